@@ -0,0 +1,284 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/fatal-error.h>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include "antenna-gain-table.h"
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AntennaGainTable");
+
+const double AntennaGainTable::MIN_GAIN_DB = -300.0;
+
+/// tolerance (degrees) used when matching the angles read from a pattern file
+static const double ANGLE_TOLERANCE_DEGREES = 1e-6;
+
+/**
+ * \param values a set of angles (degrees)
+ * \param v an angle (degrees)
+ * \return the index of the angle in the sorted set of unique angles
+ */
+static uint32_t
+FindAngle (const std::vector<double> &values, double v)
+{
+  std::vector<double>::const_iterator it = std::lower_bound (values.begin (), values.end (), v - ANGLE_TOLERANCE_DEGREES);
+  NS_ASSERT (it != values.end ());
+  return it - values.begin ();
+}
+
+/**
+ * \param values a vector of angles (degrees); on return, it holds the
+ * sorted unique angles only
+ */
+static void
+SortUniqueAngles (std::vector<double> &values)
+{
+  std::sort (values.begin (), values.end ());
+  std::vector<double> unique;
+  for (std::vector<double>::const_iterator it = values.begin (); it != values.end (); ++it)
+    {
+      if (unique.empty () || *it - unique.back () > ANGLE_TOLERANCE_DEGREES)
+        {
+          unique.push_back (*it);
+        }
+    }
+  values.swap (unique);
+}
+
+/**
+ * \param values sorted unique angles (degrees)
+ * \param step the spacing between angles (degrees)
+ * \return true if the angles are equally spaced by step
+ */
+static bool
+IsEquallySpaced (const std::vector<double> &values, double step)
+{
+  for (uint32_t i = 1; i < values.size (); ++i)
+    {
+      if (std::fabs (values.at (i) - values.at (i - 1) - step) > ANGLE_TOLERANCE_DEGREES * values.size ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+
+AntennaGainTable::AntennaGainTable ()
+  : m_nAzimuth (0),
+    m_nInclination (0),
+    m_azimuthStart (0),
+    m_azimuthStep (0),
+    m_inclinationStart (0),
+    m_inclinationStep (0)
+{
+}
+
+void
+AntennaGainTable::Build (PatternCallback pattern, uint32_t nAzimuth, uint32_t nInclination)
+{
+  NS_LOG_FUNCTION (this << nAzimuth << nInclination);
+  NS_ASSERT (nAzimuth > 0);
+  NS_ASSERT (nInclination > 0);
+  m_nAzimuth = nAzimuth;
+  m_nInclination = nInclination;
+  m_azimuthStart = -M_PI;
+  m_azimuthStep = 2 * M_PI / nAzimuth;
+  m_inclinationStart = (nInclination > 1) ? 0 : M_PI / 2;
+  m_inclinationStep = (nInclination > 1) ? M_PI / (nInclination - 1) : 0;
+  m_gainDb.resize (nAzimuth * nInclination);
+
+  for (uint32_t j = 0; j < m_nInclination; ++j)
+    {
+      double theta = m_inclinationStart + j * m_inclinationStep;
+      for (uint32_t i = 0; i < m_nAzimuth; ++i)
+        {
+          double phi = m_azimuthStart + i * m_azimuthStep;
+          double gainDb = pattern (Angles (phi, theta));
+          if (!(gainDb > MIN_GAIN_DB))
+            {
+              gainDb = MIN_GAIN_DB;
+            }
+          m_gainDb[j * m_nAzimuth + i] = gainDb;
+        }
+    }
+}
+
+void
+AntennaGainTable::Load (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::ifstream ifs (filename.c_str (), std::ifstream::in);
+  if (!ifs.good ())
+    {
+      NS_FATAL_ERROR ("Antenna pattern file " << filename << " not found");
+    }
+
+  std::vector<double> azimuths;
+  std::vector<double> inclinations;
+  std::vector<double> gains;
+  std::string line;
+  while (std::getline (ifs, line))
+    {
+      std::istringstream iss (line);
+      double azimuth;
+      double inclination;
+      double gainDb;
+      if (!(iss >> azimuth))
+        {
+          continue;  // empty line or comment
+        }
+      if (!(iss >> inclination >> gainDb))
+        {
+          NS_FATAL_ERROR ("Malformed line in antenna pattern file " << filename << ": " << line);
+        }
+      // normalize the azimuth in [-180, 180)
+      azimuth = std::fmod (azimuth + 180.0, 360.0);
+      if (azimuth < 0)
+        {
+          azimuth += 360.0;
+        }
+      azimuths.push_back (azimuth - 180.0);
+      inclinations.push_back (inclination);
+      gains.push_back (gainDb);
+    }
+
+  std::vector<double> uniqueAzimuths (azimuths);
+  std::vector<double> uniqueInclinations (inclinations);
+  SortUniqueAngles (uniqueAzimuths);
+  SortUniqueAngles (uniqueInclinations);
+  uint32_t nAzimuth = uniqueAzimuths.size ();
+  uint32_t nInclination = uniqueInclinations.size ();
+  if (nAzimuth == 0 || gains.size () != nAzimuth * nInclination)
+    {
+      NS_FATAL_ERROR ("Antenna pattern file " << filename << " does not hold a full azimuth x inclination grid");
+    }
+  double azimuthStep = 360.0 / nAzimuth;
+  double inclinationStep = (nInclination > 1) ? (uniqueInclinations.back () - uniqueInclinations.front ()) / (nInclination - 1) : 0;
+  if (!IsEquallySpaced (uniqueAzimuths, azimuthStep) || !IsEquallySpaced (uniqueInclinations, inclinationStep))
+    {
+      NS_FATAL_ERROR ("Angles in antenna pattern file " << filename << " are not equally spaced");
+    }
+
+  m_nAzimuth = nAzimuth;
+  m_nInclination = nInclination;
+  m_azimuthStart = DegreesToRadians (uniqueAzimuths.front ());
+  m_azimuthStep = DegreesToRadians (azimuthStep);
+  m_inclinationStart = DegreesToRadians (uniqueInclinations.front ());
+  m_inclinationStep = DegreesToRadians (inclinationStep);
+  m_gainDb.assign (nAzimuth * nInclination, MIN_GAIN_DB);
+  for (uint32_t k = 0; k < gains.size (); ++k)
+    {
+      uint32_t i = FindAngle (uniqueAzimuths, azimuths.at (k));
+      uint32_t j = FindAngle (uniqueInclinations, inclinations.at (k));
+      m_gainDb[j * m_nAzimuth + i] = std::max (gains.at (k), MIN_GAIN_DB);
+    }
+  NS_LOG_LOGIC (this << " loaded " << nAzimuth << " x " << nInclination << " samples from " << filename);
+}
+
+void
+AntennaGainTable::Clear ()
+{
+  NS_LOG_FUNCTION (this);
+  m_gainDb.clear ();
+  m_nAzimuth = 0;
+  m_nInclination = 0;
+}
+
+bool
+AntennaGainTable::IsEmpty () const
+{
+  return m_gainDb.empty ();
+}
+
+double
+AntennaGainTable::GetGainDb (double phi, double theta) const
+{
+  NS_ASSERT (!IsEmpty ());
+
+  // azimuth is periodic
+  double x = (phi - m_azimuthStart) / m_azimuthStep;
+  x -= m_nAzimuth * std::floor (x / m_nAzimuth);
+  uint32_t i0 = static_cast<uint32_t> (x);
+  if (i0 >= m_nAzimuth)
+    {
+      // x / m_nAzimuth rounded up to 1
+      i0 = 0;
+      x = 0;
+    }
+  uint32_t i1 = (i0 + 1 == m_nAzimuth) ? 0 : i0 + 1;
+  double fx = x - i0;
+
+  // inclination is clamped to the tabulated range
+  uint32_t j0 = 0;
+  uint32_t j1 = 0;
+  double fy = 0;
+  if (m_nInclination > 1)
+    {
+      double y = (theta - m_inclinationStart) / m_inclinationStep;
+      if (y <= 0)
+        {
+          j0 = j1 = 0;
+        }
+      else if (y >= m_nInclination - 1)
+        {
+          j0 = j1 = m_nInclination - 1;
+        }
+      else
+        {
+          j0 = static_cast<uint32_t> (y);
+          j1 = j0 + 1;
+          fy = y - j0;
+        }
+    }
+
+  const double* row0 = &m_gainDb[j0 * m_nAzimuth];
+  const double* row1 = &m_gainDb[j1 * m_nAzimuth];
+  double g00 = row0[i0];
+  double g01 = row0[i1];
+  double g10 = row1[i0];
+  double g11 = row1[i1];
+  if (g00 > MIN_GAIN_DB && g01 > MIN_GAIN_DB && g10 > MIN_GAIN_DB && g11 > MIN_GAIN_DB)
+    {
+      double g0 = g00 + fx * (g01 - g00);
+      double g1 = g10 + fx * (g11 - g10);
+      return g0 + fy * (g1 - g0);
+    }
+
+  // next to a null, interpolating in dB towards MIN_GAIN_DB would give
+  // gains far below those of the pattern: interpolate the linear gain
+  double l00 = std::pow (10.0, g00 / 10.0);
+  double l01 = std::pow (10.0, g01 / 10.0);
+  double l10 = std::pow (10.0, g10 / 10.0);
+  double l11 = std::pow (10.0, g11 / 10.0);
+  double l0 = l00 + fx * (l01 - l00);
+  double l1 = l10 + fx * (l11 - l10);
+  double l = l0 + fy * (l1 - l0);
+  if (!(l > 0))
+    {
+      return MIN_GAIN_DB;
+    }
+  return std::max (10.0 * std::log10 (l), MIN_GAIN_DB);
+}
+
+} // namespace ns3
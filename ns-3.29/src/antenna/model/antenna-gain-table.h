@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ANTENNA_GAIN_TABLE_H
+#define ANTENNA_GAIN_TABLE_H
+
+#include <ns3/angles.h>
+#include <ns3/callback.h>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup antenna
+ *
+ * \brief 2-D lookup table of an antenna radiation pattern
+ *
+ * The table stores the gain in dBi over a regular grid of azimuth
+ * (phi) and inclination (theta) angles, and evaluates the radiation
+ * pattern at any angle by bilinear interpolation. Azimuth is treated
+ * as periodic, while inclinations outside of the tabulated range are
+ * clamped to the nearest tabulated value. A table with a single
+ * inclination row represents a pattern that does not depend on the
+ * inclination.
+ *
+ * The table can be either sampled from an analytical radiation
+ * pattern, or loaded from a file containing a measured pattern.
+ */
+class AntennaGainTable
+{
+public:
+  /**
+   * Callback returning the gain in dBi at the given angles
+   */
+  typedef Callback<double, Angles> PatternCallback;
+
+  AntennaGainTable ();
+
+  /**
+   * Sample a radiation pattern over a regular grid. Azimuth samples
+   * are taken at -pi + i * 2 pi / nAzimuth, inclination samples at
+   * j * pi / (nInclination - 1); if nInclination is 1, the pattern is
+   * sampled at theta = pi / 2 only.
+   *
+   * \param pattern the radiation pattern to be tabulated
+   * \param nAzimuth the number of azimuth samples
+   * \param nInclination the number of inclination samples
+   */
+  void Build (PatternCallback pattern, uint32_t nAzimuth, uint32_t nInclination);
+
+  /**
+   * Load a measured radiation pattern from a text file. Each line of
+   * the file holds one sample in the form
+   *
+   * \verbatim
+     <azimuth (degrees)> <inclination (degrees)> <gain (dBi)>
+     \endverbatim
+   *
+   * Empty lines and lines starting with '#' are ignored. The samples
+   * must cover a full regular grid: azimuth values must be equally
+   * spaced over 360 degrees, and inclination values must be equally
+   * spaced.
+   *
+   * \param filename the name of the file to be loaded
+   */
+  void Load (std::string filename);
+
+  /**
+   * Remove all the samples from the table
+   */
+  void Clear ();
+
+  /**
+   * \return true if the table holds no samples
+   */
+  bool IsEmpty () const;
+
+  /**
+   * \param phi the azimuth angle (radians)
+   * \param theta the inclination angle (radians)
+   *
+   * \return the interpolated gain in dBi
+   */
+  double GetGainDb (double phi, double theta) const;
+
+  /**
+   * Gain (dBi) stored in place of gains which are not finite, e.g.,
+   * the -inf dB of the nulls of analytical patterns, so that they can
+   * be interpolated. Cells with a corner at this gain are interpolated
+   * in linear gain rather than in dB.
+   */
+  static const double MIN_GAIN_DB;
+
+private:
+  uint32_t m_nAzimuth;        //!< number of azimuth samples
+  uint32_t m_nInclination;    //!< number of inclination samples
+  double m_azimuthStart;      //!< azimuth of the first sample (radians)
+  double m_azimuthStep;       //!< azimuth spacing between samples (radians)
+  double m_inclinationStart;  //!< inclination of the first sample (radians)
+  double m_inclinationStep;   //!< inclination spacing between samples (radians)
+  std::vector<double> m_gainDb; //!< samples, stored one inclination row after the other
+};
+
+} // namespace ns3
+
+#endif // ANTENNA_GAIN_TABLE_H
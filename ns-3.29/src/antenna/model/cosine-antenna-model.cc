@@ -21,7 +21,9 @@
 
 #include <ns3/log.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
 #include <cmath>
+#include <algorithm>
 
 #include "antenna-model.h"
 #include "cosine-antenna-model.h"
@@ -53,6 +55,22 @@ CosineAntennaModel::GetTypeId ()
                    MakeDoubleAccessor (&CosineAntennaModel::SetOrientation,
                                        &CosineAntennaModel::GetOrientation),
                    MakeDoubleChecker<double> (-360, 360))
+    .AddAttribute ("GainTableResolution",
+                   "The azimuth resolution (degrees) of the gain table, "
+                   "used only if UseGainTable is true",
+                   DoubleValue (0.1),
+                   MakeDoubleAccessor (&CosineAntennaModel::SetGainTableResolution,
+                                       &CosineAntennaModel::GetGainTableResolution),
+                   MakeDoubleChecker<double> (1e-3, 360))
+    .AddAttribute ("UseGainTable",
+                   "If true, the radiation pattern is tabulated, and the gain is then "
+                   "obtained by interpolation over the table instead of being computed "
+                   "for every angle. The table is built again when the beamwidth or "
+                   "the resolution of the table change",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&CosineAntennaModel::SetUseGainTable,
+                                        &CosineAntennaModel::GetUseGainTable),
+                   MakeBooleanChecker ())
     .AddAttribute ("MaxGain",
                    "The gain (dB) at the antenna boresight (the direction of maximum gain)",
                    DoubleValue (0.0),
@@ -62,6 +80,13 @@ CosineAntennaModel::GetTypeId ()
   return tid;
 }
 
+CosineAntennaModel::CosineAntennaModel ()
+  : m_useGainTable (false),
+    m_gainTableResolution (0.1)
+{
+  NS_LOG_FUNCTION (this);
+}
+
 void 
 CosineAntennaModel::SetBeamwidth (double beamwidthDegrees)
 { 
@@ -69,6 +94,7 @@ CosineAntennaModel::SetBeamwidth (double beamwidthDegrees)
   m_beamwidthRadians = DegreesToRadians (beamwidthDegrees);
   m_exponent = -3.0 / (20 * std::log10 (std::cos (m_beamwidthRadians / 4.0)));
   NS_LOG_LOGIC (this << " m_exponent = " << m_exponent);
+  UpdateGainTable ();
 }
 
 double
@@ -90,12 +116,83 @@ CosineAntennaModel::GetOrientation () const
   return RadiansToDegrees (m_orientationRadians);
 }
 
+void
+CosineAntennaModel::SetUseGainTable (bool useGainTable)
+{
+  NS_LOG_FUNCTION (this << useGainTable);
+  m_useGainTable = useGainTable;
+  UpdateGainTable ();
+}
+
+bool
+CosineAntennaModel::GetUseGainTable () const
+{
+  return m_useGainTable;
+}
+
+void
+CosineAntennaModel::SetGainTableResolution (double resolutionDegrees)
+{
+  NS_LOG_FUNCTION (this << resolutionDegrees);
+  m_gainTableResolution = resolutionDegrees;
+  UpdateGainTable ();
+}
+
+double
+CosineAntennaModel::GetGainTableResolution () const
+{
+  return m_gainTableResolution;
+}
+
+void
+CosineAntennaModel::DoInitialize (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_useGainTable && m_gainTable.IsEmpty ())
+    {
+      UpdateGainTable ();
+    }
+  AntennaModel::DoInitialize ();
+}
+
+void
+CosineAntennaModel::UpdateGainTable (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_gainTable.Clear ();
+  if (!m_useGainTable)
+    {
+      return;
+    }
+  uint32_t nAzimuth = std::max (1.0, std::floor (360.0 / m_gainTableResolution + 0.5));
+  // the pattern does not depend on the inclination
+  m_gainTable.Build (MakeCallback (&CosineAntennaModel::DoGetGainDb, this), nAzimuth, 1);
+}
+
 double 
 CosineAntennaModel::GetGainDb (Angles a)
 {
   NS_LOG_FUNCTION (this << a);
   // azimuth angle w.r.t. the reference system of the antenna
-  double phi = a.phi - m_orientationRadians;
+  a.phi -= m_orientationRadians;
+
+  double gainDb;
+  if (!m_gainTable.IsEmpty ())
+    {
+      gainDb = m_gainTable.GetGainDb (a.phi, a.theta);
+    }
+  else
+    {
+      gainDb = DoGetGainDb (a);
+    }
+  NS_LOG_LOGIC ("gain = " << gainDb << " + " << m_maxGain << " dB");
+  return gainDb + m_maxGain;
+}
+
+double
+CosineAntennaModel::DoGetGainDb (Angles a) const
+{
+  double phi = a.phi;
 
   // make sure phi is in (-pi, pi]
   while (phi <= -M_PI)
@@ -118,9 +215,7 @@ CosineAntennaModel::GetGainDb (Angles a)
   // user. Hence it is not desirable to use the array factor, for the
   // ease of use of this model.
 
-  double gainDb = 20 * std::log10 (ef);
-  NS_LOG_LOGIC ("gain = " << gainDb << " + " << m_maxGain << " dB");
-  return gainDb + m_maxGain;
+  return 20 * std::log10 (ef);
 }
 
 
@@ -21,7 +21,9 @@
 
 #include <ns3/log.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
 #include <cmath>
+#include <algorithm>
 
 #include "antenna-model.h"
 #include "parabolic-antenna-model.h"
@@ -53,6 +55,22 @@ ParabolicAntennaModel::GetTypeId ()
                    MakeDoubleAccessor (&ParabolicAntennaModel::SetOrientation,
                                        &ParabolicAntennaModel::GetOrientation),
                    MakeDoubleChecker<double> (-360, 360))
+    .AddAttribute ("GainTableResolution",
+                   "The azimuth resolution (degrees) of the gain table, "
+                   "used only if UseGainTable is true",
+                   DoubleValue (0.1),
+                   MakeDoubleAccessor (&ParabolicAntennaModel::SetGainTableResolution,
+                                       &ParabolicAntennaModel::GetGainTableResolution),
+                   MakeDoubleChecker<double> (1e-3, 360))
+    .AddAttribute ("UseGainTable",
+                   "If true, the radiation pattern is tabulated, and the gain is then "
+                   "obtained by interpolation over the table instead of being computed "
+                   "for every angle. The table is built again when the beamwidth or "
+                   "the resolution of the table change",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ParabolicAntennaModel::SetUseGainTable,
+                                        &ParabolicAntennaModel::GetUseGainTable),
+                   MakeBooleanChecker ())
     .AddAttribute ("MaxAttenuation",
                    "The maximum attenuation (dB) of the antenna radiation pattern.",
                    DoubleValue (20.0),
@@ -62,11 +80,20 @@ ParabolicAntennaModel::GetTypeId ()
   return tid;
 }
 
+ParabolicAntennaModel::ParabolicAntennaModel ()
+  : m_useGainTable (false),
+    m_gainTableResolution (0.1)
+{
+  NS_LOG_FUNCTION (this);
+}
+
 void 
 ParabolicAntennaModel::SetBeamwidth (double beamwidthDegrees)
 { 
   NS_LOG_FUNCTION (this << beamwidthDegrees);
   m_beamwidthRadians = DegreesToRadians (beamwidthDegrees);
+  m_gainTable.Clear ();
+  UpdateGainTable ();
 }
 
 double
@@ -88,12 +115,86 @@ ParabolicAntennaModel::GetOrientation () const
   return RadiansToDegrees (m_orientationRadians);
 }
 
+void
+ParabolicAntennaModel::SetUseGainTable (bool useGainTable)
+{
+  NS_LOG_FUNCTION (this << useGainTable);
+  m_useGainTable = useGainTable;
+  UpdateGainTable ();
+}
+
+bool
+ParabolicAntennaModel::GetUseGainTable () const
+{
+  return m_useGainTable;
+}
+
+void
+ParabolicAntennaModel::SetGainTableResolution (double resolutionDegrees)
+{
+  NS_LOG_FUNCTION (this << resolutionDegrees);
+  m_gainTableResolution = resolutionDegrees;
+  UpdateGainTable ();
+}
+
+double
+ParabolicAntennaModel::GetGainTableResolution () const
+{
+  return m_gainTableResolution;
+}
+
+void
+ParabolicAntennaModel::DoInitialize (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_useGainTable && m_gainTable.IsEmpty ())
+    {
+      UpdateGainTable ();
+    }
+  AntennaModel::DoInitialize ();
+}
+
+void
+ParabolicAntennaModel::UpdateGainTable (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_gainTable.Clear ();
+  if (!m_useGainTable)
+    {
+      return;
+    }
+  uint32_t nAzimuth = std::max (1.0, std::floor (360.0 / m_gainTableResolution + 0.5));
+  // the pattern does not depend on the inclination
+  m_gainTable.Build (MakeCallback (&ParabolicAntennaModel::DoGetGainDb, this), nAzimuth, 1);
+}
+
 double 
 ParabolicAntennaModel::GetGainDb (Angles a)
 {
   NS_LOG_FUNCTION (this << a);
   // azimuth angle w.r.t. the reference system of the antenna
-  double phi = a.phi - m_orientationRadians;
+  a.phi -= m_orientationRadians;
+
+  double gainDb;
+  if (!m_gainTable.IsEmpty ())
+    {
+      gainDb = m_gainTable.GetGainDb (a.phi, a.theta);
+    }
+  else
+    {
+      gainDb = DoGetGainDb (a);
+    }
+  // the maximum attenuation is applied here, so that the table does
+  // not depend on it
+  gainDb = std::max (gainDb, -m_maxAttenuation);
+  NS_LOG_LOGIC ("gain = " << gainDb);
+  return gainDb;
+}
+
+double
+ParabolicAntennaModel::DoGetGainDb (Angles a) const
+{
+  double phi = a.phi;
 
   // make sure phi is in (-pi, pi]
   while (phi <= -M_PI)
@@ -107,10 +208,7 @@ ParabolicAntennaModel::GetGainDb (Angles a)
 
   NS_LOG_LOGIC ("phi = " << phi );
 
-  double gainDb = -std::min (12 * pow (phi / m_beamwidthRadians, 2), m_maxAttenuation);
-
-  NS_LOG_LOGIC ("gain = " << gainDb);
-  return gainDb;
+  return -12 * pow (phi / m_beamwidthRadians, 2);
 }
 
 
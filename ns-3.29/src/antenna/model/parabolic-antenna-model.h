@@ -24,6 +24,7 @@
 
 #include <ns3/object.h>
 #include <ns3/antenna-model.h>
+#include <ns3/antenna-gain-table.h>
 
 namespace ns3 {
 
@@ -46,6 +47,8 @@ class ParabolicAntennaModel : public AntennaModel
 {
 public:
 
+  ParabolicAntennaModel ();
+
   // inherited from Object
   static TypeId GetTypeId ();
 
@@ -58,9 +61,37 @@ public:
   double GetBeamwidth () const;
   void SetOrientation (double orientationDegrees);
   double GetOrientation () const;
+  void SetUseGainTable (bool useGainTable);
+  bool GetUseGainTable () const;
+  void SetGainTableResolution (double resolutionDegrees);
+  double GetGainTableResolution () const;
+
+protected:
+  // inherited from Object
+  virtual void DoInitialize (void);
 
 private:
 
+  /**
+   * \param a the angles, in the reference system of the antenna
+   *
+   * \return the gain in dB given by the analytical radiation pattern,
+   * before the maximum attenuation is applied
+   */
+  double DoGetGainDb (Angles a) const;
+
+  /**
+   * Tabulate the radiation pattern in m_gainTable if m_useGainTable is
+   * true, or clear m_gainTable otherwise
+   */
+  void UpdateGainTable (void);
+
+  bool m_useGainTable; //!< true if the gain is looked up in m_gainTable
+
+  double m_gainTableResolution; //!< azimuth resolution (degrees) of m_gainTable
+
+  AntennaGainTable m_gainTable; //!< radiation pattern tabulated over the azimuth
+
   double m_beamwidthRadians;
 
   double m_orientationRadians;
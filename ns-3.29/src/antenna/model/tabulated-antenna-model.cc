@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/double.h>
+#include <ns3/string.h>
+#include <ns3/abort.h>
+#include <cmath>
+#include <algorithm>
+
+#include "antenna-model.h"
+#include "tabulated-antenna-model.h"
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TabulatedAntennaModel");
+
+NS_OBJECT_ENSURE_REGISTERED (TabulatedAntennaModel);
+
+
+TypeId 
+TabulatedAntennaModel::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::TabulatedAntennaModel")
+    .SetParent<AntennaModel> ()
+    .SetGroupName("Antenna")
+    .AddConstructor<TabulatedAntennaModel> ()
+    .AddAttribute ("PatternFile",
+                   "The name of the file holding the radiation pattern, "
+                   "loaded when the attribute is set",
+                   StringValue (""),
+                   MakeStringAccessor (&TabulatedAntennaModel::SetPatternFile,
+                                       &TabulatedAntennaModel::GetPatternFile),
+                   MakeStringChecker ())
+    .AddAttribute ("Orientation",
+                   "The angle (degrees) that expresses the orientation of the antenna on the x-y plane relative to the x axis",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&TabulatedAntennaModel::SetOrientation,
+                                       &TabulatedAntennaModel::GetOrientation),
+                   MakeDoubleChecker<double> (-360, 360))
+  ;
+  return tid;
+}
+
+TabulatedAntennaModel::TabulatedAntennaModel ()
+  : m_orientationRadians (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TabulatedAntennaModel::SetPatternFile (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  m_patternFile = filename;
+  m_gainTable.Clear ();
+  if (!m_patternFile.empty ())
+    {
+      m_gainTable.Load (m_patternFile);
+    }
+}
+
+std::string
+TabulatedAntennaModel::GetPatternFile () const
+{
+  return m_patternFile;
+}
+
+void 
+TabulatedAntennaModel::SetOrientation (double orientationDegrees)
+{
+  NS_LOG_FUNCTION (this << orientationDegrees);
+  m_orientationRadians = DegreesToRadians (orientationDegrees);
+}
+
+double
+TabulatedAntennaModel::GetOrientation () const
+{
+  return RadiansToDegrees (m_orientationRadians);
+}
+
+void
+TabulatedAntennaModel::SetPattern (Ptr<AntennaModel> model, double azimuthResolutionDegrees, double inclinationResolutionDegrees)
+{
+  NS_LOG_FUNCTION (this << model << azimuthResolutionDegrees << inclinationResolutionDegrees);
+  NS_ASSERT (azimuthResolutionDegrees > 0);
+  NS_ASSERT (inclinationResolutionDegrees > 0);
+  uint32_t nAzimuth = std::max (1.0, std::floor (360.0 / azimuthResolutionDegrees + 0.5));
+  uint32_t nInclination = std::max (2.0, std::floor (180.0 / inclinationResolutionDegrees + 0.5) + 1);
+  m_gainTable.Build (MakeCallback (&AntennaModel::GetGainDb, model), nAzimuth, nInclination);
+}
+
+void
+TabulatedAntennaModel::DoInitialize (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_gainTable.IsEmpty () && !m_patternFile.empty ())
+    {
+      m_gainTable.Load (m_patternFile);
+    }
+  AntennaModel::DoInitialize ();
+}
+
+double 
+TabulatedAntennaModel::GetGainDb (Angles a)
+{
+  NS_LOG_FUNCTION (this << a);
+  NS_ABORT_MSG_IF (m_gainTable.IsEmpty (), "No radiation pattern set for TabulatedAntennaModel");
+  double gainDb = m_gainTable.GetGainDb (a.phi - m_orientationRadians, a.theta);
+  NS_LOG_LOGIC ("gain = " << gainDb);
+  return gainDb;
+}
+
+
+}
+
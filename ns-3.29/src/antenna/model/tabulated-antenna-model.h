@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TABULATED_ANTENNA_MODEL_H
+#define TABULATED_ANTENNA_MODEL_H
+
+
+#include <ns3/object.h>
+#include <ns3/antenna-model.h>
+#include <ns3/antenna-gain-table.h>
+
+namespace ns3 {
+
+/**
+ * \brief Antenna model based on a tabulated radiation pattern
+ *
+ * The radiation pattern is stored as a 2-D (azimuth, inclination)
+ * table and the gain is obtained by bilinear interpolation. The table
+ * is either loaded from the file given by the PatternFile attribute
+ * as soon as the attribute is set (see AntennaGainTable::Load for
+ * the file format), or sampled from any other AntennaModel with
+ * SetPattern.
+ *
+ * The Orientation attribute rotates the tabulated pattern on the x-y
+ * plane, so that the same measured pattern can be used for all the
+ * sectors of a site.
+ */
+class TabulatedAntennaModel : public AntennaModel
+{
+public:
+
+  TabulatedAntennaModel ();
+
+  // inherited from Object
+  static TypeId GetTypeId ();
+
+  // inherited from AntennaModel
+  virtual double GetGainDb (Angles a);
+
+  /**
+   * Tabulate the radiation pattern of another antenna model
+   *
+   * \param model the antenna model whose pattern is to be tabulated
+   * \param azimuthResolutionDegrees the azimuth resolution of the table
+   * \param inclinationResolutionDegrees the inclination resolution of
+   * the table
+   */
+  void SetPattern (Ptr<AntennaModel> model, double azimuthResolutionDegrees, double inclinationResolutionDegrees);
+
+  // attribute getters/setters
+  void SetPatternFile (std::string filename);
+  std::string GetPatternFile () const;
+  void SetOrientation (double orientationDegrees);
+  double GetOrientation () const;
+
+protected:
+  // inherited from Object
+  virtual void DoInitialize (void);
+
+private:
+
+  std::string m_patternFile; //!< name of the file holding the radiation pattern
+
+  double m_orientationRadians; //!< orientation of the antenna on the x-y plane
+
+  AntennaGainTable m_gainTable; //!< tabulated radiation pattern
+};
+
+
+
+} // namespace ns3
+
+
+#endif // TABULATED_ANTENNA_MODEL_H
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/test.h>
+#include <ns3/double.h>
+#include <ns3/boolean.h>
+#include <ns3/string.h>
+#include <ns3/object-factory.h>
+#include <ns3/cosine-antenna-model.h>
+#include <ns3/parabolic-antenna-model.h>
+#include <ns3/tabulated-antenna-model.h>
+#include <cmath>
+#include <string>
+#include <fstream>
+#include <sstream>
+
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TestTabulatedAntennaModel");
+
+/**
+ * Check that the gain table of an analytical antenna model gives the
+ * same radiation pattern as the analytical expression
+ */
+class AntennaGainTableTestCase : public TestCase
+{
+public:
+  /**
+   * \param typeId the type of the antenna model to be tested
+   * \param beamwidth the beamwidth (degrees)
+   * \param orientation the orientation (degrees)
+   */
+  AntennaGainTableTestCase (std::string typeId, double beamwidth, double orientation);
+
+private:
+  virtual void DoRun (void);
+
+  std::string m_typeId;
+  double m_beamwidth;
+  double m_orientation;
+};
+
+AntennaGainTableTestCase::AntennaGainTableTestCase (std::string typeId, double beamwidth, double orientation)
+  : TestCase (typeId + " gain table"),
+    m_typeId (typeId),
+    m_beamwidth (beamwidth),
+    m_orientation (orientation)
+{
+}
+
+void
+AntennaGainTableTestCase::DoRun ()
+{
+  ObjectFactory factory;
+  factory.SetTypeId (m_typeId);
+  factory.Set ("Beamwidth", DoubleValue (m_beamwidth));
+  factory.Set ("Orientation", DoubleValue (m_orientation));
+  Ptr<AntennaModel> exact = factory.Create<AntennaModel> ();
+  factory.Set ("UseGainTable", BooleanValue (true));
+  Ptr<AntennaModel> tabulated = factory.Create<AntennaModel> ();
+  tabulated->Initialize ();
+
+  for (double phi = -200; phi <= 200; phi += 1.37)
+    {
+      Angles a (DegreesToRadians (phi), 1.0);
+      double exactGain = exact->GetGainDb (a);
+      if (exactGain > -30)
+        {
+          NS_TEST_EXPECT_MSG_EQ_TOL (tabulated->GetGainDb (a), exactGain, 0.02, "wrong tabulated gain at phi=" << phi);
+        }
+      else
+        {
+          NS_TEST_EXPECT_MSG_LT (tabulated->GetGainDb (a), -29.9, "wrong tabulated gain at phi=" << phi);
+        }
+    }
+}
+
+
+/**
+ * Check the interpolation of a radiation pattern loaded from a file
+ */
+class TabulatedAntennaModelFileTestCase : public TestCase
+{
+public:
+  TabulatedAntennaModelFileTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+TabulatedAntennaModelFileTestCase::TabulatedAntennaModelFileTestCase ()
+  : TestCase ("tabulated antenna pattern file")
+{
+}
+
+void
+TabulatedAntennaModelFileTestCase::DoRun ()
+{
+  // the gain is -phi/10 - theta/20 dB (degrees), with azimuth wrapping
+  // around from 180 to -180
+  std::string filename = CreateTempDirFilename ("antenna-pattern.txt");
+  std::ofstream ofs (filename.c_str ());
+  ofs << "# azimuth inclination gain" << std::endl;
+  for (int theta = 0; theta <= 180; theta += 90)
+    {
+      for (int phi = -180; phi < 180; phi += 90)
+        {
+          ofs << phi << " " << theta << " " << -std::abs (phi) / 10.0 - theta / 20.0 << std::endl;
+        }
+    }
+  ofs.close ();
+
+  Ptr<TabulatedAntennaModel> a = CreateObject<TabulatedAntennaModel> ();
+  a->SetAttribute ("PatternFile", StringValue (filename));
+  a->Initialize ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (a->GetGainDb (Angles (DegreesToRadians (0), DegreesToRadians (0))), 0, 1e-9, "wrong gain at tabulated angle");
+  NS_TEST_EXPECT_MSG_EQ_TOL (a->GetGainDb (Angles (DegreesToRadians (90), DegreesToRadians (90))), -13.5, 1e-9, "wrong gain at tabulated angle");
+  NS_TEST_EXPECT_MSG_EQ_TOL (a->GetGainDb (Angles (DegreesToRadians (45), DegreesToRadians (45))), -6.75, 1e-9, "wrong interpolated gain");
+  NS_TEST_EXPECT_MSG_EQ_TOL (a->GetGainDb (Angles (DegreesToRadians (135), DegreesToRadians (180))), -22.5, 1e-9, "wrong interpolated gain");
+  NS_TEST_EXPECT_MSG_EQ_TOL (a->GetGainDb (Angles (DegreesToRadians (-135), DegreesToRadians (200))), -22.5, 1e-9, "wrong gain out of the inclination range");
+  NS_TEST_EXPECT_MSG_EQ_TOL (a->GetGainDb (Angles (DegreesToRadians (225), DegreesToRadians (0))), -13.5, 1e-9, "wrong gain across azimuth wrap-around");
+
+  a->SetAttribute ("Orientation", DoubleValue (90));
+  NS_TEST_EXPECT_MSG_EQ_TOL (a->GetGainDb (Angles (DegreesToRadians (90), DegreesToRadians (0))), 0, 1e-9, "wrong gain with orientation");
+  NS_TEST_EXPECT_MSG_EQ_TOL (a->GetGainDb (Angles (DegreesToRadians (-90), DegreesToRadians (0))), -18, 1e-9, "wrong gain with orientation");
+
+  // a null at -180 degrees is interpolated in linear gain
+  std::string nullFilename = CreateTempDirFilename ("antenna-pattern-null.txt");
+  std::ofstream nullOfs (nullFilename.c_str ());
+  for (int phi = -180; phi < 180; phi += 90)
+    {
+      nullOfs << phi << " 90 " << (phi == -180 ? -1000 : -3) << std::endl;
+    }
+  nullOfs.close ();
+  Ptr<TabulatedAntennaModel> b = CreateObject<TabulatedAntennaModel> ();
+  b->SetAttribute ("PatternFile", StringValue (nullFilename));
+  NS_TEST_EXPECT_MSG_EQ_TOL (b->GetGainDb (Angles (DegreesToRadians (-135), DegreesToRadians (90))), -3 + 10 * std::log10 (0.5), 1e-9, "wrong interpolated gain next to a null");
+  NS_TEST_EXPECT_MSG_EQ_TOL (b->GetGainDb (Angles (DegreesToRadians (-180), DegreesToRadians (90))), AntennaGainTable::MIN_GAIN_DB, 1e-9, "wrong gain at a null");
+}
+
+
+/**
+ * Check the tabulation of the radiation pattern of another antenna model
+ */
+class TabulatedAntennaModelPatternTestCase : public TestCase
+{
+public:
+  TabulatedAntennaModelPatternTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+TabulatedAntennaModelPatternTestCase::TabulatedAntennaModelPatternTestCase ()
+  : TestCase ("tabulated antenna pattern from model")
+{
+}
+
+void
+TabulatedAntennaModelPatternTestCase::DoRun ()
+{
+  Ptr<CosineAntennaModel> exact = CreateObject<CosineAntennaModel> ();
+  exact->SetAttribute ("Beamwidth", DoubleValue (65));
+  exact->SetAttribute ("Orientation", DoubleValue (-120));
+  exact->SetAttribute ("MaxGain", DoubleValue (14));
+  Ptr<TabulatedAntennaModel> tabulated = CreateObject<TabulatedAntennaModel> ();
+  tabulated->SetPattern (exact, 0.1, 10);
+
+  for (double phi = -180; phi <= 180; phi += 2.9)
+    {
+      Angles a (DegreesToRadians (phi), DegreesToRadians (phi / 2 + 90));
+      double exactGain = exact->GetGainDb (a);
+      if (exactGain > -16)
+        {
+          NS_TEST_EXPECT_MSG_EQ_TOL (tabulated->GetGainDb (a), exactGain, 0.01, "wrong tabulated gain at phi=" << phi);
+        }
+    }
+}
+
+
+class TabulatedAntennaModelTestSuite : public TestSuite
+{
+public:
+  TabulatedAntennaModelTestSuite ();
+};
+
+TabulatedAntennaModelTestSuite::TabulatedAntennaModelTestSuite ()
+  : TestSuite ("tabulated-antenna-model", UNIT)
+{
+  AddTestCase (new AntennaGainTableTestCase ("ns3::CosineAntennaModel", 60, 0), TestCase::QUICK);
+  AddTestCase (new AntennaGainTableTestCase ("ns3::CosineAntennaModel", 100, -150), TestCase::QUICK);
+  AddTestCase (new AntennaGainTableTestCase ("ns3::ParabolicAntennaModel", 70, 30), TestCase::QUICK);
+  AddTestCase (new TabulatedAntennaModelFileTestCase, TestCase::QUICK);
+  AddTestCase (new TabulatedAntennaModelPatternTestCase, TestCase::QUICK);
+}
+
+static TabulatedAntennaModelTestSuite staticTabulatedAntennaModelTestSuiteInstance;
@@ -411,4 +411,10 @@ DefaultSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+void
+DefaultSimulatorImpl::SetContext (uint32_t context)
+{
+  m_currentContext = context;
+}
+
 } // namespace ns3
@@ -77,6 +77,7 @@ public:
   virtual void SetScheduler (ObjectFactory schedulerFactory);
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
+  virtual void SetContext (uint32_t context);
 
 private:
   virtual void DoDispose (void);
@@ -42,4 +42,11 @@ SimulatorImpl::GetTypeId (void)
   return tid;
 }
 
+void
+SimulatorImpl::SetContext (uint32_t context)
+{
+  NS_LOG_FUNCTION (this << context);
+  NS_FATAL_ERROR ("Setting the context is not supported by " << GetInstanceTypeId ().GetName ());
+}
+
 } // namespace ns3
@@ -99,6 +99,21 @@ public:
   virtual uint32_t GetSystemId () const = 0; 
   /** \copydoc Simulator::GetContext */
   virtual uint32_t GetContext (void) const = 0;
+  /**
+   * Set the current simulation context.
+   *
+   * This is not part of the Simulator API: it lets a model which runs
+   * the work of several nodes in a single event, such as the LTE TTI
+   * clock, run the work of each node in the context of that node, as
+   * if it had been scheduled with Simulator::ScheduleWithContext().
+   * The model must restore the context of the event before returning.
+   *
+   * The default implementation aborts: the implementations which
+   * do not track the current context do not support it.
+   *
+   * \param [in] context The new simulation context
+   */
+  virtual void SetContext (uint32_t context);
 };
 
 } // namespace ns3
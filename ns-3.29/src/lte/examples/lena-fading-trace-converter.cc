@@ -0,0 +1,54 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Convert a fading trace generated by fading_trace_generator.m (ASCII
+ * format) to the binary format, which TraceFadingLossModel maps in
+ * memory instead of parsing it at every run, e.g.:
+ *
+ * ./waf --run "lena-fading-trace-converter
+ *   --input=src/lte/model/fading-traces/fading_trace_EPA_3kmph.fad
+ *   --output=fading_trace_EPA_3kmph.bin --rbNum=100 --samplesNum=10000"
+ *
+ * The binary trace is then used by setting it as the TraceFilename
+ * attribute of TraceFadingLossModel.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/lte-module.h"
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+  uint32_t rbNum = 100;
+  uint32_t samplesNum = 10000;
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Name of the ASCII fading trace file", input);
+  cmd.AddValue ("output", "Name of the binary fading trace file to be written", output);
+  cmd.AddValue ("rbNum", "The number of RB the trace is made of", rbNum);
+  cmd.AddValue ("samplesNum", "The number of samples the trace is made of", samplesNum);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (input.empty () || output.empty (), "Both --input and --output must be given");
+  NS_ABORT_MSG_IF (rbNum == 0 || rbNum > 255, "rbNum must be in [1, 255]");
+
+  SharedFadingTrace::ConvertToBinary (input, output, rbNum, samplesNum);
+  return 0;
+}
@@ -23,13 +23,26 @@
 #include "ns3/lte-enb-net-device.h"
 #include "ns3/lte-ue-net-device.h"
 #include "ns3/lte-spectrum-phy.h"
+#include "ns3/node.h"
+#include "ns3/mobility-model.h"
+#include "ns3/propagation-loss-model.h"
 
+#include <cstring>
+#include <fstream>
 #include <limits>
+#include <vector>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("LteGlobalPathlossDatabase");
 
+/// magic string at the start of the pathloss files
+static const char LTE_PATHLOSS_FILE_MAGIC[8] = { 'L', 'T', 'E', 'P', 'L', 'O', 'S', 'S' };
+/// version of the pathloss file format
+static const uint32_t LTE_PATHLOSS_FILE_VERSION = 1;
+/// byte order mark of the pathloss files
+static const uint32_t LTE_PATHLOSS_FILE_BYTE_ORDER = 0x01020304;
+
 LteGlobalPathlossDatabase::~LteGlobalPathlossDatabase (void)
 {
 }
@@ -69,6 +82,170 @@ LteGlobalPathlossDatabase::GetPathloss (uint16_t cellId, uint64_t imsi)
   return ueIt->second;
 }
  
+void
+LteGlobalPathlossDatabase::Compute (NetDeviceContainer enbDevices, NetDeviceContainer ueDevices, Ptr<const PropagationLossModel> model)
+{
+  NS_LOG_FUNCTION (this << enbDevices.GetN () << ueDevices.GetN () << model);
+  m_pathlossMap.clear ();
+  for (NetDeviceContainer::Iterator enbIt = enbDevices.Begin (); enbIt != enbDevices.End (); ++enbIt)
+    {
+      uint16_t cellId = (*enbIt)->GetObject<LteEnbNetDevice> ()->GetCellId ();
+      Ptr<MobilityModel> enbMobility = (*enbIt)->GetNode ()->GetObject<MobilityModel> ();
+      NS_ASSERT_MSG (enbMobility != 0, "eNB of cell " << cellId << " has no mobility model");
+      std::map<uint64_t, double> &cellPathloss = m_pathlossMap[cellId];
+      for (NetDeviceContainer::Iterator ueIt = ueDevices.Begin (); ueIt != ueDevices.End (); ++ueIt)
+        {
+          uint64_t imsi = (*ueIt)->GetObject<LteUeNetDevice> ()->GetImsi ();
+          Ptr<MobilityModel> ueMobility = (*ueIt)->GetNode ()->GetObject<MobilityModel> ();
+          NS_ASSERT_MSG (ueMobility != 0, "UE " << imsi << " has no mobility model");
+          double rxPowerDbm = IsDownlink () ? model->CalcRxPower (0.0, enbMobility, ueMobility)
+                                            : model->CalcRxPower (0.0, ueMobility, enbMobility);
+          cellPathloss[imsi] = -rxPowerDbm;
+        }
+    }
+}
+
+void
+LteGlobalPathlossDatabase::InstallPathloss (Ptr<MatrixPropagationLossModel> model, NetDeviceContainer enbDevices, NetDeviceContainer ueDevices) const
+{
+  NS_LOG_FUNCTION (this << model << enbDevices.GetN () << ueDevices.GetN ());
+  NS_ASSERT (model != 0);
+  std::map<uint64_t, Ptr<MobilityModel> > ueMobilities;
+  for (NetDeviceContainer::Iterator ueIt = ueDevices.Begin (); ueIt != ueDevices.End (); ++ueIt)
+    {
+      uint64_t imsi = (*ueIt)->GetObject<LteUeNetDevice> ()->GetImsi ();
+      ueMobilities[imsi] = (*ueIt)->GetNode ()->GetObject<MobilityModel> ();
+    }
+  for (NetDeviceContainer::Iterator enbIt = enbDevices.Begin (); enbIt != enbDevices.End (); ++enbIt)
+    {
+      uint16_t cellId = (*enbIt)->GetObject<LteEnbNetDevice> ()->GetCellId ();
+      Ptr<MobilityModel> enbMobility = (*enbIt)->GetNode ()->GetObject<MobilityModel> ();
+      std::map<uint16_t, std::map<uint64_t, double> >::const_iterator cellIt = m_pathlossMap.find (cellId);
+      if (cellIt == m_pathlossMap.end ())
+        {
+          NS_LOG_WARN ("no pathloss stored for cell " << cellId);
+          continue;
+        }
+      for (std::map<uint64_t, double>::const_iterator imsiIt = cellIt->second.begin ();
+           imsiIt != cellIt->second.end ();
+           ++imsiIt)
+        {
+          std::map<uint64_t, Ptr<MobilityModel> >::const_iterator ueIt = ueMobilities.find (imsiIt->first);
+          if (ueIt == ueMobilities.end ())
+            {
+              continue;
+            }
+          if (IsDownlink ())
+            {
+              model->SetLoss (enbMobility, ueIt->second, imsiIt->second, false);
+            }
+          else
+            {
+              model->SetLoss (ueIt->second, enbMobility, imsiIt->second, false);
+            }
+        }
+    }
+}
+
+bool
+LteGlobalPathlossDatabase::Save (std::string filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::vector<uint16_t> cellIds;
+  std::vector<uint64_t> imsis;
+  std::vector<double> pathlosses;
+  for (std::map<uint16_t, std::map<uint64_t, double> >::const_iterator cellIdIt = m_pathlossMap.begin ();
+       cellIdIt != m_pathlossMap.end ();
+       ++cellIdIt)
+    {
+      for (std::map<uint64_t, double>::const_iterator imsiIt = cellIdIt->second.begin ();
+           imsiIt != cellIdIt->second.end ();
+           ++imsiIt)
+        {
+          cellIds.push_back (cellIdIt->first);
+          imsis.push_back (imsiIt->first);
+          pathlosses.push_back (imsiIt->second);
+        }
+    }
+
+  std::ofstream file (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << filename.c_str ());
+      return false;
+    }
+  uint8_t direction = IsDownlink () ? 0 : 1;
+  uint32_t n = pathlosses.size ();
+  file.write (LTE_PATHLOSS_FILE_MAGIC, sizeof (LTE_PATHLOSS_FILE_MAGIC));
+  file.write (reinterpret_cast<const char *> (&LTE_PATHLOSS_FILE_VERSION), sizeof (uint32_t));
+  file.write (reinterpret_cast<const char *> (&LTE_PATHLOSS_FILE_BYTE_ORDER), sizeof (uint32_t));
+  file.write (reinterpret_cast<const char *> (&direction), sizeof (uint8_t));
+  file.write (reinterpret_cast<const char *> (&n), sizeof (uint32_t));
+  if (n > 0)
+    {
+      file.write (reinterpret_cast<const char *> (&cellIds[0]), sizeof (uint16_t) * n);
+      file.write (reinterpret_cast<const char *> (&imsis[0]), sizeof (uint64_t) * n);
+      file.write (reinterpret_cast<const char *> (&pathlosses[0]), sizeof (double) * n);
+    }
+  file.close ();
+  return !file.fail ();
+}
+
+bool
+LteGlobalPathlossDatabase::Load (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::ifstream file (filename.c_str (), std::ios::in | std::ios::binary);
+  if (!file.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << filename.c_str ());
+      return false;
+    }
+  char magic[sizeof (LTE_PATHLOSS_FILE_MAGIC)];
+  uint32_t version;
+  uint32_t byteOrder;
+  uint8_t direction;
+  uint32_t n;
+  file.read (magic, sizeof (magic));
+  file.read (reinterpret_cast<char *> (&version), sizeof (uint32_t));
+  file.read (reinterpret_cast<char *> (&byteOrder), sizeof (uint32_t));
+  file.read (reinterpret_cast<char *> (&direction), sizeof (uint8_t));
+  file.read (reinterpret_cast<char *> (&n), sizeof (uint32_t));
+  if (!file.good ()
+      || (std::memcmp (magic, LTE_PATHLOSS_FILE_MAGIC, sizeof (magic)) != 0)
+      || (version != LTE_PATHLOSS_FILE_VERSION)
+      || (byteOrder != LTE_PATHLOSS_FILE_BYTE_ORDER))
+    {
+      NS_LOG_ERROR (filename << " is not a pathloss file");
+      return false;
+    }
+  if (direction != (IsDownlink () ? 0 : 1))
+    {
+      NS_LOG_ERROR (filename << " holds the pathloss of the other direction");
+      return false;
+    }
+  std::vector<uint16_t> cellIds (n);
+  std::vector<uint64_t> imsis (n);
+  std::vector<double> pathlosses (n);
+  if (n > 0)
+    {
+      file.read (reinterpret_cast<char *> (&cellIds[0]), sizeof (uint16_t) * n);
+      file.read (reinterpret_cast<char *> (&imsis[0]), sizeof (uint64_t) * n);
+      file.read (reinterpret_cast<char *> (&pathlosses[0]), sizeof (double) * n);
+      if (!file.good ())
+        {
+          NS_LOG_ERROR (filename << " is truncated");
+          return false;
+        }
+    }
+  m_pathlossMap.clear ();
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      m_pathlossMap[cellIds[i]][imsis[i]] = pathlosses[i];
+    }
+  return true;
+}
+
 
 void
 DownlinkLteGlobalPathlossDatabase::UpdatePathloss (std::string context, 
@@ -78,10 +255,16 @@ DownlinkLteGlobalPathlossDatabase::UpdatePathloss (std::string context,
 {
   NS_LOG_FUNCTION (this << lossDb);
   uint16_t cellId = txPhy->GetDevice ()->GetObject<LteEnbNetDevice> ()->GetCellId ();
-  uint16_t imsi = rxPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
+  uint64_t imsi = rxPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
   m_pathlossMap[cellId][imsi] = lossDb;
 }
 
+bool
+DownlinkLteGlobalPathlossDatabase::IsDownlink (void) const
+{
+  return true;
+}
+
 
 void
 UplinkLteGlobalPathlossDatabase::UpdatePathloss (std::string context, 
@@ -90,11 +273,17 @@ UplinkLteGlobalPathlossDatabase::UpdatePathloss (std::string context,
                                         double lossDb)
 {
   NS_LOG_FUNCTION (this << lossDb);
-  uint16_t imsi = txPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
+  uint64_t imsi = txPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
   uint16_t cellId = rxPhy->GetDevice ()->GetObject<LteEnbNetDevice> ()->GetCellId ();
   m_pathlossMap[cellId][imsi] = lossDb;
 }
 
+bool
+UplinkLteGlobalPathlossDatabase::IsDownlink (void) const
+{
+  return false;
+}
+
 
 
 } // namespace ns3
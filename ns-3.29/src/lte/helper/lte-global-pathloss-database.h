@@ -24,12 +24,16 @@
 
 #include <ns3/log.h>
 #include <ns3/ptr.h>
+#include <ns3/net-device-container.h>
 #include <string>
 #include <map>
 
 namespace ns3 {
 
 class SpectrumPhy;
+class MobilityModel;
+class PropagationLossModel;
+class MatrixPropagationLossModel;
 
 /**
  * \ingroup lte
@@ -37,7 +41,27 @@ class SpectrumPhy;
  * Store the last pathloss value for each TX-RX pair. This is an
  * example of how the PathlossTrace (provided by some SpectrumChannel
  * implementations) work. 
- * 
+ *
+ * The database can also hold a precomputed pathloss matrix: Compute
+ * fills it, before the simulation is run, with the propagation loss
+ * between each eNB and each UE given by a PropagationLossModel (which
+ * includes the shadowing of the model, if any, but not the antenna
+ * gains), Save and Load write and read it as a binary file, and
+ * InstallPathloss copies it to a MatrixPropagationLossModel. When the
+ * pathloss model of the LteHelper is a MatrixPropagationLossModel
+ * filled in this way, the spectrum channels only look the pathloss up,
+ * which makes it possible to skip the propagation computations of
+ * static-UE studies and to reuse the matrix across runs:
+ *
+ * \code
+ *   lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::MatrixPropagationLossModel"));
+ *   ...
+ *   DownlinkLteGlobalPathlossDatabase dlPathlossDb;
+ *   dlPathlossDb.Load ("dl-pathloss.bin");
+ *   Ptr<SpectrumChannel> dlChannel = lteHelper->GetDownlinkSpectrumChannel ();
+ *   dlPathlossDb.InstallPathloss (DynamicCast<MatrixPropagationLossModel> (dlChannel->GetPropagationLossModel ()),
+ *                                 enbDevs, ueDevs);
+ * \endcode
  */
 class LteGlobalPathlossDatabase
 {
@@ -71,7 +95,57 @@ public:
    */
   void Print ();
 
+  /**
+   * Compute the pathloss between each eNB and each UE, replacing the
+   * stored values. The model is queried once per pair, eNB by eNB, in the
+   * order of the containers, so that its random variables (if any) are
+   * drawn in a reproducible order.
+   *
+   * \param enbDevices the eNB devices
+   * \param ueDevices the UE devices
+   * \param model the propagation loss model
+   */
+  void Compute (NetDeviceContainer enbDevices, NetDeviceContainer ueDevices, Ptr<const PropagationLossModel> model);
+
+  /**
+   * Copy the stored pathloss values of the given devices to a
+   * MatrixPropagationLossModel, in the direction of the database.
+   *
+   * \param model the propagation loss model
+   * \param enbDevices the eNB devices
+   * \param ueDevices the UE devices
+   */
+  void InstallPathloss (Ptr<MatrixPropagationLossModel> model, NetDeviceContainer enbDevices, NetDeviceContainer ueDevices) const;
+
+  /**
+   * Save the stored pathloss values to a binary file. The file starts
+   * with the magic "LTEPLOSS", the version and a byte order mark
+   * (uint32_t), the direction (uint8_t: 0 for the downlink, 1 for the
+   * uplink) and the number of values (uint32_t), followed by the cell
+   * IDs (uint16_t), the IMSIs (uint64_t) and the pathloss values
+   * (double), in the native byte order.
+   *
+   * \param filename the name of the file
+   * \return true if the file could be written
+   */
+  bool Save (std::string filename) const;
+
+  /**
+   * Load the pathloss values from a binary file written by Save for
+   * the same direction, replacing the stored values.
+   *
+   * \param filename the name of the file
+   * \return true if the file could be read
+   */
+  bool Load (std::string filename);
+
 protected:
+  /**
+   * \return true if the database stores the pathloss from the eNBs to
+   * the UEs, false if it stores the pathloss from the UEs to the eNBs
+   */
+  virtual bool IsDownlink (void) const = 0;
+
   /**
    * List of the last pathloss value for each UE by CellId.
    * ( CELL ID,  ( IMSI,PATHLOSS ))
@@ -88,6 +162,10 @@ class DownlinkLteGlobalPathlossDatabase : public LteGlobalPathlossDatabase
 public:
   // inherited from LteGlobalPathlossDatabase
   virtual void UpdatePathloss (std::string context, Ptr<const SpectrumPhy> txPhy, Ptr<const SpectrumPhy> rxPhy, double lossDb);
+
+protected:
+  // inherited from LteGlobalPathlossDatabase
+  virtual bool IsDownlink (void) const;
 };
 
 /**
@@ -99,6 +177,10 @@ class UplinkLteGlobalPathlossDatabase : public LteGlobalPathlossDatabase
 public:
   // inherited from LteGlobalPathlossDatabase
   virtual void UpdatePathloss (std::string context, Ptr<const SpectrumPhy> txPhy, Ptr<const SpectrumPhy> rxPhy, double lossDb);
+
+protected:
+  // inherited from LteGlobalPathlossDatabase
+  virtual bool IsDownlink (void) const;
 };
 
 
@@ -35,6 +35,7 @@
 #include <ns3/lte-enb-net-device.h>
 #include <ns3/lte-enb-phy.h>
 #include <ns3/lte-ue-phy.h>
+#include <ns3/lte-tti-clock.h>
 #include <ns3/lte-spectrum-phy.h>
 #include <ns3/lte-chunk-processor.h>
 #include <ns3/multi-model-spectrum-channel.h>
@@ -194,6 +195,19 @@ TypeId LteHelper::GetTypeId (void)
                    UintegerValue (1),
                    MakeUintegerAccessor (&LteHelper::m_noOfCcs),
                    MakeUintegerChecker<uint16_t> (MIN_NO_CC, MAX_NO_CC))
+    .AddAttribute ("TtiSynchronousPhy",
+                   "If true, the subframes of all the eNB and UE PHYs, on all the component "
+                   "carriers, are processed by a single LteTtiClock, with one event per "
+                   "phase of the subframe instead of one event per phase and per PHY. "
+                   "The ends of the receptions and of the signals expiring at the same "
+                   "time are also processed by a single event of the clock, and the "
+                   "receptions of each transmission are started by a single event of the "
+                   "channel, if it is a MultiModelSpectrumChannel. "
+                   "Only the devices installed before the start of the simulation "
+                   "are driven by the clock.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteHelper::m_ttiSynchronousPhy),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -205,9 +219,20 @@ LteHelper::DoDispose ()
   m_downlinkChannel = 0;
   m_uplinkChannel = 0;
   m_componentCarrierPhyParams.clear();
+  m_ttiClock = 0;
   Object::DoDispose ();
 }
 
+Ptr<LteTtiClock>
+LteHelper::GetTtiClock (void)
+{
+  if (m_ttiClock == 0)
+    {
+      m_ttiClock = CreateObject<LteTtiClock> ();
+    }
+  return m_ttiClock;
+}
+
 Ptr<SpectrumChannel>
 LteHelper::GetUplinkSpectrumChannel (void) const
 {
@@ -229,6 +254,12 @@ LteHelper::ChannelModelInitialization (void)
 
   m_downlinkChannel = m_channelFactory.Create<SpectrumChannel> ();
   m_uplinkChannel = m_channelFactory.Create<SpectrumChannel> ();
+  if (m_ttiSynchronousPhy)
+    {
+      // start the receptions of each transmission with a single event
+      m_downlinkChannel->SetAttributeFailSafe ("GroupedRx", BooleanValue (true));
+      m_uplinkChannel->SetAttributeFailSafe ("GroupedRx", BooleanValue (true));
+    }
 
   m_downlinkPathlossModel = m_pathlossModelFactory.Create ();
   Ptr<SpectrumPropagationLossModel> dlSplm = m_downlinkPathlossModel->GetObject<SpectrumPropagationLossModel> ();
@@ -545,6 +576,12 @@ LteHelper::InstallSingleEnbDevice (Ptr<Node> n)
       Ptr<LteSpectrumPhy> dlPhy = CreateObject<LteSpectrumPhy> ();
       Ptr<LteSpectrumPhy> ulPhy = CreateObject<LteSpectrumPhy> ();
       Ptr<LteEnbPhy> phy = CreateObject<LteEnbPhy> (dlPhy, ulPhy);
+      if (m_ttiSynchronousPhy)
+        {
+          phy->SetTtiClock (GetTtiClock ());
+          dlPhy->SetTtiClock (GetTtiClock ());
+          ulPhy->SetTtiClock (GetTtiClock ());
+        }
 
       Ptr<LteHarqPhy> harq = Create<LteHarqPhy> ();
       dlPhy->SetHarqPhyModule (harq);
@@ -800,6 +837,12 @@ LteHelper::InstallSingleUeDevice (Ptr<Node> n)
       Ptr<LteSpectrumPhy> ulPhy = CreateObject<LteSpectrumPhy> ();
 
       Ptr<LteUePhy> phy = CreateObject<LteUePhy> (dlPhy, ulPhy);
+      if (m_ttiSynchronousPhy)
+        {
+          phy->SetTtiClock (GetTtiClock ());
+          dlPhy->SetTtiClock (GetTtiClock ());
+          ulPhy->SetTtiClock (GetTtiClock ());
+        }
 
       Ptr<LteHarqPhy> harq = Create<LteHarqPhy> ();
       dlPhy->SetHarqPhyModule (harq);
@@ -48,6 +48,7 @@ namespace ns3 {
 
 class LteUePhy;
 class LteEnbPhy;
+class LteTtiClock;
 class SpectrumChannel;
 class EpcHelper;
 class PropagationLossModel;
@@ -729,6 +730,12 @@ private:
   /// Function that performs a channel model initialization of all component carriers
   void ChannelModelInitialization (void);
 
+  /**
+   * \return the clock of the PHYs in the TTI-synchronous PHY mode,
+   * created on first use
+   */
+  Ptr<LteTtiClock> GetTtiClock (void);
+
   /**
    * \brief This function create the component carrier based on provided configuration parameters
    */
@@ -847,6 +854,14 @@ private:
    */
   uint16_t m_noOfCcs;
 
+  /**
+   * The `TtiSynchronousPhy` attribute. If true, the subframes of all the
+   * PHYs are processed by a single LteTtiClock.
+   */
+  bool m_ttiSynchronousPhy;
+  /// The clock of the PHYs, in the TTI-synchronous PHY mode
+  Ptr<LteTtiClock> m_ttiClock;
+
 };   // end of `class LteHelper`
 
 
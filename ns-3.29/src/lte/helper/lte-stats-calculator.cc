@@ -22,6 +22,7 @@
 
 #include <ns3/log.h>
 #include <ns3/config.h>
+#include <ns3/enum.h>
 #include <ns3/lte-enb-rrc.h>
 #include <ns3/lte-ue-rrc.h>
 #include <ns3/lte-enb-net-device.h>
@@ -35,7 +36,8 @@ NS_OBJECT_ENSURE_REGISTERED (LteStatsCalculator);
 
 LteStatsCalculator::LteStatsCalculator ()
   : m_dlOutputFilename (""),
-    m_ulOutputFilename ("")
+    m_ulOutputFilename (""),
+    m_outputFormat (LteStatsFile::TEXT)
 {
   // Nothing to do here
 
@@ -54,6 +56,17 @@ LteStatsCalculator::GetTypeId (void)
     .SetParent<Object> ()
     .SetGroupName("Lte")
     .AddConstructor<LteStatsCalculator> ()
+    .AddAttribute ("OutputFormat",
+                   "Format of the output files: text written record by record, "
+                   "text buffered in memory, or binary buffered in memory "
+                   "(see the lte-stats-converter program). The buffered "
+                   "formats are written when the simulator is destroyed "
+                   "and when the calculator is deleted.",
+                   EnumValue (LteStatsFile::TEXT),
+                   MakeEnumAccessor (&LteStatsCalculator::m_outputFormat),
+                   MakeEnumChecker (LteStatsFile::TEXT, "Text",
+                                    LteStatsFile::BUFFERED_TEXT, "BufferedText",
+                                    LteStatsFile::BINARY, "Binary"))
   ;
   return tid;
 }
@@ -83,6 +96,12 @@ LteStatsCalculator::GetDlOutputFilename (void)
   return m_dlOutputFilename;
 }
 
+LteStatsFile::Format
+LteStatsCalculator::GetOutputFormat (void) const
+{
+  return m_outputFormat;
+}
+
 
 bool
 LteStatsCalculator::ExistsImsiPath (std::string path)
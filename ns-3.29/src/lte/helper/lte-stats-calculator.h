@@ -23,6 +23,7 @@
 
 #include "ns3/object.h"
 #include "ns3/string.h"
+#include "ns3/lte-stats-file.h"
 #include <map>
 
 namespace ns3 {
@@ -80,6 +81,12 @@ public:
    */
   std::string GetDlOutputFilename (void);
 
+  /**
+   * Get the format of the output files.
+   * @return the format of the output files
+   */
+  LteStatsFile::Format GetOutputFormat (void) const;
+
   /**
    * Checks if there is an already stored IMSI for the given path
    * @param path Path in the attribute system to check
@@ -204,6 +211,11 @@ private:
    * Name of the file where the uplink results will be saved
    */
   std::string m_ulOutputFilename;
+
+  /**
+   * Format of the output files
+   */
+  LteStatsFile::Format m_outputFormat;
 };
 
 } // namespace ns3
@@ -0,0 +1,583 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-stats-file.h"
+
+#include <ns3/log.h>
+#include <ns3/assert.h>
+#include <ns3/simulator.h>
+#include <cstring>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteStatsFile");
+
+/// magic string at the start of the binary files
+static const char LTE_STATS_FILE_MAGIC[8] = { 'L', 'T', 'E', 'S', 'T', 'A', 'T', 'S' };
+/// version of the binary format
+static const uint32_t LTE_STATS_FILE_VERSION = 1;
+/// byte order mark of the binary files
+static const uint32_t LTE_STATS_FILE_BYTE_ORDER = 0x01020304;
+
+/**
+ * Write raw values to a binary file.
+ *
+ * \param os the file
+ * \param values the values
+ * \param n the number of values
+ */
+template <typename T>
+static void
+WriteValues (std::ostream &os, const T *values, uint32_t n)
+{
+  os.write (reinterpret_cast<const char *> (values), sizeof (T) * n);
+}
+
+/**
+ * Write a string, preceded by its length, to a binary file.
+ *
+ * \param os the file
+ * \param s the string
+ */
+static void
+WriteString (std::ostream &os, const std::string &s)
+{
+  uint32_t length = s.size ();
+  WriteValues (os, &length, 1);
+  os.write (s.data (), length);
+}
+
+/**
+ * Write the values of an integer field to a binary file, in the
+ * smallest number of bytes (1, 2, 4 or 8) holding all of them, which is
+ * written first.
+ *
+ * \param os the file
+ * \param values the values
+ * \param isSigned whether the values are int64_t values
+ */
+static void
+WriteIntegers (std::ostream &os, const std::vector<uint64_t> &values, bool isSigned)
+{
+  uint64_t maxMagnitude = 0;
+  for (std::vector<uint64_t>::const_iterator it = values.begin (); it != values.end (); ++it)
+    {
+      uint64_t magnitude = *it;
+      if (isSigned)
+        {
+          // a two's complement value fits in n bytes if twice its
+          // magnitude (less one, if negative) fits in n unsigned bytes
+          magnitude = ((magnitude >> 63) ? ~magnitude : magnitude) << 1;
+        }
+      maxMagnitude |= magnitude;
+    }
+  uint8_t width = (maxMagnitude >> 32) ? 8 : (maxMagnitude >> 16) ? 4 : (maxMagnitude >> 8) ? 2 : 1;
+  WriteValues (os, &width, 1);
+  switch (width)
+    {
+    case 1:
+      {
+        std::vector<uint8_t> packed (values.begin (), values.end ());
+        WriteValues (os, packed.data (), packed.size ());
+        break;
+      }
+    case 2:
+      {
+        std::vector<uint16_t> packed (values.begin (), values.end ());
+        WriteValues (os, packed.data (), packed.size ());
+        break;
+      }
+    case 4:
+      {
+        std::vector<uint32_t> packed (values.begin (), values.end ());
+        WriteValues (os, packed.data (), packed.size ());
+        break;
+      }
+    default:
+      WriteValues (os, values.data (), values.size ());
+      break;
+    }
+}
+
+/**
+ * Read raw values from a binary file.
+ *
+ * \param is the file
+ * \param values the values
+ * \param n the number of values
+ * \return true if the values could be read
+ */
+template <typename T>
+static bool
+ReadValues (std::istream &is, T *values, uint32_t n)
+{
+  is.read (reinterpret_cast<char *> (values), sizeof (T) * n);
+  return !is.fail ();
+}
+
+/**
+ * Read the values of an integer field, written in a given number of
+ * bytes, from a binary file.
+ *
+ * \param is the file
+ * \param values the values
+ * \param n the number of values
+ * \return true if the values could be read
+ */
+template <typename T>
+static bool
+ReadPackedIntegers (std::istream &is, std::vector<uint64_t> &values, uint32_t n)
+{
+  std::vector<T> packed (n);
+  if (!ReadValues (is, packed.data (), n))
+    {
+      return false;
+    }
+  values.assign (packed.begin (), packed.end ());
+  return true;
+}
+
+/**
+ * Read the values of an integer field, written by WriteIntegers, from
+ * a binary file.
+ *
+ * \param is the file
+ * \param values the values
+ * \param n the number of values
+ * \param isSigned whether the values are int64_t values
+ * \return true if the values could be read
+ */
+static bool
+ReadIntegers (std::istream &is, std::vector<uint64_t> &values, uint32_t n, bool isSigned)
+{
+  uint8_t width;
+  if (!ReadValues (is, &width, 1))
+    {
+      return false;
+    }
+  switch (width)
+    {
+    case 1:
+      return isSigned ? ReadPackedIntegers<int8_t> (is, values, n) : ReadPackedIntegers<uint8_t> (is, values, n);
+    case 2:
+      return isSigned ? ReadPackedIntegers<int16_t> (is, values, n) : ReadPackedIntegers<uint16_t> (is, values, n);
+    case 4:
+      return isSigned ? ReadPackedIntegers<int32_t> (is, values, n) : ReadPackedIntegers<uint32_t> (is, values, n);
+    case 8:
+      return ReadPackedIntegers<uint64_t> (is, values, n);
+    default:
+      return false;
+    }
+}
+
+/**
+ * Read a string, preceded by its length, from a binary file.
+ *
+ * \param is the file
+ * \param s the string
+ * \return true if the string could be read
+ */
+static bool
+ReadString (std::istream &is, std::string &s)
+{
+  uint32_t length;
+  if (!ReadValues (is, &length, 1))
+    {
+      return false;
+    }
+  s.resize (length);
+  return (length == 0) || ReadValues (is, &s[0], length);
+}
+
+
+LteStatsFile::LteStatsFile ()
+  : m_format (TEXT),
+    m_open (false),
+    m_field (0),
+    m_records (0),
+    m_binaryHeaderWritten (false)
+{
+}
+
+LteStatsFile::~LteStatsFile ()
+{
+  if (m_flushEvent.PeekEventImpl () != 0)
+    {
+      Simulator::Cancel (m_flushEvent);
+    }
+  if (m_open && (m_format != TEXT))
+    {
+      Flush ();
+      WriteBinaryHeader ();
+      m_file.close ();
+    }
+}
+
+bool
+LteStatsFile::Open (std::string filename, Format format, std::string header, std::string endOfRecord)
+{
+  NS_LOG_FUNCTION (this << filename << format);
+  NS_ASSERT_MSG (!m_open, "file " << m_filename << " already open");
+  std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+  if (format == BINARY)
+    {
+      mode |= std::ios_base::binary;
+    }
+  m_file.open (filename.c_str (), mode);
+  if (!m_file.is_open ())
+    {
+      return false;
+    }
+  m_filename = filename;
+  m_format = format;
+  m_header = header;
+  m_endOfRecord = endOfRecord;
+  m_open = true;
+  if (format != BINARY)
+    {
+      m_file << header << std::endl;
+    }
+  if (format == TEXT)
+    {
+      m_file.close ();
+    }
+  return true;
+}
+
+bool
+LteStatsFile::IsOpen (void) const
+{
+  return m_open;
+}
+
+LteStatsFile::Column &
+LteStatsFile::NextColumn (FieldType type)
+{
+  if (!m_binaryHeaderWritten && (m_records == 0) && (m_field == m_columns.size ()))
+    {
+      Column column;
+      column.type = type;
+      m_columns.push_back (column);
+    }
+  NS_ASSERT_MSG (m_field < m_columns.size (), "too many fields in a record of " << m_filename);
+  NS_ASSERT_MSG (m_columns[m_field].type == type, "wrong type of field " << m_field << " in a record of " << m_filename);
+  return m_columns[m_field++];
+}
+
+std::ostream &
+LteStatsFile::NextTextField (void)
+{
+  std::ostream &os = (m_format == TEXT) ? static_cast<std::ostream &> (m_record) : m_file;
+  if (m_field > 0)
+    {
+      os << "\t";
+    }
+  ++m_field;
+  return os;
+}
+
+void
+LteStatsFile::WriteDouble (double value)
+{
+  NS_ASSERT (m_open);
+  if (m_format == BINARY)
+    {
+      NextColumn (DOUBLE).doubles.push_back (value);
+    }
+  else
+    {
+      NextTextField () << value;
+    }
+}
+
+void
+LteStatsFile::WriteUinteger (uint64_t value)
+{
+  NS_ASSERT (m_open);
+  if (m_format == BINARY)
+    {
+      NextColumn (UINTEGER).integers.push_back (value);
+    }
+  else
+    {
+      NextTextField () << value;
+    }
+}
+
+void
+LteStatsFile::WriteInteger (int64_t value)
+{
+  NS_ASSERT (m_open);
+  if (m_format == BINARY)
+    {
+      NextColumn (INTEGER).integers.push_back (static_cast<uint64_t> (value));
+    }
+  else
+    {
+      NextTextField () << value;
+    }
+}
+
+void
+LteStatsFile::WriteDoubleList (std::vector<double>::const_iterator begin, std::vector<double>::const_iterator end)
+{
+  NS_ASSERT (m_open);
+  if (m_format == BINARY)
+    {
+      Column &column = NextColumn (DOUBLE_LIST);
+      column.counts.push_back (end - begin);
+      column.doubles.insert (column.doubles.end (), begin, end);
+    }
+  else
+    {
+      std::ostream &os = NextTextField ();
+      for (std::vector<double>::const_iterator it = begin; it != end; ++it)
+        {
+          os << *it << " ";
+        }
+    }
+}
+
+void
+LteStatsFile::EndRecord (void)
+{
+  NS_ASSERT (m_open);
+  switch (m_format)
+    {
+    case TEXT:
+      {
+        m_record << m_endOfRecord;
+        std::ofstream outFile (m_filename.c_str (), std::ios_base::app);
+        if (!outFile.is_open ())
+          {
+            NS_LOG_ERROR ("Can't open file " << m_filename);
+          }
+        else
+          {
+            outFile << m_record.str ();
+          }
+        m_record.str ("");
+        break;
+      }
+    case BUFFERED_TEXT:
+      m_file << m_endOfRecord;
+      break;
+    case BINARY:
+      NS_ASSERT_MSG (m_field == m_columns.size (), "missing fields in a record of " << m_filename);
+      if (++m_records == BLOCK_RECORDS)
+        {
+          WriteBlock ();
+        }
+      break;
+    }
+  m_field = 0;
+  if ((m_format != TEXT) && (m_flushEvent.PeekEventImpl () == 0))
+    {
+      m_flushEvent = Simulator::ScheduleDestroy (&LteStatsFile::FlushAtDestroy, this);
+    }
+}
+
+void
+LteStatsFile::Flush (void)
+{
+  NS_LOG_FUNCTION (this << m_filename);
+  if (!m_open || (m_format == TEXT))
+    {
+      return;
+    }
+  if (m_records > 0)
+    {
+      WriteBlock ();
+    }
+  m_file.flush ();
+}
+
+void
+LteStatsFile::FlushAtDestroy (void)
+{
+  m_flushEvent = EventId ();
+  Flush ();
+}
+
+void
+LteStatsFile::WriteBinaryHeader (void)
+{
+  if ((m_format != BINARY) || m_binaryHeaderWritten)
+    {
+      return;
+    }
+  m_binaryHeaderWritten = true;
+  m_file.write (LTE_STATS_FILE_MAGIC, sizeof (LTE_STATS_FILE_MAGIC));
+  WriteValues (m_file, &LTE_STATS_FILE_VERSION, 1);
+  WriteValues (m_file, &LTE_STATS_FILE_BYTE_ORDER, 1);
+  WriteString (m_file, m_header);
+  WriteString (m_file, m_endOfRecord);
+  uint32_t nFields = m_columns.size ();
+  WriteValues (m_file, &nFields, 1);
+  for (std::vector<Column>::const_iterator it = m_columns.begin (); it != m_columns.end (); ++it)
+    {
+      uint8_t type = it->type;
+      WriteValues (m_file, &type, 1);
+    }
+}
+
+void
+LteStatsFile::WriteBlock (void)
+{
+  NS_LOG_FUNCTION (this << m_filename << m_records);
+  WriteBinaryHeader ();
+  WriteValues (m_file, &m_records, 1);
+  for (std::vector<Column>::iterator it = m_columns.begin (); it != m_columns.end (); ++it)
+    {
+      switch (it->type)
+        {
+        case DOUBLE:
+          WriteValues (m_file, it->doubles.data (), it->doubles.size ());
+          break;
+        case UINTEGER:
+        case INTEGER:
+          WriteIntegers (m_file, it->integers, it->type == INTEGER);
+          break;
+        case DOUBLE_LIST:
+          WriteValues (m_file, it->counts.data (), it->counts.size ());
+          WriteValues (m_file, it->doubles.data (), it->doubles.size ());
+          break;
+        }
+      it->doubles.clear ();
+      it->integers.clear ();
+      it->counts.clear ();
+    }
+  m_records = 0;
+}
+
+bool
+LteStatsFile::ConvertToText (std::string binaryFilename, std::string textFilename)
+{
+  NS_LOG_FUNCTION (binaryFilename << textFilename);
+  std::ifstream inFile (binaryFilename.c_str (), std::ios_base::in | std::ios_base::binary);
+  if (!inFile.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << binaryFilename);
+      return false;
+    }
+  char magic[sizeof (LTE_STATS_FILE_MAGIC)];
+  uint32_t version;
+  uint32_t byteOrder;
+  std::string header;
+  std::string endOfRecord;
+  uint32_t nFields;
+  if (!ReadValues (inFile, magic, sizeof (magic))
+      || (std::memcmp (magic, LTE_STATS_FILE_MAGIC, sizeof (magic)) != 0)
+      || !ReadValues (inFile, &version, 1) || (version != LTE_STATS_FILE_VERSION)
+      || !ReadValues (inFile, &byteOrder, 1) || (byteOrder != LTE_STATS_FILE_BYTE_ORDER)
+      || !ReadString (inFile, header) || !ReadString (inFile, endOfRecord)
+      || !ReadValues (inFile, &nFields, 1))
+    {
+      NS_LOG_ERROR ("Not a LTE statistics file of this version and byte order: " << binaryFilename);
+      return false;
+    }
+  std::vector<Column> columns (nFields);
+  for (uint32_t i = 0; i < nFields; ++i)
+    {
+      uint8_t type;
+      if (!ReadValues (inFile, &type, 1) || (type > DOUBLE_LIST))
+        {
+          NS_LOG_ERROR ("Invalid field type in " << binaryFilename);
+          return false;
+        }
+      columns[i].type = static_cast<FieldType> (type);
+    }
+
+  std::ofstream outFile (textFilename.c_str ());
+  if (!outFile.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << textFilename);
+      return false;
+    }
+  outFile << header << std::endl;
+
+  uint32_t nRecords;
+  while (ReadValues (inFile, &nRecords, 1))
+    {
+      std::vector<uint32_t> offsets (nFields, 0);
+      for (std::vector<Column>::iterator it = columns.begin (); it != columns.end (); ++it)
+        {
+          bool ok = true;
+          switch (it->type)
+            {
+            case DOUBLE:
+              it->doubles.resize (nRecords);
+              ok = ReadValues (inFile, it->doubles.data (), nRecords);
+              break;
+            case UINTEGER:
+            case INTEGER:
+              ok = ReadIntegers (inFile, it->integers, nRecords, it->type == INTEGER);
+              break;
+            case DOUBLE_LIST:
+              {
+                it->counts.resize (nRecords);
+                ok = ReadValues (inFile, it->counts.data (), nRecords);
+                uint64_t nValues = 0;
+                for (uint32_t r = 0; ok && (r < nRecords); ++r)
+                  {
+                    nValues += it->counts[r];
+                  }
+                it->doubles.resize (nValues);
+                ok = ok && ReadValues (inFile, it->doubles.data (), nValues);
+                break;
+              }
+            }
+          if (!ok)
+            {
+              NS_LOG_ERROR ("Truncated block in " << binaryFilename);
+              return false;
+            }
+        }
+      for (uint32_t r = 0; r < nRecords; ++r)
+        {
+          for (uint32_t f = 0; f < nFields; ++f)
+            {
+              const Column &column = columns[f];
+              if (f > 0)
+                {
+                  outFile << "\t";
+                }
+              switch (column.type)
+                {
+                case DOUBLE:
+                  outFile << column.doubles[r];
+                  break;
+                case UINTEGER:
+                  outFile << column.integers[r];
+                  break;
+                case INTEGER:
+                  outFile << static_cast<int64_t> (column.integers[r]);
+                  break;
+                case DOUBLE_LIST:
+                  for (uint32_t i = 0; i < column.counts[r]; ++i)
+                    {
+                      outFile << column.doubles[offsets[f]++] << " ";
+                    }
+                  break;
+                }
+            }
+          outFile << endOfRecord;
+        }
+    }
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,204 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_STATS_FILE_H
+#define LTE_STATS_FILE_H
+
+#include <ns3/event-id.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * An output file of the LTE statistics calculators.
+ *
+ * The records written to the file are made of fields, which are
+ * separated by a tab in the text formats; a field is either a number or
+ * a list of numbers, each of them followed by a space. A record is
+ * terminated by the end-of-record string given when opening the file.
+ * The file can be written in the following formats:
+ *
+ *  - TEXT: each record is appended to the text file as soon as it is
+ *    complete, by opening and closing the file again (this is how the
+ *    statistics calculators used to write their files);
+ *  - BUFFERED_TEXT: the same text, but the file is kept open and the
+ *    records are buffered in memory;
+ *  - BINARY: the records are buffered in memory and written in blocks
+ *    of columns, i.e., with the values of each field of the records of
+ *    a block stored contiguously, in the native byte order.
+ *
+ * In the buffered formats, the data are written when the simulator is
+ * destroyed and when the file is destroyed. A binary file can be
+ * converted to the text file which the TEXT format would have produced
+ * with ConvertToText (see also the lte-stats-converter program).
+ *
+ * The binary file starts with the magic "LTESTATS", the version and a
+ * byte order mark (uint32_t), the header and the end-of-record strings
+ * (each as a uint32_t length followed by the characters), the number of
+ * fields (uint32_t) and the type of each field (uint8_t, see
+ * FieldType). Each block then starts with its number of records
+ * (uint32_t), followed, for each field, by the values of the records:
+ * double values; for the integers, the number of bytes of the values
+ * of the block (uint8_t: 1, 2, 4 or 8) followed by the values truncated
+ * to it; or, for the lists, the number of values of each record
+ * (uint32_t) followed by all the values (double).
+ */
+class LteStatsFile
+{
+public:
+  /// The format of the file
+  enum Format
+  {
+    TEXT,
+    BUFFERED_TEXT,
+    BINARY
+  };
+
+  /// The type of a field of the records
+  enum FieldType
+  {
+    DOUBLE = 0,
+    UINTEGER = 1,
+    INTEGER = 2,
+    DOUBLE_LIST = 3
+  };
+
+  LteStatsFile ();
+  ~LteStatsFile ();
+
+  /**
+   * Create the file and write its header.
+   *
+   * \param filename the name of the file
+   * \param format the format of the file
+   * \param header the header line, without the end of line
+   * \param endOfRecord the string terminating each record
+   * \return true if the file could be created
+   */
+  bool Open (std::string filename, Format format, std::string header, std::string endOfRecord = "\n");
+  /**
+   * \return true if the file has been successfully created by Open
+   */
+  bool IsOpen (void) const;
+
+  /**
+   * Write a field of the current record.
+   *
+   * \param value the value of the field
+   */
+  void WriteDouble (double value);
+  /**
+   * Write a field of the current record.
+   *
+   * \param value the value of the field
+   */
+  void WriteUinteger (uint64_t value);
+  /**
+   * Write a field of the current record.
+   *
+   * \param value the value of the field
+   */
+  void WriteInteger (int64_t value);
+  /**
+   * Write a field of the current record made of a list of values.
+   *
+   * \param begin the first value
+   * \param end past the last value
+   */
+  void WriteDoubleList (std::vector<double>::const_iterator begin, std::vector<double>::const_iterator end);
+  /**
+   * Terminate the current record.
+   */
+  void EndRecord (void);
+
+  /**
+   * Write the buffered records to the file.
+   */
+  void Flush (void);
+
+  /**
+   * Convert a file written in the BINARY format to the text file which
+   * the TEXT format would have produced.
+   *
+   * \param binaryFilename the name of the binary file
+   * \param textFilename the name of the text file
+   * \return true if the conversion succeeded
+   */
+  static bool ConvertToText (std::string binaryFilename, std::string textFilename);
+
+private:
+  /// The values of a field of the records of the current block
+  struct Column
+  {
+    FieldType type;                 ///< the type of the field
+    std::vector<double> doubles;    ///< the DOUBLE values, or the values of the lists
+    std::vector<uint64_t> integers; ///< the UINTEGER and INTEGER values
+    std::vector<uint32_t> counts;   ///< the number of values of the lists
+  };
+
+  /// the number of records of the blocks of a binary file
+  static const uint32_t BLOCK_RECORDS = 4096;
+
+  /**
+   * Get the column of the next field of the current record, adding it
+   * while writing the first record.
+   *
+   * \param type the type of the field
+   * \return the column
+   */
+  Column & NextColumn (FieldType type);
+  /**
+   * Get the text stream of the current record, and write the field
+   * separator if needed.
+   *
+   * \return the text stream
+   */
+  std::ostream & NextTextField (void);
+  /**
+   * Write the header of a binary file, if not done yet.
+   */
+  void WriteBinaryHeader (void);
+  /**
+   * Write the records of the current block to a binary file.
+   */
+  void WriteBlock (void);
+  /**
+   * Flush the file when the simulator is destroyed.
+   */
+  void FlushAtDestroy (void);
+
+  std::string m_filename;         ///< the name of the file
+  Format m_format;                ///< the format of the file
+  std::string m_header;           ///< the header line
+  std::string m_endOfRecord;      ///< the string terminating the records
+  bool m_open;                    ///< whether the file has been created
+  std::ofstream m_file;           ///< the file, in the buffered formats
+  std::ostringstream m_record;    ///< the current record, in the TEXT format
+  uint32_t m_field;               ///< the index of the next field of the current record
+  std::vector<Column> m_columns;  ///< the columns of the current block, in the BINARY format
+  uint32_t m_records;             ///< the number of records of the current block
+  bool m_binaryHeaderWritten;     ///< whether the header of the binary file has been written
+  EventId m_flushEvent;           ///< the flush when the simulator is destroyed
+};
+
+} // namespace ns3
+
+#endif /* LTE_STATS_FILE_H */
@@ -32,8 +32,6 @@ NS_LOG_COMPONENT_DEFINE ("MacStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (MacStatsCalculator);
 
 MacStatsCalculator::MacStatsCalculator ()
-  : m_dlFirstWrite (true),
-    m_ulFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -96,41 +94,28 @@ MacStatsCalculator::DlScheduling (uint16_t cellId, uint64_t imsi, DlSchedulingCa
 		  dlSchedulingCallbackInfo.rnti << (uint32_t) dlSchedulingCallbackInfo.mcsTb1 << dlSchedulingCallbackInfo.sizeTb1 << (uint32_t) dlSchedulingCallbackInfo.mcsTb2 << dlSchedulingCallbackInfo.sizeTb2);
   NS_LOG_INFO ("Write DL Mac Stats in " << GetDlOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlFirstWrite == true )
+  if (!m_dlFile.IsOpen ())
     {
-      outFile.open (GetDlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
-      m_dlFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2\tccId";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetDlOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
+      if (!m_dlFile.Open (GetDlOutputFilename (), GetOutputFormat (),
+                          "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2\tccId"))
         {
           NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
           return;
         }
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << (uint32_t) cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << dlSchedulingCallbackInfo.frameNo << "\t";
-  outFile << dlSchedulingCallbackInfo.subframeNo << "\t";
-  outFile << dlSchedulingCallbackInfo.rnti << "\t";
-  outFile << (uint32_t) dlSchedulingCallbackInfo.mcsTb1 << "\t";
-  outFile << dlSchedulingCallbackInfo.sizeTb1 << "\t";
-  outFile << (uint32_t) dlSchedulingCallbackInfo.mcsTb2 << "\t";
-  outFile << dlSchedulingCallbackInfo.sizeTb2 << "\t";
-  outFile << (uint32_t) dlSchedulingCallbackInfo.componentCarrierId << std::endl;
-  outFile.close ();
+  m_dlFile.WriteDouble (Simulator::Now ().GetNanoSeconds () / (double) 1e9);
+  m_dlFile.WriteUinteger (cellId);
+  m_dlFile.WriteUinteger (imsi);
+  m_dlFile.WriteUinteger (dlSchedulingCallbackInfo.frameNo);
+  m_dlFile.WriteUinteger (dlSchedulingCallbackInfo.subframeNo);
+  m_dlFile.WriteUinteger (dlSchedulingCallbackInfo.rnti);
+  m_dlFile.WriteUinteger (dlSchedulingCallbackInfo.mcsTb1);
+  m_dlFile.WriteUinteger (dlSchedulingCallbackInfo.sizeTb1);
+  m_dlFile.WriteUinteger (dlSchedulingCallbackInfo.mcsTb2);
+  m_dlFile.WriteUinteger (dlSchedulingCallbackInfo.sizeTb2);
+  m_dlFile.WriteUinteger (dlSchedulingCallbackInfo.componentCarrierId);
+  m_dlFile.EndRecord ();
 }
 
 void
@@ -140,39 +125,26 @@ MacStatsCalculator::UlScheduling (uint16_t cellId, uint64_t imsi, uint32_t frame
   NS_LOG_FUNCTION (this << cellId << imsi << frameNo << subframeNo << rnti << (uint32_t) mcsTb << size);
   NS_LOG_INFO ("Write UL Mac Stats in " << GetUlOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulFirstWrite == true )
-    {
-      outFile.open (GetUlOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
-        }
-      m_ulFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize\tccId";
-      outFile << std::endl;
-    }
-  else
+  if (!m_ulFile.IsOpen ())
     {
-      outFile.open (GetUlOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
+      if (!m_ulFile.Open (GetUlOutputFilename (), GetOutputFormat (),
+                          "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize\tccId"))
         {
           NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
           return;
         }
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << (uint32_t) cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << frameNo << "\t";
-  outFile << subframeNo << "\t";
-  outFile << rnti << "\t";
-  outFile << (uint32_t) mcsTb << "\t";
-  outFile << size << "\t";
-  outFile << (uint32_t) componentCarrierId << std::endl;
-  outFile.close ();
+  m_ulFile.WriteDouble (Simulator::Now ().GetNanoSeconds () / (double) 1e9);
+  m_ulFile.WriteUinteger (cellId);
+  m_ulFile.WriteUinteger (imsi);
+  m_ulFile.WriteUinteger (frameNo);
+  m_ulFile.WriteUinteger (subframeNo);
+  m_ulFile.WriteUinteger (rnti);
+  m_ulFile.WriteUinteger (mcsTb);
+  m_ulFile.WriteUinteger (size);
+  m_ulFile.WriteUinteger (componentCarrierId);
+  m_ulFile.EndRecord ();
 }
 
 void
@@ -151,20 +151,16 @@ public:
 
 private:
   /**
-   * When writing DL MAC statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * DL MAC statistics output file, whose first line is the
+   * columns description
    */
-  bool m_dlFirstWrite;
+  LteStatsFile m_dlFile;
 
   /**
-   * When writing UL MAC statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * UL MAC statistics output file, whose first line is the
+   * columns description
    */
-  bool m_ulFirstWrite;
+  LteStatsFile m_ulFile;
 
 };
 
@@ -32,8 +32,6 @@ NS_LOG_COMPONENT_DEFINE ("PhyRxStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (PhyRxStatsCalculator);
 
 PhyRxStatsCalculator::PhyRxStatsCalculator ()
-  : m_dlRxFirstWrite (true),
-    m_ulRxFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -95,43 +93,29 @@ PhyRxStatsCalculator::DlPhyReception (PhyReceptionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi << params.m_correctness);
   NS_LOG_INFO ("Write DL Rx Phy Stats in " << GetDlRxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_dlRxFirstWrite == true )
+  if (!m_dlRxFile.IsOpen ())
     {
-      outFile.open (GetDlRxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlRxOutputFilename ().c_str ());
-          return;
-        }
-      m_dlRxFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetDlRxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
+      if (!m_dlRxFile.Open (GetDlRxOutputFilename (), GetOutputFormat (),
+                            "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId"))
         {
           NS_LOG_ERROR ("Can't open file " << GetDlRxOutputFilename ().c_str ());
           return;
         }
     }
 
-//   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
-  outFile << (uint32_t) params.m_txMode << "\t";
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << "\t";
-  outFile << (uint32_t) params.m_correctness << "\t";
-  outFile << (uint32_t) params.m_ccId << std::endl;
-  outFile.close ();
+  m_dlRxFile.WriteInteger (params.m_timestamp);
+  m_dlRxFile.WriteUinteger (params.m_cellId);
+  m_dlRxFile.WriteUinteger (params.m_imsi);
+  m_dlRxFile.WriteUinteger (params.m_rnti);
+  m_dlRxFile.WriteUinteger (params.m_txMode);
+  m_dlRxFile.WriteUinteger (params.m_layer);
+  m_dlRxFile.WriteUinteger (params.m_mcs);
+  m_dlRxFile.WriteUinteger (params.m_size);
+  m_dlRxFile.WriteUinteger (params.m_rv);
+  m_dlRxFile.WriteUinteger (params.m_ndi);
+  m_dlRxFile.WriteUinteger (params.m_correctness);
+  m_dlRxFile.WriteUinteger (params.m_ccId);
+  m_dlRxFile.EndRecord ();
 }
 
 void
@@ -140,42 +124,28 @@ PhyRxStatsCalculator::UlPhyReception (PhyReceptionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi << params.m_correctness);
   NS_LOG_INFO ("Write UL Rx Phy Stats in " << GetUlRxOutputFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_ulRxFirstWrite == true )
-    {
-      outFile.open (GetUlRxOutputFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlRxOutputFilename ().c_str ());
-          return;
-        }
-      m_ulRxFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
-      outFile << std::endl;
-    }
-  else
+  if (!m_ulRxFile.IsOpen ())
     {
-      outFile.open (GetUlRxOutputFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
+      if (!m_ulRxFile.Open (GetUlRxOutputFilename (), GetOutputFormat (),
+                            "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId"))
         {
           NS_LOG_ERROR ("Can't open file " << GetUlRxOutputFilename ().c_str ());
           return;
         }
     }
 
-//   outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << params.m_timestamp << "\t";
-  outFile << (uint32_t) params.m_cellId << "\t";
-  outFile << params.m_imsi << "\t";
-  outFile << params.m_rnti << "\t";
-  outFile << (uint32_t) params.m_layer << "\t";
-  outFile << (uint32_t) params.m_mcs << "\t";
-  outFile << params.m_size << "\t";
-  outFile << (uint32_t) params.m_rv << "\t";
-  outFile << (uint32_t) params.m_ndi << "\t";
-  outFile << (uint32_t) params.m_correctness << "\t";
-  outFile << (uint32_t) params.m_ccId <<std::endl;
-  outFile.close ();
+  m_ulRxFile.WriteInteger (params.m_timestamp);
+  m_ulRxFile.WriteUinteger (params.m_cellId);
+  m_ulRxFile.WriteUinteger (params.m_imsi);
+  m_ulRxFile.WriteUinteger (params.m_rnti);
+  m_ulRxFile.WriteUinteger (params.m_layer);
+  m_ulRxFile.WriteUinteger (params.m_mcs);
+  m_ulRxFile.WriteUinteger (params.m_size);
+  m_ulRxFile.WriteUinteger (params.m_rv);
+  m_ulRxFile.WriteUinteger (params.m_ndi);
+  m_ulRxFile.WriteUinteger (params.m_correctness);
+  m_ulRxFile.WriteUinteger (params.m_ccId);
+  m_ulRxFile.EndRecord ();
 }
 
 void
@@ -127,20 +127,16 @@ public:
 private:
 
   /**
-   * When writing DL RX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * DL PHY reception statistics output file, whose first
+   * line is the columns description
    */
-  bool m_dlRxFirstWrite;
+  LteStatsFile m_dlRxFile;
 
   /**
-   * When writing UL RX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * UL PHY reception statistics output file, whose first
+   * line is the columns description
    */
-  bool m_ulRxFirstWrite;
+  LteStatsFile m_ulRxFile;
 
 };
 
@@ -31,9 +31,6 @@ NS_LOG_COMPONENT_DEFINE ("PhyStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED (PhyStatsCalculator);
 
 PhyStatsCalculator::PhyStatsCalculator ()
-  :  m_RsrpSinrFirstWrite (true),
-    m_UeSinrFirstWrite (true),
-    m_InterferenceFirstWrite (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -115,37 +112,24 @@ PhyStatsCalculator::ReportCurrentCellRsrpSinr (uint16_t cellId, uint64_t imsi, u
   NS_LOG_FUNCTION (this << cellId <<  imsi << rnti  << rsrp << sinr);
   NS_LOG_INFO ("Write RSRP/SINR Phy Stats in " << GetCurrentCellRsrpSinrFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_RsrpSinrFirstWrite == true )
+  if (!m_RsrpSinrFile.IsOpen ())
     {
-      outFile.open (GetCurrentCellRsrpSinrFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetCurrentCellRsrpSinrFilename ().c_str ());
-          return;
-        }
-      m_RsrpSinrFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr\tComponentCarrierId";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetCurrentCellRsrpSinrFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
+      if (!m_RsrpSinrFile.Open (GetCurrentCellRsrpSinrFilename (), GetOutputFormat (),
+                                "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr\tComponentCarrierId"))
         {
           NS_LOG_ERROR ("Can't open file " << GetCurrentCellRsrpSinrFilename ().c_str ());
           return;
         }
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << rnti << "\t";
-  outFile << rsrp << "\t";
-  outFile << sinr << "\t";
-  outFile << (uint32_t)componentCarrierId << std::endl;
-  outFile.close ();
+  m_RsrpSinrFile.WriteDouble (Simulator::Now ().GetNanoSeconds () / (double) 1e9);
+  m_RsrpSinrFile.WriteUinteger (cellId);
+  m_RsrpSinrFile.WriteUinteger (imsi);
+  m_RsrpSinrFile.WriteUinteger (rnti);
+  m_RsrpSinrFile.WriteDouble (rsrp);
+  m_RsrpSinrFile.WriteDouble (sinr);
+  m_RsrpSinrFile.WriteUinteger (componentCarrierId);
+  m_RsrpSinrFile.EndRecord ();
 }
 
 void
@@ -154,36 +138,23 @@ PhyStatsCalculator::ReportUeSinr (uint16_t cellId, uint64_t imsi, uint16_t rnti,
   NS_LOG_FUNCTION (this << cellId <<  imsi << rnti  << sinrLinear);
   NS_LOG_INFO ("Write SINR Linear Phy Stats in " << GetUeSinrFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_UeSinrFirstWrite == true )
+  if (!m_UeSinrFile.IsOpen ())
     {
-      outFile.open (GetUeSinrFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUeSinrFilename ().c_str ());
-          return;
-        }
-      m_UeSinrFirstWrite = false;
-      outFile << "% time\tcellId\tIMSI\tRNTI\tsinrLinear\tcomponentCarrierId";
-      outFile << std::endl;
-    }
-  else
-    {
-      outFile.open (GetUeSinrFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
+      if (!m_UeSinrFile.Open (GetUeSinrFilename (), GetOutputFormat (),
+                              "% time\tcellId\tIMSI\tRNTI\tsinrLinear\tcomponentCarrierId"))
         {
           NS_LOG_ERROR ("Can't open file " << GetUeSinrFilename ().c_str ());
           return;
         }
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << cellId << "\t";
-  outFile << imsi << "\t";
-  outFile << rnti << "\t";
-  outFile << sinrLinear << "\t";
-  outFile << (uint32_t)componentCarrierId << std::endl;
-  outFile.close ();
+  m_UeSinrFile.WriteDouble (Simulator::Now ().GetNanoSeconds () / (double) 1e9);
+  m_UeSinrFile.WriteUinteger (cellId);
+  m_UeSinrFile.WriteUinteger (imsi);
+  m_UeSinrFile.WriteUinteger (rnti);
+  m_UeSinrFile.WriteDouble (sinrLinear);
+  m_UeSinrFile.WriteUinteger (componentCarrierId);
+  m_UeSinrFile.EndRecord ();
 }
 
 void
@@ -192,33 +163,20 @@ PhyStatsCalculator::ReportInterference (uint16_t cellId, Ptr<SpectrumValue> inte
   NS_LOG_FUNCTION (this << cellId <<  interference);
   NS_LOG_INFO ("Write Interference Phy Stats in " << GetInterferenceFilename ().c_str ());
 
-  std::ofstream outFile;
-  if ( m_InterferenceFirstWrite == true )
-    {
-      outFile.open (GetInterferenceFilename ().c_str ());
-      if (!outFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetInterferenceFilename ().c_str ());
-          return;
-        }
-      m_InterferenceFirstWrite = false;
-      outFile << "% time\tcellId\tInterference";
-      outFile << std::endl;
-    }
-  else
+  if (!m_InterferenceFile.IsOpen ())
     {
-      outFile.open (GetInterferenceFilename ().c_str (),  std::ios_base::app);
-      if (!outFile.is_open ())
+      if (!m_InterferenceFile.Open (GetInterferenceFilename (), GetOutputFormat (),
+                                    "% time\tcellId\tInterference"))
         {
           NS_LOG_ERROR ("Can't open file " << GetInterferenceFilename ().c_str ());
           return;
         }
     }
 
-  outFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 << "\t";
-  outFile << cellId << "\t";
-  outFile << *interference;
-  outFile.close ();
+  m_InterferenceFile.WriteDouble (Simulator::Now ().GetNanoSeconds () / (double) 1e9);
+  m_InterferenceFile.WriteUinteger (cellId);
+  m_InterferenceFile.WriteDoubleList (interference->ConstValuesBegin (), interference->ConstValuesEnd ());
+  m_InterferenceFile.EndRecord ();
 }
 
 
@@ -183,28 +183,22 @@ public:
 
 private:
   /**
-   * When writing RSRP SINR statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * RSRP SINR statistics output file, whose first line
+   * is the columns description
    */
-  bool m_RsrpSinrFirstWrite;
+  LteStatsFile m_RsrpSinrFile;
 
   /**
-   * When writing UE SINR statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * UE SINR statistics output file, whose first line
+   * is the columns description
    */
-  bool m_UeSinrFirstWrite;
+  LteStatsFile m_UeSinrFile;
 
   /**
-   * When writing interference statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * Interference statistics output file, whose first line
+   * is the columns description
    */
-  bool m_InterferenceFirstWrite;
+  LteStatsFile m_InterferenceFile;
 
   /**
    * Name of the file where the RSRP/SINR statistics will be saved
@@ -128,20 +128,16 @@ public:
 
 private:
   /**
-   * When writing DL TX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * DL PHY transmission statistics output file, whose first
+   * line is the columns description
    */
-  bool m_dlTxFirstWrite;
+  LteStatsFile m_dlTxFile;
 
   /**
-   * When writing UL TX PHY statistics first time to file,
-   * columns description is added. Then next lines are
-   * appended to file. This value is true if output
-   * files have not been opened yet
+   * UL PHY transmission statistics output file, whose first
+   * line is the columns description
    */
-  bool m_ulTxFirstWrite;
+  LteStatsFile m_ulTxFile;
 
 };
 
@@ -33,16 +33,14 @@ NS_LOG_COMPONENT_DEFINE ("RadioBearerStatsCalculator");
 NS_OBJECT_ENSURE_REGISTERED ( RadioBearerStatsCalculator);
 
 RadioBearerStatsCalculator::RadioBearerStatsCalculator ()
-  : m_firstWrite (true),
-    m_pendingOutput (false), 
+  : m_pendingOutput (false),
     m_protocolType ("RLC")
 {
   NS_LOG_FUNCTION (this);
 }
 
 RadioBearerStatsCalculator::RadioBearerStatsCalculator (std::string protocolType)
-  : m_firstWrite (true),
-    m_pendingOutput (false)
+  : m_pendingOutput (false)
 {
   NS_LOG_FUNCTION (this);
   m_protocolType = protocolType;
@@ -216,59 +214,30 @@ RadioBearerStatsCalculator::ShowResults (void)
   NS_LOG_FUNCTION (this << GetUlOutputFilename ().c_str () << GetDlOutputFilename ().c_str ());
   NS_LOG_INFO ("Write Rlc Stats in " << GetUlOutputFilename ().c_str () << " and in " << GetDlOutputFilename ().c_str ());
 
-  std::ofstream ulOutFile;
-  std::ofstream dlOutFile;
-
-  if (m_firstWrite == true)
+  std::string header = "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
+  header += "delay\tstdDev\tmin\tmax\t";
+  header += "PduSize\tstdDev\tmin\tmax";
+  if (!m_ulFile.IsOpen ()
+      && !m_ulFile.Open (GetUlOutputFilename (), GetOutputFormat (), header, "\t\n"))
     {
-      ulOutFile.open (GetUlOutputFilename ().c_str ());
-      if (!ulOutFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
-        }
-
-      dlOutFile.open (GetDlOutputFilename ().c_str ());
-      if (!dlOutFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
-      m_firstWrite = false;
-      ulOutFile << "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
-      ulOutFile << "delay\tstdDev\tmin\tmax\t";
-      ulOutFile << "PduSize\tstdDev\tmin\tmax";
-      ulOutFile << std::endl;
-      dlOutFile << "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
-      dlOutFile << "delay\tstdDev\tmin\tmax\t";
-      dlOutFile << "PduSize\tstdDev\tmin\tmax";
-      dlOutFile << std::endl;
+      NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
+      return;
     }
-  else
+  if (!m_dlFile.IsOpen ()
+      && !m_dlFile.Open (GetDlOutputFilename (), GetOutputFormat (), header, "\t\n"))
     {
-      ulOutFile.open (GetUlOutputFilename ().c_str (), std::ios_base::app);
-      if (!ulOutFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetUlOutputFilename ().c_str ());
-          return;
-        }
-
-      dlOutFile.open (GetDlOutputFilename ().c_str (), std::ios_base::app);
-      if (!dlOutFile.is_open ())
-        {
-          NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
-          return;
-        }
+      NS_LOG_ERROR ("Can't open file " << GetDlOutputFilename ().c_str ());
+      return;
     }
 
-  WriteUlResults (ulOutFile);
-  WriteDlResults (dlOutFile);
+  WriteUlResults (m_ulFile);
+  WriteDlResults (m_dlFile);
   m_pendingOutput = false;
 
 }
 
 void
-RadioBearerStatsCalculator::WriteUlResults (std::ofstream& outFile)
+RadioBearerStatsCalculator::WriteUlResults (LteStatsFile& outFile)
 {
   NS_LOG_FUNCTION (this);
 
@@ -302,34 +271,32 @@ RadioBearerStatsCalculator::WriteUlResults (std::ofstream& outFile)
       LteFlowId_t flowId = flowIdIt->second;
       NS_ASSERT_MSG (flowId.m_lcId == p.m_lcId, "lcid mismatch");
 
-      outFile << m_startTime.GetNanoSeconds () / 1.0e9 << "\t";
-      outFile << endTime.GetNanoSeconds () / 1.0e9 << "\t";
-      outFile << GetUlCellId (p.m_imsi, p.m_lcId) << "\t";
-      outFile << p.m_imsi << "\t";
-      outFile << flowId.m_rnti << "\t";
-      outFile << (uint32_t) flowId.m_lcId << "\t";
-      outFile << GetUlTxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetUlTxData (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetUlRxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetUlRxData (p.m_imsi, p.m_lcId) << "\t";
+      outFile.WriteDouble (m_startTime.GetNanoSeconds () / 1.0e9);
+      outFile.WriteDouble (endTime.GetNanoSeconds () / 1.0e9);
+      outFile.WriteUinteger (GetUlCellId (p.m_imsi, p.m_lcId));
+      outFile.WriteUinteger (p.m_imsi);
+      outFile.WriteUinteger (flowId.m_rnti);
+      outFile.WriteUinteger (flowId.m_lcId);
+      outFile.WriteUinteger (GetUlTxPackets (p.m_imsi, p.m_lcId));
+      outFile.WriteUinteger (GetUlTxData (p.m_imsi, p.m_lcId));
+      outFile.WriteUinteger (GetUlRxPackets (p.m_imsi, p.m_lcId));
+      outFile.WriteUinteger (GetUlRxData (p.m_imsi, p.m_lcId));
       std::vector<double> stats = GetUlDelayStats (p.m_imsi, p.m_lcId);
       for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
         {
-          outFile << (*it) * 1e-9 << "\t";
+          outFile.WriteDouble ((*it) * 1e-9);
         }
       stats = GetUlPduSizeStats (p.m_imsi, p.m_lcId);
       for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
         {
-          outFile << (*it) << "\t";
+          outFile.WriteDouble (*it);
         }
-      outFile << std::endl;
+      outFile.EndRecord ();
     }
-
-  outFile.close ();
 }
 
 void
-RadioBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
+RadioBearerStatsCalculator::WriteDlResults (LteStatsFile& outFile)
 {
   NS_LOG_FUNCTION (this);
 
@@ -363,30 +330,28 @@ RadioBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
       LteFlowId_t flowId = flowIdIt->second;
       NS_ASSERT_MSG (flowId.m_lcId == p.m_lcId, "lcid mismatch");
 
-      outFile << m_startTime.GetNanoSeconds () / 1.0e9 << "\t";
-      outFile << endTime.GetNanoSeconds () / 1.0e9 << "\t";
-      outFile << GetDlCellId (p.m_imsi, p.m_lcId) << "\t";
-      outFile << p.m_imsi << "\t";
-      outFile << flowId.m_rnti << "\t";
-      outFile << (uint32_t) flowId.m_lcId << "\t";
-      outFile << GetDlTxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetDlTxData (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetDlRxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetDlRxData (p.m_imsi, p.m_lcId) << "\t";
+      outFile.WriteDouble (m_startTime.GetNanoSeconds () / 1.0e9);
+      outFile.WriteDouble (endTime.GetNanoSeconds () / 1.0e9);
+      outFile.WriteUinteger (GetDlCellId (p.m_imsi, p.m_lcId));
+      outFile.WriteUinteger (p.m_imsi);
+      outFile.WriteUinteger (flowId.m_rnti);
+      outFile.WriteUinteger (flowId.m_lcId);
+      outFile.WriteUinteger (GetDlTxPackets (p.m_imsi, p.m_lcId));
+      outFile.WriteUinteger (GetDlTxData (p.m_imsi, p.m_lcId));
+      outFile.WriteUinteger (GetDlRxPackets (p.m_imsi, p.m_lcId));
+      outFile.WriteUinteger (GetDlRxData (p.m_imsi, p.m_lcId));
       std::vector<double> stats = GetDlDelayStats (p.m_imsi, p.m_lcId);
       for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
         {
-          outFile << (*it) * 1e-9 << "\t";
+          outFile.WriteDouble ((*it) * 1e-9);
         }
       stats = GetDlPduSizeStats (p.m_imsi, p.m_lcId);
       for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
         {
-          outFile << (*it) << "\t";
+          outFile.WriteDouble (*it);
         }
-      outFile << std::endl;
+      outFile.EndRecord ();
     }
-
-  outFile.close ();
 }
 
 void
@@ -353,26 +353,23 @@ private:
    * Called after each epoch to write collected
    * statistics to output files. During first call
    * it opens output files and write columns descriptions.
-   * During next calls it opens output files in append mode.
    */
   void
   ShowResults (void);
 
   /**
-   * Writes collected statistics to UL output file and
-   * closes UL output file.
-   * @param outFile ofstream for UL statistics
+   * Writes collected statistics to UL output file.
+   * @param outFile output file for UL statistics
    */
   void
-  WriteUlResults (std::ofstream& outFile);
+  WriteUlResults (LteStatsFile& outFile);
 
   /**
-   * Writes collected statistics to DL output file and
-   * closes DL output file.
-   * @param outFile ofstream for DL statistics
+   * Writes collected statistics to DL output file.
+   * @param outFile output file for DL statistics
    */
   void
-  WriteDlResults (std::ofstream& outFile);
+  WriteDlResults (LteStatsFile& outFile);
 
   /**
    * Erases collected statistics
@@ -424,9 +421,14 @@ private:
   Time m_epochDuration;
 
   /**
-   * true if output files have not been opened yet
+   * UL output file
    */
-  bool m_firstWrite;
+  LteStatsFile m_ulFile;
+
+  /**
+   * DL output file
+   */
+  LteStatsFile m_dlFile;
 
   /**
    * true if any output is pending
@@ -37,9 +37,26 @@
 #include <ns3/node.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/lte-spectrum-value-helper.h>
+#include <ns3/node-list.h>
+#include <ns3/building-list.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-spectrum-phy.h>
+#include <ns3/component-carrier-enb.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/antenna-model.h>
+#include <ns3/core-config.h>
+#ifdef HAVE_PTHREAD_H
+#include <ns3/system-thread.h>
+#endif
 
 #include <fstream>
 #include <limits>
+#include <cmath>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -47,6 +64,209 @@ NS_LOG_COMPONENT_DEFINE ("RadioEnvironmentMapHelper");
 
 NS_OBJECT_ENSURE_REGISTERED (RadioEnvironmentMapHelper);
 
+
+/**
+ * \param psd a PSD
+ * \param rbId the RB over which the power is measured, or -1 for the
+ * whole band
+ * \return the power measured by the map, as done by RemSpectrumPhy
+ */
+static double
+CalcRemPower (const SpectrumValue &psd, int32_t rbId)
+{
+  if (rbId >= 0)
+    {
+      return psd[rbId] * 180000;
+    }
+  return Integral (psd);
+}
+
+/**
+ * \param model the first loss model of a chain, possibly 0
+ * \return true if all the loss models of the chain are known not to
+ * change any state when called, so that they can be called concurrently
+ */
+static bool
+IsStatelessLossChain (Ptr<PropagationLossModel> model)
+{
+  for (; model != 0; model = model->GetNext ())
+    {
+      TypeId tid = model->GetInstanceTypeId ();
+      if (tid != FriisPropagationLossModel::GetTypeId ()
+          && tid != LogDistancePropagationLossModel::GetTypeId ()
+          && tid != ThreeLogDistancePropagationLossModel::GetTypeId ()
+          && tid != FixedRssLossModel::GetTypeId ()
+          && tid != RangePropagationLossModel::GetTypeId ())
+        {
+          NS_LOG_LOGIC ("loss model " << tid.GetName () << " may change its state when called");
+          return false;
+        }
+    }
+  return true;
+}
+
+
+/// An eNB transmitting on the channel of the map
+struct RemTransmitter
+{
+  Ptr<MobilityModel> mobility;  ///< mobility model of the eNB
+  Ptr<AntennaModel> antenna;    ///< antenna of the eNB, possibly 0
+  Ptr<const SpectrumValue> psd; ///< transmit PSD, as seen by the map
+  double power;                 ///< power measured by the map from psd
+};
+
+
+/**
+ * Computes the SINR of a range of points for the direct computation of
+ * the map.
+ *
+ * The loss models and the antennas are shared, while each worker
+ * passes its own mobility models to them, since reference counting is
+ * not thread-safe. Hence several workers can run in parallel as long
+ * as neither the loss models nor the antennas change any state when
+ * called.
+ */
+class RemDirectWorker
+{
+public:
+  /**
+   * \param transmitters the eNBs transmitting on the channel
+   * \param propagationLoss the single-frequency loss model, possibly 0
+   * \param spectrumLoss the frequency-dependent loss model, possibly 0
+   * \param maxLossDb the maximum loss of the channel
+   * \param noisePower the noise power (W)
+   * \param rbId the RB for which the map is computed, or -1
+   * \param copyMobility if true, use copies of the mobility models of
+   * the eNBs, so that the worker can run in its own thread
+   */
+  RemDirectWorker (const std::vector<RemTransmitter> *transmitters,
+                   Ptr<PropagationLossModel> propagationLoss,
+                   Ptr<SpectrumPropagationLossModel> spectrumLoss,
+                   double maxLossDb, double noisePower, int32_t rbId,
+                   bool copyMobility);
+
+  /**
+   * \param points the points for which the SINR is to be computed
+   * \param sinr where the SINR of each point is written
+   * \param n the number of points
+   */
+  void SetPoints (const Vector *points, double *sinr, uint32_t n);
+
+  /// Compute the SINR of the points
+  void Run ();
+
+private:
+  const std::vector<RemTransmitter> *m_transmitters;  ///< the eNBs
+  std::vector<Ptr<MobilityModel> > m_txMobility;     ///< mobility of each eNB
+  Ptr<MobilityModel> m_rxMobility;                   ///< mobility of the points
+  PropagationLossModel *m_propagationLoss;           ///< single-frequency loss model
+  SpectrumPropagationLossModel *m_spectrumLoss;      ///< frequency-dependent loss model
+  bool m_hasBuildings;   ///< whether buildings are present
+  double m_maxLossDb;    ///< maximum loss (dB)
+  double m_noisePower;   ///< noise power (W)
+  int32_t m_rbId;        ///< RB of the map
+  const Vector *m_points;  ///< points to be computed
+  double *m_sinr;          ///< SINR of the points
+  uint32_t m_nPoints;      ///< number of points
+};
+
+RemDirectWorker::RemDirectWorker (const std::vector<RemTransmitter> *transmitters,
+                                  Ptr<PropagationLossModel> propagationLoss,
+                                  Ptr<SpectrumPropagationLossModel> spectrumLoss,
+                                  double maxLossDb, double noisePower, int32_t rbId,
+                                  bool copyMobility)
+  : m_transmitters (transmitters),
+    m_propagationLoss (PeekPointer (propagationLoss)),
+    m_spectrumLoss (PeekPointer (spectrumLoss)),
+    m_hasBuildings (BuildingList::GetNBuildings () > 0),
+    m_maxLossDb (maxLossDb),
+    m_noisePower (noisePower),
+    m_rbId (rbId),
+    m_points (0),
+    m_sinr (0),
+    m_nPoints (0)
+{
+  for (std::vector<RemTransmitter>::const_iterator it = transmitters->begin ();
+       it != transmitters->end ();
+       ++it)
+    {
+      if (copyMobility)
+        {
+          Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+          mobility->SetPosition (it->mobility->GetPosition ());
+          mobility->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+          m_txMobility.push_back (mobility);
+        }
+      else
+        {
+          m_txMobility.push_back (it->mobility);
+        }
+    }
+  m_rxMobility = CreateObject<ConstantPositionMobilityModel> ();
+  m_rxMobility->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+}
+
+void
+RemDirectWorker::SetPoints (const Vector *points, double *sinr, uint32_t n)
+{
+  m_points = points;
+  m_sinr = sinr;
+  m_nPoints = n;
+}
+
+void
+RemDirectWorker::Run ()
+{
+  for (uint32_t i = 0; i < m_nPoints; ++i)
+    {
+      m_rxMobility->SetPosition (m_points[i]);
+      if (m_hasBuildings)
+        {
+          // only single-threaded workers get here
+          BuildingsHelper::MakeConsistent (m_rxMobility);
+        }
+      double sumPower = 0;
+      double referenceSignalPower = 0;
+      for (uint32_t j = 0; j < m_transmitters->size (); ++j)
+        {
+          const RemTransmitter &tx = (*m_transmitters)[j];
+          Ptr<MobilityModel> txMobility = m_txMobility[j];
+          double pathLossDb = 0;
+          if (tx.antenna != 0)
+            {
+              Angles txAngles (m_points[i], txMobility->GetPosition ());
+              pathLossDb -= tx.antenna->GetGainDb (txAngles);
+            }
+          if (m_propagationLoss != 0)
+            {
+              pathLossDb -= m_propagationLoss->CalcRxPower (0, txMobility, m_rxMobility);
+            }
+          if (pathLossDb > m_maxLossDb)
+            {
+              // beyond range
+              continue;
+            }
+          double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+          double power;
+          if (m_spectrumLoss != 0)
+            {
+              Ptr<SpectrumValue> psd = Copy<SpectrumValue> (tx.psd);
+              *psd *= pathGainLinear;
+              psd = m_spectrumLoss->CalcRxPowerSpectralDensity (psd, txMobility, m_rxMobility);
+              power = CalcRemPower (*psd, m_rbId);
+            }
+          else
+            {
+              power = tx.power * pathGainLinear;
+            }
+          sumPower += power;
+          referenceSignalPower = std::max (referenceSignalPower, power);
+        }
+      m_sinr[i] = referenceSignalPower / (sumPower - referenceSignalPower + m_noisePower);
+    }
+}
+
+
 RadioEnvironmentMapHelper::RadioEnvironmentMapHelper ()
 {
 }
@@ -144,6 +364,22 @@ RadioEnvironmentMapHelper::GetTypeId (void)
                    IntegerValue (-1),
                    MakeIntegerAccessor (&RadioEnvironmentMapHelper::m_rbId),
                    MakeIntegerChecker<int32_t> ())
+    .AddAttribute ("UseDirectComputation",
+                   "If true, the SINR of each point is computed directly from the "
+                   "transmit PSD and the antenna of the eNBs and from the loss models "
+                   "of the channel, instead of simulating the reception of the signals",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RadioEnvironmentMapHelper::m_useDirectComputation),
+                   MakeBooleanChecker ())
+    .AddAttribute ("NumThreads",
+                   "Number of threads used by the direct computation. More than one "
+                   "thread is used only if all the loss models of the channel are "
+                   "Friis, LogDistance, ThreeLogDistance, FixedRss or Range loss models, "
+                   "i.e., models which do not change any state when called, and if "
+                   "there are neither buildings nor a frequency-dependent loss model.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&RadioEnvironmentMapHelper::m_numThreads),
+                   MakeUintegerChecker<uint32_t> (1, 256))
   ;
   return tid;
 }
@@ -208,6 +444,14 @@ RadioEnvironmentMapHelper::Install ()
       startDelay = 0.5001;
     }
 
+  if (m_useDirectComputation)
+    {
+      Simulator::Schedule (Seconds (startDelay),
+                           &RadioEnvironmentMapHelper::ComputeDirectly,
+                           this);
+      return;
+    }
+
   Simulator::Schedule (Seconds (startDelay),
                        &RadioEnvironmentMapHelper::DelayedInstall,
                        this);
@@ -351,5 +595,161 @@ RadioEnvironmentMapHelper::Finalize ()
     }
 }
 
+void
+RadioEnvironmentMapHelper::ComputeDirectly ()
+{
+  NS_LOG_FUNCTION (this);
+  m_xStep = (m_xMax - m_xMin)/(m_xRes-1);
+  m_yStep = (m_yMax - m_yMin)/(m_yRes-1);
+
+  Ptr<const SpectrumModel> remModel = LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth);
+  // signals are converted to the SpectrumModel of the map only by a
+  // MultiModelSpectrumChannel, as done for the RemSpectrumPhy instances
+  bool convert = (DynamicCast<MultiModelSpectrumChannel> (m_channel) != 0);
+
+  // the eNBs transmitting on the channel, with the PSD of the control
+  // frames, i.e., all RBs at full power; the PSD of the data frames
+  // depends on the scheduling, hence a fully loaded cell is assumed
+  std::vector<RemTransmitter> transmitters;
+  for (NodeList::Iterator nodeIt = NodeList::Begin (); nodeIt != NodeList::End (); ++nodeIt)
+    {
+      for (uint32_t i = 0; i < (*nodeIt)->GetNDevices (); ++i)
+        {
+          Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice> ((*nodeIt)->GetDevice (i));
+          if (enbDev == 0)
+            {
+              continue;
+            }
+          std::map<uint8_t, Ptr<ComponentCarrierBaseStation> > ccMap = enbDev->GetCcMap ();
+          for (std::map<uint8_t, Ptr<ComponentCarrierBaseStation> >::iterator ccIt = ccMap.begin ();
+               ccIt != ccMap.end ();
+               ++ccIt)
+            {
+              Ptr<ComponentCarrierEnb> cc = DynamicCast<ComponentCarrierEnb> (ccIt->second);
+              Ptr<LteEnbPhy> phy = cc->GetPhy ();
+              Ptr<LteSpectrumPhy> dlPhy = phy->GetDownlinkSpectrumPhy ();
+              if (dlPhy->GetChannel () != m_channel)
+                {
+                  continue;
+                }
+              std::vector<int> rbs;
+              for (uint8_t rb = 0; rb < cc->GetDlBandwidth (); ++rb)
+                {
+                  rbs.push_back (rb);
+                }
+              Ptr<SpectrumValue> psd = LteSpectrumValueHelper::CreateTxPowerSpectralDensity (cc->GetDlEarfcn (), cc->GetDlBandwidth (),
+                                                                                            phy->GetTxPower (), rbs);
+              if (convert && psd->GetSpectrumModelUid () != remModel->GetUid ())
+                {
+                  if (psd->GetSpectrumModel ()->IsOrthogonal (*remModel))
+                    {
+                      NS_LOG_LOGIC ("skipping eNB " << enbDev->GetCellId () << " on an orthogonal band");
+                      continue;
+                    }
+                  psd = SpectrumConverter::Get (psd->GetSpectrumModel (), remModel)->Convert (psd);
+                }
+              RemTransmitter tx;
+              tx.mobility = dlPhy->GetMobility ();
+              tx.antenna = dlPhy->GetRxAntenna ();
+              if (tx.antenna != 0)
+                {
+                  // build the gain table of the antenna, if any, now
+                  // rather than from the workers
+                  tx.antenna->Initialize ();
+                }
+              tx.psd = psd;
+              tx.power = CalcRemPower (*psd, m_rbId);
+              NS_ABORT_MSG_IF (tx.mobility == 0, "eNB " << enbDev->GetCellId () << " has no mobility model");
+              transmitters.push_back (tx);
+            }
+        }
+    }
+  NS_LOG_LOGIC ("computing the map from " << transmitters.size () << " transmitters");
+
+  // the loss models are called concurrently only if they are known
+  // not to change any state when called
+  uint32_t numThreads = m_numThreads;
+  Ptr<SpectrumPropagationLossModel> spectrumLoss = m_channel->GetSpectrumPropagationLossModel ();
+  if (spectrumLoss != 0 || BuildingList::GetNBuildings () > 0
+      || !IsStatelessLossChain (m_channel->GetPropagationLossModel ()))
+    {
+      numThreads = 1;
+    }
+#ifndef HAVE_PTHREAD_H
+  numThreads = 1;
+#endif
+  NS_LOG_LOGIC ("using " << numThreads << " threads");
+
+  std::vector<RemDirectWorker *> workers;
+  for (uint32_t t = 0; t < numThreads; ++t)
+    {
+      workers.push_back (new RemDirectWorker (&transmitters, m_channel->GetPropagationLossModel (), spectrumLoss,
+                                              m_channel->GetMaxLossDb (), m_noisePower, m_rbId, numThreads > 1));
+    }
+
+  uint32_t tileSize = std::min<double> (m_maxPointsPerIteration, (double) m_xRes * (double) m_yRes);
+  std::vector<Vector> points;
+  std::vector<double> sinr (tileSize);
+  points.reserve (tileSize);
+  for (double x = m_xMin; x < m_xMax + 0.5*m_xStep; x += m_xStep)
+    {
+      for (double y = m_yMin; y < m_yMax + 0.5*m_yStep ; y += m_yStep)
+        {
+          points.push_back (Vector (x, y, m_z));
+          bool last = (x > m_xMax - 0.5*m_xStep) && (y > m_yMax - 0.5*m_yStep);
+          if (points.size () < tileSize && !last)
+            {
+              continue;
+            }
+
+          // compute the tile
+          uint32_t n = points.size ();
+          uint32_t pointsPerThread = (n + numThreads - 1) / numThreads;
+#ifdef HAVE_PTHREAD_H
+          std::vector<Ptr<SystemThread> > threads;
+#endif
+          for (uint32_t t = 0; t < numThreads; ++t)
+            {
+              uint32_t begin = std::min (t * pointsPerThread, n);
+              uint32_t end = std::min (begin + pointsPerThread, n);
+              workers[t]->SetPoints (&points[begin], &sinr[begin], end - begin);
+#ifdef HAVE_PTHREAD_H
+              if (numThreads > 1)
+                {
+                  Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&RemDirectWorker::Run, workers[t]));
+                  thread->Start ();
+                  threads.push_back (thread);
+                  continue;
+                }
+#endif
+              workers[t]->Run ();
+            }
+#ifdef HAVE_PTHREAD_H
+          for (std::vector<Ptr<SystemThread> >::iterator it = threads.begin (); it != threads.end (); ++it)
+            {
+              (*it)->Join ();
+            }
+#endif
+
+          // stream the tile to the output file
+          for (uint32_t i = 0; i < n; ++i)
+            {
+              m_outFile << points[i].x << "\t"
+                        << points[i].y << "\t"
+                        << points[i].z << "\t"
+                        << sinr[i]
+                        << std::endl;
+            }
+          points.clear ();
+        }
+    }
+
+  for (std::vector<RemDirectWorker *>::iterator it = workers.begin (); it != workers.end (); ++it)
+    {
+      delete *it;
+    }
+  Finalize ();
+}
+
 
 } // namespace ns3
@@ -108,6 +108,21 @@ private:
   /// Called when the map generation procedure has been completed.
   void Finalize ();
 
+  /**
+   * Scheduled by Install() instead of DelayedInstall() when the
+   * `UseDirectComputation` attribute is true.
+   *
+   * The SINR of each point is computed from the transmit PSD and the
+   * antenna of each eNB attached to the channel, and from the loss
+   * models of the channel, without simulating the reception of the
+   * signals. The map is divided into tiles of at most
+   * `MaxPointsPerIteration` points; the points of a tile are shared
+   * among `NumThreads` threads, and the tile is written to the output
+   * file before the next one is computed. Finalize() is called at the
+   * end.
+   */
+  void ComputeDirectly ();
+
   /// A complete Radio Environment Map is composed of many of this structure.
   struct RemPoint 
   {
@@ -152,6 +167,9 @@ private:
   bool m_useDataChannel;  ///< The `UseDataChannel` attribute.
   int32_t m_rbId;         ///< The `RbId` attribute.
 
+  bool m_useDirectComputation;  ///< The `UseDirectComputation` attribute.
+  uint32_t m_numThreads;        ///< The `NumThreads` attribute.
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 
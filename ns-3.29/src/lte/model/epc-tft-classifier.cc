@@ -27,10 +27,8 @@
 #include "epc-tft.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
-#include "ns3/ipv4-header.h"
-#include "ns3/ipv6-header.h"
-#include "ns3/udp-header.h"
-#include "ns3/tcp-header.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/tcp-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
@@ -41,6 +39,7 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("EpcTftClassifier");
 
 EpcTftClassifier::EpcTftClassifier ()
+  : m_compiled (true)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -50,6 +49,8 @@ EpcTftClassifier::Add (Ptr<EpcTft> tft, uint32_t id)
 {
   NS_LOG_FUNCTION (this << tft << id);
   m_tftMap[id] = tft;
+  m_compiled = false;
+  m_classifiedIpv4Flows.clear ();
 
   // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
   NS_ASSERT (m_tftMap.size () <= 16);
@@ -60,25 +61,124 @@ EpcTftClassifier::Delete (uint32_t id)
 {
   NS_LOG_FUNCTION (this << id);
   m_tftMap.erase (id);
+  m_compiled = false;
+  m_classifiedIpv4Flows.clear ();
 }
 
+void
+EpcTftClassifier::Compile (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_compiledFilters.clear ();
+  // we use a reverse iterator since filter priority is not implemented properly.
+  // This way, since the default bearer is expected to be added first, it will be evaluated last.
+  for (std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it = m_tftMap.rbegin ();
+       it != m_tftMap.rend ();
+       ++it)
+    {
+      std::list<EpcTft::PacketFilter> filters = it->second->GetPacketFilters ();
+      for (std::list<EpcTft::PacketFilter>::const_iterator fit = filters.begin ();
+           fit != filters.end ();
+           ++fit)
+        {
+          CompiledPacketFilter f;
+          f.id = it->first;
+          f.direction = fit->direction;
+          f.remoteMask = fit->remoteMask.Get ();
+          f.remoteAddress = fit->remoteAddress.Get () & f.remoteMask;
+          f.localMask = fit->localMask.Get ();
+          f.localAddress = fit->localAddress.Get () & f.localMask;
+          f.remotePortStart = fit->remotePortStart;
+          f.remotePortEnd = fit->remotePortEnd;
+          f.localPortStart = fit->localPortStart;
+          f.localPortEnd = fit->localPortEnd;
+          f.typeOfServiceMask = fit->typeOfServiceMask;
+          f.typeOfService = fit->typeOfService & fit->typeOfServiceMask;
+          m_compiledFilters.push_back (f);
+        }
+    }
+  m_compiled = true;
+  NS_LOG_LOGIC ("compiled " << m_compiledFilters.size () << " packet filters of " << m_tftMap.size () << " TFTs");
+}
+
+uint32_t
+EpcTftClassifier::Match (EpcTft::Direction direction, bool matchAddresses,
+                         uint32_t remoteAddress, uint32_t localAddress,
+                         uint16_t remotePort, uint16_t localPort, uint8_t tos) const
+{
+  for (std::vector<CompiledPacketFilter>::const_iterator it = m_compiledFilters.begin ();
+       it != m_compiledFilters.end ();
+       ++it)
+    {
+      if ((direction & it->direction)
+          && (!matchAddresses
+              || (((remoteAddress & it->remoteMask) == it->remoteAddress)
+                  && ((localAddress & it->localMask) == it->localAddress)))
+          && (remotePort >= it->remotePortStart) && (remotePort <= it->remotePortEnd)
+          && (localPort >= it->localPortStart) && (localPort <= it->localPortEnd)
+          && ((tos & it->typeOfServiceMask) == it->typeOfService))
+        {
+          NS_LOG_LOGIC ("matches with TFT ID = " << it->id);
+          return it->id;
+        }
+    }
+  NS_LOG_LOGIC ("no match");
+  return 0;  // no match
+}
+
+size_t
+EpcTftClassifier::Ipv4FlowKeyHash::operator() (const Ipv4FlowKey_t& key) const
+{
+  uint64_t addresses = ((uint64_t) std::get<0> (key) << 32) | std::get<1> (key);
+  uint64_t others = ((uint64_t) std::get<2> (key) << 48) | ((uint64_t) std::get<3> (key) << 32)
+    | ((uint64_t) std::get<4> (key) << 16) | ((uint64_t) std::get<5> (key) << 8) | std::get<6> (key);
+  uint64_t h = (addresses ^ (others * 0x9e3779b97f4a7c15ULL)) * 0xff51afd7ed558ccdULL;
+  return (size_t) (h ^ (h >> 32));
+}
+
+/**
+ * Read a 16 bits field in network byte order
+ *
+ * \param buffer the field
+ * \return the value of the field
+ */
+static uint16_t
+ReadNtohU16 (const uint8_t *buffer)
+{
+  return (buffer[0] << 8) | buffer[1];
+}
+
+/**
+ * Read a 32 bits field in network byte order
+ *
+ * \param buffer the field
+ * \return the value of the field
+ */
+static uint32_t
+ReadNtohU32 (const uint8_t *buffer)
+{
+  return ((uint32_t) buffer[0] << 24) | ((uint32_t) buffer[1] << 16) | ((uint32_t) buffer[2] << 8) | buffer[3];
+}
  
 uint32_t 
 EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
 {
   NS_LOG_FUNCTION (this << p << p->GetSize () << direction);
 
-  Ptr<Packet> pCopy = p->Copy ();
-
-  uint8_t ipType;
-  pCopy->CopyData (&ipType, 1);
-  ipType = (ipType>>4) & 0x0f;
+  if (!m_compiled)
+    {
+      Compile ();
+    }
 
-  Ipv4Address localAddressIpv4;
-  Ipv4Address remoteAddressIpv4;
+  // The IP header and the UDP/TCP ports are read from the bytes of the
+  // packet, instead of copying the packet and removing its headers:
+  // the largest IPv4 header is 60 bytes long, and the ports are the
+  // first 4 bytes of both the UDP and the TCP header.
+  uint8_t buffer[64];
+  uint32_t size = p->CopyData (buffer, sizeof (buffer));
+  NS_ABORT_MSG_IF (size < 1, "EpcTftClassifier::Classify - Empty packet");
 
-  Ipv6Address localAddressIpv6;
-  Ipv6Address remoteAddressIpv6;
+  uint8_t ipType = (buffer[0]>>4) & 0x0f;
 
   uint8_t protocol;
   uint8_t tos;
@@ -88,31 +188,31 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
 
   if (ipType == 0x04)
     {
-      Ipv4Header ipv4Header;
-      pCopy->RemoveHeader (ipv4Header);
-
+      NS_ABORT_MSG_IF (size < 20, "EpcTftClassifier::Classify - Truncated IPv4 header");
+      uint16_t headerSize = (buffer[0] & 0x0f) * 4;
+      tos = buffer[1];
+      uint16_t payloadSize = ReadNtohU16 (buffer + 2) - headerSize;
+      uint16_t identification = ReadNtohU16 (buffer + 4);
+      uint16_t fragmentOffset = ReadNtohU16 (buffer + 6) & 0x1fff;
+      bool isLastFragment = (ReadNtohU16 (buffer + 6) & 0x2000) == 0;
+      protocol = buffer[9];
+      uint32_t source = ReadNtohU32 (buffer + 12);
+      uint32_t destination = ReadNtohU32 (buffer + 16);
+
+      uint32_t localAddress;
+      uint32_t remoteAddress;
       if (direction ==  EpcTft::UPLINK)
         {
-          localAddressIpv4 = ipv4Header.GetSource ();
-          remoteAddressIpv4 = ipv4Header.GetDestination ();
+          localAddress = source;
+          remoteAddress = destination;
         }
       else
         {
           NS_ASSERT (direction ==  EpcTft::DOWNLINK);
-          remoteAddressIpv4 = ipv4Header.GetSource ();
-          localAddressIpv4 = ipv4Header.GetDestination ();
+          remoteAddress = source;
+          localAddress = destination;
         }
-      NS_LOG_INFO ("local address: " << localAddressIpv4 << " remote address: " << remoteAddressIpv4);
-
-      uint16_t payloadSize = ipv4Header.GetPayloadSize ();
-      uint16_t fragmentOffset = ipv4Header.GetFragmentOffset ();
-      bool isLastFragment = ipv4Header.IsLastFragment ();
-
-      // NS_LOG_DEBUG ("PayloadSize = " << payloadSize);
-      // NS_LOG_DEBUG ("fragmentOffset " << fragmentOffset << " isLastFragment " << isLastFragment);
-
-      protocol = ipv4Header.GetProtocol ();
-      tos = ipv4Header.GetTos ();
+      NS_LOG_INFO ("local address: " << Ipv4Address (localAddress) << " remote address: " << Ipv4Address (remoteAddress));
 
       // Port info only can be get if it is the first fragment and
       // there is enough data in the payload
@@ -120,53 +220,26 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
       // i.e. it is the first one but it is not the last one
       if (fragmentOffset == 0)
         {
-          if (protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8)
+          if ((protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8)
+              || (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20))
             {
-              UdpHeader udpHeader;
-              pCopy->RemoveHeader (udpHeader);
+              NS_ABORT_MSG_IF (size < headerSize + 4u, "EpcTftClassifier::Classify - Truncated UDP/TCP header");
+              uint16_t sourcePort = ReadNtohU16 (buffer + headerSize);
+              uint16_t destinationPort = ReadNtohU16 (buffer + headerSize + 2);
               if (direction ==  EpcTft::UPLINK)
                 {
-                  localPort = udpHeader.GetSourcePort ();
-                  remotePort = udpHeader.GetDestinationPort ();
+                  localPort = sourcePort;
+                  remotePort = destinationPort;
                 }
               else
                 {
-                  remotePort = udpHeader.GetSourcePort ();
-                  localPort = udpHeader.GetDestinationPort ();
+                  remotePort = sourcePort;
+                  localPort = destinationPort;
                 }
               if (!isLastFragment)
                 {
                   std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-                      std::make_tuple (ipv4Header.GetSource ().Get (),
-                                       ipv4Header.GetDestination ().Get (),
-                                       protocol,
-                                       ipv4Header.GetIdentification ());
-
-                  m_classifiedIpv4Fragments[fragmentKey] = std::make_pair (localPort, remotePort);
-                }
-            }
-          else if (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20)
-            {
-              TcpHeader tcpHeader;
-              pCopy->RemoveHeader (tcpHeader);
-              if (direction ==  EpcTft::UPLINK)
-                {
-                  localPort = tcpHeader.GetSourcePort ();
-                  remotePort = tcpHeader.GetDestinationPort ();
-                }
-              else
-                {
-                  remotePort = tcpHeader.GetSourcePort ();
-                  localPort = tcpHeader.GetDestinationPort ();
-                }
-
-              if (!isLastFragment)
-                {
-                  std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-                      std::make_tuple (ipv4Header.GetSource ().Get (),
-                                       ipv4Header.GetDestination ().Get (),
-                                       protocol,
-                                       ipv4Header.GetIdentification ());
+                      std::make_tuple (source, destination, protocol, identification);
 
                   m_classifiedIpv4Fragments[fragmentKey] = std::make_pair (localPort, remotePort);
                 }
@@ -181,10 +254,7 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
           // Not first fragment, so port info is not available but
           // port info should already be known (if there is not fragment reordering)
           std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-              std::make_tuple (ipv4Header.GetSource ().Get (),
-                               ipv4Header.GetDestination ().Get (),
-                               protocol,
-                               ipv4Header.GetIdentification ());
+              std::make_tuple (source, destination, protocol, identification);
 
           std::map< std::tuple<uint32_t, uint32_t, uint8_t, uint16_t>,
                     std::pair<uint32_t, uint32_t> >::iterator it =
@@ -201,95 +271,72 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
                 }
             }
         }
+
+      NS_LOG_INFO ("Classifying packet:"
+          << " localAddr="  << Ipv4Address (localAddress)
+          << " remoteAddr=" << Ipv4Address (remoteAddress)
+          << " localPort="  << localPort
+          << " remotePort=" << remotePort
+          << " tos=0x" << (uint16_t) tos );
+
+      Ipv4FlowKey_t flowKey = std::make_tuple (remoteAddress, localAddress, protocol,
+                                               remotePort, localPort, tos, (uint8_t) direction);
+      std::unordered_map<Ipv4FlowKey_t, uint32_t, Ipv4FlowKeyHash>::const_iterator flowIt =
+          m_classifiedIpv4Flows.find (flowKey);
+      if (flowIt != m_classifiedIpv4Flows.end ())
+        {
+          NS_LOG_LOGIC ("already classified flow, TFT ID = " << flowIt->second);
+          return flowIt->second;
+        }
+
+      uint32_t id = Match (direction, true, remoteAddress, localAddress, remotePort, localPort, tos);
+      if (m_classifiedIpv4Flows.size () >= MAX_CLASSIFIED_IPV4_FLOWS)
+        {
+          m_classifiedIpv4Flows.clear ();
+        }
+      m_classifiedIpv4Flows[flowKey] = id;
+      return id;
     }
   else if (ipType == 0x06)
     {
-      Ipv6Header ipv6Header;
-      pCopy->RemoveHeader (ipv6Header);
-
+      NS_ABORT_MSG_IF (size < 40, "EpcTftClassifier::Classify - Truncated IPv6 header");
+      tos = ((buffer[0] & 0x0f) << 4) | (buffer[1] >> 4);
+      protocol = buffer[6];
+      Ipv6Address source (buffer + 8);
+      Ipv6Address destination (buffer + 24);
+
+      Ipv6Address localAddressIpv6;
+      Ipv6Address remoteAddressIpv6;
       if (direction ==  EpcTft::UPLINK)
         {
-          localAddressIpv6 = ipv6Header.GetSourceAddress ();
-          remoteAddressIpv6 = ipv6Header.GetDestinationAddress ();
+          localAddressIpv6 = source;
+          remoteAddressIpv6 = destination;
         }
       else
         {
           NS_ASSERT (direction ==  EpcTft::DOWNLINK);
-          remoteAddressIpv6 = ipv6Header.GetSourceAddress ();
-          localAddressIpv6 = ipv6Header.GetDestinationAddress ();
+          remoteAddressIpv6 = source;
+          localAddressIpv6 = destination;
         }
       NS_LOG_INFO ("local address: " << localAddressIpv6 << " remote address: " << remoteAddressIpv6);
 
-      protocol = ipv6Header.GetNextHeader ();
-      tos = ipv6Header.GetTrafficClass ();
-
-      if (protocol == UdpL4Protocol::PROT_NUMBER)
-        {
-          UdpHeader udpHeader;
-          pCopy->RemoveHeader (udpHeader);
-
-          if (direction ==  EpcTft::UPLINK)
-            {
-              localPort = udpHeader.GetSourcePort ();
-              remotePort = udpHeader.GetDestinationPort ();
-            }
-          else
-            {
-              remotePort = udpHeader.GetSourcePort ();
-              localPort = udpHeader.GetDestinationPort ();
-            }
-        }
-      else if (protocol == TcpL4Protocol::PROT_NUMBER)
+      if (protocol == UdpL4Protocol::PROT_NUMBER || protocol == TcpL4Protocol::PROT_NUMBER)
         {
-          TcpHeader tcpHeader;
-          pCopy->RemoveHeader (tcpHeader);
+          NS_ABORT_MSG_IF (size < 44, "EpcTftClassifier::Classify - Truncated UDP/TCP header");
+          uint16_t sourcePort = ReadNtohU16 (buffer + 40);
+          uint16_t destinationPort = ReadNtohU16 (buffer + 42);
           if (direction ==  EpcTft::UPLINK)
             {
-              localPort = tcpHeader.GetSourcePort ();
-              remotePort = tcpHeader.GetDestinationPort ();
+              localPort = sourcePort;
+              remotePort = destinationPort;
             }
           else
             {
-              remotePort = tcpHeader.GetSourcePort ();
-              localPort = tcpHeader.GetDestinationPort ();
+              remotePort = sourcePort;
+              localPort = destinationPort;
             }
         }
-    }
-  else
-    {
-      NS_ABORT_MSG ("EpcTftClassifier::Classify - Unknown IP type...");
-    }
-
 
-  if (ipType == 0x04)
-    {
-      NS_LOG_INFO ("Classifying packet:"
-          << " localAddr="  << localAddressIpv4
-          << " remoteAddr=" << remoteAddressIpv4
-          << " localPort="  << localPort
-          << " remotePort=" << remotePort
-          << " tos=0x" << (uint16_t) tos );
-
-      // now it is possible to classify the packet!
-      // we use a reverse iterator since filter priority is not implemented properly.
-      // This way, since the default bearer is expected to be added first, it will be evaluated last.
-      std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-      NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
-
-      for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
-        {
-          NS_LOG_LOGIC ("TFT id: " << it->first );
-          NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-          Ptr<EpcTft> tft = it->second;
-          if (tft->Matches (direction, remoteAddressIpv4, localAddressIpv4, remotePort, localPort, tos))
-            {
-              NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-              return it->first; // the id of the matching TFT
-            }
-        }
-    }
-  else if (ipType == 0x06)
-    {
       NS_LOG_INFO ("Classifying packet:"
           << " localAddr="  << localAddressIpv6
           << " remoteAddr=" << remoteAddressIpv6
@@ -297,26 +344,12 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
           << " remotePort=" << remotePort
           << " tos=0x" << (uint16_t) tos );
 
-      // now it is possible to classify the packet!
-      // we use a reverse iterator since filter priority is not implemented properly.
-      // This way, since the default bearer is expected to be added first, it will be evaluated last.
-      std::map <uint32_t, Ptr<EpcTft> >::const_reverse_iterator it;
-      NS_LOG_LOGIC ("TFT MAP size: " << m_tftMap.size ());
-
-      for (it = m_tftMap.rbegin (); it != m_tftMap.rend (); ++it)
-        {
-          NS_LOG_LOGIC ("TFT id: " << it->first );
-          NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
-          Ptr<EpcTft> tft = it->second;
-          if (tft->Matches (direction, remoteAddressIpv6, localAddressIpv6, remotePort, localPort, tos))
-            {
-              NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
-              return it->first; // the id of the matching TFT
-            }
-        }
+      // the IPv6 packet filters do not match the addresses
+      return Match (direction, false, 0, 0, remotePort, localPort, tos);
     }
-  NS_LOG_LOGIC ("no match");
-  return 0;  // no match
+
+  NS_ABORT_MSG ("EpcTftClassifier::Classify - Unknown IP type...");
+  return 0;
 }
 
 
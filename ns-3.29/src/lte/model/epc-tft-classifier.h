@@ -28,6 +28,9 @@
 #include "ns3/epc-tft.h"
 
 #include <map>
+#include <unordered_map>
+#include <tuple>
+#include <vector>
 
 
 namespace ns3 {
@@ -50,6 +53,13 @@ class Packet;
  *
  * When we cannot cache the port info, the TFT of the default bearer is used. This may happen
  * if there is reordering or losses of IP packets.
+ *
+ * The packet filters of all the TFTs are compiled into a single table,
+ * which is rebuilt at the first classification after a TFT is added or
+ * deleted; hence the TFTs must not be changed after being added. The
+ * result of the classification of each IPv4 flow, identified by its
+ * addresses, protocol, ports and type of service, is also cached until
+ * the next change of the TFTs.
  */
 class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
 {
@@ -85,9 +95,74 @@ public:
   uint32_t Classify (Ptr<Packet> p, EpcTft::Direction direction);
   
 protected:
-  
+
+  /**
+   * A packet filter of a TFT, with the addresses in host byte order
+   * and already masked
+   */
+  struct CompiledPacketFilter
+  {
+    uint32_t id;                ///< the identifier of the TFT
+    uint8_t direction;          ///< the direction
+    uint32_t remoteAddress;     ///< the masked remote address
+    uint32_t remoteMask;        ///< the remote address mask
+    uint32_t localAddress;      ///< the masked local address
+    uint32_t localMask;         ///< the local address mask
+    uint16_t remotePortStart;   ///< start of the remote port range
+    uint16_t remotePortEnd;     ///< end of the remote port range
+    uint16_t localPortStart;    ///< start of the local port range
+    uint16_t localPortEnd;      ///< end of the local port range
+    uint8_t typeOfService;      ///< the masked type of service
+    uint8_t typeOfServiceMask;  ///< the type of service mask
+  };
+
+  /**
+   * Compile the packet filters of all the TFTs, in the order in which
+   * they are evaluated.
+   */
+  void Compile (void);
+
+  /**
+   * Find the first compiled packet filter matching with a packet.
+   *
+   * \param direction the direction
+   * \param matchAddresses whether the addresses are matched, which is
+   * the case for IPv4 packets only
+   * \param remoteAddress the remote IPv4 address
+   * \param localAddress the local IPv4 address
+   * \param remotePort the remote port
+   * \param localPort the local port
+   * \param tos the type of service
+   * \return the identifier of the TFT of the matching filter, or 0
+   */
+  uint32_t Match (EpcTft::Direction direction, bool matchAddresses,
+                  uint32_t remoteAddress, uint32_t localAddress,
+                  uint16_t remotePort, uint16_t localPort, uint8_t tos) const;
+
+  /// an IPv4 flow: source, destination, protocol, source port, destination port, TOS and direction
+  typedef std::tuple<uint32_t, uint32_t, uint8_t, uint16_t, uint16_t, uint8_t, uint8_t> Ipv4FlowKey_t;
+
+  /// Hash function of an IPv4 flow
+  struct Ipv4FlowKeyHash
+  {
+    /**
+     * \param key the flow
+     * \return the hash of the flow
+     */
+    size_t operator() (const Ipv4FlowKey_t& key) const;
+  };
+
+  /// maximum number of flows in the flow cache, which is cleared when full
+  static const uint32_t MAX_CLASSIFIED_IPV4_FLOWS = 4096;
+
   std::map <uint32_t, Ptr<EpcTft> > m_tftMap; ///< TFT map
 
+  std::vector<CompiledPacketFilter> m_compiledFilters; ///< the packet filters of all TFTs, in the order of evaluation
+  bool m_compiled; ///< whether m_compiledFilters is up to date with m_tftMap
+
+  std::unordered_map<Ipv4FlowKey_t, uint32_t, Ipv4FlowKeyHash>
+      m_classifiedIpv4Flows; ///< the TFT identifiers of the already classified IPv4 flows
+
   std::map < std::tuple<uint32_t, uint32_t, uint8_t, uint16_t>,
              std::pair<uint32_t, uint32_t> >
       m_classifiedIpv4Fragments; ///< Map with already classified IPv4 Fragments
@@ -68,13 +68,8 @@ void
 FdBetFfMacScheduler::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
-  m_dlHarqProcessesDciBuffer.clear ();
-  m_dlHarqProcessesTimer.clear ();
-  m_dlHarqProcessesRlcPduListBuffer.clear ();
+  m_ues.Clear ();
   m_dlInfoListBuffered.clear ();
-  m_ulHarqCurrentProcessId.clear ();
-  m_ulHarqProcessesStatus.clear ();
-  m_ulHarqProcessesDciBuffer.clear ();
   delete m_cschedSapProvider;
   delete m_schedSapProvider;
 }
@@ -160,38 +155,9 @@ void
 FdBetFfMacScheduler::DoCschedUeConfigReq (const struct FfMacCschedSapProvider::CschedUeConfigReqParameters& params)
 {
   NS_LOG_FUNCTION (this << " RNTI " << params.m_rnti << " txMode " << (uint16_t)params.m_transmissionMode);
-  std::map <uint16_t,uint8_t>::iterator it = m_uesTxMode.find (params.m_rnti);
-  if (it == m_uesTxMode.end ())
-    {
-      m_uesTxMode.insert (std::pair <uint16_t, double> (params.m_rnti, params.m_transmissionMode));
-      // generate HARQ buffers
-      m_dlHarqCurrentProcessId.insert (std::pair <uint16_t,uint8_t > (params.m_rnti, 0));
-      DlHarqProcessesStatus_t dlHarqPrcStatus;
-      dlHarqPrcStatus.resize (8,0);
-      m_dlHarqProcessesStatus.insert (std::pair <uint16_t, DlHarqProcessesStatus_t> (params.m_rnti, dlHarqPrcStatus));
-      DlHarqProcessesTimer_t dlHarqProcessesTimer;
-      dlHarqProcessesTimer.resize (8,0);
-      m_dlHarqProcessesTimer.insert (std::pair <uint16_t, DlHarqProcessesTimer_t> (params.m_rnti, dlHarqProcessesTimer));
-      DlHarqProcessesDciBuffer_t dlHarqdci;
-      dlHarqdci.resize (8);
-      m_dlHarqProcessesDciBuffer.insert (std::pair <uint16_t, DlHarqProcessesDciBuffer_t> (params.m_rnti, dlHarqdci));
-      DlHarqRlcPduListBuffer_t dlHarqRlcPdu;
-      dlHarqRlcPdu.resize (2);
-      dlHarqRlcPdu.at (0).resize (8);
-      dlHarqRlcPdu.at (1).resize (8);
-      m_dlHarqProcessesRlcPduListBuffer.insert (std::pair <uint16_t, DlHarqRlcPduListBuffer_t> (params.m_rnti, dlHarqRlcPdu));
-      m_ulHarqCurrentProcessId.insert (std::pair <uint16_t,uint8_t > (params.m_rnti, 0));
-      UlHarqProcessesStatus_t ulHarqPrcStatus;
-      ulHarqPrcStatus.resize (8,0);
-      m_ulHarqProcessesStatus.insert (std::pair <uint16_t, UlHarqProcessesStatus_t> (params.m_rnti, ulHarqPrcStatus));
-      UlHarqProcessesDciBuffer_t ulHarqdci;
-      ulHarqdci.resize (8);
-      m_ulHarqProcessesDciBuffer.insert (std::pair <uint16_t, UlHarqProcessesDciBuffer_t> (params.m_rnti, ulHarqdci));
-    }
-  else
-    {
-      (*it).second = params.m_transmissionMode;
-    }
+  // generate the UE context with its HARQ buffers, if not done yet
+  uint16_t slot = m_ues.Add (params.m_rnti);
+  m_ues.m_txMode[slot] = params.m_transmissionMode;
   return;
 }
 
@@ -255,18 +221,9 @@ FdBetFfMacScheduler::DoCschedUeReleaseReq (const struct FfMacCschedSapProvider::
 {
   NS_LOG_FUNCTION (this);
 
-  m_uesTxMode.erase (params.m_rnti);
-  m_dlHarqCurrentProcessId.erase (params.m_rnti);
-  m_dlHarqProcessesStatus.erase  (params.m_rnti);
-  m_dlHarqProcessesTimer.erase (params.m_rnti);
-  m_dlHarqProcessesDciBuffer.erase  (params.m_rnti);
-  m_dlHarqProcessesRlcPduListBuffer.erase  (params.m_rnti);
-  m_ulHarqCurrentProcessId.erase  (params.m_rnti);
-  m_ulHarqProcessesStatus.erase  (params.m_rnti);
-  m_ulHarqProcessesDciBuffer.erase  (params.m_rnti);
+  m_ues.Remove (params.m_rnti);
   m_flowStatsDl.erase  (params.m_rnti);
   m_flowStatsUl.erase  (params.m_rnti);
-  m_ceBsrRxed.erase (params.m_rnti);
   std::map<LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator it = m_rlcBufferReq.begin ();
   std::map<LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator temp;
   while (it!=m_rlcBufferReq.end ())
@@ -374,23 +331,20 @@ FdBetFfMacScheduler::HarqProcessAvailability (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << rnti);
 
-  std::map <uint16_t, uint8_t>::iterator it = m_dlHarqCurrentProcessId.find (rnti);
-  if (it == m_dlHarqCurrentProcessId.end ())
+  uint16_t slot = m_ues.Find (rnti);
+  if (slot == FfMacSchedulerUeTable::NO_SLOT)
     {
       NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
     }
-  std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
-  if (itStat == m_dlHarqProcessesStatus.end ())
-    {
-      NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
-    }
-  uint8_t i = (*it).second;
+  uint8_t current = m_ues.m_dlHarqCurrentProcessId[slot];
+  const uint8_t* status = &m_ues.m_dlHarqProcessesStatus[FfMacSchedulerUeTable::HarqIndex (slot, 0)];
+  uint8_t i = current;
   do
     {
       i = (i + 1) % HARQ_PROC_NUM;
     }
-  while ( ((*itStat).second.at (i) != 0)&&(i != (*it).second));
-  if ((*itStat).second.at (i) == 0)
+  while ((status[i] != 0)&&(i != current));
+  if (status[i] == 0)
     {
       return (true);
     }
@@ -413,33 +367,30 @@ FdBetFfMacScheduler::UpdateHarqProcessId (uint16_t rnti)
     }
 
 
-  std::map <uint16_t, uint8_t>::iterator it = m_dlHarqCurrentProcessId.find (rnti);
-  if (it == m_dlHarqCurrentProcessId.end ())
+  uint16_t slot = m_ues.Find (rnti);
+  if (slot == FfMacSchedulerUeTable::NO_SLOT)
     {
       NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
     }
-  std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
-  if (itStat == m_dlHarqProcessesStatus.end ())
-    {
-      NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
-    }
-  uint8_t i = (*it).second;
+  uint8_t current = m_ues.m_dlHarqCurrentProcessId[slot];
+  uint8_t* status = &m_ues.m_dlHarqProcessesStatus[FfMacSchedulerUeTable::HarqIndex (slot, 0)];
+  uint8_t i = current;
   do
     {
       i = (i + 1) % HARQ_PROC_NUM;
     }
-  while ( ((*itStat).second.at (i) != 0)&&(i != (*it).second));
-  if ((*itStat).second.at (i) == 0)
+  while ((status[i] != 0)&&(i != current));
+  if (status[i] == 0)
     {
-      (*it).second = i;
-      (*itStat).second.at (i) = 1;
+      m_ues.m_dlHarqCurrentProcessId[slot] = i;
+      status[i] = 1;
     }
   else
     {
       NS_FATAL_ERROR ("No HARQ process available for RNTI " << rnti << " check before update with HarqProcessAvailability");
     }
 
-  return ((*it).second);
+  return (m_ues.m_dlHarqCurrentProcessId[slot]);
 }
 
 
@@ -448,27 +399,23 @@ FdBetFfMacScheduler::RefreshHarqProcesses ()
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itTimers;
-  for (itTimers = m_dlHarqProcessesTimer.begin (); itTimers != m_dlHarqProcessesTimer.end (); itTimers++)
+  const std::vector<uint16_t>& slots = m_ues.GetSlots ();
+  for (std::vector<uint16_t>::const_iterator itSlot = slots.begin (); itSlot != slots.end (); itSlot++)
     {
       for (uint16_t i = 0; i < HARQ_PROC_NUM; i++)
         {
-          if ((*itTimers).second.at (i) == HARQ_DL_TIMEOUT)
+          uint32_t harqIndex = FfMacSchedulerUeTable::HarqIndex (*itSlot, i);
+          if (m_ues.m_dlHarqProcessesTimer[harqIndex] == HARQ_DL_TIMEOUT)
             {
               // reset HARQ process
 
-              NS_LOG_DEBUG (this << " Reset HARQ proc " << i << " for RNTI " << (*itTimers).first);
-              std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find ((*itTimers).first);
-              if (itStat == m_dlHarqProcessesStatus.end ())
-                {
-                  NS_FATAL_ERROR ("No Process Id Status found for this RNTI " << (*itTimers).first);
-                }
-              (*itStat).second.at (i) = 0;
-              (*itTimers).second.at (i) = 0;
+              NS_LOG_DEBUG (this << " Reset HARQ proc " << i << " for RNTI " << m_ues.m_rnti[*itSlot]);
+              m_ues.m_dlHarqProcessesStatus[harqIndex] = 0;
+              m_ues.m_dlHarqProcessesTimer[harqIndex] = 0;
             }
           else
             {
-              (*itTimers).second.at (i)++;
+              m_ues.m_dlHarqProcessesTimer[harqIndex]++;
             }
         }
     }
@@ -500,10 +447,10 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
 
 
   //   update UL HARQ proc id
-  std::map <uint16_t, uint8_t>::iterator itProcId;
-  for (itProcId = m_ulHarqCurrentProcessId.begin (); itProcId != m_ulHarqCurrentProcessId.end (); itProcId++)
+  const std::vector<uint16_t>& slots = m_ues.GetSlots ();
+  for (std::vector<uint16_t>::const_iterator itSlot = slots.begin (); itSlot != slots.end (); itSlot++)
     {
-      (*itProcId).second = ((*itProcId).second + 1) % HARQ_PROC_NUM;
+      m_ues.m_ulHarqCurrentProcessId[*itSlot] = (m_ues.m_ulHarqCurrentProcessId[*itSlot] + 1) % HARQ_PROC_NUM;
     }
 
   // RACH Allocation
@@ -568,20 +515,12 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
           uldci.m_freqHopping = 0;
           uldci.m_pdcchPowerOffset = 0; // not used
 
-          uint8_t harqId = 0;
-          std::map <uint16_t, uint8_t>::iterator itProcId;
-          itProcId = m_ulHarqCurrentProcessId.find (uldci.m_rnti);
-          if (itProcId == m_ulHarqCurrentProcessId.end ())
+          uint16_t slot = m_ues.Find (uldci.m_rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
               NS_FATAL_ERROR ("No info find in HARQ buffer for UE " << uldci.m_rnti);
             }
-          harqId = (*itProcId).second;
-          std::map <uint16_t, UlHarqProcessesDciBuffer_t>::iterator itDci = m_ulHarqProcessesDciBuffer.find (uldci.m_rnti);
-          if (itDci == m_ulHarqProcessesDciBuffer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find RNTI entry in UL DCI HARQ buffer for RNTI " << uldci.m_rnti);
-            }
-          (*itDci).second.at (harqId) = uldci;
+          m_ues.m_ulHarqProcessesDciBuffer.at (FfMacSchedulerUeTable::HarqIndex (slot, m_ues.m_ulHarqCurrentProcessId[slot])) = uldci;
         }
 
       rbStart = rbStart + rbLen;
@@ -641,13 +580,14 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
           uint16_t rnti = m_dlInfoListBuffered.at (i).m_rnti;
           uint8_t harqId = m_dlInfoListBuffered.at (i).m_harqProcessId;
           NS_LOG_INFO (this << " HARQ retx RNTI " << rnti << " harqId " << (uint16_t)harqId);
-          std::map <uint16_t, DlHarqProcessesDciBuffer_t>::iterator itHarq = m_dlHarqProcessesDciBuffer.find (rnti);
-          if (itHarq == m_dlHarqProcessesDciBuffer.end ())
+          uint16_t slot = m_ues.Find (rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
               NS_FATAL_ERROR ("No info find in HARQ buffer for UE " << rnti);
             }
+          uint32_t harqIndex = FfMacSchedulerUeTable::HarqIndex (slot, harqId);
 
-          DlDciListElement_s dci = (*itHarq).second.at (harqId);
+          DlDciListElement_s dci = m_ues.m_dlHarqProcessesDciBuffer.at (harqIndex);
           int rv = 0;
           if (dci.m_rv.size () == 1)
             {
@@ -662,20 +602,10 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
             {
               // maximum number of retx reached -> drop process
               NS_LOG_INFO ("Maximum number of retransmissions reached -> drop process");
-              std::map <uint16_t, DlHarqProcessesStatus_t>::iterator it = m_dlHarqProcessesStatus.find (rnti);
-              if (it == m_dlHarqProcessesStatus.end ())
-                {
-                  NS_LOG_ERROR ("No info find in HARQ buffer for UE (might change eNB) " << m_dlInfoListBuffered.at (i).m_rnti);
-                }
-              (*it).second.at (harqId) = 0;
-              std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find (rnti);
-              if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
+              m_ues.m_dlHarqProcessesStatus.at (harqIndex) = 0;
+              for (uint8_t k = 0; k < FfMacSchedulerUeTable::DL_HARQ_LAYERS; k++)
                 {
-                  NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << m_dlInfoListBuffered.at (i).m_rnti);
-                }
-              for (uint16_t k = 0; k < (*itRlcPdu).second.size (); k++)
-                {
-                  (*itRlcPdu).second.at (k).at (harqId).clear ();
+                  m_ues.m_dlHarqProcessesRlcPduListBuffer.at (FfMacSchedulerUeTable::RlcPduListIndex (slot, k, harqId)).clear ();
                 }
               continue;
             }
@@ -754,11 +684,6 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
             }
           // retrieve RLC PDU list for retx TBsize and update DCI
           BuildDataListElement_s newEl;
-          std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find (rnti);
-          if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << rnti);
-            }
           for (uint8_t j = 0; j < nLayers; j++)
             {
               if (retx.at (j))
@@ -776,7 +701,7 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
                     {
                       dci.m_ndi.at (j) = 0;
                       dci.m_rv.at (j)++;
-                      (*itHarq).second.at (harqId).m_rv.at (j)++;
+                      m_ues.m_dlHarqProcessesDciBuffer.at (harqIndex).m_rv.at (j)++;
                       NS_LOG_INFO (this << " layer " << (uint16_t)j << " RV " << (uint16_t)dci.m_rv.at (j));
                     }
                 }
@@ -790,7 +715,8 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
                   NS_LOG_INFO (this << " layer " << (uint16_t)j << " no retx");
                 }
             }
-          for (uint16_t k = 0; k < (*itRlcPdu).second.at (0).at (dci.m_harqProcess).size (); k++)
+          const std::vector <RlcPduListElement_s>* rlcPduBuffer = &m_ues.m_dlHarqProcessesRlcPduListBuffer.at (FfMacSchedulerUeTable::RlcPduListIndex (slot, 0, dci.m_harqProcess));
+          for (uint16_t k = 0; k < rlcPduBuffer[0].size (); k++)
             {
               std::vector <struct RlcPduListElement_s> rlcPduListPerLc;
               for (uint8_t j = 0; j < nLayers; j++)
@@ -800,14 +726,14 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
                       if (j < dci.m_ndi.size ())
                         {
                           NS_LOG_INFO (" layer " << (uint16_t)j << " tb size " << dci.m_tbsSize.at (j));
-                          rlcPduListPerLc.push_back ((*itRlcPdu).second.at (j).at (dci.m_harqProcess).at (k));
+                          rlcPduListPerLc.push_back (rlcPduBuffer[j * HARQ_PROC_NUM].at (k));
                         }
                     }
                   else
                     { // if no retx needed on layer j, push an RlcPduListElement_s object with m_size=0 to keep the size of rlcPduListPerLc vector = 2 in case of MIMO
                       NS_LOG_INFO (" layer " << (uint16_t)j << " tb size "<<dci.m_tbsSize.at (j));
                       RlcPduListElement_s emptyElement;
-                      emptyElement.m_logicalChannelIdentity = (*itRlcPdu).second.at (j).at (dci.m_harqProcess).at (k).m_logicalChannelIdentity;
+                      emptyElement.m_logicalChannelIdentity = rlcPduBuffer[j * HARQ_PROC_NUM].at (k).m_logicalChannelIdentity;
                       emptyElement.m_size = 0;
                       rlcPduListPerLc.push_back (emptyElement);
                     }
@@ -820,14 +746,9 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
             }
           newEl.m_rnti = rnti;
           newEl.m_dci = dci;
-          (*itHarq).second.at (harqId).m_rv = dci.m_rv;
+          m_ues.m_dlHarqProcessesDciBuffer.at (harqIndex).m_rv = dci.m_rv;
           // refresh timer
-          std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itHarqTimer = m_dlHarqProcessesTimer.find (rnti);
-          if (itHarqTimer== m_dlHarqProcessesTimer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)rnti);
-            }
-          (*itHarqTimer).second.at (harqId) = 0;
+          m_ues.m_dlHarqProcessesTimer.at (harqIndex) = 0;
           ret.m_buildDataList.push_back (newEl);
           rntiAllocated.insert (rnti);
         }
@@ -835,20 +756,16 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
         {
           // update HARQ process status
           NS_LOG_INFO (this << " HARQ received ACK for UE " << m_dlInfoListBuffered.at (i).m_rnti);
-          std::map <uint16_t, DlHarqProcessesStatus_t>::iterator it = m_dlHarqProcessesStatus.find (m_dlInfoListBuffered.at (i).m_rnti);
-          if (it == m_dlHarqProcessesStatus.end ())
+          uint16_t slot = m_ues.Find (m_dlInfoListBuffered.at (i).m_rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
               NS_FATAL_ERROR ("No info find in HARQ buffer for UE " << m_dlInfoListBuffered.at (i).m_rnti);
             }
-          (*it).second.at (m_dlInfoListBuffered.at (i).m_harqProcessId) = 0;
-          std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find (m_dlInfoListBuffered.at (i).m_rnti);
-          if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << m_dlInfoListBuffered.at (i).m_rnti);
-            }
-          for (uint16_t k = 0; k < (*itRlcPdu).second.size (); k++)
+          uint8_t harqId = m_dlInfoListBuffered.at (i).m_harqProcessId;
+          m_ues.m_dlHarqProcessesStatus.at (FfMacSchedulerUeTable::HarqIndex (slot, harqId)) = 0;
+          for (uint8_t k = 0; k < FfMacSchedulerUeTable::DL_HARQ_LAYERS; k++)
             {
-              (*itRlcPdu).second.at (k).at (m_dlInfoListBuffered.at (i).m_harqProcessId).clear ();
+              m_ues.m_dlHarqProcessesRlcPduListBuffer.at (FfMacSchedulerUeTable::RlcPduListIndex (slot, k, harqId)).clear ();
             }
         }
     }
@@ -889,26 +806,23 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
         }
 
       // check first what are channel conditions for this UE, if CQI!=0
-      std::map <uint16_t,uint8_t>::iterator itCqi;
-      itCqi = m_p10CqiRxed.find ((*itFlow).first);
-      std::map <uint16_t,uint8_t>::iterator itTxMode;
-      itTxMode = m_uesTxMode.find ((*itFlow).first);
-      if (itTxMode == m_uesTxMode.end ())
+      uint16_t slot = m_ues.Find ((*itFlow).first);
+      if (slot == FfMacSchedulerUeTable::NO_SLOT)
         {
           NS_FATAL_ERROR ("No Transmission Mode info on user " << (*itFlow).first);
         }
-      int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+      int nLayer = TransmissionModesLayers::TxMode2LayerNum (m_ues.m_txMode[slot]);
 
       uint8_t cqiSum = 0;
       for (uint8_t j = 0; j < nLayer; j++)
         {
-          if (itCqi == m_p10CqiRxed.end ())
+          if (!m_ues.m_p10CqiRxed[slot])
             {
               cqiSum += 1;  // no info on this user -> lowest MCS
             }
           else
             {
-              cqiSum = (*itCqi).second;
+              cqiSum = m_ues.m_p10Cqi[slot];
             }
         }
       if (cqiSum != 0)
@@ -958,25 +872,22 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
                 }
 
               // calculate expected throughput for current UE
-              std::map <uint16_t,uint8_t>::iterator itCqi;
-              itCqi = m_p10CqiRxed.find ((*itMax).first);
-              std::map <uint16_t,uint8_t>::iterator itTxMode;
-              itTxMode = m_uesTxMode.find ((*itMax).first);
-              if (itTxMode == m_uesTxMode.end ())
+              uint16_t slot = m_ues.Find ((*itMax).first);
+              if (slot == FfMacSchedulerUeTable::NO_SLOT)
                 {
                   NS_FATAL_ERROR ("No Transmission Mode info on user " << (*itMax).first);
                 }
-              int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+              int nLayer = TransmissionModesLayers::TxMode2LayerNum (m_ues.m_txMode[slot]);
               std::vector <uint8_t> mcs;
               for (uint8_t j = 0; j < nLayer; j++) 
                 {
-                  if (itCqi == m_p10CqiRxed.end ())
+                  if (!m_ues.m_p10CqiRxed[slot])
                     {
                       mcs.push_back (0); // no info on this user -> lowest MCS
                     }
                   else
                     {
-                      mcs.push_back (m_amc->GetMcsFromCqi ((*itCqi).second));
+                      mcs.push_back (m_amc->GetMcsFromCqi (m_ues.m_p10Cqi[slot]));
                     }
                 }
 
@@ -1048,26 +959,23 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
           lcActives = (uint16_t)65535; // UINT16_MAX;
         }
       uint16_t RgbPerRnti = (*itMap).second.size ();
-      std::map <uint16_t,uint8_t>::iterator itCqi;
-      itCqi = m_p10CqiRxed.find ((*itMap).first);
-      std::map <uint16_t,uint8_t>::iterator itTxMode;
-      itTxMode = m_uesTxMode.find ((*itMap).first);
-      if (itTxMode == m_uesTxMode.end ())
+      uint16_t slot = m_ues.Find ((*itMap).first);
+      if (slot == FfMacSchedulerUeTable::NO_SLOT)
         {
           NS_FATAL_ERROR ("No Transmission Mode info on user " << (*itMap).first);
         }
-      int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+      int nLayer = TransmissionModesLayers::TxMode2LayerNum (m_ues.m_txMode[slot]);
 
       uint32_t bytesTxed = 0;
       for (uint8_t j = 0; j < nLayer; j++)
         {
-          if (itCqi == m_p10CqiRxed.end ())
+          if (!m_ues.m_p10CqiRxed[slot])
             {
               newDci.m_mcs.push_back (0); // no info on this user -> lowest MCS
             }
           else
             {
-              newDci.m_mcs.push_back ( m_amc->GetMcsFromCqi ((*itCqi).second) );
+              newDci.m_mcs.push_back ( m_amc->GetMcsFromCqi (m_ues.m_p10Cqi[slot]) );
             }
 
           int tbSize = (m_amc->GetDlTbSizeFromMcs (newDci.m_mcs.at (j), RgbPerRnti * rbgSize) / 8); // (size of TB in bytes according to table 7.1.7.2.1-1 of 36.213)
@@ -1106,12 +1014,7 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
                   if (m_harqOn == true)
                     {
                       // store RLC PDU list for HARQ
-                      std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find ((*itMap).first);
-                      if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
-                        {
-                          NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << (*itMap).first);
-                        }
-                      (*itRlcPdu).second.at (j).at (newDci.m_harqProcess).push_back (newRlcEl);
+                      m_ues.m_dlHarqProcessesRlcPduListBuffer.at (FfMacSchedulerUeTable::RlcPduListIndex (slot, j, newDci.m_harqProcess)).push_back (newRlcEl);
                     }
                 }
               newEl.m_rlcPduList.push_back (newRlcPduLe);
@@ -1134,19 +1037,9 @@ FdBetFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sc
       if (m_harqOn == true)
         {
           // store DCI for HARQ
-          std::map <uint16_t, DlHarqProcessesDciBuffer_t>::iterator itDci = m_dlHarqProcessesDciBuffer.find (newEl.m_rnti);
-          if (itDci == m_dlHarqProcessesDciBuffer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find RNTI entry in DCI HARQ buffer for RNTI " << newEl.m_rnti);
-            }
-          (*itDci).second.at (newDci.m_harqProcess) = newDci;
+          m_ues.m_dlHarqProcessesDciBuffer.at (FfMacSchedulerUeTable::HarqIndex (slot, newDci.m_harqProcess)) = newDci;
           // refresh timer
-          std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itHarqTimer =  m_dlHarqProcessesTimer.find (newEl.m_rnti);
-          if (itHarqTimer== m_dlHarqProcessesTimer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)newEl.m_rnti);
-            }
-          (*itHarqTimer).second.at (newDci.m_harqProcess) = 0;
+          m_ues.m_dlHarqProcessesTimer[FfMacSchedulerUeTable::HarqIndex (slot, newDci.m_harqProcess)] = 0;
         }
 
       // ...more parameters -> ignored in this version
@@ -1210,46 +1103,32 @@ FdBetFfMacScheduler::DoSchedDlCqiInfoReq (const struct FfMacSchedSapProvider::Sc
       if ( params.m_cqiList.at (i).m_cqiType == CqiListElement_s::P10 )
         {
           NS_LOG_LOGIC ("wideband CQI " <<  (uint32_t) params.m_cqiList.at (i).m_wbCqi.at (0) << " reported");
-          std::map <uint16_t,uint8_t>::iterator it;
           uint16_t rnti = params.m_cqiList.at (i).m_rnti;
-          it = m_p10CqiRxed.find (rnti);
-          if (it == m_p10CqiRxed.end ())
+          uint16_t slot = m_ues.Find (rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
-              // create the new entry
-              m_p10CqiRxed.insert ( std::pair<uint16_t, uint8_t > (rnti, params.m_cqiList.at (i).m_wbCqi.at (0)) ); // only codeword 0 at this stage (SISO)
-              // generate correspondent timer
-              m_p10CqiTimers.insert ( std::pair<uint16_t, uint32_t > (rnti, m_cqiTimersThreshold));
-            }
-          else
-            {
-              // update the CQI value and refresh correspondent timer
-              (*it).second = params.m_cqiList.at (i).m_wbCqi.at (0);
-              // update correspondent timer
-              std::map <uint16_t,uint32_t>::iterator itTimers;
-              itTimers = m_p10CqiTimers.find (rnti);
-              (*itTimers).second = m_cqiTimersThreshold;
+              NS_LOG_INFO (this << " CQI of unknown UE " << rnti << " ignored");
+              continue;
             }
+          // update the CQI value and refresh correspondent timer
+          m_ues.m_p10CqiRxed[slot] = true;
+          m_ues.m_p10Cqi[slot] = params.m_cqiList.at (i).m_wbCqi.at (0); // only codeword 0 at this stage (SISO)
+          m_ues.m_p10CqiTimer[slot] = m_cqiTimersThreshold;
         }
       else if ( params.m_cqiList.at (i).m_cqiType == CqiListElement_s::A30 )
         {
           // subband CQI reporting high layer configured
-          std::map <uint16_t,SbMeasResult_s>::iterator it;
           uint16_t rnti = params.m_cqiList.at (i).m_rnti;
-          it = m_a30CqiRxed.find (rnti);
-          if (it == m_a30CqiRxed.end ())
+          uint16_t slot = m_ues.Find (rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
-              // create the new entry
-              m_a30CqiRxed.insert ( std::pair<uint16_t, SbMeasResult_s > (rnti, params.m_cqiList.at (i).m_sbMeasResult) );
-              m_a30CqiTimers.insert ( std::pair<uint16_t, uint32_t > (rnti, m_cqiTimersThreshold));
-            }
-          else
-            {
-              // update the CQI value and refresh correspondent timer
-              (*it).second = params.m_cqiList.at (i).m_sbMeasResult;
-              std::map <uint16_t,uint32_t>::iterator itTimers;
-              itTimers = m_a30CqiTimers.find (rnti);
-              (*itTimers).second = m_cqiTimersThreshold;
+              NS_LOG_INFO (this << " CQI of unknown UE " << rnti << " ignored");
+              continue;
             }
+          // update the CQI value and refresh correspondent timer
+          m_ues.m_a30CqiRxed[slot] = true;
+          m_ues.m_a30Cqi[slot] = params.m_cqiList.at (i).m_sbMeasResult;
+          m_ues.m_a30CqiTimer[slot] = m_cqiTimersThreshold;
         }
       else
         {
@@ -1332,26 +1211,18 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
             {
               // retx correspondent block: retrieve the UL-DCI
               uint16_t rnti = params.m_ulInfoList.at (i).m_rnti;
-              std::map <uint16_t, uint8_t>::iterator itProcId = m_ulHarqCurrentProcessId.find (rnti);
-              if (itProcId == m_ulHarqCurrentProcessId.end ())
-                {
-                  NS_LOG_ERROR ("No info find in HARQ buffer for UE (might change eNB) " << rnti);
-                }
-              uint8_t harqId = (uint8_t)((*itProcId).second - HARQ_PERIOD) % HARQ_PROC_NUM;
-              NS_LOG_INFO (this << " UL-HARQ retx RNTI " << rnti << " harqId " << (uint16_t)harqId << " i " << i << " size "  << params.m_ulInfoList.size ());
-              std::map <uint16_t, UlHarqProcessesDciBuffer_t>::iterator itHarq = m_ulHarqProcessesDciBuffer.find (rnti);
-              if (itHarq == m_ulHarqProcessesDciBuffer.end ())
+              uint16_t slot = m_ues.Find (rnti);
+              if (slot == FfMacSchedulerUeTable::NO_SLOT)
                 {
                   NS_LOG_ERROR ("No info find in HARQ buffer for UE (might change eNB) " << rnti);
                   continue;
                 }
-              UlDciListElement_s dci = (*itHarq).second.at (harqId);
-              std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
-              if (itStat == m_ulHarqProcessesStatus.end ())
-                {
-                  NS_LOG_ERROR ("No info find in HARQ buffer for UE (might change eNB) " << rnti);
-                }
-              if ((*itStat).second.at (harqId) >= 3)
+              uint8_t harqId = (uint8_t)(m_ues.m_ulHarqCurrentProcessId[slot] - HARQ_PERIOD) % HARQ_PROC_NUM;
+              uint32_t harqIndex = FfMacSchedulerUeTable::HarqIndex (slot, harqId);
+              uint32_t currentHarqIndex = FfMacSchedulerUeTable::HarqIndex (slot, m_ues.m_ulHarqCurrentProcessId[slot]);
+              NS_LOG_INFO (this << " UL-HARQ retx RNTI " << rnti << " harqId " << (uint16_t)harqId << " i " << i << " size "  << params.m_ulInfoList.size ());
+              UlDciListElement_s dci = m_ues.m_ulHarqProcessesDciBuffer.at (harqIndex);
+              if (m_ues.m_ulHarqProcessesStatus[harqIndex] >= 3)
                 {
                   NS_LOG_INFO ("Max number of retransmissions reached (UL)-> drop process");
                   continue;
@@ -1375,7 +1246,7 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
                       NS_LOG_INFO ("\tRB " << j);
                       rbAllocatedNum++;
                     }
-                  NS_LOG_INFO (this << " Send retx in the same RBs " << (uint16_t)dci.m_rbStart << " to " << dci.m_rbStart + dci.m_rbLen << " RV " << (*itStat).second.at (harqId) + 1);
+                  NS_LOG_INFO (this << " Send retx in the same RBs " << (uint16_t)dci.m_rbStart << " to " << dci.m_rbStart + dci.m_rbLen << " RV " << m_ues.m_ulHarqProcessesStatus[harqIndex] + 1);
                 }
               else
                 {
@@ -1384,9 +1255,9 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
                 }
               dci.m_ndi = 0;
               // Update HARQ buffers with new HarqId
-              (*itStat).second.at ((*itProcId).second) = (*itStat).second.at (harqId) + 1;
-              (*itStat).second.at (harqId) = 0;
-              (*itHarq).second.at ((*itProcId).second) = dci;
+              m_ues.m_ulHarqProcessesStatus[currentHarqIndex] = m_ues.m_ulHarqProcessesStatus[harqIndex] + 1;
+              m_ues.m_ulHarqProcessesStatus[harqIndex] = 0;
+              m_ues.m_ulHarqProcessesDciBuffer.at (currentHarqIndex) = dci;
               ret.m_dciList.push_back (dci);
               rntiAllocated.insert (dci.m_rnti);
             }
@@ -1397,14 +1268,20 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
         }
     }
 
-  std::map <uint16_t,uint32_t>::iterator it;
+  // UEs which sent a BSR, sorted by RNTI
+  std::vector <uint16_t> bsrSlots;
   int nflows = 0;
-
-  for (it = m_ceBsrRxed.begin (); it != m_ceBsrRxed.end (); it++)
+  const std::vector<uint16_t>& slots = m_ues.GetSlots ();
+  for (std::vector<uint16_t>::const_iterator itSlot = slots.begin (); itSlot != slots.end (); itSlot++)
     {
-      std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
+      if (!m_ues.m_bsrRxed[*itSlot])
+        {
+          continue;
+        }
+      bsrSlots.push_back (*itSlot);
+      std::set <uint16_t>::iterator itRnti = rntiAllocated.find (m_ues.m_rnti[*itSlot]);
       // select UEs with queues not empty and not yet allocated for HARQ
-      if (((*it).second > 0)&&(itRnti == rntiAllocated.end ()))
+      if ((m_ues.m_bsr[*itSlot] > 0)&&(itRnti == rntiAllocated.end ()))
         {
           nflows++;
         }
@@ -1431,38 +1308,39 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
   int rbAllocated = 0;
 
   std::map <uint16_t, fdbetsFlowPerf_t>::iterator itStats;
+  // index in bsrSlots of the UE to be served
+  uint16_t it = 0;
   if (m_nextRntiUl != 0)
     {
-      for (it = m_ceBsrRxed.begin (); it != m_ceBsrRxed.end (); it++)
+      for (it = 0; it < bsrSlots.size (); it++)
         {
-          if ((*it).first == m_nextRntiUl)
+          if (m_ues.m_rnti[bsrSlots.at (it)] == m_nextRntiUl)
             {
               break;
             }
         }
-      if (it == m_ceBsrRxed.end ())
+      if (it == bsrSlots.size ())
         {
           NS_LOG_ERROR (this << " no user found");
+          it = 0;
+          m_nextRntiUl = m_ues.m_rnti[bsrSlots.at (it)];
         }
     }
   else
     {
-      it = m_ceBsrRxed.begin ();
-      m_nextRntiUl = (*it).first;
+      it = 0;
+      m_nextRntiUl = m_ues.m_rnti[bsrSlots.at (it)];
     }
   do
     {
-      std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
-      if ((itRnti != rntiAllocated.end ())||((*it).second == 0))
+      uint16_t slot = bsrSlots.at (it);
+      std::set <uint16_t>::iterator itRnti = rntiAllocated.find (m_ues.m_rnti[slot]);
+      if ((itRnti != rntiAllocated.end ())||(m_ues.m_bsr[slot] == 0))
         {
           // UE already allocated for UL-HARQ -> skip it
-          NS_LOG_DEBUG (this << " UE already allocated in HARQ -> discared, RNTI " << (*it).first);
-          it++;
-          if (it == m_ceBsrRxed.end ())
-            {
-              // restart from the first
-              it = m_ceBsrRxed.begin ();
-            }
+          NS_LOG_DEBUG (this << " UE already allocated in HARQ -> discared, RNTI " << m_ues.m_rnti[slot]);
+          // restart from the first after the last one
+          it = (it + 1) % bsrSlots.size ();
           continue;
         }
       if (rbAllocated + rbPerFlow - 1 > m_cschedCellConfig.m_ulBandwidth)
@@ -1478,7 +1356,7 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
         }
 
       UlDciListElement_s uldci;
-      uldci.m_rnti = (*it).first;
+      uldci.m_rnti = m_ues.m_rnti[slot];
       uldci.m_rbLen = rbPerFlow;
       bool allocated = false;
       NS_LOG_INFO (this << " RB Allocated " << rbAllocated << " rbPerFlow " << rbPerFlow << " flows " << nflows);
@@ -1502,7 +1380,7 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
                 {
                   rbMap.at (j) = true;
                   // store info on allocation for managing ul-cqi interpretation
-                  rbgAllocationMap.at (j) = (*it).first;
+                  rbgAllocationMap.at (j) = m_ues.m_rnti[slot];
                 }
               rbAllocated += rbPerFlow;
               allocated = true;
@@ -1524,7 +1402,7 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
       if (!allocated)
         {
           // unable to allocate new resource: finish scheduling
-          m_nextRntiUl = (*it).first;
+          m_nextRntiUl = m_ues.m_rnti[slot];
           if (ret.m_dciList.size () > 0)
             {
               m_schedSapUser->SchedUlConfigInd (ret);
@@ -1535,7 +1413,7 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
 
 
 
-      std::map <uint16_t, std::vector <double> >::iterator itCqi = m_ueCqi.find ((*it).first);
+      std::map <uint16_t, std::vector <double> >::iterator itCqi = m_ueCqi.find (m_ues.m_rnti[slot]);
       int cqi = 0;
       if (itCqi == m_ueCqi.end ())
         {
@@ -1548,14 +1426,14 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
           double minSinr = (*itCqi).second.at (uldci.m_rbStart);
           if (minSinr == NO_SINR)
             {
-              minSinr = EstimateUlSinr ((*it).first, uldci.m_rbStart);
+              minSinr = EstimateUlSinr (m_ues.m_rnti[slot], uldci.m_rbStart);
             }
           for (uint16_t i = uldci.m_rbStart; i < uldci.m_rbStart + uldci.m_rbLen; i++)
             {
               double sinr = (*itCqi).second.at (i);
               if (sinr == NO_SINR)
                 {
-                  sinr = EstimateUlSinr ((*it).first, i);
+                  sinr = EstimateUlSinr (m_ues.m_rnti[slot], i);
                 }
               if (sinr < minSinr)
                 {
@@ -1570,12 +1448,8 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
           cqi = m_amc->GetCqiFromSpectralEfficiency (s);
           if (cqi == 0)
             {
-              it++;
-              if (it == m_ceBsrRxed.end ())
-                {
-                  // restart from the first
-                  it = m_ceBsrRxed.begin ();
-                }
+              // restart from the first after the last one
+              it = (it + 1) % bsrSlots.size ();
               NS_LOG_DEBUG (this << " UE discared for CQI=0, RNTI " << uldci.m_rnti);
               // remove UE from allocation map
               for (uint16_t i = uldci.m_rbStart; i < uldci.m_rbStart + uldci.m_rbLen; i++)
@@ -1606,32 +1480,17 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
       uint8_t harqId = 0;
       if (m_harqOn == true)
         {
-          std::map <uint16_t, uint8_t>::iterator itProcId;
-          itProcId = m_ulHarqCurrentProcessId.find (uldci.m_rnti);
-          if (itProcId == m_ulHarqCurrentProcessId.end ())
-            {
-              NS_FATAL_ERROR ("No info find in HARQ buffer for UE " << uldci.m_rnti);
-            }
-          harqId = (*itProcId).second;
-          std::map <uint16_t, UlHarqProcessesDciBuffer_t>::iterator itDci = m_ulHarqProcessesDciBuffer.find (uldci.m_rnti);
-          if (itDci == m_ulHarqProcessesDciBuffer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find RNTI entry in UL DCI HARQ buffer for RNTI " << uldci.m_rnti);
-            }
-          (*itDci).second.at (harqId) = uldci;
+          harqId = m_ues.m_ulHarqCurrentProcessId[slot];
+          uint32_t harqIndex = FfMacSchedulerUeTable::HarqIndex (slot, harqId);
+          m_ues.m_ulHarqProcessesDciBuffer.at (harqIndex) = uldci;
           // Update HARQ process status (RV 0)
-          std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (uldci.m_rnti);
-          if (itStat == m_ulHarqProcessesStatus.end ())
-            {
-              NS_LOG_ERROR ("No info find in HARQ buffer for UE (might change eNB) " << uldci.m_rnti);
-            }
-          (*itStat).second.at (harqId) = 0;
+          m_ues.m_ulHarqProcessesStatus[harqIndex] = 0;
         }
 
-      NS_LOG_INFO (this << " UE Allocation RNTI " << (*it).first << " startPRB " << (uint32_t)uldci.m_rbStart << " nPRB " << (uint32_t)uldci.m_rbLen << " CQI " << cqi << " MCS " << (uint32_t)uldci.m_mcs << " TBsize " << uldci.m_tbSize << " RbAlloc " << rbAllocated << " harqId " << (uint16_t)harqId);
+      NS_LOG_INFO (this << " UE Allocation RNTI " << m_ues.m_rnti[slot] << " startPRB " << (uint32_t)uldci.m_rbStart << " nPRB " << (uint32_t)uldci.m_rbLen << " CQI " << cqi << " MCS " << (uint32_t)uldci.m_mcs << " TBsize " << uldci.m_tbSize << " RbAlloc " << rbAllocated << " harqId " << (uint16_t)harqId);
 
       // update TTI  UE stats
-      itStats = m_flowStatsUl.find ((*it).first);
+      itStats = m_flowStatsUl.find (m_ues.m_rnti[slot]);
       if (itStats != m_flowStatsUl.end ())
         {
           (*itStats).second.lastTtiBytesTrasmitted =  uldci.m_tbSize;
@@ -1642,20 +1501,16 @@ FdBetFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sc
         }
 
 
-      it++;
-      if (it == m_ceBsrRxed.end ())
-        {
-          // restart from the first
-          it = m_ceBsrRxed.begin ();
-        }
+      // restart from the first after the last one
+      it = (it + 1) % bsrSlots.size ();
       if ((rbAllocated == m_cschedCellConfig.m_ulBandwidth) || (rbPerFlow == 0))
         {
           // Stop allocation: no more PRBs
-          m_nextRntiUl = (*it).first;
+          m_nextRntiUl = m_ues.m_rnti[bsrSlots.at (it)];
           break;
         }
     }
-  while (((*it).first != m_nextRntiUl)&&(rbPerFlow!=0));
+  while ((m_ues.m_rnti[bsrSlots.at (it)] != m_nextRntiUl)&&(rbPerFlow!=0));
 
 
   // Update global UE stats
@@ -1694,8 +1549,6 @@ FdBetFfMacScheduler::DoSchedUlMacCtrlInfoReq (const struct FfMacSchedSapProvider
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t,uint32_t>::iterator it;
-
   for (unsigned int i = 0; i < params.m_macCeList.size (); i++)
     {
       if ( params.m_macCeList.at (i).m_macCeType == MacCeListElement_s::BSR )
@@ -1716,17 +1569,15 @@ FdBetFfMacScheduler::DoSchedUlMacCtrlInfoReq (const struct FfMacSchedSapProvider
 
           uint16_t rnti = params.m_macCeList.at (i).m_rnti;
           NS_LOG_LOGIC (this << "RNTI=" << rnti << " buffer=" << buffer);
-          it = m_ceBsrRxed.find (rnti);
-          if (it == m_ceBsrRxed.end ())
+          uint16_t slot = m_ues.Find (rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
-              // create the new entry
-              m_ceBsrRxed.insert ( std::pair<uint16_t, uint32_t > (rnti, buffer));
-            }
-          else
-            {
-              // update the buffer size value
-              (*it).second = buffer;
+              NS_LOG_INFO (this << " BSR of unknown UE " << rnti << " ignored");
+              continue;
             }
+          // update the buffer size value
+          m_ues.m_bsrRxed[slot] = true;
+          m_ues.m_bsr[slot] = buffer;
         }
     }
 
@@ -1884,49 +1735,37 @@ FdBetFfMacScheduler::DoSchedUlCqiInfoReq (const struct FfMacSchedSapProvider::Sc
 void
 FdBetFfMacScheduler::RefreshDlCqiMaps (void)
 {
-  // refresh DL CQI P01 Map
-  std::map <uint16_t,uint32_t>::iterator itP10 = m_p10CqiTimers.begin ();
-  while (itP10 != m_p10CqiTimers.end ())
+  const std::vector<uint16_t>& slots = m_ues.GetSlots ();
+  for (std::vector<uint16_t>::const_iterator itSlot = slots.begin (); itSlot != slots.end (); itSlot++)
     {
-      NS_LOG_INFO (this << " P10-CQI for user " << (*itP10).first << " is " << (uint32_t)(*itP10).second << " thr " << (uint32_t)m_cqiTimersThreshold);
-      if ((*itP10).second == 0)
-        {
-          // delete correspondent entries
-          std::map <uint16_t,uint8_t>::iterator itMap = m_p10CqiRxed.find ((*itP10).first);
-          NS_ASSERT_MSG (itMap != m_p10CqiRxed.end (), " Does not find CQI report for user " << (*itP10).first);
-          NS_LOG_INFO (this << " P10-CQI expired for user " << (*itP10).first);
-          m_p10CqiRxed.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itP10;
-          itP10++;
-          m_p10CqiTimers.erase (temp);
-        }
-      else
+      // refresh DL CQI P01
+      if (m_ues.m_p10CqiRxed[*itSlot])
         {
-          (*itP10).second--;
-          itP10++;
+          NS_LOG_INFO (this << " P10-CQI for user " << m_ues.m_rnti[*itSlot] << " is " << (uint32_t)m_ues.m_p10CqiTimer[*itSlot] << " thr " << (uint32_t)m_cqiTimersThreshold);
+          if (m_ues.m_p10CqiTimer[*itSlot] == 0)
+            {
+              NS_LOG_INFO (this << " P10-CQI expired for user " << m_ues.m_rnti[*itSlot]);
+              m_ues.m_p10CqiRxed[*itSlot] = false;
+            }
+          else
+            {
+              m_ues.m_p10CqiTimer[*itSlot]--;
+            }
         }
-    }
 
-  // refresh DL CQI A30 Map
-  std::map <uint16_t,uint32_t>::iterator itA30 = m_a30CqiTimers.begin ();
-  while (itA30 != m_a30CqiTimers.end ())
-    {
-      NS_LOG_INFO (this << " A30-CQI for user " << (*itA30).first << " is " << (uint32_t)(*itA30).second << " thr " << (uint32_t)m_cqiTimersThreshold);
-      if ((*itA30).second == 0)
-        {
-          // delete correspondent entries
-          std::map <uint16_t,SbMeasResult_s>::iterator itMap = m_a30CqiRxed.find ((*itA30).first);
-          NS_ASSERT_MSG (itMap != m_a30CqiRxed.end (), " Does not find CQI report for user " << (*itA30).first);
-          NS_LOG_INFO (this << " A30-CQI expired for user " << (*itA30).first);
-          m_a30CqiRxed.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itA30;
-          itA30++;
-          m_a30CqiTimers.erase (temp);
-        }
-      else
+      // refresh DL CQI A30
+      if (m_ues.m_a30CqiRxed[*itSlot])
         {
-          (*itA30).second--;
-          itA30++;
+          NS_LOG_INFO (this << " A30-CQI for user " << m_ues.m_rnti[*itSlot] << " is " << (uint32_t)m_ues.m_a30CqiTimer[*itSlot] << " thr " << (uint32_t)m_cqiTimersThreshold);
+          if (m_ues.m_a30CqiTimer[*itSlot] == 0)
+            {
+              NS_LOG_INFO (this << " A30-CQI expired for user " << m_ues.m_rnti[*itSlot]);
+              m_ues.m_a30CqiRxed[*itSlot] = false;
+            }
+          else
+            {
+              m_ues.m_a30CqiTimer[*itSlot]--;
+            }
         }
     }
 
@@ -2021,17 +1860,17 @@ FdBetFfMacScheduler::UpdateUlRlcBufferInfo (uint16_t rnti, uint16_t size)
 {
 
   size = size - 2; // remove the minimum RLC overhead
-  std::map <uint16_t,uint32_t>::iterator it = m_ceBsrRxed.find (rnti);
-  if (it != m_ceBsrRxed.end ())
+  uint16_t slot = m_ues.Find (rnti);
+  if ((slot != FfMacSchedulerUeTable::NO_SLOT) && m_ues.m_bsrRxed[slot])
     {
-      NS_LOG_INFO (this << " UE " << rnti << " size " << size << " BSR " << (*it).second);
-      if ((*it).second >= size)
+      NS_LOG_INFO (this << " UE " << rnti << " size " << size << " BSR " << m_ues.m_bsr[slot]);
+      if (m_ues.m_bsr[slot] >= size)
         {
-          (*it).second -= size;
+          m_ues.m_bsr[slot] -= size;
         }
       else
         {
-          (*it).second = 0;
+          m_ues.m_bsr[slot] = 0;
         }
     }
   else
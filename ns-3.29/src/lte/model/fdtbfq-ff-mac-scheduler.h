@@ -31,6 +31,7 @@
 #include <ns3/nstime.h>
 #include <ns3/lte-amc.h>
 #include <ns3/lte-ffr-sap.h>
+#include <ns3/ff-mac-scheduler-ue-table.h>
 
 /**
  * value for SINR outside the range defined by FF-API, used to indicate that there
@@ -328,6 +329,11 @@ private:
   */
   std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters> m_rlcBufferReq;
 
+  /**
+  * State of the UEs: txMode, HARQ processes, DL CQIs and BSRs
+  */
+  FfMacSchedulerUeTable m_ues;
+
 
   /**
   * Map of UE statistics (per RNTI basis) in downlink
@@ -339,26 +345,6 @@ private:
   */
   std::map <uint16_t, fdtbfqsFlowPerf_t> m_flowStatsUl;
 
-  /**
-  * Map of UE's DL CQI P01 received
-  */
-  std::map <uint16_t,uint8_t> m_p10CqiRxed;
-
-  /**
-  * Map of UE's timers on DL CQI P01 received
-  */
-  std::map <uint16_t,uint32_t> m_p10CqiTimers;
-
-  /**
-  * Map of UE's DL CQI A30 received
-  */
-  std::map <uint16_t,SbMeasResult_s> m_a30CqiRxed;
-
-  /**
-  * Map of UE's timers on DL CQI A30 received
-  */
-  std::map <uint16_t,uint32_t> m_a30CqiTimers;
-
   /**
   * Map of previous allocated UE per RBG
   * (used to retrieve info from UL-CQI)
@@ -375,11 +361,6 @@ private:
   */
   std::map <uint16_t, uint32_t> m_ueCqiTimers;
 
-  /**
-  * Map of UE's buffer status reports received
-  */
-  std::map <uint16_t,uint32_t> m_ceBsrRxed;
-
   // MAC SAPs
   FfMacCschedSapUser* m_cschedSapUser; ///< Csched SAP user
   FfMacSchedSapUser* m_schedSapUser; ///< sched SAP user
@@ -398,8 +379,6 @@ private:
 
   uint32_t m_cqiTimersThreshold; ///< # of TTIs for which a CQI can be considered valid
 
-  std::map <uint16_t,uint8_t> m_uesTxMode; ///< txMode of the UEs
-
   uint64_t bankSize;  ///< the number of bytes in token bank
 
   int m_debtLimit;  ///< flow debt limit (byte)
@@ -412,24 +391,8 @@ private:
 
   // HARQ attributes
   bool m_harqOn; ///< m_harqOn when false inhibit the HARQ mechanisms (by default active)
-  std::map <uint16_t, uint8_t> m_dlHarqCurrentProcessId; ///< DL HARQ current process ID
-  //HARQ status
-  // 0: process Id available
-  // x>0: process Id equal to `x` transmission count
-  std::map <uint16_t, DlHarqProcessesStatus_t> m_dlHarqProcessesStatus; ///< DL HARQ process status
-  std::map <uint16_t, DlHarqProcessesTimer_t> m_dlHarqProcessesTimer; ///< DL HARQ process timer
-  std::map <uint16_t, DlHarqProcessesDciBuffer_t> m_dlHarqProcessesDciBuffer; ///< DL HARQ process DCI buffer
-  std::map <uint16_t, DlHarqRlcPduListBuffer_t> m_dlHarqProcessesRlcPduListBuffer; ///< DL HARQ process RLC PDU list buffer
   std::vector <DlInfoListElement_s> m_dlInfoListBuffered; ///< HARQ retx buffered
 
-  std::map <uint16_t, uint8_t> m_ulHarqCurrentProcessId; ///< UL HARQ current process ID
-  //HARQ status
-  // 0: process Id available
-  // x>0: process Id equal to `x` transmission count
-  std::map <uint16_t, UlHarqProcessesStatus_t> m_ulHarqProcessesStatus; ///< UL HARQ process status
-  std::map <uint16_t, UlHarqProcessesDciBuffer_t> m_ulHarqProcessesDciBuffer; ///< UL HARQ process DCI buffer
-
-
   // RACH attributes
   std::vector <struct RachListElement_s> m_rachList; ///< RACH list
   std::vector <uint16_t> m_rachAllocationMap; ///< RACH allocation map
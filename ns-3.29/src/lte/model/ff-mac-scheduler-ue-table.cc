@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/assert.h>
+#include <algorithm>
+
+#include "ff-mac-scheduler-ue-table.h"
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FfMacSchedulerUeTable");
+
+const uint16_t FfMacSchedulerUeTable::NO_SLOT;
+const uint8_t FfMacSchedulerUeTable::DL_HARQ_LAYERS;
+
+FfMacSchedulerUeTable::FfMacSchedulerUeTable ()
+{
+}
+
+uint16_t
+FfMacSchedulerUeTable::Add (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  uint16_t slot = Find (rnti);
+  if (slot != NO_SLOT)
+    {
+      return slot;
+    }
+  if (m_freeSlots.empty ())
+    {
+      NS_ASSERT_MSG (m_rnti.size () < NO_SLOT, "too many UEs");
+      slot = m_rnti.size ();
+      uint16_t capacity = slot + 1;
+      m_rnti.resize (capacity);
+      m_txMode.resize (capacity);
+      m_dlHarqCurrentProcessId.resize (capacity);
+      m_dlHarqProcessesStatus.resize (HarqIndex (capacity, 0));
+      m_dlHarqProcessesTimer.resize (HarqIndex (capacity, 0));
+      m_dlHarqProcessesDciBuffer.resize (HarqIndex (capacity, 0));
+      m_dlHarqProcessesRlcPduListBuffer.resize (RlcPduListIndex (capacity, 0, 0));
+      m_ulHarqCurrentProcessId.resize (capacity);
+      m_ulHarqProcessesStatus.resize (HarqIndex (capacity, 0));
+      m_ulHarqProcessesDciBuffer.resize (HarqIndex (capacity, 0));
+      m_p10CqiRxed.resize (capacity);
+      m_p10Cqi.resize (capacity);
+      m_p10CqiTimer.resize (capacity);
+      m_a30CqiRxed.resize (capacity);
+      m_a30Cqi.resize (capacity);
+      m_a30CqiTimer.resize (capacity);
+      m_bsrRxed.resize (capacity);
+      m_bsr.resize (capacity);
+    }
+  else
+    {
+      slot = m_freeSlots.back ();
+      m_freeSlots.pop_back ();
+    }
+  if (rnti >= m_rntiToSlot.size ())
+    {
+      m_rntiToSlot.resize (rnti + 1, NO_SLOT);
+    }
+  m_rntiToSlot[rnti] = slot;
+
+  m_rnti[slot] = rnti;
+  m_txMode[slot] = 0;
+  m_dlHarqCurrentProcessId[slot] = 0;
+  m_ulHarqCurrentProcessId[slot] = 0;
+  for (uint8_t i = 0; i < HARQ_PROC_NUM; i++)
+    {
+      uint32_t index = HarqIndex (slot, i);
+      m_dlHarqProcessesStatus[index] = 0;
+      m_dlHarqProcessesTimer[index] = 0;
+      m_dlHarqProcessesDciBuffer[index] = DlDciListElement_s ();
+      m_ulHarqProcessesStatus[index] = 0;
+      m_ulHarqProcessesDciBuffer[index] = UlDciListElement_s ();
+    }
+  m_p10CqiRxed[slot] = false;
+  m_p10Cqi[slot] = 0;
+  m_p10CqiTimer[slot] = 0;
+  m_a30CqiRxed[slot] = false;
+  m_a30CqiTimer[slot] = 0;
+  m_bsrRxed[slot] = false;
+  m_bsr[slot] = 0;
+
+  std::vector<uint16_t>::iterator it = m_slots.begin ();
+  while (it != m_slots.end () && m_rnti[*it] < rnti)
+    {
+      ++it;
+    }
+  m_slots.insert (it, slot);
+  return slot;
+}
+
+void
+FfMacSchedulerUeTable::Remove (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  uint16_t slot = Find (rnti);
+  if (slot == NO_SLOT)
+    {
+      return;
+    }
+  m_rntiToSlot[rnti] = NO_SLOT;
+  m_slots.erase (std::find (m_slots.begin (), m_slots.end (), slot));
+  // release the memory of the buffers
+  for (uint8_t layer = 0; layer < DL_HARQ_LAYERS; layer++)
+    {
+      for (uint8_t i = 0; i < HARQ_PROC_NUM; i++)
+        {
+          std::vector<RlcPduListElement_s> ().swap (m_dlHarqProcessesRlcPduListBuffer[RlcPduListIndex (slot, layer, i)]);
+        }
+    }
+  m_a30Cqi[slot] = SbMeasResult_s ();
+  m_freeSlots.push_back (slot);
+}
+
+uint16_t
+FfMacSchedulerUeTable::GetCapacity (void) const
+{
+  return m_rnti.size ();
+}
+
+void
+FfMacSchedulerUeTable::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_rnti.clear ();
+  m_txMode.clear ();
+  m_dlHarqCurrentProcessId.clear ();
+  m_dlHarqProcessesStatus.clear ();
+  m_dlHarqProcessesTimer.clear ();
+  m_dlHarqProcessesDciBuffer.clear ();
+  m_dlHarqProcessesRlcPduListBuffer.clear ();
+  m_ulHarqCurrentProcessId.clear ();
+  m_ulHarqProcessesStatus.clear ();
+  m_ulHarqProcessesDciBuffer.clear ();
+  m_p10CqiRxed.clear ();
+  m_p10Cqi.clear ();
+  m_p10CqiTimer.clear ();
+  m_a30CqiRxed.clear ();
+  m_a30Cqi.clear ();
+  m_a30CqiTimer.clear ();
+  m_bsrRxed.clear ();
+  m_bsr.clear ();
+  m_rntiToSlot.clear ();
+  m_slots.clear ();
+  m_freeSlots.clear ();
+}
+
+} // namespace ns3
@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FF_MAC_SCHEDULER_UE_TABLE_H
+#define FF_MAC_SCHEDULER_UE_TABLE_H
+
+#include <ns3/ff-mac-common.h>
+#include <vector>
+
+#define HARQ_PROC_NUM 8
+
+namespace ns3 {
+
+
+/**
+ * \ingroup ff-api
+ *
+ * A dense table of the state of the UEs of a cell which is common to
+ * the FF MAC schedulers: transmission mode, DL and UL HARQ processes,
+ * DL CQI reports and BSR. It is used by the schedulers instead of one
+ * std::map per kind of per-UE state.
+ *
+ * Each UE is given a slot when it is added, which remains valid until
+ * it is removed; the slots of removed UEs are reused. The RNTI to slot
+ * lookup is a direct index. The state is stored as a struct of arrays:
+ * each field is a vector indexed by slot, or, for the fields of the
+ * HARQ processes, by HarqIndex, so that the per-TTI loops over the UEs
+ * do not perform any tree lookup and only touch the fields they use.
+ * The slots are also kept sorted by RNTI, so that the schedulers visit
+ * the UEs in the same order as with a map indexed by RNTI.
+ *
+ * Note that adding a UE may reallocate the vectors, and hence
+ * invalidate the references to their elements.
+ */
+class FfMacSchedulerUeTable
+{
+public:
+  /// the slot returned for an unknown RNTI
+  static const uint16_t NO_SLOT = 0xffff;
+  /// the number of layers of the DL HARQ RLC PDU list buffers
+  static const uint8_t DL_HARQ_LAYERS = 2;
+
+  FfMacSchedulerUeTable ();
+
+  /**
+   * Add a UE, with a state in which all HARQ processes are available
+   * and no CQI or BSR has been received.
+   *
+   * \param rnti the RNTI of the UE
+   * \return the slot of the UE; if the UE was already in the table,
+   * its slot is returned and its state is left unchanged
+   */
+  uint16_t Add (uint16_t rnti);
+  /**
+   * Remove a UE, if present
+   *
+   * \param rnti the RNTI of the UE
+   */
+  void Remove (uint16_t rnti);
+  /**
+   * \param rnti the RNTI of a UE
+   * \return the slot of the UE, or NO_SLOT if the UE is not in the table
+   */
+  uint16_t Find (uint16_t rnti) const
+  {
+    return rnti < m_rntiToSlot.size () ? m_rntiToSlot[rnti] : NO_SLOT;
+  }
+  /**
+   * \return the slots of the UEs in the table, sorted by RNTI
+   */
+  const std::vector<uint16_t>& GetSlots (void) const
+  {
+    return m_slots;
+  }
+  /**
+   * \return the number of slots allocated so far, which is larger
+   * than any slot of a UE in the table
+   */
+  uint16_t GetCapacity (void) const;
+  /**
+   * Remove all the UEs
+   */
+  void Clear (void);
+
+  /**
+   * \param slot the slot of a UE
+   * \param harqId the id of a HARQ process
+   * \return the index of the HARQ process of the UE in the vectors of
+   * the HARQ processes
+   */
+  static uint32_t HarqIndex (uint16_t slot, uint8_t harqId)
+  {
+    return static_cast<uint32_t> (slot) * HARQ_PROC_NUM + harqId;
+  }
+  /**
+   * \param slot the slot of a UE
+   * \param layer the layer
+   * \param harqId the id of a DL HARQ process
+   * \return the index of the RLC PDU list of the layer of the HARQ
+   * process of the UE in m_dlHarqProcessesRlcPduListBuffer
+   */
+  static uint32_t RlcPduListIndex (uint16_t slot, uint8_t layer, uint8_t harqId)
+  {
+    return (static_cast<uint32_t> (slot) * DL_HARQ_LAYERS + layer) * HARQ_PROC_NUM + harqId;
+  }
+
+  std::vector<uint16_t> m_rnti;   ///< RNTI, by slot
+  std::vector<uint8_t> m_txMode;  ///< transmission mode, by slot
+
+  std::vector<uint8_t> m_dlHarqCurrentProcessId; ///< DL HARQ current process ID, by slot
+  /**
+   * DL HARQ process status, by HarqIndex
+   * 0: process Id available
+   * x>0: process Id equal to `x` transmission count
+   */
+  std::vector<uint8_t> m_dlHarqProcessesStatus;
+  std::vector<uint8_t> m_dlHarqProcessesTimer; ///< DL HARQ process timer, by HarqIndex
+  std::vector<DlDciListElement_s> m_dlHarqProcessesDciBuffer; ///< DL HARQ process DCI buffer, by HarqIndex
+  /// DL HARQ RLC PDU lists, by RlcPduListIndex
+  std::vector< std::vector<RlcPduListElement_s> > m_dlHarqProcessesRlcPduListBuffer;
+
+  std::vector<uint8_t> m_ulHarqCurrentProcessId; ///< UL HARQ current process ID, by slot
+  /**
+   * UL HARQ process status, by HarqIndex
+   * 0: process Id available
+   * x>0: process Id equal to `x` transmission count
+   */
+  std::vector<uint8_t> m_ulHarqProcessesStatus;
+  std::vector<UlDciListElement_s> m_ulHarqProcessesDciBuffer; ///< UL HARQ process DCI buffer, by HarqIndex
+
+  std::vector<bool> m_p10CqiRxed;         ///< whether a P10 DL CQI is available, by slot
+  std::vector<uint8_t> m_p10Cqi;          ///< last P10 DL CQI, by slot
+  std::vector<uint32_t> m_p10CqiTimer;    ///< TTIs before the P10 DL CQI expires, by slot
+  std::vector<bool> m_a30CqiRxed;         ///< whether an A30 DL CQI is available, by slot
+  std::vector<SbMeasResult_s> m_a30Cqi;   ///< last A30 DL CQI, by slot
+  std::vector<uint32_t> m_a30CqiTimer;    ///< TTIs before the A30 DL CQI expires, by slot
+
+  std::vector<bool> m_bsrRxed;            ///< whether a BSR was received, by slot
+  std::vector<uint32_t> m_bsr;            ///< buffer size reported in the last BSR, minus the granted bytes, by slot
+
+private:
+  std::vector<uint16_t> m_rntiToSlot; ///< the slot of each RNTI, or NO_SLOT
+  std::vector<uint16_t> m_slots;      ///< the slots in use, sorted by RNTI
+  std::vector<uint16_t> m_freeSlots;  ///< the slots which can be reused
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_SCHEDULER_UE_TABLE_H */
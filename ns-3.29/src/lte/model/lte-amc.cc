@@ -26,6 +26,7 @@
 #include <ns3/assert.h>
 #include <ns3/math.h>
 #include <vector>
+#include <algorithm>
 #include <ns3/spectrum-value.h>
 #include <ns3/double.h>
 #include "ns3/enum.h"
@@ -231,6 +232,7 @@ static const int TransportBlockSizeTable [110][27] = {
 
 
 LteAmc::LteAmc ()
+  : m_sinrThresholdsBer (-1.0)
 {
 }
 
@@ -266,11 +268,8 @@ LteAmc::GetCqiFromSpectralEfficiency (double s)
 {
   NS_LOG_FUNCTION (s);
   NS_ASSERT_MSG (s >= 0.0, "negative spectral efficiency = " << s);
-  int cqi = 0;
-  while ((cqi < 15) && (SpectralEfficiencyForCqi[cqi + 1] < s))
-    {
-      ++cqi;
-    }
+  // number of CQIs (from 1 to 15) with a lower spectral efficiency
+  int cqi = std::lower_bound (SpectralEfficiencyForCqi + 1, SpectralEfficiencyForCqi + 16, s) - (SpectralEfficiencyForCqi + 1);
   NS_LOG_LOGIC ("cqi = " << cqi);
   return cqi;
 }
@@ -326,6 +325,36 @@ LteAmc::GetSpectralEfficiencyFromCqi (int cqi)
 }
 
 
+void
+LteAmc::UpdateSinrThresholds (void)
+{
+  NS_LOG_FUNCTION (this << m_ber);
+  double gamma = (-std::log (5.0 * m_ber)) / 1.5;
+  for (int cqi = 1; cqi <= 15; ++cqi)
+    {
+      // inverse of s = log2 (1 + sinr / gamma)
+      m_sinrThresholds[cqi - 1] = gamma * (std::pow (2.0, SpectralEfficiencyForCqi[cqi]) - 1.0);
+    }
+  m_sinrThresholdsBer = m_ber;
+}
+
+int
+LteAmc::GetCqiFromSinr (double sinr)
+{
+  // the CQI is the number of CQIs whose spectral efficiency is lower
+  // than the one of the RB, i.e., whose threshold is lower than sinr
+  int cqi = std::lower_bound (m_sinrThresholds, m_sinrThresholds + 15, sinr) - m_sinrThresholds;
+  // relative margin well above the rounding errors of log2 and pow
+  static const double margin = 1e-9;
+  if ((cqi > 0 && sinr - m_sinrThresholds[cqi - 1] <= margin * m_sinrThresholds[cqi - 1])
+      || (cqi < 15 && m_sinrThresholds[cqi] - sinr <= margin * m_sinrThresholds[cqi]))
+    {
+      double s = log2 ( 1 + ( sinr / ( (-std::log (5.0 * m_ber )) / 1.5) ));
+      cqi = GetCqiFromSpectralEfficiency (s);
+    }
+  return cqi;
+}
+
 std::vector<int>
 LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
 {
@@ -336,7 +365,11 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
   
   if (m_amcModel == PiroEW2010)
     {
-
+      if (m_sinrThresholdsBer != m_ber)
+        {
+          UpdateSinrThresholds ();
+        }
+      cqi.reserve (sinr.GetSpectrumModel ()->GetNumBands ());
       for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
         {
           double sinr_ = (*it);
@@ -347,21 +380,32 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
           else
             {
               /*
-              * Compute the spectral efficiency from the SINR
+              * The CQI is the highest one whose spectral efficiency is
+              * lower than the spectral efficiency of the RB:
               *                                        SINR
               * spectralEfficiency = log2 (1 + -------------------- )
               *                                    -ln(5*BER)/1.5
               * NB: SINR must be expressed in linear units
+              *
+              * The spectral efficiency is monotonic in the SINR, hence
+              * the SINR is directly compared with the SINR thresholds of
+              * the CQIs.
               */
-
-              double s = log2 ( 1 + ( sinr_ / ( (-std::log (5.0 * m_ber )) / 1.5) ));
-
-              int cqi_ = GetCqiFromSpectralEfficiency (s);
+              int cqi_;
+              if (sinr_ > 0.0)
+                {
+                  cqi_ = GetCqiFromSinr (sinr_);
+                }
+              else
+                {
+                  double s = log2 ( 1 + ( sinr_ / ( (-std::log (5.0 * m_ber )) / 1.5) ));
+                  cqi_ = GetCqiFromSpectralEfficiency (s);
+                }
 
               NS_LOG_LOGIC (" PRB =" << cqi.size ()
                                     << ", sinr = " << sinr_
                                     << " (=" << 10 * std::log10 (sinr_) << " dB)"
-                                    << ", spectral efficiency =" << s
+                                    << ", spectral efficiency =" << log2 ( 1 + ( sinr_ / ( (-std::log (5.0 * m_ber )) / 1.5) ))
                                     << ", CQI = " << cqi_ << ", BER = " << m_ber);
 
               cqi.push_back (cqi_);
@@ -381,10 +425,17 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
          {
             uint8_t mcs = 0;
             TbStats_t tbStats;
+            HarqProcessInfoList_t harqInfoList;
+            double rbgMi = 0.0;
             while (mcs <= 28)
               {
-                HarqProcessInfoList_t harqInfoList;
-                tbStats = LteMiErrorModel::GetTbDecodificationStats (sinr, rbgMap, (uint16_t)GetDlTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
+                // the MI of the RBG only depends on the modulation, hence
+                // it is evaluated once per modulation rather than per MCS
+                if ((mcs == 0) || (mcs == MI_QPSK_MAX_ID + 1) || (mcs == MI_16QAM_MAX_ID + 1))
+                  {
+                    rbgMi = LteMiErrorModel::Mib (sinr, rbgMap, mcs);
+                  }
+                tbStats = LteMiErrorModel::GetTbDecodificationStats (rbgMi, (uint16_t)GetDlTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
                 if (tbStats.tbler > 0.1)
                   {
                     break;
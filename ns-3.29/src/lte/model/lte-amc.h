@@ -118,6 +118,25 @@ public:
   int GetCqiFromSpectralEfficiency (double s);
   
 private:
+  /**
+   * \brief Compute the SINR thresholds of the CQIs for the current BER
+   */
+  void UpdateSinrThresholds (void);
+
+  /**
+   * \brief Get the CQI of a RB according to the PiroEW2010 model
+   *
+   * The CQI is found by a binary search of the linear SINR in
+   * m_sinrThresholds, instead of computing the spectral efficiency of
+   * the RB. The SINRs too close to a threshold to be sure of the
+   * result of the comparison of the spectral efficiencies are
+   * evaluated as in GetCqiFromSpectralEfficiency, hence the CQI is
+   * always the same.
+   *
+   * \param sinr the linear SINR of the RB, greater than 0
+   * \return the CQI value
+   */
+  int GetCqiFromSinr (double sinr);
   
   /**
    * The `Ber` attribute.
@@ -133,6 +152,14 @@ private:
    */
   AmcModel m_amcModel;
 
+  /**
+   * The lowest linear SINR for which each CQI from 1 to 15 is selected
+   * by the PiroEW2010 model, i.e., the SINR for which the spectral
+   * efficiency is equal to the spectral efficiency of the CQI.
+   */
+  double m_sinrThresholds[15];
+  double m_sinrThresholdsBer; ///< BER for which m_sinrThresholds were computed
+
 }; // end of `class LteAmc`
 
 
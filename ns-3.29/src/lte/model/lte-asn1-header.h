@@ -25,6 +25,7 @@
 
 #include <bitset>
 #include <string>
+#include <vector>
 
 namespace ns3 {
 
@@ -69,12 +70,49 @@ protected:
   mutable uint8_t m_numSerializationPendingBits; //!< number of pending bits
   mutable bool m_isDataSerialized; //!< true if data is serialized
   mutable Buffer m_serializationResult; //!< serialization result
+  /// octets serialized but not yet written to m_serializationResult
+  mutable std::vector<uint8_t> m_serializationOctets;
 
   /**
-   * Function to write in m_serializationResult, after resizing its size
+   * Function to write an octet in m_serializationResult. The octets are
+   * collected and written in a single operation by
+   * FlushSerializationOctets.
    * \param octet bits to write
    */
   void WriteOctet (uint8_t octet) const;
+  /**
+   * Write the octets collected by WriteOctet at the end of
+   * m_serializationResult.
+   */
+  void FlushSerializationOctets (void) const;
+
+  /**
+   * Serialize the least significant bits of a word, most significant bit
+   * first, appending them to the pending bits. This is the primitive on
+   * which all the Serialize* functions are built: the complete octets are
+   * written at once instead of bit by bit.
+   * \param value the bits to serialize
+   * \param numBits the number of bits to serialize (at most 32)
+   */
+  void SerializeBits (uint32_t value, int numBits) const;
+  /**
+   * Deserialize bits into the least significant bits of a word, most
+   * significant bit first, starting with the pending bits. This is the
+   * counterpart of SerializeBits.
+   * \param value buffer to store the result
+   * \param numBits the number of bits to deserialize (at most 32)
+   * \param bIterator buffer iterator
+   * \returns the modified buffer iterator
+   */
+  Buffer::Iterator DeserializeBits (uint32_t *value, int numBits,
+                                    Buffer::Iterator bIterator);
+  /**
+   * Compute the number of bits needed to encode a constrained whole
+   * number (clause 11.5.6 ITU-T X.691).
+   * \param range the number of values of the constrained whole number
+   * \returns the number of bits
+   */
+  static int GetRequiredBits (int range);
 
   // Serialization functions
 
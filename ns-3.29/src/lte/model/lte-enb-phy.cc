@@ -36,6 +36,7 @@
 #include "lte-enb-net-device.h"
 #include "lte-ue-rrc.h"
 #include "lte-enb-mac.h"
+#include "lte-tti-clock.h"
 #include <ns3/lte-common.h>
 #include <ns3/lte-vendor-specific-parameters.h>
 
@@ -276,7 +277,16 @@ LteEnbPhy::DoInitialize ()
           haveNodeId = true;
         }
     }
-  if (haveNodeId)
+  if ((m_ttiClock != 0) && !m_ttiClock->AddEnbPhy (this))
+    {
+      // the clock has already started
+      m_ttiClock = 0;
+    }
+  if (m_ttiClock != 0)
+    {
+      NS_LOG_LOGIC (this << " frames and subframes started by " << m_ttiClock);
+    }
+  else if (haveNodeId)
     {
       Simulator::ScheduleWithContext (nodeId, Seconds (0), &LteEnbPhy::StartFrame, this);
     }
@@ -765,7 +775,11 @@ LteEnbPhy::StartSubFrame (void)
 
   // send data frame
   Ptr<PacketBurst> pb = GetPacketBurst ();
-  if (pb)
+  if (pb && (m_ttiClock != 0))
+    {
+      m_ttiClock->ScheduleDataChannels (DL_CTRL_DELAY_FROM_SUBFRAME_START, this, pb);
+    }
+  else if (pb)
     {
       Simulator::Schedule (DL_CTRL_DELAY_FROM_SUBFRAME_START, // ctrl frame fixed to 3 symbols
                            &LteEnbPhy::SendDataChannels,
@@ -775,9 +789,12 @@ LteEnbPhy::StartSubFrame (void)
   // trigger the MAC
   m_enbPhySapUser->SubframeIndication (m_nrFrames, m_nrSubFrames);
 
-  Simulator::Schedule (Seconds (GetTti ()),
-                       &LteEnbPhy::EndSubFrame,
-                       this);
+  if (m_ttiClock == 0)
+    {
+      Simulator::Schedule (Seconds (GetTti ()),
+                           &LteEnbPhy::EndSubFrame,
+                           this);
+    }
 
 }
 
@@ -886,6 +903,7 @@ LteEnbPhy::CreatePuschCqiReport (const SpectrumValue& sinr)
   Values::const_iterator it;
   FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulcqi;
   ulcqi.m_ulCqi.m_type = UlCqi_s::PUSCH;
+  ulcqi.m_ulCqi.m_sinr.reserve (sinr.GetSpectrumModel ()->GetNumBands ());
   int i = 0;
   for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
     {
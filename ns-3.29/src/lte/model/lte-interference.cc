@@ -21,6 +21,7 @@
 
 #include "lte-interference.h"
 #include "lte-chunk-processor.h"
+#include "lte-tti-clock.h"
 
 #include <ns3/simulator.h>
 #include <ns3/log.h>
@@ -53,6 +54,8 @@ LteInterference::DoDispose ()
   m_rxSignal = 0;
   m_allSignals = 0;
   m_noise = 0;
+  m_persistentSignals.Clear ();
+  m_ttiClock = 0;
   Object::DoDispose ();
 } 
 
@@ -146,7 +149,24 @@ LteInterference::AddSignal (Ptr<const SpectrumValue> spd, const Time duration)
       // boundary further.
       m_lastSignalIdBeforeReset += 0x10000000;
     }
-  Simulator::Schedule (duration, &LteInterference::DoSubtractSignal, this, spd, signalId);
+  if (m_ttiClock != 0)
+    {
+      m_ttiClock->ScheduleRx (duration, MakeEvent (&LteInterference::DoSubtractSignal, this, spd, signalId));
+    }
+  else
+    {
+      Simulator::Schedule (duration, &LteInterference::DoSubtractSignal, this, spd, signalId);
+    }
+}
+
+
+void
+LteInterference::AddPersistentSignal (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> spd)
+{
+  NS_LOG_FUNCTION (this << signal << *spd);
+  // the contribution of the signal to each chunk depends only on the
+  // time during which it is on, so there is no need to split the chunk
+  m_persistentSignals.Add (signal, spd);
 }
 
 
@@ -189,6 +209,10 @@ LteInterference::ConditionallyEvaluateChunk ()
       NS_LOG_LOGIC (this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals << " noise = " << *m_noise);
 
       SpectrumValue interf =  (*m_allSignals) - (*m_rxSignal) + (*m_noise);
+      if (!m_persistentSignals.IsEmpty ())
+        {
+          m_persistentSignals.AddAveragePsd (m_lastChangeTime, Now (), interf);
+        }
 
       SpectrumValue sinr = (*m_rxSignal) / interf;
       Time duration = Now () - m_lastChangeTime;
@@ -227,6 +251,13 @@ LteInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd
   m_lastSignalIdBeforeReset = m_lastSignalId;
 }
 
+void
+LteInterference::SetTtiClock (Ptr<LteTtiClock> clock)
+{
+  NS_LOG_FUNCTION (this << clock);
+  m_ttiClock = clock;
+}
+
 void
 LteInterference::AddRsPowerChunkProcessor (Ptr<LteChunkProcessor> p)
 {
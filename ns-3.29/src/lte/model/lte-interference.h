@@ -26,6 +26,7 @@
 #include <ns3/packet.h>
 #include <ns3/nstime.h>
 #include <ns3/spectrum-value.h>
+#include <ns3/persistent-spectrum-signal.h>
 
 #include <list>
 
@@ -35,6 +36,7 @@ namespace ns3 {
 
 
 class LteChunkProcessor;
+class LteTtiClock;
 
 
 
@@ -109,6 +111,16 @@ public:
    */
   void AddSignal (Ptr<const SpectrumValue> spd, const Time duration);
 
+  /**
+   * notify that a persistent signal is being perceived in the
+   * medium. The average power of the signal over each chunk is added
+   * to the interference, until the signal is stopped.
+   *
+   * @param signal the persistent signal
+   * @param spd the power spectral density of the signal when on
+   */
+  void AddPersistentSignal (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> spd);
+
 
   /**
    *
@@ -117,6 +129,14 @@ public:
    */
   void SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd);
 
+  /**
+   * Set the clock batching the ends of the signals in the
+   * TTI-synchronous PHY mode
+   *
+   * @param clock the clock, or 0 to schedule an event per signal
+   */
+  void SetTtiClock (Ptr<LteTtiClock> clock);
+
 private:
   /**
    * Considitionally evaluate chunk
@@ -152,12 +172,16 @@ private:
 
   Ptr<const SpectrumValue> m_noise; ///< the noise value
 
+  PersistentSpectrumSignalList m_persistentSignals; ///< the persistent signals perceived in the medium
+
   Time m_lastChangeTime;     /**< the time of the last change in
                                 m_TotalPower */
 
   uint32_t m_lastSignalId; ///< the last signal ID
   uint32_t m_lastSignalIdBeforeReset; ///< the last signal ID before reset
 
+  Ptr<LteTtiClock> m_ttiClock; ///< the clock batching the ends of the signals, if any
+
   /** all the processor instances that need to be notified whenever
   a new interference chunk is calculated */
   std::list<Ptr<LteChunkProcessor> > m_rsPowerChunkProcessorList;
@@ -35,6 +35,7 @@
 #include <ns3/pointer.h>
 #include <stdint.h>
 #include <cmath>
+#include <algorithm>
 #include "stdlib.h"
 #include <ns3/lte-mi-error-model.h>
 
@@ -124,6 +125,11 @@ NS_LOG_COMPONENT_DEFINE ("LteMiErrorModel");
 /// MI size table  
 static const uint16_t cbMiSizeTable [9] = {40, 104, 160, 256, 512, 1024, 2560, 4032, 6144};
 
+/// number of CB sizes with BLER curves
+static const uint8_t MI_CB_SIZE_CURVES = 9;
+/// largest CB size with BLER curves
+static const uint16_t MI_MAX_CB_SIZE = 6144;
+
 
 /// MI map QPSK
 static const double MI_map_qpsk[MI_MAP_QPSK_SIZE] = {
@@ -331,83 +337,142 @@ static const double cEcrTable [9][38] = {
 };
 
 
-double 
-LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+/// The MI curve of a modulation, sampled over a uniformly spaced SINR axis
+struct MiCurve
 {
-  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
-  
-  double MI;
-  double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  
-  for (uint32_t i = 0; i < map.size (); i++)
+  const double* mi;     ///< the MI values
+  const double* axis;   ///< the linear SINRs of the MI values
+  uint16_t size;        ///< the number of samples
+  double scalingCoeff;  ///< inverse of the spacing of the SINR axis
+
+  /**
+   * \param sinrLin a linear SINR
+   * \return the MI of the SINR
+   */
+  double GetMi (double sinrLin) const
+  {
+    if (sinrLin > axis[size - 1])
+      {
+        return 1;
+      }
+    // since the values of the axis are uniformly spaced, we have
+    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+    double sinrIndexDouble = (sinrLin - axis[0]) * scalingCoeff + 1;
+    uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
+    NS_ASSERT_MSG (sinrIndex < size, "MI map out of data");
+    return mi[sinrIndex];
+  }
+};
+
+/**
+ * The lookup tables derived from the curves above, which are built once,
+ * on first use, and shared by all the users of the error model: the MI
+ * curve of each modulation, the ID of the CB size curve of each CB size,
+ * and the b and c parameters of the BLER curve of each (CB size, ECR)
+ * pair, with the missing parameters of the small CB sizes already
+ * replaced by those of the next larger CB size.
+ */
+struct MiErrorModelTables
+{
+  MiErrorModelTables ();
+
+  MiCurve miCurve[3];                          ///< MI curves of QPSK, 16QAM and 64QAM
+  uint8_t cbIndex[MI_MAX_CB_SIZE + 1];         ///< CB size curve ID of each CB size
+  double b[MI_CB_SIZE_CURVES][MI_64QAM_BLER_MAX_ID + 1]; ///< b parameter of each BLER curve
+  double c[MI_CB_SIZE_CURVES][MI_64QAM_BLER_MAX_ID + 1]; ///< c parameter of each BLER curve
+};
+
+MiErrorModelTables::MiErrorModelTables ()
+{
+  const double* mi[3] = {MI_map_qpsk, MI_map_16qam, MI_map_64qam};
+  const double* axis[3] = {MI_map_qpsk_axis, MI_map_16qam_axis, MI_map_64qam_axis};
+  const uint16_t size[3] = {MI_MAP_QPSK_SIZE, MI_MAP_16QAM_SIZE, MI_MAP_64QAM_SIZE};
+  for (uint8_t m = 0; m < 3; ++m)
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MI_QPSK_MAX_ID) // QPSK
-        {
+      miCurve[m].mi = mi[m];
+      miCurve[m].axis = axis[m];
+      miCurve[m].size = size[m];
+      miCurve[m].scalingCoeff = (size[m] - 1) / (axis[m][size[m] - 1] - axis[m][0]);
+    }
 
-          if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-            {
-              MI = 1;
-            }
-          else 
-            { 
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk = 
-                (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
-            }
+  // the largest CB size curve not larger than the CB size
+  uint8_t i = 0;
+  for (uint16_t cbSize = 0; cbSize <= MI_MAX_CB_SIZE; ++cbSize)
+    {
+      while ((i + 1 < MI_CB_SIZE_CURVES) && (cbMiSizeTable[i + 1] <= cbSize))
+        {
+          i++;
         }
-      else
+      cbIndex[cbSize] = i;
+    }
+
+  for (uint8_t cb = 0; cb < MI_CB_SIZE_CURVES; ++cb)
+    {
+      for (uint8_t ecrId = 0; ecrId <= MI_64QAM_BLER_MAX_ID; ++ecrId)
         {
-          if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
+          //take the lowest CB size including this CB for removing CB size
+          //quatization errors
+          int j = cb;
+          double bCurve = bEcrTable[j][ecrId];
+          while ((j < MI_CB_SIZE_CURVES) && (bCurve < 0))
             {
-              if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else 
-                {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam = 
-                    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
-                }
+              bCurve = bEcrTable[j++][ecrId];
             }
-          else // 64-QAM
+          b[cb][ecrId] = bCurve;
+          j = cb;
+          double cCurve = cEcrTable[j][ecrId];
+          while ((j < MI_CB_SIZE_CURVES) && (cCurve < 0))
             {
-              if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam = 
-                    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
-                }
+              cCurve = cEcrTable[j++][ecrId];
             }
+          c[cb][ecrId] = cCurve;
         }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
+    }
+}
+
+/**
+ * \return the lookup tables of the error model
+ */
+static const MiErrorModelTables&
+GetMiErrorModelTables (void)
+{
+  static const MiErrorModelTables tables;
+  return tables;
+}
+
+/**
+ * \param mcs an MCS
+ * \return the MI curve of the modulation of the MCS
+ */
+static const MiCurve&
+GetMiCurve (uint8_t mcs)
+{
+  const MiErrorModelTables& tables = GetMiErrorModelTables ();
+  if (mcs <= MI_QPSK_MAX_ID)
+    {
+      return tables.miCurve[0];
+    }
+  else if (mcs <= MI_16QAM_MAX_ID)
+    {
+      return tables.miCurve[1];
+    }
+  return tables.miCurve[2];
+}
+
+
+double 
+LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+{
+  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
+  
+  const MiCurve& curve = GetMiCurve (mcs);
+  double MI;
+  double MIsum = 0.0;
+  for (std::vector<int>::const_iterator it = map.begin (); it != map.end (); ++it)
+    {
+      double sinrLin = sinr[*it];
+      MI = curve.GetMi (sinrLin);
+      NS_LOG_LOGIC (" RB " << *it << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
       MIsum += MI;
     }
   MI = MIsum / map.size ();
@@ -420,40 +485,14 @@ double
 LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
 {
   NS_LOG_FUNCTION (mib << (uint32_t) ecrId << (uint32_t) cbSize);
-  double b = 0;
-  double c = 0;
 
   NS_ASSERT_MSG (ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
-  int cbIndex = 1;
-  while ((cbIndex < 9)&&(cbMiSizeTable[cbIndex]<= cbSize))
-    {
-      cbIndex++;
-    }
-  cbIndex--;
+  const MiErrorModelTables& tables = GetMiErrorModelTables ();
+  int cbIndex = tables.cbIndex[std::min (cbSize, MI_MAX_CB_SIZE)];
   NS_LOG_LOGIC (" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size " << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
 
-  b = bEcrTable[cbIndex][ecrId];
-  if (b<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(b<0))
-        {
-          b = bEcrTable[i++][ecrId];
-        }
-    }
-  c = cEcrTable[cbIndex][ecrId];
-  if (c<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(c<0))
-        {
-          c = cEcrTable[i++][ecrId];
-        }
-    }
+  double b = tables.b[cbIndex][ecrId];
+  double c = tables.c[cbIndex][ecrId];
   // see IEEE802.16m EMD formula 55 of section 4.3.2.1
   double bler = 0.5*( 1 - erf((mib-b)/(sqrt(2)*c)) );
   NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
@@ -466,44 +505,22 @@ double
 LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 {
   NS_LOG_FUNCTION (sinr);
+  const MiCurve& curve = GetMiErrorModelTables ().miCurve[0];
   double MI;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  Values::iterator sinrIt = sinrCopy.ValuesBegin ();
+  Values::const_iterator sinrIt = sinr.ConstValuesBegin ();
   uint16_t rb = 0;
-  NS_ASSERT (sinrIt!=sinrCopy.ValuesEnd ());
-  while (sinrIt!=sinrCopy.ValuesEnd ())
+  NS_ASSERT (sinrIt!=sinr.ConstValuesEnd ());
+  while (sinrIt!=sinr.ConstValuesEnd ())
     {
-      double sinrLin = *sinrIt;
-      if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-        {
-          MI = 1;
-        }
-      else 
-        { 
-          // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-          // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-          static const double scalingCoeffQpsk = 
-            (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-          double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-          uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-          NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-          MI = MI_map_qpsk[sinrIndex];
-        }
-      MIsum += MI;
+      MIsum += curve.GetMi (*sinrIt);
       sinrIt++;
       rb++;
     }
   MI = MIsum / rb;
-  // return to the effective SINR value
-  int j = 0;
+  // return to the effective SINR value (the MI map is sorted)
+  int j = std::lower_bound (MI_map_qpsk, MI_map_qpsk + MI_MAP_QPSK_SIZE, MI) - MI_map_qpsk;
   double esinr = 0.0;
-  while ((j<MI_MAP_QPSK_SIZE)&&(MI_map_qpsk[j] < MI))
-    {
-      j++;
-    }
   if (MI > MI_map_qpsk[MI_MAP_QPSK_SIZE-1])
     {
       esinr = MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1];
@@ -531,12 +548,8 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
   double esirnDb = 10*log10 (esinr); 
 //   NS_LOG_DEBUG ("Effective SINR " << esirnDb << " max " << 10*log10 (MI_map_qpsk [MI_MAP_QPSK_SIZE-1]));
-  uint16_t i = 0;
+  uint16_t i = std::lower_bound (PdcchPcfichBlerCurveXaxis, PdcchPcfichBlerCurveXaxis + PDCCH_PCFICH_CURVE_SIZE, esirnDb) - PdcchPcfichBlerCurveXaxis;
   double errorRate = 0.0;
-  while ((i<PDCCH_PCFICH_CURVE_SIZE)&&(PdcchPcfichBlerCurveXaxis[i] < esirnDb))
-    {
-      i++;
-    }
   if (esirnDb > PdcchPcfichBlerCurveXaxis[PDCCH_PCFICH_CURVE_SIZE-1])
     {
       errorRate = 0.0;
@@ -554,11 +567,18 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
 
 TbStats_t
-LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory)
+LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
+  return GetTbDecodificationStats (Mib (sinr, map, mcs), size, mcs, miHistory);
+}
+
+
+TbStats_t
+LteMiErrorModel::GetTbDecodificationStats (double tbMi, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
+{
+  NS_LOG_FUNCTION (tbMi << (uint32_t) size << (uint32_t) mcs);
 
-  double tbMi = Mib(sinr, map, mcs);
   double MI = 0.0;
   double Reff = 0.0;
   NS_ASSERT (mcs < 29);
@@ -567,15 +587,16 @@ LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std:
       // evaluate R_eff and MI_eff
       uint16_t codeBitsSum = 0;
       double miSum = 0.0;
-      for (uint16_t i = 0; i < miHistory.size (); i++)
+      for (HarqProcessInfoList_t::const_iterator it = miHistory.begin (); it != miHistory.end (); ++it)
         {
-          NS_LOG_DEBUG (" Sum MI " << miHistory.at (i).m_mi << " Ci " << miHistory.at (i).m_codeBits);
-          codeBitsSum += miHistory.at (i).m_codeBits;
-          miSum += (miHistory.at (i).m_mi*miHistory.at (i).m_codeBits);
+          NS_LOG_DEBUG (" Sum MI " << it->m_mi << " Ci " << it->m_codeBits);
+          codeBitsSum += it->m_codeBits;
+          miSum += (it->m_mi*it->m_codeBits);
         }
-      codeBitsSum += (((double)size*8.0) / McsEcrTable [mcs]);
-      miSum += (tbMi*(((double)size*8.0) / McsEcrTable [mcs]));
-      Reff = miHistory.at (0).m_infoBits / (double)codeBitsSum; // information bits are the size of the first TB
+      double codeBits = ((double)size*8.0) / McsEcrTable [mcs];
+      codeBitsSum += codeBits;
+      miSum += (tbMi*codeBits);
+      Reff = miHistory.front ().m_infoBits / (double)codeBitsSum; // information bits are the size of the first TB
       MI = miSum / (double)codeBitsSum;      
     }
   else
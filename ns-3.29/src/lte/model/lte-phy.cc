@@ -27,6 +27,7 @@
 #include "ns3/spectrum-error-model.h"
 #include "lte-phy.h"
 #include "lte-net-device.h"
+#include "lte-tti-clock.h"
 
 namespace ns3 {
 
@@ -83,6 +84,11 @@ LtePhy::DoDispose ()
   m_uplinkSpectrumPhy->Dispose ();
   m_uplinkSpectrumPhy = 0;
   m_netDevice = 0;
+  if (m_ttiClock != 0)
+    {
+      m_ttiClock->RemovePhy (this);
+      m_ttiClock = 0;
+    }
   Object::DoDispose ();
 }
 
@@ -94,6 +100,13 @@ LtePhy::SetDevice (Ptr<LteNetDevice> d)
 }
 
 
+void
+LtePhy::SetTtiClock (Ptr<LteTtiClock> clock)
+{
+  NS_LOG_FUNCTION (this << clock);
+  m_ttiClock = clock;
+}
+
 Ptr<LteNetDevice>
 LtePhy::GetDevice () const
 {
@@ -40,6 +40,7 @@ namespace ns3 {
 class PacketBurst;
 class LteNetDevice;
 class LteControlMessage;
+class LteTtiClock;
 
 
 
@@ -84,6 +85,18 @@ public:
    */
   Ptr<LteNetDevice> GetDevice () const;
 
+  /**
+   * \brief Set the clock starting the subframes of the PHY in the
+   * TTI-synchronous PHY mode
+   *
+   * This must be called before the PHY is initialized. If the clock
+   * rejects the PHY, the PHY schedules its own subframe events, as in
+   * the default mode.
+   *
+   * \param clock the clock, or 0 for the default mode
+   */
+  void SetTtiClock (Ptr<LteTtiClock> clock);
+
   /** 
    * 
    * \return a pointer to the LteSpectrumPhy instance that manages the downlink
@@ -231,6 +244,12 @@ protected:
   /// Pointer to the NetDevice where this PHY layer is attached.
   Ptr<LteNetDevice> m_netDevice;
 
+  /**
+   * The clock starting the subframes of the PHY in the TTI-synchronous
+   * PHY mode, or 0 if the PHY schedules its own subframe events.
+   */
+  Ptr<LteTtiClock> m_ttiClock;
+
   /**
    * The downlink LteSpectrumPhy associated to this LtePhy. Also available as
    * attribute `DlSpectrumPhy` in the child classes LteEnbPhy and LteUePhy.
@@ -45,6 +45,7 @@ LteRlcAm::LteRlcAm ()
   m_retxBufferSize = 0;
   m_txedBuffer.resize (1024);
   m_txedBufferSize = 0;
+  m_rxonBuffer.resize (1024);
 
   m_statusPduRequested = false;
   m_statusPduBufferSize = 0;
@@ -220,7 +221,6 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
       NS_LOG_LOGIC ("Check for SNs to NACK from " << m_vrR.GetValue() << " to " << m_vrMs.GetValue());
       SequenceNumber10 sn;
       sn.SetModulusBase (m_vrR);
-      std::map<uint16_t, PduBuffer>::iterator pduIt;
       for (sn = m_vrR; sn < m_vrMs; sn++) 
         {
           NS_LOG_LOGIC ("SN = " << sn);          
@@ -229,8 +229,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
               NS_LOG_LOGIC ("Can't fit more NACKs in STATUS PDU");
               break;
             }          
-          pduIt = m_rxonBuffer.find (sn.GetValue ());
-          if (pduIt == m_rxonBuffer.end () || (!(pduIt->second.m_pduComplete)))
+          if (!m_rxonBuffer.at (sn.GetValue ()).m_pduComplete)
             {
               NS_LOG_LOGIC ("adding NACK_SN " << sn.GetValue ());
               rlcAmHeader.PushNack (sn.GetValue ());              
@@ -240,13 +239,11 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
       // 3GPP TS 36.322 section 6.2.2.1.4 ACK SN
       // find the  SN of the next not received RLC Data PDU 
       // which is not reported as missing in the STATUS PDU. 
-      pduIt = m_rxonBuffer.find (sn.GetValue ());
-      while ((sn < m_vrMs) && (pduIt != m_rxonBuffer.end ()) && (pduIt->second.m_pduComplete))            
+      while ((sn < m_vrMs) && (m_rxonBuffer.at (sn.GetValue ()).m_pduComplete))
         {
           NS_LOG_LOGIC ("SN = " << sn << " < " << m_vrMs << " = " << (sn < m_vrMs));
           sn++;
           NS_LOG_LOGIC ("SN = " << sn);
-          pduIt = m_rxonBuffer.find (sn.GetValue ());
         }
       
       NS_ASSERT_MSG (sn <= m_vrMs, "first SN not reported as missing = " << sn << ", VR(MS) = " << m_vrMs);      
@@ -367,7 +364,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
                     }
 
                   NS_LOG_INFO ("Move SN = " << seqNumberValue << " back to txedBuffer");
-                  m_txedBuffer.at (seqNumberValue).m_pdu = m_retxBuffer.at (seqNumberValue).m_pdu->Copy ();
+                  m_txedBuffer.at (seqNumberValue).m_pdu = m_retxBuffer.at (seqNumberValue).m_pdu;
                   m_txedBuffer.at (seqNumberValue).m_retxCount = m_retxBuffer.at (seqNumberValue).m_retxCount;
                   m_txedBufferSize += m_txedBuffer.at (seqNumberValue).m_pdu->GetSize ();
 
@@ -445,10 +442,10 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   NS_LOG_LOGIC ("First SDU size    = " << (*(m_txonBuffer.begin()))->GetSize ());
   NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
   NS_LOG_LOGIC ("Remove SDU from TxBuffer");
-  Ptr<Packet> firstSegment = (*(m_txonBuffer.begin ()))->Copy ();
-  m_txonBufferSize -= (*(m_txonBuffer.begin()))->GetSize ();
+  Ptr<Packet> firstSegment = m_txonBuffer.front ();
+  m_txonBufferSize -= firstSegment->GetSize ();
   NS_LOG_LOGIC ("txBufferSize      = " << m_txonBufferSize );
-  m_txonBuffer.erase (m_txonBuffer.begin ());
+  m_txonBuffer.pop_front ();
 
   while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
     {
@@ -467,17 +464,12 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           NS_LOG_LOGIC ("    IF ( firstSegment > nextSegmentSize ||");
           NS_LOG_LOGIC ("         firstSegment > 2047 )");
 
-          // Segment txBuffer.FirstBuffer and
-          // Give back the remaining segment to the transmission buffer
-          Ptr<Packet> newSegment = firstSegment->CreateFragment (0, currSegmentSize);
-          NS_LOG_LOGIC ("    newSegment size   = " << newSegment->GetSize ());
-
           // Status tag of the new and remaining segments
           // Note: This is the only place where a PDU is segmented and
           // therefore its status can change
-          LteRlcSduStatusTag oldTag, newTag;
+          LteRlcSduStatusTag oldTag;
           firstSegment->RemovePacketTag (oldTag);
-          newSegment->RemovePacketTag (newTag);
+          LteRlcSduStatusTag newTag = oldTag;
           if (oldTag.GetStatus () == LteRlcSduStatusTag::FULL_SDU)
             {
               newTag.SetStatus (LteRlcSduStatusTag::FIRST_SEGMENT);
@@ -489,23 +481,31 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
               //oldTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
             }
 
-          // Give back the remaining segment to the transmission buffer
-          firstSegment->RemoveAtStart (currSegmentSize);
-          NS_LOG_LOGIC ("    firstSegment size (after RemoveAtStart) = " << firstSegment->GetSize ());
-          if (firstSegment->GetSize () > 0)
+          // Segment txBuffer.FirstBuffer and give back the remaining
+          // segment to the transmission buffer, unless it is taken as a
+          // whole (which happens to segments larger than 2047 octets)
+          Ptr<Packet> newSegment;
+          if (currSegmentSize < firstSegment->GetSize ())
             {
+              newSegment = firstSegment->CreateFragment (0, currSegmentSize);
+              firstSegment->RemoveAtStart (currSegmentSize);
+              NS_LOG_LOGIC ("    newSegment size   = " << newSegment->GetSize ());
+              NS_LOG_LOGIC ("    firstSegment size (after RemoveAtStart) = " << firstSegment->GetSize ());
               firstSegment->AddPacketTag (oldTag);
 
-              m_txonBuffer.insert (m_txonBuffer.begin (), firstSegment);
-              m_txonBufferSize += (*(m_txonBuffer.begin()))->GetSize ();
+              m_txonBuffer.push_front (firstSegment);
+              m_txonBufferSize += firstSegment->GetSize ();
 
               NS_LOG_LOGIC ("    Txon buffer: Give back the remaining segment");
               NS_LOG_LOGIC ("    Txon buffers = " << m_txonBuffer.size ());
-              NS_LOG_LOGIC ("    Front buffer size = " << (*(m_txonBuffer.begin()))->GetSize ());
+              NS_LOG_LOGIC ("    Front buffer size = " << m_txonBuffer.front ()->GetSize ());
               NS_LOG_LOGIC ("    txonBufferSize = " << m_txonBufferSize );
             }
           else
             {
+              newSegment = firstSegment;
+              NS_LOG_LOGIC ("    newSegment size   = " << newSegment->GetSize ());
+
               // Whole segment was taken, so adjust tag
               if (newTag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT)
                 {
@@ -600,9 +600,9 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
 
           // (more segments)
-          firstSegment = (*(m_txonBuffer.begin ()))->Copy ();
-          m_txonBufferSize -= (*(m_txonBuffer.begin()))->GetSize ();
-          m_txonBuffer.erase (m_txonBuffer.begin ());
+          firstSegment = m_txonBuffer.front ();
+          m_txonBufferSize -= firstSegment->GetSize ();
+          m_txonBuffer.pop_front ();
           NS_LOG_LOGIC ("        txBufferSize = " << m_txonBufferSize );
         }
 
@@ -879,18 +879,18 @@ LteRlcAm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
           //         - discard the duplicate byte segments.
           // note: re-segmentation of AMD PDU is currently not supported, 
           // so we just check that the segment was not received before
-          std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (seqNumber.GetValue ());
-          if (it != m_rxonBuffer.end () )
+          PduBuffer &pduBuffer = m_rxonBuffer.at (seqNumber.GetValue ());
+          if (!pduBuffer.m_byteSegments.empty ())
             {
-              NS_ASSERT (it->second.m_byteSegments.size () > 0);
-              NS_ASSERT_MSG (it->second.m_byteSegments.size () == 1, "re-segmentation not supported");
+              NS_ASSERT_MSG (pduBuffer.m_byteSegments.size () == 1, "re-segmentation not supported");
               NS_LOG_LOGIC ("PDU segment already received, discarded");
             }
           else
             {
               NS_LOG_LOGIC ("Place PDU in the reception buffer ( SN = " << seqNumber << " )");
-              m_rxonBuffer[ seqNumber.GetValue () ].m_byteSegments.push_back (rxPduParams.p);
-              m_rxonBuffer[ seqNumber.GetValue () ].m_pduComplete = true;
+              pduBuffer.m_seqNumber = seqNumber;
+              pduBuffer.m_byteSegments.push_back (rxPduParams.p);
+              pduBuffer.m_pduComplete = true;
             }
 
 
@@ -913,16 +913,12 @@ LteRlcAm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
       //     - update VR(MS) to the SN of the first AMD PDU with SN > current VR(MS) for
       //       which not all byte segments have been received;
 
-      std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (m_vrMs.GetValue ());
-      if ( it != m_rxonBuffer.end () &&
-           it->second.m_pduComplete )
+      if ( m_rxonBuffer.at (m_vrMs.GetValue ()).m_pduComplete )
         {
           int firstVrMs = m_vrMs.GetValue ();
-          while ( it != m_rxonBuffer.end () &&
-                  it->second.m_pduComplete )
+          while ( m_rxonBuffer.at (m_vrMs.GetValue ()).m_pduComplete )
             {
               m_vrMs++;
-              it = m_rxonBuffer.find (m_vrMs.GetValue ());
               NS_LOG_LOGIC ("Incr VR(MS) = " << m_vrMs);
 
               NS_ASSERT_MSG (firstVrMs != m_vrMs.GetValue (), "Infinite loop in RxonBuffer");
@@ -938,27 +934,25 @@ LteRlcAm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
 
       if ( seqNumber == m_vrR )
         {
-          std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (seqNumber.GetValue ());
-          if ( it != m_rxonBuffer.end () &&
-               it->second.m_pduComplete )
+          if ( m_rxonBuffer.at (seqNumber.GetValue ()).m_pduComplete )
             {
-              it = m_rxonBuffer.find (m_vrR.GetValue ());
               int firstVrR = m_vrR.GetValue ();
-              while ( it != m_rxonBuffer.end () &&
-                      it->second.m_pduComplete )
+              while ( m_rxonBuffer.at (m_vrR.GetValue ()).m_pduComplete )
                 {
+                  PduBuffer &pduBuffer = m_rxonBuffer.at (m_vrR.GetValue ());
                   NS_LOG_LOGIC ("Reassemble and Deliver ( SN = " << m_vrR << " )");
-                  NS_ASSERT_MSG (it->second.m_byteSegments.size () == 1,
+                  NS_ASSERT_MSG (pduBuffer.m_byteSegments.size () == 1,
                                 "Too many segments. PDU Reassembly process didn't work");
-                  ReassembleAndDeliver (it->second.m_byteSegments.front ());
-                  m_rxonBuffer.erase (m_vrR.GetValue ());
+                  Ptr<Packet> pdu = pduBuffer.m_byteSegments.front ();
+                  pduBuffer.m_byteSegments.clear ();
+                  pduBuffer.m_pduComplete = false;
+                  ReassembleAndDeliver (pdu);
 
                   m_vrR++;
                   m_vrR.SetModulusBase (m_vrR);
                   m_vrX.SetModulusBase (m_vrR);
                   m_vrMs.SetModulusBase (m_vrR);
                   m_vrH.SetModulusBase (m_vrR);
-                  it = m_rxonBuffer.find (m_vrR.GetValue ());
 
                   NS_ASSERT_MSG (firstVrR != m_vrR.GetValue (), "Infinite loop in RxonBuffer");
                 }
@@ -1048,7 +1042,7 @@ LteRlcAm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
               if (m_txedBuffer.at (seqNumberValue).m_pdu != 0)
                 {
                   NS_LOG_INFO ("Move SN = " << seqNumberValue << " to retxBuffer");
-                  m_retxBuffer.at (seqNumberValue).m_pdu = m_txedBuffer.at (seqNumberValue).m_pdu->Copy ();
+                  m_retxBuffer.at (seqNumberValue).m_pdu = m_txedBuffer.at (seqNumberValue).m_pdu;
                   m_retxBuffer.at (seqNumberValue).m_retxCount = m_txedBuffer.at (seqNumberValue).m_retxCount;
                   m_retxBufferSize += m_retxBuffer.at (seqNumberValue).m_pdu->GetSize ();
 
@@ -1644,12 +1638,9 @@ LteRlcAm::ExpireReorderingTimer (void)
 
   m_vrMs = m_vrX;
   int firstVrMs = m_vrMs.GetValue ();
-  std::map <uint16_t, PduBuffer>::iterator it = m_rxonBuffer.find (m_vrMs.GetValue ());
-  while ( it != m_rxonBuffer.end () &&
-          it->second.m_pduComplete )
+  while ( m_rxonBuffer.at (m_vrMs.GetValue ()).m_pduComplete )
     {
       m_vrMs++;
-      it = m_rxonBuffer.find (m_vrMs.GetValue ());
 
       NS_ASSERT_MSG (firstVrMs != m_vrMs.GetValue (), "Infinite loop in ExpireReorderingTimer");
     }
@@ -1698,7 +1689,7 @@ LteRlcAm::ExpirePollRetransmitTimer (void)
              {
                uint16_t snValue = sn.GetValue ();
                NS_LOG_INFO ("Move PDU " << sn << " from txedBuffer to retxBuffer");
-               m_retxBuffer.at (snValue).m_pdu = m_txedBuffer.at (snValue).m_pdu->Copy ();
+               m_retxBuffer.at (snValue).m_pdu = m_txedBuffer.at (snValue).m_pdu;
                m_retxBuffer.at (snValue).m_retxCount = m_txedBuffer.at (snValue).m_retxCount;
                m_retxBufferSize += m_retxBuffer.at (snValue).m_pdu->GetSize ();
 
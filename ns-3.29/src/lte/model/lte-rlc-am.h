@@ -25,8 +25,9 @@
 #include <ns3/lte-rlc-sequence-number.h>
 #include <ns3/lte-rlc.h>
 
+#include <deque>
+#include <list>
 #include <vector>
-#include <map>
 
 namespace ns3 {
 
@@ -112,7 +113,7 @@ private:
   void DoReportBufferStatus ();
 
 private:
-    std::vector < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer
+    std::deque < Ptr<Packet> > m_txonBuffer; ///< Transmission buffer
 
     /// RetxPdu structure
     struct RetxPdu
@@ -123,8 +124,8 @@ private:
 
   std::vector <RetxPdu> m_txedBuffer;  ///< Buffer for transmitted and retransmitted PDUs 
                                        ///< that have not been acked but are not considered 
-                                       ///< for retransmission 
-  std::vector <RetxPdu> m_retxBuffer;  ///< Buffer for PDUs considered for retransmission
+                                       ///< for retransmission, indexed by SN
+  std::vector <RetxPdu> m_retxBuffer;  ///< Buffer for PDUs considered for retransmission, indexed by SN
 
     uint32_t m_txonBufferSize; ///< transmit on buffer size
     uint32_t m_retxBufferSize; ///< retransmit buffer size
@@ -142,7 +143,11 @@ private:
       bool      m_pduComplete; ///< PDU complete?
     };
 
-    std::map <uint16_t, PduBuffer > m_rxonBuffer; ///< Reception buffer
+    /**
+     * Reception buffer, indexed by SN. An entry holds a PDU of the
+     * receiving window when it has byte segments.
+     */
+    std::vector <PduBuffer> m_rxonBuffer;
 
     Ptr<Packet> m_controlPduBuffer;               ///< Control PDU buffer (just one PDU)
 
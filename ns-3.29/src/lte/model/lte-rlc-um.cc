@@ -35,6 +35,7 @@ NS_OBJECT_ENSURE_REGISTERED (LteRlcUm);
 LteRlcUm::LteRlcUm ()
   : m_maxTxBufferSize (10 * 1024),
     m_txBufferSize (0),
+    m_rxBufferPdus (0),
     m_sequenceNumber (0),
     m_vrUr (0),
     m_vrUx (0),
@@ -44,6 +45,7 @@ LteRlcUm::LteRlcUm ()
 {
   NS_LOG_FUNCTION (this);
   m_reassemblingState = WAITING_S0_FULL;
+  m_rxBuffer.resize (1024);
 }
 
 LteRlcUm::~LteRlcUm ()
@@ -159,10 +161,10 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   NS_LOG_LOGIC ("First SDU size    = " << (*(m_txBuffer.begin()))->GetSize ());
   NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
   NS_LOG_LOGIC ("Remove SDU from TxBuffer");
-  Ptr<Packet> firstSegment = (*(m_txBuffer.begin ()))->Copy ();
-  m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
+  Ptr<Packet> firstSegment = m_txBuffer.front ();
+  m_txBufferSize -= firstSegment->GetSize ();
   NS_LOG_LOGIC ("txBufferSize      = " << m_txBufferSize );
-  m_txBuffer.erase (m_txBuffer.begin ());
+  m_txBuffer.pop_front ();
 
   while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
     {
@@ -181,17 +183,12 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           NS_LOG_LOGIC ("    IF ( firstSegment > nextSegmentSize ||");
           NS_LOG_LOGIC ("         firstSegment > 2047 )");
 
-          // Segment txBuffer.FirstBuffer and
-          // Give back the remaining segment to the transmission buffer
-          Ptr<Packet> newSegment = firstSegment->CreateFragment (0, currSegmentSize);
-          NS_LOG_LOGIC ("    newSegment size   = " << newSegment->GetSize ());
-
           // Status tag of the new and remaining segments
           // Note: This is the only place where a PDU is segmented and
           // therefore its status can change
-          LteRlcSduStatusTag oldTag, newTag;
+          LteRlcSduStatusTag oldTag;
           firstSegment->RemovePacketTag (oldTag);
-          newSegment->RemovePacketTag (newTag);
+          LteRlcSduStatusTag newTag = oldTag;
           if (oldTag.GetStatus () == LteRlcSduStatusTag::FULL_SDU)
             {
               newTag.SetStatus (LteRlcSduStatusTag::FIRST_SEGMENT);
@@ -203,23 +200,31 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
               //oldTag.SetStatus (LteRlcSduStatusTag::LAST_SEGMENT);
             }
 
-          // Give back the remaining segment to the transmission buffer
-          firstSegment->RemoveAtStart (currSegmentSize);
-          NS_LOG_LOGIC ("    firstSegment size (after RemoveAtStart) = " << firstSegment->GetSize ());
-          if (firstSegment->GetSize () > 0)
+          // Segment txBuffer.FirstBuffer and give back the remaining
+          // segment to the transmission buffer, unless it is taken as a
+          // whole (which happens to segments larger than 2047 octets)
+          Ptr<Packet> newSegment;
+          if (currSegmentSize < firstSegment->GetSize ())
             {
+              newSegment = firstSegment->CreateFragment (0, currSegmentSize);
+              firstSegment->RemoveAtStart (currSegmentSize);
+              NS_LOG_LOGIC ("    newSegment size   = " << newSegment->GetSize ());
+              NS_LOG_LOGIC ("    firstSegment size (after RemoveAtStart) = " << firstSegment->GetSize ());
               firstSegment->AddPacketTag (oldTag);
 
-              m_txBuffer.insert (m_txBuffer.begin (), firstSegment);
-              m_txBufferSize += (*(m_txBuffer.begin()))->GetSize ();
+              m_txBuffer.push_front (firstSegment);
+              m_txBufferSize += firstSegment->GetSize ();
 
               NS_LOG_LOGIC ("    TX buffer: Give back the remaining segment");
               NS_LOG_LOGIC ("    TX buffers = " << m_txBuffer.size ());
-              NS_LOG_LOGIC ("    Front buffer size = " << (*(m_txBuffer.begin()))->GetSize ());
+              NS_LOG_LOGIC ("    Front buffer size = " << m_txBuffer.front ()->GetSize ());
               NS_LOG_LOGIC ("    txBufferSize = " << m_txBufferSize );
             }
           else
             {
+              newSegment = firstSegment;
+              NS_LOG_LOGIC ("    newSegment size   = " << newSegment->GetSize ());
+
               // Whole segment was taken, so adjust tag
               if (newTag.GetStatus () == LteRlcSduStatusTag::FIRST_SEGMENT)
                 {
@@ -313,9 +318,9 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
 
           // (more segments)
-          firstSegment = (*(m_txBuffer.begin ()))->Copy ();
-          m_txBufferSize -= (*(m_txBuffer.begin()))->GetSize ();
-          m_txBuffer.erase (m_txBuffer.begin ());
+          firstSegment = m_txBuffer.front ();
+          m_txBufferSize -= firstSegment->GetSize ();
+          m_txBuffer.pop_front ();
           NS_LOG_LOGIC ("        txBufferSize = " << m_txBufferSize );
         }
 
@@ -461,7 +466,7 @@ LteRlcUm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
   m_vrUh.SetModulusBase (m_vrUh - m_windowSize);
   seqNumber.SetModulusBase (m_vrUh - m_windowSize);
 
-  if ( ( (m_vrUr < seqNumber) && (seqNumber < m_vrUh) && (m_rxBuffer.count (seqNumber.GetValue ()) > 0) ) ||
+  if ( ( (m_vrUr < seqNumber) && (seqNumber < m_vrUh) && (m_rxBuffer.at (seqNumber.GetValue ()) != 0) ) ||
        ( ((m_vrUh - m_windowSize) <= seqNumber) && (seqNumber < m_vrUr) )
      )
     {
@@ -472,7 +477,11 @@ LteRlcUm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
   else
     {
       NS_LOG_LOGIC ("Place PDU in the reception buffer");
-      m_rxBuffer[seqNumber.GetValue ()] = rxPduParams.p;
+      if (m_rxBuffer.at (seqNumber.GetValue ()) == 0)
+        {
+          m_rxBufferPdus++;
+        }
+      m_rxBuffer.at (seqNumber.GetValue ()) = rxPduParams.p;
     }
 
 
@@ -510,17 +519,13 @@ LteRlcUm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
   //      so and deliver the reassembled RLC SDUs to upper layer in ascending order of the RLC SN if not delivered
   //      before;
 
-  if ( m_rxBuffer.count (m_vrUr.GetValue ()) > 0 )
+  if ( m_rxBuffer.at (m_vrUr.GetValue ()) != 0 )
     {
       NS_LOG_LOGIC ("Reception buffer contains SN = " << m_vrUr);
 
-      std::map <uint16_t, Ptr<Packet> >::iterator it;
-      uint16_t newVrUr;
       SequenceNumber10 oldVrUr = m_vrUr;
-
-      it = m_rxBuffer.find (m_vrUr.GetValue ());
-      newVrUr = (it->first) + 1;
-      while ( m_rxBuffer.count (newVrUr) > 0 )
+      SequenceNumber10 newVrUr = m_vrUr + 1;
+      while ( m_rxBuffer.at (newVrUr.GetValue ()) != 0 )
         {
           newVrUr++;
         }
@@ -1069,24 +1074,23 @@ LteRlcUm::ReassembleOutsideWindow (void)
 {
   NS_LOG_LOGIC ("Reassemble Outside Window");
 
-  std::map <uint16_t, Ptr<Packet> >::iterator it;
-  it = m_rxBuffer.begin ();
-
-  while ( (it != m_rxBuffer.end ()) && ! IsInsideReorderingWindow (SequenceNumber10 (it->first)) )
+  // The PDUs of the reception buffer are above VR(UR), so those falling
+  // outside of the reordering window are between VR(UR) and VR(UH) - UM_Window_Size
+  SequenceNumber10 sn = m_vrUr;
+  while ( (m_rxBufferPdus > 0) && ! IsInsideReorderingWindow (sn) )
     {
-      NS_LOG_LOGIC ("SN = " << it->first);
+      Ptr<Packet> pdu = m_rxBuffer.at (sn.GetValue ());
+      if (pdu != 0)
+        {
+          NS_LOG_LOGIC ("SN = " << sn);
 
-      // Reassemble RLC SDUs and deliver the PDCP PDU to upper layer
-      ReassembleAndDeliver (it->second);
+          m_rxBuffer.at (sn.GetValue ()) = 0;
+          m_rxBufferPdus--;
 
-      std::map <uint16_t, Ptr<Packet> >::iterator it_tmp = it;
-      ++it;
-      m_rxBuffer.erase (it_tmp);
-    }
-
-  if (it != m_rxBuffer.end ())
-    {
-      NS_LOG_LOGIC ("(SN = " << it->first << ") is inside the reordering window");
+          // Reassemble RLC SDUs and deliver the PDCP PDU to upper layer
+          ReassembleAndDeliver (pdu);
+        }
+      sn++;
     }
 }
 
@@ -1095,25 +1099,22 @@ LteRlcUm::ReassembleSnInterval (SequenceNumber10 lowSeqNumber, SequenceNumber10
 {
   NS_LOG_LOGIC ("Reassemble SN between " << lowSeqNumber << " and " << highSeqNumber);
 
-  std::map <uint16_t, Ptr<Packet> >::iterator it;
-
   SequenceNumber10 reassembleSn = lowSeqNumber;
   NS_LOG_LOGIC ("reassembleSN = " << reassembleSn);
   NS_LOG_LOGIC ("highSeqNumber = " << highSeqNumber);
   while (reassembleSn < highSeqNumber)
     {
       NS_LOG_LOGIC ("reassembleSn < highSeqNumber");
-      it = m_rxBuffer.find (reassembleSn.GetValue ());
-      NS_LOG_LOGIC ("it->first  = " << it->first);
-      NS_LOG_LOGIC ("it->second = " << it->second);
-      if (it != m_rxBuffer.end () )
+      Ptr<Packet> pdu = m_rxBuffer.at (reassembleSn.GetValue ());
+      if (pdu != 0)
         {
-          NS_LOG_LOGIC ("SN = " << it->first);
+          NS_LOG_LOGIC ("SN = " << reassembleSn);
 
-          // Reassemble RLC SDUs and deliver the PDCP PDU to upper layer
-          ReassembleAndDeliver (it->second);
+          m_rxBuffer.at (reassembleSn.GetValue ()) = 0;
+          m_rxBufferPdus--;
 
-          m_rxBuffer.erase (it);
+          // Reassemble RLC SDUs and deliver the PDCP PDU to upper layer
+          ReassembleAndDeliver (pdu);
         }
         
       reassembleSn++;
@@ -1167,10 +1168,9 @@ LteRlcUm::ExpireReorderingTimer (void)
   //    - start t-Reordering;
   //    - set VR(UX) to VR(UH).
 
-  std::map <uint16_t, Ptr<Packet> >::iterator it;
   SequenceNumber10 newVrUr = m_vrUx;
 
-  while ( (it = m_rxBuffer.find (newVrUr.GetValue ())) != m_rxBuffer.end () )
+  while ( m_rxBuffer.at (newVrUr.GetValue ()) != 0 )
     {
       newVrUr++;
     }
@@ -25,7 +25,9 @@
 #include "ns3/lte-rlc.h"
 
 #include <ns3/event-id.h>
-#include <map>
+#include <deque>
+#include <list>
+#include <vector>
 
 namespace ns3 {
 
@@ -102,8 +104,9 @@ private:
 private:
   uint32_t m_maxTxBufferSize; ///< maximum transmit buffer status
   uint32_t m_txBufferSize; ///< transmit buffer size
-  std::vector < Ptr<Packet> > m_txBuffer;       ///< Transmission buffer
-  std::map <uint16_t, Ptr<Packet> > m_rxBuffer; ///< Reception buffer
+  std::deque < Ptr<Packet> > m_txBuffer;        ///< Transmission buffer
+  std::vector < Ptr<Packet> > m_rxBuffer;       ///< Reception buffer, indexed by SN
+  uint32_t m_rxBufferPdus;                      ///< number of PDUs in the reception buffer
   std::vector < Ptr<Packet> > m_reasBuffer;     ///< Reassembling buffer
 
   std::list < Ptr<Packet> > m_sdusBuffer;       ///< List of SDUs in a packet
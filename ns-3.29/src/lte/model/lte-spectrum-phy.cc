@@ -33,6 +33,7 @@
 #include "lte-radio-bearer-tag.h"
 #include "lte-chunk-processor.h"
 #include "lte-phy-tag.h"
+#include "lte-tti-clock.h"
 #include <ns3/lte-mi-error-model.h>
 #include <ns3/lte-radio-bearer-tag.h>
 #include <ns3/boolean.h>
@@ -164,6 +165,7 @@ void LteSpectrumPhy::DoDispose ()
   m_interferenceData = 0;
   m_interferenceCtrl->Dispose ();
   m_interferenceCtrl = 0;
+  m_ttiClock = 0;
   m_ltePhyRxDataEndErrorCallback = MakeNullCallback< void > ();
   m_ltePhyRxDataEndOkCallback    = MakeNullCallback< void, Ptr<Packet> >  ();
   m_ltePhyRxCtrlEndOkCallback = MakeNullCallback< void, std::list<Ptr<LteControlMessage> > > ();
@@ -690,6 +692,15 @@ LteSpectrumPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
     }    
 }
 
+void
+LteSpectrumPhy::StartRxPersistent (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> rxPsd)
+{
+  NS_LOG_FUNCTION (this << signal << rxPsd);
+  // persistent signals are never LTE signals -> interference
+  m_interferenceData->AddPersistentSignal (signal, rxPsd);
+  m_interferenceCtrl->AddPersistentSignal (signal, rxPsd);
+}
+
 void
 LteSpectrumPhy::StartRxData (Ptr<LteSpectrumSignalParametersDataFrame> params)
 {
@@ -724,7 +735,14 @@ LteSpectrumPhy::StartRxData (Ptr<LteSpectrumSignalParametersDataFrame> params)
                   m_firstRxStart = Simulator::Now ();
                   m_firstRxDuration = params->duration;
                   NS_LOG_LOGIC (this << " scheduling EndRx with delay " << params->duration.GetSeconds () << "s");
-                  m_endRxDataEvent = Simulator::Schedule (params->duration, &LteSpectrumPhy::EndRxData, this);
+                  if (m_ttiClock != 0)
+                    {
+                      m_endRxDataEvent = m_ttiClock->ScheduleRx (params->duration, MakeEvent (&LteSpectrumPhy::EndRxData, this));
+                    }
+                  else
+                    {
+                      m_endRxDataEvent = Simulator::Schedule (params->duration, &LteSpectrumPhy::EndRxData, this);
+                    }
                 }
               else
                 {
@@ -824,7 +842,14 @@ LteSpectrumPhy::StartRxDlCtrl (Ptr<LteSpectrumSignalParametersDlCtrlFrame> lteDl
               
               // store the DCIs
               m_rxControlMessageList = lteDlCtrlRxParams->ctrlMsgList;
-              m_endRxDlCtrlEvent = Simulator::Schedule (lteDlCtrlRxParams->duration, &LteSpectrumPhy::EndRxDlCtrl, this);
+              if (m_ttiClock != 0)
+                {
+                  m_endRxDlCtrlEvent = m_ttiClock->ScheduleRx (lteDlCtrlRxParams->duration, MakeEvent (&LteSpectrumPhy::EndRxDlCtrl, this));
+                }
+              else
+                {
+                  m_endRxDlCtrlEvent = Simulator::Schedule (lteDlCtrlRxParams->duration, &LteSpectrumPhy::EndRxDlCtrl, this);
+                }
               ChangeState (RX_DL_CTRL);
               m_interferenceCtrl->StartRx (lteDlCtrlRxParams->psd);            
             }
@@ -892,7 +917,14 @@ LteSpectrumPhy::StartRxUlSrs (Ptr<LteSpectrumSignalParametersUlSrsFrame> lteUlSr
                 m_firstRxDuration = lteUlSrsRxParams->duration;
                 NS_LOG_LOGIC (this << " scheduling EndRx with delay " << lteUlSrsRxParams->duration);
 
-                m_endRxUlSrsEvent = Simulator::Schedule (lteUlSrsRxParams->duration, &LteSpectrumPhy::EndRxUlSrs, this);
+                if (m_ttiClock != 0)
+                  {
+                    m_endRxUlSrsEvent = m_ttiClock->ScheduleRx (lteUlSrsRxParams->duration, MakeEvent (&LteSpectrumPhy::EndRxUlSrs, this));
+                  }
+                else
+                  {
+                    m_endRxUlSrsEvent = Simulator::Schedule (lteUlSrsRxParams->duration, &LteSpectrumPhy::EndRxUlSrs, this);
+                  }
               }
             else if (m_state == RX_UL_SRS)
               {
@@ -1219,6 +1251,15 @@ LteSpectrumPhy::SetComponentCarrierId (uint8_t componentCarrierId)
   m_componentCarrierId = componentCarrierId;
 }
 
+void
+LteSpectrumPhy::SetTtiClock (Ptr<LteTtiClock> clock)
+{
+  NS_LOG_FUNCTION (this << clock);
+  m_ttiClock = clock;
+  m_interferenceData->SetTtiClock (clock);
+  m_interferenceCtrl->SetTtiClock (clock);
+}
+
 void
 LteSpectrumPhy::AddRsPowerChunkProcessor (Ptr<LteChunkProcessor> p)
 {
@@ -86,6 +86,7 @@ typedef std::map<TbId_t, tbInfo_t> expectedTbs_t; ///< expectedTbs_t typedef
 class LteNetDevice;
 class AntennaModel;
 class LteControlMessage;
+class LteTtiClock;
 struct LteSpectrumSignalParametersDataFrame;
 struct LteSpectrumSignalParametersDlCtrlFrame;
 struct LteSpectrumSignalParametersUlSrsFrame;
@@ -182,6 +183,7 @@ public:
   Ptr<const SpectrumModel> GetRxSpectrumModel () const;
   Ptr<AntennaModel> GetRxAntenna ();
   void StartRx (Ptr<SpectrumSignalParameters> params);
+  void StartRxPersistent (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> rxPsd);
   /**
    * \brief Start receive data function
    * \param params Ptr<LteSpectrumSignalParametersDataFrame>
@@ -339,6 +341,17 @@ public:
    */
   void SetComponentCarrierId (uint8_t componentCarrierId);
 
+  /**
+   * \brief Set the clock batching the ends of the receptions in the
+   * TTI-synchronous PHY mode
+   *
+   * The clock also batches the ends of the signals perceived by the
+   * data and control interference models.
+   *
+   * \param clock the clock, or 0 to schedule an event per reception
+   */
+  void SetTtiClock (Ptr<LteTtiClock> clock);
+
   /**
   *
   *
@@ -503,6 +516,7 @@ private:
   uint16_t m_cellId; ///< the cell ID
   
   uint8_t m_componentCarrierId; ///< the component carrier ID
+  Ptr<LteTtiClock> m_ttiClock; ///< the clock batching the ends of the receptions, if any
   expectedTbs_t m_expectedTbs; ///< the expected TBS
   SpectrumValue m_sinrPerceived; ///< the preceived SINR 
 
@@ -0,0 +1,433 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/simulator-impl.h>
+#include <ns3/node.h>
+#include <ns3/packet-burst.h>
+#include <ns3/lte-net-device.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-ue-phy.h>
+
+#include "lte-tti-clock.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteTtiClock");
+
+NS_OBJECT_ENSURE_REGISTERED (LteTtiClock);
+
+namespace {
+
+/**
+ * Runs the work of a PHY in the simulation context of its node: sets
+ * the context when constructed, and restores the context of the
+ * current event when destroyed.
+ */
+class ContextGuard
+{
+public:
+  /**
+   * \param context the simulation context of the PHY
+   */
+  ContextGuard (uint32_t context)
+    : m_impl (Simulator::GetImplementation ()),
+      m_context (m_impl->GetContext ())
+  {
+    m_impl->SetContext (context);
+  }
+  ~ContextGuard ()
+  {
+    m_impl->SetContext (m_context);
+  }
+
+private:
+  Ptr<SimulatorImpl> m_impl;  ///< the simulator implementation
+  uint32_t m_context;         ///< the context of the current event
+};
+
+} // anonymous namespace
+
+TypeId
+LteTtiClock::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LteTtiClock")
+    .SetParent<Object> ()
+    .SetGroupName ("Lte")
+    .AddConstructor<LteTtiClock> ()
+  ;
+  return tid;
+}
+
+LteTtiClock::LteTtiClock ()
+  : m_started (false),
+    m_tti (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LteTtiClock::~LteTtiClock ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+LteTtiClock::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_subframeEvent.Cancel ();
+  m_enbSubframeEvent.Cancel ();
+  m_enbFrameEvent.Cancel ();
+  m_dataEvent.Cancel ();
+  m_srsEvent.Cancel ();
+  m_phys.clear ();
+  m_enbSubframePhys.clear ();
+  m_enbFramePhys.clear ();
+  m_dataPhys.clear ();
+  m_srsPhys.clear ();
+  for (std::map<uint64_t, RxBatch>::iterator it = m_rxBatches.begin (); it != m_rxBatches.end (); ++it)
+    {
+      it->second.event.Cancel ();
+    }
+  m_rxBatches.clear ();
+  Object::DoDispose ();
+}
+
+bool
+LteTtiClock::AddEnbPhy (Ptr<LteEnbPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  PhyEntry entry;
+  entry.enbPhy = phy;
+  entry.frameNo = 0;
+  entry.subframeNo = 0;
+  entry.started = false;
+  return AddPhy (entry, phy);
+}
+
+bool
+LteTtiClock::AddUePhy (Ptr<LteUePhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  PhyEntry entry;
+  entry.uePhy = phy;
+  entry.frameNo = 1;
+  entry.subframeNo = 1;
+  entry.started = true;
+  return AddPhy (entry, phy);
+}
+
+bool
+LteTtiClock::AddPhy (const PhyEntry& entry, Ptr<LtePhy> phy)
+{
+  if (m_started)
+    {
+      NS_LOG_LOGIC (this << " already started, " << phy << " will schedule its own subframes");
+      return false;
+    }
+  if (m_phys.empty ())
+    {
+      m_startTime = Simulator::Now ();
+      m_tti = phy->GetTti ();
+      m_subframeEvent = Simulator::ScheduleNow (&LteTtiClock::StartSubframe, this);
+    }
+  else if ((Simulator::Now () != m_startTime) || (phy->GetTti () != m_tti))
+    {
+      NS_LOG_LOGIC (this << " not aligned, " << phy << " will schedule its own subframes");
+      return false;
+    }
+  m_phys.push_back (entry);
+  // same context as the events of the PHY in the default mode
+  Ptr<LteNetDevice> device = phy->GetDevice ();
+  if ((device != 0) && (device->GetNode () != 0))
+    {
+      m_phys.back ().context = device->GetNode ()->GetId ();
+    }
+  else
+    {
+      m_phys.back ().context = Simulator::GetContext ();
+    }
+  return true;
+}
+
+void
+LteTtiClock::RemovePhy (Ptr<LtePhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  for (std::vector<PhyEntry>::iterator it = m_phys.begin (); it != m_phys.end (); ++it)
+    {
+      if ((it->enbPhy == phy) || (it->uePhy == phy))
+        {
+          m_phys.erase (it);
+          break;
+        }
+    }
+  for (std::vector<PhyEntry>::iterator it = m_enbSubframePhys.begin (); it != m_enbSubframePhys.end (); ++it)
+    {
+      if (it->enbPhy == phy)
+        {
+          m_enbSubframePhys.erase (it);
+          break;
+        }
+    }
+  for (std::vector<PhyEntry>::iterator it = m_enbFramePhys.begin (); it != m_enbFramePhys.end (); ++it)
+    {
+      if (it->enbPhy == phy)
+        {
+          m_enbFramePhys.erase (it);
+          break;
+        }
+    }
+  for (std::vector< std::pair<PhyEntry, Ptr<PacketBurst> > >::iterator it = m_dataPhys.begin (); it != m_dataPhys.end (); ++it)
+    {
+      if (it->first.enbPhy == phy)
+        {
+          m_dataPhys.erase (it);
+          break;
+        }
+    }
+  for (std::vector<PhyEntry>::iterator it = m_srsPhys.begin (); it != m_srsPhys.end (); ++it)
+    {
+      if (it->uePhy == phy)
+        {
+          m_srsPhys.erase (it);
+          break;
+        }
+    }
+}
+
+void
+LteTtiClock::ScheduleDataChannels (Time delay, Ptr<LteEnbPhy> phy, Ptr<PacketBurst> pb)
+{
+  NS_LOG_FUNCTION (this << delay << phy << pb);
+  if (!m_dataEvent.IsRunning ())
+    {
+      m_dataEvent = Simulator::Schedule (delay, &LteTtiClock::SendDataChannels, this);
+    }
+  NS_ASSERT (m_dataEvent.GetTs () == static_cast<uint64_t> ((Simulator::Now () + delay).GetTimeStep ()));
+  PhyEntry entry;
+  entry.enbPhy = phy;
+  entry.context = Simulator::GetContext ();
+  entry.frameNo = 0;
+  entry.subframeNo = 0;
+  entry.started = true;
+  m_dataPhys.push_back (std::make_pair (entry, pb));
+}
+
+void
+LteTtiClock::ScheduleSrs (Time delay, Ptr<LteUePhy> phy)
+{
+  NS_LOG_FUNCTION (this << delay << phy);
+  if (!m_srsEvent.IsRunning ())
+    {
+      m_srsEvent = Simulator::Schedule (delay, &LteTtiClock::SendSrs, this);
+    }
+  NS_ASSERT (m_srsEvent.GetTs () == static_cast<uint64_t> ((Simulator::Now () + delay).GetTimeStep ()));
+  PhyEntry entry;
+  entry.uePhy = phy;
+  entry.context = Simulator::GetContext ();
+  entry.frameNo = 0;
+  entry.subframeNo = 0;
+  entry.started = true;
+  m_srsPhys.push_back (entry);
+}
+
+void
+LteTtiClock::CancelSrs (Ptr<LteUePhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  for (std::vector<PhyEntry>::iterator it = m_srsPhys.begin (); it != m_srsPhys.end (); ++it)
+    {
+      if (it->uePhy == phy)
+        {
+          m_srsPhys.erase (it);
+          break;
+        }
+    }
+}
+
+EventId
+LteTtiClock::ScheduleRx (Time delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay << event);
+  uint64_t ts = (Simulator::Now () + delay).GetTimeStep ();
+  std::map<uint64_t, RxBatch>::iterator it = m_rxBatches.find (ts);
+  if (it == m_rxBatches.end ())
+    {
+      // scheduled in place of the first reception event
+      it = m_rxBatches.insert (std::make_pair (ts, RxBatch ())).first;
+      it->second.event = Simulator::Schedule (delay, &LteTtiClock::ProcessRxEvents, this, ts);
+    }
+  Ptr<EventImpl> rxEvent = Ptr<EventImpl> (event, false);
+  uint32_t context = Simulator::GetContext ();
+  it->second.rxEvents.push_back (std::make_pair (rxEvent, context));
+  // the reception event expires with the event executing it
+  return EventId (rxEvent, ts, context, it->second.event.GetUid ());
+}
+
+void
+LteTtiClock::ScheduleNextSubframe (void)
+{
+  if (!m_subframeEvent.IsRunning ())
+    {
+      m_subframeEvent = Simulator::Schedule (Seconds (m_tti), &LteTtiClock::StartSubframe, this);
+    }
+}
+
+void
+LteTtiClock::StartSubframe (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_started = true;
+  // In the default mode, the UE PHYs and the eNB PHYs starting their
+  // first frame schedule their next subframe right away, while the
+  // other eNB PHYs only do so once the next subframe has started, so
+  // that they are visited after the former in the next subframe.
+  std::vector<PhyEntry> phys;
+  phys.swap (m_phys);
+  m_phys.reserve (phys.size ());
+  for (std::vector<PhyEntry>::iterator it = phys.begin (); it != phys.end (); ++it)
+    {
+      if (it->uePhy != 0)
+        {
+          {
+            ContextGuard guard (it->context);
+            it->uePhy->SubframeIndication (it->frameNo, it->subframeNo);
+          }
+          ++it->subframeNo;
+          if (it->subframeNo > 10)
+            {
+              ++it->frameNo;
+              it->subframeNo = 1;
+            }
+          ScheduleNextSubframe ();
+          m_phys.push_back (*it);
+        }
+      else if (!it->started)
+        {
+          it->started = true;
+          {
+            ContextGuard guard (it->context);
+            it->enbPhy->StartFrame ();
+          }
+          ScheduleNextSubframe ();
+          m_phys.push_back (*it);
+        }
+      else
+        {
+          // LteEnbPhy::EndSubFrame
+          if (!m_enbSubframeEvent.IsRunning ())
+            {
+              m_enbSubframeEvent = Simulator::ScheduleNow (&LteTtiClock::StartEnbSubframes, this);
+            }
+          m_enbSubframePhys.push_back (*it);
+        }
+    }
+}
+
+void
+LteTtiClock::StartEnbSubframes (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<PhyEntry> phys;
+  phys.swap (m_enbSubframePhys);
+  for (std::vector<PhyEntry>::iterator it = phys.begin (); it != phys.end (); ++it)
+    {
+      if (it->enbPhy->m_nrSubFrames == 10)
+        {
+          // LteEnbPhy::EndFrame
+          if (!m_enbFrameEvent.IsRunning ())
+            {
+              m_enbFrameEvent = Simulator::ScheduleNow (&LteTtiClock::StartEnbFrames, this);
+            }
+          m_enbFramePhys.push_back (*it);
+        }
+      else
+        {
+          {
+            ContextGuard guard (it->context);
+            it->enbPhy->StartSubFrame ();
+          }
+          ScheduleNextSubframe ();
+          m_phys.push_back (*it);
+        }
+    }
+}
+
+void
+LteTtiClock::StartEnbFrames (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<PhyEntry> phys;
+  phys.swap (m_enbFramePhys);
+  for (std::vector<PhyEntry>::iterator it = phys.begin (); it != phys.end (); ++it)
+    {
+      {
+        ContextGuard guard (it->context);
+        it->enbPhy->StartFrame ();
+      }
+      ScheduleNextSubframe ();
+      m_phys.push_back (*it);
+    }
+}
+
+void
+LteTtiClock::SendDataChannels (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector< std::pair<PhyEntry, Ptr<PacketBurst> > > phys;
+  phys.swap (m_dataPhys);
+  for (std::vector< std::pair<PhyEntry, Ptr<PacketBurst> > >::iterator it = phys.begin (); it != phys.end (); ++it)
+    {
+      ContextGuard guard (it->first.context);
+      it->first.enbPhy->SendDataChannels (it->second);
+    }
+}
+
+void
+LteTtiClock::SendSrs (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<PhyEntry> phys;
+  phys.swap (m_srsPhys);
+  for (std::vector<PhyEntry>::iterator it = phys.begin (); it != phys.end (); ++it)
+    {
+      ContextGuard guard (it->context);
+      it->uePhy->SendSrs ();
+    }
+}
+
+void
+LteTtiClock::ProcessRxEvents (uint64_t ts)
+{
+  NS_LOG_FUNCTION (this << ts);
+  std::map<uint64_t, RxBatch>::iterator it = m_rxBatches.find (ts);
+  NS_ASSERT (it != m_rxBatches.end ());
+  std::vector< std::pair<Ptr<EventImpl>, uint32_t> > rxEvents;
+  rxEvents.swap (it->second.rxEvents);
+  m_rxBatches.erase (it);
+  for (std::vector< std::pair<Ptr<EventImpl>, uint32_t> >::iterator rxIt = rxEvents.begin (); rxIt != rxEvents.end (); ++rxIt)
+    {
+      if (!rxIt->first->IsCancelled ())
+        {
+          ContextGuard guard (rxIt->second);
+          rxIt->first->Invoke ();
+        }
+    }
+}
+
+} // namespace ns3
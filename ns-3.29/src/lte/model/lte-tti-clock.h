@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_TTI_CLOCK_H
+#define LTE_TTI_CLOCK_H
+
+#include <ns3/object.h>
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
+#include <ns3/event-impl.h>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+class LtePhy;
+class LteEnbPhy;
+class LteUePhy;
+class PacketBurst;
+
+/**
+ * \ingroup lte
+ *
+ * The subframe clock shared by the eNB and UE PHYs in the
+ * TTI-synchronous PHY mode (see the `TtiSynchronousPhy` attribute of
+ * LteHelper).
+ *
+ * In the default mode, each PHY schedules its own subframe events:
+ * every eNB PHY ends its subframe and then starts the next one (and,
+ * when it has data, starts the PDSCH after the control region), and
+ * every UE PHY gets a subframe indication (and sends its SRS at the
+ * end of the subframe, when configured). The clock instead processes
+ * each of these phases for all its PHYs in a single event, which is
+ * scheduled when the first PHY would have scheduled its own event. The
+ * PHYs are visited in the order in which their own events would have
+ * been executed, so that the simulation results do not depend on the
+ * mode. The PHYs of all the component carriers share the same clock,
+ * since the order of their events also determines the order of the
+ * outputs of the statistics calculators.
+ *
+ * The clock also batches the reception events of the LteSpectrumPhy
+ * instances and of their LteInterference instances, i.e., the ends of
+ * the DL control, data and SRS receptions and the ends of the signals:
+ * the reception events of all the component carriers which expire at
+ * the same time are executed by a single event, in the order in which
+ * they were scheduled. The events of a carrier are not given an event
+ * of their own, as this would change the order of the receptions of
+ * different carriers, and hence of the outputs of the statistics
+ * calculators.
+ *
+ * The work of each PHY is run in the simulation context of its node
+ * (see SimulatorImpl::SetContext), as its own events would have been.
+ *
+ * The PHYs must be added before the clock starts, i.e., at the time
+ * of the first subframe; a PHY which is added afterwards is rejected
+ * and keeps on scheduling its own events.
+ */
+class LteTtiClock : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  LteTtiClock ();
+  virtual ~LteTtiClock ();
+
+  /**
+   * Add an eNB PHY, whose frames and subframes will be started by the
+   * clock, starting from now.
+   *
+   * \param phy the eNB PHY
+   * \return true if the PHY was added, false if the clock has already
+   * started
+   */
+  bool AddEnbPhy (Ptr<LteEnbPhy> phy);
+  /**
+   * Add a UE PHY, whose subframe indications will be triggered by the
+   * clock, starting from now with frame 1 and subframe 1.
+   *
+   * \param phy the UE PHY
+   * \return true if the PHY was added, false if the clock has already
+   * started
+   */
+  bool AddUePhy (Ptr<LteUePhy> phy);
+  /**
+   * Remove a PHY, together with its pending DL data and SRS
+   * transmissions.
+   *
+   * \param phy the PHY
+   */
+  void RemovePhy (Ptr<LtePhy> phy);
+
+  /**
+   * Schedule the transmission of the data channels of an eNB PHY.
+   *
+   * \param delay the delay from now
+   * \param phy the eNB PHY
+   * \param pb the packet burst to send
+   */
+  void ScheduleDataChannels (Time delay, Ptr<LteEnbPhy> phy, Ptr<PacketBurst> pb);
+  /**
+   * Schedule the transmission of the SRS of a UE PHY.
+   *
+   * \param delay the delay from now
+   * \param phy the UE PHY
+   */
+  void ScheduleSrs (Time delay, Ptr<LteUePhy> phy);
+  /**
+   * Cancel the pending SRS transmission of a UE PHY, if any.
+   *
+   * \param phy the UE PHY
+   */
+  void CancelSrs (Ptr<LteUePhy> phy);
+
+  /**
+   * Schedule a reception event, which will be executed in the current
+   * simulation context, together with the other reception events
+   * expiring at the same time.
+   *
+   * \param delay the delay from now
+   * \param event the reception event, e.g., created with MakeEvent
+   * \return the id of the reception event, which can be used to cancel
+   * it or to check whether it is still pending
+   */
+  EventId ScheduleRx (Time delay, EventImpl *event);
+
+protected:
+  // inherited from Object
+  virtual void DoDispose (void);
+
+private:
+  /// A PHY driven by the clock
+  struct PhyEntry
+  {
+    Ptr<LteEnbPhy> enbPhy;  ///< the eNB PHY, or 0 for a UE PHY
+    Ptr<LteUePhy> uePhy;    ///< the UE PHY, or 0 for an eNB PHY
+    uint32_t context;       ///< the simulation context of the PHY
+    uint32_t frameNo;       ///< the frame of the next UE subframe indication
+    uint32_t subframeNo;    ///< the subframe of the next UE subframe indication
+    bool started;           ///< whether the PHY has already started its first frame
+  };
+
+  /**
+   * Add a PHY.
+   *
+   * \param entry the entry of the PHY
+   * \param phy the PHY
+   * \return true if the PHY was added
+   */
+  bool AddPhy (const PhyEntry& entry, Ptr<LtePhy> phy);
+  /**
+   * Schedule the next subframe, if not already done in the current one.
+   */
+  void ScheduleNextSubframe (void);
+  /**
+   * Start a subframe: start the first frame of the new eNB PHYs, end
+   * the subframe of the other eNB PHYs, and trigger the subframe
+   * indication of the UE PHYs.
+   */
+  void StartSubframe (void);
+  /**
+   * Start the next subframe of the eNB PHYs whose subframe has ended,
+   * or end their frame.
+   */
+  void StartEnbSubframes (void);
+  /**
+   * Start the next frame of the eNB PHYs whose frame has ended.
+   */
+  void StartEnbFrames (void);
+  /**
+   * Send the data channels of the eNB PHYs.
+   */
+  void SendDataChannels (void);
+  /**
+   * Send the SRS of the UE PHYs.
+   */
+  void SendSrs (void);
+  /**
+   * Execute the reception events expiring now.
+   *
+   * \param ts the expiry time, in time steps
+   */
+  void ProcessRxEvents (uint64_t ts);
+
+  /// The reception events expiring at the same time
+  struct RxBatch
+  {
+    EventId event;  ///< the event executing the reception events
+    /// the reception events, and their simulation contexts
+    std::vector< std::pair<Ptr<EventImpl>, uint32_t> > rxEvents;
+  };
+
+  std::vector<PhyEntry> m_phys;  ///< the PHYs, in the order of their subframe events
+  Time m_startTime;              ///< the time of the first subframe
+  bool m_started;                ///< whether the first subframe has started
+  double m_tti;                  ///< the TTI of the PHYs, in seconds
+
+  EventId m_subframeEvent;       ///< the event of the next subframe
+  EventId m_enbSubframeEvent;    ///< the event starting the subframes of the eNB PHYs
+  EventId m_enbFrameEvent;       ///< the event starting the frames of the eNB PHYs
+  std::vector<PhyEntry> m_enbSubframePhys; ///< the eNB PHYs whose subframe has ended
+  std::vector<PhyEntry> m_enbFramePhys;    ///< the eNB PHYs whose frame has ended
+
+  EventId m_dataEvent;           ///< the event sending the data channels
+  /// the eNB PHYs with data channels to send, and their packet bursts
+  std::vector< std::pair<PhyEntry, Ptr<PacketBurst> > > m_dataPhys;
+  EventId m_srsEvent;            ///< the event sending the SRS
+  std::vector<PhyEntry> m_srsPhys; ///< the UE PHYs with an SRS to send
+
+  std::map<uint64_t, RxBatch> m_rxBatches; ///< the pending reception events, by expiry time
+};
+
+} // namespace ns3
+
+#endif /* LTE_TTI_CLOCK_H */
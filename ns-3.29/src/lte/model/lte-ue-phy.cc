@@ -41,6 +41,7 @@
 #include <ns3/pointer.h>
 #include <ns3/boolean.h>
 #include <ns3/lte-ue-power-control.h>
+#include <ns3/lte-tti-clock.h>
 
 namespace ns3 {
 
@@ -318,7 +319,16 @@ LteUePhy::DoInitialize ()
           haveNodeId = true;
         }
     }
-  if (haveNodeId)
+  if ((m_ttiClock != 0) && !m_ttiClock->AddUePhy (this))
+    {
+      // the clock has already started
+      m_ttiClock = 0;
+    }
+  if (m_ttiClock != 0)
+    {
+      NS_LOG_LOGIC (this << " subframe indications triggered by " << m_ttiClock);
+    }
+  else if (haveNodeId)
     {
       Simulator::ScheduleWithContext (nodeId, Seconds (0), &LteUePhy::SubframeIndication, this, 1, 1);
     }
@@ -1112,9 +1122,16 @@ LteUePhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
           if ((((frameNo-1)*10 + (subframeNo-1)) % m_srsPeriodicity) == m_srsSubframeOffset)
             {
               NS_LOG_INFO ("frame " << frameNo << " subframe " << subframeNo << " sending SRS (offset=" << m_srsSubframeOffset << ", period=" << m_srsPeriodicity << ")");
-              m_sendSrsEvent = Simulator::Schedule (UL_SRS_DELAY_FROM_SUBFRAME_START, 
-                                                    &LteUePhy::SendSrs,
-                                                    this);
+              if (m_ttiClock != 0)
+                {
+                  m_ttiClock->ScheduleSrs (UL_SRS_DELAY_FROM_SUBFRAME_START, this);
+                }
+              else
+                {
+                  m_sendSrsEvent = Simulator::Schedule (UL_SRS_DELAY_FROM_SUBFRAME_START, 
+                                                        &LteUePhy::SendSrs,
+                                                        this);
+                }
             }
         }
 
@@ -1166,8 +1183,11 @@ LteUePhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
       subframeNo = 1;
     }
 
-  // schedule next subframe indication
-  Simulator::Schedule (Seconds (GetTti ()), &LteUePhy::SubframeIndication, this, frameNo, subframeNo);
+  // schedule next subframe indication, unless triggered by the clock
+  if (m_ttiClock == 0)
+    {
+      Simulator::Schedule (Seconds (GetTti ()), &LteUePhy::SubframeIndication, this, frameNo, subframeNo);
+    }
 }
 
 
@@ -1225,6 +1245,10 @@ LteUePhy::DoReset ()
   m_subChannelsForTransmissionQueue.resize (m_macChTtiDelay, ulRb);
 
   m_sendSrsEvent.Cancel ();
+  if (m_ttiClock != 0)
+    {
+      m_ttiClock->CancelSrs (this);
+    }
   m_downlinkSpectrumPhy->Reset ();
   m_uplinkSpectrumPhy->Reset ();
 
@@ -29,6 +29,7 @@
 #include <ns3/boolean.h>
 #include <cfloat>
 #include <set>
+#include <algorithm>
 
 
 namespace ns3 {
@@ -44,6 +45,17 @@ static const int PfType0AllocationRbg[4] = {
 };  // see table 7.1.6.1-1 of 36.213
 
 
+/// a UE which can be allocated new data in the current DL subframe
+struct PfDlCandidate
+{
+  uint16_t slot;  ///< slot of the UE in the UE table
+  uint16_t rnti;  ///< RNTI of the UE
+  int nLayer;     ///< number of layers of the UE
+  const SbMeasResult_s* cqi; ///< A30 CQI of the UE, 0 if not available
+  std::vector <uint8_t> noCqi; ///< CQI per layer used when no A30 CQI is available
+};
+
+
 NS_OBJECT_ENSURE_REGISTERED (PfFfMacScheduler);
 
 
@@ -70,13 +82,8 @@ void
 PfFfMacScheduler::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
-  m_dlHarqProcessesDciBuffer.clear ();
-  m_dlHarqProcessesTimer.clear ();
-  m_dlHarqProcessesRlcPduListBuffer.clear ();
+  m_ues.Clear ();
   m_dlInfoListBuffered.clear ();
-  m_ulHarqCurrentProcessId.clear ();
-  m_ulHarqProcessesStatus.clear ();
-  m_ulHarqProcessesDciBuffer.clear ();
   delete m_cschedSapProvider;
   delete m_schedSapProvider;
   delete m_ffrSapUser;
@@ -163,39 +170,23 @@ void
 PfFfMacScheduler::DoCschedUeConfigReq (const struct FfMacCschedSapProvider::CschedUeConfigReqParameters& params)
 {
   NS_LOG_FUNCTION (this << " RNTI " << params.m_rnti << " txMode " << (uint16_t)params.m_transmissionMode);
-  std::map <uint16_t,uint8_t>::iterator it = m_uesTxMode.find (params.m_rnti);
-  if (it == m_uesTxMode.end ())
-    {
-      m_uesTxMode.insert (std::pair <uint16_t, double> (params.m_rnti, params.m_transmissionMode));
-      // generate HARQ buffers
-      m_dlHarqCurrentProcessId.insert (std::pair <uint16_t,uint8_t > (params.m_rnti, 0));
-      DlHarqProcessesStatus_t dlHarqPrcStatus;
-      dlHarqPrcStatus.resize (8,0);
-      m_dlHarqProcessesStatus.insert (std::pair <uint16_t, DlHarqProcessesStatus_t> (params.m_rnti, dlHarqPrcStatus));
-      DlHarqProcessesTimer_t dlHarqProcessesTimer;
-      dlHarqProcessesTimer.resize (8,0);
-      m_dlHarqProcessesTimer.insert (std::pair <uint16_t, DlHarqProcessesTimer_t> (params.m_rnti, dlHarqProcessesTimer));
-      DlHarqProcessesDciBuffer_t dlHarqdci;
-      dlHarqdci.resize (8);
-      m_dlHarqProcessesDciBuffer.insert (std::pair <uint16_t, DlHarqProcessesDciBuffer_t> (params.m_rnti, dlHarqdci));
-      DlHarqRlcPduListBuffer_t dlHarqRlcPdu;
-      dlHarqRlcPdu.resize (2);
-      dlHarqRlcPdu.at (0).resize (8);
-      dlHarqRlcPdu.at (1).resize (8);
-      m_dlHarqProcessesRlcPduListBuffer.insert (std::pair <uint16_t, DlHarqRlcPduListBuffer_t> (params.m_rnti, dlHarqRlcPdu));
-      m_ulHarqCurrentProcessId.insert (std::pair <uint16_t,uint8_t > (params.m_rnti, 0));
-      UlHarqProcessesStatus_t ulHarqPrcStatus;
-      ulHarqPrcStatus.resize (8,0);
-      m_ulHarqProcessesStatus.insert (std::pair <uint16_t, UlHarqProcessesStatus_t> (params.m_rnti, ulHarqPrcStatus));
-      UlHarqProcessesDciBuffer_t ulHarqdci;
-      ulHarqdci.resize (8);
-      m_ulHarqProcessesDciBuffer.insert (std::pair <uint16_t, UlHarqProcessesDciBuffer_t> (params.m_rnti, ulHarqdci));
-    }
-  else
+  // generate the UE context with its HARQ buffers, if not done yet
+  uint16_t slot = AddUe (params.m_rnti);
+  m_ues.m_txMode[slot] = params.m_transmissionMode;
+  return;
+}
+
+uint16_t
+PfFfMacScheduler::AddUe (uint16_t rnti)
+{
+  uint16_t slot = m_ues.Add (rnti);
+  if (slot >= m_hasFlowStats.size ())
     {
-      (*it).second = params.m_transmissionMode;
+      m_flowStatsDl.resize (m_ues.GetCapacity ());
+      m_flowStatsUl.resize (m_ues.GetCapacity ());
+      m_hasFlowStats.resize (m_ues.GetCapacity (), false);
     }
-  return;
+  return slot;
 }
 
 void
@@ -203,25 +194,24 @@ PfFfMacScheduler::DoCschedLcConfigReq (const struct FfMacCschedSapProvider::Csch
 {
   NS_LOG_FUNCTION (this << " New LC, rnti: "  << params.m_rnti);
 
-  std::map <uint16_t, pfsFlowPerf_t>::iterator it;
-  for (uint16_t i = 0; i < params.m_logicalChannelConfigList.size (); i++)
+  if (params.m_logicalChannelConfigList.size () > 0)
     {
-      it = m_flowStatsDl.find (params.m_rnti);
-
-      if (it == m_flowStatsDl.end ())
+      uint16_t slot = AddUe (params.m_rnti);
+      if (!m_hasFlowStats.at (slot))
         {
           pfsFlowPerf_t flowStatsDl;
           flowStatsDl.flowStart = Simulator::Now ();
           flowStatsDl.totalBytesTransmitted = 0;
           flowStatsDl.lastTtiBytesTrasmitted = 0;
           flowStatsDl.lastAveragedThroughput = 1;
-          m_flowStatsDl.insert (std::pair<uint16_t, pfsFlowPerf_t> (params.m_rnti, flowStatsDl));
+          m_flowStatsDl.at (slot) = flowStatsDl;
           pfsFlowPerf_t flowStatsUl;
           flowStatsUl.flowStart = Simulator::Now ();
           flowStatsUl.totalBytesTransmitted = 0;
           flowStatsUl.lastTtiBytesTrasmitted = 0;
           flowStatsUl.lastAveragedThroughput = 1;
-          m_flowStatsUl.insert (std::pair<uint16_t, pfsFlowPerf_t> (params.m_rnti, flowStatsUl));
+          m_flowStatsUl.at (slot) = flowStatsUl;
+          m_hasFlowStats.at (slot) = true;
         }
     }
 
@@ -258,18 +248,12 @@ PfFfMacScheduler::DoCschedUeReleaseReq (const struct FfMacCschedSapProvider::Csc
 {
   NS_LOG_FUNCTION (this);
 
-  m_uesTxMode.erase (params.m_rnti);
-  m_dlHarqCurrentProcessId.erase (params.m_rnti);
-  m_dlHarqProcessesStatus.erase  (params.m_rnti);
-  m_dlHarqProcessesTimer.erase (params.m_rnti);
-  m_dlHarqProcessesDciBuffer.erase  (params.m_rnti);
-  m_dlHarqProcessesRlcPduListBuffer.erase  (params.m_rnti);
-  m_ulHarqCurrentProcessId.erase  (params.m_rnti);
-  m_ulHarqProcessesStatus.erase  (params.m_rnti);
-  m_ulHarqProcessesDciBuffer.erase  (params.m_rnti);
-  m_flowStatsDl.erase  (params.m_rnti);
-  m_flowStatsUl.erase  (params.m_rnti);
-  m_ceBsrRxed.erase (params.m_rnti);
+  uint16_t slot = m_ues.Find (params.m_rnti);
+  if (slot != FfMacSchedulerUeTable::NO_SLOT)
+    {
+      m_hasFlowStats.at (slot) = false;
+      m_ues.Remove (params.m_rnti);
+    }
   std::map<LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator it = m_rlcBufferReq.begin ();
   std::map<LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator temp;
   while (it!=m_rlcBufferReq.end ())
@@ -354,7 +338,8 @@ PfFfMacScheduler::LcActivePerFlow (uint16_t rnti)
 {
   std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator it;
   unsigned int lcActive = 0;
-  for (it = m_rlcBufferReq.begin (); it != m_rlcBufferReq.end (); it++)
+  // the flows are sorted by RNTI first
+  for (it = m_rlcBufferReq.lower_bound (LteFlowId_t (rnti, 0)); it != m_rlcBufferReq.end (); it++)
     {
       if (((*it).first.m_rnti == rnti) && (((*it).second.m_rlcTransmissionQueueSize > 0)
                                            || ((*it).second.m_rlcRetransmissionQueueSize > 0)
@@ -373,27 +358,19 @@ PfFfMacScheduler::LcActivePerFlow (uint16_t rnti)
 
 
 uint8_t
-PfFfMacScheduler::HarqProcessAvailability (uint16_t rnti)
+PfFfMacScheduler::HarqProcessAvailability (uint16_t slot)
 {
-  NS_LOG_FUNCTION (this << rnti);
+  NS_LOG_FUNCTION (this << m_ues.m_rnti[slot]);
 
-  std::map <uint16_t, uint8_t>::iterator it = m_dlHarqCurrentProcessId.find (rnti);
-  if (it == m_dlHarqCurrentProcessId.end ())
-    {
-      NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
-    }
-  std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
-  if (itStat == m_dlHarqProcessesStatus.end ())
-    {
-      NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
-    }
-  uint8_t i = (*it).second;
+  uint8_t current = m_ues.m_dlHarqCurrentProcessId[slot];
+  const uint8_t* status = &m_ues.m_dlHarqProcessesStatus[FfMacSchedulerUeTable::HarqIndex (slot, 0)];
+  uint8_t i = current;
   do
     {
       i = (i + 1) % HARQ_PROC_NUM;
     }
-  while ( ((*itStat).second.at (i) != 0)&&(i != (*it).second));
-  if ((*itStat).second.at (i) == 0)
+  while ((status[i] != 0)&&(i != current));
+  if (status[i] == 0)
     {
       return (true);
     }
@@ -406,43 +383,34 @@ PfFfMacScheduler::HarqProcessAvailability (uint16_t rnti)
 
 
 uint8_t
-PfFfMacScheduler::UpdateHarqProcessId (uint16_t rnti)
+PfFfMacScheduler::UpdateHarqProcessId (uint16_t slot)
 {
-  NS_LOG_FUNCTION (this << rnti);
+  NS_LOG_FUNCTION (this << m_ues.m_rnti[slot]);
 
   if (m_harqOn == false)
     {
       return (0);
     }
 
-
-  std::map <uint16_t, uint8_t>::iterator it = m_dlHarqCurrentProcessId.find (rnti);
-  if (it == m_dlHarqCurrentProcessId.end ())
-    {
-      NS_FATAL_ERROR ("No Process Id found for this RNTI " << rnti);
-    }
-  std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find (rnti);
-  if (itStat == m_dlHarqProcessesStatus.end ())
-    {
-      NS_FATAL_ERROR ("No Process Id Statusfound for this RNTI " << rnti);
-    }
-  uint8_t i = (*it).second;
+  uint8_t current = m_ues.m_dlHarqCurrentProcessId[slot];
+  uint8_t* status = &m_ues.m_dlHarqProcessesStatus[FfMacSchedulerUeTable::HarqIndex (slot, 0)];
+  uint8_t i = current;
   do
     {
       i = (i + 1) % HARQ_PROC_NUM;
     }
-  while ( ((*itStat).second.at (i) != 0)&&(i != (*it).second));
-  if ((*itStat).second.at (i) == 0)
+  while ((status[i] != 0)&&(i != current));
+  if (status[i] == 0)
     {
-      (*it).second = i;
-      (*itStat).second.at (i) = 1;
+      m_ues.m_dlHarqCurrentProcessId[slot] = i;
+      status[i] = 1;
     }
   else
     {
-      NS_FATAL_ERROR ("No HARQ process available for RNTI " << rnti << " check before update with HarqProcessAvailability");
+      NS_FATAL_ERROR ("No HARQ process available for RNTI " << m_ues.m_rnti[slot] << " check before update with HarqProcessAvailability");
     }
 
-  return ((*it).second);
+  return (m_ues.m_dlHarqCurrentProcessId[slot]);
 }
 
 
@@ -451,27 +419,23 @@ PfFfMacScheduler::RefreshHarqProcesses ()
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itTimers;
-  for (itTimers = m_dlHarqProcessesTimer.begin (); itTimers != m_dlHarqProcessesTimer.end (); itTimers++)
+  const std::vector<uint16_t>& slots = m_ues.GetSlots ();
+  for (std::vector<uint16_t>::const_iterator itSlot = slots.begin (); itSlot != slots.end (); itSlot++)
     {
       for (uint16_t i = 0; i < HARQ_PROC_NUM; i++)
         {
-          if ((*itTimers).second.at (i) == HARQ_DL_TIMEOUT)
+          uint32_t harqIndex = FfMacSchedulerUeTable::HarqIndex (*itSlot, i);
+          if (m_ues.m_dlHarqProcessesTimer[harqIndex] == HARQ_DL_TIMEOUT)
             {
               // reset HARQ process
 
-              NS_LOG_DEBUG (this << " Reset HARQ proc " << i << " for RNTI " << (*itTimers).first);
-              std::map <uint16_t, DlHarqProcessesStatus_t>::iterator itStat = m_dlHarqProcessesStatus.find ((*itTimers).first);
-              if (itStat == m_dlHarqProcessesStatus.end ())
-                {
-                  NS_FATAL_ERROR ("No Process Id Status found for this RNTI " << (*itTimers).first);
-                }
-              (*itStat).second.at (i) = 0;
-              (*itTimers).second.at (i) = 0;
+              NS_LOG_DEBUG (this << " Reset HARQ proc " << i << " for RNTI " << m_ues.m_rnti[*itSlot]);
+              m_ues.m_dlHarqProcessesStatus[harqIndex] = 0;
+              m_ues.m_dlHarqProcessesTimer[harqIndex] = 0;
             }
           else
             {
-              (*itTimers).second.at (i)++;
+              m_ues.m_dlHarqProcessesTimer[harqIndex]++;
             }
         }
     }
@@ -512,10 +476,10 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
   FfMacSchedSapUser::SchedDlConfigIndParameters ret;
 
   //   update UL HARQ proc id
-  std::map <uint16_t, uint8_t>::iterator itProcId;
-  for (itProcId = m_ulHarqCurrentProcessId.begin (); itProcId != m_ulHarqCurrentProcessId.end (); itProcId++)
+  const std::vector<uint16_t>& slots = m_ues.GetSlots ();
+  for (std::vector<uint16_t>::const_iterator itSlot = slots.begin (); itSlot != slots.end (); itSlot++)
     {
-      (*itProcId).second = ((*itProcId).second + 1) % HARQ_PROC_NUM;
+      m_ues.m_ulHarqCurrentProcessId[*itSlot] = (m_ues.m_ulHarqCurrentProcessId[*itSlot] + 1) % HARQ_PROC_NUM;
     }
 
 
@@ -621,20 +585,12 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
           uldci.m_freqHopping = 0;
           uldci.m_pdcchPowerOffset = 0; // not used
 
-          uint8_t harqId = 0;
-          std::map <uint16_t, uint8_t>::iterator itProcId;
-          itProcId = m_ulHarqCurrentProcessId.find (uldci.m_rnti);
-          if (itProcId == m_ulHarqCurrentProcessId.end ())
+          uint16_t slot = m_ues.Find (uldci.m_rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
               NS_FATAL_ERROR ("No info find in HARQ buffer for UE " << uldci.m_rnti);
             }
-          harqId = (*itProcId).second;
-          std::map <uint16_t, UlHarqProcessesDciBuffer_t>::iterator itDci = m_ulHarqProcessesDciBuffer.find (uldci.m_rnti);
-          if (itDci == m_ulHarqProcessesDciBuffer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find RNTI entry in UL DCI HARQ buffer for RNTI " << uldci.m_rnti);
-            }
-          (*itDci).second.at (harqId) = uldci;
+          m_ues.m_ulHarqProcessesDciBuffer.at (FfMacSchedulerUeTable::HarqIndex (slot, m_ues.m_ulHarqCurrentProcessId[slot])) = uldci;
         }
       
       rbStart = rbStart + rbLen;
@@ -694,13 +650,14 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
           uint16_t rnti = m_dlInfoListBuffered.at (i).m_rnti;
           uint8_t harqId = m_dlInfoListBuffered.at (i).m_harqProcessId;
           NS_LOG_INFO (this << " HARQ retx RNTI " << rnti << " harqId " << (uint16_t)harqId);
-          std::map <uint16_t, DlHarqProcessesDciBuffer_t>::iterator itHarq = m_dlHarqProcessesDciBuffer.find (rnti);
-          if (itHarq == m_dlHarqProcessesDciBuffer.end ())
+          uint16_t slot = m_ues.Find (rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
               NS_FATAL_ERROR ("No info find in HARQ buffer for UE " << rnti);
             }
+          uint32_t harqIndex = FfMacSchedulerUeTable::HarqIndex (slot, harqId);
 
-          DlDciListElement_s dci = (*itHarq).second.at (harqId);
+          DlDciListElement_s dci = m_ues.m_dlHarqProcessesDciBuffer.at (harqIndex);
           int rv = 0;
           if (dci.m_rv.size () == 1)
             {
@@ -715,20 +672,10 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
             {
               // maximum number of retx reached -> drop process
               NS_LOG_INFO ("Maximum number of retransmissions reached -> drop process");
-              std::map <uint16_t, DlHarqProcessesStatus_t>::iterator it = m_dlHarqProcessesStatus.find (rnti);
-              if (it == m_dlHarqProcessesStatus.end ())
-                {
-                  NS_LOG_ERROR ("No info find in HARQ buffer for UE (might change eNB) " << m_dlInfoListBuffered.at (i).m_rnti);
-                }
-              (*it).second.at (harqId) = 0;
-              std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find (rnti);
-              if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
-                {
-                  NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << m_dlInfoListBuffered.at (i).m_rnti);
-                }
-              for (uint16_t k = 0; k < (*itRlcPdu).second.size (); k++)
+              m_ues.m_dlHarqProcessesStatus.at (harqIndex) = 0;
+              for (uint8_t k = 0; k < FfMacSchedulerUeTable::DL_HARQ_LAYERS; k++)
                 {
-                  (*itRlcPdu).second.at (k).at (harqId).clear ();
+                  m_ues.m_dlHarqProcessesRlcPduListBuffer.at (FfMacSchedulerUeTable::RlcPduListIndex (slot, k, harqId)).clear ();
                 }
               continue;
             }
@@ -807,11 +754,6 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
             }
           // retrieve RLC PDU list for retx TBsize and update DCI
           BuildDataListElement_s newEl;
-          std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find (rnti);
-          if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << rnti);
-            }
           for (uint8_t j = 0; j < nLayers; j++)
             {
               if (retx.at (j))
@@ -829,7 +771,7 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
                     {
                       dci.m_ndi.at (j) = 0;
                       dci.m_rv.at (j)++;
-                      (*itHarq).second.at (harqId).m_rv.at (j)++;
+                      m_ues.m_dlHarqProcessesDciBuffer.at (harqIndex).m_rv.at (j)++;
                       NS_LOG_INFO (this << " layer " << (uint16_t)j << " RV " << (uint16_t)dci.m_rv.at (j));
                     }
                 }
@@ -843,7 +785,8 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
                   NS_LOG_INFO (this << " layer " << (uint16_t)j << " no retx");
                 }
             }
-          for (uint16_t k = 0; k < (*itRlcPdu).second.at (0).at (dci.m_harqProcess).size (); k++)
+          const std::vector <RlcPduListElement_s>* rlcPduBuffer = &m_ues.m_dlHarqProcessesRlcPduListBuffer.at (FfMacSchedulerUeTable::RlcPduListIndex (slot, 0, dci.m_harqProcess));
+          for (uint16_t k = 0; k < rlcPduBuffer[0].size (); k++)
             {
               std::vector <struct RlcPduListElement_s> rlcPduListPerLc;
               for (uint8_t j = 0; j < nLayers; j++)
@@ -853,14 +796,14 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
                       if (j < dci.m_ndi.size ())
                         {
                           NS_LOG_INFO (" layer " << (uint16_t)j << " tb size " << dci.m_tbsSize.at (j));
-                          rlcPduListPerLc.push_back ((*itRlcPdu).second.at (j).at (dci.m_harqProcess).at (k));
+                          rlcPduListPerLc.push_back (rlcPduBuffer[j * HARQ_PROC_NUM].at (k));
                         }
                     }
                   else
                     { // if no retx needed on layer j, push an RlcPduListElement_s object with m_size=0 to keep the size of rlcPduListPerLc vector = 2 in case of MIMO
                       NS_LOG_INFO (" layer " << (uint16_t)j << " tb size "<<dci.m_tbsSize.at (j));
                       RlcPduListElement_s emptyElement;
-                      emptyElement.m_logicalChannelIdentity = (*itRlcPdu).second.at (j).at (dci.m_harqProcess).at (k).m_logicalChannelIdentity;
+                      emptyElement.m_logicalChannelIdentity = rlcPduBuffer[j * HARQ_PROC_NUM].at (k).m_logicalChannelIdentity;
                       emptyElement.m_size = 0;
                       rlcPduListPerLc.push_back (emptyElement);
                     }
@@ -873,14 +816,9 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
             }
           newEl.m_rnti = rnti;
           newEl.m_dci = dci;
-          (*itHarq).second.at (harqId).m_rv = dci.m_rv;
+          m_ues.m_dlHarqProcessesDciBuffer.at (harqIndex).m_rv = dci.m_rv;
           // refresh timer
-          std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itHarqTimer = m_dlHarqProcessesTimer.find (rnti);
-          if (itHarqTimer== m_dlHarqProcessesTimer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)rnti);
-            }
-          (*itHarqTimer).second.at (harqId) = 0;
+          m_ues.m_dlHarqProcessesTimer.at (harqIndex) = 0;
           ret.m_buildDataList.push_back (newEl);
           rntiAllocated.insert (rnti);
         }
@@ -888,20 +826,16 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
         {
           // update HARQ process status
           NS_LOG_INFO (this << " HARQ received ACK for UE " << m_dlInfoListBuffered.at (i).m_rnti);
-          std::map <uint16_t, DlHarqProcessesStatus_t>::iterator it = m_dlHarqProcessesStatus.find (m_dlInfoListBuffered.at (i).m_rnti);
-          if (it == m_dlHarqProcessesStatus.end ())
+          uint16_t slot = m_ues.Find (m_dlInfoListBuffered.at (i).m_rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
               NS_FATAL_ERROR ("No info find in HARQ buffer for UE " << m_dlInfoListBuffered.at (i).m_rnti);
             }
-          (*it).second.at (m_dlInfoListBuffered.at (i).m_harqProcessId) = 0;
-          std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find (m_dlInfoListBuffered.at (i).m_rnti);
-          if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << m_dlInfoListBuffered.at (i).m_rnti);
-            }
-          for (uint16_t k = 0; k < (*itRlcPdu).second.size (); k++)
+          uint8_t harqId = m_dlInfoListBuffered.at (i).m_harqProcessId;
+          m_ues.m_dlHarqProcessesStatus.at (FfMacSchedulerUeTable::HarqIndex (slot, harqId)) = 0;
+          for (uint8_t k = 0; k < FfMacSchedulerUeTable::DL_HARQ_LAYERS; k++)
             {
-              (*itRlcPdu).second.at (k).at (m_dlInfoListBuffered.at (i).m_harqProcessId).clear ();
+              m_ues.m_dlHarqProcessesRlcPduListBuffer.at (FfMacSchedulerUeTable::RlcPduListIndex (slot, k, harqId)).clear ();
             }
         }
     }
@@ -920,54 +854,71 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
 
 
+  // collect the UEs which can be allocated new data in this TTI: neither
+  // their HARQ processes nor their RLC buffers change during the RBG
+  // loop, hence these checks do not depend on the RBG
+  std::vector <PfDlCandidate> candidates;
+  for (std::vector<uint16_t>::const_iterator itSlot = slots.begin (); itSlot != slots.end (); itSlot++)
+    {
+      if (!m_hasFlowStats.at (*itSlot))
+        {
+          continue;
+        }
+      uint16_t rnti = m_ues.m_rnti[*itSlot];
+      std::set <uint16_t>::iterator itRnti = rntiAllocated.find (rnti);
+      if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability (*itSlot)))
+        {
+          // UE already allocated for HARQ or without HARQ process available -> drop it
+          if (itRnti != rntiAllocated.end ())
+            {
+              NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)rnti);
+            }
+          if (!HarqProcessAvailability (*itSlot))
+            {
+              NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)rnti);
+            }
+          continue;
+        }
+      if (LcActivePerFlow (rnti) == 0)
+        {
+          // this UE has no data to transmit
+          continue;
+        }
+      PfDlCandidate candidate;
+      candidate.slot = *itSlot;
+      candidate.rnti = rnti;
+      candidate.nLayer = TransmissionModesLayers::TxMode2LayerNum (m_ues.m_txMode[*itSlot]);
+      candidate.cqi = m_ues.m_a30CqiRxed[*itSlot] ? &m_ues.m_a30Cqi[*itSlot] : 0;
+      if (candidate.cqi == 0)
+        {
+          candidate.noCqi.resize (candidate.nLayer, 1);  // start with lowest value
+        }
+      candidates.push_back (candidate);
+    }
+
+  // achievable rate in a RBG for each CQI (TB size / TTI)
+  std::vector <double> rbgRate (16);
+  for (uint8_t cqi = 0; cqi < rbgRate.size (); cqi++)
+    {
+      rbgRate.at (cqi) = ((m_amc->GetDlTbSizeFromMcs (m_amc->GetMcsFromCqi (cqi), rbgSize) / 8) / 0.001);
+    }
+  // no info on the subband -> worst MCS
+  double rbgRateNoInfo = ((m_amc->GetDlTbSizeFromMcs (0, rbgSize) / 8) / 0.001);
+
   for (int i = 0; i < rbgNum; i++)
     {
       NS_LOG_INFO (this << " ALLOCATION for RBG " << i << " of " << rbgNum);
       if (rbgMap.at (i) == false)
         {
-          std::map <uint16_t, pfsFlowPerf_t>::iterator it;
-          std::map <uint16_t, pfsFlowPerf_t>::iterator itMax = m_flowStatsDl.end ();
+          std::vector <PfDlCandidate>::const_iterator it;
+          std::vector <PfDlCandidate>::const_iterator itMax = candidates.end ();
           double rcqiMax = 0.0;
-          for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+          for (it = candidates.begin (); it != candidates.end (); it++)
             {
-              if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first)) == false)
+              if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).rnti)) == false)
                 continue;
 
-              std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
-              if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability ((*it).first)))
-                {
-                  // UE already allocated for HARQ or without HARQ process available -> drop it
-                  if (itRnti != rntiAllocated.end ())
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
-                    }
-                  if (!HarqProcessAvailability ((*it).first))
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
-                    }
-                  continue;
-                }
-              std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-              itCqi = m_a30CqiRxed.find ((*it).first);
-              std::map <uint16_t,uint8_t>::iterator itTxMode;
-              itTxMode = m_uesTxMode.find ((*it).first);
-              if (itTxMode == m_uesTxMode.end ())
-                {
-                  NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                }
-              int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-              std::vector <uint8_t> sbCqi;
-              if (itCqi == m_a30CqiRxed.end ())
-                {
-                  for (uint8_t k = 0; k < nLayer; k++)
-                    {
-                      sbCqi.push_back (1);  // start with lowest value
-                    }
-                }
-              else
-                {
-                  sbCqi = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-                }
+              const std::vector <uint8_t>& sbCqi = ((*it).cqi != 0) ? (*it).cqi->m_higherLayerSelected.at (i).m_sbCqi : (*it).noCqi;
               uint8_t cqi1 = sbCqi.at (0);
               uint8_t cqi2 = 0;
               if (sbCqi.size () > 1)
@@ -977,38 +928,37 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
               if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                 {
-                  if (LcActivePerFlow ((*it).first) > 0)
+                  // this UE has data to transmit
+                  double achievableRate = 0.0;
+                  for (uint8_t k = 0; k < (*it).nLayer; k++)
                     {
-                      // this UE has data to transmit
-                      double achievableRate = 0.0;
-                      uint8_t mcs = 0;
-                      for (uint8_t k = 0; k < nLayer; k++)
+                      if (sbCqi.size () <= k)
                         {
-                          if (sbCqi.size () > k)
-                            {
-                              mcs = m_amc->GetMcsFromCqi (sbCqi.at (k));
-                            }
-                          else
-                            {
-                              // no info on this subband -> worst MCS
-                              mcs = 0;
-                            }
-                          achievableRate += ((m_amc->GetDlTbSizeFromMcs (mcs, rbgSize) / 8) / 0.001);   // = TB size / TTI
+                          achievableRate += rbgRateNoInfo;
                         }
-
-                      double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
-                      NS_LOG_INFO (this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs << " achievableRate " << achievableRate << " avgThr " << (*it).second.lastAveragedThroughput << " RCQI " << rcqi);
-
-                      if (rcqi > rcqiMax)
+                      else if (sbCqi.at (k) < rbgRate.size ())
                         {
-                          rcqiMax = rcqi;
-                          itMax = it;
+                          achievableRate += rbgRate.at (sbCqi.at (k));
+                        }
+                      else
+                        {
+                          uint8_t mcs = m_amc->GetMcsFromCqi (sbCqi.at (k));
+                          achievableRate += ((m_amc->GetDlTbSizeFromMcs (mcs, rbgSize) / 8) / 0.001);
                         }
                     }
+
+                  double rcqi = achievableRate / m_flowStatsDl.at ((*it).slot).lastAveragedThroughput;
+                  NS_LOG_INFO (this << " RNTI " << (*it).rnti << " achievableRate " << achievableRate << " avgThr " << m_flowStatsDl.at ((*it).slot).lastAveragedThroughput << " RCQI " << rcqi);
+
+                  if (rcqi > rcqiMax)
+                    {
+                      rcqiMax = rcqi;
+                      itMax = it;
+                    }
                 }   // end if cqi
-            } // end for m_rlcBufferReq
+            } // end for candidates
 
-          if (itMax == m_flowStatsDl.end ())
+          if (itMax == candidates.end ())
             {
               // no UE available for this RB
               NS_LOG_INFO (this << " any UE found");
@@ -1017,28 +967,27 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
             {
               rbgMap.at (i) = true;
               std::map <uint16_t, std::vector <uint16_t> >::iterator itMap;
-              itMap = allocationMap.find ((*itMax).first);
+              itMap = allocationMap.find ((*itMax).rnti);
               if (itMap == allocationMap.end ())
                 {
                   // insert new element
                   std::vector <uint16_t> tempMap;
                   tempMap.push_back (i);
-                  allocationMap.insert (std::pair <uint16_t, std::vector <uint16_t> > ((*itMax).first, tempMap));
+                  allocationMap.insert (std::pair <uint16_t, std::vector <uint16_t> > ((*itMax).rnti, tempMap));
                 }
               else
                 {
                   (*itMap).second.push_back (i);
                 }
-              NS_LOG_INFO (this << " UE assigned " << (*itMax).first);
+              NS_LOG_INFO (this << " UE assigned " << (*itMax).rnti);
             }
         } // end for RBG free
     } // end for RBGs
 
   // reset TTI stats of users
-  std::map <uint16_t, pfsFlowPerf_t>::iterator itStats;
-  for (itStats = m_flowStatsDl.begin (); itStats != m_flowStatsDl.end (); itStats++)
+  for (std::vector<uint16_t>::const_iterator itSlot = slots.begin (); itSlot != slots.end (); itSlot++)
     {
-      (*itStats).second.lastTtiBytesTrasmitted = 0;
+      m_flowStatsDl.at (*itSlot).lastTtiBytesTrasmitted = 0;
     }
 
   // generate the transmission opportunities by grouping the RBGs of the same RNTI and
@@ -1046,13 +995,14 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
   std::map <uint16_t, std::vector <uint16_t> >::iterator itMap = allocationMap.begin ();
   while (itMap != allocationMap.end ())
     {
+      uint16_t slot = m_ues.Find ((*itMap).first);
       // create new BuildDataListElement_s for this LC
       BuildDataListElement_s newEl;
       newEl.m_rnti = (*itMap).first;
       // create the DlDciListElement_s
       DlDciListElement_s newDci;
       newDci.m_rnti = (*itMap).first;
-      newDci.m_harqProcess = UpdateHarqProcessId ((*itMap).first);
+      newDci.m_harqProcess = UpdateHarqProcessId (slot);
 
       uint16_t lcActives = LcActivePerFlow ((*itMap).first);
       NS_LOG_INFO (this << "Allocate user " << newEl.m_rnti << " rbg " << lcActives);
@@ -1062,30 +1012,24 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
           lcActives = (uint16_t)65535; // UINT16_MAX;
         }
       uint16_t RgbPerRnti = (*itMap).second.size ();
-      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-      itCqi = m_a30CqiRxed.find ((*itMap).first);
-      std::map <uint16_t,uint8_t>::iterator itTxMode;
-      itTxMode = m_uesTxMode.find ((*itMap).first);
-      if (itTxMode == m_uesTxMode.end ())
-        {
-          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*itMap).first);
-        }
-      int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+      int nLayer = TransmissionModesLayers::TxMode2LayerNum (m_ues.m_txMode[slot]);
       std::vector <uint8_t> worstCqi (2, 15);
-      if (itCqi != m_a30CqiRxed.end ())
+      if (m_ues.m_a30CqiRxed[slot])
         {
+          const std::vector <HigherLayerSelected_s>& higherLayerSelected = m_ues.m_a30Cqi[slot].m_higherLayerSelected;
           for (uint16_t k = 0; k < (*itMap).second.size (); k++)
             {
-              if ((*itCqi).second.m_higherLayerSelected.size () > (*itMap).second.at (k))
+              if (higherLayerSelected.size () > (*itMap).second.at (k))
                 {
-                  NS_LOG_INFO (this << " RBG " << (*itMap).second.at (k) << " CQI " << (uint16_t)((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (0)) );
+                  const std::vector <uint8_t>& sbCqi = higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi;
+                  NS_LOG_INFO (this << " RBG " << (*itMap).second.at (k) << " CQI " << (uint16_t)(sbCqi.at (0)) );
                   for (uint8_t j = 0; j < nLayer; j++)
                     {
-                      if ((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.size () > j)
+                      if (sbCqi.size () > j)
                         {
-                          if (((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (j)) < worstCqi.at (j))
+                          if ((sbCqi.at (j)) < worstCqi.at (j))
                             {
-                              worstCqi.at (j) = ((*itCqi).second.m_higherLayerSelected.at ((*itMap).second.at (k)).m_sbCqi.at (j));
+                              worstCqi.at (j) = (sbCqi.at (j));
                             }
                         }
                       else
@@ -1137,7 +1081,7 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
       // create the rlc PDUs -> equally divide resources among actives LCs
       std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator itBufReq;
-      for (itBufReq = m_rlcBufferReq.begin (); itBufReq != m_rlcBufferReq.end (); itBufReq++)
+      for (itBufReq = m_rlcBufferReq.lower_bound (LteFlowId_t ((*itMap).first, 0)); itBufReq != m_rlcBufferReq.end (); itBufReq++)
         {
           if (((*itBufReq).first.m_rnti == (*itMap).first)
               && (((*itBufReq).second.m_rlcTransmissionQueueSize > 0)
@@ -1156,12 +1100,7 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
                   if (m_harqOn == true)
                     {
                       // store RLC PDU list for HARQ
-                      std::map <uint16_t, DlHarqRlcPduListBuffer_t>::iterator itRlcPdu =  m_dlHarqProcessesRlcPduListBuffer.find ((*itMap).first);
-                      if (itRlcPdu == m_dlHarqProcessesRlcPduListBuffer.end ())
-                        {
-                          NS_FATAL_ERROR ("Unable to find RlcPdcList in HARQ buffer for RNTI " << (*itMap).first);
-                        }
-                      (*itRlcPdu).second.at (j).at (newDci.m_harqProcess).push_back (newRlcEl);
+                      m_ues.m_dlHarqProcessesRlcPduListBuffer.at (FfMacSchedulerUeTable::RlcPduListIndex (slot, j, newDci.m_harqProcess)).push_back (newRlcEl);
                     }
                 }
               newEl.m_rlcPduList.push_back (newRlcPduLe);
@@ -1184,31 +1123,19 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
       if (m_harqOn == true)
         {
           // store DCI for HARQ
-          std::map <uint16_t, DlHarqProcessesDciBuffer_t>::iterator itDci = m_dlHarqProcessesDciBuffer.find (newEl.m_rnti);
-          if (itDci == m_dlHarqProcessesDciBuffer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find RNTI entry in DCI HARQ buffer for RNTI " << newEl.m_rnti);
-            }
-          (*itDci).second.at (newDci.m_harqProcess) = newDci;
+          m_ues.m_dlHarqProcessesDciBuffer.at (FfMacSchedulerUeTable::HarqIndex (slot, newDci.m_harqProcess)) = newDci;
           // refresh timer
-          std::map <uint16_t, DlHarqProcessesTimer_t>::iterator itHarqTimer =  m_dlHarqProcessesTimer.find (newEl.m_rnti);
-          if (itHarqTimer== m_dlHarqProcessesTimer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find HARQ timer for RNTI " << (uint16_t)newEl.m_rnti);
-            }
-          (*itHarqTimer).second.at (newDci.m_harqProcess) = 0;
+          m_ues.m_dlHarqProcessesTimer[FfMacSchedulerUeTable::HarqIndex (slot, newDci.m_harqProcess)] = 0;
         }
 
       // ...more parameters -> ignored in this version
 
       ret.m_buildDataList.push_back (newEl);
       // update UE stats
-      std::map <uint16_t, pfsFlowPerf_t>::iterator it;
-      it = m_flowStatsDl.find ((*itMap).first);
-      if (it != m_flowStatsDl.end ())
+      if (m_hasFlowStats.at (slot))
         {
-          (*it).second.lastTtiBytesTrasmitted = bytesTxed;
-          NS_LOG_INFO (this << " UE total bytes txed " << (*it).second.lastTtiBytesTrasmitted);
+          m_flowStatsDl.at (slot).lastTtiBytesTrasmitted = bytesTxed;
+          NS_LOG_INFO (this << " UE total bytes txed " << m_flowStatsDl.at (slot).lastTtiBytesTrasmitted);
 
 
         }
@@ -1224,14 +1151,19 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
   // update UEs stats
   NS_LOG_INFO (this << " Update UEs statistics");
-  for (itStats = m_flowStatsDl.begin (); itStats != m_flowStatsDl.end (); itStats++)
+  for (std::vector<uint16_t>::const_iterator itSlot = slots.begin (); itSlot != slots.end (); itSlot++)
     {
-      (*itStats).second.totalBytesTransmitted += (*itStats).second.lastTtiBytesTrasmitted;
+      if (!m_hasFlowStats.at (*itSlot))
+        {
+          continue;
+        }
+      pfsFlowPerf_t& stats = m_flowStatsDl.at (*itSlot);
+      stats.totalBytesTransmitted += stats.lastTtiBytesTrasmitted;
       // update average throughput (see eq. 12.3 of Sec 12.3.1.2 of LTE – The UMTS Long Term Evolution, Ed Wiley)
-      (*itStats).second.lastAveragedThroughput = ((1.0 - (1.0 / m_timeWindow)) * (*itStats).second.lastAveragedThroughput) + ((1.0 / m_timeWindow) * (double)((*itStats).second.lastTtiBytesTrasmitted / 0.001));
-      NS_LOG_INFO (this << " UE total bytes " << (*itStats).second.totalBytesTransmitted);
-      NS_LOG_INFO (this << " UE average throughput " << (*itStats).second.lastAveragedThroughput);
-      (*itStats).second.lastTtiBytesTrasmitted = 0;
+      stats.lastAveragedThroughput = ((1.0 - (1.0 / m_timeWindow)) * stats.lastAveragedThroughput) + ((1.0 / m_timeWindow) * (double)(stats.lastTtiBytesTrasmitted / 0.001));
+      NS_LOG_INFO (this << " UE total bytes " << stats.totalBytesTransmitted);
+      NS_LOG_INFO (this << " UE average throughput " << stats.lastAveragedThroughput);
+      stats.lastTtiBytesTrasmitted = 0;
     }
 
   m_schedSapUser->SchedDlConfigInd (ret);
@@ -1261,46 +1193,32 @@ PfFfMacScheduler::DoSchedDlCqiInfoReq (const struct FfMacSchedSapProvider::Sched
       if ( params.m_cqiList.at (i).m_cqiType == CqiListElement_s::P10 )
         {
           NS_LOG_LOGIC ("wideband CQI " <<  (uint32_t) params.m_cqiList.at (i).m_wbCqi.at (0) << " reported");
-          std::map <uint16_t,uint8_t>::iterator it;
           uint16_t rnti = params.m_cqiList.at (i).m_rnti;
-          it = m_p10CqiRxed.find (rnti);
-          if (it == m_p10CqiRxed.end ())
-            {
-              // create the new entry
-              m_p10CqiRxed.insert ( std::pair<uint16_t, uint8_t > (rnti, params.m_cqiList.at (i).m_wbCqi.at (0)) ); // only codeword 0 at this stage (SISO)
-              // generate correspondent timer
-              m_p10CqiTimers.insert ( std::pair<uint16_t, uint32_t > (rnti, m_cqiTimersThreshold));
-            }
-          else
+          uint16_t slot = m_ues.Find (rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
-              // update the CQI value and refresh correspondent timer
-              (*it).second = params.m_cqiList.at (i).m_wbCqi.at (0);
-              // update correspondent timer
-              std::map <uint16_t,uint32_t>::iterator itTimers;
-              itTimers = m_p10CqiTimers.find (rnti);
-              (*itTimers).second = m_cqiTimersThreshold;
+              NS_LOG_INFO (this << " CQI of unknown UE " << rnti << " ignored");
+              continue;
             }
+          // update the CQI value and refresh correspondent timer
+          m_ues.m_p10CqiRxed[slot] = true;
+          m_ues.m_p10Cqi[slot] = params.m_cqiList.at (i).m_wbCqi.at (0); // only codeword 0 at this stage (SISO)
+          m_ues.m_p10CqiTimer[slot] = m_cqiTimersThreshold;
         }
       else if ( params.m_cqiList.at (i).m_cqiType == CqiListElement_s::A30 )
         {
           // subband CQI reporting high layer configured
-          std::map <uint16_t,SbMeasResult_s>::iterator it;
           uint16_t rnti = params.m_cqiList.at (i).m_rnti;
-          it = m_a30CqiRxed.find (rnti);
-          if (it == m_a30CqiRxed.end ())
+          uint16_t slot = m_ues.Find (rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
-              // create the new entry
-              m_a30CqiRxed.insert ( std::pair<uint16_t, SbMeasResult_s > (rnti, params.m_cqiList.at (i).m_sbMeasResult) );
-              m_a30CqiTimers.insert ( std::pair<uint16_t, uint32_t > (rnti, m_cqiTimersThreshold));
-            }
-          else
-            {
-              // update the CQI value and refresh correspondent timer
-              (*it).second = params.m_cqiList.at (i).m_sbMeasResult;
-              std::map <uint16_t,uint32_t>::iterator itTimers;
-              itTimers = m_a30CqiTimers.find (rnti);
-              (*itTimers).second = m_cqiTimersThreshold;
+              NS_LOG_INFO (this << " CQI of unknown UE " << rnti << " ignored");
+              continue;
             }
+          // update the CQI value and refresh correspondent timer
+          m_ues.m_a30CqiRxed[slot] = true;
+          m_ues.m_a30Cqi[slot] = params.m_cqiList.at (i).m_sbMeasResult;
+          m_ues.m_a30CqiTimer[slot] = m_cqiTimersThreshold;
         }
       else
         {
@@ -1398,26 +1316,18 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
             {
               // retx correspondent block: retrieve the UL-DCI
               uint16_t rnti = params.m_ulInfoList.at (i).m_rnti;
-              std::map <uint16_t, uint8_t>::iterator itProcId = m_ulHarqCurrentProcessId.find (rnti);
-              if (itProcId == m_ulHarqCurrentProcessId.end ())
-                {
-                  NS_LOG_ERROR ("No info find in HARQ buffer for UE (might change eNB) " << rnti);
-                }
-              uint8_t harqId = (uint8_t)((*itProcId).second - HARQ_PERIOD) % HARQ_PROC_NUM;
-              NS_LOG_INFO (this << " UL-HARQ retx RNTI " << rnti << " harqId " << (uint16_t)harqId << " i " << i << " size "  << params.m_ulInfoList.size ());
-              std::map <uint16_t, UlHarqProcessesDciBuffer_t>::iterator itHarq = m_ulHarqProcessesDciBuffer.find (rnti);
-              if (itHarq == m_ulHarqProcessesDciBuffer.end ())
+              uint16_t slot = m_ues.Find (rnti);
+              if (slot == FfMacSchedulerUeTable::NO_SLOT)
                 {
                   NS_LOG_ERROR ("No info find in HARQ buffer for UE (might change eNB) " << rnti);
                   continue;
                 }
-              UlDciListElement_s dci = (*itHarq).second.at (harqId);
-              std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (rnti);
-              if (itStat == m_ulHarqProcessesStatus.end ())
-                {
-                  NS_LOG_ERROR ("No info find in HARQ buffer for UE (might change eNB) " << rnti);
-                }
-              if ((*itStat).second.at (harqId) >= 3)
+              uint8_t harqId = (uint8_t)(m_ues.m_ulHarqCurrentProcessId[slot] - HARQ_PERIOD) % HARQ_PROC_NUM;
+              uint32_t harqIndex = FfMacSchedulerUeTable::HarqIndex (slot, harqId);
+              uint32_t currentHarqIndex = FfMacSchedulerUeTable::HarqIndex (slot, m_ues.m_ulHarqCurrentProcessId[slot]);
+              NS_LOG_INFO (this << " UL-HARQ retx RNTI " << rnti << " harqId " << (uint16_t)harqId << " i " << i << " size "  << params.m_ulInfoList.size ());
+              UlDciListElement_s dci = m_ues.m_ulHarqProcessesDciBuffer.at (harqIndex);
+              if (m_ues.m_ulHarqProcessesStatus[harqIndex] >= 3)
                 {
                   NS_LOG_INFO ("Max number of retransmissions reached (UL)-> drop process");
                   continue;
@@ -1441,7 +1351,7 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
                       NS_LOG_INFO ("\tRB " << j);
                       rbAllocatedNum++;
                     }
-                  NS_LOG_INFO (this << " Send retx in the same RBs " << (uint16_t)dci.m_rbStart << " to " << dci.m_rbStart + dci.m_rbLen << " RV " << (*itStat).second.at (harqId) + 1);
+                  NS_LOG_INFO (this << " Send retx in the same RBs " << (uint16_t)dci.m_rbStart << " to " << dci.m_rbStart + dci.m_rbLen << " RV " << m_ues.m_ulHarqProcessesStatus[harqIndex] + 1);
                 }
               else
                 {
@@ -1450,9 +1360,9 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
                 }
               dci.m_ndi = 0;
               // Update HARQ buffers with new HarqId
-              (*itStat).second.at ((*itProcId).second) = (*itStat).second.at (harqId) + 1;
-              (*itStat).second.at (harqId) = 0;
-              (*itHarq).second.at ((*itProcId).second) = dci;
+              m_ues.m_ulHarqProcessesStatus[currentHarqIndex] = m_ues.m_ulHarqProcessesStatus[harqIndex] + 1;
+              m_ues.m_ulHarqProcessesStatus[harqIndex] = 0;
+              m_ues.m_ulHarqProcessesDciBuffer.at (currentHarqIndex) = dci;
               ret.m_dciList.push_back (dci);
               rntiAllocated.insert (dci.m_rnti);
             }
@@ -1463,14 +1373,20 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
         }
     }
 
-  std::map <uint16_t,uint32_t>::iterator it;
+  // UEs which sent a BSR, sorted by RNTI
+  std::vector <uint16_t> bsrSlots;
   int nflows = 0;
-
-  for (it = m_ceBsrRxed.begin (); it != m_ceBsrRxed.end (); it++)
+  const std::vector<uint16_t>& slots = m_ues.GetSlots ();
+  for (std::vector<uint16_t>::const_iterator itSlot = slots.begin (); itSlot != slots.end (); itSlot++)
     {
-      std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
+      if (!m_ues.m_bsrRxed[*itSlot])
+        {
+          continue;
+        }
+      bsrSlots.push_back (*itSlot);
+      std::set <uint16_t>::iterator itRnti = rntiAllocated.find (m_ues.m_rnti[*itSlot]);
       // select UEs with queues not empty and not yet allocated for HARQ
-      if (((*it).second > 0)&&(itRnti == rntiAllocated.end ()))
+      if ((m_ues.m_bsr[*itSlot] > 0)&&(itRnti == rntiAllocated.end ()))
         {
           nflows++;
         }
@@ -1499,39 +1415,39 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
   int rbAllocated = 0;
 
-  std::map <uint16_t, pfsFlowPerf_t>::iterator itStats;
+  // index in bsrSlots of the UE to be served
+  uint16_t it = 0;
   if (m_nextRntiUl != 0)
     {
-      for (it = m_ceBsrRxed.begin (); it != m_ceBsrRxed.end (); it++)
+      for (it = 0; it < bsrSlots.size (); it++)
         {
-          if ((*it).first == m_nextRntiUl)
+          if (m_ues.m_rnti[bsrSlots.at (it)] == m_nextRntiUl)
             {
               break;
             }
         }
-      if (it == m_ceBsrRxed.end ())
+      if (it == bsrSlots.size ())
         {
           NS_LOG_ERROR (this << " no user found");
+          it = 0;
+          m_nextRntiUl = m_ues.m_rnti[bsrSlots.at (it)];
         }
     }
   else
     {
-      it = m_ceBsrRxed.begin ();
-      m_nextRntiUl = (*it).first;
+      it = 0;
+      m_nextRntiUl = m_ues.m_rnti[bsrSlots.at (it)];
     }
   do
     {
-      std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
-      if ((itRnti != rntiAllocated.end ())||((*it).second == 0))
+      uint16_t slot = bsrSlots.at (it);
+      std::set <uint16_t>::iterator itRnti = rntiAllocated.find (m_ues.m_rnti[slot]);
+      if ((itRnti != rntiAllocated.end ())||(m_ues.m_bsr[slot] == 0))
         {
           // UE already allocated for UL-HARQ -> skip it
-          NS_LOG_DEBUG (this << " UE already allocated in HARQ -> discared, RNTI " << (*it).first);
-          it++;
-          if (it == m_ceBsrRxed.end ())
-            {
-              // restart from the first
-              it = m_ceBsrRxed.begin ();
-            }
+          NS_LOG_DEBUG (this << " UE already allocated in HARQ -> discared, RNTI " << m_ues.m_rnti[slot]);
+          // restart from the first after the last one
+          it = (it + 1) % bsrSlots.size ();
           continue;
         }
       if (rbAllocated + rbPerFlow - 1 > m_cschedCellConfig.m_ulBandwidth)
@@ -1548,7 +1464,7 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
       rbAllocated = 0;
       UlDciListElement_s uldci;
-      uldci.m_rnti = (*it).first;
+      uldci.m_rnti = m_ues.m_rnti[slot];
       uldci.m_rbLen = rbPerFlow;
       bool allocated = false;
 
@@ -1563,7 +1479,7 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
                   free = false;
                   break;
                 }
-              if ((m_ffrSapProvider->IsUlRbgAvailableForUe (j, (*it).first)) == false)
+              if ((m_ffrSapProvider->IsUlRbgAvailableForUe (j, m_ues.m_rnti[slot])) == false)
                 {
                   free = false;
                   break;
@@ -1571,14 +1487,14 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
             }
           if (free)
             {
-              NS_LOG_INFO (this << "RNTI: "<< (*it).first<< " RB Allocated " << rbAllocated << " rbPerFlow " << rbPerFlow << " flows " << nflows);
+              NS_LOG_INFO (this << "RNTI: "<< m_ues.m_rnti[slot] << " RB Allocated " << rbAllocated << " rbPerFlow " << rbPerFlow << " flows " << nflows);
               uldci.m_rbStart = rbAllocated;
 
               for (uint16_t j = rbAllocated; j < rbAllocated + rbPerFlow; j++)
                 {
                   rbMap.at (j) = true;
                   // store info on allocation for managing ul-cqi interpretation
-                  rbgAllocationMap.at (j) = (*it).first;
+                  rbgAllocationMap.at (j) = m_ues.m_rnti[slot];
                 }
               rbAllocated += rbPerFlow;
               allocated = true;
@@ -1600,19 +1516,13 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
       if (!allocated)
         {
           // unable to allocate new resource: finish scheduling
-          m_nextRntiUl = (*it).first;
-//          if (ret.m_dciList.size () > 0)
-//            {
-//              m_schedSapUser->SchedUlConfigInd (ret);
-//            }
-//          m_allocationMaps.insert (std::pair <uint16_t, std::vector <uint16_t> > (params.m_sfnSf, rbgAllocationMap));
-//          return;
+          m_nextRntiUl = m_ues.m_rnti[slot];
           break;
         }
 
 
 
-      std::map <uint16_t, std::vector <double> >::iterator itCqi = m_ueCqi.find ((*it).first);
+      std::map <uint16_t, std::vector <double> >::iterator itCqi = m_ueCqi.find (m_ues.m_rnti[slot]);
       int cqi = 0;
       if (itCqi == m_ueCqi.end ())
         {
@@ -1625,14 +1535,14 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
           double minSinr = (*itCqi).second.at (uldci.m_rbStart);
           if (minSinr == NO_SINR)
             {
-              minSinr = EstimateUlSinr ((*it).first, uldci.m_rbStart);
+              minSinr = EstimateUlSinr (m_ues.m_rnti[slot], uldci.m_rbStart);
             }
           for (uint16_t i = uldci.m_rbStart; i < uldci.m_rbStart + uldci.m_rbLen; i++)
             {
               double sinr = (*itCqi).second.at (i);
               if (sinr == NO_SINR)
                 {
-                  sinr = EstimateUlSinr ((*it).first, i);
+                  sinr = EstimateUlSinr (m_ues.m_rnti[slot], i);
                 }
               if (sinr < minSinr)
                 {
@@ -1647,12 +1557,8 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
           cqi = m_amc->GetCqiFromSpectralEfficiency (s);
           if (cqi == 0)
             {
-              it++;
-              if (it == m_ceBsrRxed.end ())
-                {
-                  // restart from the first
-                  it = m_ceBsrRxed.begin ();
-                }
+              // restart from the first after the last one
+              it = (it + 1) % bsrSlots.size ();
               NS_LOG_DEBUG (this << " UE discared for CQI=0, RNTI " << uldci.m_rnti);
               // remove UE from allocation map
               for (uint16_t i = uldci.m_rbStart; i < uldci.m_rbStart + uldci.m_rbLen; i++)
@@ -1683,35 +1589,19 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
       uint8_t harqId = 0;
       if (m_harqOn == true)
         {
-          std::map <uint16_t, uint8_t>::iterator itProcId;
-          itProcId = m_ulHarqCurrentProcessId.find (uldci.m_rnti);
-          if (itProcId == m_ulHarqCurrentProcessId.end ())
-            {
-              NS_FATAL_ERROR ("No info find in HARQ buffer for UE " << uldci.m_rnti);
-            }
-          harqId = (*itProcId).second;
-          std::map <uint16_t, UlHarqProcessesDciBuffer_t>::iterator itDci = m_ulHarqProcessesDciBuffer.find (uldci.m_rnti);
-          if (itDci == m_ulHarqProcessesDciBuffer.end ())
-            {
-              NS_FATAL_ERROR ("Unable to find RNTI entry in UL DCI HARQ buffer for RNTI " << uldci.m_rnti);
-            }
-          (*itDci).second.at (harqId) = uldci;
+          harqId = m_ues.m_ulHarqCurrentProcessId[slot];
+          uint32_t harqIndex = FfMacSchedulerUeTable::HarqIndex (slot, harqId);
+          m_ues.m_ulHarqProcessesDciBuffer.at (harqIndex) = uldci;
           // Update HARQ process status (RV 0)
-          std::map <uint16_t, UlHarqProcessesStatus_t>::iterator itStat = m_ulHarqProcessesStatus.find (uldci.m_rnti);
-          if (itStat == m_ulHarqProcessesStatus.end ())
-            {
-              NS_LOG_ERROR ("No info find in HARQ buffer for UE (might change eNB) " << uldci.m_rnti);
-            }
-          (*itStat).second.at (harqId) = 0;
+          m_ues.m_ulHarqProcessesStatus[harqIndex] = 0;
         }
 
-      NS_LOG_INFO (this << " UE Allocation RNTI " << (*it).first << " startPRB " << (uint32_t)uldci.m_rbStart << " nPRB " << (uint32_t)uldci.m_rbLen << " CQI " << cqi << " MCS " << (uint32_t)uldci.m_mcs << " TBsize " << uldci.m_tbSize << " RbAlloc " << rbAllocated << " harqId " << (uint16_t)harqId);
+      NS_LOG_INFO (this << " UE Allocation RNTI " << m_ues.m_rnti[slot] << " startPRB " << (uint32_t)uldci.m_rbStart << " nPRB " << (uint32_t)uldci.m_rbLen << " CQI " << cqi << " MCS " << (uint32_t)uldci.m_mcs << " TBsize " << uldci.m_tbSize << " RbAlloc " << rbAllocated << " harqId " << (uint16_t)harqId);
 
       // update TTI  UE stats
-      itStats = m_flowStatsUl.find ((*it).first);
-      if (itStats != m_flowStatsUl.end ())
+      if (m_hasFlowStats.at (slot))
         {
-          (*itStats).second.lastTtiBytesTrasmitted =  uldci.m_tbSize;
+          m_flowStatsUl.at (slot).lastTtiBytesTrasmitted =  uldci.m_tbSize;
         }
       else
         {
@@ -1719,32 +1609,33 @@ PfFfMacScheduler::DoSchedUlTriggerReq (const struct FfMacSchedSapProvider::Sched
         }
 
 
-      it++;
-      if (it == m_ceBsrRxed.end ())
-        {
-          // restart from the first
-          it = m_ceBsrRxed.begin ();
-        }
+      // restart from the first after the last one
+      it = (it + 1) % bsrSlots.size ();
       if ((rbAllocated == m_cschedCellConfig.m_ulBandwidth) || (rbPerFlow == 0))
         {
           // Stop allocation: no more PRBs
-          m_nextRntiUl = (*it).first;
+          m_nextRntiUl = m_ues.m_rnti[bsrSlots.at (it)];
           break;
         }
     }
-  while (((*it).first != m_nextRntiUl)&&(rbPerFlow!=0));
+  while ((m_ues.m_rnti[bsrSlots.at (it)] != m_nextRntiUl)&&(rbPerFlow!=0));
 
 
   // Update global UE stats
   // update UEs stats
-  for (itStats = m_flowStatsUl.begin (); itStats != m_flowStatsUl.end (); itStats++)
+  for (std::vector<uint16_t>::const_iterator itSlot = slots.begin (); itSlot != slots.end (); itSlot++)
     {
-      (*itStats).second.totalBytesTransmitted += (*itStats).second.lastTtiBytesTrasmitted;
+      if (!m_hasFlowStats.at (*itSlot))
+        {
+          continue;
+        }
+      pfsFlowPerf_t& stats = m_flowStatsUl.at (*itSlot);
+      stats.totalBytesTransmitted += stats.lastTtiBytesTrasmitted;
       // update average throughput (see eq. 12.3 of Sec 12.3.1.2 of LTE – The UMTS Long Term Evolution, Ed Wiley)
-      (*itStats).second.lastAveragedThroughput = ((1.0 - (1.0 / m_timeWindow)) * (*itStats).second.lastAveragedThroughput) + ((1.0 / m_timeWindow) * (double)((*itStats).second.lastTtiBytesTrasmitted / 0.001));
-      NS_LOG_INFO (this << " UE total bytes " << (*itStats).second.totalBytesTransmitted);
-      NS_LOG_INFO (this << " UE average throughput " << (*itStats).second.lastAveragedThroughput);
-      (*itStats).second.lastTtiBytesTrasmitted = 0;
+      stats.lastAveragedThroughput = ((1.0 - (1.0 / m_timeWindow)) * stats.lastAveragedThroughput) + ((1.0 / m_timeWindow) * (double)(stats.lastTtiBytesTrasmitted / 0.001));
+      NS_LOG_INFO (this << " UE total bytes " << stats.totalBytesTransmitted);
+      NS_LOG_INFO (this << " UE average throughput " << stats.lastAveragedThroughput);
+      stats.lastTtiBytesTrasmitted = 0;
     }
   m_allocationMaps.insert (std::pair <uint16_t, std::vector <uint16_t> > (params.m_sfnSf, rbgAllocationMap));
   m_schedSapUser->SchedUlConfigInd (ret);
@@ -1771,8 +1662,6 @@ PfFfMacScheduler::DoSchedUlMacCtrlInfoReq (const struct FfMacSchedSapProvider::S
 {
   NS_LOG_FUNCTION (this);
 
-  std::map <uint16_t,uint32_t>::iterator it;
-
   for (unsigned int i = 0; i < params.m_macCeList.size (); i++)
     {
       if ( params.m_macCeList.at (i).m_macCeType == MacCeListElement_s::BSR )
@@ -1793,17 +1682,15 @@ PfFfMacScheduler::DoSchedUlMacCtrlInfoReq (const struct FfMacSchedSapProvider::S
 
           uint16_t rnti = params.m_macCeList.at (i).m_rnti;
           NS_LOG_LOGIC (this << "RNTI=" << rnti << " buffer=" << buffer);
-          it = m_ceBsrRxed.find (rnti);
-          if (it == m_ceBsrRxed.end ())
+          uint16_t slot = m_ues.Find (rnti);
+          if (slot == FfMacSchedulerUeTable::NO_SLOT)
             {
-              // create the new entry
-              m_ceBsrRxed.insert ( std::pair<uint16_t, uint32_t > (rnti, buffer));
-            }
-          else
-            {
-              // update the buffer size value
-              (*it).second = buffer;
+              NS_LOG_INFO (this << " BSR of unknown UE " << rnti << " ignored");
+              continue;
             }
+          // update the buffer size value
+          m_ues.m_bsrRxed[slot] = true;
+          m_ues.m_bsr[slot] = buffer;
         }
     }
 
@@ -1964,49 +1851,37 @@ PfFfMacScheduler::DoSchedUlCqiInfoReq (const struct FfMacSchedSapProvider::Sched
 void
 PfFfMacScheduler::RefreshDlCqiMaps (void)
 {
-  // refresh DL CQI P01 Map
-  std::map <uint16_t,uint32_t>::iterator itP10 = m_p10CqiTimers.begin ();
-  while (itP10 != m_p10CqiTimers.end ())
+  const std::vector<uint16_t>& slots = m_ues.GetSlots ();
+  for (std::vector<uint16_t>::const_iterator itSlot = slots.begin (); itSlot != slots.end (); itSlot++)
     {
-      NS_LOG_INFO (this << " P10-CQI for user " << (*itP10).first << " is " << (uint32_t)(*itP10).second << " thr " << (uint32_t)m_cqiTimersThreshold);
-      if ((*itP10).second == 0)
+      // refresh DL CQI P01
+      if (m_ues.m_p10CqiRxed[*itSlot])
         {
-          // delete correspondent entries
-          std::map <uint16_t,uint8_t>::iterator itMap = m_p10CqiRxed.find ((*itP10).first);
-          NS_ASSERT_MSG (itMap != m_p10CqiRxed.end (), " Does not find CQI report for user " << (*itP10).first);
-          NS_LOG_INFO (this << " P10-CQI expired for user " << (*itP10).first);
-          m_p10CqiRxed.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itP10;
-          itP10++;
-          m_p10CqiTimers.erase (temp);
-        }
-      else
-        {
-          (*itP10).second--;
-          itP10++;
+          NS_LOG_INFO (this << " P10-CQI for user " << m_ues.m_rnti[*itSlot] << " is " << (uint32_t)m_ues.m_p10CqiTimer[*itSlot] << " thr " << (uint32_t)m_cqiTimersThreshold);
+          if (m_ues.m_p10CqiTimer[*itSlot] == 0)
+            {
+              NS_LOG_INFO (this << " P10-CQI expired for user " << m_ues.m_rnti[*itSlot]);
+              m_ues.m_p10CqiRxed[*itSlot] = false;
+            }
+          else
+            {
+              m_ues.m_p10CqiTimer[*itSlot]--;
+            }
         }
-    }
 
-  // refresh DL CQI A30 Map
-  std::map <uint16_t,uint32_t>::iterator itA30 = m_a30CqiTimers.begin ();
-  while (itA30 != m_a30CqiTimers.end ())
-    {
-      NS_LOG_INFO (this << " A30-CQI for user " << (*itA30).first << " is " << (uint32_t)(*itA30).second << " thr " << (uint32_t)m_cqiTimersThreshold);
-      if ((*itA30).second == 0)
-        {
-          // delete correspondent entries
-          std::map <uint16_t,SbMeasResult_s>::iterator itMap = m_a30CqiRxed.find ((*itA30).first);
-          NS_ASSERT_MSG (itMap != m_a30CqiRxed.end (), " Does not find CQI report for user " << (*itA30).first);
-          NS_LOG_INFO (this << " A30-CQI expired for user " << (*itA30).first);
-          m_a30CqiRxed.erase (itMap);
-          std::map <uint16_t,uint32_t>::iterator temp = itA30;
-          itA30++;
-          m_a30CqiTimers.erase (temp);
-        }
-      else
+      // refresh DL CQI A30
+      if (m_ues.m_a30CqiRxed[*itSlot])
         {
-          (*itA30).second--;
-          itA30++;
+          NS_LOG_INFO (this << " A30-CQI for user " << m_ues.m_rnti[*itSlot] << " is " << (uint32_t)m_ues.m_a30CqiTimer[*itSlot] << " thr " << (uint32_t)m_cqiTimersThreshold);
+          if (m_ues.m_a30CqiTimer[*itSlot] == 0)
+            {
+              NS_LOG_INFO (this << " A30-CQI expired for user " << m_ues.m_rnti[*itSlot]);
+              m_ues.m_a30CqiRxed[*itSlot] = false;
+            }
+          else
+            {
+              m_ues.m_a30CqiTimer[*itSlot]--;
+            }
         }
     }
 
@@ -2101,17 +1976,17 @@ PfFfMacScheduler::UpdateUlRlcBufferInfo (uint16_t rnti, uint16_t size)
 {
 
   size = size - 2; // remove the minimum RLC overhead
-  std::map <uint16_t,uint32_t>::iterator it = m_ceBsrRxed.find (rnti);
-  if (it != m_ceBsrRxed.end ())
+  uint16_t slot = m_ues.Find (rnti);
+  if ((slot != FfMacSchedulerUeTable::NO_SLOT) && m_ues.m_bsrRxed[slot])
     {
-      NS_LOG_INFO (this << " UE " << rnti << " size " << size << " BSR " << (*it).second);
-      if ((*it).second >= size)
+      NS_LOG_INFO (this << " UE " << rnti << " size " << size << " BSR " << m_ues.m_bsr[slot]);
+      if (m_ues.m_bsr[slot] >= size)
         {
-          (*it).second -= size;
+          m_ues.m_bsr[slot] -= size;
         }
       else
         {
-          (*it).second = 0;
+          m_ues.m_bsr[slot] = 0;
         }
     }
   else
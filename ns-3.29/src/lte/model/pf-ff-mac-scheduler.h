@@ -30,6 +30,7 @@
 #include <ns3/nstime.h>
 #include <ns3/lte-amc.h>
 #include <ns3/lte-ffr-sap.h>
+#include <ns3/ff-mac-scheduler-ue-table.h>
 
 // value for SINR outside the range defined by FF-API, used to indicate that there
 // is no CQI for this element
@@ -254,6 +255,14 @@ private:
    */
   unsigned int LcActivePerFlow (uint16_t rnti);
 
+  /**
+   * \brief Add a UE to the UE table, with its flow statistics
+   *
+   * \param rnti the RNTI
+   * \returns the slot of the UE
+   */
+  uint16_t AddUe (uint16_t rnti);
+
   /**
    * \brief Estimate UL SINR
    *
@@ -285,20 +294,20 @@ private:
   void UpdateUlRlcBufferInfo (uint16_t rnti, uint16_t size);
 
   /**
-  * \brief Update and return a new process Id for the RNTI specified
+  * \brief Update and return a new process Id for the UE specified
   *
-  * \param rnti the RNTI of the UE to be updated
+  * \param slot the slot of the UE to be updated
   * \return the process id  value
   */
-  uint8_t UpdateHarqProcessId (uint16_t rnti);
+  uint8_t UpdateHarqProcessId (uint16_t slot);
 
   /**
-  * \brief Return the availability of free process for the RNTI specified
+  * \brief Return the availability of free process for the UE specified
   *
-  * \param rnti the RNTI of the UE to be updated
+  * \param slot the slot of the UE
   * \return the process id  value
   */
-  uint8_t HarqProcessAvailability (uint16_t rnti);
+  uint8_t HarqProcessAvailability (uint16_t slot);
 
   /**
   * \brief Refresh HARQ processes according to the timers
@@ -315,33 +324,25 @@ private:
 
 
   /**
-  * Map of UE statistics (per RNTI basis) in downlink
+  * State of the UEs: txMode, HARQ processes, DL CQIs and BSRs
   */
-  std::map <uint16_t, pfsFlowPerf_t> m_flowStatsDl;
+  FfMacSchedulerUeTable m_ues;
 
   /**
-  * Map of UE statistics (per RNTI basis)
+  * UE statistics in downlink, indexed by UE slot
   */
-  std::map <uint16_t, pfsFlowPerf_t> m_flowStatsUl;
-
+  std::vector <pfsFlowPerf_t> m_flowStatsDl;
 
   /**
-  * Map of UE's DL CQI P01 received
-  */
-  std::map <uint16_t,uint8_t> m_p10CqiRxed;
-  /**
-  * Map of UE's timers on DL CQI P01 received
+  * UE statistics in uplink, indexed by UE slot
   */
-  std::map <uint16_t,uint32_t> m_p10CqiTimers;
+  std::vector <pfsFlowPerf_t> m_flowStatsUl;
 
   /**
-  * Map of UE's DL CQI A30 received
+  * Whether the statistics of each UE slot are valid, i.e., whether a
+  * LC was configured for the UE
   */
-  std::map <uint16_t,SbMeasResult_s> m_a30CqiRxed;
-  /**
-  * Map of UE's timers on DL CQI A30 received
-  */
-  std::map <uint16_t,uint32_t> m_a30CqiTimers;
+  std::vector <bool> m_hasFlowStats;
 
   /**
   * Map of previous allocated UE per RBG
@@ -358,11 +359,6 @@ private:
   */
   std::map <uint16_t, uint32_t> m_ueCqiTimers;
 
-  /**
-  * Map of UE's buffer status reports received
-  */
-  std::map <uint16_t,uint32_t> m_ceBsrRxed;
-
   // MAC SAPs
   FfMacCschedSapUser* m_cschedSapUser; ///< CSched SAP user
   FfMacSchedSapUser* m_schedSapUser; ///< Sched SAP user
@@ -383,30 +379,13 @@ private:
 
   uint32_t m_cqiTimersThreshold; ///< # of TTIs for which a CQI can be considered valid
 
-  std::map <uint16_t,uint8_t> m_uesTxMode; ///< txMode of the UEs
-
   // HARQ attributes
   /**
   * m_harqOn when false inhibit the HARQ mechanisms (by default active)
   */
   bool m_harqOn;
-  std::map <uint16_t, uint8_t> m_dlHarqCurrentProcessId; ///< DL HARQ current process ID
-  //HARQ status
-  // 0: process Id available
-  // x>0: process Id equal to `x` transmission count
-  std::map <uint16_t, DlHarqProcessesStatus_t> m_dlHarqProcessesStatus; ///< DL HARQ process status
-  std::map <uint16_t, DlHarqProcessesTimer_t> m_dlHarqProcessesTimer; ///< DL HARQ process timer
-  std::map <uint16_t, DlHarqProcessesDciBuffer_t> m_dlHarqProcessesDciBuffer; ///< DL HARQ process DCI buffer
-  std::map <uint16_t, DlHarqRlcPduListBuffer_t> m_dlHarqProcessesRlcPduListBuffer; ///< DL HARQ process RLC PDU list buffer
   std::vector <DlInfoListElement_s> m_dlInfoListBuffered; ///< HARQ retx buffered
 
-  std::map <uint16_t, uint8_t> m_ulHarqCurrentProcessId; ///< UL HARQ current process ID
-  //HARQ status
-  // 0: process Id available
-  // x>0: process Id equal to `x` transmission count
-  std::map <uint16_t, UlHarqProcessesStatus_t> m_ulHarqProcessesStatus; ///< UL HARQ process status
-  std::map <uint16_t, UlHarqProcessesDciBuffer_t> m_ulHarqProcessesDciBuffer; ///< UL HARQ process DCI buffer
-
 
   // RACH attributes
   std::vector <struct RachListElement_s> m_rachList; ///< RACH list
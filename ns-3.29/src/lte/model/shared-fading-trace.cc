@@ -0,0 +1,198 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/shared-fading-trace.h>
+#include <ns3/log.h>
+#include <ns3/fatal-error.h>
+#include <fstream>
+#include <cstring>
+#include <map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SharedFadingTrace");
+
+const char SharedFadingTrace::BINARY_MAGIC[8] = { 'N', 'S', '3', 'F', 'A', 'D', 'E', '1' };
+
+/// Header of binary fading trace files, followed by the samples
+struct BinaryFadingTraceHeader
+{
+  char magic[8]; ///< SharedFadingTrace::BINARY_MAGIC
+  uint32_t rbNum; ///< number of RBs
+  uint32_t samplesNum; ///< number of samples per RB
+};
+
+/// Key of the traces loaded so far: file name, number of RBs, number of samples
+typedef std::pair<std::string, std::pair<uint32_t, uint32_t> > SharedFadingTraceKey_t;
+
+/**
+ * \return the traces loaded so far
+ */
+static std::map<SharedFadingTraceKey_t, Ptr<const SharedFadingTrace> > &
+GetSharedFadingTraces ()
+{
+  static std::map<SharedFadingTraceKey_t, Ptr<const SharedFadingTrace> > traces;
+  return traces;
+}
+
+
+SharedFadingTrace::SharedFadingTrace (uint32_t rbNum, uint32_t samplesNum)
+  : m_rbNum (rbNum),
+    m_samplesNum (samplesNum),
+    m_data (0),
+    m_mapAddress (0),
+    m_mapLength (0)
+{
+  NS_LOG_FUNCTION (this << rbNum << samplesNum);
+}
+
+SharedFadingTrace::~SharedFadingTrace ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_mapAddress != 0)
+    {
+      munmap (m_mapAddress, m_mapLength);
+    }
+}
+
+Ptr<const SharedFadingTrace>
+SharedFadingTrace::Get (std::string fileName, uint8_t rbNum, uint32_t samplesNum)
+{
+  NS_LOG_FUNCTION (fileName << (uint16_t) rbNum << samplesNum);
+  SharedFadingTraceKey_t key (fileName, std::make_pair (rbNum, samplesNum));
+  std::map<SharedFadingTraceKey_t, Ptr<const SharedFadingTrace> >::iterator it = GetSharedFadingTraces ().find (key);
+  if (it != GetSharedFadingTraces ().end ())
+    {
+      NS_LOG_LOGIC ("fading trace " << fileName << " already loaded");
+      return it->second;
+    }
+
+  Ptr<SharedFadingTrace> trace (new SharedFadingTrace (rbNum, samplesNum), false);
+  if (!trace->Map (fileName))
+    {
+      trace->LoadAscii (fileName);
+    }
+  GetSharedFadingTraces ().insert (std::make_pair (key, trace));
+  return trace;
+}
+
+bool
+SharedFadingTrace::Map (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  int fd = open (fileName.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      NS_FATAL_ERROR ("Fading trace file " << fileName << " not found");
+    }
+  BinaryFadingTraceHeader header;
+  ssize_t n = read (fd, &header, sizeof (header));
+  if (n != sizeof (header) || std::memcmp (header.magic, BINARY_MAGIC, sizeof (BINARY_MAGIC)) != 0)
+    {
+      // not a binary trace
+      close (fd);
+      return false;
+    }
+  if (header.rbNum != m_rbNum || header.samplesNum != m_samplesNum)
+    {
+      NS_FATAL_ERROR ("Fading trace file " << fileName << " holds " << header.rbNum << " RBs x "
+                      << header.samplesNum << " samples, while " << m_rbNum << " RBs x "
+                      << m_samplesNum << " samples are expected");
+    }
+  size_t length = sizeof (header) + sizeof (double) * m_rbNum * m_samplesNum;
+  struct stat st;
+  if (fstat (fd, &st) != 0 || static_cast<size_t> (st.st_size) < length)
+    {
+      NS_FATAL_ERROR ("Fading trace file " << fileName << " is truncated");
+    }
+  void* address = mmap (0, length, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  if (address == MAP_FAILED)
+    {
+      NS_FATAL_ERROR ("Unable to map fading trace file " << fileName);
+    }
+  m_mapAddress = address;
+  m_mapLength = length;
+  m_data = reinterpret_cast<const double*> (static_cast<const char*> (address) + sizeof (header));
+  NS_LOG_LOGIC (this << " mapped binary fading trace " << fileName);
+  return true;
+}
+
+void
+SharedFadingTrace::LoadAscii (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  std::ifstream ifTraceFile;
+  ifTraceFile.open (fileName.c_str (), std::ifstream::in);
+  if (!ifTraceFile.good ())
+    {
+      NS_FATAL_ERROR ("Fading trace file " << fileName << " not found");
+    }
+  m_asciiData.resize (m_rbNum * m_samplesNum);
+  for (uint32_t i = 0; i < m_rbNum * m_samplesNum; i++)
+    {
+      ifTraceFile >> m_asciiData[i];
+    }
+  m_data = m_asciiData.data ();
+}
+
+void
+SharedFadingTrace::ConvertToBinary (std::string asciiFileName, std::string binaryFileName, uint8_t rbNum, uint32_t samplesNum)
+{
+  NS_LOG_FUNCTION (asciiFileName << binaryFileName << (uint16_t) rbNum << samplesNum);
+  SharedFadingTrace trace (rbNum, samplesNum);
+  trace.LoadAscii (asciiFileName);
+
+  BinaryFadingTraceHeader header;
+  std::memcpy (header.magic, BINARY_MAGIC, sizeof (BINARY_MAGIC));
+  header.rbNum = rbNum;
+  header.samplesNum = samplesNum;
+  std::ofstream ofTraceFile (binaryFileName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!ofTraceFile.good ())
+    {
+      NS_FATAL_ERROR ("Unable to create fading trace file " << binaryFileName);
+    }
+  ofTraceFile.write (reinterpret_cast<const char*> (&header), sizeof (header));
+  ofTraceFile.write (reinterpret_cast<const char*> (trace.m_data), sizeof (double) * rbNum * samplesNum);
+  if (!ofTraceFile.good ())
+    {
+      NS_FATAL_ERROR ("Error writing fading trace file " << binaryFileName);
+    }
+}
+
+uint32_t
+SharedFadingTrace::GetRbNum (void) const
+{
+  return m_rbNum;
+}
+
+uint32_t
+SharedFadingTrace::GetSamplesNum (void) const
+{
+  return m_samplesNum;
+}
+
+bool
+SharedFadingTrace::IsMapped (void) const
+{
+  return m_mapAddress != 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,143 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SHARED_FADING_TRACE_H
+#define SHARED_FADING_TRACE_H
+
+#include <ns3/simple-ref-count.h>
+#include <ns3/ptr.h>
+#include <ns3/assert.h>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief read-only fading trace shared by all the TraceFadingLossModel instances
+ *
+ * A fading trace is a matrix of fading values (dB), with one row per RB
+ * and one column per time sample. Each trace file is loaded only once
+ * per process, and the same instance is returned to all the models
+ * using it.
+ *
+ * Two file formats are supported:
+ *  - the ASCII format generated by fading_trace_generator.m, which is
+ *    parsed into memory;
+ *  - a binary format, made of a header followed by the samples stored
+ *    as native doubles one RB after the other, which is memory-mapped.
+ *    Since the mapping is read-only and backed by the file, its pages
+ *    are shared among all the processes using the same trace, and no
+ *    parsing is needed at startup.
+ *
+ * Binary traces can be obtained from ASCII ones with ConvertToBinary,
+ * e.g., by means of the lena-fading-trace-converter program.
+ */
+class SharedFadingTrace : public SimpleRefCount<SharedFadingTrace>
+{
+public:
+  ~SharedFadingTrace ();
+
+  /**
+   * Get the fading trace stored in a file, loading it if this is the
+   * first request for it. The format of the file is detected
+   * automatically.
+   *
+   * \param fileName the name of the trace file
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB of the trace
+   * \return the shared trace
+   */
+  static Ptr<const SharedFadingTrace> Get (std::string fileName, uint8_t rbNum, uint32_t samplesNum);
+
+  /**
+   * Convert an ASCII fading trace to the binary format
+   *
+   * \param asciiFileName the name of the ASCII trace file
+   * \param binaryFileName the name of the binary trace file to be written
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB of the trace
+   */
+  static void ConvertToBinary (std::string asciiFileName, std::string binaryFileName, uint8_t rbNum, uint32_t samplesNum);
+
+  /**
+   * \param rb the RB index
+   * \param sample the sample index
+   * \return the fading value (dB)
+   */
+  double GetValue (uint32_t rb, uint32_t sample) const
+  {
+    NS_ASSERT (rb < m_rbNum && sample < m_samplesNum);
+    return m_data[rb * m_samplesNum + sample];
+  }
+
+  /// \return the number of RBs of the trace
+  uint32_t GetRbNum (void) const;
+  /// \return the number of samples per RB of the trace
+  uint32_t GetSamplesNum (void) const;
+  /// \return true if the trace is memory-mapped from a binary file
+  bool IsMapped (void) const;
+
+  /// Signature written at the beginning of binary fading trace files
+  static const char BINARY_MAGIC[8];
+
+private:
+  /**
+   * Build an empty trace; use Get to obtain instances
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB of the trace
+   */
+  SharedFadingTrace (uint32_t rbNum, uint32_t samplesNum);
+
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  SharedFadingTrace (const SharedFadingTrace &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  SharedFadingTrace & operator = (const SharedFadingTrace &);
+
+  /**
+   * Parse an ASCII trace file
+   * \param fileName the name of the trace file
+   */
+  void LoadAscii (std::string fileName);
+
+  /**
+   * Map a binary trace file
+   * \param fileName the name of the trace file
+   * \return false if the file is not a binary trace
+   */
+  bool Map (std::string fileName);
+
+  uint32_t m_rbNum; ///< number of RBs
+  uint32_t m_samplesNum; ///< number of samples per RB
+  const double* m_data; ///< the samples, one RB after the other
+  std::vector<double> m_asciiData; ///< storage of the samples of ASCII traces
+  void* m_mapAddress; ///< address of the mapping of binary traces
+  size_t m_mapLength; ///< length of the mapping of binary traces
+};
+
+} // namespace ns3
+
+#endif /* SHARED_FADING_TRACE_H */
@@ -26,6 +26,7 @@
 
 #include <ns3/object.h>
 #include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/shared-fading-trace.h>
 #include <map>
 #include "ns3/random-variable-stream.h"
 #include <ns3/nstime.h>
@@ -112,20 +113,9 @@ private:
   
   mutable std::map <ChannelRealizationId_t, Ptr<UniformRandomVariable> > m_startVariableMap; ///< start variable map
   
-  /**
-   * Vector with fading samples in time domain (for a fixed RB)
-   */
-  typedef std::vector<double> FadingTraceSample;
-  /**
-   * Vector collecting the time fading traces in the frequency domain (per RB)
-   */
-  typedef std::vector<FadingTraceSample> FadingTrace;
-
-
-  
   std::string m_traceFile; ///< the trace file name
   
-  FadingTrace m_fadingTrace; ///< fading trace
+  Ptr<const SharedFadingTrace> m_fadingTrace; ///< fading trace, shared with the other instances using the same file
 
   
   Time m_traceLength; ///< the trace time
@@ -0,0 +1,158 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/lte-amc.h"
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestAmcCqi");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking that the CQIs of the PiroEW2010 AMC model,
+ * which are found by comparing the SINR of each RB with SINR
+ * thresholds, are the CQIs of the spectral efficiency of each RB.
+ */
+class LteAmcCqiTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param ber the requested BER
+   */
+  LteAmcCqiTestCase (double ber);
+  virtual ~LteAmcCqiTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  double m_ber; ///< the requested BER
+};
+
+LteAmcCqiTestCase::LteAmcCqiTestCase (double ber)
+  : TestCase ("CQI of the PiroEW2010 AMC model, BER = " + std::to_string (ber)),
+    m_ber (ber)
+{
+}
+
+LteAmcCqiTestCase::~LteAmcCqiTestCase ()
+{
+}
+
+void
+LteAmcCqiTestCase::DoRun (void)
+{
+  Ptr<LteAmc> amc = CreateObject<LteAmc> ();
+  amc->SetAttribute ("AmcModel", EnumValue (LteAmc::PiroEW2010));
+  std::vector<double> twoFreqs;
+  twoFreqs.push_back (0);
+  twoFreqs.push_back (1);
+  SpectrumValue two (Create<SpectrumModel> (twoFreqs));
+  two = 1.0;
+  amc->CreateCqiFeedbacks (two);
+  // the SINR thresholds must follow the changes of BER
+  amc->SetAttribute ("Ber", DoubleValue (m_ber));
+  double gamma = (-std::log (5.0 * m_ber)) / 1.5;
+
+  // SINRs on both sides of the thresholds of the CQIs, and random SINRs
+  std::vector<double> sinrs;
+  for (int cqi = 1; cqi <= 15; ++cqi)
+    {
+      double threshold = gamma * (std::pow (2.0, amc->GetSpectralEfficiencyFromCqi (cqi)) - 1.0);
+      sinrs.push_back (threshold);
+      double below = threshold;
+      double above = threshold;
+      for (int i = 0; i < 4; ++i)
+        {
+          below = std::nextafter (below, 0.0);
+          above = std::nextafter (above, 1e300);
+          sinrs.push_back (below);
+          sinrs.push_back (above);
+        }
+      sinrs.push_back (threshold * (1 - 1e-12));
+      sinrs.push_back (threshold * (1 + 1e-12));
+    }
+  Ptr<UniformRandomVariable> sinrDb = CreateObject<UniformRandomVariable> ();
+  sinrDb->SetStream (1);
+  for (int i = 0; i < 1000; ++i)
+    {
+      sinrs.push_back (std::pow (10.0, sinrDb->GetValue (-30, 40) / 10));
+    }
+  sinrs.push_back (0.0);
+  sinrs.push_back (1e-300);
+  sinrs.push_back (1e300);
+
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < sinrs.size (); ++i)
+    {
+      freqs.push_back (i);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (freqs);
+  SpectrumValue sinr (model);
+  for (uint32_t i = 0; i < sinrs.size (); ++i)
+    {
+      sinr[i] = sinrs.at (i);
+    }
+
+  std::vector<int> cqis = amc->CreateCqiFeedbacks (sinr);
+  NS_TEST_ASSERT_MSG_EQ (cqis.size (), sinrs.size (), "wrong number of CQIs");
+  for (uint32_t i = 0; i < sinrs.size (); ++i)
+    {
+      int expected = -1;
+      if (sinrs.at (i) != 0.0)
+        {
+          double s = log2 ( 1 + ( sinrs.at (i) / gamma ));
+          expected = 0;
+          while ((expected < 15) && (amc->GetSpectralEfficiencyFromCqi (expected + 1) < s))
+            {
+              ++expected;
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ (cqis.at (i), expected, "wrong CQI for SINR " << sinrs.at (i));
+    }
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the CQIs of the PiroEW2010 AMC model
+ */
+class LteAmcCqiTestSuite : public TestSuite
+{
+public:
+  LteAmcCqiTestSuite ();
+};
+
+LteAmcCqiTestSuite::LteAmcCqiTestSuite ()
+  : TestSuite ("lte-amc-cqi", UNIT)
+{
+  AddTestCase (new LteAmcCqiTestCase (0.00005), TestCase::QUICK);
+  AddTestCase (new LteAmcCqiTestCase (0.001), TestCase::QUICK);
+}
+
+static LteAmcCqiTestSuite lteAmcCqiTestSuite; ///< the test suite
@@ -0,0 +1,277 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/lte-mi-error-model.h"
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestMiErrorModel");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking the consistency of the lookups of the MIESM
+ * error model: the MI of a TB only depends on the modulation of its
+ * MCS, evaluating a TB from its MI gives the same result as evaluating
+ * it from the SINRs, with and without HARQ history, and the BLER does
+ * not increase with the SINR.
+ */
+class LteMiErrorModelTestCase : public TestCase
+{
+public:
+  LteMiErrorModelTestCase ();
+  virtual ~LteMiErrorModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteMiErrorModelTestCase::LteMiErrorModelTestCase ()
+  : TestCase ("Consistency of the MIESM lookups")
+{
+}
+
+LteMiErrorModelTestCase::~LteMiErrorModelTestCase ()
+{
+}
+
+void
+LteMiErrorModelTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < 25; ++i)
+    {
+      freqs.push_back (i);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (freqs);
+  std::vector<int> map;
+  for (int i = 0; i < 25; i += 2)
+    {
+      map.push_back (i);
+    }
+  const uint16_t sizes[] = {10, 100, 800, 3000};
+  HarqProcessInfoList_t noHistory;
+
+  for (uint16_t s = 0; s < 4; ++s)
+    {
+      uint16_t size = sizes[s];
+      for (uint8_t mcs = 0; mcs <= MI_64QAM_MAX_ID; ++mcs)
+        {
+          double previousTbler = 1.0;
+          for (double sinrDb = -10.0; sinrDb <= 30.0; sinrDb += 0.5)
+            {
+              SpectrumValue sinr (model);
+              for (uint32_t i = 0; i < 25; ++i)
+                {
+                  // ripple of +/- 2 dB around the mean SINR
+                  sinr[i] = std::pow (10.0, (sinrDb + 2.0 * std::sin (i)) / 10);
+                }
+              double mi = LteMiErrorModel::Mib (sinr, map, mcs);
+              uint8_t firstMcs = mcs <= MI_QPSK_MAX_ID ? 0 : (mcs <= MI_16QAM_MAX_ID ? MI_QPSK_MAX_ID + 1 : MI_16QAM_MAX_ID + 1);
+              NS_TEST_ASSERT_MSG_EQ (mi, LteMiErrorModel::Mib (sinr, map, firstMcs), "MI depends on more than the modulation");
+
+              TbStats_t stats = LteMiErrorModel::GetTbDecodificationStats (sinr, map, size, mcs, noHistory);
+              TbStats_t statsFromMi = LteMiErrorModel::GetTbDecodificationStats (mi, size, mcs, noHistory);
+              NS_TEST_ASSERT_MSG_EQ (stats.tbler, statsFromMi.tbler, "different TBLER from the MI");
+              NS_TEST_ASSERT_MSG_EQ (stats.mi, mi, "wrong MI");
+              NS_TEST_ASSERT_MSG_EQ_TOL (stats.tbler, 0.5, 0.5, "TBLER out of range");
+              NS_TEST_ASSERT_MSG_LT_OR_EQ (stats.tbler, previousTbler + 1e-12, "TBLER increasing with the SINR, MCS " << (uint16_t) mcs << " SINR " << sinrDb);
+              previousTbler = stats.tbler;
+
+              // combining with a previous transmission of the same TB
+              HarqProcessInfoElement_t el;
+              el.m_mi = mi;
+              el.m_rv = 0;
+              el.m_infoBits = size * 8;
+              el.m_codeBits = size * 8 / 0.5;
+              HarqProcessInfoList_t history (1, el);
+              TbStats_t retx = LteMiErrorModel::GetTbDecodificationStats (sinr, map, size, mcs, history);
+              TbStats_t retxFromMi = LteMiErrorModel::GetTbDecodificationStats (mi, size, mcs, history);
+              NS_TEST_ASSERT_MSG_EQ (retx.mi, mi, "wrong MI of the retransmission");
+              NS_TEST_ASSERT_MSG_EQ (retx.tbler, retxFromMi.tbler, "different TBLER of the retransmission from the MI");
+              NS_TEST_ASSERT_MSG_EQ_TOL (retx.tbler, 0.5, 0.5, "TBLER of the retransmission out of range");
+            }
+        }
+    }
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking the BLER of a CB, the TBLER of a TB, with and
+ * without HARQ history, and the PCFICH+PDCCH error rate against the
+ * values given by the implementation of the MIESM error model which
+ * preceded its lookup tables.
+ */
+class LteMiErrorModelReferenceTestCase : public TestCase
+{
+public:
+  LteMiErrorModelReferenceTestCase ();
+  virtual ~LteMiErrorModelReferenceTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteMiErrorModelReferenceTestCase::LteMiErrorModelReferenceTestCase ()
+  : TestCase ("MIESM error model against reference values")
+{
+}
+
+LteMiErrorModelReferenceTestCase::~LteMiErrorModelReferenceTestCase ()
+{
+}
+
+void
+LteMiErrorModelReferenceTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < 25; ++i)
+    {
+      freqs.push_back (i);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (freqs);
+  std::vector<int> map;
+  for (int i = 0; i < 25; i += 2)
+    {
+      map.push_back (i);
+    }
+
+  /// BLER of a CB
+  struct BlerPoint
+  {
+    double mib;       ///< MI per bit
+    uint8_t ecrId;    ///< ECR ID
+    uint16_t cbSize;  ///< CB size (bits)
+    double bler;      ///< reference BLER
+  };
+  const BlerPoint blerPoints[] = {
+    {0.5, 20, 1000, 0.9907618552752897},
+    {0.6, 12, 40, 0.6092624574490346},
+    {0.6, 12, 3000, 0.223719976970847},
+    {0.6, 12, 6144, 0.06025558842350859},
+    {0.6, 20, 500, 0.029961758602091826}
+  };
+  for (uint32_t k = 0; k < sizeof (blerPoints) / sizeof (blerPoints[0]); ++k)
+    {
+      const BlerPoint &p = blerPoints[k];
+      NS_TEST_EXPECT_MSG_EQ_TOL (LteMiErrorModel::MappingMiBler (p.mib, p.ecrId, p.cbSize), p.bler, 1e-12,
+                                 "wrong BLER, MI " << p.mib << " ECR " << (uint16_t) p.ecrId << " CB size " << p.cbSize);
+    }
+
+  /// TBLER of a TB, with the SINR rippling by +/- 2 dB around its mean
+  struct TbPoint
+  {
+    uint8_t mcs;       ///< MCS
+    uint16_t size;     ///< TB size (bytes)
+    double sinrDb;     ///< mean SINR (dB)
+    double mi;         ///< reference MI of the TB
+    double tbler;      ///< reference TBLER of the first transmission
+    double retxTbler;  ///< reference TBLER combined with a previous transmission
+  };
+  const TbPoint tbPoints[] = {
+    {2, 20, -7.0, 0.13638115384615387, 0.9859898576861665, 0.47402139829691303},
+    {2, 300, -6.0, 0.16715130769230768, 0.33372337207979585, 1.0963452368173421e-13},
+    {2, 3000, -6.0, 0.16715130769230768, 0.23084031933394356, 0.0},
+    {9, 20, -2.0, 0.3540210769230769, 1.0, 0.4065599724909139},
+    {9, 300, 2.0, 0.6379364615384614, 0.017739372214672144, 0.0},
+    {13, 20, 5.0, 0.46900138461538465, 0.8873790759056408, 0.0},
+    {17, 3000, 10.0, 0.5161066923076923, 0.19133518789476067, 0.0},
+    {22, 20, 14.0, 0.7020576153846154, 0.5597718189680486, 0.0},
+    {22, 3000, 14.0, 0.7020576153846154, 0.8006652565432706, 0.0},
+    {28, 20, 5.0, 0.30001830769230764, 1.0, 0.19516749440600956},
+    {28, 300, 20.0, 0.9444270769230769, 0.1879331425943423, 0.0}
+  };
+  for (uint32_t k = 0; k < sizeof (tbPoints) / sizeof (tbPoints[0]); ++k)
+    {
+      const TbPoint &p = tbPoints[k];
+      SpectrumValue sinr (model);
+      for (uint32_t i = 0; i < 25; ++i)
+        {
+          sinr[i] = std::pow (10.0, (p.sinrDb + 2.0 * std::sin (i)) / 10);
+        }
+      HarqProcessInfoList_t noHistory;
+      TbStats_t stats = LteMiErrorModel::GetTbDecodificationStats (sinr, map, p.size, p.mcs, noHistory);
+      NS_TEST_EXPECT_MSG_EQ_TOL (stats.mi, p.mi, 1e-12, "wrong MI, MCS " << (uint16_t) p.mcs << " SINR " << p.sinrDb);
+      NS_TEST_EXPECT_MSG_EQ_TOL (stats.tbler, p.tbler, 1e-12,
+                                 "wrong TBLER, MCS " << (uint16_t) p.mcs << " size " << p.size << " SINR " << p.sinrDb);
+
+      HarqProcessInfoElement_t el;
+      el.m_mi = stats.mi;
+      el.m_rv = 0;
+      el.m_infoBits = p.size * 8;
+      el.m_codeBits = p.size * 8 / 0.5;
+      HarqProcessInfoList_t history (1, el);
+      TbStats_t retx = LteMiErrorModel::GetTbDecodificationStats (sinr, map, p.size, p.mcs, history);
+      NS_TEST_EXPECT_MSG_EQ_TOL (retx.tbler, p.retxTbler, 1e-12,
+                                 "wrong TBLER of the retransmission, MCS " << (uint16_t) p.mcs << " size " << p.size << " SINR " << p.sinrDb);
+    }
+
+  /// PCFICH+PDCCH error rate, with the SINR rippling by +/- 2 dB around its mean
+  struct PdcchPoint
+  {
+    double sinrDb;  ///< mean SINR (dB)
+    double error;   ///< reference error rate
+  };
+  const PdcchPoint pdcchPoints[] = {
+    {-10.0, 0.82334},
+    {-8.0, 0.440869},
+    {-6.0, 0.159787},
+    {-4.0, 0.0310472},
+    {-2.0, 0.00532283},
+    {0.0, 0.0}
+  };
+  for (uint32_t k = 0; k < sizeof (pdcchPoints) / sizeof (pdcchPoints[0]); ++k)
+    {
+      const PdcchPoint &p = pdcchPoints[k];
+      SpectrumValue sinr (model);
+      for (uint32_t i = 0; i < 25; ++i)
+        {
+          sinr[i] = std::pow (10.0, (p.sinrDb + 2.0 * std::sin (i)) / 10);
+        }
+      NS_TEST_EXPECT_MSG_EQ_TOL (LteMiErrorModel::GetPcfichPdcchError (sinr), p.error, 1e-12,
+                                 "wrong PCFICH+PDCCH error rate at SINR " << p.sinrDb);
+    }
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the MIESM error model lookups
+ */
+class LteMiErrorModelTestSuite : public TestSuite
+{
+public:
+  LteMiErrorModelTestSuite ();
+};
+
+LteMiErrorModelTestSuite::LteMiErrorModelTestSuite ()
+  : TestSuite ("lte-mi-error-model", UNIT)
+{
+  AddTestCase (new LteMiErrorModelTestCase (), TestCase::QUICK);
+  AddTestCase (new LteMiErrorModelReferenceTestCase (), TestCase::QUICK);
+}
+
+static LteMiErrorModelTestSuite lteMiErrorModelTestSuite; ///< the test suite
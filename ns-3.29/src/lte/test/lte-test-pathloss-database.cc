@@ -0,0 +1,209 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/config.h>
+#include <ns3/boolean.h>
+#include <ns3/string.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/mobility-model.h>
+#include <ns3/position-allocator.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/spectrum-channel.h>
+#include <ns3/eps-bearer.h>
+#include <ns3/lte-helper.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-ue-net-device.h>
+#include <ns3/lte-global-pathloss-database.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestPathlossDatabase");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking the pathloss matrix computed by
+ * LteGlobalPathlossDatabase: its values, its binary file, and its use
+ * as the pathloss model of the LTE spectrum channels, by comparing the
+ * pathloss reported by the channels with the matrix.
+ */
+class LtePathlossDatabaseTestCase : public TestCase
+{
+public:
+  LtePathlossDatabaseTestCase ();
+  virtual ~LtePathlossDatabaseTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Check that two databases hold the same pathloss values.
+   *
+   * \param expected the expected database
+   * \param actual the database to check
+   * \param enbDevs the eNB devices
+   * \param ueDevs the UE devices
+   * \param what a description of the check
+   */
+  void CheckPathloss (LteGlobalPathlossDatabase &expected, LteGlobalPathlossDatabase &actual,
+                      NetDeviceContainer enbDevs, NetDeviceContainer ueDevs, std::string what);
+};
+
+LtePathlossDatabaseTestCase::LtePathlossDatabaseTestCase ()
+  : TestCase ("Precomputed pathloss matrix")
+{
+}
+
+LtePathlossDatabaseTestCase::~LtePathlossDatabaseTestCase ()
+{
+}
+
+void
+LtePathlossDatabaseTestCase::CheckPathloss (LteGlobalPathlossDatabase &expected, LteGlobalPathlossDatabase &actual,
+                                            NetDeviceContainer enbDevs, NetDeviceContainer ueDevs, std::string what)
+{
+  for (uint32_t i = 0; i < enbDevs.GetN (); ++i)
+    {
+      uint16_t cellId = enbDevs.Get (i)->GetObject<LteEnbNetDevice> ()->GetCellId ();
+      for (uint32_t j = 0; j < ueDevs.GetN (); ++j)
+        {
+          uint64_t imsi = ueDevs.Get (j)->GetObject<LteUeNetDevice> ()->GetImsi ();
+          NS_TEST_ASSERT_MSG_EQ_TOL (actual.GetPathloss (cellId, imsi), expected.GetPathloss (cellId, imsi), 1e-9,
+                                     "wrong " << what << " pathloss for cell " << cellId << " and IMSI " << imsi);
+        }
+    }
+}
+
+void
+LtePathlossDatabaseTestCase::DoRun (void)
+{
+  Config::Reset ();
+  Config::SetDefault ("ns3::LteHelper::UseIdealRrc", BooleanValue (true));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::MatrixPropagationLossModel"));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  NodeContainer ueNodes;
+  ueNodes.Create (3);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 30.0));
+  positionAlloc->Add (Vector (500.0, 0.0, 30.0));
+  positionAlloc->Add (Vector (50.0, 20.0, 1.5));
+  positionAlloc->Add (Vector (250.0, -30.0, 1.5));
+  positionAlloc->Add (Vector (400.0, 40.0, 1.5));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->Attach (ueDevs.Get (0), enbDevs.Get (0));
+  lteHelper->Attach (ueDevs.Get (1), enbDevs.Get (0));
+  lteHelper->Attach (ueDevs.Get (2), enbDevs.Get (1));
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+
+  // compute the matrices with another model
+  Ptr<PropagationLossModel> model = CreateObject<FriisPropagationLossModel> ();
+  DownlinkLteGlobalPathlossDatabase dlComputed;
+  UplinkLteGlobalPathlossDatabase ulComputed;
+  dlComputed.Compute (enbDevs, ueDevs, model);
+  ulComputed.Compute (enbDevs, ueDevs, model);
+  for (uint32_t i = 0; i < enbDevs.GetN (); ++i)
+    {
+      Ptr<MobilityModel> enbMobility = enbNodes.Get (i)->GetObject<MobilityModel> ();
+      uint16_t cellId = enbDevs.Get (i)->GetObject<LteEnbNetDevice> ()->GetCellId ();
+      for (uint32_t j = 0; j < ueDevs.GetN (); ++j)
+        {
+          Ptr<MobilityModel> ueMobility = ueNodes.Get (j)->GetObject<MobilityModel> ();
+          uint64_t imsi = ueDevs.Get (j)->GetObject<LteUeNetDevice> ()->GetImsi ();
+          NS_TEST_ASSERT_MSG_EQ_TOL (dlComputed.GetPathloss (cellId, imsi), -model->CalcRxPower (0.0, enbMobility, ueMobility), 1e-9,
+                                     "wrong computed DL pathloss for cell " << cellId << " and IMSI " << imsi);
+          NS_TEST_ASSERT_MSG_EQ_TOL (ulComputed.GetPathloss (cellId, imsi), -model->CalcRxPower (0.0, ueMobility, enbMobility), 1e-9,
+                                     "wrong computed UL pathloss for cell " << cellId << " and IMSI " << imsi);
+        }
+    }
+
+  // save and load them
+  std::string dlFilename = CreateTempDirFilename ("dl-pathloss.bin");
+  std::string ulFilename = CreateTempDirFilename ("ul-pathloss.bin");
+  NS_TEST_ASSERT_MSG_EQ (dlComputed.Save (dlFilename), true, "can't save " << dlFilename);
+  NS_TEST_ASSERT_MSG_EQ (ulComputed.Save (ulFilename), true, "can't save " << ulFilename);
+  DownlinkLteGlobalPathlossDatabase dlLoaded;
+  UplinkLteGlobalPathlossDatabase ulLoaded;
+  NS_TEST_ASSERT_MSG_EQ (ulLoaded.Load (dlFilename), false, "DL pathloss loaded as UL pathloss");
+  NS_TEST_ASSERT_MSG_EQ (dlLoaded.Load (dlFilename), true, "can't load " << dlFilename);
+  NS_TEST_ASSERT_MSG_EQ (ulLoaded.Load (ulFilename), true, "can't load " << ulFilename);
+  CheckPathloss (dlComputed, dlLoaded, enbDevs, ueDevs, "loaded DL");
+  CheckPathloss (ulComputed, ulLoaded, enbDevs, ueDevs, "loaded UL");
+
+  // use them as the pathloss of the channels
+  Ptr<MatrixPropagationLossModel> dlModel =
+    DynamicCast<MatrixPropagationLossModel> (lteHelper->GetDownlinkSpectrumChannel ()->GetPropagationLossModel ());
+  Ptr<MatrixPropagationLossModel> ulModel =
+    DynamicCast<MatrixPropagationLossModel> (lteHelper->GetUplinkSpectrumChannel ()->GetPropagationLossModel ());
+  NS_TEST_ASSERT_MSG_NE (dlModel, 0, "the DL pathloss model is not a MatrixPropagationLossModel");
+  NS_TEST_ASSERT_MSG_NE (ulModel, 0, "the UL pathloss model is not a MatrixPropagationLossModel");
+  dlLoaded.InstallPathloss (dlModel, enbDevs, ueDevs);
+  ulLoaded.InstallPathloss (ulModel, enbDevs, ueDevs);
+
+  // we rely on the fact that LteHelper creates the DL channel object first, then the UL channel object,
+  // hence the former will have index 0 and the latter 1
+  DownlinkLteGlobalPathlossDatabase dlMeasured;
+  UplinkLteGlobalPathlossDatabase ulMeasured;
+  Config::Connect ("/ChannelList/0/PathLoss",
+                   MakeCallback (&DownlinkLteGlobalPathlossDatabase::UpdatePathloss, &dlMeasured));
+  Config::Connect ("/ChannelList/1/PathLoss",
+                   MakeCallback (&UplinkLteGlobalPathlossDatabase::UpdatePathloss, &ulMeasured));
+
+  Simulator::Stop (MilliSeconds (200));
+  Simulator::Run ();
+
+  CheckPathloss (dlComputed, dlMeasured, enbDevs, ueDevs, "measured DL");
+  CheckPathloss (ulComputed, ulMeasured, enbDevs, ueDevs, "measured UL");
+
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the precomputed pathloss matrix
+ */
+class LtePathlossDatabaseTestSuite : public TestSuite
+{
+public:
+  LtePathlossDatabaseTestSuite ();
+};
+
+LtePathlossDatabaseTestSuite::LtePathlossDatabaseTestSuite ()
+  : TestSuite ("lte-pathloss-database", SYSTEM)
+{
+  AddTestCase (new LtePathlossDatabaseTestCase (), TestCase::QUICK);
+}
+
+static LtePathlossDatabaseTestSuite ltePathlossDatabaseTestSuite; ///< the test suite
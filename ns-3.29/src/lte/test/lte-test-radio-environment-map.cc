@@ -0,0 +1,188 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/integer.h"
+#include "ns3/string.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/radio-environment-map-helper.h"
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestRadioEnvironmentMap");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking that the direct computation of the Radio
+ * Environment Map gives the same map as the simulation of the
+ * reception of the control frames.
+ */
+class LteRemDirectComputationTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param numThreads the number of threads of the direct computation
+   * \param rbId the RB for which the map is computed, or -1
+   */
+  LteRemDirectComputationTestCase (uint32_t numThreads, int32_t rbId);
+  virtual ~LteRemDirectComputationTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Build the name of the test case
+   *
+   * \param numThreads the number of threads of the direct computation
+   * \param rbId the RB for which the map is computed, or -1
+   * \return the name of the test case
+   */
+  static std::string BuildNameString (uint32_t numThreads, int32_t rbId);
+
+  /**
+   * Simulate a two-cell scenario and generate its map
+   *
+   * \param fileName the output file of the map
+   * \param direct whether the map is computed directly
+   */
+  void GenerateRem (std::string fileName, bool direct);
+
+  uint32_t m_numThreads; ///< number of threads
+  int32_t m_rbId;        ///< RB of the map
+};
+
+std::string
+LteRemDirectComputationTestCase::BuildNameString (uint32_t numThreads, int32_t rbId)
+{
+  std::ostringstream oss;
+  oss << "direct REM computation, threads=" << numThreads << ", rbId=" << rbId;
+  return oss.str ();
+}
+
+LteRemDirectComputationTestCase::LteRemDirectComputationTestCase (uint32_t numThreads, int32_t rbId)
+  : TestCase (BuildNameString (numThreads, rbId)),
+    m_numThreads (numThreads),
+    m_rbId (rbId)
+{
+}
+
+LteRemDirectComputationTestCase::~LteRemDirectComputationTestCase ()
+{
+}
+
+void
+LteRemDirectComputationTestCase::GenerateRem (std::string fileName, bool direct)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetEnbAntennaModelType ("ns3::CosineAntennaModel");
+  lteHelper->SetEnbAntennaModelAttribute ("Orientation", DoubleValue (180));
+  lteHelper->SetEnbAntennaModelAttribute ("Beamwidth", DoubleValue (90));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0, 0, 30));
+  positionAlloc->Add (Vector (400, 100, 30));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  lteHelper->InstallEnbDevice (enbNodes);
+
+  Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper> ();
+  std::ostringstream channelPath;
+  channelPath << "/ChannelList/" << lteHelper->GetDownlinkSpectrumChannel ()->GetId ();
+  remHelper->SetAttribute ("ChannelPath", StringValue (channelPath.str ()));
+  remHelper->SetAttribute ("OutputFile", StringValue (fileName));
+  remHelper->SetAttribute ("XMin", DoubleValue (-200.0));
+  remHelper->SetAttribute ("XMax", DoubleValue (600.0));
+  remHelper->SetAttribute ("XRes", UintegerValue (23));
+  remHelper->SetAttribute ("YMin", DoubleValue (-300.0));
+  remHelper->SetAttribute ("YMax", DoubleValue (300.0));
+  remHelper->SetAttribute ("YRes", UintegerValue (17));
+  remHelper->SetAttribute ("Z", DoubleValue (1.5));
+  remHelper->SetAttribute ("MaxPointsPerIteration", UintegerValue (100));
+  remHelper->SetAttribute ("RbId", IntegerValue (m_rbId));
+  remHelper->SetAttribute ("UseDirectComputation", BooleanValue (direct));
+  remHelper->SetAttribute ("NumThreads", UintegerValue (m_numThreads));
+  remHelper->Install ();
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+LteRemDirectComputationTestCase::DoRun (void)
+{
+  std::string simulatedFileName = CreateTempDirFilename ("rem-simulated.out");
+  std::string directFileName = CreateTempDirFilename ("rem-direct.out");
+  GenerateRem (simulatedFileName, false);
+  GenerateRem (directFileName, true);
+
+  std::ifstream simulated (simulatedFileName.c_str ());
+  std::ifstream direct (directFileName.c_str ());
+  uint32_t nPoints = 0;
+  double x1, y1, z1, sinr1;
+  while (simulated >> x1 >> y1 >> z1 >> sinr1)
+    {
+      double x2, y2, z2, sinr2;
+      NS_TEST_ASSERT_MSG_EQ (bool (direct >> x2 >> y2 >> z2 >> sinr2), true, "missing point in the direct map");
+      NS_TEST_ASSERT_MSG_EQ (x2, x1, "wrong x coordinate");
+      NS_TEST_ASSERT_MSG_EQ (y2, y1, "wrong y coordinate");
+      NS_TEST_ASSERT_MSG_EQ (z2, z1, "wrong z coordinate");
+      NS_TEST_ASSERT_MSG_EQ_TOL (sinr2, sinr1, sinr1 * 1e-5, "wrong SINR at (" << x1 << ", " << y1 << ")");
+      ++nPoints;
+    }
+  NS_TEST_ASSERT_MSG_EQ (nPoints, 23 * 17, "wrong number of points in the simulated map");
+  NS_TEST_ASSERT_MSG_EQ (bool (direct >> x1), false, "extra points in the direct map");
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite for the Radio Environment Map.
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+public:
+  LteRadioEnvironmentMapTestSuite ();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite ()
+  : TestSuite ("lte-radio-environment-map", SYSTEM)
+{
+  AddTestCase (new LteRemDirectComputationTestCase (1, -1), TestCase::QUICK);
+  AddTestCase (new LteRemDirectComputationTestCase (4, -1), TestCase::QUICK);
+  AddTestCase (new LteRemDirectComputationTestCase (3, 7), TestCase::QUICK);
+}
+
+static LteRadioEnvironmentMapTestSuite lteRadioEnvironmentMapTestSuite;
@@ -0,0 +1,113 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/shared-fading-trace.h"
+#include <fstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestSharedFadingTrace");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking that ASCII and binary fading traces hold the
+ * same samples, and that each trace file is loaded only once.
+ */
+class LteSharedFadingTraceTestCase : public TestCase
+{
+public:
+  LteSharedFadingTraceTestCase ();
+  virtual ~LteSharedFadingTraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteSharedFadingTraceTestCase::LteSharedFadingTraceTestCase ()
+  : TestCase ("ASCII and binary fading traces")
+{
+}
+
+LteSharedFadingTraceTestCase::~LteSharedFadingTraceTestCase ()
+{
+}
+
+void
+LteSharedFadingTraceTestCase::DoRun (void)
+{
+  const uint8_t rbNum = 3;
+  const uint32_t samplesNum = 50;
+  std::string asciiFileName = CreateTempDirFilename ("fading-trace.fad");
+  std::string binaryFileName = CreateTempDirFilename ("fading-trace.bin");
+
+  // same layout as the output of fading_trace_generator.m: one row per RB
+  std::ofstream ofs (asciiFileName.c_str ());
+  for (uint32_t rb = 0; rb < rbNum; ++rb)
+    {
+      for (uint32_t sample = 0; sample < samplesNum; ++sample)
+        {
+          ofs << " " << -0.125 * rb - 0.0625 * sample + 1.5;
+        }
+      ofs << std::endl;
+    }
+  ofs.close ();
+
+  SharedFadingTrace::ConvertToBinary (asciiFileName, binaryFileName, rbNum, samplesNum);
+
+  Ptr<const SharedFadingTrace> ascii = SharedFadingTrace::Get (asciiFileName, rbNum, samplesNum);
+  Ptr<const SharedFadingTrace> binary = SharedFadingTrace::Get (binaryFileName, rbNum, samplesNum);
+  NS_TEST_ASSERT_MSG_EQ (ascii->IsMapped (), false, "ASCII trace should not be mapped");
+  NS_TEST_ASSERT_MSG_EQ (binary->IsMapped (), true, "binary trace should be mapped");
+  NS_TEST_ASSERT_MSG_EQ (binary->GetRbNum (), rbNum, "wrong number of RBs");
+  NS_TEST_ASSERT_MSG_EQ (binary->GetSamplesNum (), samplesNum, "wrong number of samples");
+  for (uint32_t rb = 0; rb < rbNum; ++rb)
+    {
+      for (uint32_t sample = 0; sample < samplesNum; ++sample)
+        {
+          double expected = -0.125 * rb - 0.0625 * sample + 1.5;
+          NS_TEST_ASSERT_MSG_EQ (ascii->GetValue (rb, sample), expected, "wrong ASCII sample");
+          NS_TEST_ASSERT_MSG_EQ (binary->GetValue (rb, sample), expected, "wrong binary sample");
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (SharedFadingTrace::Get (binaryFileName, rbNum, samplesNum), binary, "trace loaded twice");
+  NS_TEST_ASSERT_MSG_EQ (SharedFadingTrace::Get (asciiFileName, rbNum, samplesNum), ascii, "trace loaded twice");
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite for the fading traces shared by TraceFadingLossModel.
+ */
+class LteSharedFadingTraceTestSuite : public TestSuite
+{
+public:
+  LteSharedFadingTraceTestSuite ();
+};
+
+LteSharedFadingTraceTestSuite::LteSharedFadingTraceTestSuite ()
+  : TestSuite ("lte-shared-fading-trace", UNIT)
+{
+  AddTestCase (new LteSharedFadingTraceTestCase, TestCase::QUICK);
+}
+
+static LteSharedFadingTraceTestSuite lteSharedFadingTraceTestSuite;
@@ -0,0 +1,321 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/config.h>
+#include <ns3/boolean.h>
+#include <ns3/enum.h>
+#include <ns3/string.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/position-allocator.h>
+#include <ns3/eps-bearer.h>
+#include <ns3/lte-helper.h>
+#include <ns3/lte-stats-file.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestStatsFile");
+
+/**
+ * Read a text file.
+ *
+ * \param filename the name of the file
+ * \return the content of the file
+ */
+static std::string
+ReadTextFile (std::string filename)
+{
+  std::ifstream file (filename.c_str ());
+  std::ostringstream oss;
+  oss << file.rdbuf ();
+  return oss.str ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking that the buffered text and the converted
+ * binary formats of LteStatsFile give the text written record by
+ * record.
+ */
+class LteStatsFileFormatTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param nRecords the number of records to write
+   */
+  LteStatsFileFormatTestCase (uint32_t nRecords);
+  virtual ~LteStatsFileFormatTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Write the records to a file.
+   *
+   * \param filename the name of the file
+   * \param format the format of the file
+   */
+  void WriteRecords (std::string filename, LteStatsFile::Format format);
+
+  uint32_t m_nRecords; ///< the number of records to write
+};
+
+LteStatsFileFormatTestCase::LteStatsFileFormatTestCase (uint32_t nRecords)
+  : TestCase ("LteStatsFile formats, " + std::to_string (nRecords) + " records"),
+    m_nRecords (nRecords)
+{
+}
+
+LteStatsFileFormatTestCase::~LteStatsFileFormatTestCase ()
+{
+}
+
+void
+LteStatsFileFormatTestCase::WriteRecords (std::string filename, LteStatsFile::Format format)
+{
+  LteStatsFile file;
+  NS_TEST_ASSERT_MSG_EQ (file.Open (filename, format, "% time\tid\toffset\tvalues", "\t\n"), true,
+                         "can't open " << filename);
+  for (uint32_t i = 0; i < m_nRecords; ++i)
+    {
+      std::vector<double> values;
+      for (uint32_t j = 0; j < i % 5; ++j)
+        {
+          values.push_back ((i + 1) * 1.1e-13 * (j + 1));
+        }
+      file.WriteDouble (i / 1000.0);
+      file.WriteUinteger (i * 4294967311ULL);
+      file.WriteInteger (static_cast<int64_t> (i) - 100);
+      file.WriteDoubleList (values.begin (), values.end ());
+      file.EndRecord ();
+    }
+}
+
+void
+LteStatsFileFormatTestCase::DoRun (void)
+{
+  std::string text = CreateTempDirFilename ("stats-text.txt");
+  std::string bufferedText = CreateTempDirFilename ("stats-buffered-text.txt");
+  std::string binary = CreateTempDirFilename ("stats-binary.bin");
+  std::string converted = CreateTempDirFilename ("stats-converted.txt");
+
+  WriteRecords (text, LteStatsFile::TEXT);
+  WriteRecords (bufferedText, LteStatsFile::BUFFERED_TEXT);
+  WriteRecords (binary, LteStatsFile::BINARY);
+  NS_TEST_ASSERT_MSG_EQ (LteStatsFile::ConvertToText (binary, converted), true,
+                         "can't convert " << binary);
+
+  std::string expected = ReadTextFile (text);
+  NS_TEST_ASSERT_MSG_EQ ((expected.find ("% time") == 0), true, "missing header");
+  NS_TEST_ASSERT_MSG_EQ ((ReadTextFile (bufferedText) == expected), true, "wrong buffered text file");
+  NS_TEST_ASSERT_MSG_EQ ((ReadTextFile (converted) == expected), true, "wrong converted binary file");
+  NS_TEST_ASSERT_MSG_EQ (LteStatsFile::ConvertToText (text, converted), false,
+                         "text file converted as a binary one");
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking that the statistics calculators write the
+ * same statistics in all the output formats.
+ *
+ * The lines of the files are compared regardless of their order, since
+ * the order of the statistics of the UEs within a TTI is not the same
+ * in two simulations of the same process (see
+ * LteTtiSynchronousPhyTestCase).
+ */
+class LteStatsCalculatorOutputFormatTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param format the output format to check
+   */
+  LteStatsCalculatorOutputFormatTestCase (LteStatsFile::Format format);
+  virtual ~LteStatsCalculatorOutputFormatTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run the simulation writing the statistics.
+   *
+   * \param format the output format
+   * \param prefix the prefix of the names of the output files
+   */
+  void RunSimulation (LteStatsFile::Format format, std::string prefix);
+
+  /**
+   * Read a statistics file, converting it to text if needed.
+   *
+   * \param filename the name of the file
+   * \param format the output format
+   * \return the lines of the file, sorted
+   */
+  std::vector<std::string> ReadStatsFile (std::string filename, LteStatsFile::Format format);
+
+  LteStatsFile::Format m_format; ///< the output format to check
+};
+
+LteStatsCalculatorOutputFormatTestCase::LteStatsCalculatorOutputFormatTestCase (LteStatsFile::Format format)
+  : TestCase (std::string ("Statistics calculators, ") + (format == LteStatsFile::BINARY ? "binary" : "buffered text") + " format"),
+    m_format (format)
+{
+}
+
+LteStatsCalculatorOutputFormatTestCase::~LteStatsCalculatorOutputFormatTestCase ()
+{
+}
+
+/// the statistics files, as the calculator attributes setting their names
+static const char * const g_statsFileAttributes[] = {
+  "ns3::MacStatsCalculator::DlOutputFilename",
+  "ns3::MacStatsCalculator::UlOutputFilename",
+  "ns3::PhyStatsCalculator::DlRsrpSinrFilename",
+  "ns3::PhyStatsCalculator::UlSinrFilename",
+  "ns3::PhyStatsCalculator::UlInterferenceFilename",
+  "ns3::PhyTxStatsCalculator::DlTxOutputFilename",
+  "ns3::PhyTxStatsCalculator::UlTxOutputFilename",
+  "ns3::PhyRxStatsCalculator::DlRxOutputFilename",
+  "ns3::PhyRxStatsCalculator::UlRxOutputFilename",
+  "ns3::RadioBearerStatsCalculator::DlRlcOutputFilename",
+  "ns3::RadioBearerStatsCalculator::UlRlcOutputFilename"
+};
+
+void
+LteStatsCalculatorOutputFormatTestCase::RunSimulation (LteStatsFile::Format format, std::string prefix)
+{
+  Config::Reset ();
+  Config::SetDefault ("ns3::LteHelper::UseIdealRrc", BooleanValue (true));
+  Config::SetDefault ("ns3::LteStatsCalculator::OutputFormat", EnumValue (format));
+  for (uint32_t i = 0; i < sizeof (g_statsFileAttributes) / sizeof (g_statsFileAttributes[0]); ++i)
+    {
+      Config::SetDefault (g_statsFileAttributes[i],
+                          StringValue (CreateTempDirFilename (prefix + std::to_string (i) + ".txt")));
+    }
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  NodeContainer enbNodes;
+  enbNodes.Create (1);
+  NodeContainer ueNodes;
+  ueNodes.Create (2);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (20.0, 10.0, 0.0));
+  positionAlloc->Add (Vector (60.0, 10.0, 0.0));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->AssignStreams (enbDevs, 1);
+  lteHelper->AssignStreams (ueDevs, 1000);
+  lteHelper->Attach (ueDevs, enbDevs.Get (0));
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+  lteHelper->EnablePhyTraces ();
+  lteHelper->EnableMacTraces ();
+  lteHelper->EnableRlcTraces ();
+  lteHelper->GetRlcStats ()->SetAttribute ("EpochDuration", TimeValue (MilliSeconds (100)));
+
+  Simulator::Stop (MilliSeconds (350));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+std::vector<std::string>
+LteStatsCalculatorOutputFormatTestCase::ReadStatsFile (std::string filename, LteStatsFile::Format format)
+{
+  if (format == LteStatsFile::BINARY)
+    {
+      std::string converted = filename + ".converted";
+      NS_TEST_EXPECT_MSG_EQ (LteStatsFile::ConvertToText (filename, converted), true,
+                             "can't convert " << filename);
+      filename = converted;
+    }
+  std::vector<std::string> lines;
+  std::istringstream iss (ReadTextFile (filename));
+  std::string line;
+  while (std::getline (iss, line))
+    {
+      lines.push_back (line);
+    }
+  std::sort (lines.begin (), lines.end ());
+  return lines;
+}
+
+void
+LteStatsCalculatorOutputFormatTestCase::DoRun (void)
+{
+  RunSimulation (LteStatsFile::TEXT, "text-");
+  RunSimulation (m_format, "format-");
+  for (uint32_t i = 0; i < sizeof (g_statsFileAttributes) / sizeof (g_statsFileAttributes[0]); ++i)
+    {
+      std::vector<std::string> expected = ReadStatsFile (CreateTempDirFilename ("text-" + std::to_string (i) + ".txt"),
+                                                         LteStatsFile::TEXT);
+      std::vector<std::string> lines = ReadStatsFile (CreateTempDirFilename ("format-" + std::to_string (i) + ".txt"),
+                                                      m_format);
+      NS_TEST_ASSERT_MSG_GT (expected.size (), 1, "no statistics in " << g_statsFileAttributes[i]);
+      NS_TEST_ASSERT_MSG_EQ (lines.size (), expected.size (), "wrong number of lines in " << g_statsFileAttributes[i]);
+      for (uint32_t j = 0; j < expected.size (); ++j)
+        {
+          NS_TEST_ASSERT_MSG_EQ (lines.at (j), expected.at (j), "wrong line " << j << " in " << g_statsFileAttributes[i]);
+        }
+    }
+  Config::Reset ();
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the output formats of the statistics calculators
+ */
+class LteStatsFileTestSuite : public TestSuite
+{
+public:
+  LteStatsFileTestSuite ();
+};
+
+LteStatsFileTestSuite::LteStatsFileTestSuite ()
+  : TestSuite ("lte-stats-file", UNIT)
+{
+  AddTestCase (new LteStatsFileFormatTestCase (0), TestCase::QUICK);
+  AddTestCase (new LteStatsFileFormatTestCase (10000), TestCase::QUICK);
+  AddTestCase (new LteStatsCalculatorOutputFormatTestCase (LteStatsFile::BUFFERED_TEXT), TestCase::QUICK);
+  AddTestCase (new LteStatsCalculatorOutputFormatTestCase (LteStatsFile::BINARY), TestCase::QUICK);
+}
+
+static LteStatsFileTestSuite lteStatsFileTestSuite; ///< the test suite
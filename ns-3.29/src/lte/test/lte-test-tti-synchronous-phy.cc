@@ -0,0 +1,248 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/config.h>
+#include <ns3/boolean.h>
+#include <ns3/uinteger.h>
+#include <ns3/string.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/position-allocator.h>
+#include <ns3/eps-bearer.h>
+#include <ns3/lte-common.h>
+#include <ns3/lte-helper.h>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestTtiSynchronousPhy");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking that the DL and UL transmissions and
+ * receptions of the PHYs driven by a LteTtiClock, and the simulation
+ * contexts in which they happen, are those of the PHYs scheduling their
+ * own subframe and reception events.
+ *
+ * The transmissions are compared regardless of their order within each
+ * TTI: the UEs of a cell are visited by the MultiModelSpectrumChannel
+ * in the order of their addresses, which is not the same in two
+ * simulations of the same process, and whose DL control reception
+ * order then determines the order of their UL transmissions.
+ */
+class LteTtiSynchronousPhyTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param nEnbs the number of eNBs
+   * \param nUesPerEnb the number of UEs attached to each eNB
+   * \param nCcs the number of component carriers
+   */
+  LteTtiSynchronousPhyTestCase (uint16_t nEnbs, uint16_t nUesPerEnb, uint16_t nCcs);
+  virtual ~LteTtiSynchronousPhyTestCase ();
+
+  /**
+   * Record a PHY transmission.
+   *
+   * \param testCase the test case
+   * \param path the trace path
+   * \param params the transmission
+   */
+  static void PhyTransmission (LteTtiSynchronousPhyTestCase *testCase, std::string path,
+                               PhyTransmissionStatParameters params);
+  /**
+   * Record a PHY reception.
+   *
+   * \param testCase the test case
+   * \param path the trace path
+   * \param params the reception
+   */
+  static void PhyReception (LteTtiSynchronousPhyTestCase *testCase, std::string path,
+                            PhyReceptionStatParameters params);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Run the simulation and record the PHY transmissions and receptions.
+   *
+   * \param ttiSynchronousPhy whether the PHYs are driven by a LteTtiClock
+   * \return the PHY transmissions and receptions, sorted
+   */
+  std::vector<std::string> RunSimulation (bool ttiSynchronousPhy);
+
+  uint16_t m_nEnbs;      ///< the number of eNBs
+  uint16_t m_nUesPerEnb; ///< the number of UEs attached to each eNB
+  uint16_t m_nCcs;       ///< the number of component carriers
+  std::vector<std::string> m_transmissions; ///< the PHY transmissions and receptions of the current run
+};
+
+LteTtiSynchronousPhyTestCase::LteTtiSynchronousPhyTestCase (uint16_t nEnbs, uint16_t nUesPerEnb, uint16_t nCcs)
+  : TestCase ("TTI-synchronous PHY, " + std::to_string (nEnbs) + " eNBs, "
+              + std::to_string (nUesPerEnb) + " UEs per eNB, "
+              + std::to_string (nCcs) + " CCs"),
+    m_nEnbs (nEnbs),
+    m_nUesPerEnb (nUesPerEnb),
+    m_nCcs (nCcs)
+{
+}
+
+LteTtiSynchronousPhyTestCase::~LteTtiSynchronousPhyTestCase ()
+{
+}
+
+void
+LteTtiSynchronousPhyTestCase::PhyTransmission (LteTtiSynchronousPhyTestCase *testCase, std::string path,
+                                               PhyTransmissionStatParameters params)
+{
+  std::ostringstream oss;
+  oss << path << " " << Simulator::GetContext () << " " << params.m_timestamp << " " << params.m_cellId
+      << " " << params.m_rnti << " " << (uint16_t) params.m_layer
+      << " " << (uint16_t) params.m_mcs << " " << params.m_size
+      << " " << (uint16_t) params.m_rv << " " << (uint16_t) params.m_ndi
+      << " " << (uint16_t) params.m_ccId;
+  testCase->m_transmissions.push_back (oss.str ());
+}
+
+void
+LteTtiSynchronousPhyTestCase::PhyReception (LteTtiSynchronousPhyTestCase *testCase, std::string path,
+                                            PhyReceptionStatParameters params)
+{
+  std::ostringstream oss;
+  oss << path << " " << Simulator::GetContext () << " " << params.m_timestamp << " " << params.m_cellId
+      << " " << params.m_imsi << " " << params.m_rnti << " " << (uint16_t) params.m_layer
+      << " " << (uint16_t) params.m_mcs << " " << params.m_size
+      << " " << (uint16_t) params.m_rv << " " << (uint16_t) params.m_ndi
+      << " " << (uint16_t) params.m_correctness << " " << (uint16_t) params.m_ccId;
+  testCase->m_transmissions.push_back (oss.str ());
+}
+
+std::vector<std::string>
+LteTtiSynchronousPhyTestCase::RunSimulation (bool ttiSynchronousPhy)
+{
+  Config::Reset ();
+  Config::SetDefault ("ns3::LteHelper::UseIdealRrc", BooleanValue (true));
+  Config::SetDefault ("ns3::LteHelper::UseCa", BooleanValue (m_nCcs > 1));
+  Config::SetDefault ("ns3::LteHelper::NumberOfComponentCarriers", UintegerValue (m_nCcs));
+  Config::SetDefault ("ns3::LteHelper::EnbComponentCarrierManager", StringValue ("ns3::RrComponentCarrierManager"));
+  Config::SetDefault ("ns3::LteHelper::TtiSynchronousPhy", BooleanValue (ttiSynchronousPhy));
+  Config::SetDefault ("ns3::LteUePhy::EnableUplinkPowerControl", BooleanValue (false));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+
+  NodeContainer enbNodes;
+  enbNodes.Create (m_nEnbs);
+  NodeContainer ueNodes;
+  ueNodes.Create (m_nEnbs * m_nUesPerEnb);
+
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint16_t i = 0; i < m_nEnbs; ++i)
+    {
+      positionAlloc->Add (Vector (500.0 * i, 0.0, 0.0));
+    }
+  for (uint16_t i = 0; i < m_nEnbs; ++i)
+    {
+      for (uint16_t j = 0; j < m_nUesPerEnb; ++j)
+        {
+          positionAlloc->Add (Vector (500.0 * i + 20.0 + 40.0 * j, 10.0, 0.0));
+        }
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->AssignStreams (enbDevs, 1);
+  lteHelper->AssignStreams (ueDevs, 1000);
+  for (uint16_t i = 0; i < m_nEnbs; ++i)
+    {
+      for (uint16_t j = 0; j < m_nUesPerEnb; ++j)
+        {
+          lteHelper->Attach (ueDevs.Get (i * m_nUesPerEnb + j), enbDevs.Get (i));
+        }
+    }
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+
+  m_transmissions.clear ();
+  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/DlPhyTransmission",
+                   MakeBoundCallback (&LteTtiSynchronousPhyTestCase::PhyTransmission, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/UlPhyTransmission",
+                   MakeBoundCallback (&LteTtiSynchronousPhyTestCase::PhyTransmission, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbPhy/UlSpectrumPhy/UlPhyReception",
+                   MakeBoundCallback (&LteTtiSynchronousPhyTestCase::PhyReception, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/DlSpectrumPhy/DlPhyReception",
+                   MakeBoundCallback (&LteTtiSynchronousPhyTestCase::PhyReception, this));
+
+  Simulator::Stop (MilliSeconds (200));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::vector<std::string> transmissions;
+  transmissions.swap (m_transmissions);
+  std::sort (transmissions.begin (), transmissions.end ());
+  return transmissions;
+}
+
+void
+LteTtiSynchronousPhyTestCase::DoRun (void)
+{
+  std::vector<std::string> expected = RunSimulation (false);
+  std::vector<std::string> transmissions = RunSimulation (true);
+  NS_TEST_ASSERT_MSG_GT (expected.size (), 0, "no PHY transmission or reception");
+  NS_TEST_ASSERT_MSG_EQ (transmissions.size (), expected.size (), "wrong number of PHY transmissions and receptions");
+  for (uint32_t i = 0; (i < expected.size ()) && (i < transmissions.size ()); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (transmissions.at (i), expected.at (i), "wrong PHY transmission or reception " << i);
+    }
+  Config::Reset ();
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite of the TTI-synchronous PHY mode
+ */
+class LteTtiSynchronousPhyTestSuite : public TestSuite
+{
+public:
+  LteTtiSynchronousPhyTestSuite ();
+};
+
+LteTtiSynchronousPhyTestSuite::LteTtiSynchronousPhyTestSuite ()
+  : TestSuite ("lte-tti-synchronous-phy", SYSTEM)
+{
+  AddTestCase (new LteTtiSynchronousPhyTestCase (1, 3, 1), TestCase::QUICK);
+  AddTestCase (new LteTtiSynchronousPhyTestCase (3, 2, 1), TestCase::QUICK);
+  AddTestCase (new LteTtiSynchronousPhyTestCase (2, 2, 2), TestCase::QUICK);
+}
+
+static LteTtiSynchronousPhyTestSuite lteTtiSynchronousPhyTestSuite; ///< the test suite
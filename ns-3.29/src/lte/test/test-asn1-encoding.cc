@@ -52,7 +52,7 @@ public:
   {
     uint32_t psize = pkt->GetSize ();
     uint8_t buffer[psize];
-    char sbuffer[psize * 3];
+    char sbuffer[psize * 3 + 1];
     pkt->CopyData (buffer, psize);
     for (uint32_t i = 0; i < psize; i++)
       {
@@ -329,6 +329,9 @@ RrcConnectionRequestTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the encoding of the message did not change
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet), "48 3f ec af ec a6 ", "Unexpected encoding");
+
   // Remove header
   RrcConnectionRequestHeader destination;
   packet->RemoveHeader (destination);
@@ -435,6 +438,9 @@ RrcConnectionSetupCompleteTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the encoding of the message did not change
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet), "26 40 ", "Unexpected encoding");
+
   // Remove header
   RrcConnectionSetupCompleteHeader destination;
   packet->RemoveHeader (destination);
@@ -487,6 +493,9 @@ RrcConnectionReconfigurationCompleteTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the encoding of the message did not change
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet), "15 ", "Unexpected encoding");
+
   // remove header
   RrcConnectionReconfigurationCompleteHeader destination;
   packet->RemoveHeader (destination);
@@ -829,6 +838,9 @@ RrcConnectionReestablishmentRequestTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the encoding of the message did not change
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet), "00 01 81 50 00 04 ", "Unexpected encoding");
+
   // remove header
   RrcConnectionReestablishmentRequestHeader destination;
   packet->RemoveHeader (destination);
@@ -935,6 +947,9 @@ RrcConnectionReestablishmentCompleteTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the encoding of the message did not change
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet), "1e 00 ", "Unexpected encoding");
+
   // remove header
   RrcConnectionReestablishmentCompleteHeader destination;
   packet->RemoveHeader (destination);
@@ -986,6 +1001,9 @@ RrcConnectionRejectTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the encoding of the message did not change
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet), "40 20 ", "Unexpected encoding");
+
   // remove header
   RrcConnectionRejectHeader destination;
   packet->RemoveHeader (destination);
@@ -1054,6 +1072,9 @@ MeasurementReportTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the encoding of the message did not change
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet), "08 02 42 4a 82 09 00 e0 00 00 06 00 05 68 56 ", "Unexpected encoding");
+
   // remove header
   MeasurementReportHeader destination;
   packet->RemoveHeader (destination);
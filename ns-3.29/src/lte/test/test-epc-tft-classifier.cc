@@ -24,6 +24,7 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/ipv4-header.h"
+#include "ns3/ipv6-header.h"
 #include "ns3/udp-header.h"
 #include "ns3/tcp-header.h"
 #include "ns3/udp-l4-protocol.h"
@@ -169,6 +170,134 @@ EpcTftClassifierTestCase::DoRun (void)
 
 
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case checking that the TFT classifier, which compiles
+ * the packet filters and caches the classification of the flows,
+ * follows the addition and deletion of TFTs, and classifies IPv4
+ * fragments and IPv6 packets.
+ */
+class EpcTftClassifierUpdateTestCase : public TestCase
+{
+public:
+  EpcTftClassifierUpdateTestCase ();
+  virtual ~EpcTftClassifierUpdateTestCase ();
+
+private:
+  /**
+   * Create an IPv4 UDP packet, or fragment.
+   *
+   * \param sp the source port
+   * \param dp the destination port
+   * \param fragmentOffset the fragment offset, in bytes
+   * \param lastFragment whether the packet is the last fragment
+   * \returns the packet
+   */
+  static Ptr<Packet> CreateIpv4Packet (uint16_t sp, uint16_t dp, uint16_t fragmentOffset, bool lastFragment);
+  /**
+   * Create an IPv6 UDP packet.
+   *
+   * \param sp the source port
+   * \param dp the destination port
+   * \returns the packet
+   */
+  static Ptr<Packet> CreateIpv6Packet (uint16_t sp, uint16_t dp);
+  virtual void DoRun (void);
+};
+
+EpcTftClassifierUpdateTestCase::EpcTftClassifierUpdateTestCase ()
+  : TestCase ("TFT classifier after adding and deleting TFTs, with IPv4 fragments and IPv6 packets")
+{
+}
+
+EpcTftClassifierUpdateTestCase::~EpcTftClassifierUpdateTestCase ()
+{
+}
+
+Ptr<Packet>
+EpcTftClassifierUpdateTestCase::CreateIpv4Packet (uint16_t sp, uint16_t dp, uint16_t fragmentOffset, bool lastFragment)
+{
+  Ipv4Header ipHeader;
+  ipHeader.SetSource (Ipv4Address ("9.1.1.1"));
+  ipHeader.SetDestination (Ipv4Address ("8.1.1.1"));
+  ipHeader.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+  ipHeader.SetIdentification (7);
+  ipHeader.SetFragmentOffset (fragmentOffset);
+  if (lastFragment)
+    {
+      ipHeader.SetLastFragment ();
+    }
+  else
+    {
+      ipHeader.SetMoreFragments ();
+    }
+  Ptr<Packet> packet = Create<Packet> (16);
+  if (fragmentOffset == 0)
+    {
+      UdpHeader udpHeader;
+      udpHeader.SetSourcePort (sp);
+      udpHeader.SetDestinationPort (dp);
+      packet->AddHeader (udpHeader);
+    }
+  ipHeader.SetPayloadSize (packet->GetSize ());
+  packet->AddHeader (ipHeader);
+  return packet;
+}
+
+Ptr<Packet>
+EpcTftClassifierUpdateTestCase::CreateIpv6Packet (uint16_t sp, uint16_t dp)
+{
+  UdpHeader udpHeader;
+  udpHeader.SetSourcePort (sp);
+  udpHeader.SetDestinationPort (dp);
+  Ptr<Packet> packet = Create<Packet> (16);
+  packet->AddHeader (udpHeader);
+  Ipv6Header ipHeader;
+  ipHeader.SetSourceAddress (Ipv6Address ("2001:1::1"));
+  ipHeader.SetDestinationAddress (Ipv6Address ("2001:2::1"));
+  ipHeader.SetNextHeader (UdpL4Protocol::PROT_NUMBER);
+  ipHeader.SetTrafficClass (0x20);
+  ipHeader.SetPayloadLength (packet->GetSize ());
+  packet->AddHeader (ipHeader);
+  return packet;
+}
+
+void
+EpcTftClassifierUpdateTestCase::DoRun (void)
+{
+  Ptr<EpcTftClassifier> c = Create<EpcTftClassifier> ();
+  c->Add (EpcTft::Default (), 1);
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv4Packet (4, 1234, 0, true), EpcTft::DOWNLINK), 1, "bad classification with the default TFT");
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv4Packet (4, 1234, 0, true), EpcTft::DOWNLINK), 1, "bad classification of an already classified flow");
+
+  Ptr<EpcTft> tft = Create<EpcTft> ();
+  EpcTft::PacketFilter pf;
+  pf.remotePortStart = 4;
+  pf.remotePortEnd = 4;
+  tft->Add (pf);
+  c->Add (tft, 2);
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv4Packet (4, 1234, 0, true), EpcTft::DOWNLINK), 2, "bad classification after adding a TFT");
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv4Packet (4, 1234, 0, true), EpcTft::UPLINK), 1, "bad classification in the other direction");
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv4Packet (5, 1234, 0, true), EpcTft::DOWNLINK), 1, "bad classification of another flow");
+
+  // the fragments without ports use the ports of the first fragment
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv4Packet (4, 1234, 0, false), EpcTft::DOWNLINK), 2, "bad classification of the first fragment");
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv4Packet (4, 1234, 24, false), EpcTft::DOWNLINK), 2, "bad classification of a fragment");
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv4Packet (4, 1234, 48, true), EpcTft::DOWNLINK), 2, "bad classification of the last fragment");
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv4Packet (4, 1234, 72, true), EpcTft::DOWNLINK), 1, "bad classification of an unknown fragment");
+
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv6Packet (4, 1234), EpcTft::DOWNLINK), 2, "bad classification of an IPv6 packet");
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv6Packet (1234, 4), EpcTft::DOWNLINK), 1, "bad classification of an IPv6 packet");
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv6Packet (1234, 4), EpcTft::UPLINK), 2, "bad classification of an IPv6 packet");
+
+  c->Delete (2);
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv4Packet (4, 1234, 0, true), EpcTft::DOWNLINK), 1, "bad classification after deleting a TFT");
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (CreateIpv6Packet (4, 1234), EpcTft::DOWNLINK), 1, "bad classification after deleting a TFT");
+}
+
+
 
 /**
  * \ingroup lte-test
@@ -368,4 +497,11 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite ()
   AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::UPLINK,   Ipv4Address ("9.1.1.1"), Ipv4Address ("8.1.1.1"),     9,     5897,     0,    2), TestCase::QUICK);
   AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::DOWNLINK, Ipv4Address ("9.1.1.1"), Ipv4Address ("8.1.1.1"),  5897,       10,     0,    2), TestCase::QUICK);
 
+
+  ///////////////////////////////////////////
+  // check the changes of the TFTs
+  ///////////////////////////////////////////
+
+  AddTestCase (new EpcTftClassifierUpdateTestCase (), TestCase::QUICK);
+
 }
@@ -644,4 +644,10 @@ DistributedSimulatorImpl::GetContext (void) const
   return m_currentContext;
 }
 
+void
+DistributedSimulatorImpl::SetContext (uint32_t context)
+{
+  m_currentContext = context;
+}
+
 } // namespace ns3
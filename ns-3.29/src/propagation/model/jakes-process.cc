@@ -23,6 +23,8 @@
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+#include <cmath>
 #include "propagation-loss-model.h"
 #include "jakes-propagation-loss-model.h"
 
@@ -60,6 +62,19 @@ JakesProcess::GetTypeId ()
                    UintegerValue (20),
                    MakeUintegerAccessor (&JakesProcess::SetNOscillators),
                    MakeUintegerChecker<unsigned int> (4, 1000))
+    .AddAttribute ("SamplingInterval",
+                   "If non-zero, the complex gain is tabulated over a time grid "
+                   "with this resolution and interpolated between grid points, "
+                   "instead of summing all the oscillators at every call",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&JakesProcess::m_samplingInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("BlockSize",
+                   "The number of samples tabulated at a time, "
+                   "used only if SamplingInterval is non-zero",
+                   UintegerValue (1024),
+                   MakeUintegerAccessor (&JakesProcess::m_blockSize),
+                   MakeUintegerChecker<uint32_t> (1))
   ;
   return tid;
 }
@@ -115,7 +130,9 @@ JakesProcess::ConstructOscillators ()
 
 JakesProcess::JakesProcess () :
   m_omegaDopplerMax (0),
-  m_nOscillators (0)
+  m_nOscillators (0),
+  m_blockSize (0),
+  m_blockIndex (-1)
 {
 }
 
@@ -133,6 +150,20 @@ JakesProcess::DoDispose ()
 std::complex<double>
 JakesProcess::GetComplexGain () const
 {
+  if (m_samplingInterval.IsStrictlyPositive ())
+    {
+      double x = Now ().GetSeconds () / m_samplingInterval.GetSeconds ();
+      int64_t sample = static_cast<int64_t> (std::floor (x));
+      int64_t blockIndex = sample / m_blockSize;
+      if (blockIndex != m_blockIndex)
+        {
+          TabulateBlock (blockIndex);
+        }
+      uint32_t offset = sample - blockIndex * m_blockSize;
+      double frac = x - sample;
+      return m_table[offset] + (m_table[offset + 1] - m_table[offset]) * frac;
+    }
+
   std::complex<double> sumAplitude = std::complex<double> (0, 0);
   for (unsigned int i = 0; i < m_oscillators.size (); i++)
     {
@@ -141,6 +172,53 @@ JakesProcess::GetComplexGain () const
   return sumAplitude;
 }
 
+void
+JakesProcess::TabulateBlock (int64_t blockIndex) const
+{
+  NS_LOG_FUNCTION (this << blockIndex);
+  const std::size_t nOscillators = m_oscillators.size ();
+  const double dt = m_samplingInterval.GetSeconds ();
+  const double t0 = blockIndex * m_blockSize * dt;
+
+  // state of each oscillator, stored as separate arrays so that the
+  // loop over the oscillators can be vectorized
+  std::vector<double> re (nOscillators);
+  std::vector<double> im (nOscillators);
+  std::vector<double> cosValue (nOscillators);
+  std::vector<double> sinValue (nOscillators);
+  std::vector<double> cosStep (nOscillators);
+  std::vector<double> sinStep (nOscillators);
+  for (std::size_t n = 0; n < nOscillators; ++n)
+    {
+      const Oscillator &o = m_oscillators[n];
+      re[n] = o.m_amplitude.real ();
+      im[n] = o.m_amplitude.imag ();
+      cosValue[n] = std::cos (t0 * o.m_omega + o.m_phase);
+      sinValue[n] = std::sin (t0 * o.m_omega + o.m_phase);
+      cosStep[n] = std::cos (dt * o.m_omega);
+      sinStep[n] = std::sin (dt * o.m_omega);
+    }
+
+  // one extra sample is needed to interpolate after the last one
+  m_table.resize (m_blockSize + 1);
+  for (uint32_t i = 0; i <= m_blockSize; ++i)
+    {
+      double sumRe = 0;
+      double sumIm = 0;
+      for (std::size_t n = 0; n < nOscillators; ++n)
+        {
+          sumRe += re[n] * cosValue[n];
+          sumIm += im[n] * cosValue[n];
+          // rotate by omega * dt
+          double c = cosValue[n] * cosStep[n] - sinValue[n] * sinStep[n];
+          sinValue[n] = sinValue[n] * cosStep[n] + cosValue[n] * sinStep[n];
+          cosValue[n] = c;
+        }
+      m_table[i] = std::complex<double> (sumRe, sumIm);
+    }
+  m_blockIndex = blockIndex;
+}
+
 double
 JakesProcess::GetChannelGainDb () const
 {
@@ -24,6 +24,7 @@
 #include "ns3/nstime.h"
 #include "ns3/random-variable-stream.h"
 #include <complex>
+#include <vector>
 
 namespace ns3
 {
@@ -51,6 +52,17 @@ class JakesPropagationLossModel;
  * [1] Y. R. Zheng and C. Xiao, "Simulation Models With Correct
  * Statistical Properties for Rayleigh Fading Channel", IEEE
  * Trans. on Communications, Vol. 51, pp 920-928, June 2003
+ *
+ * By default, the sum of oscillators is evaluated at every call. If
+ * the SamplingInterval attribute is set to a non-zero value, the
+ * complex gain is instead tabulated over a time grid with the given
+ * resolution, and linearly interpolated between grid points. The
+ * table is generated lazily, one block of BlockSize samples at a
+ * time, when the simulation time enters the block; only the current
+ * block is kept, hence memory is bounded independently of the
+ * simulation duration. Within a block, the oscillators are advanced
+ * by a complex rotation per sample, so that trigonometric functions
+ * are evaluated only once per oscillator per block.
  */
 class JakesProcess : public Object
 {
@@ -122,12 +134,22 @@ private:
    *
    */
   void ConstructOscillators ();
+
+  /**
+   * Tabulate the complex gain over a block of samples
+   * @param blockIndex the index of the block to be tabulated
+   */
+  void TabulateBlock (int64_t blockIndex) const;
 private:
   std::vector<Oscillator> m_oscillators; //!< Vector of oscillators
   double m_omegaDopplerMax; //!< max rotation speed Doppler frequency
   unsigned int m_nOscillators;  //!< number of oscillators
   Ptr<UniformRandomVariable> m_uniformVariable; //!< random stream
   Ptr<const JakesPropagationLossModel> m_jakes; //!< pointer to the propagation loss model
+  Time m_samplingInterval; //!< time resolution of the table, zero if the gain is not tabulated
+  uint32_t m_blockSize; //!< number of samples tabulated at a time
+  mutable int64_t m_blockIndex; //!< index of the block held in m_table, -1 if none
+  mutable std::vector<std::complex<double> > m_table; //!< complex gain samples of the current block
 };
 } // namespace ns3
 #endif // DOPPLER_PROCESS_H
@@ -21,7 +21,10 @@
 #include "ns3/test.h"
 #include "ns3/config.h"
 #include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/jakes-propagation-loss-model.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/simulator.h"
 
@@ -436,6 +439,76 @@ RangePropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class JakesPropagationLossModelTabulationTestCase : public TestCase
+{
+public:
+  JakesPropagationLossModelTabulationTestCase ();
+  virtual ~JakesPropagationLossModelTabulationTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Compare the gain of the exact and the tabulated fading processes
+   * \param onGrid true if the current time is a multiple of the sampling interval
+   */
+  void Check (bool onGrid);
+
+  Ptr<MobilityModel> m_a; //!< first node mobility
+  Ptr<MobilityModel> m_b; //!< second node mobility
+  Ptr<PropagationLossModel> m_exact; //!< model evaluating the oscillators at every call
+  Ptr<PropagationLossModel> m_tabulated; //!< model tabulating the fading
+};
+
+JakesPropagationLossModelTabulationTestCase::JakesPropagationLossModelTabulationTestCase ()
+  : TestCase ("Test tabulated JakesProcess")
+{
+}
+
+JakesPropagationLossModelTabulationTestCase::~JakesPropagationLossModelTabulationTestCase ()
+{
+}
+
+void
+JakesPropagationLossModelTabulationTestCase::Check (bool onGrid)
+{
+  double exact = std::pow (10.0, m_exact->CalcRxPower (0, m_a, m_b) / 10);
+  double tabulated = std::pow (10.0, m_tabulated->CalcRxPower (0, m_a, m_b) / 10);
+  double tol = onGrid ? 1e-6 : 1e-2;
+  NS_TEST_EXPECT_MSG_EQ_TOL (tabulated, exact, tol, "Got unexpected fading gain at " << Now ().GetSeconds ());
+}
+
+void
+JakesPropagationLossModelTabulationTestCase::DoRun (void)
+{
+  m_a = CreateObject<ConstantPositionMobilityModel> ();
+  m_b = CreateObject<ConstantPositionMobilityModel> ();
+
+  m_exact = CreateObject<JakesPropagationLossModel> ();
+  m_exact->AssignStreams (1);
+  m_exact->CalcRxPower (0, m_a, m_b);
+
+  Config::SetDefault ("ns3::JakesProcess::SamplingInterval", TimeValue (MicroSeconds (100)));
+  Config::SetDefault ("ns3::JakesProcess::BlockSize", UintegerValue (16));
+  m_tabulated = CreateObject<JakesPropagationLossModel> ();
+  m_tabulated->AssignStreams (1);
+  m_tabulated->CalcRxPower (0, m_a, m_b);
+  Config::SetDefault ("ns3::JakesProcess::SamplingInterval", TimeValue (Seconds (0)));
+  Config::SetDefault ("ns3::JakesProcess::BlockSize", UintegerValue (1024));
+
+  // cross several blocks, and skip some of them
+  for (uint32_t i = 0; i < 200; ++i)
+    {
+      Simulator::Schedule (MicroSeconds (50 * i + (i / 50) * 10000), &JakesPropagationLossModelTabulationTestCase::Check, this, i % 2 == 0);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_a = 0;
+  m_b = 0;
+  m_exact = 0;
+  m_tabulated = 0;
+}
+
 class PropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -450,6 +523,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new JakesPropagationLossModelTabulationTestCase, TestCase::QUICK);
 }
 
 static PropagationLossModelsTestSuite propagationLossModelsTestSuite;
@@ -337,6 +337,14 @@ HalfDuplexIdealPhy::EndTx ()
 }
 
 
+void
+HalfDuplexIdealPhy::StartRxPersistent (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> rxPsd)
+{
+  NS_LOG_FUNCTION (this << signal << rxPsd);
+  m_interference.AddPersistentSignal (signal, rxPsd);
+}
+
+
 void
 HalfDuplexIdealPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumParams)
 {
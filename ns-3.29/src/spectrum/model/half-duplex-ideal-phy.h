@@ -107,6 +107,7 @@ public:
   Ptr<const SpectrumModel> GetRxSpectrumModel () const;
   Ptr<AntennaModel> GetRxAntenna ();
   void StartRx (Ptr<SpectrumSignalParameters> params);
+  void StartRxPersistent (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> rxPsd);
 
 
   /**
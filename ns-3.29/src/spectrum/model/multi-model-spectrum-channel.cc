@@ -20,12 +20,14 @@
 
 #include <ns3/object.h>
 #include <ns3/simulator.h>
+#include <ns3/simulator-impl.h>
 #include <ns3/log.h>
 #include <ns3/packet.h>
 #include <ns3/packet-burst.h>
 #include <ns3/net-device.h>
 #include <ns3/node.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
 #include <ns3/mobility-model.h>
 #include <ns3/spectrum-phy.h>
 #include <ns3/spectrum-converter.h>
@@ -76,12 +78,14 @@ TxSpectrumModelInfo::TxSpectrumModelInfo (Ptr<const SpectrumModel> txSpectrumMod
 
 
 RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumModel)
-  : m_rxSpectrumModel (rxSpectrumModel)
+  : m_rxSpectrumModel (rxSpectrumModel),
+    m_convertedPsd (Create<SpectrumValue> (rxSpectrumModel))
 {
 }
 
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
+  : m_groupedRx (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -102,7 +106,13 @@ MultiModelSpectrumChannel::GetTypeId (void)
     .SetParent<SpectrumChannel> ()
     .SetGroupName ("Spectrum")
     .AddConstructor<MultiModelSpectrumChannel> ()
-
+    .AddAttribute ("GroupedRx",
+                   "If true, the receptions of a transmission which start at the same "
+                   "time are started by a single event, in the same order and contexts "
+                   "as with one event per receiver.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MultiModelSpectrumChannel::m_groupedRx),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -156,17 +166,7 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
            txInfoIterator != m_txSpectrumModelInfoMap.end ();
            ++txInfoIterator)
         {
-          Ptr<const SpectrumModel> txSpectrumModel = txInfoIterator->second.m_txSpectrumModel;
-          SpectrumModelUid_t txSpectrumModelUid = txSpectrumModel->GetUid ();
-
-          if (rxSpectrumModelUid != txSpectrumModelUid && !txSpectrumModel->IsOrthogonal (*rxSpectrumModel))
-            {
-              NS_LOG_LOGIC ("Creating converter between SpectrumModelUid " << txSpectrumModel->GetUid () << " and " << rxSpectrumModelUid);
-              SpectrumConverter converter (txSpectrumModel, rxSpectrumModel);
-              std::pair<SpectrumConverterMap_t::iterator, bool> ret2;
-              ret2 = txInfoIterator->second.m_spectrumConverterMap.insert (std::make_pair (rxSpectrumModelUid, converter));
-              NS_ASSERT (ret2.second);
-            }
+          AddIfOverlapping (txInfoIterator->second, ret.first->second);
         }
     }
   else
@@ -176,6 +176,15 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
       NS_ASSERT (ret2.second);
     }
 
+  // the phy might have changed SpectrumModel, so the persistent
+  // signals are delivered again in any case
+  RemoveStoppedPersistentSignals ();
+  for (std::list<Ptr<PersistentSpectrumSignal> >::const_iterator it = m_persistentSignals.begin ();
+       it != m_persistentSignals.end ();
+       ++it)
+    {
+      ConvertAndDeliverPersistentSignal (*it, phy);
+    }
 }
 
 
@@ -200,18 +209,7 @@ MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel (Ptr<const Spectr
            rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
            ++rxInfoIterator)
         {
-          Ptr<const SpectrumModel> rxSpectrumModel = rxInfoIterator->second.m_rxSpectrumModel;
-          SpectrumModelUid_t rxSpectrumModelUid = rxSpectrumModel->GetUid ();
-
-          if (rxSpectrumModelUid != txSpectrumModelUid && !txSpectrumModel->IsOrthogonal (*rxSpectrumModel))
-            {
-              NS_LOG_LOGIC ("Creating converter between SpectrumModelUid " << txSpectrumModelUid << " and " << rxSpectrumModelUid);
-
-              SpectrumConverter converter (txSpectrumModel, rxSpectrumModel);
-              std::pair<SpectrumConverterMap_t::iterator, bool> ret2;
-              ret2 = txInfoIterator->second.m_spectrumConverterMap.insert (std::make_pair (rxSpectrumModelUid, converter));
-              NS_ASSERT (ret2.second);
-            }
+          AddIfOverlapping (txInfoIterator->second, rxInfoIterator->second);
         }
     }
   else
@@ -221,6 +219,39 @@ MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel (Ptr<const Spectr
   return txInfoIterator;
 }
 
+void
+MultiModelSpectrumChannel::AddIfOverlapping (TxSpectrumModelInfo &txInfo, const RxSpectrumModelInfo &rxInfo)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<const SpectrumModel> txSpectrumModel = txInfo.m_txSpectrumModel;
+  Ptr<const SpectrumModel> rxSpectrumModel = rxInfo.m_rxSpectrumModel;
+  SpectrumModelUid_t txSpectrumModelUid = txSpectrumModel->GetUid ();
+  SpectrumModelUid_t rxSpectrumModelUid = rxSpectrumModel->GetUid ();
+
+  Ptr<const SpectrumConverter> converter;
+  if (rxSpectrumModelUid != txSpectrumModelUid)
+    {
+      if (txSpectrumModel->IsOrthogonal (*rxSpectrumModel))
+        {
+          return;
+        }
+      NS_LOG_LOGIC ("Creating converter between SpectrumModelUid " << txSpectrumModelUid << " and " << rxSpectrumModelUid);
+      converter = SpectrumConverter::Get (txSpectrumModel, rxSpectrumModel);
+      std::pair<SpectrumConverterMap_t::iterator, bool> ret;
+      ret = txInfo.m_spectrumConverterMap.insert (std::make_pair (rxSpectrumModelUid, converter));
+      NS_ASSERT (ret.second);
+    }
+
+  // keep the RX SpectrumModels in the order of m_rxSpectrumModelInfoMap
+  OverlappingRxSpectrumModelList_t::iterator it = txInfo.m_overlappingRxSpectrumModels.begin ();
+  while (it != txInfo.m_overlappingRxSpectrumModels.end ()
+         && it->first->m_rxSpectrumModel->GetUid () < rxSpectrumModelUid)
+    {
+      ++it;
+    }
+  txInfo.m_overlappingRxSpectrumModels.insert (it, std::make_pair (&rxInfo, converter));
+}
+
     
 
 void
@@ -245,15 +276,24 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_LOGIC ("converter map size: " << txInfoIteratorerator->second.m_spectrumConverterMap.size ());
   NS_LOG_LOGIC ("converter map first element: " << txInfoIteratorerator->second.m_spectrumConverterMap.begin ()->first);
 
-  for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
-       rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
-       ++rxInfoIterator)
+  // the groups of receptions, by propagation delay, if grouped
+  std::vector<std::pair<Time, Ptr<RxGroup> > > rxGroups;
+
+  // the RX SpectrumModels orthogonal to the TX SpectrumModel are skipped
+  for (OverlappingRxSpectrumModelList_t::const_iterator overlappingIterator = txInfoIteratorerator->second.m_overlappingRxSpectrumModels.begin ();
+       overlappingIterator != txInfoIteratorerator->second.m_overlappingRxSpectrumModels.end ();
+       ++overlappingIterator)
     {
-      SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid ();
+      const RxSpectrumModelInfo &rxInfo = *overlappingIterator->first;
+      SpectrumModelUid_t rxSpectrumModelUid = rxInfo.m_rxSpectrumModel->GetUid ();
       NS_LOG_LOGIC (" rxSpectrumModelUids " << rxSpectrumModelUid);
+      if (rxInfo.m_rxPhySet.empty ())
+        {
+          continue;
+        }
 
       Ptr <SpectrumValue> convertedTxPowerSpectrum;
-      if (txSpectrumModelUid == rxSpectrumModelUid)
+      if (overlappingIterator->second == 0)
         {
           NS_LOG_LOGIC ("no spectrum conversion needed");
           convertedTxPowerSpectrum = txParams->psd;
@@ -261,18 +301,14 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
       else
         {
           NS_LOG_LOGIC (" converting txPowerSpectrum SpectrumModelUids" << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
-          SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIteratorerator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
-          if (rxConverterIterator == txInfoIteratorerator->second.m_spectrumConverterMap.end ())
-            {
-              // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
-              continue;
-            }
-          convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
+          // the scratch buffer can be reused since each receiver gets its own copy below
+          convertedTxPowerSpectrum = rxInfo.m_convertedPsd;
+          overlappingIterator->second->Convert (*txParams->psd, *convertedTxPowerSpectrum);
         }
 
 
-      for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
-           rxPhyIterator != rxInfoIterator->second.m_rxPhySet.end ();
+      for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfo.m_rxPhySet.begin ();
+           rxPhyIterator != rxInfo.m_rxPhySet.end ();
            ++rxPhyIterator)
         {
           NS_ASSERT_MSG ((*rxPhyIterator)->GetRxSpectrumModel ()->GetUid () == rxSpectrumModelUid,
@@ -333,7 +369,32 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                 }
 
               Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
-              if (netDev)
+              if (m_groupedRx)
+                {
+                  Ptr<RxGroup> group;
+                  for (std::vector<std::pair<Time, Ptr<RxGroup> > >::const_iterator groupIterator = rxGroups.begin ();
+                       groupIterator != rxGroups.end ();
+                       ++groupIterator)
+                    {
+                      if (groupIterator->first == delay)
+                        {
+                          group = groupIterator->second;
+                          break;
+                        }
+                    }
+                  if (group == 0)
+                    {
+                      // scheduled in place of the event of the first receiver
+                      group = Create<RxGroup> ();
+                      rxGroups.push_back (std::make_pair (delay, group));
+                      Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRxGroup, this, group);
+                    }
+                  group->params.push_back (rxParams);
+                  group->receivers.push_back (*rxPhyIterator);
+                  // same contexts as the events scheduled below
+                  group->contexts.push_back (netDev ? netDev->GetNode ()->GetId () : Simulator::GetContext ());
+                }
+              else if (netDev)
                 {
                   // the receiver has a NetDevice, so we expect that it is attached to a Node
                   uint32_t dstNode =  netDev->GetNode ()->GetId ();
@@ -353,6 +414,71 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
 }
 
+void
+MultiModelSpectrumChannel::AddPersistentSignal (Ptr<PersistentSpectrumSignal> signal)
+{
+  NS_LOG_FUNCTION (this << signal);
+  NS_ASSERT (signal->GetTxPhy ());
+
+  RemoveStoppedPersistentSignals ();
+  m_persistentSignals.push_back (signal);
+
+  Ptr<const SpectrumValue> txPsd = signal->GetPsd ();
+  SpectrumModelUid_t txSpectrumModelUid = txPsd->GetSpectrumModelUid ();
+  TxSpectrumModelInfoMap_t::const_iterator txInfoIterator = FindAndEventuallyAddTxSpectrumModel (txPsd->GetSpectrumModel ());
+  NS_ASSERT (txInfoIterator != m_txSpectrumModelInfoMap.end ());
+
+  for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
+       rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
+       ++rxInfoIterator)
+    {
+      SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid ();
+      Ptr<const SpectrumValue> convertedPsd;
+      if (txSpectrumModelUid == rxSpectrumModelUid)
+        {
+          convertedPsd = txPsd;
+        }
+      else
+        {
+          SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIterator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
+          if (rxConverterIterator == txInfoIterator->second.m_spectrumConverterMap.end ())
+            {
+              // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
+              continue;
+            }
+          convertedPsd = rxConverterIterator->second->Convert (txPsd);
+        }
+
+      for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
+           rxPhyIterator != rxInfoIterator->second.m_rxPhySet.end ();
+           ++rxPhyIterator)
+        {
+          DeliverPersistentSignal (signal, convertedPsd, *rxPhyIterator);
+        }
+    }
+}
+
+void
+MultiModelSpectrumChannel::ConvertAndDeliverPersistentSignal (Ptr<const PersistentSpectrumSignal> signal, Ptr<SpectrumPhy> receiver)
+{
+  NS_LOG_FUNCTION (this << signal << receiver);
+  Ptr<const SpectrumValue> txPsd = signal->GetPsd ();
+  SpectrumModelUid_t rxSpectrumModelUid = receiver->GetRxSpectrumModel ()->GetUid ();
+  if (txPsd->GetSpectrumModelUid () == rxSpectrumModelUid)
+    {
+      DeliverPersistentSignal (signal, txPsd, receiver);
+      return;
+    }
+  TxSpectrumModelInfoMap_t::const_iterator txInfoIterator = FindAndEventuallyAddTxSpectrumModel (txPsd->GetSpectrumModel ());
+  SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIterator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
+  if (rxConverterIterator == txInfoIterator->second.m_spectrumConverterMap.end ())
+    {
+      NS_LOG_LOGIC ("persistent signal is orthogonal to the SpectrumModel of the receiver");
+      return;
+    }
+  DeliverPersistentSignal (signal, rxConverterIterator->second->Convert (txPsd), receiver);
+}
+
 void
 MultiModelSpectrumChannel::StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver)
 {
@@ -360,6 +486,22 @@ MultiModelSpectrumChannel::StartRx (Ptr<SpectrumSignalParameters> params, Ptr<Sp
   receiver->StartRx (params);
 }
 
+void
+MultiModelSpectrumChannel::StartRxGroup (Ptr<RxGroup> group)
+{
+  NS_LOG_FUNCTION (this << group->receivers.size ());
+  // each reception runs in the context of its own event, see
+  // SimulatorImpl::SetContext
+  Ptr<SimulatorImpl> impl = Simulator::GetImplementation ();
+  uint32_t context = impl->GetContext ();
+  for (std::size_t i = 0; i < group->receivers.size (); ++i)
+    {
+      impl->SetContext (group->contexts[i]);
+      StartRx (group->params[i], group->receivers[i]);
+    }
+  impl->SetContext (context);
+}
+
 std::size_t
 MultiModelSpectrumChannel::GetNDevices (void) const
 {
@@ -27,8 +27,10 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
+#include <ns3/simple-ref-count.h>
 #include <map>
 #include <set>
+#include <vector>
 
 namespace ns3 {
 
@@ -37,7 +39,16 @@ namespace ns3 {
  * \ingroup spectrum
  * Container: SpectrumModelUid_t, SpectrumConverter
  */
-typedef std::map<SpectrumModelUid_t, SpectrumConverter> SpectrumConverterMap_t;
+typedef std::map<SpectrumModelUid_t, Ptr<const SpectrumConverter> > SpectrumConverterMap_t;
+
+class RxSpectrumModelInfo;
+
+/**
+ * \ingroup spectrum
+ * Container: Rx spectrum model information, SpectrumConverter to the Rx
+ * spectrum model (0 if the Tx and Rx spectrum models are the same)
+ */
+typedef std::vector<std::pair<const RxSpectrumModelInfo *, Ptr<const SpectrumConverter> > > OverlappingRxSpectrumModelList_t;
 
 /**
  * \ingroup spectrum
@@ -55,6 +66,12 @@ public:
 
   Ptr<const SpectrumModel> m_txSpectrumModel;     //!< Tx Spectrum model.
   SpectrumConverterMap_t m_spectrumConverterMap;  //!< Spectrum converter.
+  /**
+   * The Rx spectrum models which overlap the Tx spectrum model in
+   * frequency, i.e., which are not orthogonal to it, in increasing order
+   * of their uids. The transmissions are only delivered to their phys.
+   */
+  OverlappingRxSpectrumModelList_t m_overlappingRxSpectrumModels;
 };
 
 
@@ -81,6 +98,7 @@ public:
 
   Ptr<const SpectrumModel> m_rxSpectrumModel;  //!< Rx Spectrum model.
   std::set<Ptr<SpectrumPhy> > m_rxPhySet;      //!< Container of the Rx Spectrum phy objects.
+  Ptr<SpectrumValue> m_convertedPsd;           //!< Scratch buffer holding the Tx PSD converted to the Rx Spectrum model.
 };
 
 /**
@@ -102,6 +120,11 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * When the GroupedRx attribute is set, the receptions of a transmission
+ * which start at the same time are started by a single event, rather
+ * than by one event per receiver. The receivers are visited in the same
+ * order, each in the simulation context of its own event.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -118,6 +141,7 @@ public:
   // inherited from SpectrumChannel
   virtual void AddRx (Ptr<SpectrumPhy> phy);
   virtual void StartTx (Ptr<SpectrumSignalParameters> params);
+  virtual void AddPersistentSignal (Ptr<PersistentSpectrumSignal> signal);
 
 
   // inherited from Channel
@@ -141,6 +165,25 @@ private:
    */
   TxSpectrumModelInfoMap_t::const_iterator FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel);
 
+  /**
+   * If the given TX and RX SpectrumModels overlap in frequency, add the
+   * RX SpectrumModel to the overlapping RX SpectrumModels of the TX
+   * SpectrumModel, and create the converter between them if needed.
+   *
+   * \param txInfo The information of the TX SpectrumModel
+   * \param rxInfo The information of the RX SpectrumModel
+   */
+  void AddIfOverlapping (TxSpectrumModelInfo &txInfo, const RxSpectrumModelInfo &rxInfo);
+
+  /**
+   * Deliver a persistent signal to a receiver, after converting it to
+   * the SpectrumModel of the receiver if needed.
+   *
+   * \param signal The persistent signal.
+   * \param receiver A pointer to the receiver SpectrumPhy.
+   */
+  void ConvertAndDeliverPersistentSignal (Ptr<const PersistentSpectrumSignal> signal, Ptr<SpectrumPhy> receiver);
+
   /**
    * Used internally to reschedule transmission after the propagation delay.
    *
@@ -149,6 +192,25 @@ private:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+  /**
+   * The receptions of a transmission which start at the same time, when
+   * the receptions are grouped.
+   */
+  struct RxGroup : public SimpleRefCount<RxGroup>
+  {
+    std::vector<Ptr<SpectrumSignalParameters> > params; //!< The signal parameters of each receiver.
+    std::vector<Ptr<SpectrumPhy> > receivers;           //!< The receivers.
+    std::vector<uint32_t> contexts;                     //!< The simulation context of each receiver.
+  };
+
+  /**
+   * Used internally to start a group of receptions after the
+   * propagation delay.
+   *
+   * \param group The receptions.
+   */
+  void StartRxGroup (Ptr<RxGroup> group);
+
   /**
    * Data structure holding, for each TX SpectrumModel,  all the
    * converters to any RX SpectrumModel, and all the corresponding
@@ -169,6 +231,12 @@ private:
    */
   std::size_t m_numDevices;
 
+  /**
+   * Whether the receptions of a transmission which start at the same time
+   * are started by a single event.
+   */
+  bool m_groupedRx;
+
 };
 
 
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <algorithm>
+
+#include "persistent-spectrum-signal.h"
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PersistentSpectrumSignal");
+
+PersistentSpectrumSignal::PersistentSpectrumSignal (Ptr<const SpectrumValue> psd, Ptr<SpectrumPhy> txPhy,
+                                                    Ptr<AntennaModel> txAntenna, Time period, Time onDuration)
+  : m_psd (psd),
+    m_txPhy (txPhy),
+    m_txAntenna (txAntenna),
+    m_period (period),
+    m_onDuration (onDuration),
+    m_startTime (Simulator::Now ()),
+    m_stopTime (Time::Max ())
+{
+  NS_LOG_FUNCTION (this << psd << txPhy << period << onDuration);
+  NS_ASSERT (psd);
+  NS_ASSERT (!period.IsStrictlyNegative ());
+  NS_ASSERT (!onDuration.IsStrictlyNegative ());
+  if (m_period.IsStrictlyPositive () && m_onDuration >= m_period)
+    {
+      // always on
+      m_period = Time (0);
+    }
+}
+
+Ptr<const SpectrumValue>
+PersistentSpectrumSignal::GetPsd () const
+{
+  return m_psd;
+}
+
+Ptr<SpectrumPhy>
+PersistentSpectrumSignal::GetTxPhy () const
+{
+  return m_txPhy;
+}
+
+Ptr<AntennaModel>
+PersistentSpectrumSignal::GetTxAntenna () const
+{
+  return m_txAntenna;
+}
+
+Time
+PersistentSpectrumSignal::GetPeriod () const
+{
+  return m_period;
+}
+
+Time
+PersistentSpectrumSignal::GetOnDuration () const
+{
+  return m_onDuration;
+}
+
+Time
+PersistentSpectrumSignal::GetStartTime () const
+{
+  return m_startTime;
+}
+
+Time
+PersistentSpectrumSignal::GetStopTime () const
+{
+  return m_stopTime;
+}
+
+void
+PersistentSpectrumSignal::Stop ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_stopTime == Time::Max ())
+    {
+      m_stopTime = Simulator::Now ();
+    }
+}
+
+int64_t
+PersistentSpectrumSignal::GetOnTime (Time t) const
+{
+  t = std::min (t, m_stopTime);
+  if (t <= m_startTime)
+    {
+      return 0;
+    }
+  int64_t elapsed = (t - m_startTime).GetTimeStep ();
+  if (m_period.IsZero ())
+    {
+      return elapsed;
+    }
+  int64_t period = m_period.GetTimeStep ();
+  int64_t onDuration = m_onDuration.GetTimeStep ();
+  return (elapsed / period) * onDuration + std::min (elapsed % period, onDuration);
+}
+
+double
+PersistentSpectrumSignal::GetOnFraction (Time t1, Time t2) const
+{
+  if (t2 <= t1)
+    {
+      return 0;
+    }
+  int64_t onTime = GetOnTime (t2) - GetOnTime (t1);
+  return static_cast<double> (onTime) / (t2 - t1).GetTimeStep ();
+}
+
+
+void
+PersistentSpectrumSignalList::Add (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> rxPsd)
+{
+  NS_LOG_FUNCTION (this << signal << rxPsd);
+  for (std::list<Entry>::iterator it = m_signals.begin (); it != m_signals.end (); ++it)
+    {
+      if (it->first == signal)
+        {
+          it->second = rxPsd;
+          return;
+        }
+    }
+  m_signals.push_back (std::make_pair (signal, rxPsd));
+}
+
+bool
+PersistentSpectrumSignalList::IsEmpty () const
+{
+  return m_signals.empty ();
+}
+
+void
+PersistentSpectrumSignalList::AddAveragePsd (Time t1, Time t2, SpectrumValue& psd)
+{
+  NS_LOG_FUNCTION (this << t1 << t2);
+  std::list<Entry>::iterator it = m_signals.begin ();
+  while (it != m_signals.end ())
+    {
+      if (it->first->GetStopTime () <= t1)
+        {
+          NS_LOG_LOGIC ("removing stopped signal " << it->first);
+          it = m_signals.erase (it);
+          continue;
+        }
+      if (it->second->GetSpectrumModelUid () == psd.GetSpectrumModelUid ())
+        {
+          double onFraction = it->first->GetOnFraction (t1, t2);
+          NS_LOG_LOGIC ("signal " << it->first << " on fraction " << onFraction);
+          if (onFraction > 0)
+            {
+              psd += (*(it->second)) * onFraction;
+            }
+        }
+      ++it;
+    }
+}
+
+void
+PersistentSpectrumSignalList::Clear ()
+{
+  NS_LOG_FUNCTION (this);
+  m_signals.clear ();
+}
+
+} // namespace ns3
@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PERSISTENT_SPECTRUM_SIGNAL_H
+#define PERSISTENT_SPECTRUM_SIGNAL_H
+
+#include <ns3/simple-ref-count.h>
+#include <ns3/ptr.h>
+#include <ns3/nstime.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/antenna-model.h>
+#include <list>
+#include <utility>
+
+namespace ns3 {
+
+/**
+ * \ingroup spectrum
+ *
+ * A signal which is registered once on a SpectrumChannel and lasts
+ * until it is explicitly stopped, such as the signal of a
+ * WaveformGenerator. The signal is either continuous, or periodic
+ * with a given on duration at the beginning of each period.
+ *
+ * Instead of scheduling one StartTx per period, the channel computes
+ * the received PSD of the signal once per receiver, and the
+ * interference models of the receivers account for it by integrating
+ * the fraction of time during which the signal is on over each chunk.
+ *
+ * \see SpectrumChannel::AddPersistentSignal
+ */
+class PersistentSpectrumSignal : public SimpleRefCount<PersistentSpectrumSignal>
+{
+public:
+  /**
+   * Create a signal starting now
+   *
+   * \param psd the power spectral density of the signal when on
+   * \param txPhy the SpectrumPhy instance generating the signal
+   * \param txAntenna the antenna of the transmitter, possibly 0
+   * \param period the period of the signal; a zero period means
+   * that the signal is continuous
+   * \param onDuration the time during which the signal is on at the
+   * beginning of each period
+   */
+  PersistentSpectrumSignal (Ptr<const SpectrumValue> psd, Ptr<SpectrumPhy> txPhy,
+                            Ptr<AntennaModel> txAntenna, Time period, Time onDuration);
+
+  /**
+   * \return the power spectral density of the signal when on
+   */
+  Ptr<const SpectrumValue> GetPsd () const;
+  /**
+   * \return the SpectrumPhy instance generating the signal
+   */
+  Ptr<SpectrumPhy> GetTxPhy () const;
+  /**
+   * \return the antenna of the transmitter
+   */
+  Ptr<AntennaModel> GetTxAntenna () const;
+  /**
+   * \return the period of the signal, zero for a continuous signal
+   */
+  Time GetPeriod () const;
+  /**
+   * \return the on duration in each period
+   */
+  Time GetOnDuration () const;
+  /**
+   * \return the time at which the signal was started
+   */
+  Time GetStartTime () const;
+  /**
+   * \return the time at which the signal was stopped, or Time::Max ()
+   * if the signal is still active
+   */
+  Time GetStopTime () const;
+
+  /**
+   * Stop the signal now
+   */
+  void Stop ();
+
+  /**
+   * \param t1 the start of the interval
+   * \param t2 the end of the interval
+   * \return the fraction of the interval [t1, t2] during which the
+   * signal is on, or zero if the interval is empty
+   */
+  double GetOnFraction (Time t1, Time t2) const;
+
+private:
+  /**
+   * \param t a time
+   * \return the total time during which the signal has been on
+   * between its start and t, in time steps
+   */
+  int64_t GetOnTime (Time t) const;
+
+  Ptr<const SpectrumValue> m_psd; //!< PSD when on
+  Ptr<SpectrumPhy> m_txPhy;       //!< transmitter
+  Ptr<AntennaModel> m_txAntenna;  //!< antenna of the transmitter
+  Time m_period;                  //!< period, zero if continuous
+  Time m_onDuration;              //!< on duration in each period
+  Time m_startTime;               //!< start time
+  Time m_stopTime;                //!< stop time
+};
+
+
+/**
+ * \ingroup spectrum
+ *
+ * The persistent signals perceived by a receiver, used by the
+ * interference models to add the average power of these signals to
+ * each chunk.
+ */
+class PersistentSpectrumSignalList
+{
+public:
+  /**
+   * Add a signal. If the signal is already in the list, its received
+   * PSD is replaced, e.g., after the receiver changed SpectrumModel.
+   *
+   * \param signal the signal
+   * \param rxPsd the PSD of the signal at the receiver when on
+   */
+  void Add (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> rxPsd);
+
+  /**
+   * \return true if there are no signals in the list
+   */
+  bool IsEmpty () const;
+
+  /**
+   * Add to psd the average PSD of the signals over [t1, t2]. Only
+   * the signals using the same SpectrumModel as psd are considered.
+   * Signals which were stopped before t1 are removed from the list.
+   *
+   * \param t1 the start of the interval
+   * \param t2 the end of the interval
+   * \param psd the PSD to which the average PSD is added
+   */
+  void AddAveragePsd (Time t1, Time t2, SpectrumValue& psd);
+
+  /**
+   * Remove all the signals from the list
+   */
+  void Clear ();
+
+private:
+  /// a signal and its PSD at the receiver
+  typedef std::pair<Ptr<const PersistentSpectrumSignal>, Ptr<const SpectrumValue> > Entry;
+  std::list<Entry> m_signals; //!< the signals
+};
+
+} // namespace ns3
+
+#endif /* PERSISTENT_SPECTRUM_SIGNAL_H */
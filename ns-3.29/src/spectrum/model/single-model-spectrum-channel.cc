@@ -76,6 +76,41 @@ SingleModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
 {
   NS_LOG_FUNCTION (this << phy);
   m_phyList.push_back (phy);
+
+  RemoveStoppedPersistentSignals ();
+  for (std::list<Ptr<PersistentSpectrumSignal> >::const_iterator it = m_persistentSignals.begin ();
+       it != m_persistentSignals.end ();
+       ++it)
+    {
+      DeliverPersistentSignal (*it, (*it)->GetPsd (), phy);
+    }
+}
+
+
+void
+SingleModelSpectrumChannel::AddPersistentSignal (Ptr<PersistentSpectrumSignal> signal)
+{
+  NS_LOG_FUNCTION (this << signal);
+  NS_ASSERT_MSG (signal->GetTxPhy (), "NULL txPhy");
+
+  if (m_spectrumModel == 0)
+    {
+      m_spectrumModel = signal->GetPsd ()->GetSpectrumModel ();
+    }
+  else
+    {
+      // all attached SpectrumPhy instances must use the same SpectrumModel
+      NS_ASSERT (*(signal->GetPsd ()->GetSpectrumModel ()) == *m_spectrumModel);
+    }
+
+  RemoveStoppedPersistentSignals ();
+  m_persistentSignals.push_back (signal);
+  for (PhyList::const_iterator rxPhyIterator = m_phyList.begin ();
+       rxPhyIterator != m_phyList.end ();
+       ++rxPhyIterator)
+    {
+      DeliverPersistentSignal (signal, signal->GetPsd (), *rxPhyIterator);
+    }
 }
 
 
@@ -52,6 +52,7 @@ public:
   // inherited from SpectrumChannel
   virtual void AddRx (Ptr<SpectrumPhy> phy);
   virtual void StartTx (Ptr<SpectrumSignalParameters> params);
+  virtual void AddPersistentSignal (Ptr<PersistentSpectrumSignal> signal);
 
 
   // inherited from Channel
@@ -19,8 +19,12 @@
  */
 
 #include <ns3/log.h>
+#include <ns3/simulator.h>
 #include <ns3/double.h>
 #include <ns3/pointer.h>
+#include <ns3/antenna-model.h>
+#include <ns3/angles.h>
+#include <cmath>
 
 #include "spectrum-channel.h"
 
@@ -47,6 +51,7 @@ SpectrumChannel::DoDispose ()
   m_propagationLoss = 0;
   m_propagationDelay = 0;
   m_spectrumPropagationLoss = 0;
+  m_persistentSignals.clear ();
 }
 
 TypeId
@@ -149,5 +154,96 @@ SpectrumChannel::GetSpectrumPropagationLossModel (void)
   return m_spectrumPropagationLoss;
 }
 
+Ptr<PropagationLossModel>
+SpectrumChannel::GetPropagationLossModel (void)
+{
+  NS_LOG_FUNCTION (this);
+  return m_propagationLoss;
+}
+
+double
+SpectrumChannel::GetMaxLossDb (void) const
+{
+  return m_maxLossDb;
+}
+
+void
+SpectrumChannel::AddPersistentSignal (Ptr<PersistentSpectrumSignal> signal)
+{
+  NS_FATAL_ERROR ("persistent signals are not supported by " << GetInstanceTypeId ().GetName ());
+}
+
+void
+SpectrumChannel::DeliverPersistentSignal (Ptr<const PersistentSpectrumSignal> signal,
+                                          Ptr<const SpectrumValue> psd,
+                                          Ptr<SpectrumPhy> receiver)
+{
+  NS_LOG_FUNCTION (this << signal << receiver);
+  if (receiver == signal->GetTxPhy ())
+    {
+      return;
+    }
+  Ptr<SpectrumValue> rxPsd = psd->Copy ();
+  Ptr<MobilityModel> txMobility = signal->GetTxPhy ()->GetMobility ();
+  Ptr<MobilityModel> rxMobility = receiver->GetMobility ();
+  if (txMobility && rxMobility)
+    {
+      double pathLossDb = 0;
+      if (signal->GetTxAntenna () != 0)
+        {
+          Angles txAngles (rxMobility->GetPosition (), txMobility->GetPosition ());
+          double txAntennaGain = signal->GetTxAntenna ()->GetGainDb (txAngles);
+          NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+          pathLossDb -= txAntennaGain;
+        }
+      Ptr<AntennaModel> rxAntenna = receiver->GetRxAntenna ();
+      if (rxAntenna != 0)
+        {
+          Angles rxAngles (txMobility->GetPosition (), rxMobility->GetPosition ());
+          double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+          NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+          pathLossDb -= rxAntennaGain;
+        }
+      if (m_propagationLoss)
+        {
+          double propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, rxMobility);
+          NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+          pathLossDb -= propagationGainDb;
+        }
+      NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
+      m_pathLossTrace (signal->GetTxPhy (), receiver, pathLossDb);
+      if (pathLossDb > m_maxLossDb)
+        {
+          // beyond range
+          return;
+        }
+      *rxPsd *= std::pow (10.0, (-pathLossDb) / 10.0);
+
+      if (m_spectrumPropagationLoss)
+        {
+          rxPsd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxPsd, txMobility, rxMobility);
+        }
+    }
+  receiver->StartRxPersistent (signal, rxPsd);
+}
+
+void
+SpectrumChannel::RemoveStoppedPersistentSignals ()
+{
+  NS_LOG_FUNCTION (this);
+  std::list<Ptr<PersistentSpectrumSignal> >::iterator it = m_persistentSignals.begin ();
+  while (it != m_persistentSignals.end ())
+    {
+      if ((*it)->GetStopTime () <= Simulator::Now ())
+        {
+          it = m_persistentSignals.erase (it);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+}
+
 
 } // namespace
@@ -32,6 +32,8 @@
 #include <ns3/spectrum-phy.h>
 #include <ns3/traced-callback.h>
 #include <ns3/mobility-model.h>
+#include <ns3/persistent-spectrum-signal.h>
+#include <list>
 
 namespace ns3 {
 
@@ -95,6 +97,18 @@ public:
    */
   Ptr<SpectrumPropagationLossModel> GetSpectrumPropagationLossModel (void);
 
+  /**
+   * Get the single-frequency propagation loss model.
+   * \returns a pointer to the propagation loss model.
+   */
+  Ptr<PropagationLossModel> GetPropagationLossModel (void);
+
+  /**
+   * \returns the maximum loss [dB], beyond which signals are not
+   * delivered to the receivers.
+   */
+  double GetMaxLossDb (void) const;
+
 
 
   /**
@@ -121,6 +135,26 @@ public:
    */
   virtual void AddRx (Ptr<SpectrumPhy> phy) = 0;
 
+  /**
+   * Used by attached PHY instances to register a persistent signal on
+   * the channel, i.e., a continuous or periodic signal which lasts
+   * until PersistentSpectrumSignal::Stop is called.
+   *
+   * The received PSD of the signal is computed once for each receiver,
+   * including the receivers added later on, and is passed to
+   * SpectrumPhy::StartRxPersistent. The path loss is evaluated with the
+   * positions of the transmitter and of the receiver at the time the
+   * signal is delivered, and the propagation delay is neglected. This
+   * is meant for background interferers, which would otherwise need
+   * one StartTx per period.
+   *
+   * The default implementation aborts the simulation; it is to be
+   * overridden by the channels supporting persistent signals.
+   *
+   * \param signal the persistent signal
+   */
+  virtual void AddPersistentSignal (Ptr<PersistentSpectrumSignal> signal);
+
   /**
    * TracedCallback signature for path loss calculation events.
    *
@@ -154,6 +188,25 @@ public:
 
 protected:
 
+  /**
+   * Apply antenna gains and propagation losses to a persistent signal,
+   * and pass it to a receiver. Nothing is delivered if the receiver is
+   * the transmitter or if the loss exceeds m_maxLossDb.
+   *
+   * \param signal the persistent signal
+   * \param psd the PSD of the signal, already converted to the
+   * SpectrumModel of the receiver
+   * \param receiver the receiver
+   */
+  void DeliverPersistentSignal (Ptr<const PersistentSpectrumSignal> signal,
+                                Ptr<const SpectrumValue> psd,
+                                Ptr<SpectrumPhy> receiver);
+
+  /**
+   * Remove the persistent signals which have been stopped
+   */
+  void RemoveStoppedPersistentSignals ();
+
   /**
    * The `PathLoss` trace source. Exporting the pointers to the Tx and Rx
    * SpectrumPhy and a pathloss value, in dB.
@@ -194,6 +247,10 @@ protected:
    */
   Ptr<SpectrumPropagationLossModel> m_spectrumPropagationLoss;
 
+  /**
+   * The persistent signals registered on this channel.
+   */
+  std::list<Ptr<PersistentSpectrumSignal> > m_persistentSignals;
 
 };
 
@@ -30,10 +30,12 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("SpectrumConverter");
 
 SpectrumConverter::SpectrumConverter ()
+  : m_contiguousRows (true)
 {
 }
 
 SpectrumConverter::SpectrumConverter (Ptr<const SpectrumModel> fromSpectrumModel, Ptr<const SpectrumModel> toSpectrumModel)
+  : m_contiguousRows (true)
 {
   NS_LOG_FUNCTION (this);
   m_fromSpectrumModel = fromSpectrumModel;
@@ -43,6 +45,8 @@ SpectrumConverter::SpectrumConverter (Ptr<const SpectrumModel> fromSpectrumModel
   for (Bands::const_iterator toit = toSpectrumModel->Begin (); toit != toSpectrumModel->End (); ++toit)
     {
       size_t colInd = 0;
+      size_t rowBegin = rowPtr;
+      m_conversionRowFirstCol.push_back (0);
       for (Bands::const_iterator fromit = fromSpectrumModel->Begin (); fromit != fromSpectrumModel->End (); ++fromit)
         {
           double c = GetCoefficient (*fromit, *toit);
@@ -52,6 +56,14 @@ SpectrumConverter::SpectrumConverter (Ptr<const SpectrumModel> fromSpectrumModel
                             << " = " << c);
           if (c > 0)
             {
+              if (rowPtr == rowBegin)
+                {
+                  m_conversionRowFirstCol.back () = colInd;
+                }
+              else if (colInd != m_conversionColInd.back () + 1)
+                {
+                  m_contiguousRows = false;
+                }
               m_conversionMatrix.push_back (c);
               m_conversionColInd.push_back (colInd);
               rowPtr++;
@@ -78,31 +90,110 @@ double SpectrumConverter::GetCoefficient (const BandInfo& from, const BandInfo&
 Ptr<SpectrumValue>
 SpectrumConverter::Convert (Ptr<const SpectrumValue> fvvf) const
 {
-  NS_ASSERT ( *(fvvf->GetSpectrumModel ()) == *m_fromSpectrumModel);
-
   Ptr<SpectrumValue> tvvf = Create<SpectrumValue> (m_toSpectrumModel);
+  Convert (*fvvf, *tvvf);
+  return tvvf;
+}
+
+void
+SpectrumConverter::Convert (const SpectrumValue& fvvf, SpectrumValue& tvvf) const
+{
+  NS_ASSERT ( *(fvvf.GetSpectrumModel ()) == *m_fromSpectrumModel);
+  NS_ASSERT ( *(tvvf.GetSpectrumModel ()) == *m_toSpectrumModel);
+  if (m_conversionRowPtr.empty ())
+    {
+      return;
+    }
+  DoConvert (&(*fvvf.ConstValuesBegin ()), &(*tvvf.ValuesBegin ()));
+}
 
-  Values::iterator tvit = tvvf->ValuesBegin ();
+void
+SpectrumConverter::DoConvert (const double* x, double* y) const
+{
+  const double* coeff = m_conversionMatrix.data ();
+  const size_t* rowPtr = m_conversionRowPtr.data ();
+  const size_t nRows = m_conversionRowPtr.size ();
   size_t i = 0; // Index of conversion coefficient
 
-  for (std::vector<size_t>::const_iterator convIt = m_conversionRowPtr.begin ();
-       convIt != m_conversionRowPtr.end ();
-       ++convIt)
+  if (m_contiguousRows)
+    {
+      // Bands are sorted in all the SpectrumModels we know of, hence the
+      // coefficients of each row multiply a contiguous slice of the input
+      // and no indirect addressing through the column indices is needed.
+      const size_t* firstCol = m_conversionRowFirstCol.data ();
+      for (size_t row = 0; row < nRows; ++row)
+        {
+          const size_t n = rowPtr[row] - i;
+          const double* xr = x + firstCol[row];
+          const double* cr = coeff + i;
+          double sum = 0;
+          for (size_t k = 0; k < n; ++k)
+            {
+              sum += xr[k] * cr[k];
+            }
+          y[row] = sum;
+          i += n;
+        }
+    }
+  else
     {
-      double sum = 0;
-      while (i < *convIt)
+      const size_t* colInd = m_conversionColInd.data ();
+      for (size_t row = 0; row < nRows; ++row)
         {
-          sum += (*fvvf)[m_conversionColInd.at (i)] * m_conversionMatrix.at (i);
-          i++;
+          const size_t end = rowPtr[row];
+          double sum = 0;
+          for (; i < end; ++i)
+            {
+              sum += x[colInd[i]] * coeff[i];
+            }
+          y[row] = sum;
         }
-      *tvit = sum;
-      ++tvit;
     }
+}
 
-  return tvvf;
+Ptr<const SpectrumModel>
+SpectrumConverter::GetFromSpectrumModel (void) const
+{
+  return m_fromSpectrumModel;
+}
+
+Ptr<const SpectrumModel>
+SpectrumConverter::GetToSpectrumModel (void) const
+{
+  return m_toSpectrumModel;
+}
+
+SpectrumConverter::ConverterCache_t&
+SpectrumConverter::GetCache (void)
+{
+  static ConverterCache_t cache;
+  return cache;
 }
 
+Ptr<const SpectrumConverter>
+SpectrumConverter::Get (Ptr<const SpectrumModel> fromSpectrumModel, Ptr<const SpectrumModel> toSpectrumModel)
+{
+  NS_LOG_FUNCTION (fromSpectrumModel << toSpectrumModel);
+  ConverterCache_t& cache = GetCache ();
+  std::pair<SpectrumModelUid_t, SpectrumModelUid_t> key (fromSpectrumModel->GetUid (), toSpectrumModel->GetUid ());
+  ConverterCache_t::const_iterator it = cache.find (key);
+  if (it != cache.end ())
+    {
+      NS_LOG_LOGIC ("reusing converter between SpectrumModelUid " << key.first << " and " << key.second);
+      return it->second;
+    }
+  NS_LOG_LOGIC ("creating converter between SpectrumModelUid " << key.first << " and " << key.second);
+  Ptr<const SpectrumConverter> converter = Create<SpectrumConverter> (fromSpectrumModel, toSpectrumModel);
+  cache.insert (std::make_pair (key, converter));
+  return converter;
+}
 
+void
+SpectrumConverter::ClearCache (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  GetCache ().clear ();
+}
 
 
 
@@ -22,6 +22,7 @@
 #define SPECTRUM_CONVERTER_H
 
 #include <ns3/spectrum-value.h>
+#include <map>
 
 
 namespace ns3 {
@@ -65,8 +66,65 @@ public:
    */
   Ptr<SpectrumValue> Convert (Ptr<const SpectrumValue> vvf) const;
 
+  /**
+   * Convert a particular ValueVsFreq instance, writing the result into
+   * an already allocated destination. No memory is allocated, hence
+   * this is the preferred variant when the same destination can be
+   * reused for many conversions.
+   *
+   * @param vvf the ValueVsFreq instance to be converted
+   * @param dst the destination, which must be defined over the
+   * SpectrumModel this converter converts to
+   */
+  void Convert (const SpectrumValue& vvf, SpectrumValue& dst) const;
+
+  /**
+   * Get the SpectrumConverter between two SpectrumModel instances.
+   * Converters are built on first request and then shared by all the
+   * callers (e.g., all the MultiModelSpectrumChannel instances) for
+   * the rest of the simulation.
+   *
+   * @param fromSpectrumModel the SpectrumModel to convert from
+   * @param toSpectrumModel the SpectrumModel to convert to
+   *
+   * @return the shared converter
+   */
+  static Ptr<const SpectrumConverter> Get (Ptr<const SpectrumModel> fromSpectrumModel, Ptr<const SpectrumModel> toSpectrumModel);
+
+  /**
+   * Remove all the converters from the shared cache.
+   */
+  static void ClearCache (void);
+
+  /**
+   * @return the SpectrumModel this converter converts from
+   */
+  Ptr<const SpectrumModel> GetFromSpectrumModel (void) const;
+
+  /**
+   * @return the SpectrumModel this converter converts to
+   */
+  Ptr<const SpectrumModel> GetToSpectrumModel (void) const;
 
 private:
+  /**
+   * Container: (from SpectrumModelUid_t, to SpectrumModelUid_t), SpectrumConverter
+   */
+  typedef std::map<std::pair<SpectrumModelUid_t, SpectrumModelUid_t>, Ptr<const SpectrumConverter> > ConverterCache_t;
+
+  /**
+   * @return the process-wide cache of converters
+   */
+  static ConverterCache_t& GetCache (void);
+
+  /**
+   * Sparse matrix-vector product y = M x, with M being the conversion matrix
+   *
+   * @param x the values to convert from
+   * @param y the values to convert to
+   */
+  void DoConvert (const double* x, double* y) const;
+
   /**
    * Calculate the coefficient for value conversion between elements
    *
@@ -81,6 +139,8 @@ private:
   std::vector<double> m_conversionMatrix; //!< matrix of conversion coefficients stored in Compressed Row Storage format
   std::vector<size_t> m_conversionRowPtr; //!< offset of rows in m_conversionMatrix
   std::vector<size_t> m_conversionColInd; //!< column of each non-zero element in m_conversionMatrix
+  std::vector<size_t> m_conversionRowFirstCol; //!< column of the first non-zero element of each row
+  bool m_contiguousRows; //!< true if the non-zero elements of each row lie on consecutive columns
 
   Ptr<const SpectrumModel> m_fromSpectrumModel;  //!<  the SpectrumModel this SpectrumConverter instance can convert from
   Ptr<const SpectrumModel> m_toSpectrumModel;    //!<  the SpectrumModel this SpectrumConverter instance can convert to
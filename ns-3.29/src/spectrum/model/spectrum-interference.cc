@@ -64,6 +64,7 @@ SpectrumInterference::DoDispose ()
   m_allSignals = 0;
   m_noise = 0;
   m_errorModel = 0;
+  m_persistentSignals.Clear ();
   Object::DoDispose ();
 }
 
@@ -102,6 +103,16 @@ SpectrumInterference::AddSignal (Ptr<const SpectrumValue> spd, const Time durati
 }
 
 
+void
+SpectrumInterference::AddPersistentSignal (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> spd)
+{
+  NS_LOG_FUNCTION (this << signal << *spd);
+  // the contribution of the signal to each chunk depends only on the
+  // time during which it is on, so there is no need to split the chunk
+  m_persistentSignals.Add (signal, spd);
+}
+
+
 void
 SpectrumInterference::DoAddSignal  (Ptr<const SpectrumValue> spd)
 {
@@ -131,7 +142,12 @@ SpectrumInterference::ConditionallyEvaluateChunk ()
   NS_LOG_LOGIC ("if condition: " << condition);
   if (condition)
     {
-      SpectrumValue sinr = (*m_rxSignal) / ((*m_allSignals) - (*m_rxSignal) + (*m_noise));
+      SpectrumValue interf = (*m_allSignals) - (*m_rxSignal) + (*m_noise);
+      if (!m_persistentSignals.IsEmpty ())
+        {
+          m_persistentSignals.AddAveragePsd (m_lastChangeTime, Now (), interf);
+        }
+      SpectrumValue sinr = (*m_rxSignal) / interf;
       Time duration = Now () - m_lastChangeTime;
       NS_LOG_LOGIC ("calling m_errorModel->EvaluateChunk (sinr, duration)");
       m_errorModel->EvaluateChunk (sinr, duration);
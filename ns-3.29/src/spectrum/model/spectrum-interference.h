@@ -26,6 +26,7 @@
 #include <ns3/packet.h>
 #include <ns3/nstime.h>
 #include <ns3/spectrum-value.h>
+#include <ns3/persistent-spectrum-signal.h>
 
 namespace ns3 {
 
@@ -99,6 +100,16 @@ public:
    */
   void AddSignal (Ptr<const SpectrumValue> spd, const Time duration);
 
+  /**
+   * Notify that a persistent signal is being perceived in the
+   * medium. The average power of the signal over each chunk is added
+   * to the interference, until the signal is stopped.
+   *
+   * @param signal the persistent signal
+   * @param spd the power spectral density of the signal when on
+   */
+  void AddPersistentSignal (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> spd);
+
   /**
    * Set the Noise Power Spectral Density
    *
@@ -143,6 +154,8 @@ private:
 
   Ptr<const SpectrumValue> m_noise; //!< Noise spectral power density
 
+  PersistentSpectrumSignalList m_persistentSignals; //!< Persistent signals perceived in the medium
+
   Time m_lastChangeTime;     //!< the time of the last change in m_TotalPower
 
   Ptr<SpectrumErrorModel> m_errorModel; //!< Error model
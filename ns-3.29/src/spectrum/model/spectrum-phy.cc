@@ -23,6 +23,7 @@
 #include <ns3/mobility-model.h>
 #include <ns3/spectrum-value.h>
 #include <ns3/spectrum-channel.h>
+#include <ns3/persistent-spectrum-signal.h>
 #include <ns3/log.h>
 
 namespace ns3 {
@@ -52,5 +53,12 @@ SpectrumPhy::~SpectrumPhy ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+SpectrumPhy::StartRxPersistent (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> rxPsd)
+{
+  NS_LOG_FUNCTION (this << signal << rxPsd);
+  NS_LOG_LOGIC ("ignoring persistent signal");
+}
+
 
 } // namespace
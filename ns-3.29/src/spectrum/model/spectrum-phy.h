@@ -35,6 +35,7 @@ class SpectrumValue;
 class SpectrumModel;
 class NetDevice;
 struct SpectrumSignalParameters;
+class PersistentSpectrumSignal;
 
 /**
  * \ingroup spectrum
@@ -112,6 +113,18 @@ public:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params) = 0;
 
+  /**
+   * Notify the SpectrumPhy instance of a persistent signal, which
+   * lasts until the signal is stopped. The default implementation
+   * ignores the signal; SpectrumPhy instances that model interference
+   * should override this method.
+   *
+   * @param signal the persistent signal
+   * @param rxPsd the power spectral density of the signal at the
+   * receiver when the signal is on
+   */
+  virtual void StartRxPersistent (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> rxPsd);
+
 private:
   /**
    * \brief Copy constructor
@@ -26,6 +26,7 @@
 #include <ns3/integer.h>
 #include <ns3/string.h>
 #include <ns3/pointer.h>
+#include <ns3/boolean.h>
 #include <ns3/isotropic-antenna-model.h>
 #include <ns3/antenna-model.h>
 #include <cmath>
@@ -49,7 +50,8 @@ TvSpectrumTransmitter::TvSpectrumTransmitter ()
     m_txPsd (0),
     m_startingTime (Seconds (0)),
     m_transmitDuration (Seconds (0.2)),
-    m_active (false)
+    m_active (false),
+    m_persistent (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -118,6 +120,13 @@ TvSpectrumTransmitter::GetTypeId(void)
                    TimeValue (Seconds (0.2)),
                    MakeTimeAccessor (&TvSpectrumTransmitter::m_transmitDuration),
                    MakeTimeChecker ())
+    .AddAttribute ("Persistent",
+                   "If true, the TV signal is registered on the channel as a "
+                   "persistent signal lasting TransmitDuration, rather than "
+                   "being transmitted as a single signal.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TvSpectrumTransmitter::m_persistent),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -562,6 +571,15 @@ TvSpectrumTransmitter::SetupTx ()
 {
   NS_LOG_FUNCTION (this);
   NS_ASSERT (m_txPsd);
+  if (m_persistent)
+    {
+      m_persistentSignal = Create<PersistentSpectrumSignal> (m_txPsd->Copy (), GetObject<SpectrumPhy> (),
+                                                             m_antenna, Time (0), Time (0));
+      m_channel->AddPersistentSignal (m_persistentSignal);
+      m_stopEvent.Cancel ();
+      m_stopEvent = Simulator::Schedule (m_transmitDuration, &TvSpectrumTransmitter::StopPersistentSignal, this);
+      return;
+    }
   Ptr<SpectrumSignalParameters> signal = Create<SpectrumSignalParameters> ();
   signal->duration = m_transmitDuration;
   signal->psd = m_txPsd;
@@ -578,7 +596,7 @@ TvSpectrumTransmitter::Start ()
     {
       NS_LOG_LOGIC ("starting TV transmitter");
       m_active = true;
-      Simulator::Schedule (m_startingTime, &TvSpectrumTransmitter::SetupTx, this);
+      m_startEvent = Simulator::Schedule (m_startingTime, &TvSpectrumTransmitter::SetupTx, this);
     }
 }
 
@@ -587,6 +605,20 @@ TvSpectrumTransmitter::Stop ()
 {
   NS_LOG_FUNCTION (this);
   m_active = false;
+  m_startEvent.Cancel ();
+  StopPersistentSignal ();
+}
+
+void
+TvSpectrumTransmitter::StopPersistentSignal ()
+{
+  NS_LOG_FUNCTION (this);
+  m_stopEvent.Cancel ();
+  if (m_persistentSignal)
+    {
+      m_persistentSignal->Stop ();
+      m_persistentSignal = 0;
+    }
 }
 
 } // namespace ns3
@@ -28,6 +28,8 @@
 #include <ns3/spectrum-signal-parameters.h>
 #include <ns3/mobility-model.h>
 #include <ns3/net-device.h>
+#include <ns3/persistent-spectrum-signal.h>
+#include <ns3/event-id.h>
 
 namespace ns3
 {
@@ -42,6 +44,11 @@ namespace ns3
  *
  * This PHY model supports a single antenna model instance which is
  * used for transmission (this PHY model never receives).
+ *
+ * If the Persistent attribute is true, the TV signal is registered on
+ * the channel as a continuous PersistentSpectrumSignal, which also
+ * reaches the receivers attached to the channel after the transmission
+ * started.
  */
 class TvSpectrumTransmitter : public SpectrumPhy
 {
@@ -136,6 +143,9 @@ private:
   /** Sets up signal to be transmitted */
   virtual void SetupTx ();
 
+  /** Stops the persistent signal, if any */
+  void StopPersistentSignal ();
+
   enum TvType m_tvType; //!< Type of TV transmitter
   double m_startFrequency; //!< Start frequency (in Hz) of TV transmitter's signal
   double m_channelBandwidth; //!< Bandwidth (in Hz) of TV transmitter's signal
@@ -144,6 +154,10 @@ private:
   Time m_startingTime; //!< Timepoint after simulation begins that TV transmitter will begin transmitting
   Time m_transmitDuration; //!< Length of time that TV transmitter will transmit for
   bool m_active; //!< True if TV transmitter is transmitting
+  bool m_persistent; //!< True if the signal is registered as a persistent signal
+  Ptr<PersistentSpectrumSignal> m_persistentSignal; //!< Persistent signal, if transmitting
+  EventId m_startEvent; //!< Event setting up the transmission
+  EventId m_stopEvent; //!< Event stopping the persistent signal
 
 };
 
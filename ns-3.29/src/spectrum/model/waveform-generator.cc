@@ -23,6 +23,7 @@
 #include <ns3/log.h>
 #include <ns3/simulator.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
 #include <ns3/packet-burst.h>
 #include <ns3/antenna-model.h>
 
@@ -39,7 +40,8 @@ WaveformGenerator::WaveformGenerator ()
   m_netDevice (0),
   m_channel (0),
   m_txPowerSpectralDensity (0),
-  m_startTime (Seconds (0))
+  m_startTime (Seconds (0)),
+  m_persistent (false)
 {
 
 }
@@ -62,6 +64,11 @@ WaveformGenerator::DoDispose (void)
     {
       m_nextWave.Cancel ();
     }
+  if (m_persistentSignal)
+    {
+      m_persistentSignal->Stop ();
+      m_persistentSignal = 0;
+    }
 }
 
 TypeId
@@ -83,6 +90,14 @@ WaveformGenerator::GetTypeId (void)
                    MakeDoubleAccessor (&WaveformGenerator::SetDutyCycle,
                                        &WaveformGenerator::GetDutyCycle),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("Persistent",
+                   "If true, the waveform is registered once on the channel as a "
+                   "persistent signal when the generator is started, rather than "
+                   "being transmitted once per period. Receivers account for the "
+                   "average power of the waveform over each interference chunk.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&WaveformGenerator::m_persistent),
+                   MakeBooleanChecker ())
     .AddTraceSource ("TxStart",
                      "Trace fired when a new transmission is started",
                      MakeTraceSourceAccessor (&WaveformGenerator::m_phyTxStartTrace),
@@ -218,6 +233,20 @@ void
 WaveformGenerator::Start ()
 {
   NS_LOG_FUNCTION (this);
+  if (m_persistent)
+    {
+      if (!m_persistentSignal)
+        {
+          NS_LOG_LOGIC ("generator was not active, now starting persistent signal");
+          m_startTime = Now ();
+          Time onDuration = Time (m_period.GetTimeStep () * m_dutyCycle);
+          m_persistentSignal = Create<PersistentSpectrumSignal> (m_txPowerSpectralDensity->Copy (), GetObject<SpectrumPhy> (),
+                                                                 m_antenna, m_period, onDuration);
+          m_phyTxStartTrace (0);
+          m_channel->AddPersistentSignal (m_persistentSignal);
+        }
+      return;
+    }
   if (!m_nextWave.IsRunning ())
     {
       NS_LOG_LOGIC ("generator was not active, now starting");
@@ -236,5 +265,11 @@ WaveformGenerator::Stop ()
       m_nextWave.Cancel ();
 
     }
+  if (m_persistentSignal)
+    {
+      m_persistentSignal->Stop ();
+      m_persistentSignal = 0;
+      m_phyTxEndTrace (0);
+    }
 }
 } // namespace ns3
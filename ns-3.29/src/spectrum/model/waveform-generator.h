@@ -31,6 +31,7 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/trace-source-accessor.h>
 #include <ns3/event-id.h>
+#include <ns3/persistent-spectrum-signal.h>
 
 namespace ns3 {
 
@@ -49,6 +50,14 @@ class AntennaModel;
  * This PHY model supports a single antenna model instance which is
  * used for both transmission and reception (though received signals
  * are discarded by this PHY).
+ *
+ * If the Persistent attribute is true, the waveform is registered
+ * once on the channel as a PersistentSpectrumSignal when the generator
+ * is started, instead of being transmitted once per period. The
+ * interference models of the receivers then account for the average
+ * power of the waveform, and the TxStart and TxEnd traces are fired
+ * only when the generator is started and stopped. This is much cheaper
+ * for generators used as background interferers.
  */
 class WaveformGenerator : public SpectrumPhy
 {
@@ -148,6 +157,8 @@ private:
   double m_dutyCycle; //!< Duty Cycle (should be in [0,1])
   Time m_startTime;   //!< Start time
   EventId m_nextWave; //!< Next waveform generation event
+  bool m_persistent;  //!< Register the waveform as a persistent signal
+  Ptr<PersistentSpectrumSignal> m_persistentSignal; //!< Persistent signal, if started
 
   TracedCallback<Ptr<const Packet> > m_phyTxStartTrace; //!< TracedCallback: Tx start
   TracedCallback<Ptr<const Packet> > m_phyTxEndTrace;   //!< TracedCallback: Tx end
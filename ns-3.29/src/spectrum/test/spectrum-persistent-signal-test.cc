@@ -0,0 +1,314 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/core-module.h>
+#include <ns3/test.h>
+#include <ns3/spectrum-module.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/constant-position-mobility-model.h>
+
+
+NS_LOG_COMPONENT_DEFINE ("SpectrumPersistentSignalTest");
+
+using namespace ns3;
+
+
+/**
+ * Check the fraction of time during which a persistent signal is on
+ */
+class PersistentSignalOnFractionTestCase : public TestCase
+{
+public:
+  PersistentSignalOnFractionTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /// create the signal
+  void CreateSignal ();
+  /// check the on fractions while the signal is active
+  void CheckActive ();
+  /// check the on fractions after the signal has been stopped
+  void CheckStopped ();
+
+  Ptr<PersistentSpectrumSignal> m_signal; ///< the signal under test
+};
+
+PersistentSignalOnFractionTestCase::PersistentSignalOnFractionTestCase ()
+  : TestCase ("persistent signal on fraction")
+{
+}
+
+void
+PersistentSignalOnFractionTestCase::CreateSignal ()
+{
+  Ptr<SpectrumValue> psd = MicrowaveOvenSpectrumValueHelper::CreatePowerSpectralDensityMwo1 ();
+  m_signal = Create<PersistentSpectrumSignal> (psd, Ptr<SpectrumPhy> (0), Ptr<AntennaModel> (0),
+                                               MilliSeconds (10), MilliSeconds (3));
+}
+
+void
+PersistentSignalOnFractionTestCase::CheckActive ()
+{
+  // started at 1 s, on during the first 3 ms of every 10 ms
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_signal->GetOnFraction (Seconds (0), Seconds (1)), 0, 1e-12, "signal on before start");
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_signal->GetOnFraction (Seconds (1), MilliSeconds (1010)), 0.3, 1e-12, "wrong fraction over a period");
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_signal->GetOnFraction (MilliSeconds (1002), MilliSeconds (1005)), 1.0 / 3, 1e-12, "wrong fraction within a period");
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_signal->GetOnFraction (Seconds (1), MilliSeconds (1025)), 0.36, 1e-12, "wrong fraction over several periods");
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_signal->GetOnFraction (MilliSeconds (990), MilliSeconds (1010)), 0.15, 1e-12, "wrong fraction across the start");
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_signal->GetOnFraction (MilliSeconds (1004), MilliSeconds (1010)), 0, 1e-12, "signal on while off");
+  m_signal->Stop ();
+}
+
+void
+PersistentSignalOnFractionTestCase::CheckStopped ()
+{
+  // stopped at 2 s
+  NS_TEST_EXPECT_MSG_EQ (m_signal->GetStopTime (), Seconds (2), "wrong stop time");
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_signal->GetOnFraction (MilliSeconds (1990), MilliSeconds (2010)), 0.15, 1e-12, "wrong fraction across the stop");
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_signal->GetOnFraction (Seconds (2), Seconds (3)), 0, 1e-12, "signal on after stop");
+}
+
+void
+PersistentSignalOnFractionTestCase::DoRun (void)
+{
+  Simulator::Schedule (Seconds (1), &PersistentSignalOnFractionTestCase::CreateSignal, this);
+  Simulator::Schedule (Seconds (2), &PersistentSignalOnFractionTestCase::CheckActive, this);
+  Simulator::Schedule (Seconds (2.5), &PersistentSignalOnFractionTestCase::CheckStopped, this);
+  Simulator::Run ();
+  m_signal = 0;
+  Simulator::Destroy ();
+}
+
+
+/**
+ * SpectrumPhy recording the persistent signals it receives
+ */
+class PersistentSignalTestPhy : public SpectrumPhy
+{
+public:
+  PersistentSignalTestPhy ();
+
+  // inherited from SpectrumPhy
+  void SetDevice (Ptr<NetDevice> d);
+  Ptr<NetDevice> GetDevice () const;
+  void SetMobility (Ptr<MobilityModel> m);
+  Ptr<MobilityModel> GetMobility ();
+  void SetChannel (Ptr<SpectrumChannel> c);
+  Ptr<const SpectrumModel> GetRxSpectrumModel () const;
+  Ptr<AntennaModel> GetRxAntenna ();
+  void StartRx (Ptr<SpectrumSignalParameters> params);
+  void StartRxPersistent (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> rxPsd);
+
+  uint32_t m_numRx;                  ///< number of signals received
+  uint32_t m_numRxPersistent;        ///< number of persistent signals received
+  Ptr<const SpectrumValue> m_rxPsd;  ///< PSD of the last persistent signal received
+
+private:
+  Ptr<MobilityModel> m_mobility;     ///< mobility model
+};
+
+PersistentSignalTestPhy::PersistentSignalTestPhy ()
+  : m_numRx (0),
+    m_numRxPersistent (0)
+{
+}
+
+void
+PersistentSignalTestPhy::SetDevice (Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+PersistentSignalTestPhy::GetDevice () const
+{
+  return 0;
+}
+
+void
+PersistentSignalTestPhy::SetMobility (Ptr<MobilityModel> m)
+{
+  m_mobility = m;
+}
+
+Ptr<MobilityModel>
+PersistentSignalTestPhy::GetMobility ()
+{
+  return m_mobility;
+}
+
+void
+PersistentSignalTestPhy::SetChannel (Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+PersistentSignalTestPhy::GetRxSpectrumModel () const
+{
+  return 0;
+}
+
+Ptr<AntennaModel>
+PersistentSignalTestPhy::GetRxAntenna ()
+{
+  return 0;
+}
+
+void
+PersistentSignalTestPhy::StartRx (Ptr<SpectrumSignalParameters> params)
+{
+  ++m_numRx;
+}
+
+void
+PersistentSignalTestPhy::StartRxPersistent (Ptr<const PersistentSpectrumSignal> signal, Ptr<const SpectrumValue> rxPsd)
+{
+  ++m_numRxPersistent;
+  m_rxPsd = rxPsd;
+}
+
+
+/**
+ * Check that a persistent WaveformGenerator is delivered once to each
+ * receiver, including the receivers attached after it started
+ */
+class PersistentSignalChannelTestCase : public TestCase
+{
+public:
+  PersistentSignalChannelTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PersistentSignalChannelTestCase::PersistentSignalChannelTestCase ()
+  : TestCase ("persistent signal delivery")
+{
+}
+
+void
+PersistentSignalChannelTestCase::DoRun (void)
+{
+  Ptr<SpectrumValue> txPsd = MicrowaveOvenSpectrumValueHelper::CreatePowerSpectralDensityMwo1 ();
+
+  Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel> ();
+  Ptr<FixedRssLossModel> loss = CreateObject<FixedRssLossModel> ();
+  loss->SetRss (-30);
+  channel->AddPropagationLossModel (loss);
+
+  Ptr<WaveformGenerator> wave = CreateObject<WaveformGenerator> ();
+  wave->SetAttribute ("Persistent", BooleanValue (true));
+  wave->SetAttribute ("Period", TimeValue (MilliSeconds (10)));
+  wave->SetAttribute ("DutyCycle", DoubleValue (0.5));
+  wave->SetTxPowerSpectralDensity (txPsd);
+  wave->SetChannel (channel);
+  wave->SetMobility (CreateObject<ConstantPositionMobilityModel> ());
+
+  Ptr<PersistentSignalTestPhy> before = CreateObject<PersistentSignalTestPhy> ();
+  before->SetMobility (CreateObject<ConstantPositionMobilityModel> ());
+  channel->AddRx (before);
+
+  Ptr<PersistentSignalTestPhy> after = CreateObject<PersistentSignalTestPhy> ();
+  after->SetMobility (CreateObject<ConstantPositionMobilityModel> ());
+  Ptr<PersistentSignalTestPhy> stopped = CreateObject<PersistentSignalTestPhy> ();
+  stopped->SetMobility (CreateObject<ConstantPositionMobilityModel> ());
+
+  Simulator::Schedule (Seconds (1), &WaveformGenerator::Start, wave);
+  Simulator::Schedule (Seconds (2), &SpectrumChannel::AddRx, channel, after);
+  Simulator::Schedule (Seconds (3), &WaveformGenerator::Stop, wave);
+  Simulator::Schedule (Seconds (4), &SpectrumChannel::AddRx, channel, stopped);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (before->m_numRxPersistent, 1, "persistent signal not delivered to existing receiver");
+  NS_TEST_EXPECT_MSG_EQ (after->m_numRxPersistent, 1, "persistent signal not delivered to new receiver");
+  NS_TEST_EXPECT_MSG_EQ (stopped->m_numRxPersistent, 0, "stopped signal delivered");
+  NS_TEST_EXPECT_MSG_EQ (before->m_numRx + after->m_numRx, 0, "persistent signal transmitted with StartTx");
+  SpectrumValue expected = (*txPsd) * 1e-3;
+  for (uint32_t i = 0; i < expected.GetSpectrumModel ()->GetNumBands (); ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL ((*before->m_rxPsd)[i], expected[i], expected[i] * 1e-9, "wrong received PSD");
+      NS_TEST_EXPECT_MSG_EQ_TOL ((*after->m_rxPsd)[i], expected[i], expected[i] * 1e-9, "wrong received PSD");
+    }
+
+  channel->Dispose ();
+  wave->Dispose ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Check the average PSD of a list of persistent signals
+ */
+class PersistentSignalListTestCase : public TestCase
+{
+public:
+  PersistentSignalListTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PersistentSignalListTestCase::PersistentSignalListTestCase ()
+  : TestCase ("persistent signal average PSD")
+{
+}
+
+void
+PersistentSignalListTestCase::DoRun (void)
+{
+  Ptr<SpectrumValue> psd = MicrowaveOvenSpectrumValueHelper::CreatePowerSpectralDensityMwo1 ();
+  Ptr<PersistentSpectrumSignal> periodic = Create<PersistentSpectrumSignal> (psd, Ptr<SpectrumPhy> (0), Ptr<AntennaModel> (0),
+                                                                             MilliSeconds (4), MilliSeconds (1));
+  Ptr<PersistentSpectrumSignal> continuous = Create<PersistentSpectrumSignal> (psd, Ptr<SpectrumPhy> (0), Ptr<AntennaModel> (0),
+                                                                               Time (0), Time (0));
+
+  PersistentSpectrumSignalList list;
+  NS_TEST_EXPECT_MSG_EQ (list.IsEmpty (), true, "list not empty");
+  list.Add (periodic, psd);
+  list.Add (continuous, Create<SpectrumValue> (*psd * 2));
+  // adding the same signal again replaces its PSD
+  list.Add (continuous, psd);
+  NS_TEST_EXPECT_MSG_EQ (list.IsEmpty (), false, "list empty");
+
+  SpectrumValue average (psd->GetSpectrumModel ());
+  list.AddAveragePsd (Seconds (0), MilliSeconds (8), average);
+  SpectrumValue expected = (*psd) * 1.25;
+  for (uint32_t i = 0; i < expected.GetSpectrumModel ()->GetNumBands (); ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (average[i], expected[i], expected[i] * 1e-9, "wrong average PSD");
+    }
+
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Test suite for persistent spectrum signals
+ */
+class PersistentSignalTestSuite : public TestSuite
+{
+public:
+  PersistentSignalTestSuite ();
+};
+
+PersistentSignalTestSuite::PersistentSignalTestSuite ()
+  : TestSuite ("spectrum-persistent-signal", UNIT)
+{
+  AddTestCase (new PersistentSignalOnFractionTestCase, TestCase::QUICK);
+  AddTestCase (new PersistentSignalChannelTestCase, TestCase::QUICK);
+  AddTestCase (new PersistentSignalListTestCase, TestCase::QUICK);
+}
+
+static PersistentSignalTestSuite g_persistentSignalTestSuite;
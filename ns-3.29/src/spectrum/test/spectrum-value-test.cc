@@ -328,6 +328,13 @@ SpectrumConverterTestSuite::SpectrumConverterTestSuite ()
 //   NS_LOG_LOGIC(*res);
   AddTestCase (new SpectrumValueTestCase (t21b, *res, ""), TestCase::QUICK);
 
+  SpectrumValue r21b (sof1);
+  c21.Convert (*v2b, r21b);
+  AddTestCase (new SpectrumValueTestCase (t21b, r21b, "in-place conversion"), TestCase::QUICK);
+
+  Ptr<const SpectrumConverter> s21 = SpectrumConverter::Get (sof2, sof1);
+  res = s21->Convert (v2b);
+  AddTestCase (new SpectrumValueTestCase (t21b, *res, "shared converter"), TestCase::QUICK);
 
 }
 
@@ -23,6 +23,10 @@
 #include <ns3/spectrum-value.h>
 #include <ns3/enum.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
+#include <ns3/nstime.h>
+#include <ns3/simulator.h>
+#include <ns3/single-model-spectrum-channel.h>
 #include <ns3/tv-spectrum-transmitter.h>
 
 /**
@@ -154,6 +158,72 @@ TvSpectrumTransmitterTestCase::DoRun (void)
 }
 
 
+/**
+ * SpectrumChannel recording the persistent signals registered on it
+ */
+class TvPersistentSignalTestChannel : public SingleModelSpectrumChannel
+{
+public:
+  virtual void AddPersistentSignal (Ptr<PersistentSpectrumSignal> signal);
+
+  std::vector< Ptr<PersistentSpectrumSignal> > m_signals; ///< the signals registered
+};
+
+void
+TvPersistentSignalTestChannel::AddPersistentSignal (Ptr<PersistentSpectrumSignal> signal)
+{
+  m_signals.push_back (signal);
+  SingleModelSpectrumChannel::AddPersistentSignal (signal);
+}
+
+
+/**
+ * Check that a persistent TV transmitter which is stopped and started
+ * again transmits for TransmitDuration after the restart, rather than
+ * being stopped by the end of the first transmission
+ */
+class TvSpectrumTransmitterRestartTestCase : public TestCase
+{
+public:
+  TvSpectrumTransmitterRestartTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+TvSpectrumTransmitterRestartTestCase::TvSpectrumTransmitterRestartTestCase ()
+  : TestCase ("persistent TV transmitter stopped and started again")
+{
+}
+
+void
+TvSpectrumTransmitterRestartTestCase::DoRun (void)
+{
+  Ptr<TvPersistentSignalTestChannel> channel = CreateObject<TvPersistentSignalTestChannel> ();
+  Ptr<TvSpectrumTransmitter> phy = CreateObject<TvSpectrumTransmitter> ();
+  phy->SetAttribute ("Persistent", BooleanValue (true));
+  phy->SetAttribute ("TransmitDuration", TimeValue (Seconds (2)));
+  phy->SetChannel (channel);
+  phy->CreateTvPsd ();
+
+  Simulator::Schedule (Seconds (1), &TvSpectrumTransmitter::Start, phy);
+  Simulator::Schedule (Seconds (2), &TvSpectrumTransmitter::Stop, phy);
+  Simulator::Schedule (Seconds (2.5), &TvSpectrumTransmitter::Start, phy);
+  // stopped before the transmission is set up
+  Simulator::Schedule (Seconds (6), &TvSpectrumTransmitter::Start, phy);
+  Simulator::Schedule (Seconds (6), &TvSpectrumTransmitter::Stop, phy);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (channel->m_signals.size (), 2, "wrong number of transmissions");
+  NS_TEST_EXPECT_MSG_EQ (channel->m_signals[0]->GetStopTime (), Seconds (2), "first transmission not stopped by Stop");
+  NS_TEST_EXPECT_MSG_EQ (channel->m_signals[1]->GetStopTime (), Seconds (4.5), "second transmission not lasting TransmitDuration");
+
+  channel->Dispose ();
+  phy->Dispose ();
+  Simulator::Destroy ();
+}
+
+
 class TvSpectrumTransmitterTestSuite : public TestSuite
 {
 public:
@@ -206,6 +276,7 @@ TvSpectrumTransmitterTestSuite::TvSpectrumTransmitterTestSuite ()
             }
         }
     }
+  AddTestCase (new TvSpectrumTransmitterRestartTestCase, TestCase::QUICK);
 }
 
 static TvSpectrumTransmitterTestSuite g_tvSpectrumTransmitterTestSuite;
@@ -38,7 +38,9 @@ BlockAckCache::Init (uint16_t winStart, uint16_t winSize)
   m_winStart = winStart;
   m_winSize = winSize <= 64 ? winSize : 64;
   m_winEnd = (m_winStart + m_winSize - 1) % 4096;
-  memset (m_bitmap, 0, sizeof (m_bitmap));
+  m_bitmap = 0;
+  m_fragmented = 0;
+  m_history = 0;
 }
 
 uint16_t
@@ -47,6 +49,35 @@ BlockAckCache::GetWinStart () const
   return m_winStart;
 }
 
+void
+BlockAckCache::ShiftWindow (uint16_t delta)
+{
+  NS_LOG_FUNCTION (this << delta);
+  if (delta == 0)
+    {
+      return;
+    }
+  if (delta < 64)
+    {
+      m_history = (m_history >> delta) | (m_bitmap << (64 - delta));
+      m_bitmap >>= delta;
+      m_fragmented >>= delta;
+    }
+  else if (delta < 128)
+    {
+      m_history = delta == 64 ? m_bitmap : m_bitmap >> (delta - 64);
+      m_bitmap = 0;
+      m_fragmented = 0;
+    }
+  else
+    {
+      m_history = 0;
+      m_bitmap = 0;
+      m_fragmented = 0;
+    }
+  m_winStart = (m_winStart + delta) % 4096;
+}
+
 void
 BlockAckCache::UpdateWithMpdu (const WifiMacHeader *hdr)
 {
@@ -56,17 +87,24 @@ BlockAckCache::UpdateWithMpdu (const WifiMacHeader *hdr)
     {
       if (!IsInWindow (seqNumber, m_winStart, m_winSize))
         {
-          uint16_t delta = (seqNumber - m_winEnd + 4096) % 4096;
-          if (delta > 1)
-            {
-              ResetPortionOfBitmap ((m_winEnd + 1) % 4096, ((seqNumber - 1) + 4096) % 4096);
-            }
-          m_winStart = (m_winStart + delta) % 4096;
+          ShiftWindow ((seqNumber - m_winEnd + 4096) % 4096);
           m_winEnd = seqNumber;
 
           WINSIZE_ASSERT;
         }
-      m_bitmap[seqNumber] |= (0x0001 << hdr->GetFragmentNumber ());
+      uint64_t mask = uint64_t (1) << ((seqNumber - m_winStart + 4096) % 4096);
+      /* only the packets received unfragmented are acknowledged by a
+         compressed block ack: once a fragment other than the first one
+         is received, the packet is never acknowledged */
+      if (hdr->GetFragmentNumber () != 0)
+        {
+          m_fragmented |= mask;
+          m_bitmap &= ~mask;
+        }
+      else if ((m_fragmented & mask) == 0)
+        {
+          m_bitmap |= mask;
+        }
     }
 }
 
@@ -80,10 +118,8 @@ BlockAckCache::UpdateWithBlockAckReq (uint16_t startingSeq)
         {
           if (startingSeq != m_winStart)
             {
-              m_winStart = startingSeq;
-              uint16_t newWinEnd = (m_winStart + m_winSize - 1) % 4096;
-              ResetPortionOfBitmap ((m_winEnd + 1) % 4096, newWinEnd);
-              m_winEnd = newWinEnd;
+              ShiftWindow ((startingSeq - m_winStart + 4096) % 4096);
+              m_winEnd = (m_winStart + m_winSize - 1) % 4096;
 
               WINSIZE_ASSERT;
             }
@@ -92,25 +128,15 @@ BlockAckCache::UpdateWithBlockAckReq (uint16_t startingSeq)
         {
           m_winStart = startingSeq;
           m_winEnd = (m_winStart + m_winSize - 1) % 4096;
-          ResetPortionOfBitmap (m_winStart, m_winEnd);
+          m_bitmap = 0;
+          m_fragmented = 0;
+          m_history = 0;
 
           WINSIZE_ASSERT;
         }
     }
 }
 
-void
-BlockAckCache::ResetPortionOfBitmap (uint16_t start, uint16_t end)
-{
-  NS_LOG_FUNCTION (this << start << end);
-  uint16_t i = start;
-  for (; i != end; i = (i + 1) % 4096)
-    {
-      m_bitmap[i] = 0;
-    }
-  m_bitmap[i] = 0;
-}
-
 void
 BlockAckCache::FillBlockAckBitmap (CtrlBAckResponseHeader *blockAckHeader)
 {
@@ -121,18 +147,30 @@ BlockAckCache::FillBlockAckBitmap (CtrlBAckResponseHeader *blockAckHeader)
     }
   else if (blockAckHeader->IsCompressed ())
     {
-      uint16_t i = blockAckHeader->GetStartingSequence ();
-      uint16_t end = (i + m_winSize - 1) % 4096;
-      for (; i != end; i = (i + 1) % 4096)
+      uint16_t start = blockAckHeader->GetStartingSequence ();
+      uint16_t ahead = (start - m_winStart + 4096) % 4096;
+      uint16_t behind = (m_winStart - start + 4096) % 4096;
+      uint64_t bitmap = 0;
+      if (ahead < 64)
         {
-          if (m_bitmap[i] == 1)
-            {
-              blockAckHeader->SetReceivedPacket (i);
-            }
+          bitmap = m_bitmap >> ahead;
+        }
+      else if (behind < 64)
+        {
+          bitmap = (m_bitmap << behind) | (m_history >> (64 - behind));
+        }
+      else if (behind == 64)
+        {
+          bitmap = m_history;
+        }
+      if (m_winSize < 64)
+        {
+          bitmap &= (uint64_t (1) << m_winSize) - 1;
         }
-      if (m_bitmap[i] == 1)
+      while (bitmap != 0)
         {
-          blockAckHeader->SetReceivedPacket (i);
+          blockAckHeader->SetReceivedPacket ((start + CountTrailingZeros (bitmap)) % 4096);
+          bitmap &= bitmap - 1;
         }
     }
   else if (blockAckHeader->IsMultiTid ())
@@ -21,7 +21,7 @@
 #ifndef BLOCK_ACK_CACHE_H
 #define BLOCK_ACK_CACHE_H
 
-//#include <stdint.h>
+#include <stdint.h>
 
 namespace ns3 {
 
@@ -32,6 +32,10 @@ class CtrlBAckResponseHeader;
  * \ingroup wifi
  * \brief BlockAckCache cache
  *
+ * The scoreboard of the packets received under a block ack agreement, kept
+ * in 64-bit words indexed by the offset of their sequence number from the
+ * start of the window (of at most 64 packets), which are shifted when the
+ * window moves.
  */
 class BlockAckCache
 {
@@ -70,17 +74,32 @@ public:
 
 private:
   /**
-   * Reset portion of bitmap functiion
-   * \param start the starting position
-   * \param end the ending position
+   * Move the window forward.
+   * \param delta the number of sequence numbers by which the window is moved
    */
-  void ResetPortionOfBitmap (uint16_t start, uint16_t end);
+  void ShiftWindow (uint16_t delta);
 
   uint16_t m_winStart; ///< window start
   uint16_t m_winSize; ///< window size
   uint16_t m_winEnd; ///< window end
 
-  uint16_t m_bitmap[4096]; ///< bitmap
+  /**
+   * The packets of the window received unfragmented: bit i is set if the
+   * packet with sequence number m_winStart + i was received.
+   */
+  uint64_t m_bitmap;
+  /**
+   * The packets of the window of which a fragment other than the first
+   * one was received: bit i is set for the sequence number m_winStart + i,
+   * whose bit in m_bitmap is then never set.
+   */
+  uint64_t m_fragmented;
+  /**
+   * The packets of the 64 sequence numbers preceding the window received
+   * unfragmented: bit i is set if the packet with sequence number
+   * m_winStart - 64 + i was received.
+   */
+  uint64_t m_history;
 };
 
 } //namespace ns3
@@ -27,6 +27,8 @@
 #include "wifi-mac-queue.h"
 #include "mac-tx-middle.h"
 #include "qos-utils.h"
+#include "wifi-utils.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -40,6 +42,245 @@ BlockAckManager::Item::Item (Ptr<const Packet> packet, const WifiMacHeader &hdr,
   NS_LOG_FUNCTION (this << packet << hdr << tStamp);
 }
 
+BlockAckManager::PacketWindow::PacketWindow ()
+  : m_slots (64),
+    m_stored (1, 0),
+    m_retry (1, 0),
+    m_start (0),
+    m_nStored (0),
+    m_nRetry (0)
+{
+}
+
+uint32_t
+BlockAckManager::PacketWindow::GetIndex (uint16_t seq) const
+{
+  return seq & (m_slots.size () - 1);
+}
+
+uint32_t
+BlockAckManager::PacketWindow::GetOffset (uint16_t seq) const
+{
+  return static_cast<uint16_t> (seq - m_start) % 4096;
+}
+
+uint32_t
+BlockAckManager::PacketWindow::GetSize (void) const
+{
+  return m_slots.size ();
+}
+
+uint16_t
+BlockAckManager::PacketWindow::GetSequence (uint32_t offset) const
+{
+  return (m_start + offset) % 4096;
+}
+
+bool
+BlockAckManager::PacketWindow::IsEmpty (void) const
+{
+  return m_nStored == 0;
+}
+
+uint32_t
+BlockAckManager::PacketWindow::GetNStored (void) const
+{
+  return m_nStored;
+}
+
+uint32_t
+BlockAckManager::PacketWindow::GetNRetry (void) const
+{
+  return m_nRetry;
+}
+
+uint32_t
+BlockAckManager::PacketWindow::NextSet (const std::vector<uint64_t> &bits, uint32_t offset) const
+{
+  uint32_t size = m_slots.size ();
+  while (offset < size)
+    {
+      uint32_t index = (m_start + offset) & (size - 1);
+      uint64_t word = bits[index / 64] >> (index % 64);
+      if (word != 0)
+        {
+          //the bits of a word don't wrap around the end of the window
+          offset += CountTrailingZeros (word);
+          return std::min (offset, size);
+        }
+      offset += 64 - index % 64;
+    }
+  return size;
+}
+
+uint32_t
+BlockAckManager::PacketWindow::NextStored (uint32_t offset) const
+{
+  return NextSet (m_stored, offset);
+}
+
+uint32_t
+BlockAckManager::PacketWindow::NextRetry (uint32_t offset) const
+{
+  return NextSet (m_retry, offset);
+}
+
+void
+BlockAckManager::PacketWindow::Resize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  NS_ASSERT (size >= 64 && size <= 4096 && (size & (size - 1)) == 0);
+  std::vector<std::vector<Item> > slots (size);
+  std::vector<uint64_t> stored (size / 64, 0);
+  std::vector<uint64_t> retry (size / 64, 0);
+  for (uint32_t offset = NextStored (0); offset < m_slots.size (); offset = NextStored (offset + 1))
+    {
+      uint16_t seq = GetSequence (offset);
+      uint32_t from = GetIndex (seq);
+      uint32_t to = seq & (size - 1);
+      slots[to].swap (m_slots[from]);
+      stored[to / 64] |= uint64_t (1) << (to % 64);
+      if ((m_retry[from / 64] >> (from % 64)) & 1)
+        {
+          retry[to / 64] |= uint64_t (1) << (to % 64);
+        }
+    }
+  m_slots.swap (slots);
+  m_stored.swap (stored);
+  m_retry.swap (retry);
+}
+
+void
+BlockAckManager::PacketWindow::Store (const Item &item)
+{
+  uint16_t seq = item.hdr.GetSequenceNumber ();
+  if (m_nStored == 0)
+    {
+      m_start = seq;
+    }
+  else
+    {
+      uint32_t offset = GetOffset (seq);
+      if (offset > 2047)
+        {
+          //the packet is older than the start of the window, which is moved back to it
+          uint32_t last = 0;
+          for (uint32_t i = NextStored (0); i < m_slots.size (); i = NextStored (i + 1))
+            {
+              last = i;
+            }
+          uint32_t size = m_slots.size ();
+          while (size <= last + 4096 - offset)
+            {
+              size *= 2;
+            }
+          if (size != m_slots.size ())
+            {
+              Resize (size);
+            }
+          m_start = seq;
+        }
+      else if (offset >= m_slots.size ())
+        {
+          //move the start of the window to the first stored packet, and
+          //make room for the packet if still needed
+          uint32_t first = NextStored (0);
+          m_start = GetSequence (first);
+          offset -= first;
+          uint32_t size = m_slots.size ();
+          while (size <= offset)
+            {
+              size *= 2;
+            }
+          if (size != m_slots.size ())
+            {
+              Resize (size);
+            }
+        }
+    }
+  uint32_t index = GetIndex (seq);
+  if (m_slots[index].empty ())
+    {
+      m_stored[index / 64] |= uint64_t (1) << (index % 64);
+      m_nStored++;
+    }
+  m_slots[index].push_back (item);
+}
+
+std::vector<BlockAckManager::Item> &
+BlockAckManager::PacketWindow::GetSlot (uint16_t seq)
+{
+  NS_ASSERT (GetOffset (seq) < m_slots.size ());
+  return m_slots[GetIndex (seq)];
+}
+
+void
+BlockAckManager::PacketWindow::Remove (uint16_t seq, std::size_t index)
+{
+  std::vector<Item> &slot = GetSlot (seq);
+  NS_ASSERT (index < slot.size ());
+  slot.erase (slot.begin () + index);
+  if (slot.empty ())
+    {
+      NS_ASSERT (!IsRetry (seq));
+      uint32_t i = GetIndex (seq);
+      m_stored[i / 64] &= ~(uint64_t (1) << (i % 64));
+      m_nStored--;
+    }
+}
+
+void
+BlockAckManager::PacketWindow::RemoveBefore (uint16_t seq, std::size_t index)
+{
+  uint32_t end = GetOffset (seq);
+  for (uint32_t offset = NextStored (0); offset < end; offset = NextStored (offset + 1))
+    {
+      uint16_t removedSeq = GetSequence (offset);
+      ClearRetry (removedSeq);
+      uint32_t i = GetIndex (removedSeq);
+      m_slots[i].clear ();
+      m_stored[i / 64] &= ~(uint64_t (1) << (i % 64));
+      m_nStored--;
+    }
+  std::vector<Item> &slot = GetSlot (seq);
+  NS_ASSERT (index < slot.size ());
+  slot.erase (slot.begin (), slot.begin () + index);
+}
+
+void
+BlockAckManager::PacketWindow::SetRetry (uint16_t seq)
+{
+  NS_ASSERT (!GetSlot (seq).empty ());
+  uint32_t i = GetIndex (seq);
+  if (((m_retry[i / 64] >> (i % 64)) & 1) == 0)
+    {
+      m_retry[i / 64] |= uint64_t (1) << (i % 64);
+      m_nRetry++;
+    }
+}
+
+void
+BlockAckManager::PacketWindow::ClearRetry (uint16_t seq)
+{
+  if (IsRetry (seq))
+    {
+      uint32_t i = GetIndex (seq);
+      m_retry[i / 64] &= ~(uint64_t (1) << (i % 64));
+      m_nRetry--;
+    }
+}
+
+bool
+BlockAckManager::PacketWindow::IsRetry (uint16_t seq) const
+{
+  if (m_nRetry == 0 || GetOffset (seq) >= m_slots.size ())
+    {
+      return false;
+    }
+  uint32_t i = GetIndex (seq);
+  return (m_retry[i / 64] >> (i % 64)) & 1;
+}
+
 Bar::Bar ()
 {
   NS_LOG_FUNCTION (this);
@@ -76,8 +317,8 @@ BlockAckManager::~BlockAckManager ()
 {
   NS_LOG_FUNCTION (this);
   m_queue = 0;
+  m_retryAgreements.clear ();
   m_agreements.clear ();
-  m_retryPackets.clear ();
 }
 
 bool
@@ -136,8 +377,8 @@ BlockAckManager::CreateAgreement (const MgtAddBaRequestHeader *reqHdr, Mac48Addr
       agreement.SetDelayedBlockAck ();
     }
   agreement.SetState (OriginatorBlockAckAgreement::PENDING);
-  PacketQueue queue;
-  std::pair<OriginatorBlockAckAgreement, PacketQueue> value (agreement, queue);
+  PacketWindow window;
+  std::pair<OriginatorBlockAckAgreement, PacketWindow> value (agreement, window);
   m_agreements.insert (std::make_pair (key, value));
   m_blockPackets (recipient, reqHdr->GetTid ());
 }
@@ -149,17 +390,7 @@ BlockAckManager::DestroyAgreement (Mac48Address recipient, uint8_t tid)
   AgreementsI it = m_agreements.find (std::make_pair (recipient, tid));
   if (it != m_agreements.end ())
     {
-      for (std::list<PacketQueueI>::const_iterator i = m_retryPackets.begin (); i != m_retryPackets.end (); )
-        {
-          if ((*i)->hdr.GetAddr1 () == recipient && (*i)->hdr.GetQosTid () == tid)
-            {
-              i = m_retryPackets.erase (i);
-            }
-          else
-            {
-              i++;
-            }
-        }
+      m_retryAgreements.remove (it);
       m_agreements.erase (it);
       //remove scheduled bar
       for (std::list<Bar>::const_iterator i = m_bars.begin (); i != m_bars.end (); )
@@ -221,23 +452,7 @@ BlockAckManager::StorePacket (Ptr<const Packet> packet, const WifiMacHeader &hdr
   Item item (packet, hdr, tStamp);
   AgreementsI it = m_agreements.find (std::make_pair (recipient, tid));
   NS_ASSERT (it != m_agreements.end ());
-  PacketQueueI queueIt = it->second.second.begin ();
-  for (; queueIt != it->second.second.end (); )
-    {
-      if (((hdr.GetSequenceNumber () - queueIt->hdr.GetSequenceNumber () + 4096) % 4096) > 2047)
-        {
-          queueIt = it->second.second.insert (queueIt, item);
-          break;
-        }
-      else
-        {
-          queueIt++;
-        }
-    }
-  if (queueIt == it->second.second.end ())
-    {
-      it->second.second.push_back (item);
-    }
+  it->second.second.Store (item);
 }
 
 void
@@ -257,80 +472,66 @@ BlockAckManager::GetNextPacket (WifiMacHeader &hdr, bool removePacket)
   uint8_t tid;
   Mac48Address recipient;
   CleanupBuffers ();
-  if (!m_retryPackets.empty ())
+  while (!m_retryAgreements.empty ())
     {
-      NS_LOG_DEBUG ("Retry buffer size is " << m_retryPackets.size ());
-      std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
-      while (it != m_retryPackets.end ())
+      AgreementsI agreement = m_retryAgreements.front ();
+      PacketWindow &window = agreement->second.second;
+      NS_LOG_DEBUG ("Retry buffer size is " << window.GetNRetry ());
+      uint16_t seq = window.GetSequence (window.NextRetry (0));
+      const Item &item = window.GetSlot (seq).front ();
+      if (!item.hdr.IsQosData ())
         {
-          if ((*it)->hdr.IsQosData ())
-            {
-              tid = (*it)->hdr.GetQosTid ();
-            }
-          else
-            {
-              NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
-            }
-          recipient = (*it)->hdr.GetAddr1 ();
-          AgreementsI agreement = m_agreements.find (std::make_pair (recipient, tid));
-          NS_ASSERT (agreement != m_agreements.end ());
-          if (removePacket)
-            {
-              if (QosUtilsIsOldPacket (agreement->second.first.GetStartingSequence (),(*it)->hdr.GetSequenceNumber ()))
-                {
-                  //Standard says the originator should not send a packet with seqnum < winstart
-                  NS_LOG_DEBUG ("The Retry packet have sequence number < WinStartO --> Discard " << (*it)->hdr.GetSequenceNumber () << " " << agreement->second.first.GetStartingSequence ());
-                  agreement->second.second.erase ((*it));
-                  it = m_retryPackets.erase (it);
-                  continue;
-                }
-              else if ((*it)->hdr.GetSequenceNumber () > (agreement->second.first.GetStartingSequence () + 63) % 4096)
-                {
-                  agreement->second.first.SetStartingSequence ((*it)->hdr.GetSequenceNumber ());
-                }
-            }
-          packet = (*it)->packet->Copy ();
-          hdr = (*it)->hdr;
-          hdr.SetRetry ();
-          if (hdr.IsQosData ())
-            {
-              tid = hdr.GetQosTid ();
-            }
-          else
-            {
-              NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
-            }
-          recipient = hdr.GetAddr1 ();
-          if (!agreement->second.first.IsHtSupported ()
-              && (ExistsAgreementInState (recipient, tid, OriginatorBlockAckAgreement::ESTABLISHED)
-                  || SwitchToBlockAckIfNeeded (recipient, tid, hdr.GetSequenceNumber ())))
+          NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
+        }
+      if (removePacket)
+        {
+          if (QosUtilsIsOldPacket (agreement->second.first.GetStartingSequence (), seq))
             {
-              hdr.SetQosAckPolicy (WifiMacHeader::BLOCK_ACK);
+              //Standard says the originator should not send a packet with seqnum < winstart
+              NS_LOG_DEBUG ("The Retry packet have sequence number < WinStartO --> Discard " << seq << " " << agreement->second.first.GetStartingSequence ());
+              RemoveFromRetryQueue (agreement, seq);
+              window.Remove (seq, 0);
+              continue;
             }
-          else
+          else if (seq > (agreement->second.first.GetStartingSequence () + 63) % 4096)
             {
-              /* From section 9.10.3 in IEEE802.11e standard:
-               * In order to improve efficiency, originators using the Block Ack facility
-               * may send MPDU frames with the Ack Policy subfield in QoS control frames
-               * set to Normal Ack if only a few MPDUs are available for transmission.[...]
-               * When there are sufficient number of MPDUs, the originator may switch back to
-               * the use of Block Ack.
-               */
-              hdr.SetQosAckPolicy (WifiMacHeader::NORMAL_ACK);
-              if (removePacket)
-                {
-                  AgreementsI i = m_agreements.find (std::make_pair (recipient, tid));
-                  i->second.second.erase (*it);
-                }
+              agreement->second.first.SetStartingSequence (seq);
             }
+        }
+      packet = item.packet->Copy ();
+      hdr = item.hdr;
+      hdr.SetRetry ();
+      tid = hdr.GetQosTid ();
+      recipient = hdr.GetAddr1 ();
+      if (!agreement->second.first.IsHtSupported ()
+          && (ExistsAgreementInState (recipient, tid, OriginatorBlockAckAgreement::ESTABLISHED)
+              || SwitchToBlockAckIfNeeded (recipient, tid, seq)))
+        {
+          hdr.SetQosAckPolicy (WifiMacHeader::BLOCK_ACK);
+        }
+      else
+        {
+          /* From section 9.10.3 in IEEE802.11e standard:
+           * In order to improve efficiency, originators using the Block Ack facility
+           * may send MPDU frames with the Ack Policy subfield in QoS control frames
+           * set to Normal Ack if only a few MPDUs are available for transmission.[...]
+           * When there are sufficient number of MPDUs, the originator may switch back to
+           * the use of Block Ack.
+           */
+          hdr.SetQosAckPolicy (WifiMacHeader::NORMAL_ACK);
           if (removePacket)
             {
-              NS_LOG_INFO ("Retry packet seq = " << hdr.GetSequenceNumber ());
-              it = m_retryPackets.erase (it);
-              NS_LOG_DEBUG ("Removed one packet, retry buffer size = " << m_retryPackets.size ());
+              RemoveFromRetryQueue (agreement, seq);
+              window.Remove (seq, 0);
             }
-          break;
         }
+      if (removePacket)
+        {
+          NS_LOG_INFO ("Retry packet seq = " << hdr.GetSequenceNumber ());
+          RemoveFromRetryQueue (agreement, seq);
+          NS_LOG_DEBUG ("Removed one packet, retry buffer size = " << window.GetNRetry ());
+        }
+      break;
     }
   return packet;
 }
@@ -344,53 +545,51 @@ BlockAckManager::PeekNextPacketByTidAndAddress (WifiMacHeader &hdr, uint8_t tid,
   Mac48Address recipient = hdr.GetAddr1 ();
   AgreementsI agreement = m_agreements.find (std::make_pair (recipient, tid));
   NS_ASSERT (agreement != m_agreements.end ());
-  std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
-  for (; it != m_retryPackets.end (); it++)
+  PacketWindow &window = agreement->second.second;
+  for (uint32_t offset = window.NextRetry (0); offset < window.GetSize (); offset = window.NextRetry (offset + 1))
     {
-      if (!(*it)->hdr.IsQosData ())
+      uint16_t seq = window.GetSequence (offset);
+      const Item &item = window.GetSlot (seq).front ();
+      if (!item.hdr.IsQosData ())
         {
           NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
         }
-      if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid)
+      if (QosUtilsIsOldPacket (agreement->second.first.GetStartingSequence (), seq))
         {
-          if (QosUtilsIsOldPacket (agreement->second.first.GetStartingSequence (),(*it)->hdr.GetSequenceNumber ()))
-            {
-              //standard says the originator should not send a packet with seqnum < winstart
-              NS_LOG_DEBUG ("The Retry packet have sequence number < WinStartO --> Discard " << (*it)->hdr.GetSequenceNumber () << " " << agreement->second.first.GetStartingSequence ());
-              agreement->second.second.erase ((*it));
-              it = m_retryPackets.erase (it);
-              it--;
-              continue;
-            }
-          else if ((*it)->hdr.GetSequenceNumber () > (agreement->second.first.GetStartingSequence () + 63) % 4096)
-            {
-              agreement->second.first.SetStartingSequence ((*it)->hdr.GetSequenceNumber ());
-            }
-          packet = (*it)->packet->Copy ();
-          hdr = (*it)->hdr;
-          hdr.SetRetry ();
-          *tstamp = (*it)->timestamp;
-          NS_LOG_INFO ("Retry packet seq = " << hdr.GetSequenceNumber ());
-          if (!agreement->second.first.IsHtSupported ()
-              && (ExistsAgreementInState (recipient, tid, OriginatorBlockAckAgreement::ESTABLISHED)
-                  || SwitchToBlockAckIfNeeded (recipient, tid, hdr.GetSequenceNumber ())))
-            {
-              hdr.SetQosAckPolicy (WifiMacHeader::BLOCK_ACK);
-            }
-          else
-            {
-              /* From section 9.10.3 in IEEE802.11e standard:
-               * In order to improve efficiency, originators using the Block Ack facility
-               * may send MPDU frames with the Ack Policy subfield in QoS control frames
-               * set to Normal Ack if only a few MPDUs are available for transmission.[...]
-               * When there are sufficient number of MPDUs, the originator may switch back to
-               * the use of Block Ack.
-               */
-              hdr.SetQosAckPolicy (WifiMacHeader::NORMAL_ACK);
-            }
-          NS_LOG_DEBUG ("Peeked one packet from retry buffer size = " << m_retryPackets.size () );
-          return packet;
+          //standard says the originator should not send a packet with seqnum < winstart
+          NS_LOG_DEBUG ("The Retry packet have sequence number < WinStartO --> Discard " << seq << " " << agreement->second.first.GetStartingSequence ());
+          RemoveFromRetryQueue (agreement, seq);
+          window.Remove (seq, 0);
+          continue;
+        }
+      else if (seq > (agreement->second.first.GetStartingSequence () + 63) % 4096)
+        {
+          agreement->second.first.SetStartingSequence (seq);
         }
+      packet = item.packet->Copy ();
+      hdr = item.hdr;
+      hdr.SetRetry ();
+      *tstamp = item.timestamp;
+      NS_LOG_INFO ("Retry packet seq = " << hdr.GetSequenceNumber ());
+      if (!agreement->second.first.IsHtSupported ()
+          && (ExistsAgreementInState (recipient, tid, OriginatorBlockAckAgreement::ESTABLISHED)
+              || SwitchToBlockAckIfNeeded (recipient, tid, hdr.GetSequenceNumber ())))
+        {
+          hdr.SetQosAckPolicy (WifiMacHeader::BLOCK_ACK);
+        }
+      else
+        {
+          /* From section 9.10.3 in IEEE802.11e standard:
+           * In order to improve efficiency, originators using the Block Ack facility
+           * may send MPDU frames with the Ack Policy subfield in QoS control frames
+           * set to Normal Ack if only a few MPDUs are available for transmission.[...]
+           * When there are sufficient number of MPDUs, the originator may switch back to
+           * the use of Block Ack.
+           */
+          hdr.SetQosAckPolicy (WifiMacHeader::NORMAL_ACK);
+        }
+      NS_LOG_DEBUG ("Peeked one packet from retry buffer size = " << window.GetNRetry ());
+      return packet;
     }
   return packet;
 }
@@ -398,23 +597,13 @@ BlockAckManager::PeekNextPacketByTidAndAddress (WifiMacHeader &hdr, uint8_t tid,
 bool
 BlockAckManager::RemovePacket (uint8_t tid, Mac48Address recipient, uint16_t seqnumber)
 {
-
-  std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
-  for (; it != m_retryPackets.end (); it++)
+  AgreementsI agreement = m_agreements.find (std::make_pair (recipient, tid));
+  if (agreement != m_agreements.end () && agreement->second.second.IsRetry (seqnumber))
     {
-      if (!(*it)->hdr.IsQosData ())
-        {
-          NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
-        }
-      if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid && (*it)->hdr.GetSequenceNumber () == seqnumber)
-        {
-          WifiMacHeader hdr = (*it)->hdr;
-          AgreementsI i = m_agreements.find (std::make_pair (recipient, tid));
-          i->second.second.erase ((*it));
-          m_retryPackets.erase (it);
-          NS_LOG_DEBUG ("Removed Packet from retry queue = " << hdr.GetSequenceNumber () << " " << +tid << " " << recipient << " Buffer Size = " << m_retryPackets.size ());
-          return true;
-        }
+      RemoveFromRetryQueue (agreement, seqnumber);
+      agreement->second.second.Remove (seqnumber, 0);
+      NS_LOG_DEBUG ("Removed Packet from retry queue = " << seqnumber << " " << +tid << " " << recipient << " Buffer Size = " << agreement->second.second.GetNRetry ());
+      return true;
     }
   return false;
 }
@@ -436,7 +625,7 @@ bool
 BlockAckManager::HasPackets (void) const
 {
   NS_LOG_FUNCTION (this);
-  return (m_retryPackets.size () > 0 || m_bars.size () > 0);
+  return (!m_retryAgreements.empty () || m_bars.size () > 0);
 }
 
 uint32_t
@@ -448,54 +637,21 @@ BlockAckManager::GetNBufferedPackets (Mac48Address recipient, uint8_t tid) const
     {
       return 0;
     }
-  uint32_t nPackets = 0;
-  PacketQueueCI queueIt = (*it).second.second.begin ();
-  while (queueIt != (*it).second.second.end ())
-    {
-      uint16_t currentSeq = (*queueIt).hdr.GetSequenceNumber ();
-      nPackets++;
-      /* a fragmented packet must be counted as one packet */
-      while (queueIt != (*it).second.second.end () && (*queueIt).hdr.GetSequenceNumber () == currentSeq)
-        {
-          queueIt++;
-        }
-    }
-  return nPackets;
+  /* a fragmented packet must be counted as one packet */
+  return it->second.second.GetNStored ();
 }
 
 uint32_t
 BlockAckManager::GetNRetryNeededPackets (Mac48Address recipient, uint8_t tid) const
 {
   NS_LOG_FUNCTION (this << recipient << +tid);
-  uint32_t nPackets = 0;
-  uint16_t currentSeq = 0;
-  if (ExistsAgreement (recipient, tid))
+  AgreementsCI it = m_agreements.find (std::make_pair (recipient, tid));
+  if (it == m_agreements.end ())
     {
-      std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
-      while (it != m_retryPackets.end ())
-        {
-          if (!(*it)->hdr.IsQosData ())
-            {
-              NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
-            }
-          if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid)
-            {
-              currentSeq = (*it)->hdr.GetSequenceNumber ();
-              nPackets++;
-              /* a fragmented packet must be counted as one packet */
-              while (it != m_retryPackets.end () && (*it)->hdr.GetSequenceNumber () == currentSeq)
-                {
-                  it++;
-                }
-            }
-          //go to next packet
-          else
-            {
-              it++;
-            }
-        }
+      return 0;
     }
-  return nPackets;
+  /* a fragmented packet must be counted as one packet */
+  return it->second.second.GetNRetry ();
 }
 
 void
@@ -515,21 +671,9 @@ BlockAckManager::SetWifiRemoteStationManager (const Ptr<WifiRemoteStationManager
 bool
 BlockAckManager::AlreadyExists (uint16_t currentSeq, Mac48Address recipient, uint8_t tid) const
 {
-  std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
-  while (it != m_retryPackets.end ())
-    {
-      NS_LOG_FUNCTION (this << (*it)->hdr.GetType ());
-      if (!(*it)->hdr.IsQosData ())
-        {
-          NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
-        }
-      if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid && currentSeq == (*it)->hdr.GetSequenceNumber ())
-        {
-          return true;
-        }
-      it++;
-    }
-  return false;
+  NS_LOG_FUNCTION (this << currentSeq << recipient << +tid);
+  AgreementsCI it = m_agreements.find (std::make_pair (recipient, tid));
+  return it != m_agreements.end () && it->second.second.IsRetry (currentSeq);
 }
 
 void
@@ -546,7 +690,7 @@ BlockAckManager::NotifyGotBlockAck (const CtrlBAckResponseHeader *blockAck, Mac4
           uint8_t nSuccessfulMpdus = 0;
           uint8_t nFailedMpdus = 0;
           AgreementsI it = m_agreements.find (std::make_pair (recipient, tid));
-          PacketQueueI queueEnd = it->second.second.end ();
+          PacketWindow &window = it->second.second;
 
           if (it->second.first.m_inactivityEvent.IsRunning ())
             {
@@ -560,71 +704,46 @@ BlockAckManager::NotifyGotBlockAck (const CtrlBAckResponseHeader *blockAck, Mac4
                                                                         this,
                                                                         recipient, tid);
             }
-          if (blockAck->IsBasic ())
+          bool compressed = blockAck->IsCompressed ();
+          if (blockAck->IsBasic () || compressed)
             {
-              for (PacketQueueI queueIt = it->second.second.begin (); queueIt != queueEnd; )
+              for (uint32_t offset = window.NextStored (0); offset < window.GetSize (); offset = window.NextStored (offset + 1))
                 {
-                  if (blockAck->IsFragmentReceived ((*queueIt).hdr.GetSequenceNumber (),
-                                                    (*queueIt).hdr.GetFragmentNumber ()))
+                  uint16_t currentSeq = window.GetSequence (offset);
+                  std::vector<Item> &slot = window.GetSlot (currentSeq);
+                  bool packetReceived = compressed && blockAck->IsPacketReceived (currentSeq);
+                  for (std::size_t i = 0; i < slot.size (); )
                     {
-                      nSuccessfulMpdus++;
-                      RemoveFromRetryQueue (recipient, tid, (*queueIt).hdr.GetSequenceNumber ());
-                      queueIt = it->second.second.erase (queueIt);
-                    }
-                  else
-                    {
-                      if (!foundFirstLost)
-                        {
-                          foundFirstLost = true;
-                          sequenceFirstLost = (*queueIt).hdr.GetSequenceNumber ();
-                          (*it).second.first.SetStartingSequence (sequenceFirstLost);
-                        }
-                      nFailedMpdus++;
-                      if (!AlreadyExists ((*queueIt).hdr.GetSequenceNumber (),recipient,tid))
-                        {
-                          InsertInRetryQueue (queueIt);
-                        }
-                      queueIt++;
-                    }
-                }
-            }
-          else if (blockAck->IsCompressed ())
-            {
-              for (PacketQueueI queueIt = it->second.second.begin (); queueIt != queueEnd; )
-                {
-                  uint16_t currentSeq = (*queueIt).hdr.GetSequenceNumber ();
-                  if (blockAck->IsPacketReceived (currentSeq))
-                    {
-                      while (queueIt != queueEnd
-                             && (*queueIt).hdr.GetSequenceNumber () == currentSeq)
+                      if (packetReceived
+                          || (!compressed && blockAck->IsFragmentReceived (currentSeq, slot[i].hdr.GetFragmentNumber ())))
                         {
                           nSuccessfulMpdus++;
-                          if (!m_txOkCallback.IsNull ())
+                          if (compressed && !m_txOkCallback.IsNull ())
                             {
-                              m_txOkCallback ((*queueIt).hdr);
+                              m_txOkCallback (slot[i].hdr);
                             }
-                          RemoveFromRetryQueue (recipient, tid, currentSeq);
-                          queueIt = it->second.second.erase (queueIt);
-                        }
-                    }
-                  else
-                    {
-                      if (!foundFirstLost)
-                        {
-                          foundFirstLost = true;
-                          sequenceFirstLost = (*queueIt).hdr.GetSequenceNumber ();
-                          (*it).second.first.SetStartingSequence (sequenceFirstLost);
+                          RemoveFromRetryQueue (it, currentSeq);
+                          window.Remove (currentSeq, i);
                         }
-                      nFailedMpdus++;
-                      if (!m_txFailedCallback.IsNull ())
+                      else
                         {
-                          m_txFailedCallback ((*queueIt).hdr);
-                        }
-                      if (!AlreadyExists ((*queueIt).hdr.GetSequenceNumber (),recipient,tid))
-                        {
-                          InsertInRetryQueue (queueIt);
+                          if (!foundFirstLost)
+                            {
+                              foundFirstLost = true;
+                              sequenceFirstLost = currentSeq;
+                              (*it).second.first.SetStartingSequence (sequenceFirstLost);
+                            }
+                          nFailedMpdus++;
+                          if (compressed && !m_txFailedCallback.IsNull ())
+                            {
+                              m_txFailedCallback (slot[i].hdr);
+                            }
+                          if (!window.IsRetry (currentSeq))
+                            {
+                              InsertInRetryQueue (it, currentSeq);
+                            }
+                          i++;
                         }
-                      queueIt++;
                     }
                 }
             }
@@ -805,21 +924,16 @@ bool BlockAckManager::NeedBarRetransmission (uint8_t tid, uint16_t seqNumber, Ma
 }
 
 void
-BlockAckManager::RemoveFromRetryQueue (Mac48Address address, uint8_t tid, uint16_t seq)
+BlockAckManager::RemoveFromRetryQueue (AgreementsI agreement, uint16_t seq)
 {
-  /* remove retry packet iterator if it's present in retry queue */
-  std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
-  while (it != m_retryPackets.end ())
+  /* remove retry packet if it's present in retry queue */
+  PacketWindow &window = agreement->second.second;
+  if (window.IsRetry (seq))
     {
-      if ((*it)->hdr.GetAddr1 () == address
-          && (*it)->hdr.GetQosTid () == tid
-          && (*it)->hdr.GetSequenceNumber () == seq)
+      window.ClearRetry (seq);
+      if (window.GetNRetry () == 0)
         {
-          it = m_retryPackets.erase (it);
-        }
-      else
-        {
-          it++;
+          m_retryAgreements.remove (agreement);
         }
     }
 }
@@ -828,30 +942,43 @@ void
 BlockAckManager::CleanupBuffers (void)
 {
   NS_LOG_FUNCTION (this);
+  Time now = Simulator::Now ();
   for (AgreementsI j = m_agreements.begin (); j != m_agreements.end (); j++)
     {
-      if (j->second.second.empty ())
+      PacketWindow &window = j->second.second;
+      if (window.IsEmpty ())
         {
           continue;
         }
-      Time now = Simulator::Now ();
-      PacketQueueI end = j->second.second.begin ();
-      for (PacketQueueI i = j->second.second.begin (); i != j->second.second.end (); i++)
+      /* the packets are removed up to the first one whose lifetime was not
+         exceeded; they are all kept if the lifetime of all of them was exceeded */
+      uint32_t offset = window.NextStored (0);
+      uint16_t firstSeq = window.GetSequence (offset);
+      bool found = false;
+      for (; offset < window.GetSize () && !found; offset = window.NextStored (offset + 1))
         {
-          if (i->timestamp + m_maxDelay > now)
+          uint16_t seq = window.GetSequence (offset);
+          const std::vector<Item> &slot = window.GetSlot (seq);
+          std::size_t index = 0;
+          while (index < slot.size () && slot[index].timestamp + m_maxDelay <= now)
             {
-              end = i;
-              break;
+              index++;
             }
-          else
+          if (index > 0)
+            {
+              RemoveFromRetryQueue (j, seq);
+            }
+          if (index < slot.size ())
             {
-              RemoveFromRetryQueue (j->second.first.GetPeer (),
-                                    j->second.first.GetTid (),
-                                    i->hdr.GetSequenceNumber ());
+              window.RemoveBefore (seq, index);
+              j->second.first.SetStartingSequence (seq);
+              found = true;
             }
         }
-      j->second.second.erase (j->second.second.begin (), end);
-      j->second.first.SetStartingSequence (end->hdr.GetSequenceNumber ());
+      if (!found)
+        {
+          j->second.first.SetStartingSequence (firstSeq);
+        }
     }
 }
 
@@ -894,20 +1021,12 @@ uint16_t
 BlockAckManager::GetSeqNumOfNextRetryPacket (Mac48Address recipient, uint8_t tid) const
 {
   NS_LOG_FUNCTION (this << recipient << +tid);
-  std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin ();
-  while (it != m_retryPackets.end ())
+  AgreementsCI it = m_agreements.find (std::make_pair (recipient, tid));
+  if (it == m_agreements.end () || it->second.second.GetNRetry () == 0)
     {
-      if (!(*it)->hdr.IsQosData ())
-        {
-          NS_FATAL_ERROR ("Packet in blockAck manager retry queue is not Qos Data");
-        }
-      if ((*it)->hdr.GetAddr1 () == recipient && (*it)->hdr.GetQosTid () == tid)
-        {
-          return (*it)->hdr.GetSequenceNumber ();
-        }
-      it++;
+      return 4096;
     }
-  return 4096;
+  return it->second.second.GetSequence (it->second.second.NextRetry (0));
 }
 
 void
@@ -923,32 +1042,15 @@ BlockAckManager::SetTxFailedCallback (TxFailed callback)
 }
 
 void
-BlockAckManager::InsertInRetryQueue (PacketQueueI item)
+BlockAckManager::InsertInRetryQueue (AgreementsI agreement, uint16_t seq)
 {
-  NS_LOG_INFO ("Adding to retry queue " << (*item).hdr.GetSequenceNumber ());
-  if (m_retryPackets.size () == 0)
+  NS_LOG_INFO ("Adding to retry queue " << seq);
+  PacketWindow &window = agreement->second.second;
+  if (window.GetNRetry () == 0)
     {
-      m_retryPackets.push_back (item);
-    }
-  else
-    {
-      for (std::list<PacketQueueI>::const_iterator it = m_retryPackets.begin (); it != m_retryPackets.end (); )
-        {
-          if (((item->hdr.GetSequenceNumber () - (*it)->hdr.GetSequenceNumber () + 4096) % 4096) > 2047)
-            {
-              it = m_retryPackets.insert (it, item);
-              break;
-            }
-          else
-            {
-              it++;
-              if (it == m_retryPackets.end ())
-                {
-                  m_retryPackets.push_back (item);
-                }
-            }
-        }
+      m_retryAgreements.push_back (agreement);
     }
+  window.SetRetry (seq);
 }
 
 } //namespace ns3
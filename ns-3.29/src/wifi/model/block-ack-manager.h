@@ -22,6 +22,8 @@
 #define BLOCK_ACK_MANAGER_H
 
 #include <map>
+#include <list>
+#include <vector>
 #include "ns3/nstime.h"
 #include "wifi-mac-header.h"
 #include "originator-block-ack-agreement.h"
@@ -409,35 +411,6 @@ private:
    */
   void InactivityTimeout (Mac48Address recipient, uint8_t tid);
 
-  struct Item;
-  /**
-   * typedef for a list of Item struct.
-   */
-  typedef std::list<Item> PacketQueue;
-  /**
-   * typedef for an iterator for PacketQueue.
-   */
-  typedef std::list<Item>::iterator PacketQueueI;
-  /**
-   * typedef for a const iterator for PacketQueue.
-   */
-  typedef std::list<Item>::const_iterator PacketQueueCI;
-  /**
-   * typedef for a map between MAC address and block ACK agreement.
-   */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> > Agreements;
-  /**
-   * typedef for an iterator for Agreements.
-   */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> >::iterator AgreementsI;
-  /**
-   * typedef for a const iterator for Agreements.
-   */
-  typedef std::map<std::pair<Mac48Address, uint8_t>,
-                   std::pair<OriginatorBlockAckAgreement, PacketQueue> >::const_iterator AgreementsCI;
-
   /**
    * A struct for packet, Wifi header, and timestamp.
    * Used in queue by block ACK manager.
@@ -458,38 +431,190 @@ private:
     WifiMacHeader hdr; ///< header
     Time timestamp; ///< timestamp
   };
+
+  /**
+   * The packets of a block ack agreement for which an ack by block ack is
+   * requested, in a circular window of slots indexed by their sequence
+   * number modulo the size of the window. The size of the window is a
+   * power of two (at least 64, at most 4096) which is doubled when a
+   * packet falls outside of it, so that the index of a sequence number
+   * does not change when the sequence numbers wrap around.
+   *
+   * A slot holds the packets (fragments) with the same sequence number,
+   * in the order in which they were stored. The sequence numbers having a
+   * stored packet and those needing a retransmission are kept in bitmaps
+   * of 64-bit words, so that they are found in increasing order, starting
+   * from the start of the window, by skipping the null words and counting
+   * the trailing zeros of the others.
+   */
+  class PacketWindow
+  {
+  public:
+    PacketWindow ();
+
+    /**
+     * Store a packet after the packets with the same sequence number.
+     *
+     * \param item the packet
+     */
+    void Store (const Item &item);
+    /**
+     * \return true if no packet is stored
+     */
+    bool IsEmpty (void) const;
+    /**
+     * \return the number of sequence numbers having a stored packet
+     */
+    uint32_t GetNStored (void) const;
+    /**
+     * \param offset the offset from the start of the window
+     * \return the offset of the first sequence number having a stored
+     *         packet from <i>offset</i>, or the size of the window
+     */
+    uint32_t NextStored (uint32_t offset) const;
+    /**
+     * \return the size of the window
+     */
+    uint32_t GetSize (void) const;
+    /**
+     * \param offset the offset from the start of the window
+     * \return the sequence number at <i>offset</i>
+     */
+    uint16_t GetSequence (uint32_t offset) const;
+    /**
+     * \param seq the sequence number
+     * \return the packets with sequence number <i>seq</i>
+     */
+    std::vector<Item> & GetSlot (uint16_t seq);
+    /**
+     * Remove a packet, which must be stored.
+     *
+     * \param seq the sequence number of the packet
+     * \param index the index of the packet in its slot
+     */
+    void Remove (uint16_t seq, std::size_t index);
+    /**
+     * Remove the first packets of the window.
+     *
+     * \param seq the sequence number of the first packet to keep
+     * \param index the index of the first packet to keep in its slot
+     */
+    void RemoveBefore (uint16_t seq, std::size_t index);
+
+    /**
+     * Mark a sequence number, which must have a stored packet, as needing
+     * a retransmission.
+     *
+     * \param seq the sequence number
+     */
+    void SetRetry (uint16_t seq);
+    /**
+     * Unmark a sequence number as needing a retransmission.
+     *
+     * \param seq the sequence number
+     */
+    void ClearRetry (uint16_t seq);
+    /**
+     * \param seq the sequence number
+     * \return true if the sequence number needs a retransmission
+     */
+    bool IsRetry (uint16_t seq) const;
+    /**
+     * \return the number of sequence numbers needing a retransmission
+     */
+    uint32_t GetNRetry (void) const;
+    /**
+     * \param offset the offset from the start of the window
+     * \return the offset of the first sequence number needing a
+     *         retransmission from <i>offset</i>, or the size of the window
+     */
+    uint32_t NextRetry (uint32_t offset) const;
+
+  private:
+    /**
+     * \param bits a bitmap of the window
+     * \param offset the offset from the start of the window
+     * \return the offset of the first bit set from <i>offset</i>, or the
+     *         size of the window
+     */
+    uint32_t NextSet (const std::vector<uint64_t> &bits, uint32_t offset) const;
+    /**
+     * \param seq the sequence number
+     * \return the index of the sequence number in the window
+     */
+    uint32_t GetIndex (uint16_t seq) const;
+    /**
+     * \param seq the sequence number
+     * \return the distance from the start of the window to the sequence
+     *         number, modulo 4096
+     */
+    uint32_t GetOffset (uint16_t seq) const;
+    /**
+     * Resize the window, keeping its start.
+     *
+     * \param size the new size of the window
+     */
+    void Resize (uint32_t size);
+
+    std::vector<std::vector<Item> > m_slots; ///< the packets, by sequence number
+    std::vector<uint64_t> m_stored;          ///< the sequence numbers having a stored packet
+    std::vector<uint64_t> m_retry;           ///< the sequence numbers needing a retransmission
+    uint16_t m_start;                        ///< the sequence number of the start of the window
+    uint32_t m_nStored;                      ///< the number of bits set in m_stored
+    uint32_t m_nRetry;                       ///< the number of bits set in m_retry
+  };
+
+  /**
+   * typedef for a map between MAC address and block ACK agreement.
+   */
+  typedef std::map<std::pair<Mac48Address, uint8_t>,
+                   std::pair<OriginatorBlockAckAgreement, PacketWindow> > Agreements;
+  /**
+   * typedef for an iterator for Agreements.
+   */
+  typedef std::map<std::pair<Mac48Address, uint8_t>,
+                   std::pair<OriginatorBlockAckAgreement, PacketWindow> >::iterator AgreementsI;
+  /**
+   * typedef for a const iterator for Agreements.
+   */
+  typedef std::map<std::pair<Mac48Address, uint8_t>,
+                   std::pair<OriginatorBlockAckAgreement, PacketWindow> >::const_iterator AgreementsCI;
+
   /**
-   * \param item
+   * Mark a stored packet as needing a retransmission.
+   * Retransmissions are done in increasing sequence number order for each
+   * agreement, and in the order in which the agreements got a packet to
+   * retransmit.
    *
-   * Insert item in retransmission queue.
-   * This method ensures packets are retransmitted in the correct order.
+   * \param agreement the agreement of the packet
+   * \param seq the sequence number of the packet
    */
-  void InsertInRetryQueue (PacketQueueI item);
+  void InsertInRetryQueue (AgreementsI agreement, uint16_t seq);
 
   /**
    * Remove items from retransmission queue.
    * This method should be called when packets are acknowledged.
    *
-   * \param address recipient mac address of the packet to be removed
-   * \param tid Traffic ID of the packet to be removed
+   * \param agreement the agreement of the packet
    * \param seq sequence number of the packet to be removed
    */
-  void RemoveFromRetryQueue (Mac48Address address, uint8_t tid, uint16_t seq);
+  void RemoveFromRetryQueue (AgreementsI agreement, uint16_t seq);
 
   /**
    * This data structure contains, for each block ack agreement (recipient, tid), a set of packets
    * for which an ack by block ack is requested.
    * Every packet or fragment indicated as correctly received in block ack frame is
-   * erased from this data structure. Pushed back in retransmission queue otherwise.
+   * erased from this data structure. Marked as needing a retransmission otherwise.
    */
   Agreements m_agreements;
 
   /**
-   * This list contains all iterators to stored packets that need to be retransmitted.
+   * The agreements having packets that need to be retransmitted, in the
+   * order in which they got their first one.
    * A packet needs retransmission if it's indicated as not correctly received in a block ack
    * frame.
    */
-  std::list<PacketQueueI> m_retryPackets;
+  std::list<AgreementsI> m_retryAgreements;
   std::list<Bar> m_bars; ///< list of BARs
 
   uint8_t m_blockAckThreshold; ///< block ack threshold
@@ -18,11 +18,17 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "error-rate-model.h"
 #include "ns3/wifi-tx-vector.h"
+#include <cmath>
 
 namespace ns3 {
 
+NS_LOG_COMPONENT_DEFINE ("ErrorRateModel");
+
 NS_OBJECT_ENSURE_REGISTERED (ErrorRateModel);
 
 TypeId ErrorRateModel::GetTypeId (void)
@@ -30,10 +36,86 @@ TypeId ErrorRateModel::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::ErrorRateModel")
     .SetParent<Object> ()
     .SetGroupName ("Wifi")
+    .AddAttribute ("UseTables",
+                   "If true, the chunk success rates are derived from tables of the bit error rate "
+                   "of each mode, computed on a grid of SNR values, instead of being computed "
+                   "by the model for each chunk.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ErrorRateModel::m_useTables),
+                   MakeBooleanChecker ())
+    .AddAttribute ("TableMinSnr",
+                   "The lowest SNR (dB) of the tables of the bit error rate.",
+                   DoubleValue (-20.0),
+                   MakeDoubleAccessor (&ErrorRateModel::SetTableMinSnr,
+                                       &ErrorRateModel::GetTableMinSnr),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("TableMaxSnr",
+                   "The highest SNR (dB) of the tables of the bit error rate.",
+                   DoubleValue (60.0),
+                   MakeDoubleAccessor (&ErrorRateModel::SetTableMaxSnr,
+                                       &ErrorRateModel::GetTableMaxSnr),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("TableResolution",
+                   "The SNR step (dB) of the tables of the bit error rate: the smaller, "
+                   "the closer the chunk success rates are to the ones computed by the model.",
+                   DoubleValue (0.05),
+                   MakeDoubleAccessor (&ErrorRateModel::SetTableResolution,
+                                       &ErrorRateModel::GetTableResolution),
+                   MakeDoubleChecker<double> (0.001))
   ;
   return tid;
 }
 
+ErrorRateModel::ErrorRateModel ()
+  : m_useTables (false),
+    m_tableMinSnr (-20.0),
+    m_tableMaxSnr (60.0),
+    m_tableResolution (0.05)
+{
+}
+
+void
+ErrorRateModel::SetTableMinSnr (double snr)
+{
+  NS_LOG_FUNCTION (this << snr);
+  m_tableMinSnr = snr;
+  m_berTables.clear ();
+}
+
+double
+ErrorRateModel::GetTableMinSnr (void) const
+{
+  return m_tableMinSnr;
+}
+
+void
+ErrorRateModel::SetTableMaxSnr (double snr)
+{
+  NS_LOG_FUNCTION (this << snr);
+  m_tableMaxSnr = snr;
+  m_berTables.clear ();
+}
+
+double
+ErrorRateModel::GetTableMaxSnr (void) const
+{
+  return m_tableMaxSnr;
+}
+
+void
+ErrorRateModel::SetTableResolution (double resolution)
+{
+  NS_LOG_FUNCTION (this << resolution);
+  m_tableResolution = resolution;
+  m_berTables.clear ();
+}
+
+double
+ErrorRateModel::GetTableResolution (void) const
+{
+  return m_tableResolution;
+}
+
 double
 ErrorRateModel::CalculateSnr (WifiTxVector txVector, double ber) const
 {
@@ -58,4 +140,68 @@ ErrorRateModel::CalculateSnr (WifiTxVector txVector, double ber) const
   return low;
 }
 
+double
+ErrorRateModel::GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
+{
+  if (!m_useTables)
+    {
+      return DoGetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  return GetTabulatedChunkSuccessRate (mode, txVector, snr, nbits);
+}
+
+double
+ErrorRateModel::GetTabulatedChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const
+{
+  if (nbits == 0 || snr <= 0)
+    {
+      return DoGetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  double position = (10.0 * std::log10 (snr) - m_tableMinSnr) / m_tableResolution;
+  const std::vector<double> &table = GetBerTable (mode, txVector);
+  if (position < 0 || position >= table.size () - 1)
+    {
+      return DoGetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  std::size_t index = static_cast<std::size_t> (position);
+  if (table[index] >= 0)
+    {
+      // the model saturates the bit error rate to 1 at low SNR, which
+      // can't be interpolated
+      return DoGetChunkSuccessRate (mode, txVector, snr, nbits);
+    }
+  double fraction = position - index;
+  double ber = std::exp (table[index] + fraction * (table[index + 1] - table[index]));
+  return std::exp (nbits * std::log1p (-ber));
+}
+
+const std::vector<double> &
+ErrorRateModel::GetBerTable (WifiMode mode, WifiTxVector txVector) const
+{
+  NS_ASSERT (mode.GetUid () < 0x10000);
+  uint64_t key = (static_cast<uint64_t> (mode.GetUid ()) << 40)
+    | (static_cast<uint64_t> (txVector.GetChannelWidth ()) << 24)
+    | (static_cast<uint64_t> (txVector.GetGuardInterval ()) << 8)
+    | txVector.GetNss ();
+  std::unordered_map<uint64_t, std::vector<double> >::const_iterator it = m_berTables.find (key);
+  if (it != m_berTables.end ())
+    {
+      return it->second;
+    }
+  NS_LOG_FUNCTION (this << mode << txVector);
+  // the natural logarithm of the smallest bit error rates, to keep the
+  // interpolation finite where the model returns a null bit error rate
+  const double minLogBer = -700.0;
+  uint32_t size = static_cast<uint32_t> (std::floor ((m_tableMaxSnr - m_tableMinSnr) / m_tableResolution)) + 1;
+  std::vector<double> &table = m_berTables[key];
+  table.reserve (size);
+  for (uint32_t i = 0; i < size; i++)
+    {
+      double snr = std::pow (10.0, (m_tableMinSnr + i * m_tableResolution) / 10.0);
+      double ber = 1.0 - DoGetChunkSuccessRate (mode, txVector, snr, 1);
+      table.push_back (ber > 0 ? std::max (std::log (ber), minLogBer) : minLogBer);
+    }
+  return table;
+}
+
 } //namespace ns3
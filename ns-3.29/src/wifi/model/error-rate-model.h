@@ -22,6 +22,8 @@
 #define ERROR_RATE_MODEL_H
 
 #include "ns3/object.h"
+#include <unordered_map>
+#include <vector>
 
 namespace ns3 {
 
@@ -42,6 +44,42 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  ErrorRateModel ();
+
+  /**
+   * Set the lowest SNR of the tables of the bit error rate. The tables
+   * already computed are dropped.
+   *
+   * \param snr the lowest SNR (dB)
+   */
+  void SetTableMinSnr (double snr);
+  /**
+   * \return the lowest SNR (dB) of the tables of the bit error rate
+   */
+  double GetTableMinSnr (void) const;
+  /**
+   * Set the highest SNR of the tables of the bit error rate. The tables
+   * already computed are dropped.
+   *
+   * \param snr the highest SNR (dB)
+   */
+  void SetTableMaxSnr (double snr);
+  /**
+   * \return the highest SNR (dB) of the tables of the bit error rate
+   */
+  double GetTableMaxSnr (void) const;
+  /**
+   * Set the SNR step of the tables of the bit error rate. The tables
+   * already computed are dropped.
+   *
+   * \param resolution the SNR step (dB)
+   */
+  void SetTableResolution (double resolution);
+  /**
+   * \return the SNR step (dB) of the tables of the bit error rate
+   */
+  double GetTableResolution (void) const;
+
   /**
    * \param txVector a specific transmission vector including WifiMode
    * \param ber a target ber
@@ -51,7 +89,6 @@ public:
   double CalculateSnr (WifiTxVector txVector, double ber) const;
 
   /**
-   * A pure virtual method that must be implemented in the subclass.
    * This method returns the probability that the given 'chunk' of the
    * packet will be successfully received by the PHY.
    *
@@ -66,6 +103,46 @@ public:
    * to calculate the chunk error rate, and the txVector is used for
    * other information as needed.
    *
+   * If the UseTables attribute is set, the success rate is derived from
+   * a table of the bit error rate of the mode, which is computed with
+   * DoGetChunkSuccessRate on a grid of SNR values in dB the first time
+   * the mode is used: the logarithm of the bit error rate is linearly
+   * interpolated between the two nearest SNR values of the grid, and the
+   * chunk success rate is (1 - ber)^nbits. SNR values outside the range
+   * of the tables are handed to DoGetChunkSuccessRate.
+   *
+   * \param mode the Wi-Fi mode applicable to this chunk
+   * \param txVector TXVECTOR of the overall transmission
+   * \param snr the SNR of the chunk
+   * \param nbits the number of bits in this chunk
+   *
+   * \return probability of successfully receiving the chunk
+   */
+  double GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
+
+  /**
+   * This method returns the probability that the given 'chunk' of the
+   * packet will be successfully received by the PHY, as derived from the
+   * table of the bit error rate of the mode, whether the UseTables
+   * attribute is set or not (see GetChunkSuccessRate).
+   *
+   * \param mode the Wi-Fi mode applicable to this chunk
+   * \param txVector TXVECTOR of the overall transmission
+   * \param snr the SNR of the chunk
+   * \param nbits the number of bits in this chunk
+   *
+   * \return probability of successfully receiving the chunk
+   */
+  double GetTabulatedChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
+
+
+private:
+  /**
+   * A pure virtual method that must be implemented in the subclass.
+   * This method returns the probability that the given 'chunk' of the
+   * packet will be successfully received by the PHY, as computed by the
+   * model (see GetChunkSuccessRate).
+   *
    * \param mode the Wi-Fi mode applicable to this chunk
    * \param txVector TXVECTOR of the overall transmission
    * \param snr the SNR of the chunk
@@ -73,7 +150,30 @@ public:
    *
    * \return probability of successfully receiving the chunk
    */
-  virtual double GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const = 0;
+  virtual double DoGetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const = 0;
+
+  /**
+   * Return the table of the bit error rate of the given mode, computing
+   * it if needed.
+   *
+   * \param mode the Wi-Fi mode applicable to the chunk
+   * \param txVector TXVECTOR of the overall transmission
+   *
+   * \return the natural logarithm of the bit error rate for each SNR
+   *         value of the grid
+   */
+  const std::vector<double> & GetBerTable (WifiMode mode, WifiTxVector txVector) const;
+
+  bool m_useTables;         //!< whether the chunk success rates are derived from tables
+  double m_tableMinSnr;     //!< the lowest SNR (dB) of the tables
+  double m_tableMaxSnr;     //!< the highest SNR (dB) of the tables
+  double m_tableResolution; //!< the SNR step (dB) of the tables
+  /**
+   * The tables of the natural logarithm of the bit error rate, indexed by
+   * the mode and the parameters of the TXVECTOR the model may depend on
+   * (channel width, guard interval and number of spatial streams)
+   */
+  mutable std::unordered_map<uint64_t, std::vector<double> > m_berTables;
 };
 
 } //namespace ns3
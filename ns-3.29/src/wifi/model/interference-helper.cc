@@ -89,12 +89,19 @@ Event::GetPayloadMode (void) const
  *       short period of time.
  ****************************************************************/
 
-InterferenceHelper::NiChange::NiChange (double power, Ptr<Event> event)
-  : m_power (power),
+InterferenceHelper::NiChange::NiChange (double delta, Ptr<Event> event)
+  : m_delta (delta),
+    m_power (0),
     m_event (event)
 {
 }
 
+double
+InterferenceHelper::NiChange::GetDelta (void) const
+{
+  return m_delta;
+}
+
 double
 InterferenceHelper::NiChange::GetPower (void) const
 {
@@ -102,9 +109,9 @@ InterferenceHelper::NiChange::GetPower (void) const
 }
 
 void
-InterferenceHelper::NiChange::AddPower (double power)
+InterferenceHelper::NiChange::SetPower (double power)
 {
-  m_power += power;
+  m_power = power;
 }
 
 Ptr<Event>
@@ -121,11 +128,11 @@ InterferenceHelper::NiChange::GetEvent (void) const
 InterferenceHelper::InterferenceHelper ()
   : m_errorRateModel (0),
     m_numRxAntennas (1),
-    m_firstPower (0),
-    m_rxing (false)
+    m_power (0)
 {
-  // Always have a zero power noise event in the list
-  AddNiChangeEvent (Time (0), NiChange (0.0, 0));
+  // Always have a zero power noise event at the end of the list
+  m_nextChange = m_niChanges.end ();
+  AddNiChangeEvent (Time::Max (), NiChange (0.0, 0));
 }
 
 InterferenceHelper::~InterferenceHelper ()
@@ -180,41 +187,54 @@ Time
 InterferenceHelper::GetEnergyDuration (double energyW) const
 {
   Time now = Simulator::Now ();
-  auto i = GetPreviousPosition (now);
-  Time end = i->first;
-  for (; i != m_niChanges.end (); ++i)
+  AdvanceTo (now);
+  double noiseInterferenceW = m_power;
+  Time end = now;
+  for (auto i = m_nextChange; noiseInterferenceW >= energyW && i->second.GetEvent () != 0; ++i)
     {
-      double noiseInterferenceW = i->second.GetPower ();
+      noiseInterferenceW += i->second.GetDelta ();
       end = i->first;
-      if (noiseInterferenceW < energyW)
-        {
-          break;
-        }
     }
-  return end > now ? end - now : MicroSeconds (0);
+  return end - now;
 }
 
 void
 InterferenceHelper::AppendEvent (Ptr<Event> event)
 {
   NS_LOG_FUNCTION (this);
-  double previousPowerStart = 0;
-  double previousPowerEnd = 0;
-  previousPowerStart = GetPreviousPosition (event->GetStartTime ())->second.GetPower ();
-  previousPowerEnd = GetPreviousPosition (event->GetEndTime ())->second.GetPower ();
+  AdvanceTo (event->GetStartTime ());
+  RemoveEndedEvents ();
+  AddNiChangeEvent (event->GetStartTime (), NiChange (event->GetRxPowerW (), event));
+  AddNiChangeEvent (event->GetEndTime (), NiChange (-event->GetRxPowerW (), event));
+  // the change at the start of the event is accounted for right away, so
+  // that the power before it is kept
+  AdvanceTo (event->GetStartTime ());
+}
+
+void
+InterferenceHelper::AdvanceTo (Time moment) const
+{
+  while (m_nextChange->first <= moment)
+    {
+      m_power += m_nextChange->second.GetDelta ();
+      m_nextChange->second.SetPower (m_power);
+      ++m_nextChange;
+    }
+}
 
-  if (!m_rxing)
+void
+InterferenceHelper::RemoveEndedEvents (void)
+{
+  Time now = Simulator::Now ();
+  while (m_niChanges.begin () != m_nextChange
+         && m_niChanges.begin ()->second.GetEvent ()->GetEndTime () < now)
     {
-      m_firstPower = previousPowerStart;
-      // Always leave the first zero power noise event in the list
-      m_niChanges.erase (++(m_niChanges.begin ()),
-                         GetNextPosition (event->GetStartTime ()));
+      m_niChanges.erase (m_niChanges.begin ());
     }
-  auto first = AddNiChangeEvent (event->GetStartTime (), NiChange (previousPowerStart, event));
-  auto last = AddNiChangeEvent (event->GetEndTime (), NiChange (previousPowerEnd, event));
-  for (auto i = first; i != last; ++i)
+  if (m_niChanges.size () == 1)
     {
-      i->second.AddPower (event->GetRxPowerW ());
+      // no signal left: get rid of the rounding errors of the sum
+      m_power = 0;
     }
 }
 
@@ -234,25 +254,53 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, uint1
 }
 
 double
-InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const
+InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiPowers *ni) const
 {
-  double noiseInterference = m_firstPower;
-  auto it = m_niChanges.find (event->GetStartTime ());
-  for (; it != m_niChanges.end () && it->second.GetEvent () != event; ++it)
+  auto it = m_niChanges.lower_bound (event->GetStartTime ());
+  while (it->second.GetEvent () != event)
     {
-      noiseInterference = it->second.GetPower ();
+      NS_ASSERT (it->first == event->GetStartTime ());
+      ++it;
     }
-  ni->emplace (event->GetStartTime (), NiChange (0, event));
-  while (++it != m_niChanges.end () && it->second.GetEvent () != event)
+  // the change at the start of the event has been accounted for when the
+  // event was added
+  double powerW = it->second.GetPower ();
+  double noiseInterference = powerW - event->GetRxPowerW ();
+  ni->emplace_back (event->GetStartTime (), noiseInterference);
+  while ((++it)->second.GetEvent () != event)
     {
-      ni->insert (*it);
+      powerW += it->second.GetDelta ();
+      ni->emplace_back (it->first, powerW - event->GetRxPowerW ());
     }
-  ni->emplace (event->GetEndTime (), NiChange (0, event));
+  ni->emplace_back (event->GetEndTime (), 0);
   return noiseInterference;
 }
 
 double
-InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode, WifiTxVector txVector) const
+InterferenceHelper::CalculateMeanNoiseInterferenceW (Ptr<Event> event, double *startNoiseInterferenceW) const
+{
+  auto it = m_niChanges.lower_bound (event->GetStartTime ());
+  while (it->second.GetEvent () != event)
+    {
+      NS_ASSERT (it->first == event->GetStartTime ());
+      ++it;
+    }
+  double powerW = it->second.GetPower ();
+  *startNoiseInterferenceW = powerW - event->GetRxPowerW ();
+  Time previous = event->GetStartTime ();
+  double energy = 0;
+  while ((++it)->second.GetEvent () != event)
+    {
+      energy += (powerW - event->GetRxPowerW ()) * (it->first - previous).GetSeconds ();
+      powerW += it->second.GetDelta ();
+      previous = it->first;
+    }
+  energy += (powerW - event->GetRxPowerW ()) * (event->GetEndTime () - previous).GetSeconds ();
+  return energy / (event->GetEndTime () - event->GetStartTime ()).GetSeconds ();
+}
+
+double
+InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode, WifiTxVector txVector, bool tabulated) const
 {
   if (duration.IsZero ())
     {
@@ -269,12 +317,16 @@ InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiM
                     ", SNIR improvement=+" << 10 * std::log10 (gain) << "dB");
       snir *= gain;
     }
+  if (tabulated)
+    {
+      return m_errorRateModel->GetTabulatedChunkSuccessRate (mode, txVector, snir, nbits);
+    }
   double csr = m_errorRateModel->GetChunkSuccessRate (mode, txVector, snir, nbits);
   return csr;
 }
 
 double
-InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges *ni) const
+InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const Event> event, const NiPowers *ni) const
 {
   NS_LOG_FUNCTION (this);
   const WifiTxVector txVector = event->GetTxVector ();
@@ -287,7 +339,7 @@ InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges *
   Time plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (txVector); //packet start time + preamble + L-SIG
   Time plcpTrainingSymbolsStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble) + WifiPhy::GetPlcpSigA1Duration (preamble) + WifiPhy::GetPlcpSigA2Duration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A
   Time plcpPayloadStart = plcpTrainingSymbolsStart + WifiPhy::GetPlcpTrainingSymbolDuration (txVector) + WifiPhy::GetPlcpSigBDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A + Training + SIG-B
-  double noiseInterferenceW = m_firstPower;
+  double noiseInterferenceW = j->second;
   double powerW = event->GetRxPowerW ();
   while (++j != ni->end ())
     {
@@ -314,7 +366,7 @@ InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges *
                                             payloadMode, txVector);
           NS_LOG_DEBUG ("previous is before payload and current is in the payload: mode=" << payloadMode << ", psr=" << psr);
         }
-      noiseInterferenceW = j->second.GetPower () - powerW;
+      noiseInterferenceW = j->second;
       previous = j->first;
     }
   double per = 1 - psr;
@@ -322,7 +374,7 @@ InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges *
 }
 
 double
-InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges *ni) const
+InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const Event> event, const NiPowers *ni) const
 {
   NS_LOG_FUNCTION (this);
   const WifiTxVector txVector = event->GetTxVector ();
@@ -351,7 +403,7 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges *n
   Time plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (txVector); //packet start time + preamble + L-SIG
   Time plcpTrainingSymbolsStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble) + WifiPhy::GetPlcpSigA1Duration (preamble) + WifiPhy::GetPlcpSigA2Duration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A
   Time plcpPayloadStart = plcpTrainingSymbolsStart + WifiPhy::GetPlcpTrainingSymbolDuration (txVector) + WifiPhy::GetPlcpSigBDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A + Training + SIG-B
-  double noiseInterferenceW = m_firstPower;
+  double noiseInterferenceW = j->second;
   double powerW = event->GetRxPowerW ();
   while (++j != ni->end ())
     {
@@ -728,7 +780,7 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges *n
             }
         }
 
-      noiseInterferenceW = j->second.GetPower () - powerW;
+      noiseInterferenceW = j->second;
       previous = j->first;
     }
 
@@ -739,7 +791,7 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges *n
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<Event> event) const
 {
-  NiChanges ni;
+  NiPowers ni;
   double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
@@ -759,7 +811,7 @@ InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<Event> event) const
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<Event> event) const
 {
-  NiChanges ni;
+  NiPowers ni;
   double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
@@ -776,54 +828,71 @@ InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<Event> event) const
   return snrPer;
 }
 
-void
-InterferenceHelper::EraseEvents (void)
+struct InterferenceHelper::AbstractedSnrPer
+InterferenceHelper::CalculateAbstractedSnrPer (Ptr<Event> event) const
 {
-  m_niChanges.clear ();
-  // Always have a zero power noise event in the list
-  AddNiChangeEvent (Time (0), NiChange (0.0, 0));
-  m_rxing = false;
-  m_firstPower = 0;
-}
+  NS_LOG_FUNCTION (this << event);
+  const WifiTxVector txVector = event->GetTxVector ();
+  double noiseInterferenceW;
+  double meanNoiseInterferenceW = CalculateMeanNoiseInterferenceW (event, &noiseInterferenceW);
+  double snir = CalculateSnr (event->GetRxPowerW (), meanNoiseInterferenceW, txVector.GetChannelWidth ());
 
-InterferenceHelper::NiChanges::const_iterator
-InterferenceHelper::GetNextPosition (Time moment) const
-{
-  return m_niChanges.upper_bound (moment);
+  WifiPreamble preamble = txVector.GetPreambleType ();
+  WifiMode mcsHeaderMode;
+  if (preamble == WIFI_PREAMBLE_HT_MF || preamble == WIFI_PREAMBLE_HT_GF)
+    {
+      mcsHeaderMode = WifiPhy::GetHtPlcpHeaderMode ();
+    }
+  else if (preamble == WIFI_PREAMBLE_VHT)
+    {
+      mcsHeaderMode = WifiPhy::GetVhtPlcpHeaderMode ();
+    }
+  else if (preamble == WIFI_PREAMBLE_HE_SU)
+    {
+      mcsHeaderMode = WifiPhy::GetHePlcpHeaderMode ();
+    }
+  Time plcpHeaderStart = event->GetStartTime () + WifiPhy::GetPlcpPreambleDuration (txVector);
+  Time plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (txVector);
+  Time plcpPayloadStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble) + WifiPhy::GetPlcpSigA1Duration (preamble) + WifiPhy::GetPlcpSigA2Duration (preamble)
+    + WifiPhy::GetPlcpTrainingSymbolDuration (txVector) + WifiPhy::GetPlcpSigBDuration (preamble);
+
+  //L-SIG, then HT-SIG or SIG-A, training and SIG-B
+  double headerPsr = CalculateChunkSuccessRate (snir, plcpHsigHeaderStart - plcpHeaderStart,
+                                                WifiPhy::GetPlcpHeaderMode (txVector), txVector, true);
+  headerPsr *= CalculateChunkSuccessRate (snir, plcpPayloadStart - plcpHsigHeaderStart,
+                                          mcsHeaderMode, txVector, true);
+  double payloadPsr = CalculateChunkSuccessRate (snir, event->GetEndTime () - plcpPayloadStart,
+                                                 event->GetPayloadMode (), txVector, true);
+  NS_LOG_DEBUG ("mean snir=" << snir << ", header psr=" << headerPsr << ", payload psr=" << payloadPsr);
+
+  struct AbstractedSnrPer snrPer;
+  snrPer.snr = CalculateSnr (event->GetRxPowerW (), noiseInterferenceW, txVector.GetChannelWidth ());
+  snrPer.headerPer = 1 - headerPsr;
+  snrPer.payloadPer = 1 - payloadPsr;
+  return snrPer;
 }
 
-InterferenceHelper::NiChanges::const_iterator
-InterferenceHelper::GetPreviousPosition (Time moment) const
+void
+InterferenceHelper::EraseEvents (void)
 {
-  auto it = GetNextPosition (moment);
-  // This is safe since there is always an NiChange at time 0,
-  // before moment.
-  --it;
-  return it;
+  m_niChanges.clear ();
+  m_nextChange = m_niChanges.end ();
+  m_power = 0;
+  // Always have a zero power noise event at the end of the list
+  AddNiChangeEvent (Time::Max (), NiChange (0.0, 0));
 }
 
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::AddNiChangeEvent (Time moment, NiChange change)
 {
-  return m_niChanges.insert (GetNextPosition (moment), std::make_pair (moment, change));
-}
-
-void
-InterferenceHelper::NotifyRxStart ()
-{
-  NS_LOG_FUNCTION (this);
-  m_rxing = true;
-}
-
-void
-InterferenceHelper::NotifyRxEnd ()
-{
-  NS_LOG_FUNCTION (this);
-  m_rxing = false;
-  //Update m_firstPower for frame capture
-  auto it = m_niChanges.find (Simulator::Now ());
-  it--;
-  m_firstPower = it->second.GetPower ();
+  auto it = m_niChanges.insert (m_niChanges.upper_bound (moment), std::make_pair (moment, change));
+  // the changes are never added before the ones which have been accounted
+  // for, but may be added right before the first one which has not
+  if (std::next (it) == m_nextChange)
+    {
+      m_nextChange = it;
+    }
+  return it;
 }
 
 } //namespace ns3
@@ -24,6 +24,7 @@
 #include "ns3/nstime.h"
 #include "wifi-tx-vector.h"
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -114,6 +115,17 @@ public:
     double per; ///< PER
   };
 
+  /**
+   * A struct for the SNR and the PERs of the PLCP header and payload of
+   * an abstracted reception
+   */
+  struct AbstractedSnrPer
+  {
+    double snr;        ///< SNR at the start of the signal
+    double headerPer;  ///< PER of the PLCP header
+    double payloadPer; ///< PER of the PLCP payload
+  };
+
   InterferenceHelper ();
   ~InterferenceHelper ();
 
@@ -189,15 +201,19 @@ public:
    * \return struct of SNR and PER
    */
   struct InterferenceHelper::SnrPer CalculatePlcpHeaderSnrPer (Ptr<Event> event) const;
-
-  /**
-   * Notify that RX has started.
-   */
-  void NotifyRxStart ();
   /**
-   * Notify that RX has ended.
+   * Calculate the SNIR at the start of the signal, and the error rates of
+   * the plcp header and of the plcp payload at the SNIR of the mean noise
+   * and interference power over the whole signal. The success rates of the
+   * header and payload fields are looked up in the bit error rate tables of
+   * the error rate model (see ErrorRateModel::GetTabulatedChunkSuccessRate).
+   *
+   * \param event the event corresponding to the first time the corresponding packet arrives
+   *
+   * \return struct of SNR and of the PERs of the plcp header and payload
    */
-  void NotifyRxEnd ();
+  struct InterferenceHelper::AbstractedSnrPer CalculateAbstractedSnrPer (Ptr<Event> event) const;
+
   /**
    * Erase all events.
    */
@@ -207,6 +223,13 @@ public:
 private:
   /**
    * Noise and Interference (thus Ni) event.
+   *
+   * A NiChange only records the change of the received power caused by
+   * the start or the end of a signal. The total received power after the
+   * change is stored once all the changes up to the current time have
+   * been accounted for (see AdvanceTo): since signals only start at the
+   * current time and end in the future, the changes in the past are
+   * never modified again.
    */
   class NiChange
   {
@@ -214,22 +237,29 @@ public:
     /**
      * Create a NiChange at the given time and the amount of NI change.
      *
-     * \param power the power
+     * \param delta the change of the received power
      * \param event causes this NI change
      */
-    NiChange (double power, Ptr<Event> event);
+    NiChange (double delta, Ptr<Event> event);
+    /**
+     * Return the change of the received power
+     *
+     * \return the change of the received power
+     */
+    double GetDelta (void) const;
     /**
-     * Return the power
+     * Return the total received power after this change, which is only
+     * known once the change has been accounted for.
      *
      * \return the power
      */
     double GetPower (void) const;
     /**
-     * Add a given amount of power.
+     * Set the total received power after this change.
      *
-     * \param power the power to be added to the existing value
+     * \param power the power
      */
-    void AddPower (double power);
+    void SetPower (double power);
     /**
      * Return the event causes the corresponding NI change
      *
@@ -239,7 +269,8 @@ public:
 
 
 private:
-    double m_power; ///< power
+    double m_delta; ///< change of the received power
+    double m_power; ///< received power after the change
     Ptr<Event> m_event; ///< event
   };
 
@@ -247,6 +278,12 @@ private:
    * typedef for a multimap of NiChanges
    */
   typedef std::multimap<Time, NiChange> NiChanges;
+  /**
+   * typedef for the noise and interference power (W) of the other signals
+   * after each NI change during a signal, starting with its start and
+   * ending with its end
+   */
+  typedef std::vector<std::pair<Time, double> > NiPowers;
 
   /**
    * Append the given Event.
@@ -258,11 +295,20 @@ private:
    * Calculate noise and interference power in W.
    *
    * \param event
-   * \param ni
+   * \param ni the noise and interference power after each change during the event
    *
-   * \return noise and interference power
+   * \return noise and interference power at the start of the event
    */
-  double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const;
+  double CalculateNoiseInterferenceW (Ptr<Event> event, NiPowers *ni) const;
+  /**
+   * Calculate the mean noise and interference power in W over the signal.
+   *
+   * \param event
+   * \param startNoiseInterferenceW the noise and interference power at the start of the event
+   *
+   * \return the mean noise and interference power over the event
+   */
+  double CalculateMeanNoiseInterferenceW (Ptr<Event> event, double *startNoiseInterferenceW) const;
   /**
    * Calculate SNR (linear ratio) from the given signal power and noise+interference power.
    * (Mode is not currently used)
@@ -282,61 +328,58 @@ private:
    * \param duration
    * \param mode
    * \param txVector
+   * \param tabulated whether the tables of the error rate model must be used
    *
    * \return the success rate
    */
-  double CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode, WifiTxVector txVector) const;
+  double CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode, WifiTxVector txVector, bool tabulated = false) const;
   /**
    * Calculate the error rate of the given plcp payload. The plcp payload can be divided into
    * multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event
-   * \param ni
+   * \param ni the noise and interference power after each change during the event
    *
    * \return the error rate of the packet
    */
-  double CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculatePlcpPayloadPer (Ptr<const Event> event, const NiPowers *ni) const;
   /**
    * Calculate the error rate of the plcp header. The plcp header can be divided into
    * multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event
-   * \param ni
+   * \param ni the noise and interference power after each change during the event
    *
    * \return the error rate of the packet
    */
-  double CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculatePlcpHeaderPer (Ptr<const Event> event, const NiPowers *ni) const;
 
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel; ///< error rate model
   uint8_t m_numRxAntennas; /**< the number of RX antennas in the corresponding receiver */
-  /// Experimental: needed for energy duration calculation
-  NiChanges m_niChanges;
-  double m_firstPower; ///< first power
-  bool m_rxing; ///< flag whether it is in receiving state
-
   /**
-   * Returns an iterator to the first nichange that is later than moment
-   *
-   * \param moment time to check from
-   * \returns an iterator to the list of NiChanges
+   * The NI changes of the signals which have not ended yet, and of the
+   * ended signals which started after them, terminated by a change of
+   * null power at Time::Max ()
    */
-  NiChanges::const_iterator GetNextPosition (Time moment) const;
+  mutable NiChanges m_niChanges;
+  /// The first NI change which has not been accounted for in m_power
+  mutable NiChanges::iterator m_nextChange;
+  /// The total received power after the NI changes before m_nextChange
+  mutable double m_power;
+
   /**
-   * Returns an iterator to the first nichange that is later than moment
+   * Account for the NI changes up to the given time, i.e., set the total
+   * received power after each of them.
    *
-   * \param moment time to check from
-   * \returns an iterator to the list of NiChanges
+   * \param moment the time
    */
-  //NiChanges::iterator GetNextPosition (Time moment);
+  void AdvanceTo (Time moment) const;
   /**
-   * Returns an iterator to the last nichange that is before than moment
-   *
-   * \param moment time to check from
-   * \returns an iterator to the list of NiChanges
+   * Remove the NI changes which are no longer needed, i.e., the first
+   * changes as long as they belong to signals which have ended.
    */
-  NiChanges::const_iterator GetPreviousPosition (Time moment) const;
-
+  void RemoveEndedEvents (void);
   /**
    * Add NiChange to the list at the appropriate position and
    * return the iterator of the new event.
@@ -34,6 +34,7 @@
  * reference: http://lwn.net/Articles/376765/
  */
 
+#include <algorithm>
 #include <iomanip>
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -50,6 +51,32 @@ NS_LOG_COMPONENT_DEFINE ("MinstrelHtWifiManager");
 
 namespace ns3 {
 
+HtRatesTable::HtRatesTable ()
+{
+}
+
+HtRatesTable::HtRatesTable (uint8_t numRates)
+  : perfectTxTime (numRates),
+    perfectTxTimeSeconds (numRates, 0),
+    supported (numRates, false),
+    mcsIndex (numRates, 0),
+    retryCount (numRates, 0),
+    adjustedRetryCount (numRates, 0),
+    numRateAttempt (numRates, 0),
+    numRateSuccess (numRates, 0),
+    prob (numRates, 0),
+    retryUpdated (numRates, false),
+    ewmaProb (numRates, 0),
+    ewmsdProb (numRates, 0),
+    prevNumRateAttempt (numRates, 0),
+    prevNumRateSuccess (numRates, 0),
+    numSamplesSkipped (numRates, 0),
+    successHist (numRates, 0),
+    attemptHist (numRates, 0),
+    throughput (numRates, 0)
+{
+}
+
 ///MinstrelHtWifiRemoteStation structure
 struct MinstrelHtWifiRemoteStation : MinstrelWifiRemoteStation
 {
@@ -114,6 +141,13 @@ MinstrelHtWifiManager::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&MinstrelHtWifiManager::m_printStats),
                    MakeBooleanChecker ())
+    .AddAttribute ("StaggerStatsUpdates",
+                   "If true, the first statistics update of each station happens at a random "
+                   "time within the update interval, so that the stations initialized together "
+                   "do not update their statistics at the same time",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MinstrelHtWifiManager::m_staggerStatsUpdates),
+                   MakeBooleanChecker ())
     .AddTraceSource ("Rate",
                      "Traced value for rate changes (b/s)",
                      MakeTraceSourceAccessor (&MinstrelHtWifiManager::m_currentRate),
@@ -391,6 +425,7 @@ MinstrelHtWifiManager::DoCreateStation (void) const
   station->m_longRetry = 0;
   station->m_txrate = 0;
   station->m_initialized = false;
+  station->m_sampleTable = 0;
 
   // Variables specific to HT station
   station->m_sampleGroup = 0;
@@ -447,6 +482,7 @@ MinstrelHtWifiManager::CheckInit (MinstrelHtWifiRemoteStation *station)
           m_legacyManager->SetAttribute ("SampleColumn", UintegerValue (m_nSampleCol));
           m_legacyManager->SetAttribute ("PacketLength", UintegerValue (m_frameLength));
           m_legacyManager->SetAttribute ("PrintStats", BooleanValue (m_printStats));
+          m_legacyManager->SetAttribute ("StaggerStatsUpdates", BooleanValue (m_staggerStatsUpdates));
           m_legacyManager->CheckInit (station);
         }
       else
@@ -455,9 +491,14 @@ MinstrelHtWifiManager::CheckInit (MinstrelHtWifiRemoteStation *station)
           station->m_isHt = true;
           station->m_nModes = GetNMcsSupported (station);
           station->m_minstrelTable = MinstrelRate (station->m_nModes);
-          station->m_sampleTable = SampleRate (m_numRates, std::vector<uint8_t> (m_nSampleCol));
           InitSampleTable (station);
           RateInit (station);
+          if (m_staggerStatsUpdates)
+            {
+              // Spread the first update over an interval, so that the stations
+              // initialized together do not update their statistics together.
+              station->m_nextStatsUpdate = Simulator::Now () + Seconds (m_updateStats.GetSeconds () * m_uniformRandomVariable->GetValue (0, 1));
+            }
           std::ostringstream tmp;
           tmp << "minstrel-ht-stats-" << station->m_state->m_address << ".txt";
           station->m_statsFile.open (tmp.str ().c_str (), std::ios::out);
@@ -529,7 +570,7 @@ MinstrelHtWifiManager::DoReportDataFailed (WifiRemoteStation *st)
     {
       uint8_t rateId = GetRateId (station->m_txrate);
       uint8_t groupId = GetGroupId (station->m_txrate);
-      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt++; // Increment the attempts counter for the rate used.
+      station->m_groupsTable[groupId].m_ratesTable.numRateAttempt[rateId]++; // Increment the attempts counter for the rate used.
       UpdateRate (station);
     }
 }
@@ -569,8 +610,8 @@ MinstrelHtWifiManager::DoReportDataOk (WifiRemoteStation *st, double ackSnr, Wif
     {
       uint8_t rateId = GetRateId (station->m_txrate);
       uint8_t groupId = GetGroupId (station->m_txrate);
-      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess++;
-      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt++;
+      station->m_groupsTable[groupId].m_ratesTable.numRateSuccess[rateId]++;
+      station->m_groupsTable[groupId].m_ratesTable.numRateAttempt[rateId]++;
 
       UpdatePacketCounters (station, 1, 0);
 
@@ -665,8 +706,8 @@ MinstrelHtWifiManager::DoReportAmpduTxStatus (WifiRemoteStation *st, uint8_t nSu
 
   uint8_t rateId = GetRateId (station->m_txrate);
   uint8_t groupId = GetGroupId (station->m_txrate);
-  station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess += nSuccessfulMpdus;
-  station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt += nSuccessfulMpdus + nFailedMpdus;
+  station->m_groupsTable[groupId].m_ratesTable.numRateSuccess[rateId] += nSuccessfulMpdus;
+  station->m_groupsTable[groupId].m_ratesTable.numRateAttempt[rateId] += nSuccessfulMpdus + nFailedMpdus;
 
   if (nSuccessfulMpdus == 0 && station->m_longRetry < CountRetries (station))
     {
@@ -739,24 +780,24 @@ MinstrelHtWifiManager::UpdateRate (MinstrelHtWifiRemoteStation *station)
   if (!station->m_isSampling)
     {
       /// Use best throughput rate.
-      if (station->m_longRetry <  station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].retryCount)
+      if (station->m_longRetry <  station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTpRateId])
         {
           NS_LOG_DEBUG ("Not Sampling; use the same rate again");
           station->m_txrate = station->m_maxTpRate;  //!<  There are still a few retries.
         }
 
       /// Use second best throughput rate.
-      else if (station->m_longRetry < ( station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].retryCount +
-                                        station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].retryCount))
+      else if (station->m_longRetry < ( station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTpRateId] +
+                                        station->m_groupsTable[maxTp2GroupId].m_ratesTable.retryCount[maxTp2RateId]))
         {
           NS_LOG_DEBUG ("Not Sampling; use the Max TP2");
           station->m_txrate = station->m_maxTpRate2;
         }
 
       /// Use best probability rate.
-      else if (station->m_longRetry <= ( station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].retryCount +
-                                         station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].retryCount +
-                                         station->m_groupsTable[maxProbGroupId].m_ratesTable[maxProbRateId].retryCount))
+      else if (station->m_longRetry <= ( station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTpRateId] +
+                                         station->m_groupsTable[maxTp2GroupId].m_ratesTable.retryCount[maxTp2RateId] +
+                                         station->m_groupsTable[maxProbGroupId].m_ratesTable.retryCount[maxProbRateId]))
         {
           NS_LOG_DEBUG ("Not Sampling; use Max Prob");
           station->m_txrate = station->m_maxProbRate;
@@ -772,15 +813,15 @@ MinstrelHtWifiManager::UpdateRate (MinstrelHtWifiRemoteStation *station)
     {
       /// Sample rate is used only once
       /// Use the best rate.
-      if (station->m_longRetry < 1 + station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTp2RateId].retryCount)
+      if (station->m_longRetry < 1 + station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTp2RateId])
         {
           NS_LOG_DEBUG ("Sampling use the MaxTP rate");
           station->m_txrate = station->m_maxTpRate2;
         }
 
       /// Use the best probability rate.
-      else if (station->m_longRetry <= 1 + station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTp2RateId].retryCount +
-               station->m_groupsTable[maxProbGroupId].m_ratesTable[maxProbRateId].retryCount)
+      else if (station->m_longRetry <= 1 + station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTp2RateId] +
+               station->m_groupsTable[maxProbGroupId].m_ratesTable.retryCount[maxProbRateId])
         {
           NS_LOG_DEBUG ("Sampling use the MaxProb rate");
           station->m_txrate = station->m_maxProbRate;
@@ -853,7 +894,7 @@ MinstrelHtWifiManager::DoGetDataTxVector (WifiRemoteStation *st)
 
       uint8_t rateId = GetRateId (station->m_txrate);
       uint8_t groupId = GetGroupId (station->m_txrate);
-      uint8_t mcsIndex = station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex;
+      uint8_t mcsIndex = station->m_groupsTable[groupId].m_ratesTable.mcsIndex[rateId];
 
       NS_LOG_DEBUG ("DoGetDataMode rateId= " << +rateId << " groupId= " << +groupId << " mode= " << GetMcsSupported (station, mcsIndex));
 
@@ -913,7 +954,7 @@ MinstrelHtWifiManager::DoGetRtsTxVector (WifiRemoteStation *st)
       // As we are in Minstrel HT, assume the last rate was an HT rate.
       uint8_t rateId = GetRateId (station->m_txrate);
       uint8_t groupId = GetGroupId (station->m_txrate);
-      uint8_t mcsIndex = station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex;
+      uint8_t mcsIndex = station->m_groupsTable[groupId].m_ratesTable.mcsIndex[rateId];
 
       WifiMode lastRate = GetMcsSupported (station, mcsIndex);
       uint64_t lastDataRate = lastRate.GetNonHtReferenceRate ();
@@ -1002,14 +1043,14 @@ MinstrelHtWifiManager::CountRetries (MinstrelHtWifiRemoteStation *station)
 
   if (!station->m_isSampling)
     {
-      return station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].retryCount +
-             station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].retryCount +
-             station->m_groupsTable[maxProbGroupId].m_ratesTable[maxProbRateId].retryCount;
+      return station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTpRateId] +
+             station->m_groupsTable[maxTp2GroupId].m_ratesTable.retryCount[maxTp2RateId] +
+             station->m_groupsTable[maxProbGroupId].m_ratesTable.retryCount[maxProbRateId];
     }
   else
     {
-      return 1 + station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTp2RateId].retryCount +
-             station->m_groupsTable[maxProbGroupId].m_ratesTable[maxProbRateId].retryCount;
+      return 1 + station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTp2RateId] +
+             station->m_groupsTable[maxProbGroupId].m_ratesTable.retryCount[maxProbRateId];
     }
 }
 
@@ -1026,7 +1067,7 @@ MinstrelHtWifiManager::GetNextSample (MinstrelHtWifiRemoteStation *station)
   uint8_t sampleGroup = station->m_sampleGroup;
   uint8_t index = station->m_groupsTable[sampleGroup].m_index;
   uint8_t col = station->m_groupsTable[sampleGroup].m_col;
-  uint8_t sampleIndex = station->m_sampleTable[index][col];
+  uint8_t sampleIndex = (*station->m_sampleTable)[index][col];
   uint16_t rateIndex = GetIndex (sampleGroup, sampleIndex);
   NS_LOG_DEBUG ("Next Sample is " << rateIndex);
   SetNextSample (station); //Calculate the next sample rate.
@@ -1061,7 +1102,7 @@ MinstrelHtWifiManager::SetNextSample (MinstrelHtWifiRemoteStation *station)
       index = station->m_groupsTable[station->m_sampleGroup].m_index;
       col = station->m_groupsTable[sampleGroup].m_col;
     }
-  NS_LOG_DEBUG ("New sample set: group= " << +sampleGroup << " index= " << +station->m_sampleTable[index][col]);
+  NS_LOG_DEBUG ("New sample set: group= " << +sampleGroup << " index= " << +(*station->m_sampleTable)[index][col]);
 }
 
 uint16_t
@@ -1089,7 +1130,7 @@ MinstrelHtWifiManager::FindRate (MinstrelHtWifiRemoteStation *station)
       uint8_t sampleRateId = GetRateId (sampleIdx);
 
       // If the rate selected is not supported, then don't sample.
-      if (station->m_groupsTable[sampleGroupId].m_supported && station->m_groupsTable[sampleGroupId].m_ratesTable[sampleRateId].supported)
+      if (station->m_groupsTable[sampleGroupId].m_supported && station->m_groupsTable[sampleGroupId].m_ratesTable.supported[sampleRateId])
         {
           /**
            * Sampling might add some overhead to the frame.
@@ -1098,13 +1139,13 @@ MinstrelHtWifiManager::FindRate (MinstrelHtWifiRemoteStation *station)
            * Also do not sample if the probability is already higher than 95%
            * to avoid wasting airtime.
            */
-          HtRateInfo sampleRateInfo = station->m_groupsTable[sampleGroupId].m_ratesTable[sampleRateId];
+          const HtRatesTable &sampleRates = station->m_groupsTable[sampleGroupId].m_ratesTable;
 
           NS_LOG_DEBUG ("Use sample rate? MaxTpRate= " << station->m_maxTpRate << " CurrentRate= " << station->m_txrate <<
-                        " SampleRate= " << sampleIdx << " SampleProb= " << sampleRateInfo.ewmaProb);
+                        " SampleRate= " << sampleIdx << " SampleProb= " << sampleRates.ewmaProb[sampleRateId]);
 
           if (sampleIdx != station->m_maxTpRate && sampleIdx != station->m_maxTpRate2
-              && sampleIdx != station->m_maxProbRate && sampleRateInfo.ewmaProb <= 95)
+              && sampleIdx != station->m_maxProbRate && sampleRates.ewmaProb[sampleRateId] <= 95)
             {
 
               /**
@@ -1121,9 +1162,9 @@ MinstrelHtWifiManager::FindRate (MinstrelHtWifiRemoteStation *station)
               uint8_t maxTpStreams = m_minstrelGroups[maxTpGroupId].streams;
               uint8_t sampleStreams = m_minstrelGroups[sampleGroupId].streams;
 
-              Time sampleDuration = sampleRateInfo.perfectTxTime;
-              Time maxTp2Duration = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].perfectTxTime;
-              Time maxProbDuration = station->m_groupsTable[maxProbGroupId].m_ratesTable[maxProbRateId].perfectTxTime;
+              Time sampleDuration = sampleRates.perfectTxTime[sampleRateId];
+              Time maxTp2Duration = station->m_groupsTable[maxTp2GroupId].m_ratesTable.perfectTxTime[maxTp2RateId];
+              Time maxProbDuration = station->m_groupsTable[maxProbGroupId].m_ratesTable.perfectTxTime[maxProbRateId];
 
               NS_LOG_DEBUG ("Use sample rate? SampleDuration= " << sampleDuration << " maxTp2Duration= " << maxTp2Duration <<
                             " maxProbDuration= " << maxProbDuration << " sampleStreams= " << +sampleStreams <<
@@ -1143,7 +1184,7 @@ MinstrelHtWifiManager::FindRate (MinstrelHtWifiRemoteStation *station)
               else
                 {
                   station->m_numSamplesSlow++;
-                  if (sampleRateInfo.numSamplesSkipped >= 20 && station->m_numSamplesSlow <= 2)
+                  if (sampleRates.numSamplesSkipped[sampleRateId] >= 20 && station->m_numSamplesSlow <= 2)
                     {
                       /// Set flag that we are currently sampling.
                       station->m_isSampling = true;
@@ -1179,8 +1220,6 @@ MinstrelHtWifiManager::UpdateStats (MinstrelHtWifiRemoteStation *station)
   station->m_numSamplesSlow = 0;
   station->m_sampleCount = 0;
 
-  double tempProb;
-
   if (station->m_ampduPacketCount > 0)
     {
       uint32_t newLen = station->m_ampduLen / station->m_ampduPacketCount;
@@ -1206,65 +1245,19 @@ MinstrelHtWifiManager::UpdateStats (MinstrelHtWifiRemoteStation *station)
           station->m_groupsTable[j].m_maxTpRate2 = GetLowestIndex (station, j);
           station->m_groupsTable[j].m_maxProbRate = GetLowestIndex (station, j);
 
+          UpdateGroupStats (station, j);
+
+          /**
+           * The best rates are only compared with rates of this group or
+           * of the previous ones, whose statistics are already updated.
+           */
+          const HtRatesTable &rates = station->m_groupsTable[j].m_ratesTable;
           for (uint8_t i = 0; i < m_numRates; i++)
             {
-              if (station->m_groupsTable[j].m_ratesTable[i].supported)
+              if (rates.supported[i] && rates.throughput[i] != 0)
                 {
-                  station->m_groupsTable[j].m_ratesTable[i].retryUpdated = false;
-
-                  NS_LOG_DEBUG (+i << " " << GetMcsSupported (station, station->m_groupsTable[j].m_ratesTable[i].mcsIndex) <<
-                                "\t attempt=" << station->m_groupsTable[j].m_ratesTable[i].numRateAttempt <<
-                                "\t success=" << station->m_groupsTable[j].m_ratesTable[i].numRateSuccess);
-
-                  /// If we've attempted something.
-                  if (station->m_groupsTable[j].m_ratesTable[i].numRateAttempt > 0)
-                    {
-                      station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped = 0;
-                      /**
-                       * Calculate the probability of success.
-                       * Assume probability scales from 0 to 100.
-                       */
-                      tempProb = (100 * station->m_groupsTable[j].m_ratesTable[i].numRateSuccess) / station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-
-                      /// Bookkeeping.
-                      station->m_groupsTable[j].m_ratesTable[i].prob = tempProb;
-
-                      if (station->m_groupsTable[j].m_ratesTable[i].successHist == 0)
-                        {
-                          station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
-                      else
-                        {
-                          station->m_groupsTable[j].m_ratesTable[i].ewmsdProb = CalculateEwmsd (station->m_groupsTable[j].m_ratesTable[i].ewmsdProb,
-                                                                                                tempProb, station->m_groupsTable[j].m_ratesTable[i].ewmaProb,
-                                                                                                m_ewmaLevel);
-                          /// EWMA probability
-                          tempProb = (tempProb * (100 - m_ewmaLevel) + station->m_groupsTable[j].m_ratesTable[i].ewmaProb * m_ewmaLevel)  / 100;
-                          station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
-
-                      station->m_groupsTable[j].m_ratesTable[i].throughput = CalculateThroughput (station, j, i, tempProb);
-
-                      station->m_groupsTable[j].m_ratesTable[i].successHist += station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                      station->m_groupsTable[j].m_ratesTable[i].attemptHist += station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    }
-                  else
-                    {
-                      station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped++;
-                    }
-
-                  /// Bookkeeping.
-                  station->m_groupsTable[j].m_ratesTable[i].prevNumRateSuccess = station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                  station->m_groupsTable[j].m_ratesTable[i].prevNumRateAttempt = station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                  station->m_groupsTable[j].m_ratesTable[i].numRateSuccess = 0;
-                  station->m_groupsTable[j].m_ratesTable[i].numRateAttempt = 0;
-
-                  if (station->m_groupsTable[j].m_ratesTable[i].throughput != 0)
-                    {
-                      SetBestStationThRates (station, GetIndex (j, i));
-                      SetBestProbabilityRate (station, GetIndex (j, i));
-                    }
-
+                  SetBestStationThRates (station, GetIndex (j, i));
+                  SetBestProbabilityRate (station, GetIndex (j, i));
                 }
             }
         }
@@ -1285,6 +1278,68 @@ MinstrelHtWifiManager::UpdateStats (MinstrelHtWifiRemoteStation *station)
     }
 }
 
+void
+MinstrelHtWifiManager::UpdateGroupStats (MinstrelHtWifiRemoteStation *station, uint8_t groupId)
+{
+  NS_LOG_FUNCTION (this << station << +groupId);
+  HtRatesTable &rates = station->m_groupsTable[groupId].m_ratesTable;
+
+  for (uint8_t i = 0; i < m_numRates; i++)
+    {
+      if (!rates.supported[i])
+        {
+          continue;
+        }
+      rates.retryUpdated[i] = false;
+
+      NS_LOG_DEBUG (+i << " " << GetMcsSupported (station, rates.mcsIndex[i]) <<
+                    "\t attempt=" << rates.numRateAttempt[i] <<
+                    "\t success=" << rates.numRateSuccess[i]);
+
+      /// If we've attempted something.
+      if (rates.numRateAttempt[i] > 0)
+        {
+          rates.numSamplesSkipped[i] = 0;
+          /**
+           * Calculate the probability of success.
+           * Assume probability scales from 0 to 100.
+           */
+          double tempProb = (100 * rates.numRateSuccess[i]) / rates.numRateAttempt[i];
+
+          /// Bookkeeping.
+          rates.prob[i] = tempProb;
+
+          if (rates.successHist[i] == 0)
+            {
+              rates.ewmaProb[i] = tempProb;
+            }
+          else
+            {
+              rates.ewmsdProb[i] = CalculateEwmsd (rates.ewmsdProb[i], tempProb, rates.ewmaProb[i], m_ewmaLevel);
+              /// EWMA probability
+              tempProb = (tempProb * (100 - m_ewmaLevel) + rates.ewmaProb[i] * m_ewmaLevel)  / 100;
+              rates.ewmaProb[i] = tempProb;
+            }
+
+          /// The throughput only changes with the EWMA, hence it is only evaluated here.
+          rates.throughput[i] = CalculateThroughput (station, groupId, i, tempProb);
+
+          rates.successHist[i] += rates.numRateSuccess[i];
+          rates.attemptHist[i] += rates.numRateAttempt[i];
+        }
+      else
+        {
+          rates.numSamplesSkipped[i]++;
+        }
+    }
+
+  /// Bookkeeping.
+  rates.prevNumRateSuccess = rates.numRateSuccess;
+  rates.prevNumRateAttempt = rates.numRateAttempt;
+  std::fill (rates.numRateSuccess.begin (), rates.numRateSuccess.end (), 0);
+  std::fill (rates.numRateAttempt.begin (), rates.numRateAttempt.end (), 0);
+}
+
 double
 MinstrelHtWifiManager::CalculateThroughput (MinstrelHtWifiRemoteStation *station, uint8_t groupId, uint8_t rateId, double ewmaProb)
 {
@@ -1303,14 +1358,14 @@ MinstrelHtWifiManager::CalculateThroughput (MinstrelHtWifiRemoteStation *station
        * For the throughput calculation, limit the probability value to 90% to
        * account for collision related packet error rate fluctuation.
        */
-      Time txTime =  station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTime;
+      double txTime = station->m_groupsTable[groupId].m_ratesTable.perfectTxTimeSeconds[rateId];
       if (ewmaProb > 90)
         {
-          return 90 / txTime.GetSeconds ();
+          return 90 / txTime;
         }
       else
         {
-          return ewmaProb / txTime.GetSeconds ();
+          return ewmaProb / txTime;
         }
     }
 }
@@ -1319,7 +1374,6 @@ void
 MinstrelHtWifiManager::SetBestProbabilityRate (MinstrelHtWifiRemoteStation *station, uint16_t index)
 {
   GroupInfo *group;
-  HtRateInfo rate;
   uint8_t tmpGroupId, tmpRateId;
   double tmpTh, tmpProb;
   uint8_t groupId, rateId;
@@ -1331,16 +1385,16 @@ MinstrelHtWifiManager::SetBestProbabilityRate (MinstrelHtWifiRemoteStation *stat
   groupId = GetGroupId (index);
   rateId = GetRateId (index);
   group = &station->m_groupsTable[groupId];
-  rate = group->m_ratesTable[rateId];
+  double rateProb = group->m_ratesTable.ewmaProb[rateId];
 
   tmpGroupId = GetGroupId (station->m_maxProbRate);
   tmpRateId = GetRateId (station->m_maxProbRate);
-  tmpProb = station->m_groupsTable[tmpGroupId].m_ratesTable[tmpRateId].ewmaProb;
-  tmpTh =  station->m_groupsTable[tmpGroupId].m_ratesTable[tmpRateId].throughput;
+  tmpProb = station->m_groupsTable[tmpGroupId].m_ratesTable.ewmaProb[tmpRateId];
+  tmpTh =  station->m_groupsTable[tmpGroupId].m_ratesTable.throughput[tmpRateId];
 
-  if (rate.ewmaProb > 75)
+  if (rateProb > 75)
     {
-      currentTh = station->m_groupsTable[groupId].m_ratesTable[rateId].throughput;
+      currentTh = station->m_groupsTable[groupId].m_ratesTable.throughput[rateId];
       if (currentTh > tmpTh)
         {
           station->m_maxProbRate = index;
@@ -1348,7 +1402,7 @@ MinstrelHtWifiManager::SetBestProbabilityRate (MinstrelHtWifiRemoteStation *stat
 
       maxGPGroupId = GetGroupId (group->m_maxProbRate);
       maxGPRateId = GetRateId (group->m_maxProbRate);
-      maxGPTh = station->m_groupsTable[maxGPGroupId].m_ratesTable[maxGPRateId].throughput;
+      maxGPTh = station->m_groupsTable[maxGPGroupId].m_ratesTable.throughput[maxGPRateId];
 
       if (currentTh > maxGPTh)
         {
@@ -1357,12 +1411,12 @@ MinstrelHtWifiManager::SetBestProbabilityRate (MinstrelHtWifiRemoteStation *stat
     }
   else
     {
-      if (rate.ewmaProb > tmpProb)
+      if (rateProb > tmpProb)
         {
           station->m_maxProbRate = index;
         }
       maxGPRateId = GetRateId (group->m_maxProbRate);
-      if (rate.ewmaProb > group->m_ratesTable[maxGPRateId].ewmaProb)
+      if (rateProb > group->m_ratesTable.ewmaProb[maxGPRateId])
         {
           group->m_maxProbRate = index;
         }
@@ -1388,18 +1442,18 @@ MinstrelHtWifiManager::SetBestStationThRates (MinstrelHtWifiRemoteStation *stati
 
   groupId = GetGroupId (index);
   rateId = GetRateId (index);
-  prob = station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb;
-  th = station->m_groupsTable[groupId].m_ratesTable[rateId].throughput;
+  prob = station->m_groupsTable[groupId].m_ratesTable.ewmaProb[rateId];
+  th = station->m_groupsTable[groupId].m_ratesTable.throughput[rateId];
 
   maxTpGroupId = GetGroupId (station->m_maxTpRate);
   maxTpRateId = GetRateId (station->m_maxTpRate);
-  maxTpProb = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].ewmaProb;
-  maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].throughput;
+  maxTpProb = station->m_groupsTable[maxTpGroupId].m_ratesTable.ewmaProb[maxTpRateId];
+  maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable.throughput[maxTpRateId];
 
   maxTp2GroupId = GetGroupId (station->m_maxTpRate2);
   maxTp2RateId = GetRateId (station->m_maxTpRate2);
-  maxTp2Prob = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].ewmaProb;
-  maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].throughput;
+  maxTp2Prob = station->m_groupsTable[maxTp2GroupId].m_ratesTable.ewmaProb[maxTp2RateId];
+  maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable.throughput[maxTp2RateId];
 
   if (th > maxTpTh || (th == maxTpTh && prob > maxTpProb))
     {
@@ -1416,13 +1470,13 @@ MinstrelHtWifiManager::SetBestStationThRates (MinstrelHtWifiRemoteStation *stati
   GroupInfo *group = &station->m_groupsTable[groupId];
   maxTpGroupId = GetGroupId (group->m_maxTpRate);
   maxTpRateId = GetRateId (group->m_maxTpRate);
-  maxTpProb = group->m_ratesTable[maxTpRateId].ewmaProb;
-  maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].throughput;
+  maxTpProb = group->m_ratesTable.ewmaProb[maxTpRateId];
+  maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable.throughput[maxTpRateId];
 
   maxTp2GroupId = GetGroupId (group->m_maxTpRate2);
   maxTp2RateId = GetRateId (group->m_maxTpRate2);
-  maxTp2Prob = group->m_ratesTable[maxTp2RateId].ewmaProb;
-  maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].throughput;
+  maxTp2Prob = group->m_ratesTable.ewmaProb[maxTp2RateId];
+  maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable.throughput[maxTp2RateId];
 
   if (th > maxTpTh || (th == maxTpTh && prob > maxTpProb))
     {
@@ -1464,11 +1518,7 @@ MinstrelHtWifiManager::RateInit (MinstrelHtWifiRemoteStation *station)
               station->m_groupsTable[groupId].m_col = 0;
               station->m_groupsTable[groupId].m_index = 0;
 
-              station->m_groupsTable[groupId].m_ratesTable = HtMinstrelRate (m_numRates);        ///Create the rate list for the group.
-              for (uint8_t i = 0; i < m_numRates; i++)
-                {
-                  station->m_groupsTable[groupId].m_ratesTable[i].supported = false;
-                }
+              station->m_groupsTable[groupId].m_ratesTable = HtRatesTable (m_numRates);          ///Create the rate list for the group.
 
               // Initialize all modes supported by the remote station that belong to the current group.
               for (uint8_t i = 0; i < station->m_nModes; i++)
@@ -1491,21 +1541,22 @@ MinstrelHtWifiManager::RateInit (MinstrelHtWifiRemoteStation *station)
                     {
                       NS_LOG_DEBUG ("Mode " << +i << ": " << mode << " isVht: " << m_minstrelGroups[groupId].isVht);
 
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].supported = true;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex = i;         ///Mapping between rateId and operationalMcsSet
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].prob = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateAttempt = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateSuccess = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].numSamplesSkipped = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].successHist = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].attemptHist = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].throughput = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTime = GetFirstMpduTxTime (groupId, GetMcsSupported (station, i));
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 0;
-                      station->m_groupsTable[groupId].m_ratesTable[rateId].adjustedRetryCount = 0;
+                      station->m_groupsTable[groupId].m_ratesTable.supported[rateId] = true;
+                      station->m_groupsTable[groupId].m_ratesTable.mcsIndex[rateId] = i;         ///Mapping between rateId and operationalMcsSet
+                      station->m_groupsTable[groupId].m_ratesTable.numRateAttempt[rateId] = 0;
+                      station->m_groupsTable[groupId].m_ratesTable.numRateSuccess[rateId] = 0;
+                      station->m_groupsTable[groupId].m_ratesTable.prob[rateId] = 0;
+                      station->m_groupsTable[groupId].m_ratesTable.ewmaProb[rateId] = 0;
+                      station->m_groupsTable[groupId].m_ratesTable.prevNumRateAttempt[rateId] = 0;
+                      station->m_groupsTable[groupId].m_ratesTable.prevNumRateSuccess[rateId] = 0;
+                      station->m_groupsTable[groupId].m_ratesTable.numSamplesSkipped[rateId] = 0;
+                      station->m_groupsTable[groupId].m_ratesTable.successHist[rateId] = 0;
+                      station->m_groupsTable[groupId].m_ratesTable.attemptHist[rateId] = 0;
+                      station->m_groupsTable[groupId].m_ratesTable.throughput[rateId] = 0;
+                      station->m_groupsTable[groupId].m_ratesTable.perfectTxTime[rateId] = GetFirstMpduTxTime (groupId, GetMcsSupported (station, i));
+                      station->m_groupsTable[groupId].m_ratesTable.perfectTxTimeSeconds[rateId] = station->m_groupsTable[groupId].m_ratesTable.perfectTxTime[rateId].GetSeconds ();
+                      station->m_groupsTable[groupId].m_ratesTable.retryCount[rateId] = 0;
+                      station->m_groupsTable[groupId].m_ratesTable.adjustedRetryCount[rateId] = 0;
                       CalculateRetransmits (station, groupId, rateId);
                     }
                 }
@@ -1523,7 +1574,7 @@ MinstrelHtWifiManager::CalculateRetransmits (MinstrelHtWifiRemoteStation *statio
   NS_LOG_FUNCTION (this << station << index);
   uint8_t groupId = GetGroupId (index);
   uint8_t rateId = GetRateId (index);
-  if (!station->m_groupsTable[groupId].m_ratesTable[rateId].retryUpdated)
+  if (!station->m_groupsTable[groupId].m_ratesTable.retryUpdated[rateId])
     {
       CalculateRetransmits (station, groupId, rateId);
     }
@@ -1540,17 +1591,17 @@ MinstrelHtWifiManager::CalculateRetransmits (MinstrelHtWifiRemoteStation *statio
   Time slotTime = GetMac ()->GetSlot ();
   Time ackTime = GetMac ()->GetBasicBlockAckTimeout ();
 
-  if (station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb < 1)
+  if (station->m_groupsTable[groupId].m_ratesTable.ewmaProb[rateId] < 1)
     {
-      station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 1;
+      station->m_groupsTable[groupId].m_ratesTable.retryCount[rateId] = 1;
     }
   else
     {
-      station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 2;
-      station->m_groupsTable[groupId].m_ratesTable[rateId].retryUpdated = true;
+      station->m_groupsTable[groupId].m_ratesTable.retryCount[rateId] = 2;
+      station->m_groupsTable[groupId].m_ratesTable.retryUpdated[rateId] = true;
 
-      dataTxTime = GetFirstMpduTxTime (groupId, GetMcsSupported (station, station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex)) +
-        GetMpduTxTime (groupId, GetMcsSupported (station, station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex)) * (station->m_avgAmpduLen - 1);
+      dataTxTime = GetFirstMpduTxTime (groupId, GetMcsSupported (station, station->m_groupsTable[groupId].m_ratesTable.mcsIndex[rateId])) +
+        GetMpduTxTime (groupId, GetMcsSupported (station, station->m_groupsTable[groupId].m_ratesTable.mcsIndex[rateId])) * (station->m_avgAmpduLen - 1);
 
       /* Contention time for first 2 tries */
       cwTime = (cw / 2) * slotTime;
@@ -1572,7 +1623,7 @@ MinstrelHtWifiManager::CalculateRetransmits (MinstrelHtWifiRemoteStation *statio
           txTime += cwTime + ackTime + dataTxTime;
         }
       while ((txTime < MilliSeconds (6))
-             && (++station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount < 7));
+             && (++station->m_groupsTable[groupId].m_ratesTable.retryCount[rateId] < 7));
     }
 }
 
@@ -1596,6 +1647,12 @@ MinstrelHtWifiManager::InitSampleTable (MinstrelHtWifiRemoteStation *station)
 {
   NS_LOG_FUNCTION (this << station);
   station->m_col = station->m_index = 0;
+  station->m_sampleTable = &m_sampleTable;
+  if (!m_sampleTable.empty ())
+    {
+      return;
+    }
+  m_sampleTable = SampleRate (m_numRates, std::vector<uint8_t> (m_nSampleCol));
 
   //for off-setting to make rates fall between 0 and nModes
   uint8_t numSampleRates = m_numRates;
@@ -1613,11 +1670,11 @@ MinstrelHtWifiManager::InitSampleTable (MinstrelHtWifiRemoteStation *station)
           newIndex = (i + uv) % numSampleRates;
 
           //this loop is used for filling in other uninitialized places
-          while (station->m_sampleTable[newIndex][col] != 0)
+          while (m_sampleTable[newIndex][col] != 0)
             {
               newIndex = (newIndex + 1) % m_numRates;
             }
-          station->m_sampleTable[newIndex][col] = i;
+          m_sampleTable[newIndex][col] = i;
         }
     }
 }
@@ -1656,7 +1713,7 @@ MinstrelHtWifiManager::StatsDump (MinstrelHtWifiRemoteStation *station, uint8_t
     }
   for (uint8_t i = 0; i < numRates; i++)
     {
-      if (station->m_groupsTable[groupId].m_supported && station->m_groupsTable[groupId].m_ratesTable[i].supported)
+      if (station->m_groupsTable[groupId].m_supported && station->m_groupsTable[groupId].m_ratesTable.supported[i])
         {
           if (!group.isVht)
             {
@@ -1709,19 +1766,19 @@ MinstrelHtWifiManager::StatsDump (MinstrelHtWifiRemoteStation *station, uint8_t
           of << "  " << std::setw (3) << +idx << "  ";
 
           /* tx_time[rate(i)] in usec */
-          txTime = GetFirstMpduTxTime (groupId, GetMcsSupported (station, station->m_groupsTable[groupId].m_ratesTable[i].mcsIndex));
+          txTime = GetFirstMpduTxTime (groupId, GetMcsSupported (station, station->m_groupsTable[groupId].m_ratesTable.mcsIndex[i]));
           of << std::setw (6) << txTime.GetMicroSeconds () << "  ";
 
           of << std::setw (7) << CalculateThroughput (station, groupId, i, 100) / 100 << "   " <<
-            std::setw (7) << station->m_groupsTable[groupId].m_ratesTable[i].throughput / 100 << "   " <<
-            std::setw (7) << station->m_groupsTable[groupId].m_ratesTable[i].ewmaProb << "  " <<
-            std::setw (7) << station->m_groupsTable[groupId].m_ratesTable[i].ewmsdProb << "  " <<
-            std::setw (7) << station->m_groupsTable[groupId].m_ratesTable[i].prob << "  " <<
-            std::setw (2) << station->m_groupsTable[groupId].m_ratesTable[i].retryCount << "   " <<
-            std::setw (3) << station->m_groupsTable[groupId].m_ratesTable[i].prevNumRateSuccess << "  " <<
-            std::setw (3) << station->m_groupsTable[groupId].m_ratesTable[i].prevNumRateAttempt << "   " <<
-            std::setw (9) << station->m_groupsTable[groupId].m_ratesTable[i].successHist << "   " <<
-            std::setw (9) << station->m_groupsTable[groupId].m_ratesTable[i].attemptHist << "\n";
+            std::setw (7) << station->m_groupsTable[groupId].m_ratesTable.throughput[i] / 100 << "   " <<
+            std::setw (7) << station->m_groupsTable[groupId].m_ratesTable.ewmaProb[i] << "  " <<
+            std::setw (7) << station->m_groupsTable[groupId].m_ratesTable.ewmsdProb[i] << "  " <<
+            std::setw (7) << station->m_groupsTable[groupId].m_ratesTable.prob[i] << "  " <<
+            std::setw (2) << station->m_groupsTable[groupId].m_ratesTable.retryCount[i] << "   " <<
+            std::setw (3) << station->m_groupsTable[groupId].m_ratesTable.prevNumRateSuccess[i] << "  " <<
+            std::setw (3) << station->m_groupsTable[groupId].m_ratesTable.prevNumRateAttempt[i] << "   " <<
+            std::setw (9) << station->m_groupsTable[groupId].m_ratesTable.successHist[i] << "   " <<
+            std::setw (9) << station->m_groupsTable[groupId].m_ratesTable.attemptHist[i] << "\n";
         }
     }
 }
@@ -1775,11 +1832,11 @@ MinstrelHtWifiManager::GetLowestIndex (MinstrelHtWifiRemoteStation *station)
     {
       groupId++;
     }
-  while (rateId < m_numRates && !station->m_groupsTable[groupId].m_ratesTable[rateId].supported)
+  while (rateId < m_numRates && !station->m_groupsTable[groupId].m_ratesTable.supported[rateId])
     {
       rateId++;
     }
-  NS_ASSERT (station->m_groupsTable[groupId].m_supported && station->m_groupsTable[groupId].m_ratesTable[rateId].supported);
+  NS_ASSERT (station->m_groupsTable[groupId].m_supported && station->m_groupsTable[groupId].m_ratesTable.supported[rateId]);
   return GetIndex (groupId, rateId);
 }
 
@@ -1789,11 +1846,11 @@ MinstrelHtWifiManager::GetLowestIndex (MinstrelHtWifiRemoteStation *station, uin
   NS_LOG_FUNCTION (this << station << +groupId);
 
   uint8_t rateId = 0;
-  while (rateId < m_numRates && !station->m_groupsTable[groupId].m_ratesTable[rateId].supported)
+  while (rateId < m_numRates && !station->m_groupsTable[groupId].m_ratesTable.supported[rateId])
     {
       rateId++;
     }
-  NS_ASSERT (station->m_groupsTable[groupId].m_supported && station->m_groupsTable[groupId].m_ratesTable[rateId].supported);
+  NS_ASSERT (station->m_groupsTable[groupId].m_supported && station->m_groupsTable[groupId].m_ratesTable.supported[rateId]);
   return GetIndex (groupId, rateId);
 }
 
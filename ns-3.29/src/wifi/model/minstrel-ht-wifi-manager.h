@@ -63,44 +63,50 @@ typedef std::vector<McsGroup> MinstrelMcsGroups;
 
 struct MinstrelHtWifiRemoteStation;
 /**
- * A struct to contain all statistics information related to a data rate.
+ * A struct to contain all statistics information related to the data rates
+ * of a group. Each statistic is stored in its own array, indexed by the rate
+ * ID, so that the periodic update of the statistics of a group runs over
+ * contiguous values.
  */
-struct HtRateInfo
+struct HtRatesTable
 {
+  HtRatesTable ();
+  /**
+   * Create a table of rates, none of which is supported.
+   *
+   * \param numRates the number of rates of the group
+   */
+  HtRatesTable (uint8_t numRates);
+
   /**
    * Perfect transmission time calculation, or frame calculation.
    * Given a bit rate and a packet length n bytes.
    */
-  Time perfectTxTime;
-  bool supported;               //!< If the rate is supported.
-  uint8_t mcsIndex;             //!< The index in the operationalMcsSet of the WifiRemoteStationManager.
-  uint32_t retryCount;          //!< Retry limit.
-  uint32_t adjustedRetryCount;  //!< Adjust the retry limit for this rate.
-  uint32_t numRateAttempt;      //!< Number of transmission attempts so far.
-  uint32_t numRateSuccess;      //!< Number of successful frames transmitted so far.
-  double prob;                  //!< Current probability within last time interval. (# frame success )/(# total frames)
-  bool retryUpdated;            //!< If number of retries was updated already.
+  std::vector<Time> perfectTxTime;
+  std::vector<double> perfectTxTimeSeconds;     //!< The perfect transmission time, in seconds.
+  std::vector<bool> supported;                  //!< If the rate is supported.
+  std::vector<uint8_t> mcsIndex;                //!< The index in the operationalMcsSet of the WifiRemoteStationManager.
+  std::vector<uint32_t> retryCount;             //!< Retry limit.
+  std::vector<uint32_t> adjustedRetryCount;     //!< Adjust the retry limit for this rate.
+  std::vector<uint32_t> numRateAttempt;         //!< Number of transmission attempts so far.
+  std::vector<uint32_t> numRateSuccess;         //!< Number of successful frames transmitted so far.
+  std::vector<double> prob;                     //!< Current probability within last time interval. (# frame success )/(# total frames)
+  std::vector<bool> retryUpdated;               //!< If number of retries was updated already.
   /**
    * Exponential weighted moving average of probability.
    * EWMA calculation:
    * ewma_prob =[prob *(100 - ewma_level) + (ewma_prob_old * ewma_level)]/100
    */
-  double ewmaProb;
-  double ewmsdProb;             //!< Exponential weighted moving standard deviation of probability.
-  uint32_t prevNumRateAttempt;  //!< Number of transmission attempts with previous rate.
-  uint32_t prevNumRateSuccess;  //!< Number of successful frames transmitted with previous rate.
-  uint32_t numSamplesSkipped;   //!< Number of times this rate statistics were not updated because no attempts have been made.
-  uint64_t successHist;         //!< Aggregate of all transmission successes.
-  uint64_t attemptHist;         //!< Aggregate of all transmission attempts.
-  double throughput;            //!< Throughput of this rate (in pkts per second).
+  std::vector<double> ewmaProb;
+  std::vector<double> ewmsdProb;                //!< Exponential weighted moving standard deviation of probability.
+  std::vector<uint32_t> prevNumRateAttempt;     //!< Number of transmission attempts with previous rate.
+  std::vector<uint32_t> prevNumRateSuccess;     //!< Number of successful frames transmitted with previous rate.
+  std::vector<uint32_t> numSamplesSkipped;      //!< Number of times this rate statistics were not updated because no attempts have been made.
+  std::vector<uint64_t> successHist;            //!< Aggregate of all transmission successes.
+  std::vector<uint64_t> attemptHist;            //!< Aggregate of all transmission attempts.
+  std::vector<double> throughput;               //!< Throughput of this rate (in pkts per second).
 };
 
-/**
- * Data structure for a Minstrel Rate table.
- * A vector of a struct HtRateInfo.
- */
-typedef std::vector<HtRateInfo> HtMinstrelRate;
-
 /**
  * A struct to contain information of a group.
  */
@@ -115,7 +121,7 @@ struct GroupInfo
   uint16_t m_maxTpRate;           //!< The max throughput rate of this group.
   uint16_t m_maxTpRate2;          //!< The second max throughput rate of this group.
   uint16_t m_maxProbRate;         //!< The highest success probability rate of this group.
-  HtMinstrelRate m_ratesTable;    //!< Information about rates of this group.
+  HtRatesTable m_ratesTable;      //!< Information about rates of this group.
 };
 
 /**
@@ -371,6 +377,16 @@ private:
    */
   double CalculateThroughput (MinstrelHtWifiRemoteStation *station, uint8_t groupId, uint8_t rateId, double ewmaProb);
 
+  /**
+   * Update the EWMA of the success probability and the throughput of the
+   * rates of a group which were attempted during the last interval, and
+   * reset the counters of the interval.
+   *
+   * \param station the minstrel HT wifi remote station
+   * \param groupId the group ID
+   */
+  void UpdateGroupStats (MinstrelHtWifiRemoteStation *station, uint8_t groupId);
+
   /**
    * Set index rate as maxTpRate or maxTp2Rate if is better than current values.
    *
@@ -439,7 +455,8 @@ private:
   double CalculateEwmsd (double oldEwmsd, double currentProb, double ewmaProb, double weight);
 
   /**
-   * Initialize Sample Table.
+   * Initialize Sample Table. The sample table is shared by all the HT
+   * stations, hence it is only filled when the first station is initialized.
    *
    * \param station the minstrel HT wifi remote station
    */
@@ -584,8 +601,10 @@ private:
   uint8_t m_numRates;        //!< Number of rates per group Minstrel should consider.
   bool m_useVhtOnly;         //!< If only VHT MCS should be used, instead of HT and VHT.
   bool m_printStats;         //!< If statistics table should be printed.
+  bool m_staggerStatsUpdates; //!< If the first statistics update of the stations is spread over an interval.
 
   MinstrelMcsGroups m_minstrelGroups;                 //!< Global array for groups information.
+  SampleRate m_sampleTable;                           //!< Sample table shared by the HT stations.
 
   Ptr<MinstrelWifiManager> m_legacyManager;           //!< Pointer to an instance of MinstrelWifiManager. Used when 802.11n/ac not supported.
 
@@ -83,6 +83,13 @@ MinstrelWifiManager::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&MinstrelWifiManager::m_printStats),
                    MakeBooleanChecker ())
+    .AddAttribute ("StaggerStatsUpdates",
+                   "If true, the first statistics update of each station happens at a random "
+                   "time within the update interval, so that the stations initialized together "
+                   "do not update their statistics at the same time",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MinstrelWifiManager::m_staggerStatsUpdates),
+                   MakeBooleanChecker ())
     .AddAttribute ("PrintSamples",
                    "Print samples table",
                    BooleanValue (false),
@@ -179,6 +186,7 @@ MinstrelWifiManager::DoCreateStation (void) const
   station->m_retry = 0;
   station->m_txrate = 0;
   station->m_initialized = false;
+  station->m_sampleTable = 0;
 
   return station;
 }
@@ -194,9 +202,14 @@ MinstrelWifiManager::CheckInit (MinstrelWifiRemoteStation *station)
       //before we perform our own initialization.
       station->m_nModes = GetNSupported (station);
       station->m_minstrelTable = MinstrelRate (station->m_nModes);
-      station->m_sampleTable = SampleRate (station->m_nModes, std::vector<uint8_t> (m_sampleCol));
       InitSampleTable (station);
       RateInit (station);
+      if (m_staggerStatsUpdates)
+        {
+          //Spread the first update over an interval, so that the stations
+          //initialized together do not update their statistics together.
+          station->m_nextStatsUpdate = Simulator::Now () + Seconds (m_updateStats.GetSeconds () * m_uniformRandomVariable->GetValue (0, 1));
+        }
       station->m_initialized = true;
       std::ostringstream tmp;
       tmp << "minstrel-stats-" << station->m_state->m_address << ".txt";
@@ -888,7 +901,7 @@ MinstrelWifiManager::GetNextSample (MinstrelWifiRemoteStation *station)
 {
   NS_LOG_FUNCTION (this << station);
   uint16_t bitrate;
-  bitrate = station->m_sampleTable[station->m_index][station->m_col];
+  bitrate = (*station->m_sampleTable)[station->m_index][station->m_col];
   station->m_index++;
 
   //bookkeeping for m_index and m_col variables
@@ -983,6 +996,16 @@ MinstrelWifiManager::InitSampleTable (MinstrelWifiRemoteStation *station)
   //for off-setting to make rates fall between 0 and nModes
   uint8_t numSampleRates = station->m_nModes;
 
+  std::map<uint8_t, SampleRate>::iterator it = m_sampleTables.find (numSampleRates);
+  if (it != m_sampleTables.end ())
+    {
+      station->m_sampleTable = &it->second;
+      return;
+    }
+  SampleRate &sampleTable = m_sampleTables[numSampleRates];
+  sampleTable = SampleRate (numSampleRates, std::vector<uint8_t> (m_sampleCol));
+  station->m_sampleTable = &sampleTable;
+
   uint16_t newIndex;
   for (uint8_t col = 0; col < m_sampleCol; col++)
     {
@@ -997,11 +1020,11 @@ MinstrelWifiManager::InitSampleTable (MinstrelWifiRemoteStation *station)
           newIndex = (i + uv) % numSampleRates;
 
           //this loop is used for filling in other uninitialized places
-          while (station->m_sampleTable[newIndex][col] != 0)
+          while (sampleTable[newIndex][col] != 0)
             {
               newIndex = (newIndex + 1) % station->m_nModes;
             }
-          station->m_sampleTable[newIndex][col] = i;
+          sampleTable[newIndex][col] = i;
         }
     }
 }
@@ -1015,7 +1038,7 @@ MinstrelWifiManager::PrintSampleTable (MinstrelWifiRemoteStation *station)
     {
       for (uint8_t j = 0; j < m_sampleCol; j++)
         {
-          table << station->m_sampleTable[i][j] << "\t";
+          table << (*station->m_sampleTable)[i][j] << "\t";
         }
       table << std::endl;
     }
@@ -108,7 +108,7 @@ struct MinstrelWifiRemoteStation : public WifiRemoteStation
   uint16_t m_txrate;             ///< current transmit rate
   bool m_initialized;            ///< for initializing tables
   MinstrelRate m_minstrelTable;  ///< minstrel table
-  SampleRate m_sampleTable;      ///< sample table
+  const SampleRate *m_sampleTable; ///< sample table, shared by the stations with the same number of modes
   std::ofstream m_statsFile;     ///< stats file
 };
 
@@ -251,7 +251,9 @@ public:
   void CheckInit (MinstrelWifiRemoteStation *station);
 
   /**
-   * initialize Sample Table
+   * initialize Sample Table. The sample tables are shared by the stations
+   * supporting the same number of modes, hence a table is only filled when
+   * the first of these stations is initialized.
    *
    * \param station the station object
    */
@@ -360,6 +362,9 @@ private:
   uint32_t m_pktLen;        ///< packet length used for calculate mode TxTime
   bool m_printStats;        ///< whether statistics table should be printed.
   bool m_printSamples;      ///< whether samples table should be printed.
+  bool m_staggerStatsUpdates; ///< whether the first statistics update of the stations is spread over an interval.
+
+  std::map<uint8_t, SampleRate> m_sampleTables; ///< sample tables, indexed by the number of modes
 
   /// Provides uniform random variables.
   Ptr<UniformRandomVariable> m_uniformRandomVariable;
@@ -44,10 +44,11 @@ public:
 
   NistErrorRateModel ();
 
-  double GetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
-
 
 private:
+  // Inherited from ErrorRateModel
+  double DoGetChunkSuccessRate (WifiMode mode, WifiTxVector txVector, double snr, uint64_t nbits) const;
+
   /**
    * Return the coded BER for the given p and b.
    *
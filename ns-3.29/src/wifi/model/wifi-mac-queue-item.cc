@@ -31,7 +31,8 @@ NS_LOG_COMPONENT_DEFINE ("WifiMacQueueItem");
 WifiMacQueueItem::WifiMacQueueItem (Ptr<const Packet> p, const WifiMacHeader & header)
   : m_packet (p),
     m_header (header),
-    m_tstamp (Simulator::Now ())
+    m_tstamp (Simulator::Now ()),
+    m_queueOrder (0)
 {
 }
 
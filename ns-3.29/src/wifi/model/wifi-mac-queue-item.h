@@ -27,6 +27,8 @@
 #include "ns3/nstime.h"
 #include "ns3/queue.h"
 #include "wifi-mac-header.h"
+#include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -82,6 +84,12 @@ public:
   uint32_t GetSize (void) const;
 
 private:
+  /// allow WifiMacQueue class access to the position of the item in its indexes
+  friend class WifiMacQueue;
+
+  /// the position of an item in the list of the items of a queue
+  typedef std::list<Ptr<WifiMacQueueItem> >::const_iterator QueuePosition;
+
   /**
    * \brief Default constructor
    *
@@ -105,6 +113,11 @@ private:
   Ptr<const Packet> m_packet;  //!< The packet contained in this queue item
   WifiMacHeader m_header;      //!< Wifi MAC header associated with the packet
   Time m_tstamp;               //!< timestamp when the packet arrived at the queue
+
+  // position of the item in the indexes of the WifiMacQueue holding it
+  int64_t m_queueOrder;                                              //!< the rank of the item in the queue
+  std::list<QueuePosition>::iterator m_bucketPosition;               //!< the position in the list of its receiver and TID
+  std::multimap<Time, QueuePosition>::iterator m_expiryPosition;     //!< the position in the index of the timestamps
 };
 
 
@@ -52,7 +52,9 @@ WifiMacQueue::GetTypeId (void)
 }
 
 WifiMacQueue::WifiMacQueue ()
-  : NS_LOG_TEMPLATE_DEFINE ("WifiMacQueue")
+  : m_headOrder (0),
+    m_tailOrder (1),
+    NS_LOG_TEMPLATE_DEFINE ("WifiMacQueue")
 {
 }
 
@@ -74,20 +76,140 @@ WifiMacQueue::GetMaxDelay (void) const
   return m_maxDelay;
 }
 
+uint64_t
+WifiMacQueue::GetBucketKey (Mac48Address address, uint8_t tid)
+{
+  uint8_t buffer[6];
+  address.CopyTo (buffer);
+  uint64_t key = 0;
+  for (uint8_t i = 0; i < 6; i++)
+    {
+      key = (key << 8) | buffer[i];
+    }
+  return (key << 8) | tid;
+}
+
+uint64_t
+WifiMacQueue::GetBucketKey (Ptr<const WifiMacQueueItem> item)
+{
+  const WifiMacHeader &hdr = item->GetHeader ();
+  if (hdr.IsQosData ())
+    {
+      return GetBucketKey (item->GetDestinationAddress (), hdr.GetQosTid ());
+    }
+  return GetBucketKey (item->GetDestinationAddress (), hdr.IsData () ? NON_QOS_DATA : NON_DATA);
+}
+
 bool
-WifiMacQueue::TtlExceeded (ConstIterator &it)
+WifiMacQueue::Insert (ConstIterator pos, Ptr<WifiMacQueueItem> item)
+{
+  NS_LOG_FUNCTION (this << item);
+  NS_ASSERT (pos == Head () || pos == Tail ());
+  bool atTail = (pos == Tail ());
+  if (!DoEnqueue (pos, item))
+    {
+      return false;
+    }
+
+  ConstIterator it = atTail ? std::prev (Tail ()) : Head ();
+  Bucket &bucket = m_buckets[GetBucketKey (item)];
+  if (atTail)
+    {
+      item->m_queueOrder = m_tailOrder++;
+      item->m_bucketPosition = bucket.items.insert (bucket.items.end (), it);
+      item->m_expiryPosition = m_expiry.emplace_hint (m_expiry.end (), item->GetTimeStamp (), it);
+    }
+  else
+    {
+      item->m_queueOrder = m_headOrder--;
+      item->m_bucketPosition = bucket.items.insert (bucket.items.begin (), it);
+      item->m_expiryPosition = m_expiry.emplace_hint (m_expiry.begin (), item->GetTimeStamp (), it);
+    }
+  bucket.nBytes += item->GetSize ();
+  return true;
+}
+
+void
+WifiMacQueue::Unindex (ConstIterator pos)
 {
   NS_LOG_FUNCTION (this);
+  Ptr<WifiMacQueueItem> item = *pos;
+  auto bucket = m_buckets.find (GetBucketKey (item));
+  NS_ASSERT (bucket != m_buckets.end ());
+  bucket->second.items.erase (item->m_bucketPosition);
+  bucket->second.nBytes -= item->GetSize ();
+  if (bucket->second.items.empty ())
+    {
+      m_buckets.erase (bucket);
+    }
+  m_expiry.erase (item->m_expiryPosition);
+}
 
-  if (Simulator::Now () > (*it)->GetTimeStamp () + m_maxDelay)
+void
+WifiMacQueue::RemoveExpiredItems (void)
+{
+  NS_LOG_FUNCTION (this);
+  Time now = Simulator::Now ();
+  while (!m_expiry.empty () && now > m_expiry.begin ()->first + m_maxDelay)
     {
+      ConstIterator it = m_expiry.begin ()->second;
       NS_LOG_DEBUG ("Removing packet that stayed in the queue for too long (" <<
-                    Simulator::Now () - (*it)->GetTimeStamp () << ")");
-      auto curr = it++;
-      DoRemove (curr);
-      return true;
+                    now - (*it)->GetTimeStamp () << ")");
+      Unindex (it);
+      DoRemove (it);
     }
-  return false;
+}
+
+WifiMacQueue::ConstIterator
+WifiMacQueue::FindFirst (Mac48Address dest, uint8_t firstTid, uint8_t lastTid) const
+{
+  ConstIterator first = Tail ();
+  for (uint16_t tid = firstTid; tid <= lastTid; tid++)
+    {
+      auto bucket = m_buckets.find (GetBucketKey (dest, static_cast<uint8_t> (tid)));
+      if (bucket != m_buckets.end ())
+        {
+          ConstIterator it = bucket->second.items.front ();
+          if (first == Tail () || (*it)->m_queueOrder < (*first)->m_queueOrder)
+            {
+              first = it;
+            }
+        }
+    }
+  return first;
+}
+
+WifiMacQueue::ConstIterator
+WifiMacQueue::FindFirstAvailable (const Ptr<QosBlockedDestinations> blockedPackets) const
+{
+  ConstIterator first = Head ();
+  if (first == Tail ())
+    {
+      return first;
+    }
+  const WifiMacHeader &hdr = (*first)->GetHeader ();
+  if (!hdr.IsQosData () || !blockedPackets->IsBlocked (hdr.GetAddr1 (), hdr.GetQosTid ()))
+    {
+      return first;
+    }
+
+  // the first item of the queue is blocked: look for the first available
+  // item among the first items of the buckets
+  first = Tail ();
+  for (const auto &bucket : m_buckets)
+    {
+      ConstIterator it = bucket.second.items.front ();
+      if (first != Tail () && (*first)->m_queueOrder < (*it)->m_queueOrder)
+        {
+          continue;
+        }
+      const WifiMacHeader &itHdr = (*it)->GetHeader ();
+      if (!itHdr.IsQosData () || !blockedPackets->IsBlocked (itHdr.GetAddr1 (), itHdr.GetQosTid ()))
+        {
+          first = it;
+        }
+    }
+  return first;
 }
 
 bool
@@ -97,24 +219,19 @@ WifiMacQueue::Enqueue (Ptr<WifiMacQueueItem> item)
   NS_ASSERT_MSG (GetMaxSize ().GetUnit () == QueueSizeUnit::PACKETS,
                  "WifiMacQueues must be in packet mode");
 
-  // if the queue is full, remove the first stale packet (if any) encountered
-  // starting from the head of the queue, in order to make room for the new packet.
-  if (QueueBase::GetNPackets () == GetMaxSize ().GetValue ())
-    {
-      auto it = Head ();
-      while (it != Tail () && !TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  // remove the stale packets (if any), which also makes room for the new
+  // packet if the queue is full
+  RemoveExpiredItems ();
 
   if (QueueBase::GetNPackets () == GetMaxSize ().GetValue () && m_dropPolicy == DROP_OLDEST)
     {
       NS_LOG_DEBUG ("Remove the oldest item in the queue");
-      DoRemove (Head ());
+      ConstIterator it = Head ();
+      Unindex (it);
+      DoRemove (it);
     }
 
-  return DoEnqueue (Tail (), item);
+  return Insert (Tail (), item);
 }
 
 bool
@@ -124,36 +241,31 @@ WifiMacQueue::PushFront (Ptr<WifiMacQueueItem> item)
   NS_ASSERT_MSG (GetMaxSize ().GetUnit () == QueueSizeUnit::PACKETS,
                  "WifiMacQueues must be in packet mode");
 
-  // if the queue is full, remove the first stale packet (if any) encountered
-  // starting from the head of the queue, in order to make room for the new packet.
-  if (QueueBase::GetNPackets () == GetMaxSize ().GetValue ())
-    {
-      auto it = Head ();
-      while (it != Tail () && !TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  // remove the stale packets (if any), which also makes room for the new
+  // packet if the queue is full
+  RemoveExpiredItems ();
 
   if (QueueBase::GetNPackets () == GetMaxSize ().GetValue () && m_dropPolicy == DROP_OLDEST)
     {
       NS_LOG_DEBUG ("Remove the oldest item in the queue");
-      DoRemove (Head ());
+      ConstIterator it = Head ();
+      Unindex (it);
+      DoRemove (it);
     }
 
-  return DoEnqueue (Head (), item);
+  return Insert (Head (), item);
 }
 
 Ptr<WifiMacQueueItem>
 WifiMacQueue::Dequeue (void)
 {
   NS_LOG_FUNCTION (this);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  ConstIterator it = Head ();
+  if (it != Tail ())
     {
-      if (!TtlExceeded (it))
-        {
-          return DoDequeue (it);
-        }
+      Unindex (it);
+      return DoDequeue (it);
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -163,18 +275,13 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::DequeueByAddress (Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  // the data frames are those of the QoS TIDs and the non-QoS data frames
+  ConstIterator it = FindFirst (dest, 0, NON_QOS_DATA);
+  if (it != Tail ())
     {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
-            {
-              return DoDequeue (it);
-            }
-
-          it++;
-        }
+      Unindex (it);
+      return DoDequeue (it);
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -184,18 +291,12 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::DequeueByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  ConstIterator it = FindFirst (dest, tid, tid);
+  if (it != Tail ())
     {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              return DoDequeue (it);
-            }
-
-          it++;
-        }
+      Unindex (it);
+      return DoDequeue (it);
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -205,18 +306,12 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::DequeueFirstAvailable (const Ptr<QosBlockedDestinations> blockedPackets)
 {
   NS_LOG_FUNCTION (this);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  ConstIterator it = FindFirstAvailable (blockedPackets);
+  if (it != Tail ())
     {
-      if (!TtlExceeded (it))
-        {
-          if (!(*it)->GetHeader ().IsQosData ()
-              || !blockedPackets->IsBlocked ((*it)->GetHeader ().GetAddr1 (), (*it)->GetHeader ().GetQosTid ()))
-            {
-              return DoDequeue (it);
-            }
-
-          it++;
-        }
+      Unindex (it);
+      return DoDequeue (it);
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -243,18 +338,11 @@ Ptr<const WifiMacQueueItem>
 WifiMacQueue::PeekByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  ConstIterator it = FindFirst (dest, tid, tid);
+  if (it != Tail ())
     {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              return DoPeek (it);
-            }
-
-          it++;
-        }
+      return DoPeek (it);
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -264,18 +352,11 @@ Ptr<const WifiMacQueueItem>
 WifiMacQueue::PeekFirstAvailable (const Ptr<QosBlockedDestinations> blockedPackets)
 {
   NS_LOG_FUNCTION (this);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  ConstIterator it = FindFirstAvailable (blockedPackets);
+  if (it != Tail ())
     {
-      if (!TtlExceeded (it))
-        {
-          if (!(*it)->GetHeader ().IsQosData ()
-              || !blockedPackets->IsBlocked ((*it)->GetHeader ().GetAddr1 (), (*it)->GetHeader ().GetQosTid ()))
-            {
-              return DoPeek (it);
-            }
-
-          it++;
-        }
+      return DoPeek (it);
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -285,13 +366,12 @@ Ptr<WifiMacQueueItem>
 WifiMacQueue::Remove (void)
 {
   NS_LOG_FUNCTION (this);
-
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  ConstIterator it = Head ();
+  if (it != Tail ())
     {
-      if (!TtlExceeded (it))
-        {
-          return DoRemove (it);
-        }
+      Unindex (it);
+      return DoRemove (it);
     }
   NS_LOG_DEBUG ("The queue is empty");
   return 0;
@@ -301,17 +381,14 @@ bool
 WifiMacQueue::Remove (Ptr<const Packet> packet)
 {
   NS_LOG_FUNCTION (this << packet);
-  for (auto it = Head (); it != Tail (); )
+  RemoveExpiredItems ();
+  for (auto it = Head (); it != Tail (); it++)
     {
-      if (!TtlExceeded (it))
+      if ((*it)->GetPacket () == packet)
         {
-          if ((*it)->GetPacket () == packet)
-            {
-              DoRemove (it);
-              return true;
-            }
-
-          it++;
+          Unindex (it);
+          DoRemove (it);
+          return true;
         }
     }
   NS_LOG_DEBUG ("Packet " << packet << " not found in the queue");
@@ -322,19 +399,15 @@ uint32_t
 WifiMacQueue::GetNPacketsByAddress (Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-
+  RemoveExpiredItems ();
   uint32_t nPackets = 0;
-
-  for (auto it = Head (); it != Tail (); )
+  // the data frames are those of the QoS TIDs and the non-QoS data frames
+  for (uint8_t tid = 0; tid <= NON_QOS_DATA; tid++)
     {
-      if (!TtlExceeded (it))
+      auto bucket = m_buckets.find (GetBucketKey (dest, tid));
+      if (bucket != m_buckets.end ())
         {
-          if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
-            {
-              nPackets++;
-            }
-
-          it++;
+          nPackets += bucket->second.items.size ();
         }
     }
   NS_LOG_DEBUG ("returns " << nPackets);
@@ -345,38 +418,40 @@ uint32_t
 WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
+  RemoveExpiredItems ();
   uint32_t nPackets = 0;
-  for (auto it = Head (); it != Tail (); )
+  auto bucket = m_buckets.find (GetBucketKey (dest, tid));
+  if (bucket != m_buckets.end ())
     {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              nPackets++;
-            }
-
-          it++;
-        }
+      nPackets = bucket->second.items.size ();
     }
   NS_LOG_DEBUG ("returns " << nPackets);
   return nPackets;
 }
 
+uint32_t
+WifiMacQueue::GetNBytesByTidAndAddress (uint8_t tid, Mac48Address dest)
+{
+  NS_LOG_FUNCTION (this << dest);
+  RemoveExpiredItems ();
+  uint32_t nBytes = 0;
+  auto bucket = m_buckets.find (GetBucketKey (dest, tid));
+  if (bucket != m_buckets.end ())
+    {
+      nBytes = bucket->second.nBytes;
+    }
+  NS_LOG_DEBUG ("returns " << nBytes);
+  return nBytes;
+}
+
 bool
 WifiMacQueue::IsEmpty (void)
 {
   NS_LOG_FUNCTION (this);
-  for (auto it = Head (); it != Tail (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          NS_LOG_DEBUG ("returns false");
-          return false;
-        }
-    }
-  NS_LOG_DEBUG ("returns true");
-  return true;
+  RemoveExpiredItems ();
+  bool empty = QueueBase::IsEmpty ();
+  NS_LOG_DEBUG ("returns " << (empty ? "true" : "false"));
+  return empty;
 }
 
 uint32_t
@@ -384,13 +459,7 @@ WifiMacQueue::GetNPackets (void)
 {
   NS_LOG_FUNCTION (this);
   // remove packets that stayed in the queue for too long
-  for (auto it = Head (); it != Tail (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  RemoveExpiredItems ();
   return QueueBase::GetNPackets ();
 }
 
@@ -399,13 +468,7 @@ WifiMacQueue::GetNBytes (void)
 {
   NS_LOG_FUNCTION (this);
   // remove packets that stayed in the queue for too long
-  for (auto it = Head (); it != Tail (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  RemoveExpiredItems ();
   return QueueBase::GetNBytes ();
 }
 
@@ -25,6 +25,7 @@
 #define WIFI_MAC_QUEUE_H
 
 #include "wifi-mac-queue-item.h"
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -44,6 +45,15 @@ class QosBlockedDestinations;
  * to verify whether or not it should be dropped. If
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
+ *
+ * Besides the list of all the items, the queue keeps, for each receiver,
+ * the list of the QoS data frames of each TID, the list of the non-QoS
+ * data frames and the list of the other frames, with their number of
+ * bytes, so that the frames to a receiver can be found without scanning
+ * the whole queue. The items which stayed in the queue for too long are
+ * found through an index of their timestamps, and removed when the
+ * queue is next accessed (except by the const Peek method, which skips
+ * them).
  */
 class WifiMacQueue : public Queue<WifiMacQueueItem>
 {
@@ -196,6 +206,16 @@ public:
    * \return the number of QoS packets
    */
   uint32_t GetNPacketsByTidAndAddress (uint8_t tid, Mac48Address dest);
+  /**
+   * Return the number of bytes of the QoS packets having tid equal to
+   * <i>tid</i> and destination address equal to <i>dest</i>.
+   *
+   * \param tid the given TID
+   * \param dest the given destination
+   *
+   * \return the number of bytes of the QoS packets
+   */
+  uint32_t GetNBytesByTidAndAddress (uint8_t tid, Mac48Address dest);
 
   /**
    * \return true if the queue is empty; false otherwise
@@ -219,18 +239,82 @@ public:
   uint32_t GetNBytes (void);
 
 private:
+  /// The items of the queue to a receiver with a given TID or kind of frame
+  struct Bucket
+  {
+    std::list<ConstIterator> items; //!< the positions of the items in the queue, in the order of the queue
+    uint32_t nBytes;                //!< the total size of the items
+  };
+
+  /// The TIDs of the buckets of the frames which are not QoS data frames
+  enum BucketTid
+  {
+    NON_QOS_DATA = 16,
+    NON_DATA = 17
+  };
+
+  /**
+   * Return the key of a bucket.
+   *
+   * \param address the receiver address
+   * \param tid the TID of the QoS data frames, or a BucketTid
+   *
+   * \return the address in the 48 most significant bits and the TID in
+   *         the 8 least significant bits
+   */
+  static uint64_t GetBucketKey (Mac48Address address, uint8_t tid);
+  /**
+   * Return the key of the bucket of an item.
+   *
+   * \param item the item
+   *
+   * \return the key of the bucket
+   */
+  static uint64_t GetBucketKey (Ptr<const WifiMacQueueItem> item);
+  /**
+   * Insert an item in the queue and in its indexes.
+   *
+   * \param pos the position where the item is inserted (Head () or Tail ())
+   * \param item the item
+   * \return true if success, false if the packet has been dropped
+   */
+  bool Insert (ConstIterator pos, Ptr<WifiMacQueueItem> item);
+  /**
+   * Remove an item from the indexes, before it is removed from the queue.
+   *
+   * \param pos the position of the item in the queue
+   */
+  void Unindex (ConstIterator pos);
+  /**
+   * Remove the items which have been in the queue for too long.
+   */
+  void RemoveExpiredItems (void);
+  /**
+   * Return the position of the first item of the given buckets.
+   *
+   * \param dest the receiver address of the buckets
+   * \param firstTid the TID of the first bucket
+   * \param lastTid the TID of the last bucket
+   * \return the position of the first item of the buckets, or Tail ()
+   *         if the buckets are empty
+   */
+  ConstIterator FindFirst (Mac48Address dest, uint8_t firstTid, uint8_t lastTid) const;
   /**
-   * Remove the item pointed to by the iterator <i>it</i> if it has been in the
-   * queue for too long. If the item is removed, the iterator is updated to
-   * point to the item that followed the erased one.
+   * Return the position of the first item which is not a QoS data frame
+   * to a blocked receiver and TID.
    *
-   * \param it an iterator pointing to the item
-   * \return true if the item is removed, false otherwise
+   * \param blockedPackets the blocked receivers and TIDs
+   * \return the position of the first available item, or Tail () if
+   *         no item is available
    */
-  bool TtlExceeded (ConstIterator &it);
+  ConstIterator FindFirstAvailable (const Ptr<QosBlockedDestinations> blockedPackets) const;
 
   Time m_maxDelay;                          //!< Time to live for packets in the queue
   DropPolicy m_dropPolicy;                  //!< Drop behavior of queue
+  std::unordered_map<uint64_t, Bucket> m_buckets; //!< the non-empty buckets, indexed by key
+  std::multimap<Time, ConstIterator> m_expiry;    //!< the positions of the items, indexed by timestamp
+  int64_t m_headOrder;                      //!< the rank of the next item pushed at the front of the queue
+  int64_t m_tailOrder;                      //!< the rank of the next item enqueued at the end of the queue
 
   NS_LOG_TEMPLATE_DECLARE;                  //!< redefinition of the log component
 };
@@ -161,8 +161,8 @@ WifiMode::GetDataRate (uint16_t channelWidth, uint16_t guardInterval, uint8_t ns
   uint64_t dataRate = 0;
   uint16_t usableSubCarriers = 0;
   double symbolRate = 0;
-  double codingRate = 0;
-  uint16_t numberOfBitsPerSubcarrier = static_cast<uint16_t> (log2 (GetConstellationSize ()));
+  double codingRate = item->codingRateValue;
+  uint16_t numberOfBitsPerSubcarrier = item->numberOfBitsPerSubcarrier;
   if (item->modClass == WIFI_MOD_CLASS_DSSS)
     {
       dataRate = ((11000000 / 11) * numberOfBitsPerSubcarrier);
@@ -188,21 +188,9 @@ WifiMode::GetDataRate (uint16_t channelWidth, uint16_t guardInterval, uint8_t ns
           break;
         }
 
-      switch (GetCodeRate ())
+      if (item->codingRate == WIFI_CODE_RATE_UNDEFINED)
         {
-        case WIFI_CODE_RATE_3_4:
-          codingRate = (3.0 / 4.0);
-          break;
-        case WIFI_CODE_RATE_2_3:
-          codingRate = (2.0 / 3.0);
-          break;
-        case WIFI_CODE_RATE_1_2:
-          codingRate = (1.0 / 2.0);
-          break;
-        case WIFI_CODE_RATE_UNDEFINED:
-        default:
           NS_FATAL_ERROR ("trying to get datarate for a mcs without any coding rate defined");
-          break;
         }
 
       dataRate = lrint (ceil (symbolRate * usableSubCarriers * numberOfBitsPerSubcarrier * codingRate));
@@ -252,24 +240,9 @@ WifiMode::GetDataRate (uint16_t channelWidth, uint16_t guardInterval, uint8_t ns
             }
         }
 
-      switch (GetCodeRate ())
+      if (item->codingRate == WIFI_CODE_RATE_UNDEFINED)
         {
-        case WIFI_CODE_RATE_5_6:
-          codingRate = (5.0 / 6.0);
-          break;
-        case WIFI_CODE_RATE_3_4:
-          codingRate = (3.0 / 4.0);
-          break;
-        case WIFI_CODE_RATE_2_3:
-          codingRate = (2.0 / 3.0);
-          break;
-        case WIFI_CODE_RATE_1_2:
-          codingRate = (1.0 / 2.0);
-          break;
-        case WIFI_CODE_RATE_UNDEFINED:
-        default:
           NS_FATAL_ERROR ("trying to get datarate for a mcs without any coding rate defined with nss: " << +nss);
-          break;
         }
 
       dataRate = lrint (ceil (symbolRate * usableSubCarriers * numberOfBitsPerSubcarrier * codingRate));
@@ -296,24 +269,9 @@ WifiMode::GetDataRate (uint16_t channelWidth, uint16_t guardInterval, uint8_t ns
           break;
         }
 
-      switch (GetCodeRate ())
+      if (item->codingRate == WIFI_CODE_RATE_UNDEFINED)
         {
-        case WIFI_CODE_RATE_5_6:
-          codingRate = (5.0 / 6.0);
-          break;
-        case WIFI_CODE_RATE_3_4:
-          codingRate = (3.0 / 4.0);
-          break;
-        case WIFI_CODE_RATE_2_3:
-          codingRate = (2.0 / 3.0);
-          break;
-        case WIFI_CODE_RATE_1_2:
-          codingRate = (1.0 / 2.0);
-          break;
-        case WIFI_CODE_RATE_UNDEFINED:
-        default:
           NS_FATAL_ERROR ("trying to get datarate for a mcs without any coding rate defined with nss: " << +nss);
-          break;
         }
 
       dataRate = lrint (ceil (symbolRate * usableSubCarriers * numberOfBitsPerSubcarrier * codingRate));
@@ -330,133 +288,14 @@ WifiCodeRate
 WifiMode::GetCodeRate (void) const
 {
   WifiModeFactory::WifiModeItem *item = WifiModeFactory::GetFactory ()->Get (m_uid);
-  if (item->modClass == WIFI_MOD_CLASS_HT)
-    {
-      switch (item->mcsValue % 8)
-        {
-        case 0:
-        case 1:
-        case 3:
-          return WIFI_CODE_RATE_1_2;
-        case 2:
-        case 4:
-        case 6:
-          return WIFI_CODE_RATE_3_4;
-        case 5:
-          return WIFI_CODE_RATE_2_3;
-        case 7:
-          return WIFI_CODE_RATE_5_6;
-        default:
-          return WIFI_CODE_RATE_UNDEFINED;
-        }
-    }
-  else if (item->modClass == WIFI_MOD_CLASS_VHT)
-    {
-      switch (item->mcsValue)
-        {
-        case 0:
-        case 1:
-        case 3:
-          return WIFI_CODE_RATE_1_2;
-        case 2:
-        case 4:
-        case 6:
-        case 8:
-          return WIFI_CODE_RATE_3_4;
-        case 5:
-          return WIFI_CODE_RATE_2_3;
-        case 7:
-        case 9:
-          return WIFI_CODE_RATE_5_6;
-        default:
-          return WIFI_CODE_RATE_UNDEFINED;
-        }
-    }
-  else if (item->modClass == WIFI_MOD_CLASS_HE)
-    {
-      switch (item->mcsValue)
-        {
-        case 0:
-        case 1:
-        case 3:
-          return WIFI_CODE_RATE_1_2;
-        case 2:
-        case 4:
-        case 6:
-        case 8:
-        case 10:
-          return WIFI_CODE_RATE_3_4;
-        case 5:
-          return WIFI_CODE_RATE_2_3;
-        case 7:
-        case 9:
-        case 11:
-          return WIFI_CODE_RATE_5_6;
-        default:
-          return WIFI_CODE_RATE_UNDEFINED;
-        }
-    }
-  else
-    {
-      return item->codingRate;
-    }
+  return item->codingRate;
 }
 
 uint16_t
 WifiMode::GetConstellationSize (void) const
 {
   WifiModeFactory::WifiModeItem *item = WifiModeFactory::GetFactory ()->Get (m_uid);
-  if (item->modClass == WIFI_MOD_CLASS_HT)
-    {
-      switch (item->mcsValue % 8)
-        {
-        case 0:
-          return 2;
-        case 1:
-        case 2:
-          return 4;
-        case 3:
-        case 4:
-          return 16;
-        case 5:
-        case 6:
-        case 7:
-          return 64;
-        default:
-          return 0;
-        }
-    }
-  else if (item->modClass == WIFI_MOD_CLASS_VHT || item->modClass == WIFI_MOD_CLASS_HE)
-    {
-      switch (item->mcsValue)
-        {
-        case 0:
-          return 2;
-        case 1:
-        case 2:
-          return 4;
-        case 3:
-        case 4:
-          return 16;
-        case 5:
-        case 6:
-        case 7:
-          return 64;
-        case 8:
-        case 9:
-          return 256;
-        case 10:
-        case 11:
-          NS_ASSERT (item->modClass == WIFI_MOD_CLASS_HE);
-          return 1024;
-        default:
-          return 0;
-        }
-    }
-  else
-    {
-      return item->constellationSize;
-    }
+  return item->constellationSize;
 }
 
 std::string
@@ -724,6 +563,7 @@ WifiModeFactory::CreateWifiMode (std::string uniqueName,
   NS_ASSERT (modClass != WIFI_MOD_CLASS_HT && modClass != WIFI_MOD_CLASS_VHT && modClass != WIFI_MOD_CLASS_HE);
   //fill unused mcs item with a dummy value
   item->mcsValue = 0;
+  ComputeConstants (item);
 
   return WifiMode (uid);
 }
@@ -743,14 +583,141 @@ WifiModeFactory::CreateWifiMcs (std::string uniqueName,
   NS_ASSERT (modClass == WIFI_MOD_CLASS_HT || modClass == WIFI_MOD_CLASS_VHT || modClass == WIFI_MOD_CLASS_HE);
 
   item->mcsValue = mcsValue;
-  //fill unused items with dummy values
-  item->constellationSize = 0;
-  item->codingRate = WIFI_CODE_RATE_UNDEFINED;
   item->isMandatory = false;
+  ComputeConstants (item);
 
   return WifiMode (uid);
 }
 
+void
+WifiModeFactory::ComputeConstants (WifiModeItem *item)
+{
+  if (item->modClass == WIFI_MOD_CLASS_HT)
+    {
+      switch (item->mcsValue % 8)
+        {
+        case 0:
+          item->constellationSize = 2;
+          item->codingRate = WIFI_CODE_RATE_1_2;
+          break;
+        case 1:
+          item->constellationSize = 4;
+          item->codingRate = WIFI_CODE_RATE_1_2;
+          break;
+        case 2:
+          item->constellationSize = 4;
+          item->codingRate = WIFI_CODE_RATE_3_4;
+          break;
+        case 3:
+          item->constellationSize = 16;
+          item->codingRate = WIFI_CODE_RATE_1_2;
+          break;
+        case 4:
+          item->constellationSize = 16;
+          item->codingRate = WIFI_CODE_RATE_3_4;
+          break;
+        case 5:
+          item->constellationSize = 64;
+          item->codingRate = WIFI_CODE_RATE_2_3;
+          break;
+        case 6:
+          item->constellationSize = 64;
+          item->codingRate = WIFI_CODE_RATE_3_4;
+          break;
+        case 7:
+        default:
+          item->constellationSize = 64;
+          item->codingRate = WIFI_CODE_RATE_5_6;
+          break;
+        }
+    }
+  else if (item->modClass == WIFI_MOD_CLASS_VHT || item->modClass == WIFI_MOD_CLASS_HE)
+    {
+      switch (item->mcsValue)
+        {
+        case 0:
+          item->constellationSize = 2;
+          item->codingRate = WIFI_CODE_RATE_1_2;
+          break;
+        case 1:
+          item->constellationSize = 4;
+          item->codingRate = WIFI_CODE_RATE_1_2;
+          break;
+        case 2:
+          item->constellationSize = 4;
+          item->codingRate = WIFI_CODE_RATE_3_4;
+          break;
+        case 3:
+          item->constellationSize = 16;
+          item->codingRate = WIFI_CODE_RATE_1_2;
+          break;
+        case 4:
+          item->constellationSize = 16;
+          item->codingRate = WIFI_CODE_RATE_3_4;
+          break;
+        case 5:
+          item->constellationSize = 64;
+          item->codingRate = WIFI_CODE_RATE_2_3;
+          break;
+        case 6:
+          item->constellationSize = 64;
+          item->codingRate = WIFI_CODE_RATE_3_4;
+          break;
+        case 7:
+          item->constellationSize = 64;
+          item->codingRate = WIFI_CODE_RATE_5_6;
+          break;
+        case 8:
+          item->constellationSize = 256;
+          item->codingRate = WIFI_CODE_RATE_3_4;
+          break;
+        case 9:
+          item->constellationSize = 256;
+          item->codingRate = WIFI_CODE_RATE_5_6;
+          break;
+        case 10:
+          NS_ASSERT (item->modClass == WIFI_MOD_CLASS_HE);
+          item->constellationSize = 1024;
+          item->codingRate = WIFI_CODE_RATE_3_4;
+          break;
+        case 11:
+          NS_ASSERT (item->modClass == WIFI_MOD_CLASS_HE);
+          item->constellationSize = 1024;
+          item->codingRate = WIFI_CODE_RATE_5_6;
+          break;
+        default:
+          item->constellationSize = 0;
+          item->codingRate = WIFI_CODE_RATE_UNDEFINED;
+          break;
+        }
+    }
+
+  item->numberOfBitsPerSubcarrier = 0;
+  if (item->constellationSize > 0)
+    {
+      item->numberOfBitsPerSubcarrier = static_cast<uint16_t> (log2 (item->constellationSize));
+    }
+  switch (item->codingRate)
+    {
+    case WIFI_CODE_RATE_5_6:
+      item->codingRateValue = (5.0 / 6.0);
+      break;
+    case WIFI_CODE_RATE_3_4:
+      item->codingRateValue = (3.0 / 4.0);
+      break;
+    case WIFI_CODE_RATE_2_3:
+      item->codingRateValue = (2.0 / 3.0);
+      break;
+    case WIFI_CODE_RATE_1_2:
+      item->codingRateValue = (1.0 / 2.0);
+      break;
+    case WIFI_CODE_RATE_UNDEFINED:
+    default:
+      item->codingRateValue = 0;
+      break;
+    }
+}
+
 WifiMode
 WifiModeFactory::Search (std::string name) const
 {
@@ -826,6 +793,8 @@ WifiModeFactory::GetFactory (void)
       item->codingRate = WIFI_CODE_RATE_UNDEFINED;
       item->isMandatory = false;
       item->mcsValue = 0;
+      item->numberOfBitsPerSubcarrier = 0;
+      item->codingRateValue = 0;
       isFirstTime = false;
     }
   return &factory;
@@ -318,6 +318,11 @@ private:
    * This is the data associated to a unique WifiMode.
    * The integer stored in a WifiMode is in fact an index
    * in an array of WifiModeItem objects.
+   *
+   * The constellation size and the coding rate of the HT, VHT and HE
+   * MCSs are derived from their MCS value when they are created, and
+   * the values used to compute the data rates are computed once for
+   * all modes, since the data rates are needed for every frame.
    */
   struct WifiModeItem
   {
@@ -327,8 +332,21 @@ private:
     WifiCodeRate codingRate; ///< coding rate
     bool isMandatory; ///< flag to indicate whether this mode is mandatory
     uint8_t mcsValue; ///< MCS value
+    uint16_t numberOfBitsPerSubcarrier; ///< log2 of the constellation size
+    double codingRateValue; ///< coding rate, 0 if undefined
   };
 
+  /**
+   * Compute the constellation size and the coding rate of an HT, VHT
+   * or HE MCS, and the values of a WifiModeItem used to compute the
+   * data rates.
+   *
+   * \param item the WifiModeItem, whose modulation class, MCS value,
+   *        and for the other modulation classes, constellation size
+   *        and coding rate, are set
+   */
+  static void ComputeConstants (WifiModeItem *item);
+
   /**
    * Search and return WifiMode from a given name.
    *
@@ -31,6 +31,7 @@
 #include "frame-capture-model.h"
 #include "wifi-radio-energy-model.h"
 #include "error-rate-model.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -304,6 +305,14 @@ WifiPhy::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&WifiPhy::m_frameCaptureModel),
                    MakePointerChecker <FrameCaptureModel> ())
+    .AddAttribute ("FrameAbstraction",
+                   "If true, the reception of a frame is abstracted: the reception of both its "
+                   "PLCP header and its payload is decided upon at the end of the frame, from "
+                   "the SINR of the mean noise and interference power over the frame and the "
+                   "tabulated bit error rates of the error rate model.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&WifiPhy::m_frameAbstraction),
+                   MakeBooleanChecker ())
     .AddTraceSource ("PhyTxBegin",
                      "Trace source indicating a packet "
                      "has begun transmitting over the channel medium",
@@ -373,6 +382,7 @@ WifiPhy::WifiPhy ()
     m_totalAmpduSize (0),
     m_totalAmpduNumSymbols (0),
     m_currentEvent (0),
+    m_frameAbstraction (false),
     m_wifiRadioEnergyModel (0)
 {
   NS_LOG_FUNCTION (this);
@@ -1941,9 +1951,127 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
 Time
 WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t frequency, MpduType mpdutype, uint8_t incFlag)
 {
-  WifiMode payloadMode = txVector.GetMode ();
   WifiPreamble preamble = txVector.GetPreambleType ();
-  NS_LOG_FUNCTION (size << payloadMode);
+  NS_LOG_FUNCTION (size << txVector.GetMode ());
+  const TxDurationParameters &params = GetTxDurationParameters (txVector, frequency);
+
+  double numSymbols = 0;
+  if (mpdutype == MPDU_IN_AGGREGATE && preamble != WIFI_PREAMBLE_NONE)
+    {
+      //First packet in an A-MPDU
+      numSymbols = (params.stbc * (16 + size * 8.0 + 6 * params.nes) / (params.stbc * params.numDataBitsPerSymbol));
+      if (incFlag == 1)
+        {
+          m_totalAmpduSize += size;
+          m_totalAmpduNumSymbols += numSymbols;
+        }
+    }
+  else if (mpdutype == MPDU_IN_AGGREGATE && preamble == WIFI_PREAMBLE_NONE)
+    {
+      //consecutive packets in an A-MPDU
+      numSymbols = (params.stbc * size * 8.0) / (params.stbc * params.numDataBitsPerSymbol);
+      if (incFlag == 1)
+        {
+          m_totalAmpduSize += size;
+          m_totalAmpduNumSymbols += numSymbols;
+        }
+    }
+  else if (mpdutype == LAST_MPDU_IN_AGGREGATE && preamble == WIFI_PREAMBLE_NONE)
+    {
+      //last packet in an A-MPDU
+      uint32_t totalAmpduSize = m_totalAmpduSize + size;
+      numSymbols = lrint (params.stbc * ceil ((16 + totalAmpduSize * 8.0 + 6 * params.nes) / (params.stbc * params.numDataBitsPerSymbol)));
+      NS_ASSERT (m_totalAmpduNumSymbols <= numSymbols);
+      numSymbols -= m_totalAmpduNumSymbols;
+      if (incFlag == 1)
+        {
+          m_totalAmpduSize = 0;
+          m_totalAmpduNumSymbols = 0;
+        }
+    }
+  else if (mpdutype == NORMAL_MPDU && preamble != WIFI_PREAMBLE_NONE)
+    {
+      //Not an A-MPDU
+      // The number of OFDM symbols in the data field when BCC encoding 
+      // is used is given in equation 19-32 of the IEEE 802.11-2016 standard.
+      numSymbols = lrint (params.stbc * ceil ((16 + size * 8.0 + 6.0 * params.nes) / (params.stbc * params.numDataBitsPerSymbol)));
+    }
+  else
+    {
+      NS_FATAL_ERROR ("Wrong combination of preamble and packet type");
+    }
+
+  switch (params.modClass)
+    {
+    case WIFI_MOD_CLASS_OFDM:
+    case WIFI_MOD_CLASS_ERP_OFDM:
+      {
+        //Add signal extension for ERP PHY
+        if (params.signalExtension)
+          {
+            return FemtoSeconds (static_cast<uint64_t> (numSymbols * params.symbolDuration.GetFemtoSeconds ())) + MicroSeconds (6);
+          }
+        else
+          {
+            return FemtoSeconds (static_cast<uint64_t> (numSymbols * params.symbolDuration.GetFemtoSeconds ()));
+          }
+      }
+    case WIFI_MOD_CLASS_HT:
+    case WIFI_MOD_CLASS_VHT:
+    case WIFI_MOD_CLASS_HE:
+      {
+        if (params.signalExtension
+            && ((mpdutype == NORMAL_MPDU && preamble != WIFI_PREAMBLE_NONE)
+                || (mpdutype == LAST_MPDU_IN_AGGREGATE && preamble == WIFI_PREAMBLE_NONE))) //at 2.4 GHz
+          {
+            return FemtoSeconds (static_cast<uint64_t> (numSymbols * params.symbolDuration.GetFemtoSeconds ())) + MicroSeconds (6);
+          }
+        else //at 5 GHz
+          {
+            return FemtoSeconds (static_cast<uint64_t> (numSymbols * params.symbolDuration.GetFemtoSeconds ()));
+          }
+      }
+    case WIFI_MOD_CLASS_DSSS:
+    case WIFI_MOD_CLASS_HR_DSSS:
+      return MicroSeconds (lrint (ceil ((size * 8.0) / params.dsssRate)));
+    default:
+      NS_FATAL_ERROR ("unsupported modulation class");
+      return MicroSeconds (0);
+    }
+}
+
+const WifiPhy::TxDurationParameters &
+WifiPhy::GetTxDurationParameters (WifiTxVector txVector, uint16_t frequency)
+{
+  //the fields of the TXVECTOR the duration depends on; the number of
+  //extension spatial streams is capped to 3 since 3 and 4 give the
+  //same training symbols
+  NS_ASSERT (txVector.GetMode ().GetUid () < 65536);
+  uint64_t key = (static_cast<uint64_t> (txVector.GetMode ().GetUid ()) << 48)
+    | (static_cast<uint64_t> (txVector.GetPreambleType ()) << 40)
+    | (static_cast<uint64_t> (txVector.GetGuardInterval ()) << 24)
+    | (static_cast<uint64_t> (txVector.GetChannelWidth ()) << 8)
+    | (static_cast<uint64_t> (txVector.GetNss () & 0x0f) << 4)
+    | (static_cast<uint64_t> (std::min<uint8_t> (txVector.GetNess (), 3)) << 2)
+    | (static_cast<uint64_t> (txVector.IsStbc () ? 1 : 0) << 1)
+    | (Is2_4Ghz (frequency) ? 1 : 0);
+  auto it = m_txDurationParameters.find (key);
+  if (it == m_txDurationParameters.end ())
+    {
+      it = m_txDurationParameters.emplace (key, ComputeTxDurationParameters (txVector, frequency)).first;
+    }
+  return it->second;
+}
+
+WifiPhy::TxDurationParameters
+WifiPhy::ComputeTxDurationParameters (WifiTxVector txVector, uint16_t frequency)
+{
+  WifiMode payloadMode = txVector.GetMode ();
+  NS_LOG_FUNCTION (payloadMode << frequency);
+
+  TxDurationParameters params;
+  params.preambleAndHeader = CalculatePlcpPreambleAndHeaderDuration (txVector);
+  params.modClass = payloadMode.GetModulationClass ();
 
   double stbc = 1;
   if (txVector.IsStbc ()
@@ -2113,101 +2241,18 @@ WifiPhy::GetPayloadDuration (uint32_t size, WifiTxVector txVector, uint16_t freq
 
   double numDataBitsPerSymbol = payloadMode.GetDataRate (txVector) * symbolDuration.GetNanoSeconds () / 1e9;
 
-  double numSymbols = 0;
-  if (mpdutype == MPDU_IN_AGGREGATE && preamble != WIFI_PREAMBLE_NONE)
-    {
-      //First packet in an A-MPDU
-      numSymbols = (stbc * (16 + size * 8.0 + 6 * Nes) / (stbc * numDataBitsPerSymbol));
-      if (incFlag == 1)
-        {
-          m_totalAmpduSize += size;
-          m_totalAmpduNumSymbols += numSymbols;
-        }
-    }
-  else if (mpdutype == MPDU_IN_AGGREGATE && preamble == WIFI_PREAMBLE_NONE)
-    {
-      //consecutive packets in an A-MPDU
-      numSymbols = (stbc * size * 8.0) / (stbc * numDataBitsPerSymbol);
-      if (incFlag == 1)
-        {
-          m_totalAmpduSize += size;
-          m_totalAmpduNumSymbols += numSymbols;
-        }
-    }
-  else if (mpdutype == LAST_MPDU_IN_AGGREGATE && preamble == WIFI_PREAMBLE_NONE)
-    {
-      //last packet in an A-MPDU
-      uint32_t totalAmpduSize = m_totalAmpduSize + size;
-      numSymbols = lrint (stbc * ceil ((16 + totalAmpduSize * 8.0 + 6 * Nes) / (stbc * numDataBitsPerSymbol)));
-      NS_ASSERT (m_totalAmpduNumSymbols <= numSymbols);
-      numSymbols -= m_totalAmpduNumSymbols;
-      if (incFlag == 1)
-        {
-          m_totalAmpduSize = 0;
-          m_totalAmpduNumSymbols = 0;
-        }
-    }
-  else if (mpdutype == NORMAL_MPDU && preamble != WIFI_PREAMBLE_NONE)
-    {
-      //Not an A-MPDU
-      // The number of OFDM symbols in the data field when BCC encoding 
-      // is used is given in equation 19-32 of the IEEE 802.11-2016 standard.
-      numSymbols = lrint (stbc * ceil ((16 + size * 8.0 + 6.0 * Nes) / (stbc * numDataBitsPerSymbol)));
-    }
-  else
-    {
-      NS_FATAL_ERROR ("Wrong combination of preamble and packet type");
-    }
-
-  switch (payloadMode.GetModulationClass ())
+  params.symbolDuration = symbolDuration;
+  params.numDataBitsPerSymbol = numDataBitsPerSymbol;
+  params.stbc = stbc;
+  params.nes = Nes;
+  params.signalExtension = params.modClass == WIFI_MOD_CLASS_ERP_OFDM
+    || ((params.modClass == WIFI_MOD_CLASS_HT || params.modClass == WIFI_MOD_CLASS_HE) && Is2_4Ghz (frequency));
+  params.dsssRate = 0;
+  if (params.modClass == WIFI_MOD_CLASS_DSSS || params.modClass == WIFI_MOD_CLASS_HR_DSSS)
     {
-    case WIFI_MOD_CLASS_OFDM:
-    case WIFI_MOD_CLASS_ERP_OFDM:
-      {
-        //Add signal extension for ERP PHY
-        if (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM)
-          {
-            return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ())) + MicroSeconds (6);
-          }
-        else
-          {
-            return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ()));
-          }
-      }
-    case WIFI_MOD_CLASS_HT:
-    case WIFI_MOD_CLASS_VHT:
-      {
-        if (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_HT && Is2_4Ghz (frequency)
-            && ((mpdutype == NORMAL_MPDU && preamble != WIFI_PREAMBLE_NONE)
-                || (mpdutype == LAST_MPDU_IN_AGGREGATE && preamble == WIFI_PREAMBLE_NONE))) //at 2.4 GHz
-          {
-            return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ())) + MicroSeconds (6);
-          }
-        else //at 5 GHz
-          {
-            return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ()));
-          }
-      }
-    case WIFI_MOD_CLASS_HE:
-      {
-        if (Is2_4Ghz (frequency)
-            && ((mpdutype == NORMAL_MPDU && preamble != WIFI_PREAMBLE_NONE)
-                || (mpdutype == LAST_MPDU_IN_AGGREGATE && preamble == WIFI_PREAMBLE_NONE))) //at 2.4 GHz
-          {
-            return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ())) + MicroSeconds (6);
-          }
-        else //at 5 GHz
-          {
-            return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ()));
-          }
-      }
-    case WIFI_MOD_CLASS_DSSS:
-    case WIFI_MOD_CLASS_HR_DSSS:
-      return MicroSeconds (lrint (ceil ((size * 8.0) / (payloadMode.GetDataRate (22) / 1.0e6))));
-    default:
-      NS_FATAL_ERROR ("unsupported modulation class");
-      return MicroSeconds (0);
+      params.dsssRate = payloadMode.GetDataRate (22) / 1.0e6;
     }
+  return params;
 }
 
 Time
@@ -2227,7 +2272,7 @@ WifiPhy::CalculatePlcpPreambleAndHeaderDuration (WifiTxVector txVector)
 Time
 WifiPhy::CalculateTxDuration (uint32_t size, WifiTxVector txVector, uint16_t frequency, MpduType mpdutype, uint8_t incFlag)
 {
-  Time duration = CalculatePlcpPreambleAndHeaderDuration (txVector)
+  Time duration = GetTxDurationParameters (txVector, frequency).preambleAndHeader
     + GetPayloadDuration (size, txVector, frequency, mpdutype, incFlag);
   return duration;
 }
@@ -2321,7 +2366,6 @@ WifiPhy::SendPacket (Ptr<const Packet> packet, WifiTxVector txVector, MpduType m
     {
       m_endPlcpRxEvent.Cancel ();
       m_endRxEvent.Cancel ();
-      m_interference.NotifyRxEnd ();
     }
   NotifyTxBegin (packet);
   if ((mpdutype == MPDU_IN_AGGREGATE) && (txVector.GetPreambleType () != WIFI_PREAMBLE_NONE))
@@ -2508,14 +2552,19 @@ WifiPhy::StartReceivePacket (Ptr<Packet> packet,
   NS_LOG_FUNCTION (this << packet << txVector.GetMode () << txVector.GetPreambleType () << +mpdutype);
   NS_ASSERT (IsStateRx ());
   NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
-  WifiMode txMode = txVector.GetMode ();
 
   InterferenceHelper::SnrPer snrPer;
   snrPer = m_interference.CalculatePlcpHeaderSnrPer (event);
 
   NS_LOG_DEBUG ("snr(dB)=" << RatioToDb (snrPer.snr) << ", per=" << snrPer.per);
+  ReceivePlcpHeader (packet, txVector.GetMode (), snrPer.per);
+}
 
-  if (m_random->GetValue () > snrPer.per) //plcp reception succeeded
+void
+WifiPhy::ReceivePlcpHeader (Ptr<Packet> packet, WifiMode txMode, double per)
+{
+  NS_LOG_FUNCTION (this << packet << txMode << per);
+  if (m_random->GetValue () > per) //plcp reception succeeded
     {
       if (IsModeSupported (txMode) || IsMcsSupported (txMode))
         {
@@ -2545,8 +2594,21 @@ WifiPhy::EndReceive (Ptr<Packet> packet, WifiPreamble preamble, MpduType mpdutyp
   NS_ASSERT (event->GetEndTime () == Simulator::Now ());
 
   InterferenceHelper::SnrPer snrPer;
-  snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
-  m_interference.NotifyRxEnd ();
+  if (m_frameAbstraction)
+    {
+      InterferenceHelper::AbstractedSnrPer abstractedSnrPer = m_interference.CalculateAbstractedSnrPer (event);
+      if (preamble != WIFI_PREAMBLE_NONE)
+        {
+          //the PLCP header has not been received yet
+          ReceivePlcpHeader (packet, event->GetPayloadMode (), abstractedSnrPer.headerPer);
+        }
+      snrPer.snr = abstractedSnrPer.snr;
+      snrPer.per = abstractedSnrPer.payloadPer;
+    }
+  else
+    {
+      snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+    }
   m_currentEvent = 0;
 
   if (m_plcpSuccess == true)
@@ -3609,7 +3671,6 @@ WifiPhy::AbortCurrentReception ()
       m_endRxEvent.Cancel ();
     }
   NotifyRxDrop (m_currentEvent->GetPacket ());
-  m_interference.NotifyRxEnd ();
   m_state->SwitchFromRxAbort ();
   m_currentEvent = 0;
 }
@@ -3666,9 +3727,10 @@ WifiPhy::StartRx (Ptr<Packet> packet, WifiTxVector txVector, MpduType mpdutype,
       m_state->SwitchToRx (rxDuration);
       NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
       NotifyRxBegin (packet);
-      m_interference.NotifyRxStart ();
 
-      if (preamble != WIFI_PREAMBLE_NONE)
+      //with the frame abstraction, the reception of the PLCP header is
+      //decided upon at the end of the frame
+      if (preamble != WIFI_PREAMBLE_NONE && !m_frameAbstraction)
         {
           NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
           Time preambleAndHeaderDuration = CalculatePlcpPreambleAndHeaderDuration (txVector);
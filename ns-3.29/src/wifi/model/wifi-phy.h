@@ -27,6 +27,7 @@
 #include "wifi-phy-standard.h"
 #include "interference-helper.h"
 #include "wifi-phy-state-helper.h"
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -138,6 +139,16 @@ public:
    */
   void EndReceive (Ptr<Packet> packet, WifiPreamble preamble, MpduType mpdutype, Ptr<Event> event);
 
+  /**
+   * Decide whether the PLCP header of a packet is successfully received,
+   * given its error rate.
+   *
+   * \param packet the arriving packet
+   * \param txMode the mode of the payload of the arriving packet
+   * \param per the error rate of the PLCP header
+   */
+  void ReceivePlcpHeader (Ptr<Packet> packet, WifiMode txMode, double per);
+
   /**
    * \param packet the packet to send
    * \param txVector the TXVECTOR that has tx parameters such as mode, the transmission mode to use to send
@@ -1508,6 +1519,48 @@ protected:
   EventId m_endPlcpRxEvent;            //!< the end PLCP receive event
 
 private:
+  /**
+   * The parameters of the computation of the duration of a PPDU which
+   * only depend on its TXVECTOR and on the band (2.4 GHz or not).
+   */
+  struct TxDurationParameters
+  {
+    Time preambleAndHeader;      //!< the duration of the PLCP preamble and header
+    WifiModulationClass modClass; //!< the modulation class of the payload
+    Time symbolDuration;         //!< the duration of an OFDM symbol of the payload
+    double numDataBitsPerSymbol; //!< the number of data bits per OFDM symbol
+    double stbc;                 //!< 2 if STBC is used, 1 otherwise
+    double nes;                  //!< the number of BCC encoders
+    bool signalExtension;        //!< whether a 6 us signal extension ends the PPDU
+    double dsssRate;             //!< the DSSS data rate (Mbps)
+  };
+
+  /**
+   * Get the parameters of the computation of the duration of the PPDUs
+   * sent with the given TXVECTOR, computing them on the first call.
+   *
+   * The data rate of the mode, the symbol duration and the number of
+   * BCC encoders are needed to compute the duration of every frame,
+   * NAV, timeout and A-MPDU size, while only a few TXVECTORs are used
+   * by a PHY.
+   *
+   * \param txVector the TXVECTOR used for the transmission
+   * \param frequency the channel center frequency (MHz)
+   *
+   * \return the parameters
+   */
+  const TxDurationParameters & GetTxDurationParameters (WifiTxVector txVector, uint16_t frequency);
+  /**
+   * Compute the parameters of the computation of the duration of the
+   * PPDUs sent with the given TXVECTOR.
+   *
+   * \param txVector the TXVECTOR used for the transmission
+   * \param frequency the channel center frequency (MHz)
+   *
+   * \return the parameters
+   */
+  static TxDurationParameters ComputeTxDurationParameters (WifiTxVector txVector, uint16_t frequency);
+
   /**
    * \brief post-construction setting of frequency and/or channel number
    *
@@ -1783,12 +1836,14 @@ private:
   Time m_channelSwitchDelay;     //!< Time required to switch between channel
   uint32_t m_totalAmpduSize;     //!< Total size of the previously transmitted MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
   double m_totalAmpduNumSymbols; //!< Number of symbols previously transmitted for the MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
+  std::unordered_map<uint64_t, TxDurationParameters> m_txDurationParameters; //!< the parameters of the duration of the PPDUs, indexed by TXVECTOR and band
 
   Ptr<NetDevice>     m_device;   //!< Pointer to the device
   Ptr<MobilityModel> m_mobility; //!< Pointer to the mobility model
 
   Ptr<Event> m_currentEvent; //!< Hold the current event
   Ptr<FrameCaptureModel> m_frameCaptureModel; //!< Frame capture model
+  bool m_frameAbstraction; //!< Whether the reception of the frames is abstracted
   Ptr<WifiRadioEnergyModel> m_wifiRadioEnergyModel; //!< Wifi radio energy model
 
   Callback<void> m_capabilitiesChangedCallback; //!< Callback when PHY capabilities changed
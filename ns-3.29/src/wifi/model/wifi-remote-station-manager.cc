@@ -415,6 +415,7 @@ WifiRemoteStationManager::WifiRemoteStationManager ()
     m_rifsPermitted (false)
 {
   NS_LOG_FUNCTION (this);
+  m_lastStation = 0;
 }
 
 WifiRemoteStationManager::~WifiRemoteStationManager ()
@@ -1641,13 +1642,12 @@ WifiRemoteStationState *
 WifiRemoteStationManager::LookupState (Mac48Address address) const
 {
   NS_LOG_FUNCTION (this << address);
-  for (StationStates::const_iterator i = m_states.begin (); i != m_states.end (); i++)
+  uint64_t key = GetStationKey (address, 0);
+  std::unordered_map<uint64_t, WifiRemoteStationState *>::const_iterator it = m_stateIndex.find (key);
+  if (it != m_stateIndex.end ())
     {
-      if ((*i)->m_address == address)
-        {
-          NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning existing state");
-          return (*i);
-        }
+      NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning existing state");
+      return it->second;
     }
   WifiRemoteStationState *state = new WifiRemoteStationState ();
   state->m_state = WifiRemoteStationState::BRAND_NEW;
@@ -1668,6 +1668,7 @@ WifiRemoteStationManager::LookupState (Mac48Address address) const
   state->m_vhtSupported = false;
   state->m_heSupported = false;
   const_cast<WifiRemoteStationManager *> (this)->m_states.push_back (state);
+  const_cast<WifiRemoteStationManager *> (this)->m_stateIndex[key] = state;
   NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning new state");
   return state;
 }
@@ -1691,13 +1692,18 @@ WifiRemoteStation *
 WifiRemoteStationManager::Lookup (Mac48Address address, uint8_t tid) const
 {
   NS_LOG_FUNCTION (this << address << +tid);
-  for (Stations::const_iterator i = m_stations.begin (); i != m_stations.end (); i++)
+  if (m_lastStation != 0
+      && m_lastStation->m_tid == tid
+      && m_lastStation->m_state->m_address == address)
     {
-      if ((*i)->m_tid == tid
-          && (*i)->m_state->m_address == address)
-        {
-          return (*i);
-        }
+      return m_lastStation;
+    }
+  uint64_t key = GetStationKey (address, tid);
+  std::unordered_map<uint64_t, WifiRemoteStation *>::const_iterator it = m_stationIndex.find (key);
+  if (it != m_stationIndex.end ())
+    {
+      m_lastStation = it->second;
+      return it->second;
     }
   WifiRemoteStationState *state = LookupState (address);
 
@@ -1707,9 +1713,24 @@ WifiRemoteStationManager::Lookup (Mac48Address address, uint8_t tid) const
   station->m_ssrc = 0;
   station->m_slrc = 0;
   const_cast<WifiRemoteStationManager *> (this)->m_stations.push_back (station);
+  const_cast<WifiRemoteStationManager *> (this)->m_stationIndex[key] = station;
+  m_lastStation = station;
   return station;
 }
 
+uint64_t
+WifiRemoteStationManager::GetStationKey (Mac48Address address, uint8_t tid)
+{
+  uint8_t buffer[6];
+  address.CopyTo (buffer);
+  uint64_t key = 0;
+  for (uint8_t i = 0; i < 6; i++)
+    {
+      key = (key << 8) | buffer[i];
+    }
+  return (key << 8) | tid;
+}
+
 void
 WifiRemoteStationManager::SetQosSupport (Mac48Address from, bool qosSupported)
 {
@@ -1877,6 +1898,9 @@ WifiRemoteStationManager::Reset (void)
       delete (*i);
     }
   m_stations.clear ();
+  m_stateIndex.clear ();
+  m_stationIndex.clear ();
+  m_lastStation = 0;
   m_bssBasicRateSet.clear ();
   m_bssBasicMcsSet.clear ();
 }
@@ -28,6 +28,7 @@
 #include "ns3/mac48-address.h"
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
+#include <unordered_map>
 
 namespace ns3 {
 
@@ -1323,6 +1324,10 @@ private:
   /**
    * Return the station associated with the given address and TID.
    *
+   * The stations are found through a hash index on (address, TID), and
+   * the station returned by the previous call is checked first, since
+   * MacLow makes several calls for the same MPDU in a row.
+   *
    * \param address the address of the station
    * \param tid the TID
    *
@@ -1340,6 +1345,16 @@ private:
    * \return WifiRemoteStation corresponding to the address
    */
   WifiRemoteStation* Lookup (Mac48Address address, const WifiMacHeader *header) const;
+  /**
+   * Return the key of a station in the indexes of the known stations.
+   *
+   * \param address the address of the station
+   * \param tid the TID
+   *
+   * \return the address in the 48 most significant bits and the TID in
+   *         the 8 least significant bits
+   */
+  static uint64_t GetStationKey (Mac48Address address, uint8_t tid);
 
   /**
    * Return whether the modulation class of the selected mode for the
@@ -1426,6 +1441,11 @@ private:
 
   StationStates m_states;  //!< States of known stations
   Stations m_stations;     //!< Information for each known stations
+  /// States of known stations, indexed by address (see GetStationKey)
+  std::unordered_map<uint64_t, WifiRemoteStationState *> m_stateIndex;
+  /// Known stations, indexed by address and TID (see GetStationKey)
+  std::unordered_map<uint64_t, WifiRemoteStation *> m_stationIndex;
+  mutable WifiRemoteStation *m_lastStation; //!< the station returned by the last Lookup
 
   WifiMode m_defaultTxMode; //!< The default transmission mode
   WifiMode m_defaultTxMcs;   //!< The default transmission modulation-coding scheme (MCS)
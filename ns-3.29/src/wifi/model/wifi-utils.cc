@@ -135,6 +135,23 @@ IsInWindow (uint16_t seq, uint16_t winstart, uint16_t winsize)
   return ((seq - winstart + 4096) % 4096) < winsize;
 }
 
+uint8_t
+CountTrailingZeros (uint64_t word)
+{
+  NS_ASSERT (word != 0);
+#if defined (__GNUC__)
+  return __builtin_ctzll (word);
+#else
+  uint8_t n = 0;
+  while ((word & 1) == 0)
+    {
+      word >>= 1;
+      n++;
+    }
+  return n;
+#endif
+}
+
 void
 AddWifiMacTrailer (Ptr<Packet> packet)
 {
@@ -116,6 +116,11 @@ uint32_t GetCtsSize (void);
  * This method checks if the MPDU's sequence number is inside the scoreboard boundaries or not
  */
 bool IsInWindow (uint16_t seq, uint16_t winstart, uint16_t winsize);
+/**
+ * \param word a non-null word of a bitmap
+ * \returns the number of trailing zero bits of the word, i.e., the index of its first bit set
+ */
+uint8_t CountTrailingZeros (uint64_t word);
 /**
  * Add FCS trailer to a packet.
  *
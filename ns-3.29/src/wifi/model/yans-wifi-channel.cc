@@ -30,6 +30,7 @@
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
 #include "wifi-utils.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -65,6 +66,8 @@ YansWifiChannel::~YansWifiChannel ()
 {
   NS_LOG_FUNCTION (this);
   m_phyList.clear ();
+  m_phyChannels.clear ();
+  m_channelPhys.clear ();
 }
 
 void
@@ -87,16 +90,18 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
   NS_LOG_FUNCTION (this << sender << packet << txPowerDbm << duration.GetSeconds ());
   Ptr<MobilityModel> senderMobility = sender->GetMobility ();
   NS_ASSERT (senderMobility != 0);
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+  //For now don't account for inter channel interference nor channel bonding
+  ChannelPhysMap::const_iterator bucket = m_channelPhys.find (sender->GetChannelNumber ());
+  if (bucket == m_channelPhys.end ())
     {
+      return;
+    }
+  for (std::vector<std::size_t>::const_iterator it = bucket->second.begin (); it != bucket->second.end (); it++)
+    {
+      PhyList::const_iterator i = m_phyList.begin () + *it;
+      NS_ASSERT ((*i)->GetChannelNumber () == sender->GetChannelNumber ());
       if (sender != (*i))
         {
-          //For now don't account for inter channel interference nor channel bonding
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
-            {
-              continue;
-            }
-
           Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
           Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
           double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
@@ -144,9 +149,37 @@ void
 YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
 {
   NS_LOG_FUNCTION (this << phy);
+  uint8_t channelNumber = phy->GetChannelNumber ();
+  m_phyChannels[phy] = std::make_pair (channelNumber, m_phyList.size ());
+  // the index of the new PHY is the largest one
+  m_channelPhys[channelNumber].push_back (m_phyList.size ());
   m_phyList.push_back (phy);
 }
 
+void
+YansWifiChannel::NotifyChannelNumberChange (Ptr<YansWifiPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  PhyChannelMap::iterator it = m_phyChannels.find (phy);
+  NS_ASSERT (it != m_phyChannels.end ());
+  uint8_t channelNumber = phy->GetChannelNumber ();
+  if (it->second.first == channelNumber)
+    {
+      return;
+    }
+  NS_LOG_DEBUG ("PHY " << phy << " moved from channel " << +it->second.first << " to channel " << +channelNumber);
+  std::size_t index = it->second.second;
+  std::vector<std::size_t> &from = m_channelPhys[it->second.first];
+  from.erase (std::lower_bound (from.begin (), from.end (), index));
+  if (from.empty ())
+    {
+      m_channelPhys.erase (it->second.first);
+    }
+  std::vector<std::size_t> &to = m_channelPhys[channelNumber];
+  to.insert (std::lower_bound (to.begin (), to.end (), index), index);
+  it->second.first = channelNumber;
+}
+
 int64_t
 YansWifiChannel::AssignStreams (int64_t stream)
 {
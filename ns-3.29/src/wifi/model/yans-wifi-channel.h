@@ -22,6 +22,7 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include <map>
 
 namespace ns3 {
 
@@ -40,6 +41,10 @@ class Time;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * A packet is only delivered to the PHYs tuned to the channel number of
+ * the sender: the PHYs are kept in a bucket per channel number, which is
+ * updated when a PHY notifies a channel number change.
  */
 class YansWifiChannel : public Channel
 {
@@ -63,6 +68,14 @@ public:
    * \param phy the YansWifiPhy to be added to the PHY list
    */
   void Add (Ptr<YansWifiPhy> phy);
+  /**
+   * Move the given YansWifiPhy to the bucket of its current channel
+   * number. This method is invoked by the YansWifiPhy when its channel
+   * number may have changed.
+   *
+   * \param phy the YansWifiPhy
+   */
+  void NotifyChannelNumberChange (Ptr<YansWifiPhy> phy);
 
   /**
    * \param loss the new propagation loss model.
@@ -82,7 +95,8 @@ public:
    * This method should not be invoked by normal users. It is
    * currently invoked only from YansWifiPhy::StartTx.  The channel
    * attempts to deliver the packet to all other YansWifiPhy objects
-   * on the channel (except for the sender).
+   * on the channel (except for the sender) which are tuned to the
+   * channel number of the sender.
    */
   void Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm, Time duration) const;
 
@@ -103,6 +117,15 @@ private:
    * A vector of pointers to YansWifiPhy.
    */
   typedef std::vector<Ptr<YansWifiPhy> > PhyList;
+  /**
+   * The channel number of each YansWifiPhy, and its index in the PHY list.
+   */
+  typedef std::map<Ptr<YansWifiPhy>, std::pair<uint8_t, std::size_t> > PhyChannelMap;
+  /**
+   * The indices in the PHY list of the YansWifiPhys tuned to each channel
+   * number, in increasing order.
+   */
+  typedef std::map<uint8_t, std::vector<std::size_t> > ChannelPhysMap;
 
   /**
    * This method is scheduled by Send for each associated YansWifiPhy.
@@ -117,6 +140,8 @@ private:
   static void Receive (Ptr<YansWifiPhy> receiver, Ptr<Packet> packet, double txPowerDbm, Time duration);
 
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
+  PhyChannelMap m_phyChannels;         //!< Channel number of each YansWifiPhy
+  ChannelPhysMap m_channelPhys;        //!< YansWifiPhys tuned to each channel number
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
 };
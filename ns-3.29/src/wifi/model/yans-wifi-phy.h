@@ -74,6 +74,13 @@ public:
 
   virtual Ptr<Channel> GetChannel (void) const;
 
+  // The following two methods call to the base WifiPhy class method
+  // but also notify the YansWifiChannel of the channel number change
+
+  virtual void SetChannelNumber (uint8_t id);
+
+  virtual void SetFrequency (uint16_t freq);
+
 
 protected:
   // Inherited
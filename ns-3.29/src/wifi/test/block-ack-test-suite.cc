@@ -21,6 +21,8 @@
 #include "ns3/test.h"
 #include "ns3/qos-utils.h"
 #include "ns3/ctrl-headers.h"
+#include "ns3/block-ack-cache.h"
+#include "ns3/wifi-mac-header.h"
 
 using namespace ns3;
 
@@ -306,6 +308,111 @@ CtrlBAckResponseHeaderTest::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_blockAckHdr.IsPacketReceived (80), false, "error in compressed bitmap");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test for the block ack cache
+ *
+ * The window of the cache is moved by received packets and block ack
+ * requests, across the wrap around of the sequence numbers, and the
+ * bitmaps of the block acks are checked.
+ */
+class BlockAckCacheTest : public TestCase
+{
+public:
+  BlockAckCacheTest ();
+private:
+  virtual void DoRun ();
+  /**
+   * Update the cache with a received packet.
+   * \param seq the sequence number of the packet
+   * \param frag the fragment number of the packet
+   */
+  void ReceivePacket (uint16_t seq, uint8_t frag);
+  /**
+   * Fill a compressed block ack with the cache.
+   * \param startingSeq the starting sequence of the block ack
+   * \return the compressed bitmap of the block ack
+   */
+  uint64_t GetBitmap (uint16_t startingSeq);
+  BlockAckCache m_cache; ///< the block ack cache
+};
+
+BlockAckCacheTest::BlockAckCacheTest ()
+  : TestCase ("Check the block ack cache windows")
+{
+}
+
+void
+BlockAckCacheTest::ReceivePacket (uint16_t seq, uint8_t frag)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetSequenceNumber (seq);
+  hdr.SetFragmentNumber (frag);
+  m_cache.UpdateWithMpdu (&hdr);
+}
+
+uint64_t
+BlockAckCacheTest::GetBitmap (uint16_t startingSeq)
+{
+  CtrlBAckResponseHeader blockAck;
+  blockAck.SetType (COMPRESSED_BLOCK_ACK);
+  blockAck.SetStartingSequence (startingSeq);
+  m_cache.FillBlockAckBitmap (&blockAck);
+  return blockAck.GetCompressedBitmap ();
+}
+
+void
+BlockAckCacheTest::DoRun (void)
+{
+  //          4090       57
+  m_cache.Init (4090, 64);
+  ReceivePacket (4090, 0);
+  ReceivePacket (4092, 0);
+  ReceivePacket (5, 0);
+  NS_TEST_EXPECT_MSG_EQ (m_cache.GetWinStart (), 4090, "the window should not have moved");
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (4090), 0x0000000000000805LL, "error in compressed bitmap");
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (4092), 0x0000000000000201LL, "error in compressed bitmap");
+
+  //          4093       60
+  ReceivePacket (60, 0);
+  NS_TEST_EXPECT_MSG_EQ (m_cache.GetWinStart (), 4093, "the window should end at the last received packet");
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (4093), 0x8000000000000100LL, "error in compressed bitmap");
+  //the packets received before the window are still acknowledged
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (4090), 0x0000000000000805LL, "error in compressed bitmap");
+
+  //only the packets received unfragmented are acknowledged
+  ReceivePacket (4095, 1);
+  ReceivePacket (5, 1);
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (4093), 0x8000000000000000LL, "error in compressed bitmap");
+  //even if the first fragment is received after the other ones
+  ReceivePacket (4095, 0);
+  ReceivePacket (10, 1);
+  ReceivePacket (10, 0);
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (4093), 0x8000000000000000LL, "error in compressed bitmap");
+
+  //          4094       61
+  m_cache.UpdateWithBlockAckReq (4094);
+  NS_TEST_EXPECT_MSG_EQ (m_cache.GetWinStart (), 4094, "the window should start at the requested sequence");
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (4094), 0x4000000000000000LL, "error in compressed bitmap");
+  //a request for older packets doesn't move the window
+  m_cache.UpdateWithBlockAckReq (4000);
+  NS_TEST_EXPECT_MSG_EQ (m_cache.GetWinStart (), 4094, "the window should not have moved");
+
+  //          100        163
+  m_cache.UpdateWithBlockAckReq (100);
+  NS_TEST_EXPECT_MSG_EQ (m_cache.GetWinStart (), 100, "the window should start at the requested sequence");
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (100), 0, "error in compressed bitmap");
+  ReceivePacket (163, 0);
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (100), 0x8000000000000000LL, "error in compressed bitmap");
+  //a window far ahead of the received packets
+  ReceivePacket (400, 0);
+  NS_TEST_EXPECT_MSG_EQ (m_cache.GetWinStart (), 337, "the window should end at the last received packet");
+  NS_TEST_EXPECT_MSG_EQ (GetBitmap (337), 0x8000000000000000LL, "error in compressed bitmap");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -324,6 +431,7 @@ BlockAckTestSuite::BlockAckTestSuite ()
   AddTestCase (new PacketBufferingCaseA, TestCase::QUICK);
   AddTestCase (new PacketBufferingCaseB, TestCase::QUICK);
   AddTestCase (new CtrlBAckResponseHeaderTest, TestCase::QUICK);
+  AddTestCase (new BlockAckCacheTest, TestCase::QUICK);
 }
 
 static BlockAckTestSuite g_blockAckTestSuite; ///< the test suite
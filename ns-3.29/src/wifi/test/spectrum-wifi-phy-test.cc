@@ -27,6 +27,7 @@
 #include "ns3/wifi-phy-tag.h"
 #include "ns3/wifi-spectrum-signal-parameters.h"
 #include "ns3/wifi-phy-listener.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 
 using namespace ns3;
@@ -308,6 +309,97 @@ SpectrumWifiPhyListenerTest::DoRun (void)
   delete m_listener;
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Spectrum Wifi Phy Frame Abstraction Test
+ *
+ * The packets of the basic test are received with the frame abstraction,
+ * along with a packet overlapped by a signal below the sensitivity, and
+ * the outcome of each reception is checked.
+ */
+class SpectrumWifiPhyFrameAbstractionTest : public SpectrumWifiPhyBasicTest
+{
+public:
+  SpectrumWifiPhyFrameAbstractionTest ();
+  virtual ~SpectrumWifiPhyFrameAbstractionTest ();
+private:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+  /**
+   * Spectrum wifi receive success function
+   * \param p the packet
+   * \param snr the SNR
+   * \param txVector the transmit vector
+   */
+  void RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector);
+  /**
+   * Spectrum wifi receive failure function
+   * \param p the packet
+   * \param snr the SNR
+   */
+  void RxFailure (Ptr<Packet> p, double snr);
+  uint32_t m_countRxSuccess; ///< count of successful receptions
+  uint32_t m_countRxFailure; ///< count of failed receptions
+};
+
+SpectrumWifiPhyFrameAbstractionTest::SpectrumWifiPhyFrameAbstractionTest ()
+  : SpectrumWifiPhyBasicTest ("SpectrumWifiPhy test case receives packets with the frame abstraction"),
+    m_countRxSuccess (0),
+    m_countRxFailure (0)
+{
+}
+
+SpectrumWifiPhyFrameAbstractionTest::~SpectrumWifiPhyFrameAbstractionTest ()
+{
+}
+
+void
+SpectrumWifiPhyFrameAbstractionTest::RxSuccess (Ptr<Packet> p, double snr, WifiTxVector txVector)
+{
+  NS_LOG_FUNCTION (this << p << snr << txVector);
+  m_countRxSuccess++;
+}
+
+void
+SpectrumWifiPhyFrameAbstractionTest::RxFailure (Ptr<Packet> p, double snr)
+{
+  NS_LOG_FUNCTION (this << p << snr);
+  m_countRxFailure++;
+}
+
+void
+SpectrumWifiPhyFrameAbstractionTest::DoSetup (void)
+{
+  SpectrumWifiPhyBasicTest::DoSetup ();
+  m_phy->SetAttribute ("FrameAbstraction", BooleanValue (true));
+  m_phy->SetReceiveOkCallback (MakeCallback (&SpectrumWifiPhyFrameAbstractionTest::RxSuccess, this));
+  m_phy->SetReceiveErrorCallback (MakeCallback (&SpectrumWifiPhyFrameAbstractionTest::RxFailure, this));
+}
+
+void
+SpectrumWifiPhyFrameAbstractionTest::DoRun (void)
+{
+  double txPowerWatts = 0.010;
+  // Send packets spaced 1 second apart; all should be received
+  Simulator::Schedule (Seconds (1), &SpectrumWifiPhyFrameAbstractionTest::SendSignal, this, txPowerWatts);
+  Simulator::Schedule (Seconds (2), &SpectrumWifiPhyFrameAbstractionTest::SendSignal, this, txPowerWatts);
+  Simulator::Schedule (Seconds (3), &SpectrumWifiPhyFrameAbstractionTest::SendSignal, this, txPowerWatts);
+  // Send packets spaced 1 microsecond second apart; the first one should
+  // fail because of the interference of the second one, which is dropped
+  Simulator::Schedule (MicroSeconds (4000000), &SpectrumWifiPhyFrameAbstractionTest::SendSignal, this, txPowerWatts);
+  Simulator::Schedule (MicroSeconds (4000001), &SpectrumWifiPhyFrameAbstractionTest::SendSignal, this, txPowerWatts);
+  // Send a packet overlapped by a signal 100 dB weaker; it should be received
+  Simulator::Schedule (MicroSeconds (5000000), &SpectrumWifiPhyFrameAbstractionTest::SendSignal, this, txPowerWatts);
+  Simulator::Schedule (MicroSeconds (5000100), &SpectrumWifiPhyFrameAbstractionTest::SendSignal, this, txPowerWatts * 1e-10);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_countRxSuccess, 4, "Didn't receive right number of packets");
+  NS_TEST_ASSERT_MSG_EQ (m_countRxFailure, 1, "Didn't fail to receive right number of packets");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -325,6 +417,7 @@ SpectrumWifiPhyTestSuite::SpectrumWifiPhyTestSuite ()
 {
   AddTestCase (new SpectrumWifiPhyBasicTest, TestCase::QUICK);
   AddTestCase (new SpectrumWifiPhyListenerTest, TestCase::QUICK);
+  AddTestCase (new SpectrumWifiPhyFrameAbstractionTest, TestCase::QUICK);
 }
 
 static SpectrumWifiPhyTestSuite spectrumWifiPhyTestSuite; ///< the test suite
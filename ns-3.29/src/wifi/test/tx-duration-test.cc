@@ -426,6 +426,164 @@ TxDurationTest::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (retval, true, "an 802.11ax duration failed");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Tx Duration Cache Test
+ *
+ * The parameters of the computation of the durations are stored by
+ * WifiPhy for each TXVECTOR: this test checks that the durations given
+ * by a PHY which already computed the durations of many TXVECTORs are
+ * the same as those given by a new PHY, for single MPDUs and A-MPDUs.
+ */
+class TxDurationCacheTest : public TestCase
+{
+public:
+  TxDurationCacheTest ();
+  virtual ~TxDurationCacheTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Compute the durations of the transmission of an MPDU and of an A-MPDU.
+   *
+   * \param phy the PHY computing the durations
+   * \param txVector the TXVECTOR used for the transmission
+   * \param frequency the channel center frequency (MHz)
+   * \param size the size of the MPDUs
+   *
+   * \return the durations
+   */
+  std::vector<Time> GetDurations (Ptr<WifiPhy> phy, WifiTxVector txVector, uint16_t frequency, uint32_t size);
+};
+
+TxDurationCacheTest::TxDurationCacheTest ()
+  : TestCase ("Durations computed with the stored parameters of the TXVECTORs")
+{
+}
+
+TxDurationCacheTest::~TxDurationCacheTest ()
+{
+}
+
+std::vector<Time>
+TxDurationCacheTest::GetDurations (Ptr<WifiPhy> phy, WifiTxVector txVector, uint16_t frequency, uint32_t size)
+{
+  std::vector<Time> durations;
+  durations.push_back (phy->CalculateTxDuration (size, txVector, frequency));
+  durations.push_back (phy->GetPayloadDuration (size, txVector, frequency));
+  WifiModulationClass modClass = txVector.GetMode ().GetModulationClass ();
+  if (modClass == WIFI_MOD_CLASS_HT || modClass == WIFI_MOD_CLASS_VHT || modClass == WIFI_MOD_CLASS_HE)
+    {
+      WifiPreamble preamble = txVector.GetPreambleType ();
+      durations.push_back (phy->CalculateTxDuration (size, txVector, frequency, MPDU_IN_AGGREGATE, 1));
+      txVector.SetPreambleType (WIFI_PREAMBLE_NONE);
+      durations.push_back (phy->CalculateTxDuration (size + 7, txVector, frequency, MPDU_IN_AGGREGATE, 1));
+      durations.push_back (phy->CalculateTxDuration (size + 3, txVector, frequency, LAST_MPDU_IN_AGGREGATE, 1));
+      txVector.SetPreambleType (preamble);
+    }
+  return durations;
+}
+
+void
+TxDurationCacheTest::DoRun (void)
+{
+  std::vector<WifiTxVector> txVectors;
+  WifiTxVector txVector;
+  txVector.SetNss (1);
+  txVector.SetNess (0);
+  txVector.SetStbc (0);
+  txVector.SetGuardInterval (800);
+  txVector.SetChannelWidth (22);
+  for (WifiPreamble preamble : {WIFI_PREAMBLE_LONG, WIFI_PREAMBLE_SHORT})
+    {
+      txVector.SetPreambleType (preamble);
+      txVector.SetMode (WifiPhy::GetDsssRate1Mbps ());
+      txVectors.push_back (txVector);
+      txVector.SetMode (WifiPhy::GetDsssRate11Mbps ());
+      txVectors.push_back (txVector);
+    }
+  txVector.SetPreambleType (WIFI_PREAMBLE_LONG);
+  txVector.SetChannelWidth (20);
+  txVector.SetMode (WifiPhy::GetErpOfdmRate54Mbps ());
+  txVectors.push_back (txVector);
+  txVector.SetMode (WifiPhy::GetOfdmRate54Mbps ());
+  txVectors.push_back (txVector);
+  txVector.SetChannelWidth (10);
+  txVector.SetMode (WifiPhy::GetOfdmRate27MbpsBW10MHz ());
+  txVectors.push_back (txVector);
+  txVector.SetChannelWidth (5);
+  txVector.SetMode (WifiPhy::GetOfdmRate13_5MbpsBW5MHz ());
+  txVectors.push_back (txVector);
+  for (uint16_t channelWidth : {20, 40})
+    {
+      txVector.SetChannelWidth (channelWidth);
+      for (uint16_t guardInterval : {400, 800})
+        {
+          txVector.SetGuardInterval (guardInterval);
+          for (WifiPreamble preamble : {WIFI_PREAMBLE_HT_MF, WIFI_PREAMBLE_HT_GF})
+            {
+              txVector.SetPreambleType (preamble);
+              txVector.SetMode (WifiPhy::GetHtMcs7 ());
+              txVector.SetStbc (1);
+              txVectors.push_back (txVector);
+              txVector.SetStbc (0);
+              txVectors.push_back (txVector);
+              txVector.SetMode (WifiPhy::GetHtMcs23 ());
+              txVector.SetNss (3);
+              txVectors.push_back (txVector);
+              txVector.SetNss (1);
+            }
+        }
+    }
+  for (uint16_t channelWidth : {20, 40, 80, 160})
+    {
+      txVector.SetChannelWidth (channelWidth);
+      for (uint8_t nss : {1, 2})
+        {
+          txVector.SetNss (nss);
+          for (uint16_t guardInterval : {400, 800})
+            {
+              txVector.SetGuardInterval (guardInterval);
+              txVector.SetPreambleType (WIFI_PREAMBLE_VHT);
+              txVector.SetMode (WifiPhy::GetVhtMcs7 ());
+              txVectors.push_back (txVector);
+            }
+          for (uint16_t guardInterval : {800, 1600, 3200})
+            {
+              txVector.SetGuardInterval (guardInterval);
+              txVector.SetPreambleType (WIFI_PREAMBLE_HE_SU);
+              txVector.SetMode (WifiPhy::GetHeMcs11 ());
+              txVectors.push_back (txVector);
+            }
+        }
+    }
+
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  // the second pass uses the parameters stored in the first one
+  for (uint8_t pass = 0; pass < 2; ++pass)
+    {
+      for (const auto &tx : txVectors)
+        {
+          for (uint16_t frequency : {CHANNEL_1_MHZ, CHANNEL_36_MHZ})
+            {
+              for (uint32_t size : {14, 1536, 65535})
+                {
+                  Ptr<YansWifiPhy> newPhy = CreateObject<YansWifiPhy> ();
+                  std::vector<Time> expected = GetDurations (newPhy, tx, frequency, size);
+                  std::vector<Time> durations = GetDurations (phy, tx, frequency, size);
+                  for (std::size_t i = 0; i < expected.size (); ++i)
+                    {
+                      NS_TEST_EXPECT_MSG_EQ (durations[i], expected[i], "wrong duration " << i << " for " << tx
+                                             << " at " << frequency << " MHz, size " << size << " and pass " << +pass);
+                    }
+                }
+            }
+        }
+    }
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -442,6 +600,7 @@ TxDurationTestSuite::TxDurationTestSuite ()
   : TestSuite ("devices-wifi-tx-duration", UNIT)
 {
   AddTestCase (new TxDurationTest, TestCase::QUICK);
+  AddTestCase (new TxDurationCacheTest, TestCase::QUICK);
 }
 
 static TxDurationTestSuite g_txDurationTestSuite; ///< the test suite
@@ -21,8 +21,12 @@
 #include <cmath>
 #include "ns3/test.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/yans-error-rate-model.h"
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/wifi-tx-vector.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 
 using namespace ns3;
 
@@ -291,6 +295,106 @@ WifiErrorRateModelsTestCaseNist::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ_TOL (ps, 0.999, 0.001, "Not equal within tolerance");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Wifi Error Rate Models Test Case Tables
+ *
+ * Check that the chunk success rates derived from the tables of the bit
+ * error rate are close to the ones computed by the models.
+ */
+class WifiErrorRateModelsTestCaseTables : public TestCase
+{
+public:
+  WifiErrorRateModelsTestCaseTables ();
+  virtual ~WifiErrorRateModelsTestCaseTables ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Compare the chunk success rates of a model with and without tables.
+   *
+   * \param exact the model computing the chunk success rates
+   * \param tables the same model, using tables
+   * \param mode the mode of the chunks
+   * \param txVector the TXVECTOR of the transmission
+   */
+  void CheckModel (Ptr<ErrorRateModel> exact, Ptr<ErrorRateModel> tables, WifiMode mode, WifiTxVector txVector);
+};
+
+WifiErrorRateModelsTestCaseTables::WifiErrorRateModelsTestCaseTables ()
+  : TestCase ("WifiErrorRateModel test case tables")
+{
+}
+
+WifiErrorRateModelsTestCaseTables::~WifiErrorRateModelsTestCaseTables ()
+{
+}
+
+void
+WifiErrorRateModelsTestCaseTables::CheckModel (Ptr<ErrorRateModel> exact, Ptr<ErrorRateModel> tables, WifiMode mode, WifiTxVector txVector)
+{
+  uint64_t sizes[] = {1, 200, 12000, 80000};
+  for (double snr = -5.0; snr < 50.0; snr += 0.17)
+    {
+      for (uint32_t i = 0; i < 4; i++)
+        {
+          double expected = exact->GetChunkSuccessRate (mode, txVector, std::pow (10.0, snr / 10.0), sizes[i]);
+          double ps = tables->GetChunkSuccessRate (mode, txVector, std::pow (10.0, snr / 10.0), sizes[i]);
+          NS_TEST_ASSERT_MSG_EQ_TOL (ps, expected, 0.0005, "Not equal within tolerance for " << mode
+                                     << " at " << snr << " dB and " << sizes[i] << " bits");
+        }
+    }
+}
+
+void
+WifiErrorRateModelsTestCaseTables::DoRun (void)
+{
+  Ptr<NistErrorRateModel> nist = CreateObject<NistErrorRateModel> ();
+  Ptr<NistErrorRateModel> nistTables = CreateObject<NistErrorRateModel> ();
+  nistTables->SetAttribute ("UseTables", BooleanValue (true));
+  Ptr<YansErrorRateModel> yans = CreateObject<YansErrorRateModel> ();
+  Ptr<YansErrorRateModel> yansTables = CreateObject<YansErrorRateModel> ();
+  yansTables->SetAttribute ("UseTables", BooleanValue (true));
+
+  WifiTxVector txVector;
+  WifiMode modes[] = {WifiPhy::GetDsssRate1Mbps (), WifiPhy::GetDsssRate2Mbps (),
+                      WifiPhy::GetDsssRate5_5Mbps (), WifiPhy::GetDsssRate11Mbps (),
+                      WifiPhy::GetOfdmRate6Mbps (), WifiPhy::GetOfdmRate9Mbps (),
+                      WifiPhy::GetOfdmRate12Mbps (), WifiPhy::GetOfdmRate18Mbps (),
+                      WifiPhy::GetOfdmRate24Mbps (), WifiPhy::GetOfdmRate36Mbps (),
+                      WifiPhy::GetOfdmRate48Mbps (), WifiPhy::GetOfdmRate54Mbps ()};
+  for (uint32_t i = 0; i < 12; i++)
+    {
+      CheckModel (nist, nistTables, modes[i], txVector);
+      CheckModel (yans, yansTables, modes[i], txVector);
+    }
+  txVector.SetChannelWidth (40);
+  txVector.SetGuardInterval (400);
+  WifiMode htModes[] = {WifiPhy::GetHtMcs0 (), WifiPhy::GetHtMcs1 (), WifiPhy::GetHtMcs2 (), WifiPhy::GetHtMcs3 (),
+                        WifiPhy::GetHtMcs4 (), WifiPhy::GetHtMcs5 (), WifiPhy::GetHtMcs6 (), WifiPhy::GetHtMcs7 ()};
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      CheckModel (nist, nistTables, htModes[i], txVector);
+      CheckModel (yans, yansTables, htModes[i], txVector);
+    }
+  txVector.SetChannelWidth (80);
+  txVector.SetGuardInterval (800);
+  txVector.SetNss (2);
+  CheckModel (nist, nistTables, WifiPhy::GetVhtMcs8 (), txVector);
+  CheckModel (yans, yansTables, WifiPhy::GetVhtMcs8 (), txVector);
+  CheckModel (nist, nistTables, WifiPhy::GetVhtMcs9 (), txVector);
+  CheckModel (yans, yansTables, WifiPhy::GetVhtMcs9 (), txVector);
+
+  // the tables already computed are dropped when their grid changes
+  nistTables->SetAttribute ("TableMinSnr", DoubleValue (-10.0));
+  nistTables->SetAttribute ("TableResolution", DoubleValue (0.02));
+  yansTables->SetAttribute ("TableMaxSnr", DoubleValue (30.0));
+  CheckModel (nist, nistTables, WifiPhy::GetVhtMcs8 (), txVector);
+  CheckModel (yans, yansTables, WifiPhy::GetVhtMcs8 (), txVector);
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -308,6 +412,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite ()
 {
   AddTestCase (new WifiErrorRateModelsTestCaseDsss, TestCase::QUICK);
   AddTestCase (new WifiErrorRateModelsTestCaseNist, TestCase::QUICK);
+  AddTestCase (new WifiErrorRateModelsTestCaseTables, TestCase::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite; ///< the test suite
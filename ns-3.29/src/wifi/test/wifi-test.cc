@@ -28,6 +28,7 @@
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/ap-wifi-mac.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
 #include "ns3/yans-error-rate-model.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/test.h"
@@ -43,6 +44,11 @@
 #include "ns3/wifi-phy-tag.h"
 #include "ns3/yans-wifi-phy.h"
 #include "ns3/mgt-headers.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/qos-blocked-destinations.h"
+#include "ns3/ampdu-subframe-header.h"
 
 using namespace ns3;
 
@@ -363,6 +369,568 @@ InterferenceHelperSequenceTest::DoRun (void)
 }
 
 
+/**
+ * Check the received powers tracked by the InterferenceHelper: the
+ * noise and interference at the start of overlapping signals and the
+ * duration of the energy above a threshold, including after a long
+ * sequence of signals.
+ */
+class InterferenceHelperPowerTest : public TestCase
+{
+public:
+  InterferenceHelperPowerTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Add a signal to the interference helper.
+   * \param duration the duration of the signal
+   * \param rxPowerW the received power (W)
+   */
+  void AddSignal (Time duration, double rxPowerW);
+  /**
+   * Check the SNR at the start of the last signal which has been added.
+   * \param interferenceW the expected interference power (W)
+   */
+  void CheckSnr (double interferenceW);
+  /**
+   * Check the duration of the energy above a threshold.
+   * \param energyW the threshold (W)
+   * \param expected the expected duration
+   */
+  void CheckEnergyDuration (double energyW, Time expected);
+
+  InterferenceHelper m_interference; ///< the interference helper
+  Ptr<Event> m_event;                ///< the last signal which has been added
+  double m_noiseW;                   ///< the noise power (W)
+};
+
+InterferenceHelperPowerTest::InterferenceHelperPowerTest ()
+  : TestCase ("InterferenceHelperPower")
+{
+}
+
+void
+InterferenceHelperPowerTest::AddSignal (Time duration, double rxPowerW)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  txVector.SetPreambleType (WIFI_PREAMBLE_LONG);
+  m_event = m_interference.Add (Create<Packet> (), txVector, duration, rxPowerW);
+}
+
+void
+InterferenceHelperPowerTest::CheckSnr (double interferenceW)
+{
+  double snr = m_interference.CalculatePlcpHeaderSnrPer (m_event).snr;
+  NS_TEST_EXPECT_MSG_EQ_TOL (snr, m_event->GetRxPowerW () / (m_noiseW + interferenceW),
+                             snr * 1e-9, "wrong SNR at " << Simulator::Now ());
+}
+
+void
+InterferenceHelperPowerTest::CheckEnergyDuration (double energyW, Time expected)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_interference.GetEnergyDuration (energyW), expected,
+                         "wrong energy duration at " << Simulator::Now ());
+}
+
+void
+InterferenceHelperPowerTest::DoRun (void)
+{
+  m_interference.SetNoiseFigure (1);
+  m_interference.SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+  // thermal noise in 20 MHz, as computed by the interference helper
+  m_noiseW = 1.3803e-23 * 290 * 20e6;
+
+  // three overlapping signals: A [0, 100us), B [10us, 40us) and C [20us, 220us)
+  Simulator::Schedule (MicroSeconds (0), &InterferenceHelperPowerTest::AddSignal, this, MicroSeconds (100), 1e-9);
+  Simulator::Schedule (MicroSeconds (0), &InterferenceHelperPowerTest::CheckSnr, this, 0);
+  Simulator::Schedule (MicroSeconds (10), &InterferenceHelperPowerTest::AddSignal, this, MicroSeconds (30), 2e-10);
+  Simulator::Schedule (MicroSeconds (10), &InterferenceHelperPowerTest::CheckSnr, this, 1e-9);
+  Simulator::Schedule (MicroSeconds (20), &InterferenceHelperPowerTest::AddSignal, this, MicroSeconds (200), 5e-10);
+  Simulator::Schedule (MicroSeconds (20), &InterferenceHelperPowerTest::CheckSnr, this, 1.2e-9);
+  Simulator::Schedule (MicroSeconds (20), &InterferenceHelperPowerTest::CheckEnergyDuration, this, 1.6e-9, MicroSeconds (20));
+  Simulator::Schedule (MicroSeconds (20), &InterferenceHelperPowerTest::CheckEnergyDuration, this, 6e-10, MicroSeconds (80));
+  Simulator::Schedule (MicroSeconds (20), &InterferenceHelperPowerTest::CheckEnergyDuration, this, 1e-10, MicroSeconds (200));
+  Simulator::Schedule (MicroSeconds (50), &InterferenceHelperPowerTest::CheckEnergyDuration, this, 1.6e-9, MicroSeconds (0));
+  // a signal starting when another one ends
+  Simulator::Schedule (MicroSeconds (100), &InterferenceHelperPowerTest::AddSignal, this, MicroSeconds (50), 1e-9);
+  Simulator::Schedule (MicroSeconds (100), &InterferenceHelperPowerTest::CheckSnr, this, 5e-10);
+  // a signal after all the others have ended
+  Simulator::Schedule (MicroSeconds (1000), &InterferenceHelperPowerTest::AddSignal, this, MicroSeconds (10), 1e-9);
+  Simulator::Schedule (MicroSeconds (1000), &InterferenceHelperPowerTest::CheckSnr, this, 0);
+  Simulator::Schedule (MicroSeconds (1000), &InterferenceHelperPowerTest::CheckEnergyDuration, this, 1e-10, MicroSeconds (10));
+  // a long sequence of signals overlapping their predecessor
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      Simulator::Schedule (MicroSeconds (2000 + 5 * i), &InterferenceHelperPowerTest::AddSignal, this,
+                           MicroSeconds (8), (i % 2 == 0) ? 1e-9 : 3e-9);
+    }
+  Simulator::Schedule (MicroSeconds (6996), &InterferenceHelperPowerTest::CheckSnr, this, 1e-9);
+  Simulator::Schedule (MicroSeconds (6996), &InterferenceHelperPowerTest::CheckEnergyDuration, this, 3.5e-9, MicroSeconds (2));
+  Simulator::Schedule (MicroSeconds (6996), &InterferenceHelperPowerTest::CheckEnergyDuration, this, 1e-10, MicroSeconds (7));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Check that YansWifiChannel only delivers the packets to the PHYs tuned
+ * to the channel number of the sender, when the PHYs switch channels by
+ * channel number or by frequency.
+ */
+class YansWifiChannelPartitionTest : public TestCase
+{
+public:
+  YansWifiChannelPartitionTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Send a packet.
+   * \param phy the sending PHY
+   */
+  void Send (Ptr<YansWifiPhy> phy);
+  /**
+   * Count the packets received by a PHY.
+   * \param context the index of the PHY
+   * \param packet the packet
+   */
+  void NotifyRxBegin (std::string context, Ptr<const Packet> packet);
+  /**
+   * Check the number of packets received by each PHY.
+   * \param expected the expected numbers of packets
+   */
+  void CheckRx (std::vector<uint32_t> expected);
+
+  std::vector<uint32_t> m_rx; ///< the number of packets received by each PHY
+};
+
+YansWifiChannelPartitionTest::YansWifiChannelPartitionTest ()
+  : TestCase ("YansWifiChannel delivery to the PHYs tuned to the channel number of the sender")
+{
+}
+
+void
+YansWifiChannelPartitionTest::Send (Ptr<YansWifiPhy> phy)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  txVector.SetPreambleType (WIFI_PREAMBLE_LONG);
+  txVector.SetChannelWidth (20);
+  txVector.SetTxPowerLevel (0);
+  phy->SendPacket (Create<Packet> (1000), txVector);
+}
+
+void
+YansWifiChannelPartitionTest::NotifyRxBegin (std::string context, Ptr<const Packet> packet)
+{
+  m_rx[std::stoul (context)]++;
+}
+
+void
+YansWifiChannelPartitionTest::CheckRx (std::vector<uint32_t> expected)
+{
+  for (std::size_t i = 0; i < m_rx.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_rx[i], expected[i], "wrong number of packets received by PHY " << i
+                             << " at " << Simulator::Now ());
+    }
+}
+
+void
+YansWifiChannelPartitionTest::DoRun (void)
+{
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  Ptr<MatrixPropagationLossModel> loss = CreateObject<MatrixPropagationLossModel> ();
+  loss->SetDefaultLoss (50);
+  channel->SetPropagationLossModel (loss);
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+  // four PHYs on channel 36
+  std::vector<Ptr<YansWifiPhy> > phys;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (i, 0.0, 0.0));
+      phy->SetMobility (mobility);
+      phy->SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+      phy->SetChannel (channel);
+      phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+      std::ostringstream context;
+      context << i;
+      phy->TraceConnect ("PhyRxBegin", context.str (),
+                         MakeCallback (&YansWifiChannelPartitionTest::NotifyRxBegin, this));
+      phys.push_back (phy);
+    }
+  m_rx.assign (phys.size (), 0);
+  // PHY 2 is on channel 40 before the simulation starts
+  phys[2]->SetChannelNumber (40);
+  NS_TEST_ASSERT_MSG_EQ (+phys[2]->GetChannelNumber (), 40, "wrong channel number");
+
+  uint32_t rx1[] = {0, 1, 0, 1};
+  Simulator::Schedule (Seconds (1), &YansWifiChannelPartitionTest::Send, this, phys[0]);
+  Simulator::Schedule (Seconds (1.5), &YansWifiChannelPartitionTest::CheckRx, this,
+                       std::vector<uint32_t> (rx1, rx1 + 4));
+  // alone on channel 40
+  Simulator::Schedule (Seconds (2), &YansWifiChannelPartitionTest::Send, this, phys[2]);
+  Simulator::Schedule (Seconds (2.5), &YansWifiChannelPartitionTest::CheckRx, this,
+                       std::vector<uint32_t> (rx1, rx1 + 4));
+  // PHY 1 switches to channel 40
+  Simulator::Schedule (Seconds (3), &YansWifiPhy::SetChannelNumber, phys[1], 40);
+  uint32_t rx2[] = {0, 2, 0, 1};
+  Simulator::Schedule (Seconds (4), &YansWifiChannelPartitionTest::Send, this, phys[2]);
+  Simulator::Schedule (Seconds (4.5), &YansWifiChannelPartitionTest::CheckRx, this,
+                       std::vector<uint32_t> (rx2, rx2 + 4));
+  uint32_t rx3[] = {0, 2, 0, 2};
+  Simulator::Schedule (Seconds (5), &YansWifiChannelPartitionTest::Send, this, phys[0]);
+  Simulator::Schedule (Seconds (5.5), &YansWifiChannelPartitionTest::CheckRx, this,
+                       std::vector<uint32_t> (rx3, rx3 + 4));
+  // PHY 3 switches to the frequency of channel 40
+  Simulator::Schedule (Seconds (6), &YansWifiPhy::SetFrequency, phys[3], 5200);
+  uint32_t rx4[] = {0, 3, 0, 3};
+  Simulator::Schedule (Seconds (7), &YansWifiChannelPartitionTest::Send, this, phys[2]);
+  Simulator::Schedule (Seconds (7.5), &YansWifiChannelPartitionTest::CheckRx, this,
+                       std::vector<uint32_t> (rx4, rx4 + 4));
+  // PHY 0 is alone on channel 36
+  Simulator::Schedule (Seconds (8), &YansWifiChannelPartitionTest::Send, this, phys[0]);
+  Simulator::Schedule (Seconds (8.5), &YansWifiChannelPartitionTest::CheckRx, this,
+                       std::vector<uint32_t> (rx4, rx4 + 4));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Check the frames returned by the WifiMacQueue methods looking for
+ * the frames to a receiver, with a TID, or which are not blocked, their
+ * number and size, and the removal of the frames which stayed in the
+ * queue for too long.
+ */
+class WifiMacQueueIndexTest : public TestCase
+{
+public:
+  WifiMacQueueIndexTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Enqueue a frame.
+   * \param type the type of the frame
+   * \param dest the receiver address
+   * \param tid the TID of a QoS data frame
+   * \param size the size of the packet
+   * \param front whether the frame is pushed at the front of the queue
+   * \return the packet of the frame
+   */
+  Ptr<const Packet> Enqueue (WifiMacType type, Mac48Address dest, uint8_t tid, uint32_t size, bool front = false);
+  /// Check the frames enqueued at the start
+  void CheckFrames (void);
+  /// Check the frames after the first ones stayed in the queue for too long
+  void CheckExpiry (void);
+
+  Ptr<WifiMacQueue> m_queue;               ///< the queue
+  Mac48Address m_sta1;                     ///< the first receiver
+  Mac48Address m_sta2;                     ///< the second receiver
+  std::vector<Ptr<const Packet> > m_packets; ///< the packets enqueued at the start
+};
+
+WifiMacQueueIndexTest::WifiMacQueueIndexTest ()
+  : TestCase ("WifiMacQueue indexes of the receivers and TIDs")
+{
+}
+
+Ptr<const Packet>
+WifiMacQueueIndexTest::Enqueue (WifiMacType type, Mac48Address dest, uint8_t tid, uint32_t size, bool front)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (type);
+  hdr.SetAddr1 (dest);
+  if (hdr.IsQosData ())
+    {
+      hdr.SetQosTid (tid);
+    }
+  Ptr<const Packet> packet = Create<Packet> (size);
+  Ptr<WifiMacQueueItem> item = Create<WifiMacQueueItem> (packet, hdr);
+  bool enqueued = front ? m_queue->PushFront (item) : m_queue->Enqueue (item);
+  NS_TEST_EXPECT_MSG_EQ (enqueued, true, "frame not enqueued");
+  return packet;
+}
+
+void
+WifiMacQueueIndexTest::CheckFrames (void)
+{
+  // queue: 0 beacon, 1 sta1/TID 0, 2 sta2/TID 0, 3 sta1/TID 5, 4 sta1 data,
+  // 5 sta1/TID 0, 6 sta2/TID 5; then 7 sta1/TID 0 pushed at the front
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (), 8, "wrong number of frames");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, m_sta1), 3, "wrong number of sta1/TID 0 frames");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (5, m_sta1), 1, "wrong number of sta1/TID 5 frames");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (3, m_sta1), 0, "wrong number of sta1/TID 3 frames");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByAddress (m_sta1), 5, "wrong number of sta1 data frames");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByAddress (m_sta2), 2, "wrong number of sta2 data frames");
+  uint32_t headerSize = m_queue->PeekByTidAndAddress (0, m_sta1)->GetHeader ().GetSerializedSize ();
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNBytesByTidAndAddress (0, m_sta1), 100 + 500 + 700 + 3 * headerSize,
+                         "wrong number of bytes of sta1/TID 0 frames");
+
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekByTidAndAddress (0, m_sta1)->GetPacket (), m_packets[7], "wrong first sta1/TID 0 frame");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekByTidAndAddress (5, m_sta2)->GetPacket (), m_packets[6], "wrong first sta2/TID 5 frame");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekByTidAndAddress (3, m_sta2), 0, "unexpected sta2/TID 3 frame");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->DequeueByTidAndAddress (0, m_sta1)->GetPacket (), m_packets[7], "wrong sta1/TID 0 frame");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->DequeueByTidAndAddress (0, m_sta1)->GetPacket (), m_packets[1], "wrong sta1/TID 0 frame");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, m_sta1), 1, "wrong number of sta1/TID 0 frames");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->DequeueByAddress (m_sta1)->GetPacket (), m_packets[3], "wrong sta1 data frame");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->DequeueByAddress (m_sta1)->GetPacket (), m_packets[4], "wrong sta1 data frame");
+
+  // queue: 0 beacon, 2 sta2/TID 0, 5 sta1/TID 0, 6 sta2/TID 5
+  Ptr<QosBlockedDestinations> blocked = Create<QosBlockedDestinations> ();
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekFirstAvailable (blocked)->GetPacket (), m_packets[0], "wrong first available frame");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->Remove (m_packets[0]), true, "beacon not removed");
+  blocked->Block (m_sta2, 0);
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekFirstAvailable (blocked)->GetPacket (), m_packets[5], "wrong first available frame");
+  blocked->Block (m_sta1, 0);
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekFirstAvailable (blocked)->GetPacket (), m_packets[6], "wrong first available frame");
+  blocked->Block (m_sta2, 5);
+  NS_TEST_EXPECT_MSG_EQ (m_queue->PeekFirstAvailable (blocked), 0, "unexpected available frame");
+  blocked->Unblock (m_sta1, 0);
+  NS_TEST_EXPECT_MSG_EQ (m_queue->DequeueFirstAvailable (blocked)->GetPacket (), m_packets[5], "wrong first available frame");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (), 2, "wrong number of frames");
+}
+
+void
+WifiMacQueueIndexTest::CheckExpiry (void)
+{
+  // the frames enqueued at the start expired, the ones enqueued later did not
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, m_sta2), 1, "expired sta2/TID 0 frame not removed");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPacketsByTidAndAddress (0, m_sta1), 1, "wrong number of sta1/TID 0 frames");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNBytesByTidAndAddress (5, m_sta2), 0, "expired sta2/TID 5 frame not removed");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (), 2, "wrong number of frames");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->Dequeue ()->GetHeader ().GetAddr1 (), m_sta2, "wrong first frame");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->Dequeue ()->GetHeader ().GetAddr1 (), m_sta1, "wrong first frame");
+  NS_TEST_EXPECT_MSG_EQ (m_queue->IsEmpty (), true, "the queue is not empty");
+}
+
+void
+WifiMacQueueIndexTest::DoRun (void)
+{
+  m_queue = CreateObject<WifiMacQueue> ();
+  m_queue->SetMaxDelay (MilliSeconds (10));
+  m_sta1 = Mac48Address ("00:00:00:00:00:01");
+  m_sta2 = Mac48Address ("00:00:00:00:00:02");
+
+  m_packets.push_back (Enqueue (WIFI_MAC_MGT_BEACON, Mac48Address::GetBroadcast (), 0, 10));
+  m_packets.push_back (Enqueue (WIFI_MAC_QOSDATA, m_sta1, 0, 100));
+  m_packets.push_back (Enqueue (WIFI_MAC_QOSDATA, m_sta2, 0, 200));
+  m_packets.push_back (Enqueue (WIFI_MAC_QOSDATA, m_sta1, 5, 300));
+  m_packets.push_back (Enqueue (WIFI_MAC_DATA, m_sta1, 0, 400));
+  m_packets.push_back (Enqueue (WIFI_MAC_QOSDATA, m_sta1, 0, 500));
+  m_packets.push_back (Enqueue (WIFI_MAC_QOSDATA, m_sta2, 5, 600));
+  m_packets.push_back (Enqueue (WIFI_MAC_QOSDATA, m_sta1, 0, 700, true));
+  CheckFrames ();
+
+  // two frames enqueued later, one of them pushed at the front
+  Simulator::Schedule (MilliSeconds (5), &WifiMacQueueIndexTest::Enqueue, this,
+                       WIFI_MAC_QOSDATA, m_sta1, 0, 800, false);
+  Simulator::Schedule (MilliSeconds (6), &WifiMacQueueIndexTest::Enqueue, this,
+                       WIFI_MAC_QOSDATA, m_sta2, 0, 900, true);
+  Simulator::Schedule (MilliSeconds (12), &WifiMacQueueIndexTest::CheckExpiry, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_queue = 0;
+}
+
+
+/**
+ * Check the data rates chosen by Minstrel and Minstrel-HT for two
+ * stations at different distances from the access point.
+ *
+ * The stations of a manager share its sample tables, and the first
+ * statistics update of each station happens at a random time when
+ * StaggerStatsUpdates is enabled. The data rate most used to each
+ * station once the statistics settled must be the same in both cases,
+ * and the same as the one chosen with the sample tables built for each
+ * station.
+ */
+class MinstrelRateChoiceTest : public TestCase
+{
+public:
+  MinstrelRateChoiceTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Run the scenario.
+   * \param manager the type of the remote station manager of the access point
+   * \param standard the standard
+   * \param stagger the value of the StaggerStatsUpdates attribute
+   * \return the name of the data mode most used to each station
+   */
+  std::vector<std::string> RunScenario (std::string manager, WifiPhyStandard standard, bool stagger);
+  /**
+   * Send a packet to each station, and schedule the next ones.
+   * \param ap the device of the access point
+   * \param stas the devices of the stations
+   */
+  void Send (Ptr<NetDevice> ap, NetDeviceContainer stas);
+  /**
+   * Count the data frames sent by the access point once the statistics settled.
+   * \param packet the packet
+   * \param channelFreqMhz the frequency of the channel
+   * \param txVector the TXVECTOR of the packet
+   * \param aMpdu the A-MPDU information of the packet
+   */
+  void PhyTx (Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector, MpduInfo aMpdu);
+
+  std::vector<Mac48Address> m_stas;                       ///< the addresses of the stations
+  std::vector<std::map<std::string, uint32_t> > m_modes;  ///< the number of data frames sent with each mode, by station
+};
+
+MinstrelRateChoiceTest::MinstrelRateChoiceTest ()
+  : TestCase ("Minstrel rate choice with shared sample tables and staggered updates")
+{
+}
+
+void
+MinstrelRateChoiceTest::Send (Ptr<NetDevice> ap, NetDeviceContainer stas)
+{
+  for (uint32_t i = 0; i < stas.GetN (); i++)
+    {
+      ap->Send (Create<Packet> (1000), stas.Get (i)->GetAddress (), 0);
+    }
+  Simulator::Schedule (MilliSeconds (2), &MinstrelRateChoiceTest::Send, this, ap, stas);
+}
+
+void
+MinstrelRateChoiceTest::PhyTx (Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector, MpduInfo aMpdu)
+{
+  if (Simulator::Now () < Seconds (1.5))
+    {
+      return;
+    }
+  Ptr<Packet> copy = packet->Copy ();
+  if (aMpdu.type != NORMAL_MPDU)
+    {
+      AmpduSubframeHeader subframe;
+      copy->RemoveHeader (subframe);
+    }
+  WifiMacHeader hdr;
+  copy->PeekHeader (hdr);
+  if (!hdr.IsData ())
+    {
+      return;
+    }
+  for (uint32_t i = 0; i < m_stas.size (); i++)
+    {
+      if (hdr.GetAddr1 () == m_stas[i])
+        {
+          m_modes[i][txVector.GetMode ().GetUniqueName ()]++;
+        }
+    }
+}
+
+std::vector<std::string>
+MinstrelRateChoiceTest::RunScenario (std::string manager, WifiPhyStandard standard, bool stagger)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  NodeContainer apNode;
+  apNode.Create (1);
+  NodeContainer staNodes;
+  staNodes.Create (2);
+
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  phy.SetChannel (channel.Create ());
+
+  WifiHelper wifi;
+  wifi.SetStandard (standard);
+  wifi.SetRemoteStationManager (manager,
+                                "StaggerStatsUpdates", BooleanValue (stagger));
+  Ssid ssid = Ssid ("minstrel-rate-choice");
+  WifiMacHelper mac;
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid));
+  NetDeviceContainer staDevices = wifi.Install (phy, mac, staNodes);
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid));
+  NetDeviceContainer apDevice = wifi.Install (phy, mac, apNode);
+  wifi.AssignStreams (NetDeviceContainer (apDevice, staDevices), 100);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (20.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (0.0, 40.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (apNode);
+  mobility.Install (staNodes);
+
+  m_stas.clear ();
+  for (uint32_t i = 0; i < staDevices.GetN (); i++)
+    {
+      m_stas.push_back (Mac48Address::ConvertFrom (staDevices.Get (i)->GetAddress ()));
+    }
+  m_modes.assign (m_stas.size (), std::map<std::string, uint32_t> ());
+  DynamicCast<WifiNetDevice> (apDevice.Get (0))->GetPhy ()->TraceConnectWithoutContext ("MonitorSnifferTx", MakeCallback (&MinstrelRateChoiceTest::PhyTx, this));
+
+  Simulator::Schedule (Seconds (0.5), &MinstrelRateChoiceTest::Send, this, apDevice.Get (0), staDevices);
+  Simulator::Stop (Seconds (2.5));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::vector<std::string> modes;
+  for (uint32_t i = 0; i < m_modes.size (); i++)
+    {
+      std::string mode;
+      uint32_t count = 0;
+      for (std::map<std::string, uint32_t>::const_iterator it = m_modes[i].begin (); it != m_modes[i].end (); it++)
+        {
+          if (it->second > count)
+            {
+              mode = it->first;
+              count = it->second;
+            }
+        }
+      modes.push_back (mode);
+    }
+  return modes;
+}
+
+void
+MinstrelRateChoiceTest::DoRun (void)
+{
+  // the rates chosen with the sample tables built for each station
+  const char *legacy[] = {"OfdmRate54Mbps", "OfdmRate24Mbps"};
+  const char *ht[] = {"HtMcs7", "HtMcs3"};
+
+  for (uint8_t stagger = 0; stagger < 2; stagger++)
+    {
+      std::vector<std::string> modes = RunScenario ("ns3::MinstrelWifiManager", WIFI_PHY_STANDARD_80211a, stagger);
+      for (uint32_t i = 0; i < modes.size (); i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (modes[i], legacy[i], "wrong Minstrel rate for station " << i << " (stagger " << +stagger << ")");
+        }
+      modes = RunScenario ("ns3::MinstrelHtWifiManager", WIFI_PHY_STANDARD_80211n_5GHZ, stagger);
+      for (uint32_t i = 0; i < modes.size (); i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (modes[i], ht[i], "wrong Minstrel-HT rate for station " << i << " (stagger " << +stagger << ")");
+        }
+    }
+}
+
+
 //-----------------------------------------------------------------------------
 /**
  * Make sure that when multiple broadcast packets are queued on the same
@@ -1708,6 +2276,10 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new WifiTest, TestCase::QUICK);
   AddTestCase (new QosUtilsIsOldPacketTest, TestCase::QUICK);
   AddTestCase (new InterferenceHelperSequenceTest, TestCase::QUICK); //Bug 991
+  AddTestCase (new InterferenceHelperPowerTest, TestCase::QUICK);
+  AddTestCase (new YansWifiChannelPartitionTest, TestCase::QUICK);
+  AddTestCase (new WifiMacQueueIndexTest, TestCase::QUICK);
+  AddTestCase (new MinstrelRateChoiceTest, TestCase::QUICK);
   AddTestCase (new DcfImmediateAccessBroadcastTestCase, TestCase::QUICK);
   AddTestCase (new Bug730TestCase, TestCase::QUICK); //Bug 730
   AddTestCase (new SetChannelFrequencyTest, TestCase::QUICK);
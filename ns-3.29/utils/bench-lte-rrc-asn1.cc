@@ -0,0 +1,335 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the ASN.1 encoding of the RRC messages used by
+// the real RRC protocol (ns3::LteRrcProtocolReal): each message type is
+// serialized into a packet and deserialized from it, in a loop.
+// Sample usage:  ./waf --run 'bench-lte-rrc-asn1 --iterations=100000'
+//
+// With --dump, the encoding of each message is printed in hexadecimal,
+// which allows to check that a change of the encoder does not change the
+// encoded messages. Each message is also checked to be encoded again
+// identically after being decoded.
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/lte-rrc-sap.h"
+#include "ns3/lte-rrc-header.h"
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+
+/**
+ * Get the bytes of a packet.
+ *
+ * \param packet the packet
+ * \return the bytes
+ */
+static std::vector<uint8_t>
+GetBytes (Ptr<Packet> packet)
+{
+  std::vector<uint8_t> bytes (packet->GetSize ());
+  if (!bytes.empty ())
+    {
+      packet->CopyData (&bytes[0], bytes.size ());
+    }
+  return bytes;
+}
+
+/**
+ * Benchmark the round trip of an RRC message through its header.
+ *
+ * \param name the name of the message
+ * \param msg the message
+ * \param iterations the number of round trips
+ * \param dump whether to print the encoded message
+ * \return true if the decoded message is encoded identically
+ */
+template <class H, class M>
+static bool
+BenchMessage (std::string name, M msg, uint32_t iterations, bool dump)
+{
+  H source;
+  source.SetMessage (msg);
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (source);
+  std::vector<uint8_t> encoded = GetBytes (packet);
+  H destination;
+  packet->RemoveHeader (destination);
+  H reencoded;
+  reencoded.SetMessage (destination.GetMessage ());
+  packet = Create<Packet> ();
+  packet->AddHeader (reencoded);
+  bool identical = (GetBytes (packet) == encoded);
+
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < iterations; ++i)
+    {
+      H header;
+      header.SetMessage (msg);
+      packet = Create<Packet> ();
+      packet->AddHeader (header);
+      H decoded;
+      packet->RemoveHeader (decoded);
+    }
+  int64_t elapsed = time.End ();
+
+  std::cout << std::left << std::setw (40) << name << std::right
+            << std::setw (5) << encoded.size () << " bytes "
+            << std::setw (10) << std::fixed << std::setprecision (3)
+            << (iterations > 0 ? (double) elapsed * 1000 / iterations : 0) << " us/round trip"
+            << (identical ? "" : "  DECODED MESSAGE ENCODED DIFFERENTLY") << std::endl;
+  if (dump)
+    {
+      std::cout << "  ";
+      for (uint32_t i = 0; i < encoded.size (); ++i)
+        {
+          char hex[4];
+          std::sprintf (hex, "%02x ", encoded[i]);
+          std::cout << hex;
+        }
+      std::cout << std::endl;
+    }
+  return identical;
+}
+
+/**
+ * \return the dedicated radio resource configuration of a UE with one
+ * SRB and two DRBs
+ */
+static LteRrcSap::RadioResourceConfigDedicated
+CreateRadioResourceConfigDedicated (void)
+{
+  LteRrcSap::RadioResourceConfigDedicated rrcd = LteRrcSap::RadioResourceConfigDedicated ();
+
+  LteRrcSap::SrbToAddMod srb = LteRrcSap::SrbToAddMod ();
+  srb.srbIdentity = 1;
+  srb.logicalChannelConfig.priority = 1;
+  srb.logicalChannelConfig.prioritizedBitRateKbps = 65535;
+  srb.logicalChannelConfig.bucketSizeDurationMs = 1000;
+  srb.logicalChannelConfig.logicalChannelGroup = 0;
+  rrcd.srbToAddModList.push_back (srb);
+
+  for (uint8_t i = 1; i <= 2; ++i)
+    {
+      LteRrcSap::DrbToAddMod drb = LteRrcSap::DrbToAddMod ();
+      drb.epsBearerIdentity = 4 + i;
+      drb.drbIdentity = i;
+      drb.logicalChannelIdentity = 2 + i;
+      drb.rlcConfig.choice = (i == 1) ? LteRrcSap::RlcConfig::AM : LteRrcSap::RlcConfig::UM_BI_DIRECTIONAL;
+      drb.logicalChannelConfig.priority = 9 + i;
+      drb.logicalChannelConfig.prioritizedBitRateKbps = 256;
+      drb.logicalChannelConfig.bucketSizeDurationMs = 100;
+      drb.logicalChannelConfig.logicalChannelGroup = 2;
+      rrcd.drbToAddModList.push_back (drb);
+    }
+  rrcd.drbToReleaseList.push_back (3);
+
+  rrcd.havePhysicalConfigDedicated = true;
+  rrcd.physicalConfigDedicated.haveSoundingRsUlConfigDedicated = true;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.type = LteRrcSap::SoundingRsUlConfigDedicated::SETUP;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.srsBandwidth = 0;
+  rrcd.physicalConfigDedicated.soundingRsUlConfigDedicated.srsConfigIndex = 17;
+  rrcd.physicalConfigDedicated.haveAntennaInfoDedicated = true;
+  rrcd.physicalConfigDedicated.antennaInfo.transmissionMode = 1;
+  rrcd.physicalConfigDedicated.havePdschConfigDedicated = true;
+  rrcd.physicalConfigDedicated.pdschConfigDedicated.pa = LteRrcSap::PdschConfigDedicated::dB0;
+  return rrcd;
+}
+
+/**
+ * \return a measurement configuration with an A3 event and an A2 event
+ */
+static LteRrcSap::MeasConfig
+CreateMeasConfig (void)
+{
+  LteRrcSap::MeasConfig measConfig = LteRrcSap::MeasConfig ();
+
+  LteRrcSap::MeasObjectToAddMod measObject = LteRrcSap::MeasObjectToAddMod ();
+  measObject.measObjectId = 1;
+  measObject.measObjectEutra.carrierFreq = 100;
+  measObject.measObjectEutra.allowedMeasBandwidth = 25;
+  measObject.measObjectEutra.presenceAntennaPort1 = false;
+  measObject.measObjectEutra.neighCellConfig = 0;
+  measObject.measObjectEutra.offsetFreq = 0;
+  LteRrcSap::CellsToAddMod cell = LteRrcSap::CellsToAddMod ();
+  cell.cellIndex = 1;
+  cell.physCellId = 2;
+  cell.cellIndividualOffset = 15;
+  measObject.measObjectEutra.cellsToAddModList.push_back (cell);
+  measConfig.measObjectToAddModList.push_back (measObject);
+
+  LteRrcSap::ReportConfigToAddMod reportConfig = LteRrcSap::ReportConfigToAddMod ();
+  reportConfig.reportConfigId = 1;
+  reportConfig.reportConfigEutra.triggerType = LteRrcSap::ReportConfigEutra::EVENT;
+  reportConfig.reportConfigEutra.eventId = LteRrcSap::ReportConfigEutra::EVENT_A3;
+  reportConfig.reportConfigEutra.a3Offset = 6;
+  reportConfig.reportConfigEutra.hysteresis = 6;
+  reportConfig.reportConfigEutra.timeToTrigger = 256;
+  reportConfig.reportConfigEutra.reportOnLeave = false;
+  reportConfig.reportConfigEutra.triggerQuantity = LteRrcSap::ReportConfigEutra::RSRP;
+  reportConfig.reportConfigEutra.reportQuantity = LteRrcSap::ReportConfigEutra::BOTH;
+  reportConfig.reportConfigEutra.maxReportCells = 8;
+  reportConfig.reportConfigEutra.reportInterval = LteRrcSap::ReportConfigEutra::MS480;
+  reportConfig.reportConfigEutra.reportAmount = 255;
+  measConfig.reportConfigToAddModList.push_back (reportConfig);
+  reportConfig.reportConfigId = 2;
+  reportConfig.reportConfigEutra.eventId = LteRrcSap::ReportConfigEutra::EVENT_A2;
+  reportConfig.reportConfigEutra.threshold1.choice = LteRrcSap::ThresholdEutra::THRESHOLD_RSRQ;
+  reportConfig.reportConfigEutra.threshold1.range = 30;
+  reportConfig.reportConfigEutra.triggerQuantity = LteRrcSap::ReportConfigEutra::RSRQ;
+  measConfig.reportConfigToAddModList.push_back (reportConfig);
+
+  for (uint8_t i = 1; i <= 2; ++i)
+    {
+      LteRrcSap::MeasIdToAddMod measId = LteRrcSap::MeasIdToAddMod ();
+      measId.measId = i;
+      measId.measObjectId = 1;
+      measId.reportConfigId = i;
+      measConfig.measIdToAddModList.push_back (measId);
+    }
+
+  measConfig.haveQuantityConfig = true;
+  measConfig.quantityConfig.filterCoefficientRSRP = 4;
+  measConfig.quantityConfig.filterCoefficientRSRQ = 4;
+  return measConfig;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t iterations = 10000;
+  bool dump = false;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the ASN.1 encoding and decoding of the RRC messages.");
+  cmd.AddValue ("iterations", "number of round trips of each message", iterations);
+  cmd.AddValue ("dump", "print the encoded messages", dump);
+  cmd.Parse (argc, argv);
+
+  bool identical = true;
+
+  LteRrcSap::RrcConnectionRequest request = LteRrcSap::RrcConnectionRequest ();
+  request.ueIdentity = 0x83fecafecaULL;
+  identical &= BenchMessage<RrcConnectionRequestHeader> ("RrcConnectionRequest", request, iterations, dump);
+
+  LteRrcSap::RrcConnectionSetup setup = LteRrcSap::RrcConnectionSetup ();
+  setup.rrcTransactionIdentifier = 3;
+  setup.radioResourceConfigDedicated = CreateRadioResourceConfigDedicated ();
+  identical &= BenchMessage<RrcConnectionSetupHeader> ("RrcConnectionSetup", setup, iterations, dump);
+
+  LteRrcSap::RrcConnectionSetupCompleted setupCompleted = LteRrcSap::RrcConnectionSetupCompleted ();
+  setupCompleted.rrcTransactionIdentifier = 3;
+  identical &= BenchMessage<RrcConnectionSetupCompleteHeader> ("RrcConnectionSetupComplete", setupCompleted, iterations, dump);
+
+  LteRrcSap::RrcConnectionReconfiguration reconfiguration = LteRrcSap::RrcConnectionReconfiguration ();
+  reconfiguration.rrcTransactionIdentifier = 2;
+  reconfiguration.haveMeasConfig = true;
+  reconfiguration.measConfig = CreateMeasConfig ();
+  reconfiguration.haveMobilityControlInfo = true;
+  reconfiguration.mobilityControlInfo.targetPhysCellId = 2;
+  reconfiguration.mobilityControlInfo.haveCarrierFreq = true;
+  reconfiguration.mobilityControlInfo.carrierFreq.dlCarrierFreq = 100;
+  reconfiguration.mobilityControlInfo.carrierFreq.ulCarrierFreq = 18100;
+  reconfiguration.mobilityControlInfo.haveCarrierBandwidth = true;
+  reconfiguration.mobilityControlInfo.carrierBandwidth.dlBandwidth = 25;
+  reconfiguration.mobilityControlInfo.carrierBandwidth.ulBandwidth = 25;
+  reconfiguration.mobilityControlInfo.newUeIdentity = 11;
+  reconfiguration.mobilityControlInfo.haveRachConfigDedicated = true;
+  reconfiguration.mobilityControlInfo.rachConfigDedicated.raPreambleIndex = 52;
+  reconfiguration.mobilityControlInfo.rachConfigDedicated.raPrachMaskIndex = 0;
+  reconfiguration.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.preambleInfo.numberOfRaPreambles = 52;
+  reconfiguration.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax = 50;
+  reconfiguration.mobilityControlInfo.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.raResponseWindowSize = 3;
+  reconfiguration.haveRadioResourceConfigDedicated = true;
+  reconfiguration.radioResourceConfigDedicated = CreateRadioResourceConfigDedicated ();
+  identical &= BenchMessage<RrcConnectionReconfigurationHeader> ("RrcConnectionReconfiguration", reconfiguration, iterations, dump);
+
+  LteRrcSap::RrcConnectionReconfigurationCompleted reconfigurationCompleted = LteRrcSap::RrcConnectionReconfigurationCompleted ();
+  reconfigurationCompleted.rrcTransactionIdentifier = 2;
+  identical &= BenchMessage<RrcConnectionReconfigurationCompleteHeader> ("RrcConnectionReconfigurationComplete", reconfigurationCompleted, iterations, dump);
+
+  LteRrcSap::HandoverPreparationInfo handoverPreparationInfo = LteRrcSap::HandoverPreparationInfo ();
+  handoverPreparationInfo.asConfig.sourceDlCarrierFreq = 100;
+  handoverPreparationInfo.asConfig.sourceUeIdentity = 11;
+  handoverPreparationInfo.asConfig.sourceRadioResourceConfig = CreateRadioResourceConfigDedicated ();
+  handoverPreparationInfo.asConfig.sourceMeasConfig = CreateMeasConfig ();
+  handoverPreparationInfo.asConfig.sourceMasterInformationBlock.dlBandwidth = 25;
+  handoverPreparationInfo.asConfig.sourceMasterInformationBlock.systemFrameNumber = 1;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.plmnIdentityInfo.plmnIdentity = 123;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.cellIdentity = 1;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.csgIndication = false;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType1.cellAccessRelatedInfo.csgIdentity = 0;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType2.freqInfo.ulCarrierFreq = 18100;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType2.freqInfo.ulBandwidth = 25;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.preambleInfo.numberOfRaPreambles = 52;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.preambleTransMax = 50;
+  handoverPreparationInfo.asConfig.sourceSystemInformationBlockType2.radioResourceConfigCommon.rachConfigCommon.raSupervisionInfo.raResponseWindowSize = 3;
+  identical &= BenchMessage<HandoverPreparationInfoHeader> ("HandoverPreparationInfo", handoverPreparationInfo, iterations, dump);
+
+  LteRrcSap::RrcConnectionReestablishmentRequest reestablishmentRequest = LteRrcSap::RrcConnectionReestablishmentRequest ();
+  reestablishmentRequest.ueIdentity.cRnti = 12;
+  reestablishmentRequest.ueIdentity.physCellId = 21;
+  reestablishmentRequest.reestablishmentCause = LteRrcSap::HANDOVER_FAILURE;
+  identical &= BenchMessage<RrcConnectionReestablishmentRequestHeader> ("RrcConnectionReestablishmentRequest", reestablishmentRequest, iterations, dump);
+
+  LteRrcSap::RrcConnectionReestablishment reestablishment = LteRrcSap::RrcConnectionReestablishment ();
+  reestablishment.rrcTransactionIdentifier = 2;
+  reestablishment.radioResourceConfigDedicated = CreateRadioResourceConfigDedicated ();
+  identical &= BenchMessage<RrcConnectionReestablishmentHeader> ("RrcConnectionReestablishment", reestablishment, iterations, dump);
+
+  LteRrcSap::RrcConnectionReestablishmentComplete reestablishmentComplete = LteRrcSap::RrcConnectionReestablishmentComplete ();
+  reestablishmentComplete.rrcTransactionIdentifier = 3;
+  identical &= BenchMessage<RrcConnectionReestablishmentCompleteHeader> ("RrcConnectionReestablishmentComplete", reestablishmentComplete, iterations, dump);
+
+  LteRrcSap::RrcConnectionReestablishmentReject reestablishmentReject = LteRrcSap::RrcConnectionReestablishmentReject ();
+  identical &= BenchMessage<RrcConnectionReestablishmentRejectHeader> ("RrcConnectionReestablishmentReject", reestablishmentReject, iterations, dump);
+
+  LteRrcSap::RrcConnectionRelease release = LteRrcSap::RrcConnectionRelease ();
+  release.rrcTransactionIdentifier = 1;
+  identical &= BenchMessage<RrcConnectionReleaseHeader> ("RrcConnectionRelease", release, iterations, dump);
+
+  LteRrcSap::RrcConnectionReject reject = LteRrcSap::RrcConnectionReject ();
+  reject.waitTime = 2;
+  identical &= BenchMessage<RrcConnectionRejectHeader> ("RrcConnectionReject", reject, iterations, dump);
+
+  LteRrcSap::MeasurementReport measurementReport = LteRrcSap::MeasurementReport ();
+  measurementReport.measResults.measId = 1;
+  measurementReport.measResults.rsrpResult = 60;
+  measurementReport.measResults.rsrqResult = 20;
+  measurementReport.measResults.haveMeasResultNeighCells = true;
+  for (uint16_t i = 2; i <= 5; ++i)
+    {
+      LteRrcSap::MeasResultEutra neighbour = LteRrcSap::MeasResultEutra ();
+      neighbour.physCellId = i;
+      neighbour.haveRsrpResult = true;
+      neighbour.rsrpResult = 40 + i;
+      neighbour.haveRsrqResult = true;
+      neighbour.rsrqResult = 10 + i;
+      neighbour.haveCgiInfo = false;
+      measurementReport.measResults.measResultListEutra.push_back (neighbour);
+    }
+  measurementReport.measResults.haveScellsMeas = false;
+  identical &= BenchMessage<MeasurementReportHeader> ("MeasurementReport", measurementReport, iterations, dump);
+
+  return identical ? 0 : 1;
+}
@@ -0,0 +1,372 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks an LTE MAC scheduler in isolation: the
+// scheduler is driven through the FF MAC scheduler SAPs with synthetic
+// DL CQI reports, UL CQI reports, RLC buffer reports, BSRs and HARQ
+// feedback, without any MAC or PHY.
+// Sample usage:  ./waf --run 'bench-lte-scheduler --ues=200 --ttis=10000'
+//
+// The checksum printed at the end only depends on the allocations made
+// by the scheduler, and can be used to check that an optimization of a
+// scheduler does not change its decisions.
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/ff-mac-scheduler.h"
+#include "ns3/ff-mac-csched-sap.h"
+#include "ns3/ff-mac-sched-sap.h"
+#include "ns3/lte-ffr-algorithm.h"
+#include "ns3/lte-common.h"
+#include <iostream>
+#include <deque>
+#include <vector>
+
+using namespace ns3;
+
+
+/// CSCHED SAP user discarding all the confirmations
+class BenchCschedSapUser : public FfMacCschedSapUser
+{
+public:
+  virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params)
+  {
+  }
+  virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params)
+  {
+  }
+};
+
+
+/// SCHED SAP user storing the allocations of the last TTI
+class BenchSchedSapUser : public FfMacSchedSapUser
+{
+public:
+  BenchSchedSapUser ()
+    : m_checksum (0),
+      m_dlDcis (0),
+      m_ulDcis (0)
+  {
+  }
+  virtual void SchedDlConfigInd (const struct SchedDlConfigIndParameters& params)
+  {
+    m_dlConfig = params;
+    for (std::vector<BuildDataListElement_s>::const_iterator it = params.m_buildDataList.begin ();
+         it != params.m_buildDataList.end ();
+         ++it)
+      {
+        Add (it->m_rnti);
+        Add (it->m_dci.m_rbBitmap);
+        Add (it->m_dci.m_harqProcess);
+        for (uint32_t j = 0; j < it->m_dci.m_tbsSize.size (); ++j)
+          {
+            Add (it->m_dci.m_mcs.at (j));
+            Add (it->m_dci.m_tbsSize.at (j));
+            Add (it->m_dci.m_rv.at (j));
+          }
+        ++m_dlDcis;
+      }
+  }
+  virtual void SchedUlConfigInd (const struct SchedUlConfigIndParameters& params)
+  {
+    m_ulConfig = params;
+    for (std::vector<UlDciListElement_s>::const_iterator it = params.m_dciList.begin ();
+         it != params.m_dciList.end ();
+         ++it)
+      {
+        Add (it->m_rnti);
+        Add (it->m_rbStart);
+        Add (it->m_rbLen);
+        Add (it->m_mcs);
+        Add (it->m_tbSize);
+        Add (it->m_ndi);
+        ++m_ulDcis;
+      }
+  }
+
+  /**
+   * Add a value to the checksum
+   * \param v the value
+   */
+  void Add (uint64_t v)
+  {
+    // FNV-1a
+    m_checksum ^= v;
+    m_checksum *= 1099511628211ULL;
+  }
+
+  SchedDlConfigIndParameters m_dlConfig; ///< last DL allocation
+  SchedUlConfigIndParameters m_ulConfig; ///< last UL allocation
+  uint64_t m_checksum; ///< checksum of all the allocations
+  uint64_t m_dlDcis;   ///< number of DL DCIs
+  uint64_t m_ulDcis;   ///< number of UL DCIs
+};
+
+
+/**
+ * \param rnti the RNTI of a UE
+ * \return the transmission mode of the UE
+ */
+static uint8_t
+TxMode (uint16_t rnti)
+{
+  return (rnti % 4 == 0) ? 2 : 0;
+}
+
+
+int main (int argc, char *argv[])
+{
+  std::string schedulerType = "ns3::PfFfMacScheduler";
+  uint32_t nUes = 200;
+  uint32_t nTtis = 10000;
+  uint32_t bandwidth = 100;
+  uint32_t cqiPeriod = 5;
+  uint32_t bsrPeriod = 5;
+  double nackProbability = 0.1;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark an LTE MAC scheduler with synthetic traffic, without MAC and PHY.");
+  cmd.AddValue ("scheduler", "TypeId of the scheduler", schedulerType);
+  cmd.AddValue ("ues", "number of UEs in the cell", nUes);
+  cmd.AddValue ("ttis", "number of TTIs", nTtis);
+  cmd.AddValue ("bandwidth", "DL and UL bandwidth (RBs)", bandwidth);
+  cmd.AddValue ("cqiPeriod", "period of the CQI reports of each UE (TTIs)", cqiPeriod);
+  cmd.AddValue ("bsrPeriod", "period of the BSRs and RLC buffer reports of each UE (TTIs)", bsrPeriod);
+  cmd.AddValue ("nack", "probability of a HARQ NACK", nackProbability);
+  cmd.Parse (argc, argv);
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+
+  ObjectFactory factory;
+  factory.SetTypeId (schedulerType);
+  Ptr<FfMacScheduler> scheduler = factory.Create<FfMacScheduler> ();
+  factory.SetTypeId ("ns3::LteFrNoOpAlgorithm");
+  Ptr<LteFfrAlgorithm> ffr = factory.Create<LteFfrAlgorithm> ();
+  ffr->SetDlBandwidth (bandwidth);
+  ffr->SetUlBandwidth (bandwidth);
+  scheduler->SetLteFfrSapProvider (ffr->GetLteFfrSapProvider ());
+  ffr->SetLteFfrSapUser (scheduler->GetLteFfrSapUser ());
+  BenchCschedSapUser cschedSapUser;
+  BenchSchedSapUser schedSapUser;
+  scheduler->SetFfMacCschedSapUser (&cschedSapUser);
+  scheduler->SetFfMacSchedSapUser (&schedSapUser);
+  FfMacCschedSapProvider* csched = scheduler->GetFfMacCschedSapProvider ();
+  FfMacSchedSapProvider* sched = scheduler->GetFfMacSchedSapProvider ();
+
+  FfMacCschedSapProvider::CschedCellConfigReqParameters cellConfig;
+  cellConfig.m_dlBandwidth = bandwidth;
+  cellConfig.m_ulBandwidth = bandwidth;
+  csched->CschedCellConfigReq (cellConfig);
+
+  for (uint16_t rnti = 1; rnti <= nUes; ++rnti)
+    {
+      FfMacCschedSapProvider::CschedUeConfigReqParameters ueConfig;
+      ueConfig.m_rnti = rnti;
+      ueConfig.m_transmissionMode = TxMode (rnti);
+      ueConfig.m_reconfigureFlag = false;
+      csched->CschedUeConfigReq (ueConfig);
+
+      FfMacCschedSapProvider::CschedLcConfigReqParameters lcConfig;
+      lcConfig.m_rnti = rnti;
+      lcConfig.m_reconfigureFlag = false;
+      LogicalChannelConfigListElement_s lc;
+      lc.m_logicalChannelIdentity = 3;
+      lc.m_logicalChannelGroup = 1;
+      lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+      lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+      lc.m_qci = 9;
+      lc.m_eRabMaximulBitrateUl = 0;
+      lc.m_eRabMaximulBitrateDl = 0;
+      lc.m_eRabGuaranteedBitrateUl = 0;
+      lc.m_eRabGuaranteedBitrateDl = 0;
+      lcConfig.m_logicalChannelConfigList.push_back (lc);
+      csched->CschedLcConfigReq (lcConfig);
+    }
+
+  // per-UE state of the synthetic channel
+  int rbgSize = (bandwidth < 11) ? 1 : (bandwidth < 27) ? 2 : (bandwidth < 64) ? 3 : 4;
+  uint32_t nRbgs = bandwidth / rbgSize;
+  std::vector<double> meanCqi (nUes + 1);
+  for (uint16_t rnti = 1; rnti <= nUes; ++rnti)
+    {
+      meanCqi.at (rnti) = rng->GetValue (2, 15);
+    }
+
+  // the HARQ feedback is sent back after the HARQ period
+  std::deque<std::vector<DlInfoListElement_s> > dlFeedback (HARQ_PERIOD);
+  std::deque<std::vector<UlInfoListElement_s> > ulFeedback (HARQ_PERIOD);
+  uint16_t lastUlSfnSf = 0;
+  bool ulCqiPending = false;
+
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t tti = 0; tti < nTtis; ++tti)
+    {
+      uint16_t frameNo = (tti / 10) % 1024 + 1;
+      uint16_t subframeNo = tti % 10 + 1;
+      uint16_t sfnSf = (frameNo << 4) | subframeNo;
+
+      FfMacSchedSapProvider::SchedDlCqiInfoReqParameters dlCqi;
+      dlCqi.m_sfnSf = sfnSf;
+      FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters bsr;
+      bsr.m_sfnSf = sfnSf;
+      for (uint16_t rnti = 1; rnti <= nUes; ++rnti)
+        {
+          if ((tti + rnti) % cqiPeriod == 0)
+            {
+              CqiListElement_s cqi;
+              cqi.m_rnti = rnti;
+              cqi.m_ri = 1;
+              cqi.m_cqiType = CqiListElement_s::A30;
+              cqi.m_wbPmi = 0;
+              // one CQI per layer, as reported by LteUePhy
+              uint8_t nLayers = TransmissionModesLayers::TxMode2LayerNum (TxMode (rnti));
+              for (uint8_t j = 0; j < nLayers; ++j)
+                {
+                  cqi.m_wbCqi.push_back (meanCqi.at (rnti));
+                }
+              for (uint32_t i = 0; i < nRbgs; ++i)
+                {
+                  HigherLayerSelected_s sb;
+                  sb.m_sbPmi = 0;
+                  double v = meanCqi.at (rnti) + rng->GetValue (-3, 3);
+                  for (uint8_t j = 0; j < nLayers; ++j)
+                    {
+                      sb.m_sbCqi.push_back (std::max (0.0, std::min (15.0, v)));
+                    }
+                  cqi.m_sbMeasResult.m_higherLayerSelected.push_back (sb);
+                }
+              dlCqi.m_cqiList.push_back (cqi);
+            }
+          if ((tti + 2 * rnti) % bsrPeriod == 0)
+            {
+              FfMacSchedSapProvider::SchedDlRlcBufferReqParameters rlc;
+              rlc.m_rnti = rnti;
+              rlc.m_logicalChannelIdentity = 3;
+              rlc.m_rlcTransmissionQueueSize = rng->GetInteger (0, 20000);
+              rlc.m_rlcTransmissionQueueHolDelay = rng->GetInteger (0, 100);
+              rlc.m_rlcRetransmissionQueueSize = 0;
+              rlc.m_rlcRetransmissionHolDelay = 0;
+              rlc.m_rlcStatusPduSize = 0;
+              sched->SchedDlRlcBufferReq (rlc);
+
+              MacCeListElement_s ce;
+              ce.m_rnti = rnti;
+              ce.m_macCeType = MacCeListElement_s::BSR;
+              ce.m_macCeValue.m_bufferStatus.push_back (rng->GetInteger (0, 40));
+              ce.m_macCeValue.m_bufferStatus.push_back (0);
+              ce.m_macCeValue.m_bufferStatus.push_back (0);
+              ce.m_macCeValue.m_bufferStatus.push_back (0);
+              bsr.m_macCeList.push_back (ce);
+            }
+        }
+      if (!dlCqi.m_cqiList.empty ())
+        {
+          sched->SchedDlCqiInfoReq (dlCqi);
+        }
+      if (!bsr.m_macCeList.empty ())
+        {
+          sched->SchedUlMacCtrlInfoReq (bsr);
+        }
+
+      if (ulCqiPending)
+        {
+          // PUSCH SINR of the RBs allocated in the last UL subframe
+          FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulCqi;
+          ulCqi.m_sfnSf = lastUlSfnSf;
+          ulCqi.m_ulCqi.m_type = UlCqi_s::PUSCH;
+          for (uint32_t i = 0; i < bandwidth; ++i)
+            {
+              ulCqi.m_ulCqi.m_sinr.push_back (LteFfConverter::double2fpS11dot3 (rng->GetValue (-5, 25)));
+            }
+          sched->SchedUlCqiInfoReq (ulCqi);
+        }
+
+      FfMacSchedSapProvider::SchedDlTriggerReqParameters dlTrigger;
+      dlTrigger.m_sfnSf = sfnSf;
+      dlTrigger.m_dlInfoList = dlFeedback.front ();
+      dlFeedback.pop_front ();
+      sched->SchedDlTriggerReq (dlTrigger);
+      std::vector<DlInfoListElement_s> dlInfoList;
+      for (std::vector<BuildDataListElement_s>::const_iterator it = schedSapUser.m_dlConfig.m_buildDataList.begin ();
+           it != schedSapUser.m_dlConfig.m_buildDataList.end ();
+           ++it)
+        {
+          DlInfoListElement_s dlInfo;
+          dlInfo.m_rnti = it->m_rnti;
+          dlInfo.m_harqProcessId = it->m_dci.m_harqProcess;
+          for (uint32_t j = 0; j < it->m_dci.m_ndi.size (); ++j)
+            {
+              bool nack = (rng->GetValue () < nackProbability);
+              dlInfo.m_harqStatus.push_back (nack ? DlInfoListElement_s::NACK : DlInfoListElement_s::ACK);
+            }
+          dlInfoList.push_back (dlInfo);
+        }
+      dlFeedback.push_back (dlInfoList);
+      schedSapUser.m_dlConfig.m_buildDataList.clear ();
+
+      FfMacSchedSapProvider::SchedUlTriggerReqParameters ulTrigger;
+      ulTrigger.m_sfnSf = sfnSf;
+      ulTrigger.m_ulInfoList = ulFeedback.front ();
+      ulFeedback.pop_front ();
+      schedSapUser.m_ulConfig.m_dciList.clear ();
+      sched->SchedUlTriggerReq (ulTrigger);
+      std::vector<UlInfoListElement_s> ulInfoList;
+      for (std::vector<UlDciListElement_s>::const_iterator it = schedSapUser.m_ulConfig.m_dciList.begin ();
+           it != schedSapUser.m_ulConfig.m_dciList.end ();
+           ++it)
+        {
+          UlInfoListElement_s ulInfo;
+          ulInfo.m_rnti = it->m_rnti;
+          ulInfo.m_receptionStatus = (rng->GetValue () < nackProbability) ? UlInfoListElement_s::NotOk : UlInfoListElement_s::Ok;
+          ulInfo.m_tpc = 0;
+          ulInfoList.push_back (ulInfo);
+        }
+      ulFeedback.push_back (ulInfoList);
+      ulCqiPending = !schedSapUser.m_ulConfig.m_dciList.empty ();
+      lastUlSfnSf = sfnSf;
+    }
+  int64_t elapsed = time.End ();
+
+  std::cout << schedulerType << ": " << nUes << " UEs, " << bandwidth << " RBs, "
+            << nTtis << " TTIs in " << elapsed << " ms ("
+            << (nTtis > 0 ? (double) elapsed * 1000 / nTtis : 0) << " us/TTI)" << std::endl;
+  std::cout << "DL DCIs: " << schedSapUser.m_dlDcis
+            << " UL DCIs: " << schedSapUser.m_ulDcis
+            << " checksum: " << std::hex << schedSapUser.m_checksum << std::dec << std::endl;
+
+  scheduler->Dispose ();
+  ffr->Dispose ();
+  return 0;
+}
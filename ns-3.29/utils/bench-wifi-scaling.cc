@@ -0,0 +1,819 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the simulation of a Wi-Fi BSS: an AP and its
+// stations, placed on a disc around it, exchange saturating or fixed-rate
+// traffic over packet sockets (so that no IP stack is simulated). A run
+// is made for each combination of the numbers of stations, PHY types
+// (yans or spectrum), remote station managers, aggregation settings,
+// traffic directions and offered loads given on the command line.
+// Sample usage:
+//   ./waf --run 'bench-wifi-scaling --stations=1,10,100,1000 --phy=yans,spectrum
+//                --manager=ns3::IdealWifiManager,ns3::MinstrelHtWifiManager
+//                --aggregation=none,ampdu --output=wifi-scaling.json'
+//
+// The results are written in JSON: for each run, the wall clock time of
+// the simulation (Simulator::Run only) and per simulated second, the
+// number of events processed by the scheduler (including the cancelled
+// ones) and per wall clock second, the peak resident set size of the
+// process during the run and the received throughput, which only depends
+// on the simulated behavior. On Linux, each run is made in a child process
+// of its own, so that its peak resident set size does not include the
+// memory of the previous runs. On Linux, the CPU time of the run is also
+// sampled and broken down by shared library, i.e., by ns-3 module when
+// ns-3 is built as shared libraries ("moduleSeconds"); the time spent in
+// the C and C++ runtimes on behalf of a module is counted in the runtime.
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/map-scheduler.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/traced-callback.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-address.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/spectrum-wifi-helper.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/ssid.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+#if defined (__linux__)
+#include <signal.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+using namespace ns3;
+
+
+/**
+ * The map scheduler, counting the events removed from it to be processed.
+ */
+class CountingMapScheduler : public MapScheduler
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::CountingMapScheduler")
+      .SetParent<MapScheduler> ()
+      .SetGroupName ("Core")
+      .AddConstructor<CountingMapScheduler> ()
+    ;
+    return tid;
+  }
+
+  virtual Scheduler::Event RemoveNext (void)
+  {
+    s_events++;
+    return MapScheduler::RemoveNext ();
+  }
+
+  static uint64_t s_events; ///< the number of events removed from the schedulers
+};
+
+uint64_t CountingMapScheduler::s_events = 0;
+
+
+/**
+ * A sampling profiler attributing the CPU time of the process to the
+ * shared library executing when SIGPROF is delivered. The CPU time
+ * measured between the start and the stop of the sampling is split
+ * between the libraries in proportion to their samples, as the timer
+ * may be coarser than the requested interval.
+ */
+class LibraryProfiler
+{
+public:
+  /**
+   * Allocate the sample buffer, before the measured runs. The buffer is
+   * not initialized, so that its pages only become resident as the
+   * samples are written, and do not add to the peak resident set size
+   * of the runs.
+   *
+   * \param maxSamples the maximum number of samples of a run
+   */
+  static void Allocate (std::size_t maxSamples);
+  /**
+   * Start sampling.
+   *
+   * \param intervalUs the CPU time between two samples, in microseconds
+   */
+  static void Start (uint32_t intervalUs);
+  /**
+   * Stop sampling.
+   */
+  static void Stop (void);
+  /**
+   * \return the CPU time of each library since the last start, in seconds
+   */
+  static std::map<std::string, double> GetBreakdown (void);
+
+private:
+  /**
+   * \return the CPU time used by the process, in seconds
+   */
+  static double GetCpuSeconds (void);
+
+#if defined (__linux__)
+  /**
+   * Record the program counter of the interrupted code.
+   *
+   * \param sig the signal
+   * \param info the signal information
+   * \param context the context of the interrupted code
+   */
+  static void Sample (int sig, siginfo_t *info, void *context);
+  /**
+   * \param path the path of an executable file
+   * \return the name of its library or module
+   */
+  static std::string GetLibraryName (std::string path);
+
+  static uintptr_t *s_samples;               ///< the sampled program counters
+  static std::size_t s_maxSamples;           ///< the size of the sample buffer
+  static volatile sig_atomic_t s_nSamples;   ///< the number of samples
+  static struct sigaction s_oldAction;       ///< the action replaced by Sample
+#endif
+  static double s_cpuSeconds;                ///< the CPU time at the start, then of the sampling
+};
+
+double LibraryProfiler::s_cpuSeconds = 0;
+
+double
+LibraryProfiler::GetCpuSeconds (void)
+{
+#if defined (__linux__)
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+         + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+#else
+  return 0;
+#endif
+}
+
+#if defined (__linux__)
+uintptr_t *LibraryProfiler::s_samples = 0;
+std::size_t LibraryProfiler::s_maxSamples = 0;
+volatile sig_atomic_t LibraryProfiler::s_nSamples = 0;
+struct sigaction LibraryProfiler::s_oldAction;
+
+void
+LibraryProfiler::Sample (int sig, siginfo_t *info, void *context)
+{
+  uintptr_t pc = 0;
+  ucontext_t *uc = static_cast<ucontext_t *> (context);
+#if defined (__x86_64__)
+  pc = uc->uc_mcontext.gregs[REG_RIP];
+#elif defined (__i386__)
+  pc = uc->uc_mcontext.gregs[REG_EIP];
+#elif defined (__aarch64__)
+  pc = uc->uc_mcontext.pc;
+#else
+  (void) uc;
+#endif
+  if (static_cast<std::size_t> (s_nSamples) < s_maxSamples)
+    {
+      s_samples[s_nSamples] = pc;
+      s_nSamples = s_nSamples + 1;
+    }
+}
+
+void
+LibraryProfiler::Allocate (std::size_t maxSamples)
+{
+  delete [] s_samples;
+  s_samples = new uintptr_t[maxSamples];
+  s_maxSamples = maxSamples;
+}
+
+void
+LibraryProfiler::Start (uint32_t intervalUs)
+{
+  s_nSamples = 0;
+  struct sigaction action;
+  memset (&action, 0, sizeof (action));
+  action.sa_sigaction = &LibraryProfiler::Sample;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset (&action.sa_mask);
+  sigaction (SIGPROF, &action, &s_oldAction);
+  struct itimerval timer;
+  timer.it_interval.tv_sec = intervalUs / 1000000;
+  timer.it_interval.tv_usec = intervalUs % 1000000;
+  timer.it_value = timer.it_interval;
+  s_cpuSeconds = GetCpuSeconds ();
+  setitimer (ITIMER_PROF, &timer, 0);
+}
+
+void
+LibraryProfiler::Stop (void)
+{
+  struct itimerval timer;
+  memset (&timer, 0, sizeof (timer));
+  setitimer (ITIMER_PROF, &timer, 0);
+  sigaction (SIGPROF, &s_oldAction, 0);
+  s_cpuSeconds = GetCpuSeconds () - s_cpuSeconds;
+}
+
+std::string
+LibraryProfiler::GetLibraryName (std::string path)
+{
+  char exe[4096];
+  ssize_t length = readlink ("/proc/self/exe", exe, sizeof (exe) - 1);
+  if (length > 0 && path == std::string (exe, length))
+    {
+      return "program";
+    }
+  std::string name = path.substr (path.find_last_of ('/') + 1);
+  if (name.compare (0, 6, "libns3") == 0)
+    {
+      // libns3.29-<module>-<profile>.so
+      std::string::size_type first = name.find ('-');
+      std::string::size_type last = name.find_last_of ('-');
+      if (first != std::string::npos && last > first)
+        {
+          return name.substr (first + 1, last - first - 1);
+        }
+    }
+  return name.substr (0, name.find (".so"));
+}
+
+std::map<std::string, double>
+LibraryProfiler::GetBreakdown (void)
+{
+  // the executable mappings of the process
+  std::map<uintptr_t, std::pair<uintptr_t, std::string> > mappings;
+  std::ifstream maps ("/proc/self/maps");
+  std::string line;
+  while (std::getline (maps, line))
+    {
+      std::istringstream iss (line);
+      std::string range, perms, offset, dev, inode, path;
+      iss >> range >> perms >> offset >> dev >> inode >> path;
+      if (perms.size () < 3 || perms[2] != 'x' || path.empty ())
+        {
+          continue;
+        }
+      std::string::size_type dash = range.find ('-');
+      uintptr_t start = std::stoull (range.substr (0, dash), 0, 16);
+      uintptr_t end = std::stoull (range.substr (dash + 1), 0, 16);
+      mappings[start] = std::make_pair (end, GetLibraryName (path));
+    }
+  std::map<std::string, double> breakdown;
+  for (sig_atomic_t i = 0; i < s_nSamples; i++)
+    {
+      std::string name = "unknown";
+      std::map<uintptr_t, std::pair<uintptr_t, std::string> >::const_iterator it = mappings.upper_bound (s_samples[i]);
+      if (it != mappings.begin ())
+        {
+          --it;
+          if (s_samples[i] < it->second.first)
+            {
+              name = it->second.second;
+            }
+        }
+      breakdown[name] += s_cpuSeconds / s_nSamples;
+    }
+  return breakdown;
+}
+#else
+void
+LibraryProfiler::Allocate (std::size_t maxSamples)
+{
+}
+
+void
+LibraryProfiler::Start (uint32_t intervalUs)
+{
+}
+
+void
+LibraryProfiler::Stop (void)
+{
+}
+
+std::map<std::string, double>
+LibraryProfiler::GetBreakdown (void)
+{
+  return std::map<std::string, double> ();
+}
+#endif
+
+
+/**
+ * Reset the peak resident set size of the process, where supported.
+ */
+static void
+ResetPeakRss (void)
+{
+#if defined (__linux__)
+  std::ofstream clearRefs ("/proc/self/clear_refs");
+  if (clearRefs)
+    {
+      clearRefs << "5";
+    }
+#endif
+}
+
+/**
+ * \return the peak resident set size of the process since the last
+ *         reset, in kB
+ */
+static uint64_t
+GetPeakRssKb (void)
+{
+#if defined (__linux__)
+  std::ifstream status ("/proc/self/status");
+  std::string line;
+  while (std::getline (status, line))
+    {
+      if (line.compare (0, 6, "VmHWM:") == 0)
+        {
+          return std::stoull (line.substr (6));
+        }
+    }
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+#else
+  return 0;
+#endif
+}
+
+/**
+ * Split a comma-separated list.
+ *
+ * \param list the list
+ * \return the items of the list
+ */
+static std::vector<std::string>
+Split (std::string list)
+{
+  std::vector<std::string> items;
+  std::istringstream iss (list);
+  std::string item;
+  while (std::getline (iss, item, ','))
+    {
+      if (!item.empty ())
+        {
+          items.push_back (item);
+        }
+    }
+  return items;
+}
+
+/**
+ * Count the bytes received by a packet socket server.
+ *
+ * \param bytes the byte counter
+ * \param packet the received packet
+ * \param from the address of the sender
+ */
+static void
+CountRxBytes (uint64_t *bytes, Ptr<const Packet> packet, const Address &from)
+{
+  *bytes += packet->GetSize ();
+}
+
+/// The parameters shared by the runs
+struct BenchParams
+{
+  WifiPhyStandard standard; ///< the standard
+  double radius;            ///< the radius of the disc of the stations, in meters
+  uint32_t payloadSize;     ///< the size of the packets, in bytes
+  double warmup;            ///< the time before the traffic starts, in seconds
+  double duration;          ///< the duration of the traffic, in seconds
+  uint32_t profileUs;       ///< the CPU time between two profiler samples, 0 to disable
+};
+
+/// The configuration of a run
+struct BenchConfig
+{
+  uint32_t nStations;       ///< the number of stations
+  std::string phy;          ///< the PHY type (yans or spectrum)
+  std::string manager;      ///< the type of the remote station manager
+  std::string aggregation;  ///< the aggregation setting (none, ampdu, amsdu or both)
+  std::string direction;    ///< the direction of the traffic (downlink or uplink)
+  double load;              ///< the offered load, in Mbit/s
+};
+
+/**
+ * Run the benchmark for a configuration, and write its results.
+ *
+ * \param params the parameters shared by the runs
+ * \param config the configuration of the run
+ * \param os the output stream of the JSON results
+ */
+static void
+BenchRun (const BenchParams &params, const BenchConfig &config, std::ostream &os)
+{
+  ObjectFactory scheduler;
+  scheduler.SetTypeId (CountingMapScheduler::GetTypeId ());
+  Simulator::SetScheduler (scheduler);
+
+  NodeContainer apNode;
+  apNode.Create (1);
+  NodeContainer staNodes;
+  staNodes.Create (config.nStations);
+
+  WifiHelper wifi;
+  wifi.SetStandard (params.standard);
+  wifi.SetRemoteStationManager (config.manager);
+
+  uint32_t maxAmpduSize = 0;
+  uint32_t maxAmsduSize = 0;
+  if (config.aggregation == "ampdu" || config.aggregation == "both")
+    {
+      maxAmpduSize = 65535;
+    }
+  if (config.aggregation == "amsdu")
+    {
+      maxAmsduSize = 7935;
+    }
+  else if (config.aggregation == "both")
+    {
+      maxAmsduSize = 3839;
+    }
+  else if (config.aggregation != "none" && config.aggregation != "ampdu")
+    {
+      NS_FATAL_ERROR ("Unknown aggregation setting " << config.aggregation);
+    }
+  WifiMacHelper staMac;
+  staMac.SetType ("ns3::StaWifiMac",
+                  "Ssid", SsidValue (Ssid ("bench")),
+                  "BE_MaxAmpduSize", UintegerValue (maxAmpduSize),
+                  "BE_MaxAmsduSize", UintegerValue (maxAmsduSize));
+  WifiMacHelper apMac;
+  apMac.SetType ("ns3::ApWifiMac",
+                 "Ssid", SsidValue (Ssid ("bench")),
+                 "BE_MaxAmpduSize", UintegerValue (maxAmpduSize),
+                 "BE_MaxAmsduSize", UintegerValue (maxAmsduSize));
+
+  NetDeviceContainer apDevice;
+  NetDeviceContainer staDevices;
+  if (config.phy == "yans")
+    {
+      YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+      YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+      phy.SetChannel (channel.Create ());
+      apDevice = wifi.Install (phy, apMac, apNode);
+      staDevices = wifi.Install (phy, staMac, staNodes);
+    }
+  else if (config.phy == "spectrum")
+    {
+      Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+      channel->AddPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+      channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+      SpectrumWifiPhyHelper phy = SpectrumWifiPhyHelper::Default ();
+      phy.SetChannel (channel);
+      apDevice = wifi.Install (phy, apMac, apNode);
+      staDevices = wifi.Install (phy, staMac, staNodes);
+    }
+  else
+    {
+      NS_FATAL_ERROR ("Unknown PHY type " << config.phy);
+    }
+
+  // the stations are spread evenly on the disc around the AP
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  positions->Add (Vector (0.0, 0.0, 0.0));
+  for (uint32_t i = 0; i < config.nStations; i++)
+    {
+      double distance = params.radius * std::sqrt ((i + 0.5) / config.nStations);
+      double angle = i * 2.399963229728653; // golden angle
+      positions->Add (Vector (distance * std::cos (angle), distance * std::sin (angle), 0.0));
+    }
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator (positions);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (apNode);
+  mobility.Install (staNodes);
+
+  PacketSocketHelper packetSocket;
+  packetSocket.Install (apNode);
+  packetSocket.Install (staNodes);
+
+  uint64_t rxBytes = 0;
+  Time start = Seconds (params.warmup);
+  Time stop = Seconds (params.warmup + params.duration);
+  Time interval = Seconds (params.payloadSize * 8.0 * config.nStations / (config.load * 1e6));
+  Ptr<WifiNetDevice> ap = DynamicCast<WifiNetDevice> (apDevice.Get (0));
+  for (uint32_t i = 0; i < config.nStations; i++)
+    {
+      Ptr<WifiNetDevice> sta = DynamicCast<WifiNetDevice> (staDevices.Get (i));
+      bool downlink = config.direction == "downlink";
+      if (!downlink && config.direction != "uplink")
+        {
+          NS_FATAL_ERROR ("Unknown traffic direction " << config.direction);
+        }
+      Ptr<WifiNetDevice> sender = downlink ? ap : sta;
+      Ptr<WifiNetDevice> receiver = downlink ? sta : ap;
+
+      PacketSocketAddress remote;
+      remote.SetSingleDevice (sender->GetIfIndex ());
+      remote.SetPhysicalAddress (receiver->GetAddress ());
+      remote.SetProtocol (1);
+      Ptr<PacketSocketClient> client = CreateObject<PacketSocketClient> ();
+      client->SetAttribute ("PacketSize", UintegerValue (params.payloadSize));
+      client->SetAttribute ("MaxPackets", UintegerValue (0));
+      client->SetAttribute ("Interval", TimeValue (interval));
+      client->SetRemote (remote);
+      sender->GetNode ()->AddApplication (client);
+      // the clients don't start at the same time
+      client->SetStartTime (start + MicroSeconds (i));
+      client->SetStopTime (stop);
+
+      if (downlink || i == 0)
+        {
+          PacketSocketAddress local;
+          local.SetSingleDevice (receiver->GetIfIndex ());
+          local.SetPhysicalAddress (receiver->GetAddress ());
+          local.SetProtocol (1);
+          Ptr<PacketSocketServer> server = CreateObject<PacketSocketServer> ();
+          server->SetLocal (local);
+          server->TraceConnectWithoutContext ("Rx", MakeBoundCallback (&CountRxBytes, &rxBytes));
+          receiver->GetNode ()->AddApplication (server);
+          server->SetStartTime (Seconds (0));
+          server->SetStopTime (stop);
+        }
+    }
+
+  Simulator::Stop (stop);
+  CountingMapScheduler::s_events = 0;
+  ResetPeakRss ();
+  if (params.profileUs > 0)
+    {
+      LibraryProfiler::Start (params.profileUs);
+    }
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  double elapsed = clock.End () / 1000.0;
+  if (params.profileUs > 0)
+    {
+      LibraryProfiler::Stop ();
+    }
+  uint64_t events = CountingMapScheduler::s_events;
+  uint64_t peakRssKb = GetPeakRssKb ();
+  double simulated = stop.GetSeconds ();
+
+  os << "    {\n"
+     << "      \"stations\": " << config.nStations << ",\n"
+     << "      \"phy\": \"" << config.phy << "\",\n"
+     << "      \"manager\": \"" << config.manager << "\",\n"
+     << "      \"aggregation\": \"" << config.aggregation << "\",\n"
+     << "      \"direction\": \"" << config.direction << "\",\n"
+     << "      \"loadMbps\": " << config.load << ",\n"
+     << "      \"simulatedSeconds\": " << simulated << ",\n"
+     << "      \"wallClockSeconds\": " << elapsed << ",\n"
+     << "      \"wallClockPerSimulatedSecond\": " << elapsed / simulated << ",\n"
+     << "      \"events\": " << events << ",\n"
+     << "      \"eventsPerSecond\": " << (elapsed > 0 ? events / elapsed : 0) << ",\n"
+     << "      \"peakRssKb\": " << peakRssKb << ",\n"
+     << "      \"throughputMbps\": " << rxBytes * 8.0 / params.duration / 1e6 << ",\n"
+     << "      \"moduleSeconds\": {";
+  if (params.profileUs > 0)
+    {
+      std::map<std::string, double> breakdown = LibraryProfiler::GetBreakdown ();
+      std::vector<std::pair<double, std::string> > sorted;
+      for (std::map<std::string, double>::const_iterator it = breakdown.begin (); it != breakdown.end (); it++)
+        {
+          sorted.push_back (std::make_pair (it->second, it->first));
+        }
+      std::sort (sorted.rbegin (), sorted.rend ());
+      for (std::size_t i = 0; i < sorted.size (); i++)
+        {
+          os << (i == 0 ? "" : ", ") << "\"" << sorted[i].second << "\": " << sorted[i].first;
+        }
+    }
+  os << "}\n"
+     << "    }";
+  os.flush ();
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Run the benchmark for a configuration, in a child process where
+ * supported, and return its results.
+ *
+ * \param params the parameters shared by the runs
+ * \param config the configuration of the run
+ * \return the JSON results of the run
+ */
+static std::string
+BenchRunIsolated (const BenchParams &params, const BenchConfig &config)
+{
+  std::ostringstream oss;
+#if defined (__linux__)
+  int fds[2];
+  if (pipe (fds) != 0)
+    {
+      NS_FATAL_ERROR ("Can't create a pipe: " << std::strerror (errno));
+    }
+  pid_t pid = fork ();
+  if (pid < 0)
+    {
+      NS_FATAL_ERROR ("Can't fork: " << std::strerror (errno));
+    }
+  if (pid == 0)
+    {
+      // the child makes the run and sends its results to the parent
+      close (fds[0]);
+      BenchRun (params, config, oss);
+      std::string results = oss.str ();
+      const char *data = results.data ();
+      std::size_t left = results.size ();
+      while (left > 0)
+        {
+          ssize_t written = write (fds[1], data, left);
+          if (written <= 0)
+            {
+              _exit (1);
+            }
+          data += written;
+          left -= written;
+        }
+      close (fds[1]);
+      _exit (0);
+    }
+  close (fds[1]);
+  char buffer[4096];
+  ssize_t n;
+  while ((n = read (fds[0], buffer, sizeof (buffer))) > 0)
+    {
+      oss.write (buffer, n);
+    }
+  close (fds[0]);
+  int status;
+  if (waitpid (pid, &status, 0) != pid || !WIFEXITED (status) || WEXITSTATUS (status) != 0)
+    {
+      NS_FATAL_ERROR ("The run of " << config.nStations << " stations failed");
+    }
+#else
+  BenchRun (params, config, oss);
+#endif
+  return oss.str ();
+}
+
+int main (int argc, char *argv[])
+{
+  std::string stations = "1,10,100";
+  std::string phys = "yans,spectrum";
+  std::string managers = "ns3::IdealWifiManager,ns3::MinstrelHtWifiManager";
+  std::string aggregations = "none,ampdu";
+  std::string directions = "downlink";
+  std::string loads = "50";
+  std::string standard = "802.11n";
+  std::string output;
+  BenchParams params;
+  params.radius = 10;
+  params.payloadSize = 1000;
+  params.warmup = 1;
+  params.duration = 1;
+  params.profileUs = 1000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the simulation of a Wi-Fi BSS for various numbers of stations and settings.");
+  cmd.AddValue ("stations", "comma-separated numbers of stations", stations);
+  cmd.AddValue ("phy", "comma-separated PHY types (yans, spectrum)", phys);
+  cmd.AddValue ("manager", "comma-separated types of remote station managers", managers);
+  cmd.AddValue ("aggregation", "comma-separated aggregation settings (none, ampdu, amsdu, both)", aggregations);
+  cmd.AddValue ("direction", "comma-separated traffic directions (downlink, uplink)", directions);
+  cmd.AddValue ("load", "comma-separated offered loads of the BSS, in Mbit/s", loads);
+  cmd.AddValue ("standard", "the standard (802.11n, 802.11ac or 802.11ax)", standard);
+  cmd.AddValue ("radius", "the radius of the disc of the stations around the AP, in meters", params.radius);
+  cmd.AddValue ("payloadSize", "the size of the packets, in bytes", params.payloadSize);
+  cmd.AddValue ("warmup", "the time before the traffic starts, in seconds", params.warmup);
+  cmd.AddValue ("duration", "the duration of the traffic, in seconds", params.duration);
+  cmd.AddValue ("profile", "the CPU time between two samples of the per-module time breakdown, "
+                "in microseconds (0 to disable it)", params.profileUs);
+  cmd.AddValue ("output", "the name of the JSON output file (standard output if empty)", output);
+  cmd.Parse (argc, argv);
+
+  if (standard == "802.11n")
+    {
+      params.standard = WIFI_PHY_STANDARD_80211n_5GHZ;
+    }
+  else if (standard == "802.11ac")
+    {
+      params.standard = WIFI_PHY_STANDARD_80211ac;
+    }
+  else if (standard == "802.11ax")
+    {
+      params.standard = WIFI_PHY_STANDARD_80211ax_5GHZ;
+    }
+  else
+    {
+      NS_FATAL_ERROR ("Unknown standard " << standard);
+    }
+
+  std::ofstream file;
+  if (!output.empty ())
+    {
+      file.open (output.c_str ());
+      if (!file)
+        {
+          NS_FATAL_ERROR ("Can't open " << output);
+        }
+    }
+  std::ostream &os = output.empty () ? std::cout : file;
+
+  os << "{\n"
+     << "  \"benchmark\": \"bench-wifi-scaling\",\n"
+     << "  \"standard\": \"" << standard << "\",\n"
+     << "  \"payloadSize\": " << params.payloadSize << ",\n"
+     << "  \"runs\": [\n";
+  if (params.profileUs > 0)
+    {
+      LibraryProfiler::Allocate (1 << 22);
+    }
+  bool first = true;
+  std::vector<std::string> stationList = Split (stations);
+  std::vector<std::string> phyList = Split (phys);
+  std::vector<std::string> managerList = Split (managers);
+  std::vector<std::string> aggregationList = Split (aggregations);
+  std::vector<std::string> directionList = Split (directions);
+  std::vector<std::string> loadList = Split (loads);
+  for (std::size_t s = 0; s < stationList.size (); s++)
+    {
+      for (std::size_t p = 0; p < phyList.size (); p++)
+        {
+          for (std::size_t m = 0; m < managerList.size (); m++)
+            {
+              for (std::size_t a = 0; a < aggregationList.size (); a++)
+                {
+                  for (std::size_t d = 0; d < directionList.size (); d++)
+                    {
+                      for (std::size_t l = 0; l < loadList.size (); l++)
+                        {
+                          BenchConfig config;
+                          config.nStations = std::stoul (stationList[s]);
+                          config.phy = phyList[p];
+                          config.manager = managerList[m];
+                          config.aggregation = aggregationList[a];
+                          config.direction = directionList[d];
+                          config.load = std::stod (loadList[l]);
+                          if (config.nStations == 0 || config.load <= 0)
+                            {
+                              continue;
+                            }
+                          std::cerr << config.nStations << " stations, " << config.phy << ", "
+                                    << config.manager << ", " << config.aggregation << ", "
+                                    << config.direction << ", " << config.load << " Mbit/s" << std::endl;
+                          if (!first)
+                            {
+                              os << ",\n";
+                            }
+                          first = false;
+                          os << BenchRunIsolated (params, config);
+                          os.flush ();
+                        }
+                    }
+                }
+            }
+        }
+    }
+  os << "\n  ]\n"
+     << "}\n";
+  return 0;
+}
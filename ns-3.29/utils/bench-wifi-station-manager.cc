@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the per-frame work of the Wi-Fi remote station
+// manager of a dense BSS: the AP sends frames to its associated stations
+// in turn, and for each frame the station manager is asked for the TXVECTOR
+// and whether RTS/CTS, fragmentation and retransmissions are needed, and is
+// told the outcome of the transmission, as MacLow does. The number of
+// frames processed per second is given for each number of stations.
+// Sample usage:
+//   ./waf --run 'bench-wifi-station-manager --stations=1,10,100,500,1000 --frames=100000'
+//
+// The checksum printed for each number of stations only depends on the
+// decisions of the station manager.
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-remote-station-manager.h"
+#include "ns3/wifi-mac-header.h"
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+
+/**
+ * Run the benchmark for a number of stations.
+ *
+ * \param manager the type of the remote station manager
+ * \param nStations the number of stations
+ * \param nFrames the number of frames to send
+ */
+static void
+BenchStations (std::string manager, uint32_t nStations, uint32_t nFrames)
+{
+  Ptr<Node> ap = CreateObject<Node> ();
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager (manager);
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, ap);
+  ap->Initialize ();
+  Ptr<WifiRemoteStationManager> stationManager =
+    DynamicCast<WifiNetDevice> (devices.Get (0))->GetRemoteStationManager ();
+  // normally done by Txop before the first frame is sent
+  stationManager->UpdateFragmentationThreshold ();
+
+  std::vector<Mac48Address> stations;
+  for (uint32_t i = 0; i < nStations; ++i)
+    {
+      Mac48Address address = Mac48Address::Allocate ();
+      stationManager->AddAllSupportedModes (address);
+      stationManager->RecordGotAssocTxOk (address);
+      stations.push_back (address);
+    }
+
+  Ptr<const Packet> packet = Create<Packet> (1000);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_DATA);
+  hdr.SetAddr2 (Mac48Address::ConvertFrom (devices.Get (0)->GetAddress ()));
+  WifiMode ackMode = stationManager->GetDefaultMode ();
+  uint64_t checksum = 0;
+
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < nFrames; ++i)
+    {
+      Mac48Address address = stations[i % nStations];
+      hdr.SetAddr1 (address);
+      WifiTxVector txVector = stationManager->GetDataTxVector (address, &hdr, packet);
+      checksum += txVector.GetMode ().GetUid ();
+      checksum += stationManager->NeedRts (address, &hdr, packet, txVector) ? 1 : 0;
+      checksum += stationManager->NeedFragmentation (address, &hdr, packet) ? 1 : 0;
+      // every seventh frame to a station fails once
+      if ((i / nStations) % 7 == 3)
+        {
+          stationManager->ReportDataFailed (address, &hdr, packet->GetSize ());
+          checksum += stationManager->NeedRetransmission (address, &hdr, packet) ? 1 : 0;
+          txVector = stationManager->GetDataTxVector (address, &hdr, packet);
+          checksum += txVector.GetMode ().GetUid ();
+        }
+      stationManager->ReportDataOk (address, &hdr, 25.0, ackMode, 20.0, packet->GetSize ());
+      checksum += stationManager->GetAckTxVector (address, txVector.GetMode ()).GetMode ().GetUid ();
+    }
+  int64_t elapsed = time.End ();
+
+  std::cout << nStations << " stations: " << nFrames << " frames in " << elapsed << " ms, "
+            << (elapsed > 0 ? nFrames * 1000.0 / elapsed : 0) << " frames/s, checksum "
+            << checksum << std::endl;
+  Simulator::Destroy ();
+}
+
+int main (int argc, char *argv[])
+{
+  std::string manager = "ns3::MinstrelWifiManager";
+  std::string stations = "1,10,100,500,1000";
+  uint32_t frames = 100000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the per-frame work of a Wi-Fi remote station manager in a dense BSS.");
+  cmd.AddValue ("manager", "type of the remote station manager", manager);
+  cmd.AddValue ("stations", "comma-separated numbers of stations", stations);
+  cmd.AddValue ("frames", "number of frames sent for each number of stations", frames);
+  cmd.Parse (argc, argv);
+
+  std::cout << manager << std::endl;
+  std::istringstream iss (stations);
+  std::string token;
+  while (std::getline (iss, token, ','))
+    {
+      uint32_t nStations = std::stoul (token);
+      if (nStations > 0)
+        {
+          BenchStations (manager, nStations, frames);
+        }
+    }
+  return 0;
+}
@@ -0,0 +1,65 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program converts the files written by the LTE statistics
+// calculators in the binary format (ns3::LteStatsCalculator::OutputFormat
+// set to "Binary") to the text files which they write by default.
+// Sample usage:
+//   ./waf --run 'lte-stats-converter --input=DlMacStats.txt --output=DlMacStats.txt.converted'
+// When no output file is given, the input file is replaced.
+
+#include "ns3/command-line.h"
+#include "ns3/lte-stats-file.h"
+#include <cstdio>
+#include <iostream>
+
+using namespace ns3;
+
+int
+main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+
+  CommandLine cmd;
+  cmd.Usage ("Convert a binary LTE statistics file to text.");
+  cmd.AddValue ("input", "binary statistics file", input);
+  cmd.AddValue ("output", "text statistics file (default: replace the input file)", output);
+  cmd.Parse (argc, argv);
+
+  if (input.empty ())
+    {
+      std::cerr << "No input file given (see --help)" << std::endl;
+      return 1;
+    }
+  bool replace = output.empty ();
+  if (replace)
+    {
+      output = input + ".tmp";
+    }
+  if (!LteStatsFile::ConvertToText (input, output))
+    {
+      std::cerr << "Could not convert " << input << " to " << output << std::endl;
+      std::remove (output.c_str ());
+      return 1;
+    }
+  if (replace && (std::rename (output.c_str (), input.c_str ()) != 0))
+    {
+      std::cerr << "Could not replace " << input << std::endl;
+      return 1;
+    }
+  return 0;
+}